@@ -0,0 +1,38 @@
+#pragma once
+
+#include <chrono>
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * Minimal stopwatch for the benchmarks. Results are printed one per line as
+ * "[name] label value unit" so that two runs can be compared with diff.
+ */
+class Benchmark
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit Benchmark(const char *name) : name(name), start(Clock::now()) {}
+
+    void restart(void) { start = Clock::now(); }
+    double elapsedUs(void) const { return std::chrono::duration<double, std::micro>(Clock::now() - start).count(); }
+    double elapsedMs(void) const { return elapsedUs() / 1000.0; }
+
+    void report(const char *label, double value, const char *unit) const
+    {
+        printf("[%s] %-48s %12.3f %s\n", name, label, value, unit);
+    }
+
+    // busy wait to emulate work that is not available in the benchmark (e.g. LVGL object creation)
+    static void spin(std::chrono::microseconds duration)
+    {
+        auto end = Clock::now() + duration;
+        while (Clock::now() < end)
+            ;
+    }
+
+  private:
+    const char *name;
+    Clock::time_point start;
+};
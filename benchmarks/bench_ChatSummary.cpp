@@ -0,0 +1,72 @@
+#include "Benchmark.h"
+#include "TestFileSystem.h"
+#include "util/ChatSummary.h"
+#include "util/LogRotate.h"
+#include <doctest/doctest.h>
+#include <string>
+
+/**
+ * Time until the chat list can be rendered at boot: loading the persistent chat summary
+ * compared to replaying the full message log (25 files).
+ */
+
+namespace
+{
+constexpr const char *logDir = "/bench_chatsummary";
+constexpr const char *summaryFile = "/bench_chatsummary.sum";
+constexpr uint32_t ownNode = 0x1000;
+constexpr int c_runs = 20;
+} // namespace
+
+TEST_CASE("ChatSummary: time to first chat list render")
+{
+    fs::FS &fs = testFileSystem();
+    removeDir(fs, logDir);
+    fs.remove(summaryFile);
+
+    {
+        LogRotate log(fs, logDir, sizeof(LogMessage));
+        log.init();
+        ChatSummary summary(fs, summaryFile);
+        for (int i = 0; i < 1000; i++) {
+            std::string text = "benchmark message " + std::to_string(i) + std::string(i % 150, '.');
+            uint32_t peer = 0x2000 + i % 20;
+            LogMessageEnv msg(i % 3 ? peer : ownNode, i % 2 ? UINT32_MAX : (i % 3 ? ownNode : peer), i % 8, 1000 + i,
+                              LogMessage::eDefault, false, text.size(), (const uint8_t *)text.c_str());
+            log.write(msg);
+            summary.update(msg, ownNode, true);
+        }
+        summary.save();
+    }
+
+    Benchmark bench("chatsummary");
+    uint32_t chats = 0;
+    bench.restart();
+    for (int i = 0; i < c_runs; i++) {
+        ChatSummary summary(fs, summaryFile);
+        summary.load();
+        chats = summary.chats().size();
+    }
+    bench.report("load summary", bench.elapsedMs() / c_runs, "ms");
+    bench.report("chats", chats, "");
+
+    uint32_t records = 0;
+    bench.restart();
+    for (int i = 0; i < c_runs; i++) {
+        LogRotate log(fs, logDir, sizeof(LogMessage));
+        log.init();
+        ChatSummary summary(fs, "/bench_chatsummary_rebuilt.sum");
+        LogMessageEnv msg;
+        records = 0;
+        while (log.readNext(msg)) {
+            summary.update(msg, ownNode);
+            records++;
+        }
+        CHECK(summary.chats().size() == chats);
+    }
+    bench.report("replay log", bench.elapsedMs() / c_runs, "ms");
+    bench.report("records", records, "");
+
+    removeDir(fs, logDir);
+    fs.remove(summaryFile);
+}
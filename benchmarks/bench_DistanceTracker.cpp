@@ -0,0 +1,97 @@
+#include "Benchmark.h"
+#include "util/DistanceTracker.h"
+#include <doctest/doctest.h>
+#include <math.h>
+#include <random>
+#include <stdio.h>
+#include <vector>
+
+/**
+ * 1000 nodes around our position while we walk (2 m per position update) and drive (20 m per
+ * update): the previous float recomputation and formatting of every node on each own position
+ * update, compared to DistanceTracker. Label updates are counted since every one of them costs
+ * an lv_label_set_text() and a redraw on the device.
+ */
+
+namespace
+{
+constexpr uint32_t c_nodes = 1000;
+constexpr int c_steps = 600;
+
+struct Node {
+    uint32_t num;
+    int32_t lat, lon; // 1e-7 degrees
+};
+
+std::vector<Node> makeNodes(void)
+{
+    std::mt19937 rnd(34);
+    std::vector<Node> nodes(c_nodes);
+    for (uint32_t i = 0; i < c_nodes; i++) {
+        // up to ~50 km around 47.3N 8.5E
+        nodes[i] = Node{0x1000 + i, int32_t(473000000 + int32_t(rnd() % 9000000) - 4500000),
+                        int32_t(85000000 + int32_t(rnd() % 13000000) - 6500000)};
+    }
+    return nodes;
+}
+
+// previous updateDistance() computation and formatting
+void previousDistance(char *buf, int32_t myLat, int32_t myLon, int32_t lat, int32_t lon)
+{
+    float dx = 71.5 * 1e-7 * (myLon - lon);
+    float dy = 111.3 * 1e-7 * (myLat - lat);
+    float dist = sqrt(dx * dx + dy * dy);
+    if (dist > 1.0)
+        sprintf(buf, "%.1f km ", dist);
+    else
+        sprintf(buf, "%d m ", (uint32_t)round(dist * 1000));
+}
+} // namespace
+
+TEST_CASE("DistanceTracker: 1000 nodes, moving own position")
+{
+    std::vector<Node> nodes = makeNodes();
+    Benchmark bench("distance");
+    char label[64], buf[32];
+
+    for (int32_t stepE7 : {180, 1800}) { // ~2 m and ~20 m north per update
+        const char *mode = stepE7 < 1000 ? "walking" : "driving";
+
+        uint32_t labels = 0;
+        bench.restart();
+        for (int step = 0; step < c_steps; step++) {
+            int32_t myLat = 473000000 + step * stepE7;
+            for (const Node &n : nodes) {
+                previousDistance(buf, myLat, 85000000, n.lat, n.lon);
+                labels++;
+            }
+        }
+        snprintf(label, sizeof(label), "previous %s: per position update", mode);
+        bench.report(label, bench.elapsedUs() / c_steps, "us");
+        snprintf(label, sizeof(label), "previous %s: label updates", mode);
+        bench.report(label, labels, "");
+
+        DistanceTracker tracker;
+        for (const Node &n : nodes)
+            tracker.setPosition(n.num, n.lat, n.lon);
+        labels = 0;
+        uint32_t recomputed = 0;
+        auto update = [&](uint32_t, const char *) { labels++; };
+        tracker.setOrigin(473000000, 85000000);
+        tracker.process(c_nodes, update);
+        labels = 0;
+
+        bench.restart();
+        for (int step = 0; step < c_steps; step++) {
+            tracker.setOrigin(473000000 + step * stepE7, 85000000);
+            recomputed += tracker.process(c_nodes, update);
+        }
+        snprintf(label, sizeof(label), "tracker %s: per position update", mode);
+        bench.report(label, bench.elapsedUs() / c_steps, "us");
+        snprintf(label, sizeof(label), "tracker %s: nodes recomputed", mode);
+        bench.report(label, recomputed, "");
+        snprintf(label, sizeof(label), "tracker %s: label updates", mode);
+        bench.report(label, labels, "");
+        CHECK(tracker.pending() == 0);
+    }
+}
@@ -0,0 +1,152 @@
+#include "Benchmark.h"
+#include "lvgl.h"
+#include <doctest/doctest.h>
+#include <stdio.h>
+#include <time.h>
+#include <vector>
+
+/**
+ * Headless full-screen rendering with the draw units of this build (cmake -DDRAW_UNITS=n, compare
+ * the reports of builds with 1, 2 and 4). Two screens at 320x240 and 480x222: a main screen like
+ * the generated ones (top bar, button bar, node list with rounded, shadowed rows) and a map panel
+ * of 256x256 RGB565 tiles as decodeImgColor() leaves them, with node markers. Reports frames/s
+ * and the CPU time of all threads per frame.
+ */
+
+namespace
+{
+constexpr int c_frames = 50;
+
+struct Resolution {
+    int32_t width;
+    int32_t height;
+};
+
+std::vector<uint8_t> drawBuf;
+
+void flush(lv_display_t *disp, const lv_area_t *, uint8_t *)
+{
+    lv_display_flush_ready(disp);
+}
+
+lv_display_t *display(const Resolution &res)
+{
+    if (!lv_is_initialized())
+        lv_init();
+    drawBuf.assign(res.width * res.height / 8 * 2, 0);
+    lv_display_t *disp = lv_display_create(res.width, res.height);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB565);
+    lv_display_set_buffers(disp, drawBuf.data(), nullptr, drawBuf.size(), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, flush);
+    lv_display_set_default(disp);
+    return disp;
+}
+
+void createMainScreen(lv_obj_t *screen, const Resolution &res)
+{
+    lv_obj_t *top = lv_obj_create(screen);
+    lv_obj_set_size(top, res.width, 28);
+    lv_obj_set_flex_flow(top, LV_FLEX_FLOW_ROW);
+    const char *status[] = {LV_SYMBOL_WIFI, LV_SYMBOL_BLUETOOTH, "12:34", "42/128", LV_SYMBOL_BATTERY_3 " 87%"};
+    for (const char *s : status)
+        lv_label_set_text(lv_label_create(top), s);
+
+    lv_obj_t *buttons = lv_obj_create(screen);
+    lv_obj_set_size(buttons, 48, res.height - 28);
+    lv_obj_set_pos(buttons, 0, 28);
+    lv_obj_set_flex_flow(buttons, LV_FLEX_FLOW_COLUMN);
+    const char *symbols[] = {LV_SYMBOL_HOME, LV_SYMBOL_LIST, LV_SYMBOL_ENVELOPE, LV_SYMBOL_GPS, LV_SYMBOL_SETTINGS};
+    for (const char *s : symbols) {
+        lv_obj_t *button = lv_button_create(buttons);
+        lv_label_set_text(lv_label_create(button), s);
+    }
+
+    lv_obj_t *list = lv_obj_create(screen);
+    lv_obj_set_size(list, res.width - 48, res.height - 28);
+    lv_obj_set_pos(list, 48, 28);
+    lv_obj_set_flex_flow(list, LV_FLEX_FLOW_COLUMN);
+    for (int i = 0; i < 12; i++) {
+        lv_obj_t *row = lv_obj_create(list);
+        lv_obj_set_size(row, LV_PCT(100), 44);
+        lv_obj_set_style_radius(row, 8, 0);
+        lv_obj_set_style_shadow_width(row, 6, 0);
+        lv_obj_set_style_bg_grad_color(row, lv_color_hex(0x67ea94), 0);
+        lv_obj_set_style_bg_grad_dir(row, LV_GRAD_DIR_HOR, 0);
+        lv_obj_t *name = lv_label_create(row);
+        lv_label_set_text_fmt(name, "Meshtastic %04x", 0x1a2b + i * 97);
+        lv_obj_t *signal = lv_label_create(row);
+        lv_label_set_text_fmt(signal, "SNR %d.%d  RSSI -%d  %d hops", 9 - i, i, 70 + i * 3, i % 4);
+        lv_obj_align(signal, LV_ALIGN_BOTTOM_LEFT, 0, 0);
+    }
+}
+
+std::vector<uint16_t> tilePixels[4];
+lv_image_dsc_t tiles[4];
+
+void createMap(lv_obj_t *screen, const Resolution &)
+{
+    for (int t = 0; t < 4; t++) {
+        tilePixels[t].resize(256 * 256);
+        for (uint32_t i = 0; i < tilePixels[t].size(); i++) {
+            uint32_t x = i % 256, y = i / 256;
+            tilePixels[t][i] = (uint16_t)((((x + t * 40) & 0xf8) << 8) | (((y ^ x) & 0xfc) << 3) | ((y + t * 16) >> 3));
+        }
+        tiles[t].header.magic = LV_IMAGE_HEADER_MAGIC;
+        tiles[t].header.cf = LV_COLOR_FORMAT_RGB565;
+        tiles[t].header.w = 256;
+        tiles[t].header.h = 256;
+        tiles[t].header.stride = 256 * 2;
+        tiles[t].data = (const uint8_t *)tilePixels[t].data();
+        tiles[t].data_size = tilePixels[t].size() * 2;
+    }
+    for (int i = 0; i < 9; i++) {
+        lv_obj_t *tile = lv_image_create(screen);
+        lv_image_set_src(tile, &tiles[i % 4]);
+        lv_obj_set_pos(tile, (i % 3) * 256 - 100, (i / 3) * 256 - 120);
+    }
+    for (int m = 0; m < 10; m++) {
+        lv_obj_t *marker = lv_label_create(screen);
+        lv_label_set_text_fmt(marker, LV_SYMBOL_GPS " %04x", 0x1a2b + m * 97);
+        lv_obj_set_style_bg_opa(marker, LV_OPA_70, 0);
+        lv_obj_set_style_bg_color(marker, lv_color_white(), 0);
+        lv_obj_set_pos(marker, 20 + m * 29, 15 + (m * 53) % 180);
+    }
+}
+
+void run(Benchmark &bench, const Resolution &res, const char *scene, void (*create)(lv_obj_t *, const Resolution &))
+{
+    lv_display_t *disp = display(res);
+    lv_obj_t *screen = lv_display_get_screen_active(disp);
+    create(screen, res);
+    lv_refr_now(disp);
+
+    clock_t cpu = clock();
+    bench.restart();
+    for (int f = 0; f < c_frames; f++) {
+        lv_obj_invalidate(screen);
+        lv_refr_now(disp);
+    }
+    double us = bench.elapsedUs();
+    double cpuUs = double(clock() - cpu) * 1000000 / CLOCKS_PER_SEC;
+    lv_display_delete(disp);
+
+    char label[64];
+    snprintf(label, sizeof(label), "%dx%d %s", res.width, res.height, scene);
+    bench.report(label, c_frames * 1000000 / us, "frames/s");
+    snprintf(label, sizeof(label), "%dx%d %s CPU", res.width, res.height, scene);
+    bench.report(label, cpuUs / c_frames / 1000, "ms/frame");
+}
+} // namespace
+
+TEST_CASE("DrawUnits: full-screen rendering")
+{
+    Benchmark bench("drawunits");
+    lv_display_t *previous = lv_is_initialized() ? lv_display_get_default() : nullptr;
+    bench.report("draw units", LV_DRAW_SW_DRAW_UNIT_CNT, "");
+    for (const Resolution &res : {Resolution{320, 240}, Resolution{480, 222}}) {
+        run(bench, res, "main screen", createMainScreen);
+        run(bench, res, "map panel", createMap);
+    }
+    if (previous)
+        lv_display_set_default(previous);
+}
@@ -0,0 +1,111 @@
+#include "Benchmark.h"
+#include "graphics/common/FrameStats.h"
+#include "lvgl.h"
+#include "util/Histogram.h"
+#include <doctest/doctest.h>
+#include <vector>
+
+/**
+ * Cost of the always-on frame statistics: adding a sample to a histogram, reading the clock, and
+ * the display event callbacks per frame on a headless 320x240 RGB565 display (screen/8 draw
+ * buffer), for frames that update a single label and for full-screen frames, each compared to the
+ * same frames on a display without FrameStats attached.
+ */
+
+namespace
+{
+constexpr int32_t c_width = 320;
+constexpr int32_t c_height = 240;
+constexpr int c_frames = 200;
+constexpr uint32_t c_samples = 10000000;
+
+std::vector<uint8_t> drawBuf;
+
+void flush(lv_display_t *disp, const lv_area_t *, uint8_t *)
+{
+    lv_display_flush_ready(disp);
+}
+
+lv_display_t *display(void)
+{
+    if (!lv_is_initialized())
+        lv_init();
+    drawBuf.assign(c_width * c_height / 8 * 2, 0);
+    lv_display_t *disp = lv_display_create(c_width, c_height);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB565);
+    lv_display_set_buffers(disp, drawBuf.data(), nullptr, drawBuf.size(), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, flush);
+    lv_display_set_default(disp);
+    return disp;
+}
+
+// us per frame
+double frameTime(Benchmark &bench, bool attached, bool fullScreen)
+{
+    lv_display_t *disp = display();
+    if (attached)
+        FrameStats::instance().attach(disp);
+    lv_obj_t *screen = lv_display_get_screen_active(disp);
+    for (int i = 0; i < 8; i++)
+        lv_label_set_text_fmt(lv_label_create(screen), "Meshtastic node %d", i);
+    lv_obj_t *clock = lv_label_create(screen);
+    lv_obj_align(clock, LV_ALIGN_TOP_RIGHT, 0, 0);
+    lv_refr_now(disp);
+
+    bench.restart();
+    for (int f = 0; f < c_frames; f++) {
+        if (fullScreen)
+            lv_obj_invalidate(screen);
+        lv_label_set_text_fmt(clock, "12:%02d", f % 60);
+        lv_refr_now(disp);
+    }
+    double us = bench.elapsedUs() / c_frames;
+    lv_display_delete(disp);
+    return us;
+}
+} // namespace
+
+TEST_CASE("FrameStats: overhead")
+{
+    Benchmark bench("framestats");
+
+    Histogram h;
+    uint32_t value = 12345;
+    bench.restart();
+    for (uint32_t i = 0; i < c_samples; i++) {
+        h.add(value);
+        value = value * 1103515245 + 12345;
+    }
+    bench.report("Histogram::add", bench.elapsedUs() * 1000 / c_samples, "ns");
+    CHECK(h.count() == c_samples);
+
+    uint64_t sum = 0;
+    bench.restart();
+    for (uint32_t i = 0; i < c_samples / 10; i++)
+        sum += FrameStats::now();
+    bench.report("FrameStats::now", bench.elapsedUs() * 1000 / (c_samples / 10), "ns");
+    CHECK(sum > 0);
+
+    lv_display_t *previous = lv_is_initialized() ? lv_display_get_default() : nullptr;
+    FrameStats &stats = FrameStats::instance();
+    for (bool fullScreen : {false, true}) {
+        stats.clear();
+        double plain = frameTime(bench, false, fullScreen);
+        double attached = frameTime(bench, true, fullScreen);
+        CHECK(stats.frames() == c_frames + 1);
+        if (fullScreen)
+            CHECK(stats.histogram(FrameStats::eArea).min() == c_width * c_height);
+
+        const char *scene = fullScreen ? "full screen" : "label";
+        char label[64];
+        snprintf(label, sizeof(label), "%s: frame without stats", scene);
+        bench.report(label, plain, "us");
+        snprintf(label, sizeof(label), "%s: frame with stats", scene);
+        bench.report(label, attached, "us");
+        snprintf(label, sizeof(label), "%s: overhead", scene);
+        bench.report(label, attached - plain, "us/frame");
+    }
+    stats.clear();
+    if (previous)
+        lv_display_set_default(previous);
+}
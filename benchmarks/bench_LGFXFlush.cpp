@@ -0,0 +1,184 @@
+#include "Benchmark.h"
+#include "MockLGFX.h"
+#include "graphics/driver/LGFXFlush.h"
+#include "lvgl.h"
+#include <doctest/doctest.h>
+#include <functional>
+#include <stdio.h>
+
+/**
+ * Frame time of a 320x240 RGB565 display behind a mock LGFX device that transfers 2.5 pixels/us
+ * like a 40MHz SPI panel. One draw buffer of screen/8 pushed blocking (LGFXDriver without
+ * USE_DOUBLE_BUFFER) compared to two of screen/8 pushed by DMA while the next area is rendered.
+ * Two full-screen updates per frame: scrolling a list of 40 rows by 8 pixels and panning a map
+ * of 3x3 256x256 tiles (gradients and a few markers instead of PNG tiles) by 5/3 pixels.
+ * A frame lasts until its last transfer is done.
+ * Flush cost: the time spent in the flush callback per full-screen frame on a bus without latency,
+ * rendering in RGB565 (swapped before the push) compared to RGB565_SWAPPED (pushed as rendered).
+ */
+
+namespace
+{
+constexpr int32_t c_width = 320;
+constexpr int32_t c_height = 240;
+constexpr uint32_t c_bufsize = c_width * c_height / 8 * 2;
+constexpr int c_frames = 60;
+
+uint8_t drawBuf1[c_bufsize];
+uint8_t drawBuf2[c_bufsize];
+
+lv_display_t *display(MockLGFX &lgfx, bool doubleBuffered, lv_color_format_t cf = LV_COLOR_FORMAT_RGB565_SWAPPED)
+{
+    if (!lv_is_initialized())
+        lv_init();
+    lv_display_t *disp = lv_display_create(c_width, c_height);
+    lv_display_set_color_format(disp, cf);
+    lv_display_set_buffers(disp, drawBuf1, doubleBuffered ? drawBuf2 : nullptr, c_bufsize, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    LGFXFlush<MockLGFX>::attach(disp, &lgfx);
+    lv_display_set_default(disp);
+    return disp;
+}
+
+lv_obj_t *createList(lv_obj_t *screen)
+{
+    lv_obj_t *list = lv_obj_create(screen);
+    lv_obj_set_size(list, c_width, c_height);
+    lv_obj_set_flex_flow(list, LV_FLEX_FLOW_COLUMN);
+    for (int i = 0; i < 40; i++) {
+        lv_obj_t *row = lv_obj_create(list);
+        lv_obj_set_size(row, LV_PCT(100), 36);
+        lv_obj_t *label = lv_label_create(row);
+        lv_label_set_text_fmt(label, "Node %04x  -%d dBm  %d hops", 0x1000 + i * 37, 60 + i, i % 4);
+    }
+    return list;
+}
+
+lv_obj_t *createMap(lv_obj_t *screen)
+{
+    lv_obj_t *map = lv_obj_create(screen);
+    lv_obj_remove_style_all(map);
+    lv_obj_set_size(map, 3 * 256, 3 * 256);
+    lv_obj_set_pos(map, -128, -128);
+    for (int i = 0; i < 9; i++) {
+        lv_obj_t *tile = lv_obj_create(map);
+        lv_obj_remove_style_all(tile);
+        lv_obj_set_size(tile, 256, 256);
+        lv_obj_set_pos(tile, (i % 3) * 256, (i / 3) * 256);
+        lv_obj_set_style_bg_opa(tile, LV_OPA_COVER, 0);
+        lv_obj_set_style_bg_color(tile, lv_color_hex(0xd0e8c0 + i * 0x0401), 0);
+        lv_obj_set_style_bg_grad_color(tile, lv_color_hex(0xa0c8f0 - i * 0x0102), 0);
+        lv_obj_set_style_bg_grad_dir(tile, i % 2 ? LV_GRAD_DIR_VER : LV_GRAD_DIR_HOR, 0);
+        for (int m = 0; m < 3; m++) {
+            lv_obj_t *marker = lv_label_create(tile);
+            lv_label_set_text_fmt(marker, LV_SYMBOL_GPS " %d", i * 3 + m);
+            lv_obj_set_pos(marker, 40 + m * 60, 50 + m * 50);
+        }
+    }
+    return map;
+}
+
+// average frame time in us
+double frameTime(Benchmark &bench, bool doubleBuffered, const std::function<lv_obj_t *(lv_obj_t *)> &create,
+                 const std::function<void(lv_obj_t *, int)> &step, MockLGFX &lgfx)
+{
+    lv_display_t *disp = display(lgfx, doubleBuffered);
+    lv_obj_t *obj = create(lv_display_get_screen_active(disp));
+    lv_refr_now(disp);
+    LGFXFlush<MockLGFX>::finish(&lgfx);
+
+    bench.restart();
+    for (int f = 0; f < c_frames; f++) {
+        step(obj, f);
+        lv_refr_now(disp);
+        LGFXFlush<MockLGFX>::finish(&lgfx);
+    }
+    double us = bench.elapsedUs() / c_frames;
+    lv_display_delete(disp);
+    return us;
+}
+
+void scroll(lv_obj_t *list, int frame)
+{
+    lv_obj_scroll_by(list, 0, frame < c_frames / 2 ? -8 : 8, LV_ANIM_OFF);
+}
+
+void pan(lv_obj_t *map, int frame)
+{
+    int32_t d = frame < c_frames / 2 ? -1 : 1;
+    lv_obj_set_pos(map, lv_obj_get_x(map) + 5 * d, lv_obj_get_y(map) + 3 * d);
+}
+
+// LV_EVENT_FLUSH_START/FINISH
+void flushTime(lv_event_t *e)
+{
+    static Benchmark::Clock::time_point start;
+    if (lv_event_get_code(e) == LV_EVENT_FLUSH_START)
+        start = Benchmark::Clock::now();
+    else
+        *(double *)lv_event_get_user_data(e) +=
+            std::chrono::duration<double, std::micro>(Benchmark::Clock::now() - start).count();
+}
+
+// average time in the flush callback per frame in us
+double flushCost(lv_color_format_t cf, MockLGFX &lgfx)
+{
+    lv_display_t *disp = display(lgfx, false, cf);
+    lv_obj_t *map = createMap(lv_display_get_screen_active(disp));
+    lv_refr_now(disp);
+    double us = 0;
+    lv_display_add_event_cb(disp, flushTime, LV_EVENT_FLUSH_START, &us);
+    lv_display_add_event_cb(disp, flushTime, LV_EVENT_FLUSH_FINISH, &us);
+    for (int f = 0; f < c_frames; f++) {
+        pan(map, f);
+        lv_refr_now(disp);
+    }
+    lv_display_delete(disp);
+    return us / c_frames;
+}
+} // namespace
+
+TEST_CASE("LGFXFlush: frame time")
+{
+    Benchmark bench("lgfxflush");
+    lv_display_t *previous = lv_is_initialized() ? lv_display_get_default() : nullptr;
+    struct {
+        const char *name;
+        std::function<lv_obj_t *(lv_obj_t *)> create;
+        std::function<void(lv_obj_t *, int)> step;
+    } scenes[] = {{"full-screen scroll", createList, scroll}, {"map pan", createMap, pan}};
+
+    for (auto &scene : scenes) {
+        MockLGFX blocking(c_width, c_height), dma(c_width, c_height);
+        double blockingUs = frameTime(bench, false, scene.create, scene.step, blocking);
+        double dmaUs = frameTime(bench, true, scene.create, scene.step, dma);
+        CHECK(dma.unselected == 0);
+        CHECK(dma.pixels == blocking.pixels);
+
+        char label[64];
+        snprintf(label, sizeof(label), "%s: blocking", scene.name);
+        bench.report(label, blockingUs / 1000, "ms/frame");
+        snprintf(label, sizeof(label), "%s: double-buffered DMA", scene.name);
+        bench.report(label, dmaUs / 1000, "ms/frame");
+        snprintf(label, sizeof(label), "%s: transfer", scene.name);
+        bench.report(label, blocking.pixels / blocking.pixelsPerUs / (c_frames + 1) / 1000, "ms/frame");
+        CHECK(dmaUs < blockingUs);
+    }
+    if (previous)
+        lv_display_set_default(previous);
+}
+
+TEST_CASE("LGFXFlush: flush cost")
+{
+    Benchmark bench("lgfxflush");
+    lv_display_t *previous = lv_is_initialized() ? lv_display_get_default() : nullptr;
+    MockLGFX rgb565(c_width, c_height, 1e6), swapped(c_width, c_height, 1e6);
+    double rgb565Us = flushCost(LV_COLOR_FORMAT_RGB565, rgb565);
+    double swappedUs = flushCost(LV_COLOR_FORMAT_RGB565_SWAPPED, swapped);
+    CHECK(rgb565.pixels == swapped.pixels);
+
+    bench.report("flush: RGB565 + swap", rgb565Us, "us/frame");
+    bench.report("flush: RGB565_SWAPPED", swappedUs, "us/frame");
+    CHECK(swappedUs < rgb565Us);
+    if (previous)
+        lv_display_set_default(previous);
+}
@@ -0,0 +1,170 @@
+#include "Benchmark.h"
+#include "lv_i18n.h"
+#include "lvgl.h"
+#include "util/LabelRegistry.h"
+#include <doctest/doctest.h>
+#include <set>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+/**
+ * Locale switch latency with the settings of all languages: the translatable labels spread over
+ * six panels of a 320x240 screen like the panels of the main screen, one of them shown. Relabeling
+ * all labels before the next frame (what a switch without reboot would do without the registry)
+ * compared to LabelRegistry relabeling the visible panel with the first frame and the hidden
+ * ones c_batch labels per frame. Reports the time from the switch until the first frame is
+ * rendered and the frames until the last hidden label is relabeled.
+ */
+
+namespace
+{
+constexpr uint32_t c_panels = 6;
+constexpr uint32_t c_batch = 16;
+constexpr int c_rounds = 5;
+
+uint8_t drawBuf[320 * 24 * 2];
+
+void flush(lv_display_t *disp, const lv_area_t *, uint8_t *)
+{
+    lv_display_flush_ready(disp);
+}
+
+lv_display_t *headlessDisplay(void)
+{
+    if (!lv_is_initialized())
+        lv_init();
+    lv_display_t *disp = lv_display_get_default();
+    if (!disp) {
+        disp = lv_display_create(320, 240);
+        lv_display_set_buffers(disp, drawBuf, nullptr, sizeof(drawBuf), LV_DISPLAY_RENDER_MODE_PARTIAL);
+        lv_display_set_flush_cb(disp, flush);
+    }
+    return disp;
+}
+
+const char *text(LabelRegistry::Label label)
+{
+    return lv_label_get_text((lv_obj_t *)label);
+}
+
+void setText(LabelRegistry::Label label, const char *text)
+{
+    lv_label_set_text((lv_obj_t *)label, text);
+}
+
+// TFTView_Common::task_handler()
+bool visible(LabelRegistry::Label label)
+{
+    const lv_obj_t *obj = (const lv_obj_t *)label;
+    return lv_obj_get_screen(obj) == lv_screen_active() && lv_obj_is_visible(obj);
+}
+
+struct Screen {
+    std::vector<std::string> msgIds;
+    std::vector<lv_obj_t *> panels;
+    std::vector<lv_obj_t *> labels;
+
+    Screen(void)
+    {
+        std::set<std::string> seen;
+        for (const lv_i18n_language_pack_t *lang = lv_i18n_language_pack; *lang; lang++) {
+            for (const lv_i18n_phrase_t *p = (*lang)->singulars; p && p->msg_id; p++) {
+                if (!strchr(p->msg_id, '%') && !strchr(p->msg_id, '\n') && seen.insert(p->msg_id).second)
+                    msgIds.push_back(p->msg_id);
+            }
+        }
+        for (uint32_t i = 0; i < c_panels; i++) {
+            lv_obj_t *panel = lv_obj_create(lv_screen_active());
+            lv_obj_set_size(panel, 320, 240);
+            lv_obj_set_flex_flow(panel, LV_FLEX_FLOW_COLUMN);
+            if (i > 0)
+                lv_obj_add_flag(panel, LV_OBJ_FLAG_HIDDEN);
+            panels.push_back(panel);
+        }
+        for (size_t i = 0; i < msgIds.size(); i++) {
+            lv_obj_t *label = lv_label_create(panels[i % c_panels]);
+            lv_label_set_text(label, lv_i18n_get_text(msgIds[i].c_str()));
+            labels.push_back(label);
+        }
+    }
+    ~Screen()
+    {
+        for (lv_obj_t *panel : panels)
+            lv_obj_delete(panel);
+    }
+
+    bool translated(void) const
+    {
+        for (size_t i = 0; i < labels.size(); i++) {
+            if (strcmp(lv_label_get_text(labels[i]), lv_i18n_get_text(msgIds[i].c_str())) != 0)
+                return false;
+        }
+        return true;
+    }
+};
+} // namespace
+
+TEST_CASE("LabelRegistry: locale switch latency")
+{
+    lv_display_t *disp = headlessDisplay();
+    REQUIRE(lv_i18n_init_default() == 0);
+    Benchmark bench("labelregistry");
+    Screen screen;
+    bench.report("translatable labels", screen.labels.size(), "");
+
+    std::vector<const char *> locales;
+    for (const lv_i18n_language_pack_t *lang = lv_i18n_language_pack + 1; *lang; lang++)
+        locales.push_back((*lang)->locale_name);
+    locales.push_back("en");
+    uint32_t switches = c_rounds * locales.size();
+
+    double allUs = 0;
+    lv_refr_now(disp);
+    for (int r = 0; r < c_rounds; r++) {
+        for (const char *locale : locales) {
+            bench.restart();
+            lv_i18n_set_locale(locale);
+            for (size_t i = 0; i < screen.labels.size(); i++)
+                lv_label_set_text(screen.labels[i], lv_i18n_get_text(screen.msgIds[i].c_str()));
+            lv_refr_now(disp);
+            allUs += bench.elapsedUs();
+        }
+    }
+    CHECK(screen.translated());
+
+    LabelRegistry labels(lv_i18n_get_text, text, setText);
+    for (size_t i = 0; i < screen.labels.size(); i++)
+        labels.adopt(screen.labels[i], screen.msgIds[i].c_str());
+    double firstUs = 0, restUs = 0;
+    uint32_t frames = 0;
+    lv_refr_now(disp);
+    for (int r = 0; r < c_rounds; r++) {
+        for (const char *locale : locales) {
+            bench.restart();
+            labels.invalidate();
+            lv_i18n_set_locale(locale);
+            labels.relabel(visible, c_batch);
+            lv_refr_now(disp);
+            firstUs += bench.elapsedUs();
+
+            bench.restart();
+            while (labels.stale() > 0) {
+                labels.relabel(visible, c_batch);
+                lv_refr_now(disp);
+                frames++;
+            }
+            restUs += bench.elapsedUs();
+            CHECK(screen.translated());
+        }
+    }
+    CHECK(labels.released() == 0);
+
+    bench.report("relabel all: switch to first frame", allUs / switches, "us");
+    bench.report("registry: switch to first frame", firstUs / switches, "us");
+    bench.report("registry: following frames", double(frames) / switches, "");
+    bench.report("registry: relabel hidden labels", restUs / switches, "us");
+    CHECK(firstUs < allUs);
+    lv_i18n_set_locale("en");
+}
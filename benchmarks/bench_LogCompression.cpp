@@ -0,0 +1,146 @@
+#include "Benchmark.h"
+#include "TestFileSystem.h"
+#include "util/LogMessage.h"
+#include "util/LogRotate.h"
+#include "util/Lzss.h"
+#include <doctest/doctest.h>
+#include <random>
+#include <string>
+
+/**
+ * Effect of compressing rotated log segments: messages retained in a log limited to 100kB
+ * (oldest files are deleted once the limit is reached) and read throughput of the decompressing
+ * readNext() compared to plain records.
+ */
+
+namespace
+{
+constexpr const char *logDir = "/bench_logcompression";
+constexpr uint32_t c_maxLogSize = 102400;
+constexpr int c_runs = 10;
+// a compressed segment of 10000 raw bytes still fits into a single 4kB flash block
+constexpr uint32_t c_plainFileSize = 4000;
+constexpr uint32_t c_compressedFileSize = 10000;
+
+uint32_t fileSize(bool compress)
+{
+    return compress ? c_compressedFileSize : c_plainFileSize;
+}
+
+// chat-like texts: a limited vocabulary with varying length, names and numbers
+std::string chatText(std::mt19937 &rnd)
+{
+    static const char *words[] = {"hello", "the",    "node",     "is",       "on",     "channel", "battery", "signal",
+                                  "good",  "weak",   "see",      "you",      "at",     "meeting", "point",   "north",
+                                  "ok",    "thanks", "anyone",   "copy",     "mesh",   "relay",   "hops",    "position",
+                                  "going", "home",   "tomorrow", "morning",  "check",  "antenna", "range",   "km"};
+    std::string text;
+    uint32_t count = 2 + rnd() % 18;
+    for (uint32_t i = 0; i < count; i++) {
+        if (!text.empty())
+            text += ' ';
+        if (rnd() % 8 == 0)
+            text += std::to_string(rnd() % 1000);
+        else
+            text += words[rnd() % (sizeof(words) / sizeof(words[0]))];
+    }
+    return text;
+}
+
+// write more messages than fit into the log and return how many are still retained
+uint32_t fillLog(fs::FS &fs, bool compress, uint32_t numMessages)
+{
+    removeDir(fs, logDir);
+    std::mt19937 rnd(7);
+    LogRotate log(fs, logDir, sizeof(LogMessage), c_maxLogSize, 25, fileSize(compress), compress);
+    log.init();
+    for (uint32_t i = 0; i < numMessages; i++) {
+        std::string text = chatText(rnd);
+        uint32_t from = 0x1000 + rnd() % 30;
+        log.write(LogMessageEnv(from, rnd() % 4 ? UINT32_MAX : 0x1000, rnd() % 3, 1700000000 + i * 17, LogMessage::eDefault,
+                                false, text.size(), (const uint8_t *)text.c_str()));
+    }
+
+    LogRotate reader(fs, logDir, sizeof(LogMessage), c_maxLogSize, 25, fileSize(compress), compress);
+    reader.init();
+    LogMessageEnv msg;
+    uint32_t retained = 0;
+    while (reader.readNext(msg))
+        retained++;
+    return retained;
+}
+
+uint32_t logSize(fs::FS &fs)
+{
+    LogRotate log(fs, logDir, sizeof(LogMessage), c_maxLogSize, 25, c_compressedFileSize, true);
+    log.init();
+    return log.size();
+}
+
+double readThroughput(fs::FS &fs, bool compress, Benchmark &bench, uint32_t &rawBytes)
+{
+    bench.restart();
+    for (int i = 0; i < c_runs; i++) {
+        LogRotate log(fs, logDir, sizeof(LogMessage), c_maxLogSize, 25, fileSize(compress), compress);
+        log.init();
+        LogMessageEnv msg;
+        rawBytes = 0;
+        while (log.readNext(msg))
+            rawBytes += sizeof(LogMessage) - sizeof(msg.bytes) + msg.length();
+    }
+    return (double)rawBytes * c_runs / bench.elapsedUs(); // bytes per us == MB/s
+}
+} // namespace
+
+TEST_CASE("LogRotate: segment compression")
+{
+    fs::FS &fs = testFileSystem();
+    Benchmark bench("logcompression");
+    constexpr uint32_t numMessages = 5000;
+
+    uint32_t plain = fillLog(fs, false, numMessages);
+    uint32_t rawBytes = 0;
+    double plainRead = readThroughput(fs, false, bench, rawBytes);
+
+    uint32_t compressed = fillLog(fs, true, numMessages);
+    double compressedRead = readThroughput(fs, true, bench, rawBytes);
+
+    bench.report("messages retained per 100kB (uncompressed)", plain, "");
+    bench.report("messages retained per 100kB (compressed)", compressed, "");
+    bench.report("retention gain", (double)compressed / plain, "x");
+    bench.report("log size (compressed)", logSize(fs), "bytes");
+    bench.report("readNext() throughput (uncompressed)", plainRead, "MB/s");
+    bench.report("readNext() throughput (compressed)", compressedRead, "MB/s");
+    CHECK(compressed > plain);
+
+    // raw decoder throughput without file system overhead
+    std::mt19937 rnd(7);
+    std::string text;
+    while (text.size() < 64 * 1024)
+        text += chatText(rnd) + '\n';
+    std::vector<uint8_t> packed;
+    bench.restart();
+    Lzss::compress((const uint8_t *)text.data(), text.size(), packed);
+    bench.report("Lzss::compress() 64kB", bench.elapsedMs(), "ms");
+    bench.report("Lzss ratio on chat text", (double)packed.size() / text.size(), "");
+
+    uint8_t buf[256];
+    bench.restart();
+    for (int i = 0; i < c_runs; i++) {
+        size_t pos = 0;
+        Lzss::Decoder decoder(
+            [&](uint8_t *out, size_t len) {
+                size_t n = std::min(len, packed.size() - pos);
+                memcpy(out, &packed[pos], n);
+                pos += n;
+                return n;
+            },
+            text.size());
+        while (decoder.read(buf, sizeof(buf)))
+            ;
+        CHECK(decoder.position() == text.size());
+    }
+    bench.report("Lzss::Decoder throughput", (double)text.size() * c_runs / bench.elapsedUs(), "MB/s");
+
+    removeDir(fs, logDir);
+}
@@ -0,0 +1,86 @@
+#include "Benchmark.h"
+#include "TestFileSystem.h"
+#include "util/LogMessage.h"
+#include "util/LogRotate.h"
+#include <doctest/doctest.h>
+#include <fstream>
+#include <string>
+
+/**
+ * Restoring a full log (25 files of 4000 bytes) through fs compared to mapped log files.
+ * Besides the time the number of read syscalls is taken from /proc/self/io.
+ */
+
+#if defined(__linux__)
+namespace
+{
+constexpr const char *logDir = "/bench_logmapped";
+constexpr int c_runs = 20;
+
+uint64_t readSyscalls(void)
+{
+    std::ifstream io("/proc/self/io");
+    std::string key;
+    uint64_t value = 0;
+    while (io >> key >> value) {
+        if (key == "syscr:")
+            return value;
+    }
+    return 0;
+}
+
+void fillLog(fs::FS &fs, bool compress)
+{
+    removeDir(fs, logDir);
+    LogRotate log(fs, logDir, sizeof(LogMessage), 102400, 25, 4000, compress);
+    log.init();
+    for (int i = 0; i < 2000; i++) {
+        std::string text = "benchmark message " + std::to_string(i) + std::string(i % 150, '.');
+        log.write(LogMessageEnv(0x1000 + i % 50, UINT32_MAX, i % 8, 1000 + i, LogMessage::eDefault, false, text.size(),
+                                (const uint8_t *)text.c_str()));
+    }
+}
+
+void restore(fs::FS &fs, bool compress, bool map, const char *label)
+{
+    Benchmark bench("logmapped");
+    uint32_t records = 0;
+    uint64_t syscalls = 0;
+    double ms = 0;
+    for (int i = 0; i < c_runs; i++) {
+        LogRotate log(fs, logDir, sizeof(LogMessage), 102400, 25, 4000, compress);
+        log.init();
+        if (map)
+            log.mapFiles(portduinoVFS->mountpoint());
+        uint64_t before = readSyscalls();
+        bench.restart();
+        LogMessageEnv msg;
+        records = 0;
+        while (log.readNext(msg))
+            records++;
+        ms += bench.elapsedMs();
+        syscalls += readSyscalls() - before - 1; // minus the read of /proc/self/io
+    }
+
+    std::string name = std::string(label) + (map ? " mmap" : " fs");
+    bench.report((name + ": restore (readNext)").c_str(), ms / c_runs, "ms");
+    bench.report((name + ": read syscalls").c_str(), syscalls / c_runs, "");
+    bench.report((name + ": records").c_str(), records, "");
+}
+} // namespace
+
+TEST_CASE("LogRotate: mapped restore")
+{
+    fs::FS &fs = testFileSystem();
+
+    fillLog(fs, false);
+    restore(fs, false, false, "plain");
+    restore(fs, false, true, "plain");
+
+    fillLog(fs, true);
+    restore(fs, true, false, "compressed");
+    restore(fs, true, true, "compressed");
+
+    removeDir(fs, logDir);
+}
+#endif
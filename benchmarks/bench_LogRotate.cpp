@@ -0,0 +1,88 @@
+#include "Benchmark.h"
+#include "TestFileSystem.h"
+#include "util/LogMessage.h"
+#include "util/LogRotate.h"
+#include <doctest/doctest.h>
+#include <string>
+
+/**
+ * Startup cost of LogRotate::init() with a full log (25 files of 4000 bytes), compared to
+ * validating every record by reading the whole log.
+ */
+
+namespace
+{
+constexpr const char *logDir = "/bench_logrotate";
+constexpr int c_runs = 20;
+
+void fillLog(fs::FS &fs)
+{
+    LogRotate log(fs, logDir, sizeof(LogMessage));
+    log.init();
+    for (int i = 0; i < 1000; i++) {
+        std::string text = "benchmark message " + std::to_string(i) + std::string(i % 150, '.');
+        log.write(LogMessageEnv(0x1000 + i % 50, UINT32_MAX, i % 8, 1000 + i, LogMessage::eDefault, false, text.size(),
+                                (const uint8_t *)text.c_str()));
+    }
+}
+} // namespace
+
+TEST_CASE("LogRotate: recovery time")
+{
+    fs::FS &fs = testFileSystem();
+    removeDir(fs, logDir);
+    fillLog(fs);
+
+    Benchmark bench("logrotate");
+    uint32_t files = 0, bytes = 0, records = 0;
+    {
+        LogRotate log(fs, logDir, sizeof(LogMessage));
+        log.init();
+        files = log.count();
+        bytes = log.size();
+    }
+    bench.report("log files", files, "");
+    bench.report("log size", bytes, "bytes");
+
+    bench.restart();
+    for (int i = 0; i < c_runs; i++) {
+        LogRotate log(fs, logDir, sizeof(LogMessage));
+        log.init();
+    }
+    bench.report("init() with recovery scan", bench.elapsedMs() / c_runs, "ms");
+
+    bench.restart();
+    for (int i = 0; i < c_runs; i++) {
+        LogRotate log(fs, logDir, sizeof(LogMessage));
+        log.init();
+        LogMessageEnv msg;
+        records = 0;
+        while (log.readNext(msg))
+            records++;
+    }
+    bench.report("init() + reading all records (linear scan)", bench.elapsedMs() / c_runs, "ms");
+    bench.report("records", records, "");
+
+    // tear the newest log file in every run
+    String newest;
+    {
+        char name[40];
+        LogRotate log(fs, logDir, sizeof(LogMessage));
+        log.init();
+        sprintf(name, "%s/log_%06d.log", logDir, log.current() + log.count() - 1);
+        newest = name;
+    }
+    std::vector<uint8_t> image = readFile(fs, newest.c_str());
+    double torn = 0;
+    for (int i = 0; i < c_runs; i++) {
+        writeFile(fs, newest.c_str(), image.data(), image.size() - 3);
+        bench.restart();
+        LogRotate log(fs, logDir, sizeof(LogMessage));
+        log.init();
+        torn += bench.elapsedMs();
+    }
+    bench.report("init() with torn newest file", torn / c_runs, "ms");
+    CHECK(readFile(fs, newest.c_str()).size() < image.size());
+
+    removeDir(fs, logDir);
+}
@@ -0,0 +1,253 @@
+#if defined(ARCH_PORTDUINO)
+
+#include "Benchmark.h"
+#include "graphics/common/FrameStats.h"
+#include "lvgl.h"
+#include "util/Histogram.h"
+#include "util/Wakeup.h"
+#include <atomic>
+#include <doctest/doctest.h>
+#include <fcntl.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+/**
+ * Linux main loop of DeviceGUI::task_handler(): the previous loop slept to a fixed 10 ms cadence
+ * and advanced the ticks by the sleep, the current one takes the ticks from the monotonic clock
+ * and sleeps until the next LVGL timer is due or an input device becomes readable (Wakeup).
+ * Headless 320x240 display with a button and a pointer input device, read every
+ * LV_DEF_REFR_PERIOD ms by the previous loop and on input only (LV_INDEV_MODE_EVENT) by the
+ * current one. Reported for both loops: wakeups per second and CPU usage of the loop thread while
+ * idle, and the time from a press or release on the input device (written to a pipe, as evdev
+ * would) to the end of the frame that shows it.
+ */
+
+namespace
+{
+constexpr int32_t c_width = 320;
+constexpr int32_t c_height = 240;
+constexpr uint32_t c_runMs = 3000;
+constexpr uint32_t c_inputPeriod = 37; // ms between presses and releases, not aligned with the loop
+constexpr uint32_t c_maxSleep = 100;   // ms, as in DeviceGUI
+
+std::vector<uint8_t> drawBuf;
+
+std::atomic<bool> pressed(false);
+std::atomic<uint64_t> inputAt(0); // us, last press or release on the device
+uint64_t shownAfter = 0;          // us, input handled by the UI, waiting for the frame
+Histogram latency;
+
+uint32_t lastTimerRun = 0;
+uint32_t timeUntilNext = 0;
+bool inputRead = false;
+
+void flush(lv_display_t *disp, const lv_area_t *, uint8_t *)
+{
+    lv_display_flush_ready(disp);
+}
+
+void pointer_read_cb(lv_indev_t *, lv_indev_data_t *data)
+{
+    data->point.x = c_width / 2;
+    data->point.y = c_height / 2;
+    data->state = pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+
+void button_event_cb(lv_event_t *e)
+{
+    lv_event_code_t code = lv_event_get_code(e);
+    if (code == LV_EVENT_PRESSED || code == LV_EVENT_RELEASED) {
+        lv_label_set_text((lv_obj_t *)lv_event_get_user_data(e), code == LV_EVENT_PRESSED ? "pressed" : "released");
+        shownAfter = inputAt;
+    }
+}
+
+void render_ready_cb(lv_event_t *)
+{
+    if (shownAfter) {
+        latency.add(uint32_t(FrameStats::now() - shownAfter));
+        shownAfter = 0;
+    }
+}
+
+void timer_resume_cb(void *)
+{
+    timeUntilNext = 0;
+}
+
+uint64_t threadCpuUs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return uint64_t(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+// previous DeviceGUI::task_handler()
+void oldLoop(void)
+{
+    int ms = 10;
+    auto start = std::chrono::high_resolution_clock::now();
+    lv_timer_handler();
+    auto stop = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+    if (duration.count() < ms) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms - duration.count()));
+        lv_tick_inc(ms);
+    } else {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        lv_tick_inc(duration.count() + 1);
+    }
+}
+
+bool inputHeld(void)
+{
+    for (lv_indev_t *indev = lv_indev_get_next(nullptr); indev; indev = lv_indev_get_next(indev)) {
+        if (lv_indev_get_mode(indev) == LV_INDEV_MODE_EVENT && lv_indev_get_state(indev) == LV_INDEV_STATE_PRESSED)
+            return true;
+    }
+    return false;
+}
+
+// DisplayDriver::task_handler() and DeviceGUI::task_handler()
+void newLoop(void)
+{
+    if (lv_tick_elaps(lastTimerRun) >= timeUntilNext) {
+        timeUntilNext = lv_timer_handler();
+        lastTimerRun = lv_tick_get();
+    }
+    uint32_t elapsed = lv_tick_elaps(lastTimerRun);
+    uint32_t ms = elapsed >= timeUntilNext ? 0 : timeUntilNext - elapsed;
+    bool readAgain = inputRead || inputHeld();
+    uint32_t maxSleep = readAgain ? LV_DEF_REFR_PERIOD : c_maxSleep;
+    inputRead = Wakeup::instance().wait(ms < maxSleep ? ms : maxSleep) == Wakeup::eReadable;
+    if (inputRead || readAgain) {
+        for (lv_indev_t *indev = lv_indev_get_next(nullptr); indev; indev = lv_indev_get_next(indev))
+            lv_indev_read(indev);
+    }
+}
+
+struct Result {
+    double wakeups; // per s
+    double cpu;     // %
+};
+
+/**
+ * Runs the loop for c_runMs, with a thread pressing and releasing the button if withInput.
+ */
+Result run(bool current, bool withInput)
+{
+    if (current) {
+        lv_tick_set_cb([]() -> uint32_t { return uint32_t(FrameStats::now() / 1000); });
+        lv_timer_handler_set_resume_cb(timer_resume_cb, nullptr);
+    } else {
+        lv_tick_set_cb(nullptr);
+        lv_timer_handler_set_resume_cb(nullptr, nullptr);
+    }
+    lastTimerRun = lv_tick_get();
+    timeUntilNext = 0;
+    inputRead = false;
+
+    drawBuf.assign(c_width * c_height / 8 * 2, 0);
+    lv_display_t *disp = lv_display_create(c_width, c_height);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB565);
+    lv_display_set_buffers(disp, drawBuf.data(), nullptr, drawBuf.size(), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, flush);
+    lv_display_add_event_cb(disp, render_ready_cb, LV_EVENT_RENDER_READY, nullptr);
+    lv_display_set_default(disp);
+
+    lv_indev_t *indev = lv_indev_create();
+    lv_indev_set_type(indev, LV_INDEV_TYPE_POINTER);
+    lv_indev_set_read_cb(indev, pointer_read_cb);
+    lv_indev_set_display(indev, disp);
+    if (current)
+        lv_indev_set_mode(indev, LV_INDEV_MODE_EVENT); // the pipe is watched, as LinuxInputDriver does
+
+    lv_obj_t *button = lv_button_create(lv_display_get_screen_active(disp));
+    lv_obj_set_size(button, c_width / 2, c_height / 2);
+    lv_obj_center(button);
+    lv_obj_t *label = lv_label_create(button);
+    lv_label_set_text(label, "released");
+    lv_obj_center(label);
+    lv_obj_add_event_cb(button, button_event_cb, LV_EVENT_ALL, label);
+
+    int fds[2];
+    REQUIRE(pipe2(fds, O_NONBLOCK | O_CLOEXEC) == 0);
+    Wakeup::instance().watch(fds[0]);
+
+    pressed = false;
+    shownAfter = 0;
+    latency.clear();
+    std::atomic<bool> done(false);
+    std::thread input;
+    if (withInput) {
+        input = std::thread([&done, &fds] {
+            while (!done) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(c_inputPeriod));
+                inputAt = FrameStats::now();
+                pressed = !pressed;
+                (void)write(fds[1], "", 1);
+            }
+        });
+    }
+
+    // settle: first frame and any theme animations
+    for (uint64_t end = FrameStats::now() + 500000; FrameStats::now() < end;)
+        current ? newLoop() : oldLoop();
+    latency.clear();
+
+    uint32_t wakeups = 0;
+    uint64_t start = FrameStats::now();
+    uint64_t cpu = threadCpuUs();
+    while (FrameStats::now() - start < uint64_t(c_runMs) * 1000) {
+        current ? newLoop() : oldLoop();
+        wakeups++;
+    }
+    cpu = threadCpuUs() - cpu;
+    uint64_t wall = FrameStats::now() - start;
+
+    done = true;
+    if (input.joinable())
+        input.join();
+    Wakeup::instance().unwatch(fds[0]);
+    close(fds[0]);
+    close(fds[1]);
+    lv_indev_delete(indev);
+    lv_display_delete(disp);
+    lv_tick_set_cb(nullptr);
+    lv_timer_handler_set_resume_cb(nullptr, nullptr);
+
+    return {wakeups * 1000000.0 / wall, cpu * 100.0 / wall};
+}
+} // namespace
+
+TEST_CASE("MainLoop: idle wakeups and input latency")
+{
+    Benchmark bench("mainloop");
+    if (!lv_is_initialized())
+        lv_init();
+    lv_display_t *previous = lv_display_get_default();
+
+    for (bool current : {false, true}) {
+        const char *loop = current ? "wakeup loop" : "10 ms loop";
+        char label[64];
+
+        Result idle = run(current, false);
+        snprintf(label, sizeof(label), "%s: idle wakeups", loop);
+        bench.report(label, idle.wakeups, "/s");
+        snprintf(label, sizeof(label), "%s: idle CPU", loop);
+        bench.report(label, idle.cpu, "%");
+
+        run(current, true);
+        CHECK(latency.count() > c_runMs / c_inputPeriod / 2);
+        snprintf(label, sizeof(label), "%s: input to render p50", loop);
+        bench.report(label, latency.percentile(50) / 1000.0, "ms");
+        snprintf(label, sizeof(label), "%s: input to render p99", loop);
+        bench.report(label, latency.percentile(99) / 1000.0, "ms");
+    }
+    if (previous)
+        lv_display_set_default(previous);
+}
+
+#endif
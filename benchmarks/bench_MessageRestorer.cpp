@@ -0,0 +1,157 @@
+#include "Benchmark.h"
+#include "util/MessageRestorer.h"
+#include <algorithm>
+#include <doctest/doctest.h>
+#include <functional>
+#include <random>
+#include <vector>
+
+/**
+ * Time-to-interactive for restoring the message log at startup.
+ * The UI is interactive again when all stored messages are in the view. Each runOnce() call is
+ * modelled as one frame of the Portduino main loop (at least 10ms) and creating a message in the
+ * view is emulated with a fixed cost per message. The log is read from memory, so file system
+ * reads are not part of the figures.
+ */
+
+namespace
+{
+constexpr uint32_t ownNode = 0x1000;
+constexpr uint32_t numChannels = 8;
+constexpr uint32_t numPeers = 32;
+constexpr auto c_framePeriod = std::chrono::microseconds(10000);
+constexpr auto c_viewCost = std::chrono::microseconds(200); // creating one message container in the view
+constexpr uint32_t c_blockSize = 256;                       // same as in ViewController
+constexpr uint32_t c_budgetMs = 8;
+
+struct Stored {
+    uint32_t from;
+    uint32_t to;
+    uint8_t ch;
+    uint16_t len;
+};
+
+std::vector<Stored> createLog(uint32_t count)
+{
+    std::mt19937 rnd(4711);
+    std::vector<Stored> log;
+    log.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t chat = rnd() % (numChannels + numPeers);
+        uint16_t len = 20 + rnd() % 120;
+        if (chat < numChannels)
+            log.push_back({0x2000 + (uint32_t)(rnd() % 50), UINT32_MAX, (uint8_t)chat, len});
+        else if (rnd() % 2)
+            log.push_back({ownNode, 0x3000 + chat, 0, len});
+        else
+            log.push_back({0x3000 + chat, ownNode, 0, len});
+    }
+    return log;
+}
+
+struct Reader {
+    const std::vector<Stored> &log;
+    size_t pos;
+    bool operator()(LogMessageEnv &msg)
+    {
+        if (pos >= log.size())
+            return false;
+        const Stored &s = log[pos++];
+        msg._size = s.len;
+        msg.time = pos;
+        msg.from = s.from;
+        msg.to = s.to;
+        msg.ch = s.ch;
+        msg.status = LogMessage::eDefault;
+        msg.trashFlag = false;
+        memset(msg.bytes, 'x', s.len);
+        msg.bytes[s.len] = 0;
+        return true;
+    }
+};
+
+struct Result {
+    uint32_t frames;
+    uint32_t created;
+    double cpuMs;
+    double ttiMs;
+};
+
+void frameDone(Result &result, Benchmark::Clock::time_point start)
+{
+    auto work = Benchmark::Clock::now() - start;
+    result.frames++;
+    result.cpuMs += std::chrono::duration<double, std::milli>(work).count();
+    result.ttiMs += std::chrono::duration<double, std::milli>(std::max<Benchmark::Clock::duration>(work, c_framePeriod)).count();
+}
+
+// previous implementation: one log entry read and created per runOnce()
+Result legacyRestore(const std::vector<Stored> &log)
+{
+    Result result{};
+    Reader reader{log, 0};
+    LogMessageEnv msg;
+    while (true) {
+        auto start = Benchmark::Clock::now();
+        bool more = reader(msg);
+        if (more) {
+            Benchmark::spin(c_viewCost);
+            result.created++;
+        }
+        frameDone(result, start);
+        if (!more)
+            break;
+    }
+    return result;
+}
+
+Result batchedRestore(const std::vector<Stored> &log)
+{
+    Result result{};
+    Reader reader{log, 0};
+    MessageRestorer restorer;
+    restorer.begin(ownNode);
+    while (true) {
+        auto start = Benchmark::Clock::now();
+        bool done = false;
+        if (restorer.load(std::ref(reader), c_blockSize)) {
+            done = restorer.restore(
+                [&](const LogMessage &, bool, bool) {
+                    Benchmark::spin(c_viewCost);
+                    result.created++;
+                },
+                c_budgetMs);
+        }
+        frameDone(result, start);
+        if (done)
+            break;
+    }
+    return result;
+}
+
+void report(Benchmark &bench, const char *label, uint32_t count, const Result &r)
+{
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%s %5u msgs: frames", label, count);
+    bench.report(buf, r.frames, "");
+    snprintf(buf, sizeof(buf), "%s %5u msgs: messages created", label, count);
+    bench.report(buf, r.created, "");
+    snprintf(buf, sizeof(buf), "%s %5u msgs: cpu", label, count);
+    bench.report(buf, r.cpuMs, "ms");
+    snprintf(buf, sizeof(buf), "%s %5u msgs: time-to-interactive", label, count);
+    bench.report(buf, r.ttiMs, "ms");
+}
+} // namespace
+
+TEST_CASE("MessageRestorer: time-to-interactive")
+{
+    Benchmark bench("restore");
+    for (uint32_t count : {0u, 1000u, 10000u}) {
+        std::vector<Stored> log = createLog(count);
+        Result legacy = legacyRestore(log);
+        Result batched = batchedRestore(log);
+        report(bench, "legacy ", count, legacy);
+        report(bench, "batched", count, batched);
+        CHECK(batched.ttiMs <= legacy.ttiMs);
+    }
+}
@@ -0,0 +1,222 @@
+#include "Benchmark.h"
+#include "lvgl.h"
+#include "util/NodeDB.h"
+#include <algorithm>
+#include <doctest/doctest.h>
+#include <random>
+#include <string.h>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Node list workloads with 1000 nodes: the previous widget-backed state (node data in the
+ * user_data of the panel children, read back through the lv_obj tree) compared to the NodeDB
+ * columns. Runs in a headless LVGL instance without rendering.
+ */
+
+namespace
+{
+constexpr uint32_t c_nodes = 1000;
+constexpr uint32_t c_updates = 20000;
+constexpr int c_runs = 20;
+constexpr time_t c_now = 1700000000;
+
+// children of a node panel as created by addNode()
+enum { img_idx, btn_idx, lbl_idx, lbs_idx, bat_idx, lh_idx, sig_idx, pos1_idx, pos2_idx, tm1_idx, tm2_idx, c_children };
+
+uint8_t drawBuf[320 * 20 * 2];
+
+void flush(lv_display_t *disp, const lv_area_t *, uint8_t *)
+{
+    lv_display_flush_ready(disp);
+}
+
+lv_display_t *headlessDisplay(void)
+{
+    if (!lv_is_initialized())
+        lv_init();
+    lv_display_t *disp = lv_display_get_default();
+    if (!disp) {
+        disp = lv_display_create(320, 240);
+        lv_display_set_buffers(disp, drawBuf, nullptr, sizeof(drawBuf), LV_DISPLAY_RENDER_MODE_PARTIAL);
+        lv_display_set_flush_cb(disp, flush);
+    }
+    return disp;
+}
+
+struct Node {
+    uint32_t num;
+    uint32_t lastHeard;
+    int8_t hops;
+    uint8_t ch;
+    bool hasKey;
+    char shortName[5];
+    char longName[24];
+};
+
+std::vector<Node> makeNodes(void)
+{
+    std::mt19937 rnd(31);
+    std::vector<Node> nodes(c_nodes);
+    for (uint32_t i = 0; i < c_nodes; i++) {
+        Node &n = nodes[i];
+        n.num = rnd();
+        n.lastHeard = rnd() % 8 ? c_now - rnd() % 20000 : 0;
+        n.hops = (int)(rnd() % 9) - 1;
+        n.ch = rnd() % 8;
+        n.hasKey = rnd() % 2;
+        snprintf(n.shortName, sizeof(n.shortName), "%04x", n.num & 0xffff);
+        snprintf(n.longName, sizeof(n.longName), "Meshtastic %04x node %u", n.num & 0xffff, i);
+    }
+    return nodes;
+}
+
+lv_obj_t *widgetPanel(lv_obj_t *parent, const Node &n)
+{
+    lv_obj_t *p = lv_obj_create(parent);
+    p->user_data = (void *)(unsigned long)n.ch;
+    for (int i = 0; i < c_children; i++) {
+        lv_obj_t *child = i == img_idx ? lv_image_create(p) : i == btn_idx ? lv_button_create(p) : lv_label_create(p);
+        if (i == lbl_idx)
+            lv_label_set_text(child, n.longName);
+        else if (i == lbs_idx)
+            lv_label_set_text(child, n.shortName);
+        else if (i >= bat_idx)
+            lv_label_set_text(child, "");
+    }
+    lv_obj_get_child(p, lbl_idx)->user_data = (void *)(unsigned long)n.num;
+    lv_obj_get_child(p, bat_idx)->user_data = (void *)(unsigned long)n.hasKey;
+    lv_obj_get_child(p, lh_idx)->user_data = (void *)(unsigned long)n.lastHeard;
+    lv_obj_get_child(p, sig_idx)->user_data = (void *)(long)n.hops;
+    return p;
+}
+
+bool widgetFilter(lv_obj_t *p, const char *name)
+{
+    time_t lastHeard = (time_t)lv_obj_get_child(p, lh_idx)->user_data;
+    if (lastHeard == 0 || c_now - lastHeard > 7200)
+        return true;
+    if ((unsigned long)lv_obj_get_child(p, bat_idx)->user_data != 1)
+        return true;
+    if ((signed long)lv_obj_get_child(p, sig_idx)->user_data > 3)
+        return true;
+    return !strcasestr(lv_label_get_text(lv_obj_get_child(p, lbl_idx)), name) &&
+           !strcasestr(lv_label_get_text(lv_obj_get_child(p, lbs_idx)), name);
+}
+
+bool modelFilter(const NodeDB &db, uint32_t slot, const char *name)
+{
+    time_t lastHeard = db.lastHeard(slot);
+    if (lastHeard == 0 || c_now - lastHeard > 7200)
+        return true;
+    if (!db.hasFlag(slot, NodeDB::eHasKey))
+        return true;
+    if (db.hopsAway(slot) > 3)
+        return true;
+    return !strcasestr(db.longName(slot), name) && !strcasestr(db.shortName(slot), name);
+}
+} // namespace
+
+TEST_CASE("NodeDB: 1000 node update/sort/filter")
+{
+    headlessDisplay();
+    std::vector<Node> nodes = makeNodes();
+    std::mt19937 rnd(7);
+    std::vector<uint32_t> updates(c_updates);
+    for (auto &u : updates)
+        u = nodes[rnd() % c_nodes].num;
+    const char *name = "node 5";
+
+    Benchmark bench("nodedb");
+
+    // widget-backed state
+    size_t freeBefore, freeAfter;
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    freeBefore = mon.free_size;
+
+    lv_obj_t *list = lv_obj_create(lv_screen_active());
+    std::unordered_map<uint32_t, lv_obj_t *> panels;
+    bench.restart();
+    for (const Node &n : nodes)
+        panels[n.num] = widgetPanel(list, n);
+    bench.report("widgets: create", bench.elapsedMs(), "ms");
+
+    lv_mem_monitor(&mon);
+    freeAfter = mon.free_size;
+    bench.report("widgets: memory per node", double(freeBefore - freeAfter) / c_nodes, "bytes");
+
+    bench.restart();
+    for (int run = 0; run < c_runs; run++) {
+        for (uint32_t i = 0; i < c_updates; i++) {
+            lv_obj_t *p = panels[updates[i]];
+            lv_obj_get_child(p, lh_idx)->user_data = (void *)(unsigned long)(c_now - i % 100);
+            lv_obj_get_child(p, sig_idx)->user_data = (void *)(long)(i % 4);
+        }
+    }
+    bench.report("widgets: update (20k)", bench.elapsedMs() / c_runs, "ms");
+
+    std::vector<lv_obj_t *> order;
+    bench.restart();
+    for (int run = 0; run < c_runs; run++) {
+        order.assign(list->spec_attr->children, list->spec_attr->children + list->spec_attr->child_cnt);
+        std::stable_sort(order.begin(), order.end(), [](lv_obj_t *a, lv_obj_t *b) {
+            return (time_t)lv_obj_get_child(a, lh_idx)->user_data > (time_t)lv_obj_get_child(b, lh_idx)->user_data;
+        });
+    }
+    bench.report("widgets: sort by last heard", bench.elapsedMs() / c_runs, "ms");
+
+    uint32_t hiddenWidgets = 0;
+    bench.restart();
+    for (int run = 0; run < c_runs; run++) {
+        hiddenWidgets = 0;
+        for (auto &it : panels)
+            hiddenWidgets += widgetFilter(it.second, name);
+    }
+    bench.report("widgets: filter", bench.elapsedMs() / c_runs, "ms");
+
+    // data model
+    NodeDB db;
+    bench.restart();
+    for (const Node &n : nodes) {
+        uint32_t slot = db.add(n.num);
+        db.setNames(slot, n.shortName, n.longName);
+        db.setChannel(slot, n.ch);
+        db.setLastHeard(slot, n.lastHeard);
+        db.setHopsAway(slot, n.hops);
+        db.setFlag(slot, NodeDB::eHasKey, n.hasKey);
+    }
+    bench.report("nodedb: create", bench.elapsedMs(), "ms");
+
+    bench.restart();
+    for (int run = 0; run < c_runs; run++) {
+        for (uint32_t i = 0; i < c_updates; i++) {
+            uint32_t slot = db.find(updates[i]);
+            db.setLastHeard(slot, c_now - i % 100);
+            db.setHopsAway(slot, i % 4);
+        }
+    }
+    bench.report("nodedb: update (20k)", bench.elapsedMs() / c_runs, "ms");
+
+    std::vector<uint32_t> sorted;
+    bench.restart();
+    for (int run = 0; run < c_runs; run++)
+        sorted = db.sortedByLastHeard();
+    bench.report("nodedb: sort by last heard", bench.elapsedMs() / c_runs, "ms");
+
+    uint32_t hiddenModel = 0;
+    bench.restart();
+    for (int run = 0; run < c_runs; run++) {
+        hiddenModel = 0;
+        for (uint32_t slot = 0; slot < db.size(); slot++)
+            hiddenModel += modelFilter(db, slot, name);
+    }
+    bench.report("nodedb: filter", bench.elapsedMs() / c_runs, "ms");
+
+    CHECK(hiddenModel == hiddenWidgets);
+    REQUIRE(sorted.size() == order.size());
+    for (size_t i = 0; i < sorted.size(); i++)
+        CHECK((time_t)lv_obj_get_child(order[i], lh_idx)->user_data == db.lastHeard(db.find(sorted[i])));
+
+    lv_obj_delete(list);
+}
@@ -0,0 +1,119 @@
+#include "Benchmark.h"
+#include "util/NodeDB.h"
+#include "util/NodeEviction.h"
+#include <algorithm>
+#include <doctest/doctest.h>
+#include <random>
+#include <stdio.h>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * 10000 add/evict cycles on a full node list (as during config sync with more nodes than the
+ * view can hold): the previous backwards scan over the node panels (nodeDB and chat lookups per
+ * panel, restarted under the 80/20 rule) compared to the NodeEviction indexes.
+ */
+
+namespace
+{
+constexpr uint32_t c_cycles = 10000;
+constexpr uint32_t c_listSizes[] = {250, 2000};
+constexpr time_t c_now = 1700000000;
+
+struct NewNode {
+    uint32_t num;
+    uint32_t lastHeard;
+    bool unknown;
+};
+
+std::vector<NewNode> makeNodes(uint32_t count, std::mt19937 &rnd)
+{
+    std::vector<NewNode> nodes(count);
+    for (uint32_t i = 0; i < count; i++)
+        nodes[i] = NewNode{0x10000 + i, uint32_t(c_now - rnd() % 86400), rnd() % 10 < 3};
+    return nodes;
+}
+
+// node numbers ordered like the panels: most recently heard first
+void insertOrdered(std::vector<uint32_t> &order, const NodeDB &db, uint32_t num, uint32_t lastHeard)
+{
+    size_t i = order.size();
+    while (i > 0 && lastHeard > db.lastHeard(db.find(order[i - 1])))
+        i--;
+    order.insert(order.begin() + i, num);
+}
+
+// previous purgeNode() logic
+uint32_t scanVictim(const std::vector<uint32_t> &order, const NodeDB &db, const std::unordered_map<uint32_t, int> &chats,
+                    uint32_t nodeNum)
+{
+    int last = order.size() - 1;
+    int i = last;
+    auto keep = [&](uint32_t num) {
+        uint32_t slot = db.find(num);
+        return slot == NodeDB::c_noSlot || db.role(slot) != NodeDB::c_unknownRole || c_now < (time_t)db.lastHeard(slot) + 120 ||
+               num == nodeNum || chats.find(num) != chats.end();
+    };
+    while (keep(order[i])) {
+        if (i < (last + 1) / 5) {
+            i = last;
+            break;
+        }
+        i--;
+    }
+    return order[i];
+}
+} // namespace
+
+TEST_CASE("NodeEviction: 10k add/evict cycles")
+{
+    Benchmark bench("nodeeviction");
+    char label[64];
+
+    for (uint32_t listSize : c_listSizes) {
+        std::mt19937 rnd(33);
+        std::vector<NewNode> nodes = makeNodes(listSize + c_cycles, rnd);
+        std::unordered_map<uint32_t, int> chats;
+        for (uint32_t i = 0; i < listSize; i += 20)
+            chats[nodes[i].num] = 0;
+
+        // panel scan
+        NodeDB db;
+        std::vector<uint32_t> order;
+        auto addScan = [&](const NewNode &n) {
+            uint32_t slot = db.add(n.num);
+            db.setLastHeard(slot, n.lastHeard);
+            db.setRole(slot, n.unknown ? NodeDB::c_unknownRole : 1);
+            insertOrdered(order, db, n.num, n.lastHeard);
+        };
+        for (uint32_t i = 0; i < listSize; i++)
+            addScan(nodes[i]);
+
+        bench.restart();
+        for (uint32_t i = listSize; i < listSize + c_cycles; i++) {
+            uint32_t victim = scanVictim(order, db, chats, nodes[i].num);
+            order.erase(std::find(order.begin(), order.end(), victim));
+            db.remove(victim);
+            addScan(nodes[i]);
+        }
+        snprintf(label, sizeof(label), "panel scan %u nodes", listSize);
+        bench.report(label, bench.elapsedMs(), "ms");
+
+        // eviction indexes
+        NodeEviction ev;
+        for (uint32_t i = 0; i < listSize; i++)
+            ev.add(nodes[i].num, nodes[i].lastHeard, nodes[i].unknown, chats.count(nodes[i].num));
+
+        bench.restart();
+        for (uint32_t i = listSize; i < listSize + c_cycles; i++) {
+            uint32_t victim = ev.victim(c_now, nodes[i].num);
+            ev.remove(victim);
+            ev.add(nodes[i].num, nodes[i].lastHeard, nodes[i].unknown);
+        }
+        snprintf(label, sizeof(label), "eviction index %u nodes", listSize);
+        bench.report(label, bench.elapsedMs(), "ms");
+
+        CHECK(ev.size() == listSize);
+        CHECK(order.size() == listSize);
+    }
+}
@@ -0,0 +1,101 @@
+#include "Benchmark.h"
+#include "util/NodeFilter.h"
+#include <doctest/doctest.h>
+#include <random>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+/**
+ * Latency of one keystroke in the node name filter while typing a query character by character,
+ * for 250 and 5000 nodes with the "online" and "public key" criteria active: the previous
+ * per-node criteria checks plus strcasestr() on the short and long name, compared to NodeFilter.
+ */
+
+namespace
+{
+constexpr int c_rounds = 20;
+const char *const c_query = "meshtastic 4";
+
+struct Node {
+    uint32_t num;
+    char shortName[5];
+    std::string longName;
+    bool online;
+    bool hasKey;
+};
+
+std::vector<Node> makeNodes(uint32_t count)
+{
+    static const char *const words[] = {"Meshtastic", "Base", "Mobile", "Gateway", "Relay", "Ёжик", "Straße", "Node"};
+    std::mt19937 rnd(35);
+    std::vector<Node> nodes(count);
+    for (uint32_t i = 0; i < count; i++) {
+        Node &n = nodes[i];
+        n.num = 0x10000000 + rnd() % 0x0fffffff;
+        snprintf(n.shortName, sizeof(n.shortName), "%04x", n.num & 0xffff);
+        n.longName = std::string(words[rnd() % 8]) + " " + words[rnd() % 8] + " " + std::to_string(i);
+        n.online = rnd() % 3 != 0;
+        n.hasKey = rnd() % 4 != 0;
+    }
+    return nodes;
+}
+
+// previous applyNodesFilter() criteria and name search for one node
+bool previousHidden(const Node &n, const char *name)
+{
+    if (!n.online || !n.hasKey)
+        return true;
+    return !strcasestr(n.longName.c_str(), name) && !strcasestr(n.shortName, name);
+}
+} // namespace
+
+TEST_CASE("NodeFilter: keystroke latency")
+{
+    Benchmark bench("node filter");
+    char label[64];
+    size_t len = strlen(c_query);
+
+    for (uint32_t count : {250u, 5000u}) {
+        std::vector<Node> nodes = makeNodes(count);
+        uint32_t hiddenPrevious = 0, hiddenFilter = 0;
+
+        bench.restart();
+        for (int r = 0; r < c_rounds; r++) {
+            for (size_t k = 1; k <= len; k++) {
+                std::string query(c_query, k);
+                hiddenPrevious = 0;
+                for (const Node &n : nodes)
+                    hiddenPrevious += previousHidden(n, query.c_str());
+            }
+        }
+        snprintf(label, sizeof(label), "previous %u nodes: per keystroke", count);
+        bench.report(label, bench.elapsedUs() / (c_rounds * len), "us");
+
+        NodeFilter filter;
+        for (const Node &n : nodes) {
+            filter.setKey(n.num, n.shortName, n.longName.c_str());
+            filter.set(n.num, NodeFilter::eOnline, n.online);
+            filter.set(n.num, NodeFilter::eHasKey, n.hasKey);
+        }
+        filter.require(NodeFilter::eOnline, true);
+        filter.require(NodeFilter::eHasKey, true);
+
+        uint32_t visited = 0;
+        bench.restart();
+        for (int r = 0; r < c_rounds; r++) {
+            for (size_t k = 1; k <= len; k++) {
+                filter.setQuery(std::string(c_query, k).c_str());
+                hiddenFilter = filter.apply([&](uint32_t, bool) { visited++; });
+            }
+        }
+        snprintf(label, sizeof(label), "filter %u nodes: per keystroke", count);
+        bench.report(label, bench.elapsedUs() / (c_rounds * len), "us");
+        snprintf(label, sizeof(label), "filter %u nodes: hidden", count);
+        bench.report(label, hiddenFilter, "");
+
+        CHECK(visited == count * c_rounds * len);
+        CHECK(hiddenFilter == hiddenPrevious);
+    }
+}
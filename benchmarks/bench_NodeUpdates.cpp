@@ -0,0 +1,270 @@
+#include "Benchmark.h"
+#include "lvgl.h"
+#include "util/NodeUpdates.h"
+#include <algorithm>
+#include <doctest/doctest.h>
+#include <random>
+#include <stdio.h>
+#include <string.h>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Replay of a telemetry burst as it arrives after a mesh-wide restart: 80 nodes send device
+ * and environment metrics (and a position) right after each other within two seconds and every
+ * packet is heard again through up to three relays a few ms later. The previous synchronous updates (sprintf and lv_label_set_text for every
+ * packet, node moved to the top of the list each time) compared to NodeUpdates flushed once
+ * per frame, writing only labels whose text changed. Reports label writes (each invalidates
+ * the label), the rendering time of all frames and the CPU time per packet.
+ */
+
+namespace
+{
+constexpr uint32_t c_nodes = 80;
+constexpr uint32_t c_burstMs = 2000;
+constexpr uint32_t c_frameMs = 33;
+
+uint8_t drawBuf[320 * 24 * 2];
+
+void flush(lv_display_t *disp, const lv_area_t *, uint8_t *)
+{
+    lv_display_flush_ready(disp);
+}
+
+lv_display_t *headlessDisplay(void)
+{
+    if (!lv_is_initialized())
+        lv_init();
+    lv_display_t *disp = lv_display_get_default();
+    if (!disp) {
+        disp = lv_display_create(320, 240);
+        lv_display_set_buffers(disp, drawBuf, nullptr, sizeof(drawBuf), LV_DISPLAY_RENDER_MODE_PARTIAL);
+        lv_display_set_flush_cb(disp, flush);
+    }
+    return disp;
+}
+
+enum Kind : uint8_t { eDeviceMetrics, eEnvironmentMetrics, eOther };
+
+// the part of a FromRadio packet that ViewController::packetReceived() hands to the view
+struct Packet {
+    uint32_t time; // ms into the burst
+    uint32_t from;
+    Kind kind;
+    uint8_t hopsAway;
+    int16_t rssi;
+    float snr;
+    NodeUpdates::Metrics metrics;
+    NodeUpdates::Environment environment;
+};
+
+std::vector<Packet> recordBurst(void)
+{
+    std::mt19937 rnd(40);
+    std::vector<Packet> packets;
+    for (uint32_t n = 0; n < c_nodes; n++) {
+        uint32_t from = 0x1000 + n;
+        uint32_t boot = rnd() % (c_burstMs - 300);
+        for (Kind kind : {eDeviceMetrics, eEnvironmentMetrics, eOther}) {
+            Packet p{};
+            p.time = boot + rnd() % 100;
+            p.from = from;
+            p.kind = kind;
+            p.hopsAway = rnd() % 3;
+            p.metrics = NodeUpdates::Metrics{60 + n % 40, 3.7f + (n % 5) * 0.1f, 10.0f + n % 7, 1.0f + n % 3};
+            p.environment = NodeUpdates::Environment{18.0f + n % 9, 40.0f + n % 20, 1013.0f, 50 + n, 0.0f, 0.0f};
+            // the original and up to three relayed copies with their own signal
+            uint32_t copies = 1 + rnd() % 4;
+            for (uint32_t c = 0; c < copies; c++) {
+                p.rssi = -70 - int16_t(rnd() % 50);
+                p.snr = float(int(rnd() % 40) - 20) / 4;
+                packets.push_back(p);
+                p.time += 5 + rnd() % 40;
+                p.hopsAway++;
+            }
+        }
+    }
+    std::stable_sort(packets.begin(), packets.end(), [](const Packet &a, const Packet &b) { return a.time < b.time; });
+    return packets;
+}
+
+struct Panel {
+    lv_obj_t *panel, *sig, *bat, *tm1, *lh;
+};
+
+struct NodeList {
+    lv_obj_t *list;
+    std::unordered_map<uint32_t, Panel> nodes;
+    uint32_t writes = 0;
+
+    NodeList(void)
+    {
+        list = lv_obj_create(lv_screen_active());
+        lv_obj_set_size(list, 320, 240);
+        lv_obj_set_flex_flow(list, LV_FLEX_FLOW_COLUMN);
+        for (uint32_t n = 0; n < c_nodes; n++) {
+            Panel p;
+            p.panel = lv_obj_create(list);
+            lv_obj_set_size(p.panel, 300, 60);
+            p.sig = lv_label_create(p.panel);
+            p.bat = lv_label_create(p.panel);
+            p.tm1 = lv_label_create(p.panel);
+            p.lh = lv_label_create(p.panel);
+            lv_obj_set_y(p.bat, 15);
+            lv_obj_set_y(p.tm1, 30);
+            lv_obj_set_y(p.lh, 45);
+            nodes[0x1000 + n] = p;
+        }
+    }
+    ~NodeList() { lv_obj_delete(list); }
+
+    void setText(lv_obj_t *label, const char *text)
+    {
+        lv_label_set_text(label, text);
+        writes++;
+    }
+    // TFTView_Common::setLabelText()
+    void setTextIfChanged(lv_obj_t *label, const char *text)
+    {
+        if (strcmp(lv_label_get_text(label), text) != 0)
+            setText(label, text);
+    }
+};
+
+void formatMetrics(char *buf, const NodeUpdates::Metrics &m)
+{
+    sprintf(buf, "%d%% %0.2fV", (int)m.batteryLevel, m.voltage);
+}
+
+void formatEnvironment(char *buf, const NodeUpdates::Environment &e)
+{
+    sprintf(buf, "%2.1f°C %d%% %3.1fhPa", e.temperature, (int)e.relativeHumidity, e.barometricPressure);
+}
+
+void formatSignal(char *buf, const Packet &p)
+{
+    if (p.hopsAway == 0)
+        sprintf(buf, "rssi: %d snr: %.1f", p.rssi, p.snr);
+    else
+        sprintf(buf, "hops: %d", p.hopsAway);
+}
+
+// previous ViewController::packetReceived() -> view calls
+void previousPacket(NodeList &list, const Packet &p)
+{
+    char buf[48];
+    auto it = list.nodes.find(p.from);
+    formatSignal(buf, p);
+    list.setText(it->second.sig, buf);
+    it = list.nodes.find(p.from);
+    list.setText(it->second.lh, "now");
+    lv_obj_move_to_index(it->second.panel, 1);
+    it = list.nodes.find(p.from);
+    if (p.kind == eDeviceMetrics) {
+        formatMetrics(buf, p.metrics);
+        list.setText(it->second.bat, buf);
+    } else if (p.kind == eEnvironmentMetrics) {
+        formatEnvironment(buf, p.environment);
+        list.setText(it->second.tm1, buf);
+    }
+}
+
+void recordPacket(NodeUpdates &updates, const Packet &p)
+{
+    if (p.hopsAway == 0)
+        updates.setSignal(p.from, p.rssi, p.snr);
+    else
+        updates.setHopsAway(p.from, p.hopsAway);
+    updates.setLastHeard(p.from, false);
+    if (p.kind == eDeviceMetrics)
+        updates.setMetrics(p.from, p.metrics);
+    else if (p.kind == eEnvironmentMetrics)
+        updates.setEnvironment(p.from, p.environment);
+}
+
+void flushUpdates(NodeList &list, NodeUpdates &updates)
+{
+    updates.flush([&](const NodeUpdates::Update &u) {
+        char buf[48];
+        Panel &panel = list.nodes.find(u.nodeNum)->second;
+        if (u.dirty & NodeUpdates::eMetrics) {
+            formatMetrics(buf, u.metrics);
+            list.setTextIfChanged(panel.bat, buf);
+        }
+        if (u.dirty & NodeUpdates::eEnvironment) {
+            formatEnvironment(buf, u.environment);
+            list.setTextIfChanged(panel.tm1, buf);
+        }
+        if (u.dirty & (NodeUpdates::eSignal | NodeUpdates::eHopsAway)) {
+            Packet p{};
+            p.hopsAway = (u.dirty & NodeUpdates::eSignal) ? 0 : u.hopsAway;
+            p.rssi = u.rssi;
+            p.snr = u.snr;
+            formatSignal(buf, p);
+            list.setTextIfChanged(panel.sig, buf);
+        }
+        if (u.dirty & NodeUpdates::eLastHeard) {
+            list.setTextIfChanged(panel.lh, "now");
+            if (lv_obj_get_index(panel.panel) != 1)
+                lv_obj_move_to_index(panel.panel, 1);
+        }
+    });
+}
+
+template <class Receive, class Frame>
+void replay(Benchmark &bench, const char *name, const std::vector<Packet> &packets, NodeList &list, Receive receive,
+            Frame frame)
+{
+    lv_display_t *disp = headlessDisplay();
+    lv_refr_now(disp);
+    list.writes = 0;
+
+    char label[64];
+    double cpuUs = 0, renderUs = 0;
+    size_t next = 0;
+    for (uint32_t t = c_frameMs; next < packets.size(); t += c_frameMs) {
+        bench.restart();
+        for (; next < packets.size() && packets[next].time < t; next++)
+            receive(packets[next]);
+        frame();
+        cpuUs += bench.elapsedUs();
+
+        bench.restart();
+        lv_refr_now(disp);
+        renderUs += bench.elapsedUs();
+    }
+    snprintf(label, sizeof(label), "%s: label writes", name);
+    bench.report(label, list.writes, "");
+    snprintf(label, sizeof(label), "%s: render all frames", name);
+    bench.report(label, renderUs / 1000, "ms");
+    snprintf(label, sizeof(label), "%s: cpu per packet", name);
+    bench.report(label, cpuUs / packets.size(), "us");
+}
+} // namespace
+
+TEST_CASE("NodeUpdates: telemetry burst replay")
+{
+    headlessDisplay();
+    Benchmark bench("nodeupdates");
+    std::vector<Packet> packets = recordBurst();
+    bench.report("packets in burst", packets.size(), "");
+
+    uint32_t previousWrites, coalescedWrites;
+    {
+        NodeList list;
+        replay(
+            bench, "previous", packets, list, [&](const Packet &p) { previousPacket(list, p); }, [] {});
+        previousWrites = list.writes;
+    }
+    {
+        NodeList list;
+        NodeUpdates updates;
+        replay(
+            bench, "coalesced", packets, list, [&](const Packet &p) { recordPacket(updates, p); },
+            [&] { flushUpdates(list, updates); });
+        coalescedWrites = list.writes;
+        bench.report("coalesced: values merged", updates.coalesced(), "");
+        CHECK(updates.pending() == 0);
+    }
+    CHECK(coalescedWrites < previousWrites);
+}
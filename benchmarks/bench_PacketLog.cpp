@@ -0,0 +1,169 @@
+#include "Benchmark.h"
+#include "graphics/common/VirtualList.h"
+#include "lvgl.h"
+#include "util/PacketLog.h"
+#include <doctest/doctest.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * Packet log retaining 200 and 5000 packets: one label per packet (deleting the oldest one
+ * when full, as writePacketLog() did) compared to PacketLog records shown through a
+ * VirtualList. Reports the memory used for the retained packets and the cost of logging one
+ * packet including the refresh of the visible log. Labels stop being created when the LVGL
+ * heap runs low, which is reported.
+ */
+
+namespace
+{
+constexpr int c_packets = 300;
+constexpr int32_t c_rowHeight = 16;
+constexpr size_t c_heapReserve = 8 * 1024; // keep free for rendering
+constexpr uint32_t c_retained[] = {200, 5000};
+constexpr uint32_t c_ownNode = 0x1234abcd;
+
+uint8_t drawBuf[320 * 24 * 2];
+
+void flush(lv_display_t *disp, const lv_area_t *, uint8_t *)
+{
+    lv_display_flush_ready(disp);
+}
+
+lv_display_t *headlessDisplay(void)
+{
+    if (!lv_is_initialized())
+        lv_init();
+    lv_display_t *disp = lv_display_get_default();
+    if (!disp) {
+        disp = lv_display_create(320, 240);
+        lv_display_set_buffers(disp, drawBuf, nullptr, sizeof(drawBuf), LV_DISPLAY_RENDER_MODE_PARTIAL);
+        lv_display_set_flush_cb(disp, flush);
+    }
+    return disp;
+}
+
+size_t heapFree(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.free_size;
+}
+
+lv_obj_t *logPanel(void)
+{
+    lv_obj_t *panel = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(panel, 320, 200);
+    lv_obj_set_style_pad_all(panel, 0, LV_PART_MAIN);
+    return panel;
+}
+
+PacketLog::Entry packet(uint32_t n)
+{
+    PacketLog::Entry e{};
+    e.time = 1700000000 + n;
+    e.from = 0x10000 + n % 97;
+    e.to = n % 5 ? UINT32_MAX : c_ownNode;
+    e.port = n % 3 ? 3 : 67;
+    e.rssi = -90 - n % 20;
+    e.snr = 20 - n % 40;
+    e.hops = n % 4;
+    return e;
+}
+
+// previous label per packet, formatted on arrival
+void addLabel(lv_obj_t *panel, const PacketLog &log, uint32_t max)
+{
+    char buf[160];
+    log.format(log.size() - 1, "12:34:56", "ABCD", c_ownNode, buf, sizeof(buf));
+    if (lv_obj_get_child_count(panel) >= max)
+        lv_obj_delete(lv_obj_get_child(panel, 0));
+    lv_obj_t *pLabel = lv_label_create(panel);
+    lv_obj_set_size(pLabel, LV_PCT(100), LV_SIZE_CONTENT);
+    lv_obj_set_style_bg_opa(pLabel, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_label_set_text(pLabel, buf);
+    if (lv_obj_get_scroll_bottom(panel) < 20)
+        lv_obj_scroll_to_view(pLabel, LV_ANIM_OFF);
+}
+} // namespace
+
+TEST_CASE("PacketLog: per-packet cost and memory")
+{
+    lv_display_t *disp = headlessDisplay();
+    Benchmark bench("packetlog");
+    char label[64];
+
+    for (uint32_t retained : c_retained) {
+        // one label per packet
+        PacketLog scratch(1);
+        size_t before = heapFree();
+        lv_obj_t *panel = logPanel();
+        lv_obj_set_flex_flow(panel, LV_FLEX_FLOW_COLUMN);
+        uint32_t created = 0;
+        while (created < retained && heapFree() > c_heapReserve) {
+            scratch.push(packet(created));
+            addLabel(panel, scratch, retained);
+            created++;
+        }
+        lv_refr_now(disp);
+        snprintf(label, sizeof(label), "labels %u: created", retained);
+        bench.report(label, created, "labels");
+        snprintf(label, sizeof(label), "labels %u: heap", retained);
+        bench.report(label, before - heapFree(), "bytes");
+
+        bench.restart();
+        for (int i = 0; i < c_packets; i++) {
+            scratch.push(packet(created + i));
+            addLabel(panel, scratch, created);
+            lv_refr_now(disp);
+        }
+        snprintf(label, sizeof(label), "labels %u: per packet", retained);
+        bench.report(label, bench.elapsedUs() / c_packets, "us");
+        lv_obj_delete(panel);
+
+        // binary ring and recycled rows
+        before = heapFree();
+        panel = logPanel();
+        PacketLog log(retained);
+        {
+            char buf[160];
+            VirtualList list(
+                panel, c_rowHeight,
+                [](lv_obj_t *parent) {
+                    lv_obj_t *row = lv_label_create(parent);
+                    lv_obj_set_size(row, LV_PCT(100), c_rowHeight);
+                    lv_label_set_long_mode(row, LV_LABEL_LONG_DOT);
+                    lv_obj_set_style_bg_opa(row, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
+                    return row;
+                },
+                [&](lv_obj_t *row, uint32_t index) {
+                    log.format(index, "12:34:56", "ABCD", c_ownNode, buf, sizeof(buf));
+                    lv_label_set_text(row, buf);
+                });
+            for (uint32_t i = 0; i < retained; i++)
+                log.push(packet(i));
+            list.setCount(log.size());
+            lv_obj_scroll_by(panel, 0, -lv_obj_get_scroll_bottom(panel), LV_ANIM_OFF);
+            lv_refr_now(disp);
+            snprintf(label, sizeof(label), "ring %u: heap", retained);
+            bench.report(label, before - heapFree(), "bytes");
+            snprintf(label, sizeof(label), "ring %u: records", retained);
+            bench.report(label, log.capacity() * sizeof(PacketLog::Entry), "bytes");
+
+            bench.restart();
+            for (int i = 0; i < c_packets; i++) {
+                log.push(packet(retained + i));
+                bool atBottom = lv_obj_get_scroll_bottom(panel) < 20;
+                list.setCount(log.size());
+                if (atBottom)
+                    lv_obj_scroll_by(panel, 0, -lv_obj_get_scroll_bottom(panel), LV_ANIM_OFF);
+                lv_refr_now(disp);
+            }
+            snprintf(label, sizeof(label), "ring %u: per packet", retained);
+            bench.report(label, bench.elapsedUs() / c_packets, "us");
+
+            CHECK(log.size() == retained);
+            CHECK(lv_obj_get_child_count(panel) < 20);
+        }
+        lv_obj_delete(panel);
+    }
+}
@@ -0,0 +1,195 @@
+#include "Benchmark.h"
+#include "lvgl.h"
+#include "util/PacketStats.h"
+#include <algorithm>
+#include <doctest/doctest.h>
+#include <list>
+#include <random>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+/**
+ * One minute of 10000 packets from 1000 nodes (a few nodes send most of them) shown in a
+ * 12 row statistics table at 30 frames/s: the previous std::list with a linear search, a full
+ * sort and a rewrite of the changed rows per packet, compared to PacketStats with one table
+ * update per frame that writes only changed cells.
+ */
+
+namespace
+{
+constexpr uint32_t c_nodes = 1000;
+constexpr uint32_t c_packets = 10000;
+constexpr uint32_t c_frames = 30 * 60;
+constexpr uint32_t c_rows = 12;
+
+uint8_t drawBuf[320 * 24 * 2];
+
+void flush(lv_display_t *disp, const lv_area_t *, uint8_t *)
+{
+    lv_display_flush_ready(disp);
+}
+
+lv_display_t *headlessDisplay(void)
+{
+    if (!lv_is_initialized())
+        lv_init();
+    lv_display_t *disp = lv_display_get_default();
+    if (!disp) {
+        disp = lv_display_create(320, 240);
+        lv_display_set_buffers(disp, drawBuf, nullptr, sizeof(drawBuf), LV_DISPLAY_RENDER_MODE_PARTIAL);
+        lv_display_set_flush_cb(disp, flush);
+    }
+    return disp;
+}
+
+lv_obj_t *statisticsTable(void)
+{
+    lv_obj_t *table = lv_table_create(lv_screen_active());
+    lv_table_set_row_count(table, c_rows);
+    lv_table_set_column_count(table, 7);
+    return table;
+}
+
+struct Packet {
+    uint32_t from;
+    uint8_t counter;
+};
+
+std::vector<Packet> makePackets(void)
+{
+    std::mt19937 rnd(37);
+    std::geometric_distribution<uint32_t> pick(0.005);
+    std::vector<Packet> packets(c_packets);
+    for (Packet &p : packets)
+        p = Packet{0x1000 + pick(rnd) % c_nodes, uint8_t(rnd() % 6)};
+    return packets;
+}
+
+// previous updateStatistics()
+struct Stats {
+    uint32_t id;
+    uint16_t row;
+    uint16_t count[6];
+    uint32_t sum;
+
+    bool operator==(const Stats &rhs) const { return id == rhs.id; }
+    bool operator<(const Stats &rhs) const { return sum > rhs.sum; }
+};
+
+uint32_t previousUpdate(std::list<Stats> &stats, lv_obj_t *table, const Packet &p)
+{
+    Stats stat = {p.from};
+    stat.count[p.counter] = 1;
+    auto it = std::find(stats.begin(), stats.end(), stat);
+    if (it == stats.end()) {
+        stat.row = stats.size();
+        stat.sum = 1;
+        stats.push_back(stat);
+    } else {
+        for (int i = 0; i < 6; i++)
+            it->count[i] += stat.count[i];
+        it->sum++;
+    }
+    stats.sort();
+
+    uint32_t writes = 0;
+    char buf[10];
+    uint32_t row = 1;
+    bool move = false;
+    for (auto it2 : stats) {
+        if (it2.id == p.from || move) {
+            snprintf(buf, sizeof(buf), "%04x", it2.id & 0xffff);
+            lv_table_set_cell_value(table, row, 0, buf);
+            for (int j = 0; j < 6; j++) {
+                snprintf(buf, sizeof(buf), "%d", j < 5 ? it2.count[j] : it2.sum);
+                lv_table_set_cell_value(table, row, j + 1, buf);
+            }
+            writes += 7;
+            if (row != it2.row) {
+                it2.row = row;
+                move = true;
+            } else {
+                break;
+            }
+        }
+        row++;
+        if (row >= c_rows)
+            break;
+    }
+    return writes;
+}
+
+// new per-frame table update writing changed cells only
+uint32_t frameUpdate(const PacketStats &stats, std::vector<PacketStats::Node> &shown, lv_obj_t *table)
+{
+    const PacketStats::Node *top[c_rows];
+    uint32_t rows = stats.top(top, c_rows - 1);
+    shown.resize(std::max<size_t>(shown.size(), rows), PacketStats::Node{});
+    uint32_t writes = 0;
+    char buf[10];
+    for (uint32_t i = 0; i < rows; i++) {
+        const PacketStats::Node &node = *top[i];
+        if (shown[i].num != node.num) {
+            snprintf(buf, sizeof(buf), "%04x", node.num & 0xffff);
+            lv_table_set_cell_value(table, i + 1, 0, buf);
+            writes++;
+        }
+        for (int j = 0; j < 6; j++) {
+            uint32_t value = j < 5 ? node.count[j] : node.sum;
+            uint32_t old = j < 5 ? shown[i].count[j] : shown[i].sum;
+            if (shown[i].num != node.num || value != old) {
+                snprintf(buf, sizeof(buf), "%u", value);
+                lv_table_set_cell_value(table, i + 1, j + 1, buf);
+                writes++;
+            }
+        }
+        shown[i] = node;
+    }
+    return writes;
+}
+} // namespace
+
+TEST_CASE("PacketStats: 10k packets/min from 1000 nodes")
+{
+    headlessDisplay();
+    Benchmark bench("statistics");
+    std::vector<Packet> packets = makePackets();
+
+    std::list<Stats> stats;
+    lv_obj_t *table = statisticsTable();
+    uint32_t writes = 0;
+    bench.restart();
+    for (const Packet &p : packets)
+        writes += previousUpdate(stats, table, p);
+    double previousMs = bench.elapsedMs();
+    bench.report("previous: one minute", previousMs, "ms");
+    bench.report("previous: per packet", previousMs * 1000 / c_packets, "us");
+    bench.report("previous: cell writes", writes, "");
+    lv_obj_delete(table);
+
+    PacketStats packetStats(c_rows - 1);
+    std::vector<PacketStats::Node> shown;
+    table = statisticsTable();
+    writes = 0;
+    uint32_t next = 0;
+    bench.restart();
+    for (uint32_t frame = 0; frame < c_frames; frame++) {
+        bool changed = false;
+        for (; next < (frame + 1) * c_packets / c_frames; next++) {
+            packetStats.count(packets[next].from, PacketStats::Counter(packets[next].counter));
+            changed = true;
+        }
+        if (changed)
+            writes += frameUpdate(packetStats, shown, table);
+    }
+    double statsMs = bench.elapsedMs();
+    bench.report("stats: one minute", statsMs, "ms");
+    bench.report("stats: per packet", statsMs * 1000 / c_packets, "us");
+    bench.report("stats: cell writes", writes, "");
+    lv_obj_delete(table);
+
+    CHECK(next == c_packets);
+    CHECK(packetStats.size() == stats.size());
+    CHECK(shown[0].sum == stats.front().sum);
+}
@@ -0,0 +1,191 @@
+#include "Benchmark.h"
+#include "util/RequestId.h"
+#include "util/TimingWheel.h"
+#include <doctest/doctest.h>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * 10000 outstanding requests with a 60 s timeout, a quarter of them answered, while new ones
+ * keep coming in: the previous map scan in every task_handler() call and the random ids,
+ * compared to the timing wheel with counter based ids. Both sides keep the same map of
+ * pending requests, only the timeout bookkeeping and the id generation differ.
+ */
+
+namespace
+{
+constexpr uint32_t c_outstanding = 10000;
+constexpr uint32_t c_timeout = 60 * 1000;
+constexpr uint32_t c_minutes = 30;
+
+struct Request {
+    uint32_t id;
+    unsigned long timestamp;
+    void *cookie;
+};
+
+// previous ResponseHandler without the Arduino dependency
+class PreviousHandler
+{
+  public:
+    PreviousHandler(void) : rollingPacketId(random() & 0x7fffffff) {}
+
+    uint32_t addRequest(uint32_t id, unsigned long now)
+    {
+        uint32_t requestId = generatePacketId();
+        collisions += pending.count(requestId);
+        pending[requestId] = Request{id, now, nullptr};
+        return requestId;
+    }
+    void removeRequest(uint32_t requestId) { pending.erase(requestId); }
+    uint32_t task_handler(unsigned long now)
+    {
+        uint32_t expired = 0;
+        auto it = pending.begin();
+        while (it != pending.end()) {
+            if (it->second.timestamp + c_timeout < now) {
+                it = pending.erase(it);
+                expired++;
+            } else {
+                it++;
+            }
+        }
+        return expired;
+    }
+    uint32_t size(void) const { return pending.size(); }
+    uint32_t collisions = 0;
+
+  private:
+    uint32_t generatePacketId(void)
+    {
+        rollingPacketId++;
+        rollingPacketId &= UINT32_MAX >> 22;
+        return rollingPacketId | (random() & 0x7fffffff) << 10;
+    }
+
+    uint32_t rollingPacketId;
+    std::unordered_map<uint32_t, Request> pending;
+};
+
+// ResponseHandler with the timing wheel
+class WheelHandler
+{
+  public:
+    WheelHandler(void) : ids(random()), timeouts(1000, 64) {}
+
+    uint32_t addRequest(uint32_t id, unsigned long now)
+    {
+        uint32_t requestId;
+        do {
+            requestId = ids.next();
+            collisions += pending.count(requestId);
+        } while (pending.count(requestId));
+        Pending &p = pending[requestId];
+        p.request = Request{id, now, nullptr};
+        p.timer = timeouts.schedule(requestId, now, c_timeout);
+        return requestId;
+    }
+    void removeRequest(uint32_t requestId)
+    {
+        auto it = pending.find(requestId);
+        if (it != pending.end()) {
+            timeouts.cancel(it->second.timer);
+            pending.erase(it);
+        }
+    }
+    uint32_t task_handler(unsigned long now)
+    {
+        return timeouts.advance(now, [this](uint32_t requestId) { pending.erase(requestId); });
+    }
+    uint32_t size(void) const { return pending.size(); }
+    uint32_t collisions = 0;
+
+  private:
+    struct Pending {
+        Request request;
+        TimingWheel::Handle timer;
+    };
+    RequestId ids;
+    TimingWheel timeouts;
+    std::unordered_map<uint32_t, Pending> pending;
+};
+
+template <class Handler> void run(Benchmark &bench, const char *name, uint32_t taskInterval)
+{
+    char label[64];
+    std::mt19937 rnd(39);
+    Handler handler;
+    std::vector<uint32_t> open;
+    open.reserve(c_outstanding * 2);
+
+    // fill up within the first timeout
+    unsigned long now = 0;
+    bench.restart();
+    for (uint32_t i = 0; i < c_outstanding; i++) {
+        now = uint64_t(i) * (c_timeout / 2) / c_outstanding;
+        open.push_back(handler.addRequest(i, now));
+    }
+    snprintf(label, sizeof(label), "%s: add %u requests", name, c_outstanding);
+    bench.report(label, bench.elapsedMs(), "ms");
+
+    // steady state: every 6 ms a new request, every 24 ms an answer
+    double taskUs = 0, maxTaskUs = 0, addRemoveUs = 0;
+    uint32_t tasks = 0, expired = 0, ops = 0;
+    unsigned long end = now + c_minutes * 60 * 1000;
+    unsigned long nextTask = taskInterval;
+    while (now < end) {
+        bench.restart();
+        for (int k = 0; k < 100; k++) {
+            now += 6;
+            open.push_back(handler.addRequest(k, now));
+            if (k % 4 == 0 && !open.empty()) {
+                uint32_t i = rnd() % open.size();
+                handler.removeRequest(open[i]);
+                open[i] = open.back();
+                open.pop_back();
+            }
+            ops++;
+        }
+        addRemoveUs += bench.elapsedUs();
+        if (open.size() > c_outstanding * 2)
+            open.erase(open.begin(), open.begin() + c_outstanding); // oldest have timed out anyway
+
+        if (now >= nextTask) {
+            nextTask += taskInterval;
+            bench.restart();
+            expired += handler.task_handler(now);
+            double us = bench.elapsedUs();
+            taskUs += us;
+            maxTaskUs = us > maxTaskUs ? us : maxTaskUs;
+            tasks++;
+        }
+    }
+    snprintf(label, sizeof(label), "%s: add/remove per request", name);
+    bench.report(label, addRemoveUs / ops, "us");
+    snprintf(label, sizeof(label), "%s: task_handler mean", name);
+    bench.report(label, taskUs / tasks, "us");
+    snprintf(label, sizeof(label), "%s: task_handler max", name);
+    bench.report(label, maxTaskUs, "us");
+    snprintf(label, sizeof(label), "%s: expired", name);
+    bench.report(label, expired, "");
+    snprintf(label, sizeof(label), "%s: id collisions", name);
+    bench.report(label, handler.collisions, "");
+    snprintf(label, sizeof(label), "%s: outstanding", name);
+    bench.report(label, handler.size(), "");
+    CHECK(handler.size() >= c_outstanding / 2);
+}
+} // namespace
+
+TEST_CASE("ResponseHandler: 10000 outstanding requests")
+{
+    Benchmark bench("requests");
+    srandom(39);
+    // task_handler() every 20 s as in MeshtasticView, and every second for timely timeouts
+    run<PreviousHandler>(bench, "previous 20s", 20 * 1000);
+    run<WheelHandler>(bench, "wheel 20s", 20 * 1000);
+    run<PreviousHandler>(bench, "previous 1s", 1000);
+    run<WheelHandler>(bench, "wheel 1s", 1000);
+}
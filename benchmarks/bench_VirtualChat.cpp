@@ -0,0 +1,176 @@
+#include "Benchmark.h"
+#include "graphics/common/VirtualChat.h"
+#include "lvgl.h"
+#include <algorithm>
+#include <doctest/doctest.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+/**
+ * Chats with 100, 1000 and 10000 messages: a panel and a label per message (as newMessage()
+ * and addMessage() created them) compared to a VirtualChat with cached bubble sizes.
+ * Reports the LVGL heap used and the time to scroll by 40 px and render the frame into a
+ * headless display. Per-message widgets stop being created when the LVGL heap runs low,
+ * which is reported.
+ */
+
+namespace
+{
+constexpr int c_frames = 100;
+constexpr int32_t c_scrollStep = 40;
+constexpr int32_t c_gap = 6;
+constexpr size_t c_heapReserve = 8 * 1024; // keep free for rendering
+constexpr uint32_t c_counts[] = {100, 1000, 10000};
+
+uint8_t drawBuf[320 * 24 * 2];
+
+void flush(lv_display_t *disp, const lv_area_t *, uint8_t *)
+{
+    lv_display_flush_ready(disp);
+}
+
+lv_display_t *headlessDisplay(void)
+{
+    if (!lv_is_initialized())
+        lv_init();
+    lv_display_t *disp = lv_display_get_default();
+    if (!disp) {
+        disp = lv_display_create(320, 240);
+        lv_display_set_buffers(disp, drawBuf, nullptr, sizeof(drawBuf), LV_DISPLAY_RENDER_MODE_PARTIAL);
+        lv_display_set_flush_cb(disp, flush);
+    }
+    return disp;
+}
+
+size_t heapFree(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.free_size;
+}
+
+lv_obj_t *chatContainer(void)
+{
+    lv_obj_t *container = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(container);
+    lv_obj_set_size(container, 320, 200);
+    lv_obj_set_style_pad_hor(container, 6, LV_PART_MAIN);
+    lv_obj_set_style_pad_row(container, c_gap, LV_PART_MAIN);
+    lv_obj_set_flex_flow(container, LV_FLEX_FLOW_COLUMN);
+    return container;
+}
+
+std::vector<std::string> makeMessages(uint32_t count)
+{
+    static const char *const words[] = {"hello", "mesh", "node", "battery", "position", "ok", "relay", "73"};
+    std::vector<std::string> msgs(count);
+    for (uint32_t i = 0; i < count; i++) {
+        char time[16];
+        snprintf(time, sizeof(time), "%02u:%02u ", (i / 60) % 24, i % 60);
+        msgs[i] = time;
+        for (uint32_t w = 0; w < 2 + (i * 7) % 23; w++)
+            msgs[i] += std::string(words[(i + w) % 8]) + " ";
+    }
+    return msgs;
+}
+
+// previous bubble: a panel with a label, sized by the text width
+void addBubble(lv_obj_t *container, const char *text, bool sent)
+{
+    lv_obj_t *panel = lv_obj_create(container);
+    lv_obj_set_size(panel, LV_PCT(100), LV_SIZE_CONTENT);
+    lv_obj_remove_flag(panel, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_style_pad_all(panel, 0, LV_PART_MAIN);
+    lv_obj_t *label = lv_label_create(panel);
+    int32_t width = lv_text_get_width(text, strlen(text), LV_FONT_DEFAULT, 0);
+    lv_obj_set_width(label, std::max<int32_t>(std::min<int32_t>(width, sent ? 200 : 160) + 10, 40));
+    lv_obj_set_align(label, sent ? LV_ALIGN_RIGHT_MID : LV_ALIGN_LEFT_MID);
+    lv_label_set_text(label, text);
+}
+
+ChatLayout::Size measure(const char *text, bool sent)
+{
+    int32_t width = lv_text_get_width(text, strlen(text), LV_FONT_DEFAULT, 0);
+    width = std::max<int32_t>(std::min<int32_t>(width, sent ? 200 : 160) + 10, 40);
+    lv_point_t size;
+    lv_text_get_size(&size, text, LV_FONT_DEFAULT, 0, 0, width, LV_TEXT_FLAG_NONE);
+    return ChatLayout::Size{uint16_t(width), uint16_t(size.y)};
+}
+
+// scroll up from the newest message by c_scrollStep per frame and render it
+double scrollFrameUs(lv_display_t *disp, lv_obj_t *container, Benchmark &bench)
+{
+    lv_obj_update_layout(container);
+    lv_obj_scroll_by(container, 0, -lv_obj_get_scroll_bottom(container), LV_ANIM_OFF);
+    lv_refr_now(disp);
+    bench.restart();
+    for (int frame = 0; frame < c_frames; frame++) {
+        lv_obj_scroll_by(container, 0, c_scrollStep, LV_ANIM_OFF);
+        lv_refr_now(disp);
+    }
+    return bench.elapsedUs() / c_frames;
+}
+} // namespace
+
+TEST_CASE("VirtualChat: chat memory and scroll frame time")
+{
+    lv_display_t *disp = headlessDisplay();
+    Benchmark bench("virtualchat");
+    char label[64];
+
+    for (uint32_t count : c_counts) {
+        std::vector<std::string> msgs = makeMessages(count);
+
+        // widgets per message
+        size_t before = heapFree();
+        lv_obj_t *container = chatContainer();
+        uint32_t created = 0;
+        bench.restart();
+        while (created < count && heapFree() > c_heapReserve) {
+            addBubble(container, msgs[created].c_str(), created % 3 == 0);
+            created++;
+        }
+        lv_obj_update_layout(container);
+        snprintf(label, sizeof(label), "widgets %u: restore", count);
+        bench.report(label, bench.elapsedMs(), "ms");
+        snprintf(label, sizeof(label), "widgets %u: created", count);
+        bench.report(label, created, "messages");
+        snprintf(label, sizeof(label), "widgets %u: heap", count);
+        bench.report(label, before - heapFree(), "bytes");
+        snprintf(label, sizeof(label), "widgets %u: scroll frame", count);
+        bench.report(label, scrollFrameUs(disp, container, bench), "us");
+        lv_obj_delete(container);
+
+        // recycled bubbles
+        before = heapFree();
+        container = chatContainer();
+        VirtualChat *chat = new VirtualChat(
+            container, measure,
+            [](lv_obj_t *parent, bool) {
+                lv_obj_t *bubble = lv_label_create(parent);
+                return bubble;
+            },
+            [&chat](lv_obj_t *bubble, uint32_t index) { lv_label_set_text(bubble, chat->messages().text(index)); });
+        bench.restart();
+        for (uint32_t i = 0; i < count; i++) {
+            chat->messages().add(msgs[i].c_str(), i % 3 == 0, 0x100, i, 0);
+            chat->changed();
+        }
+        lv_obj_update_layout(container);
+        snprintf(label, sizeof(label), "virtual %u: restore", count);
+        bench.report(label, bench.elapsedMs(), "ms");
+        snprintf(label, sizeof(label), "virtual %u: heap", count);
+        bench.report(label, before - heapFree(), "bytes");
+        snprintf(label, sizeof(label), "virtual %u: scroll frame", count);
+        bench.report(label, scrollFrameUs(disp, container, bench), "us");
+        snprintf(label, sizeof(label), "virtual %u: bubbles", count);
+        bench.report(label, chat->bubbles(), "");
+
+        CHECK(chat->bubbles() < 24);
+        CHECK(chat->messages().measured() == count);
+        CHECK(VirtualChat::of(container) == chat);
+        lv_obj_delete(container); // deletes the chat as well
+    }
+}
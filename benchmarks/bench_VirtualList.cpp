@@ -0,0 +1,159 @@
+#include "Benchmark.h"
+#include "graphics/common/VirtualList.h"
+#include "lvgl.h"
+#include "util/NodeDB.h"
+#include <doctest/doctest.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+/**
+ * Node list with 250, 2000 and 10000 nodes: one panel per node (as nodes_panel did before)
+ * compared to a VirtualList with recycled rows bound from NodeDB. Reports the LVGL heap used
+ * and the time to scroll by one row and render the frame into a headless display.
+ * The per-node panels stop being created when the LVGL heap runs low, which is reported.
+ */
+
+namespace
+{
+constexpr int32_t c_rowHeight = 46;
+constexpr int c_frames = 100;
+constexpr size_t c_heapReserve = 8 * 1024; // keep free for rendering
+constexpr uint32_t c_counts[] = {250, 2000, 10000};
+
+uint8_t drawBuf[320 * 24 * 2];
+
+void flush(lv_display_t *disp, const lv_area_t *, uint8_t *)
+{
+    lv_display_flush_ready(disp);
+}
+
+lv_display_t *headlessDisplay(void)
+{
+    if (!lv_is_initialized())
+        lv_init();
+    lv_display_t *disp = lv_display_get_default();
+    if (!disp) {
+        disp = lv_display_create(320, 240);
+        lv_display_set_buffers(disp, drawBuf, nullptr, sizeof(drawBuf), LV_DISPLAY_RENDER_MODE_PARTIAL);
+        lv_display_set_flush_cb(disp, flush);
+    }
+    return disp;
+}
+
+size_t heapFree(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.free_size;
+}
+
+lv_obj_t *listContainer(void)
+{
+    lv_obj_t *list = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(list, 320, 200);
+    lv_obj_set_style_pad_all(list, 0, LV_PART_MAIN);
+    return list;
+}
+
+// node panel layout as in addNode(): image, button and 9 labels
+lv_obj_t *nodePanel(lv_obj_t *parent)
+{
+    lv_obj_t *p = lv_obj_create(parent);
+    lv_obj_set_size(p, LV_PCT(100), c_rowHeight);
+    lv_obj_remove_flag(p, LV_OBJ_FLAG_SCROLLABLE);
+    lv_image_create(p);
+    lv_button_create(p);
+    for (int i = 0; i < 9; i++)
+        lv_label_create(p);
+    return p;
+}
+
+void bindPanel(lv_obj_t *p, const NodeDB &db, uint32_t slot)
+{
+    lv_label_set_text(lv_obj_get_child(p, 2), db.longName(slot));
+    lv_label_set_text(lv_obj_get_child(p, 3), db.shortName(slot));
+    lv_label_set_text_fmt(lv_obj_get_child(p, 5), "%us", (unsigned)db.lastHeard(slot));
+}
+
+void fillNodes(NodeDB &db, uint32_t count)
+{
+    db.clear();
+    db.reserve(count);
+    char shortName[5], longName[40];
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t slot = db.add(0x10000 + i);
+        snprintf(shortName, sizeof(shortName), "%04x", i & 0xffff);
+        snprintf(longName, sizeof(longName), "Meshtastic node %u", i);
+        db.setNames(slot, shortName, longName);
+        db.setLastHeard(slot, 1700000000 - i);
+    }
+}
+
+// scroll down by one row per frame and render it
+double scrollFrameUs(lv_display_t *disp, lv_obj_t *list, Benchmark &bench)
+{
+    lv_obj_scroll_to_y(list, 0, LV_ANIM_OFF);
+    lv_refr_now(disp);
+    bench.restart();
+    for (int frame = 0; frame < c_frames; frame++) {
+        lv_obj_scroll_by(list, 0, -c_rowHeight, LV_ANIM_OFF);
+        lv_refr_now(disp);
+    }
+    return bench.elapsedUs() / c_frames;
+}
+} // namespace
+
+TEST_CASE("VirtualList: node list memory and scroll frame time")
+{
+    lv_display_t *disp = headlessDisplay();
+    Benchmark bench("virtuallist");
+    NodeDB db;
+    char label[64];
+
+    for (uint32_t count : c_counts) {
+        fillNodes(db, count);
+
+        // one panel per node
+        size_t before = heapFree();
+        lv_obj_t *list = listContainer();
+        lv_obj_set_flex_flow(list, LV_FLEX_FLOW_COLUMN);
+        uint32_t created = 0;
+        while (created < count && heapFree() > c_heapReserve) {
+            bindPanel(nodePanel(list), db, created);
+            created++;
+        }
+        lv_obj_update_layout(list);
+        size_t used = before - heapFree();
+        snprintf(label, sizeof(label), "panels %u: created", count);
+        bench.report(label, created, "panels");
+        snprintf(label, sizeof(label), "panels %u: heap", count);
+        bench.report(label, used, "bytes");
+        snprintf(label, sizeof(label), "panels %u: scroll frame", count);
+        bench.report(label, scrollFrameUs(disp, list, bench), "us");
+        lv_obj_delete(list);
+
+        // recycled rows
+        before = heapFree();
+        list = listContainer();
+        {
+            VirtualList vlist(
+                list, c_rowHeight, [](lv_obj_t *parent) { return nodePanel(parent); },
+                [&db](lv_obj_t *row, uint32_t index) { bindPanel(row, db, index); });
+            vlist.setCount(db.size());
+            lv_obj_update_layout(list);
+            used = before - heapFree();
+            snprintf(label, sizeof(label), "virtual %u: heap", count);
+            bench.report(label, used, "bytes");
+            snprintf(label, sizeof(label), "virtual %u: scroll frame", count);
+            bench.report(label, scrollFrameUs(disp, list, bench), "us");
+
+            CHECK(lv_obj_get_child_count(list) < 16);
+            CHECK(lv_obj_get_scroll_y(list) == c_frames * c_rowHeight);
+            lv_obj_t *row = vlist.rowOf(c_frames);
+            REQUIRE(row != nullptr);
+            CHECK(strcmp(lv_label_get_text(lv_obj_get_child(row, 3)), db.shortName(c_frames)) == 0);
+        }
+        lv_obj_delete(list);
+    }
+}
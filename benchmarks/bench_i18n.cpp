@@ -0,0 +1,93 @@
+#include "Benchmark.h"
+#include "lv_i18n.h"
+#include <doctest/doctest.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+/**
+ * Translation lookups per second as done when a screen is relabelled: every message ID of
+ * all languages looked up once per round. The previous linear search through the phrase
+ * tables (strcmp against each entry, then again through the English table if the message is
+ * not translated) compared to the perfect-hash lookup, for a language with most messages
+ * translated, a partially translated one and one without any translations (English fallback
+ * path; the English table only holds the few messages whose text differs from the ID).
+ */
+
+namespace
+{
+constexpr int c_rounds = 2000;
+
+const char *linearFind(const lv_i18n_phrase_t *phrases, const char *msgId)
+{
+    for (; phrases && phrases->msg_id; phrases++) {
+        if (strcmp(phrases->msg_id, msgId) == 0)
+            return phrases->translation;
+    }
+    return nullptr;
+}
+
+// lv_i18n_get_text() as generated by lv_i18n compile
+const char *previousGetText(const lv_i18n_lang_t *lang, const char *msgId)
+{
+    const char *txt = linearFind(lang->singulars, msgId);
+    if (!txt && lang != lv_i18n_language_pack[0])
+        txt = linearFind(lv_i18n_language_pack[0]->singulars, msgId);
+    return txt ? txt : msgId;
+}
+
+const lv_i18n_lang_t *findLang(const char *locale)
+{
+    for (const lv_i18n_language_pack_t *lang = lv_i18n_language_pack; *lang; lang++) {
+        if (strcmp((*lang)->locale_name, locale) == 0)
+            return *lang;
+    }
+    return nullptr;
+}
+
+template <class GetText> double lookupsPerSecond(Benchmark &bench, const std::vector<const char *> &ids, GetText getText)
+{
+    size_t sum = 0;
+    bench.restart();
+    for (int r = 0; r < c_rounds; r++) {
+        for (const char *id : ids)
+            sum += (size_t)getText(id);
+    }
+    double us = bench.elapsedUs();
+    CHECK(sum != 0);
+    return double(c_rounds) * ids.size() / us * 1e6;
+}
+} // namespace
+
+TEST_CASE("i18n: lookups per second")
+{
+    Benchmark bench("i18n");
+    REQUIRE(lv_i18n_init_default() == 0);
+    std::vector<const char *> ids;
+    for (const lv_i18n_language_pack_t *lang = lv_i18n_language_pack; *lang; lang++) {
+        for (const lv_i18n_phrase_t *p = (*lang)->singulars; p && p->msg_id; p++) {
+            bool known = false;
+            for (const char *id : ids)
+                known = known || strcmp(id, p->msg_id) == 0;
+            if (!known)
+                ids.push_back(p->msg_id);
+        }
+    }
+    bench.report("message IDs", ids.size(), "");
+
+    char label[64];
+    for (const char *locale : {"de", "pl", "ro"}) {
+        const lv_i18n_lang_t *lang = findLang(locale);
+        REQUIRE(lang != nullptr);
+        REQUIRE(lv_i18n_set_locale(locale) == 0);
+        double previous = lookupsPerSecond(bench, ids, [&](const char *id) { return previousGetText(lang, id); });
+        double hashed = lookupsPerSecond(bench, ids, [](const char *id) { return lv_i18n_get_text(id); });
+        snprintf(label, sizeof(label), "%s: linear search", locale);
+        bench.report(label, previous / 1e6, "M/s");
+        snprintf(label, sizeof(label), "%s: perfect hash", locale);
+        bench.report(label, hashed / 1e6, "M/s");
+        if (lang->singulars)
+            CHECK(hashed > previous);
+    }
+    lv_i18n_set_locale("en");
+}
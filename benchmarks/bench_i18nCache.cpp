@@ -0,0 +1,173 @@
+#include "Benchmark.h"
+#include "lv_i18n.h"
+#include "lv_i18n_hash.h"
+#include <doctest/doctest.h>
+#include <random>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+/**
+ * Translations requested by the label updates of TFTView_Common during ten minutes of normal
+ * operation in German: uptime and memory every second, node count and unread messages, the node
+ * panel labels for each packet heard and the settings labels when the settings are opened.
+ * The previous lookup (perfect hash plus strcmp for each call) compared to the pointer cache.
+ */
+
+namespace
+{
+constexpr int c_rounds = 200;
+constexpr uint32_t c_seconds = 600;
+
+struct Call {
+    const char *msgId;
+    int32_t num; // plural count, -1 for _()
+};
+
+std::vector<Call> recordTrace(void)
+{
+    std::mt19937 rnd(42);
+    std::vector<Call> trace;
+    for (uint32_t s = 0; s < c_seconds; s++) {
+        // TFTView_Common::updateTime(), updateFreeMem()
+        trace.push_back({"uptime: %02d:%02d:%02d", -1});
+        trace.push_back({"Heap: %d (%d%%)\nLVGL: %d (%d%%)", -1});
+        // packets heard, each updates the node panel: updateSignalStrength(), updateLastHeard(), updateMetrics()
+        for (uint32_t p = rnd() % 4; p > 0; p--) {
+            trace.push_back({"hops: %d", -1});
+            trace.push_back({"now", -1});
+            if (rnd() % 3 == 0)
+                trace.push_back({"Util %0.1f%%  Air %0.1f%%", -1});
+            if (rnd() % 10 == 0)
+                trace.push_back({"%d of %d nodes online", int32_t(20 + rnd() % 5)});
+        }
+        if (s % 5 == 0)
+            trace.push_back({"no signal", -1});
+        // new message: updateUnreadMessages(), updateActiveChats()
+        if (rnd() % 30 == 0) {
+            trace.push_back({"%d new message", -1});
+            trace.push_back({"%d active chat(s)", int32_t(1 + rnd() % 3)});
+            trace.push_back({"no new messages", -1});
+        }
+        // settings opened
+        if (s % 120 == 60) {
+            for (const char *id : {"Device Role: %s", "WiFi: %s", "Modem Preset: %s", "Region: %s", "Message Alert: %s",
+                                   "Channel: %s", "Language: %s", "Screen Timeout: %ds", "Screen Brightness: %d%%",
+                                   "Theme: %s", "Input Control: %s/%s", "silent", "on", "off"})
+                trace.push_back({id, -1});
+        }
+    }
+    return trace;
+}
+
+uint32_t hashSlot(const char *msgId)
+{
+    uint32_t h = 2166136261u;
+    for (const unsigned char *s = (const unsigned char *)msgId; *s; s++)
+        h = (h ^ *s) * 16777619u;
+    uint32_t x = h ^ lv_i18n_hash_displace[h % LV_I18N_HASH_BUCKETS];
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x % LV_I18N_HASH_KEYS;
+}
+
+const lv_i18n_hash_index_t *hashIndex(const char *locale)
+{
+    for (const lv_i18n_hash_lang_t *l = lv_i18n_hash_langs; l->locale_name; l++) {
+        if (strcmp(l->locale_name, locale) == 0)
+            return l->index;
+    }
+    return nullptr;
+}
+
+const char *linearFind(const lv_i18n_phrase_t *phrases, const char *msgId)
+{
+    for (; phrases && phrases->msg_id; phrases++) {
+        if (strcmp(phrases->msg_id, msgId) == 0)
+            return phrases->translation;
+    }
+    return nullptr;
+}
+
+// lv_i18n_get_text() and lv_i18n_get_text_plural() without the cache
+struct PreviousLookup {
+    const lv_i18n_lang_t *lang;
+    const lv_i18n_lang_t *en = lv_i18n_language_pack[0];
+    const lv_i18n_hash_index_t *index;
+    const lv_i18n_hash_index_t *enIndex = hashIndex("en");
+
+    const char *text(const char *msgId) const
+    {
+        uint32_t slot = hashSlot(msgId);
+        for (auto [l, idx] : {std::make_pair(lang, index[slot]), std::make_pair(en, enIndex[slot])}) {
+            if (idx && strcmp(l->singulars[idx - 1].msg_id, msgId) == 0)
+                return l->singulars[idx - 1].translation;
+        }
+        return msgId;
+    }
+
+    const char *plural(const char *msgId, int32_t num) const
+    {
+        const char *txt = linearFind(lang->plurals[lang->locale_plural_fn(num)], msgId);
+        if (!txt && en->locale_plural_fn)
+            txt = linearFind(en->plurals[en->locale_plural_fn(num)], msgId);
+        return txt ? txt : msgId;
+    }
+};
+
+template <class Text, class Plural>
+double nsPerCall(Benchmark &bench, const std::vector<Call> &trace, Text text, Plural plural)
+{
+    size_t sum = 0;
+    bench.restart();
+    for (int r = 0; r < c_rounds; r++) {
+        for (const Call &c : trace)
+            sum += (size_t)(c.num < 0 ? text(c.msgId) : plural(c.msgId, c.num));
+    }
+    double us = bench.elapsedUs();
+    CHECK(sum != 0);
+    return us * 1000 / (double(c_rounds) * trace.size());
+}
+} // namespace
+
+TEST_CASE("i18n: cached lookups of a label update trace")
+{
+    Benchmark bench("i18ncache");
+    std::vector<Call> trace = recordTrace();
+    bench.report("calls in trace", trace.size(), "");
+
+    REQUIRE(lv_i18n_init_default() == 0);
+    REQUIRE(lv_i18n_set_locale("de") == 0);
+    PreviousLookup previous{lv_i18n_language_pack[0]};
+    for (const lv_i18n_language_pack_t *lang = lv_i18n_language_pack; *lang; lang++) {
+        if (strcmp((*lang)->locale_name, "de") == 0)
+            previous.lang = *lang;
+    }
+    previous.index = hashIndex("de");
+    REQUIRE(previous.index != nullptr);
+    for (const Call &c : trace) {
+        CHECK((c.num < 0 ? lv_i18n_get_text(c.msgId) : lv_i18n_get_text_plural(c.msgId, c.num)) ==
+              (c.num < 0 ? previous.text(c.msgId) : previous.plural(c.msgId, c.num)));
+    }
+
+    double uncached = nsPerCall(
+        bench, trace, [&](const char *id) { return previous.text(id); },
+        [&](const char *id, int32_t n) { return previous.plural(id, n); });
+#ifdef LV_I18N_CACHE_STATS
+    uint32_t hits, misses;
+    lv_i18n_get_cache_stats(&hits, &misses);
+#endif
+    double cached = nsPerCall(bench, trace, lv_i18n_get_text, lv_i18n_get_text_plural);
+    bench.report("hash lookup", uncached, "ns/call");
+    bench.report("pointer cache", cached, "ns/call");
+#ifdef LV_I18N_CACHE_STATS
+    uint32_t hits2, misses2;
+    lv_i18n_get_cache_stats(&hits2, &misses2);
+    bench.report("cache hit rate", 100.0 * (hits2 - hits) / ((hits2 - hits) + (misses2 - misses)), "%");
+#endif
+    CHECK(cached < uncached);
+    lv_i18n_set_locale("en");
+}
@@ -0,0 +1,126 @@
+#include "Benchmark.h"
+#include "lv_i18n.h"
+#include "lv_i18n_hash.h"
+#include <algorithm>
+#include <doctest/doctest.h>
+#include <set>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+/**
+ * Flash taken by the compiled-in tables of all languages except English (phrase tables, their
+ * strings and the hash index) compared to the size of the language packs that replace them with
+ * LV_I18N_EXTERNAL_PACKS, and the time to switch the locale: lv_i18n_set_locale() with compiled
+ * tables versus reading the pack from a file and lv_i18n_set_locale_pack().
+ */
+
+#ifdef LV_I18N_PACK_DIR
+namespace
+{
+constexpr int c_rounds = 200;
+
+size_t tableBytes(const lv_i18n_phrase_t *phrases, std::set<const char *> &strings)
+{
+    size_t bytes = 0;
+    for (; phrases && phrases->msg_id; phrases++) {
+        bytes += sizeof(lv_i18n_phrase_t);
+        // the compiler merges equal literals, count each string once
+        for (const char *s : {phrases->msg_id, phrases->translation}) {
+            if (strings.insert(s).second)
+                bytes += strlen(s) + 1;
+        }
+    }
+    return phrases ? bytes + sizeof(lv_i18n_phrase_t) : 0;
+}
+
+std::string packPath(const char *locale)
+{
+    return std::string(LV_I18N_PACK_DIR) + "/" + locale + ".lvi";
+}
+
+// what TFTView_Common::loadLanguagePack() does
+void *loadPack(const char *locale, uint32_t &size)
+{
+    FILE *f = fopen(packPath(locale).c_str(), "rb");
+    if (!f)
+        return nullptr;
+    uint8_t header[LV_I18N_PACK_HEADER_SIZE];
+    fseek(f, 0, SEEK_END);
+    size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint32_t alloc = 0;
+    if (fread(header, 1, sizeof(header), f) == sizeof(header))
+        alloc = lv_i18n_pack_alloc_size(header, size);
+    uint8_t *pack = alloc ? (uint8_t *)malloc(alloc) : nullptr;
+    if (pack) {
+        memcpy(pack, header, sizeof(header));
+        if (fread(pack + sizeof(header), 1, size - sizeof(header), f) != size - sizeof(header)) {
+            free(pack);
+            pack = nullptr;
+        }
+    }
+    fclose(f);
+    return pack;
+}
+} // namespace
+
+TEST_CASE("i18n: language packs")
+{
+    Benchmark bench("i18npack");
+    REQUIRE(lv_i18n_init_default() == 0);
+
+    size_t compiled = 0, packs = 0, largest = 0;
+    std::set<const char *> englishStrings;
+    tableBytes(lv_i18n_language_pack[0]->singulars, englishStrings);
+    for (const lv_i18n_language_pack_t *lang = lv_i18n_language_pack + 1; *lang; lang++) {
+        std::set<const char *> strings = englishStrings;
+        size_t bytes = tableBytes((*lang)->singulars, strings);
+        for (const lv_i18n_phrase_t *plurals : (*lang)->plurals)
+            bytes += tableBytes(plurals, strings);
+        compiled += bytes + LV_I18N_HASH_KEYS * sizeof(lv_i18n_hash_index_t);
+        FILE *f = fopen(packPath((*lang)->locale_name).c_str(), "rb");
+        if (f) {
+            fseek(f, 0, SEEK_END);
+            packs += ftell(f);
+            largest = std::max<size_t>(largest, ftell(f));
+            fclose(f);
+        }
+    }
+    if (packs == 0) {
+        MESSAGE("no language packs in " LV_I18N_PACK_DIR ", is PyYAML installed?");
+        return;
+    }
+    bench.report("compiled tables (without English)", compiled / 1024.0, "KiB");
+    bench.report("language packs", packs / 1024.0, "KiB");
+    bench.report("largest pack", largest / 1024.0, "KiB");
+
+    const char *locales[] = {"de", "fr", "uk", "zh-CN"};
+    bench.restart();
+    for (int r = 0; r < c_rounds; r++) {
+        for (const char *locale : locales)
+            lv_i18n_set_locale(locale);
+    }
+    bench.report("switch compiled", bench.elapsedUs() / (c_rounds * 4), "us");
+
+    void *current = nullptr;
+    double loadUs = 0;
+    for (int r = 0; r < c_rounds; r++) {
+        for (const char *locale : locales) {
+            bench.restart();
+            uint32_t size = 0;
+            void *pack = loadPack(locale, size);
+            REQUIRE(pack != nullptr);
+            REQUIRE(lv_i18n_set_locale_pack(pack, size) == 0);
+            loadUs += bench.elapsedUs();
+            free(current);
+            current = pack;
+        }
+    }
+    bench.report("switch to pack (read + load)", loadUs / (c_rounds * 4), "us");
+    lv_i18n_set_locale("en");
+    free(current);
+}
+#endif
@@ -0,0 +1,209 @@
+#include "Benchmark.h"
+#include "PortduinoFS.h"
+#include "comms/IClientBase.h"
+#include "graphics/DeviceScreen.h"
+#include "graphics/driver/DisplayDriverConfig.h"
+#include "graphics/driver/MemDriver.h"
+#include "util/InputScript.h"
+#include <deque>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/stat.h>
+#include <time.h>
+#include <vector>
+
+/**
+ * The 320x240 view (TFTView_320x240) on a MemDriver, fed by a client that answers the config
+ * request with a node database and a few text messages. After booting the interaction scripts
+ * are replayed on the virtual clock one after another, for each are reported: frames rendered,
+ * render time per frame (average and slowest), flushed pixels and the LVGL heap high-water mark.
+ * Usage: ui_bench [-o <snapshot dir>] [script.txt ...], without scripts those in
+ * benchmarks/ui/scripts are replayed.
+ */
+
+const char *firmware_version = "ui_bench";
+
+namespace
+{
+constexpr uint32_t c_myNode = 0x1a2b3c4d;
+constexpr uint32_t c_nodes = 120;
+constexpr uint32_t c_messages = 30;
+constexpr const char *c_bootScript = "wait 6000\n"; // boot screen, config and restoring messages
+constexpr const char *c_scripts[] = {"home", "nodes", "messages", "map", "settings"};
+
+/**
+ * Client connected to a simulated radio: each config request is answered with my node info, the
+ * UI config, the primary channel, c_nodes nodes with position and config complete, followed by
+ * c_messages text messages.
+ */
+class BenchClient : public IClientBase
+{
+  public:
+    void init(void) override {}
+    bool connect(void) override
+    {
+        if (notify)
+            notify(eConnected, "ui_bench");
+        return true;
+    }
+    bool disconnect(void) override { return true; }
+    bool isConnected(void) override { return true; }
+    bool isStandalone(void) override { return false; }
+    void setNotifyCallback(NotifyCallback notifyConnectionStatus) override { notify = notifyConnectionStatus; }
+
+    bool send(meshtastic_ToRadio &&to) override
+    {
+        if (to.which_payload_variant == meshtastic_ToRadio_want_config_id_tag)
+            sendConfig(to.want_config_id);
+        return true;
+    }
+
+    meshtastic_FromRadio receive(void) override
+    {
+        meshtastic_FromRadio from{};
+        if (!queue.empty()) {
+            from = queue.front();
+            queue.pop_front();
+        }
+        return from;
+    }
+
+  private:
+    void sendConfig(uint32_t configId)
+    {
+        meshtastic_FromRadio from{};
+        from.which_payload_variant = meshtastic_FromRadio_my_info_tag;
+        from.my_info.my_node_num = c_myNode;
+        queue.push_back(from);
+
+        from = meshtastic_FromRadio{};
+        from.which_payload_variant = meshtastic_FromRadio_deviceuiConfig_tag;
+        from.deviceuiConfig.version = 1;
+        from.deviceuiConfig.screen_brightness = 153;
+        from.deviceuiConfig.screen_timeout = 0;
+        queue.push_back(from);
+
+        from = meshtastic_FromRadio{};
+        from.which_payload_variant = meshtastic_FromRadio_channel_tag;
+        from.channel.index = 0;
+        from.channel.role = meshtastic_Channel_Role_PRIMARY;
+        from.channel.has_settings = true;
+        queue.push_back(from);
+
+        uint32_t now = time(nullptr);
+        for (uint32_t i = 0; i <= c_nodes; i++) {
+            from = meshtastic_FromRadio{};
+            from.which_payload_variant = meshtastic_FromRadio_node_info_tag;
+            meshtastic_NodeInfo &node = from.node_info;
+            node.num = i == 0 ? c_myNode : 0x10000000 + i * 7919;
+            node.last_heard = now - i * 60;
+            node.has_user = true;
+            snprintf(node.user.id, sizeof(node.user.id), "!%08x", node.num);
+            snprintf(node.user.long_name, sizeof(node.user.long_name), "Meshtastic %04x", node.num & 0xffff);
+            snprintf(node.user.short_name, sizeof(node.user.short_name), "%04x", node.num & 0xffff);
+            node.has_position = true;
+            node.position.latitude_i = 520000000 + int32_t(i % 11) * 1100000 - 6000000;
+            node.position.longitude_i = 130000000 + int32_t(i % 13) * 900000 - 6000000;
+            queue.push_back(from);
+        }
+
+        from = meshtastic_FromRadio{};
+        from.which_payload_variant = meshtastic_FromRadio_config_complete_id_tag;
+        from.config_complete_id = configId;
+        queue.push_back(from);
+
+        for (uint32_t i = 0; i < c_messages; i++) {
+            from = meshtastic_FromRadio{};
+            from.which_payload_variant = meshtastic_FromRadio_packet_tag;
+            meshtastic_MeshPacket &p = from.packet;
+            p.from = 0x10000000 + (i % 5 + 1) * 7919;
+            p.to = i % 3 ? 0xffffffff : c_myNode;
+            p.id = 1000 + i;
+            p.rx_time = now;
+            p.which_payload_variant = meshtastic_MeshPacket_decoded_tag;
+            p.decoded.portnum = meshtastic_PortNum_TEXT_MESSAGE_APP;
+            p.decoded.payload.size = snprintf((char *)p.decoded.payload.bytes, sizeof(p.decoded.payload.bytes),
+                                              "message %u: the quick brown fox jumps over the lazy dog", i);
+            queue.push_back(from);
+        }
+    }
+
+    NotifyCallback notify;
+    std::deque<meshtastic_FromRadio> queue;
+};
+
+void mountFileSystem(void)
+{
+    const char *tmp = getenv("TMPDIR");
+    static std::string root = std::string(tmp ? tmp : "/tmp") + "/device-ui-bench";
+    mkdir(root.c_str(), 0755);
+    portduinoVFS->mountpoint(root.c_str());
+}
+
+void report(const Benchmark &bench, const char *script, const MemDriver::Stats &stats, double wallMs)
+{
+    char label[64];
+    snprintf(label, sizeof(label), "%s: frames", script);
+    bench.report(label, stats.frames, "");
+    snprintf(label, sizeof(label), "%s: render", script);
+    bench.report(label, stats.frames ? stats.renderUs / 1000.0 / stats.frames : 0, "ms/frame");
+    snprintf(label, sizeof(label), "%s: slowest frame", script);
+    bench.report(label, stats.maxRenderUs / 1000.0, "ms");
+    snprintf(label, sizeof(label), "%s: flushed", script);
+    bench.report(label, stats.frames ? double(stats.flushedPixels) / stats.frames : 0, "pixels/frame");
+    snprintf(label, sizeof(label), "%s: LVGL heap high-water", script);
+    bench.report(label, stats.heapHighWater / 1024.0, "kB");
+    snprintf(label, sizeof(label), "%s: wall time", script);
+    bench.report(label, wallMs, "ms");
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    const char *snapshotDir = nullptr;
+    std::vector<std::string> scripts;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+            snapshotDir = argv[++i];
+        else
+            scripts.push_back(argv[i]);
+    }
+    if (scripts.empty()) {
+        for (const char *name : c_scripts)
+            scripts.push_back(std::string(UI_BENCH_SCRIPTS) + "/" + name + ".txt");
+    }
+
+    mountFileSystem();
+    static BenchClient client;
+    static DisplayDriverConfig config(DisplayDriverConfig::device_t::MEM, 320, 240);
+    DeviceScreen &screen = DeviceScreen::create(&config);
+    MemDriver &driver = MemDriver::create(config.width(), config.height());
+    screen.init(&client);
+    auto frame = [&screen]() { screen.task_handler(); };
+
+    Benchmark bench("ui");
+    InputScript boot;
+    boot.parse(c_bootScript);
+    driver.replay(boot, frame, LV_DEF_REFR_PERIOD, snapshotDir);
+    report(bench, "boot", driver.stats(), bench.elapsedMs());
+
+    int failed = 0;
+    for (const std::string &path : scripts) {
+        InputScript script;
+        if (!script.load(path.c_str())) {
+            fprintf(stderr, "%s:%u: invalid script\n", path.c_str(), script.errorLine());
+            failed++;
+            continue;
+        }
+        std::string name = path.substr(path.find_last_of('/') + 1);
+        name = name.substr(0, name.find('.'));
+
+        driver.resetStats();
+        bench.restart();
+        driver.replay(script, frame, LV_DEF_REFR_PERIOD, snapshotDir);
+        report(bench, name.c_str(), driver.stats(), bench.elapsedMs());
+    }
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
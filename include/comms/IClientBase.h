@@ -27,6 +27,8 @@ class IClientBase
 
     virtual bool send(meshtastic_ToRadio &&to) = 0;
     virtual meshtastic_FromRadio receive(void) = 0;
+    // monotonic time in us the packet last returned by receive() was queued, 0 if unknown
+    virtual uint64_t enqueuedAt(void) const { return 0; }
     virtual ~IClientBase(){};
 
     virtual void task_handler(void){};
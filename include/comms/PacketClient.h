@@ -20,6 +20,7 @@ class PacketClient : public IClientBase
     bool isStandalone(void) override;
     bool send(meshtastic_ToRadio &&to) override;
     meshtastic_FromRadio receive(void) override;
+    uint64_t enqueuedAt(void) const override { return lastEnqueued; }
 
     virtual bool hasData() const;
     virtual bool available() const;
@@ -34,4 +35,5 @@ class PacketClient : public IClientBase
   private:
     volatile bool is_connected = false;
     SharedQueue *queue;
+    uint64_t lastEnqueued = 0;
 };
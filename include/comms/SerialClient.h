@@ -16,6 +16,7 @@ class SerialClient : public IClientBase
     bool isStandalone(void) override;
     bool send(meshtastic_ToRadio &&to) override;
     meshtastic_FromRadio receive(void) override;
+    uint64_t enqueuedAt(void) const override { return lastEnqueued; }
 
     void task_handler(void) override;
     void setNotifyCallback(NotifyCallback notifyConnectionStatus) override;
@@ -61,4 +62,6 @@ class SerialClient : public IClientBase
 
     // receiver and sender queue
     SharedQueue queue;
+    // queuing time of the last received packet
+    uint64_t lastEnqueued = 0;
 };
\ No newline at end of file
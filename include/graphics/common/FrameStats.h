@@ -0,0 +1,68 @@
+#pragma once
+
+#include "lvgl.h"
+#include "util/Histogram.h"
+#include <stdint.h>
+
+#ifndef FRAME_STATS_LOG_INTERVAL
+#define FRAME_STATS_LOG_INTERVAL 300 // s, 0: no periodic log line
+#endif
+
+/**
+ * @brief Always-on frame statistics in fixed-size histograms: duration of lv_timer_handler(),
+ *        render and flush time and rendered area per frame, and the time from queuing a packet
+ *        for the UI to the end of the next frame. Render, flush and area are taken from the display
+ *        events of LVGL, the rest is reported by DisplayDriver and ViewController.
+ *        The statistics are logged periodically (and then cleared) and can be shown in an
+ *        overlay on the top layer.
+ */
+class FrameStats
+{
+  public:
+    enum Metric { eTimerHandler, eRender, eFlush, eArea, ePacketToScreen, eMetrics };
+
+    static FrameStats &instance(void);
+    // monotonic time in us
+    static uint64_t now(void);
+
+    // collect render, flush and area of disp
+    void attach(lv_display_t *disp);
+    void timerHandler(uint32_t us);
+    // queued: time the packet was queued for the UI (see SharedQueue), 0: now
+    void packetArrived(uint64_t queued = 0);
+    // periodic log line and overlay update
+    void task_handler(void);
+
+    void showOverlay(bool show);
+    void setLogInterval(uint32_t seconds) { logInterval = seconds; }
+    void log(void);
+    void clear(void);
+
+    const Histogram &histogram(Metric metric) const { return histograms[metric]; }
+    // frames rendered since the last clear()
+    uint32_t frames(void) const { return histograms[eRender].count(); }
+
+  private:
+    FrameStats(void);
+    FrameStats(const FrameStats &) = delete;
+    FrameStats &operator=(const FrameStats &) = delete;
+
+    static void display_event_cb(lv_event_t *e);
+    void updateOverlay(void);
+
+    static constexpr uint32_t c_maxPendingPackets = 8;
+
+    Histogram histograms[eMetrics];
+    uint64_t renderStart;
+    uint64_t flushStart;
+    uint32_t flushUs;
+    uint32_t area;
+    bool rendering;
+    uint64_t pendingPackets[c_maxPendingPackets]; // arrival times not yet on screen
+    uint32_t numPendingPackets;
+    uint32_t logInterval;
+    uint64_t lastLog;
+    uint64_t lastOverlay;
+    uint64_t since; // last clear()
+    lv_obj_t *overlay;
+};
@@ -5,7 +5,13 @@
 #include "graphics/driver/DisplayDriverConfig.h"
 #include "lvgl.h"
 #include "mesh-pb-constants.h"
+#include "util/ChatSummary.h"
 #include "util/LogMessage.h"
+#include "util/NodeDB.h"
+#include "util/NodeEviction.h"
+#include "util/NodeFilter.h"
+#include "util/NodeList.h"
+#include "util/NodeUpdates.h"
 #include <array>
 #include <stdint.h>
 #include <string>
@@ -14,7 +20,6 @@
 
 #define LV_OBJ_IDX(x) spec_attr->children[x]
 
-constexpr uint8_t c_max_channels = 8;
 constexpr uint32_t c_request_timeout = 60 * 1000;
 
 class ViewController;
@@ -137,6 +142,7 @@ class MeshtasticView : public DeviceGUI
     virtual void packetReceived(const meshtastic_MeshPacket &p);
     virtual void newMessage(uint32_t from, uint32_t to, uint8_t ch, const char *msg, uint32_t &msgtime, bool restore = false) {}
     virtual void restoreMessage(const LogMessage &msg) {}
+    virtual void restoreChatSummary(const ChatSummary &summary) {}
 
     virtual void notifyRestoreMessages(int32_t percentage) {}
     virtual void notifyMessagesRestored(void);
@@ -168,7 +174,11 @@ class MeshtasticView : public DeviceGUI
 
     ViewController *controller;
     ResponseHandler requests;
-    std::unordered_map<uint32_t, lv_obj_t *> nodes;       // node panels
+    NodeList nodes;                                       // rows of the node list
+    NodeDB nodeDB;                                        // node data shown in the node list
+    NodeFilter nodeFilter;                                // search keys and filter criteria of all nodes
+    NodeEviction nodeEviction;                            // which node to purge when the node list is full
+    NodeUpdates nodeUpdates;                              // node widget updates pending for the next frame
     std::unordered_map<uint32_t, lv_obj_t *> messages;    // message containers (within ui_MessagesPanel)
     std::unordered_map<uint32_t, lv_obj_t *> chats;       // active chats (within ui_ChatPanel)
     std::array<lv_obj_t *, c_max_channels> channel;       // TODO channel name and info
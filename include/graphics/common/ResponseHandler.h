@@ -1,5 +1,7 @@
 #pragma once
 
+#include "util/RequestId.h"
+#include "util/TimingWheel.h"
 #include <functional>
 #include <stdint.h>
 #include <unordered_map>
@@ -44,10 +46,15 @@ class ResponseHandler
   protected:
     virtual uint32_t generatePacketId(void);
 
-    static uint32_t rollingPacketId;
-    uint32_t requestIdCounter;
+    struct Pending {
+        Request request;
+        TimingWheel::Handle timer;
+    };
+
+    RequestId ids;
     uint32_t maxTime;
-    std::unordered_map<uint32_t, Request> pendingRequest;
+    TimingWheel timeouts; // requestIds by timeout
+    std::unordered_map<uint32_t, Pending> pendingRequest;
 
   private:
     ResponseHandler(const ResponseHandler &) = delete;
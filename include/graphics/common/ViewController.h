@@ -1,7 +1,9 @@
 #pragma once
 
 #include "comms/IClientBase.h"
+#include "util/ChatSummary.h"
 #include "util/LogRotate.h"
+#include "util/MessageRestorer.h"
 #include <time.h>
 
 class MeshtasticView;
@@ -67,6 +69,8 @@ class ViewController
     virtual void sendTextMessage(uint32_t to, uint8_t ch, uint8_t hopLimit, uint32_t msgTime, uint32_t requestId, bool usePkc,
                                  const char *textmsg);
     virtual void removeTextMessages(uint32_t from, uint32_t to, uint8_t ch);
+    // all messages have been read in the view
+    virtual void markMessagesRead(void);
     virtual bool requestPosition(uint32_t to, uint8_t ch, uint32_t requestId);
     virtual void traceRoute(uint32_t to, uint8_t ch, uint8_t hopLimit, uint32_t requestId);
 
@@ -97,6 +101,10 @@ class ViewController
     virtual void beginRestoreTextMessages(void);
     // incrementally load persistent messages
     virtual void restoreTextMessages(void);
+    // write message to the log and update the chat summary
+    void logMessage(const LogMessageEnv &msg, bool unread = false);
+    // write the chat summary to flash if modified
+    void saveSummary(void);
     // handle received packet and update view
     bool handleFromRadio(const meshtastic_FromRadio &from);
     // handle meshPacket
@@ -104,14 +112,20 @@ class ViewController
 
     MeshtasticView *view;
     LogRotate log;
+    MessageRestorer restorer;
+    ChatSummary summary;
     IClientBase *client;
     uint32_t sendId;
     uint32_t myNodeNum;
     time_t lastrun1;
     time_t lastrun10;
+    time_t lastSummarySave;
     time_t restoreTimer;
+    LogRotate::Position summaryReplayFrom; // messages logged after the chat summary was saved (e.g. before a power loss)
+    LogRotate::Position summaryReplayTo;   // are applied to it while the log is restored
     bool setupDone;             // true if ui config has been loaded and screens are setup in the view
     bool configCompleted;       // true if all data from node has been received
     bool messagesRestored;      // true if log messages have been restored
+    bool summaryRebuild;        // true if the chat summary must be rebuilt from the log
     bool requestConfigRequired; // true if config needs to be reloaded from the node
 };
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "lvgl.h"
+#include "util/ChatLayout.h"
+#include <functional>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @brief Chat message list where only the visible bubbles exist as widgets.
+ *        The messages and their cached bubble sizes are held in a ChatLayout; bubbles are taken
+ *        from a recycled pool (one per message kind, sent or received) and bound to the messages
+ *        that scroll into view. The scroll extents come from the cached heights.
+ *        The list deletes itself together with its container.
+ */
+class VirtualChat
+{
+  public:
+    // create a bubble widget within parent
+    using CreateBubble = std::function<lv_obj_t *(lv_obj_t *parent, bool sent)>;
+    // fill a bubble with message index
+    using BindBubble = std::function<void(lv_obj_t *bubble, uint32_t index)>;
+
+    VirtualChat(lv_obj_t *container, ChatLayout::Measure measure, CreateBubble create, BindBubble bind);
+    ~VirtualChat();
+
+    // list attached to a container or nullptr
+    static VirtualChat *of(lv_obj_t *container);
+
+    ChatLayout &messages(void) { return layout; }
+    // messages were added or bubble sizes changed
+    void changed(void);
+    // measure all bubbles again (font or theme changed), also done when the container is resized
+    void invalidate(void);
+    // content of a message changed (e.g. status)
+    void refresh(uint32_t index);
+    void scrollToEnd(lv_anim_enable_t anim);
+    // message shown by a bubble or ChatLayout::c_none
+    uint32_t indexOf(lv_obj_t *bubble) const;
+    uint32_t bubbles(void) const { return pool.size(); }
+
+  private:
+    VirtualChat(const VirtualChat &) = delete;
+    VirtualChat &operator=(const VirtualChat &) = delete;
+
+    struct Bubble {
+        lv_obj_t *obj;
+        uint32_t index; // bound message or ChatLayout::c_none
+        bool sent;
+    };
+
+    static void scrollEvent(lv_event_t *e);
+    static void selfSizeEvent(lv_event_t *e);
+    static void sizeChangedEvent(lv_event_t *e);
+    static void deleteEvent(lv_event_t *e);
+    void update(bool rebind);
+
+    lv_obj_t *container;
+    ChatLayout layout;
+    CreateBubble createBubble;
+    BindBubble bindBubble;
+    std::vector<Bubble> pool;
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "lvgl.h"
+#include "util/RowWindow.h"
+#include <functional>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @brief Scrollable list of equally high rows where only a small pool of row widgets exists.
+ *        The rows are rebound from a backing array (via the bind callback) as the container scrolls;
+ *        the scroll extents are computed from the row count, so the LVGL heap usage does not
+ *        depend on the number of rows.
+ */
+class VirtualList
+{
+  public:
+    // create the widget tree of a row within parent
+    using CreateRow = std::function<lv_obj_t *(lv_obj_t *parent)>;
+    // fill a row with the data of index
+    using BindRow = std::function<void(lv_obj_t *row, uint32_t index)>;
+
+    VirtualList(lv_obj_t *container, uint32_t rowHeight, CreateRow create, BindRow bind);
+    ~VirtualList();
+
+    // set the number of rows and rebind all visible rows
+    void setCount(uint32_t count);
+    uint32_t count(void) const { return window.count(); }
+    // data of all rows or of a single row changed
+    void refresh(void);
+    void refresh(uint32_t index);
+    void scrollToIndex(uint32_t index, lv_anim_enable_t anim);
+    // make one row extra pixels higher (the bind callback sizes the row widget), RowWindow::c_none for none
+    void setExpanded(uint32_t index, uint32_t extra);
+    uint32_t expanded(void) const { return window.expanded(); }
+    // rows bound to row widgets [first, last)
+    uint32_t first(void) const { return window.first(); }
+    uint32_t last(void) const { return window.last(); }
+    // row widget currently showing index or nullptr
+    lv_obj_t *rowOf(uint32_t index) const;
+
+  private:
+    VirtualList(const VirtualList &) = delete;
+    VirtualList &operator=(const VirtualList &) = delete;
+
+    static void scrollEvent(lv_event_t *e);
+    static void selfSizeEvent(lv_event_t *e);
+    void update(void);
+
+    lv_obj_t *container;
+    RowWindow window;
+    CreateRow createRow;
+    BindRow bindRow;
+    std::vector<lv_obj_t *> rows; // pool
+};
@@ -19,8 +19,16 @@ class DisplayDriver
     virtual bool hasTouch(void) { return false; }
     virtual bool hasButton(void) { return false; }
     virtual bool hasLight(void) { return false; }
-    virtual void task_handler(void) { lv_timer_periodic_handler(); };
+    // LVGL ticks are advanced by the driver instead of the wall clock (see MemDriver)
+    virtual bool hasVirtualClock(void) { return false; }
+    virtual void task_handler(void);
+    // ms until the next LVGL timer is due (LV_NO_TIMER_READY: none)
+    uint32_t getTimeUntilNext(void) const;
     virtual bool isPowersaving() { return false; }
+    // exclusive use of the panel's bus from any thread, e.g. for the SD card on the same SPI bus: a running
+    // transfer to the panel is finished first and flushing waits until releaseBus()
+    virtual void acquireBus(void) {}
+    virtual void releaseBus(void) {}
     virtual void printConfig(void) {}
     virtual ~DisplayDriver() {}
 
@@ -36,10 +44,14 @@ class DisplayDriver
     lv_display_t *getDisplay(void) { return display; }
 
   protected:
+    static void timer_resume_cb(void *data);
+
     LVGLGraphics lvgl;
     LVGLDisplay *display;
     LVGLTouch *touch;
     DeviceGUI *view;
     uint16_t screenWidth;
     uint16_t screenHeight;
+    uint32_t lastTimerRun;  // tick
+    uint32_t timeUntilNext; // ms until the next LVGL timer is due
 };
@@ -2,11 +2,13 @@
 
 #include "LovyanGFX.h"
 #include "graphics/driver/DisplayDriverConfig.h"
+#include "graphics/driver/LGFXFlush.h"
 #include "graphics/driver/TFTDriver.h"
 #include "input/InputDriver.h"
 #include "lvgl_private.h"
 #include "util/ILog.h"
 #include <functional>
+#include <new>
 
 constexpr uint32_t defaultLongPressTime = 700; // ms until long press is detected (lvgl default is 400)
 constexpr uint32_t defaultGestureLimit = 10;   // x/y diff pixel until a swipe gesture is detected (lvgl default is 50)
@@ -25,6 +27,8 @@ template <class LGFX> class LGFXDriver : public TFTDriver<LGFX>
     bool hasButton(void) override { return lgfx->hasButton(); }
     bool hasLight(void) override { return lgfx->light(); }
     bool isPowersaving(void) override { return powerSaving; }
+    void acquireBus(void) override { LGFXFlush<LGFX>::acquire(lgfx); }
+    void releaseBus(void) override { LGFXFlush<LGFX>::release(); }
     void printConfig(void) override;
     void task_handler(void) override;
 
@@ -36,7 +40,6 @@ template <class LGFX> class LGFXDriver : public TFTDriver<LGFX>
 
   protected:
     // lvgl callbacks have to be static cause it's a C library, not C++
-    static void display_flush(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map);
     static void rounder_cb(lv_event_t *e);
     static void touchpad_read(lv_indev_t *indev_driver, lv_indev_data_t *data);
 
@@ -103,6 +106,7 @@ template <class LGFX> void LGFXDriver<LGFX>::task_handler(void)
                             lv_indev_enable(DisplayDriver::touch, false);
                             lv_indev_enable(InputDriver::instance()->getButton(), true);
                         }
+                        LGFXFlush<LGFX>::finish(lgfx);
                         lgfx->sleep();
                         lgfx->powerSaveOn();
                         powerSaving = true;
@@ -150,6 +154,7 @@ template <class LGFX> void LGFXDriver<LGFX>::task_handler(void)
             else {
                 if (!powerSaving) {
                     DisplayDriver::view->blankScreen(true);
+                    LGFXFlush<LGFX>::finish(lgfx);
                     lgfx->sleep();
                     lgfx->powerSaveOn();
                     powerSaving = true;
@@ -173,31 +178,6 @@ template <class LGFX> void LGFXDriver<LGFX>::task_handler(void)
     }
 }
 
-#if 1
-// Display flushing not using DMA */
-template <class LGFX> void LGFXDriver<LGFX>::display_flush(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
-{
-    uint32_t w = lv_area_get_width(area);
-    uint32_t h = lv_area_get_height(area);
-    lv_draw_sw_rgb565_swap(px_map, w * h);
-    lgfx->pushImage(area->x1, area->y1, w, h, (uint16_t *)px_map);
-    lv_display_flush_ready(disp);
-}
-#else
-// Display flushing using DMA
-template <class LGFX> void LGFXDriver<LGFX>::display_flush(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
-{
-    uint32_t w = lv_area_get_width(area);
-    uint32_t h = lv_area_get_height(area);
-    lv_draw_sw_rgb565_swap(px_map, w * h);
-    if (lgfx->getStartCount() == 0) { // Processing if not yet started
-        lgfx->startWrite();
-    }
-    lgfx->pushImageDMA(area->x1, area->y1, w, h, (uint16_t *)px_map);
-    lv_disp_flush_ready(disp); // TODO must put into LGFX callback for DMA double-buffering
-}
-#endif
-
 #ifdef LGFX_AMOLED_ROUNDER
 template <class LGFX> void LGFXDriver<LGFX>::rounder_cb(lv_event_t *e)
 {
@@ -220,11 +200,13 @@ template <class LGFX> void LGFXDriver<LGFX>::rounder_cb(lv_event_t *e)
 template <class LGFX> void LGFXDriver<LGFX>::touchpad_read(lv_indev_t *indev_driver, lv_indev_data_t *data)
 {
     uint16_t touchX = 0, touchY = 0;
+    LGFXFlush<LGFX>::acquire(lgfx); // the touch controller may share the bus with the panel
 #ifdef CUSTOM_TOUCH_DRIVER
     bool touched = lgfx->getTouchXY(&touchX, &touchY);
 #else
     bool touched = lgfx->getTouch(&touchX, &touchY);
 #endif
+    LGFXFlush<LGFX>::release();
     if (!touched) {
         data->state = LV_INDEV_STATE_REL;
     } else {
@@ -246,31 +228,40 @@ template <class LGFX> void LGFXDriver<LGFX>::init(DeviceGUI *gui)
     ILOG_DEBUG("LVGL display driver init...");
 
     DisplayDriver::display = lv_display_create(DisplayDriver::screenWidth, DisplayDriver::screenHeight);
-    lv_display_set_color_format(this->display, LV_COLOR_FORMAT_RGB565);
+    // render in the byte order of the panel, flushing needs no swap pass
+    lv_display_set_color_format(this->display, LV_COLOR_FORMAT_RGB565_SWAPPED);
 
-#if defined(USE_DOUBLE_BUFFER) // speedup drawing by using double-buffered DMA mode
-    bufsize = screenWidth * screenHeight / 8 * sizeof(lv_color_t);
-#if defined(CONFIG_IDF_TARGET_ESP32S2) || defined(CONFIG_IDF_TARGET_ESP32S3)
-    ILOG_DEBUG("LVGL: allocating %u bytes PSRAM for double buffering"), bufsize;
+#if defined(USE_DOUBLE_BUFFER) // render into one buffer while the other one is transferred by DMA
+#if defined(BOARD_HAS_PSRAM)
     assert(ESP.getFreePsram());
-    // buf1 = (lv_color_t*)heap_caps_malloc(bufsize, MALLOC_CAP_INTERNAL |
-    // MALLOC_CAP_DMA);  //assert failed: block_trim_free heap_tlsf.c:371 buf2 =
-    // (lv_color_t*)heap_caps_malloc(bufsize, MALLOC_CAP_INTERNAL |
-    // MALLOC_CAP_DMA); buf1 = (lv_color_t*)heap_caps_malloc((bufsize + 3) & ~3,
-    // MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT); // crash buf1 =
-    // (lv_color_t*)heap_caps_malloc(bufsize, MALLOC_CAP_SPIRAM); // crash buf1 =
-    // (lv_color_t*)ps_malloc(bufsize); // crash
-    buf1 = (lv_color_t *)heap_caps_aligned_alloc(32, (bufsize + 3) & ~3, MALLOC_CAP_SPIRAM);
-    // buf2 = (lv_color_t*)heap_caps_aligned_alloc(16, (bufsize + 3) & ~3,
-    // MALLOC_CAP_SPIRAM);
-    draw_buf = (lv_disp_draw_buf_t *)heap_caps_aligned_alloc(32, sizeof(lv_disp_draw_buf_t), MALLOC_CAP_SPIRAM);
+#ifdef LGFX_BUFSIZE
+    bufsize = LGFX_BUFSIZE;
 #else
-    ILOG_DEBUG("LVGL: allocating %u bytes heap memory for double buffering"), bufsize;
-    buf1 = (lv_color_t *)heap_caps_malloc(bufsize, MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA); // heap_alloc_dma
-    buf2 = (lv_color_t *)heap_caps_malloc(bufsize, MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA); // heap_alloc_dma
+    bufsize = lgfx->screenWidth * lgfx->screenHeight * sizeof(lv_color_t) / 4;
 #endif
-    assert(buf1 != 0 /* && buf2 != 0 */);
-    lv_display_set_buffers(disp, buf1, buf2, bufsize, LV_DISPLAY_RENDER_MODE_DIRECT);
+    const uint32_t caps = MALLOC_CAP_SPIRAM;
+#else
+#ifdef LGFX_BUFSIZE
+    bufsize = sizeof(lv_color_t) * LGFX_BUFSIZE;
+#else
+    bufsize = sizeof(lv_color_t) * lgfx->screenWidth * lgfx->screenHeight / 8;
+#endif
+    const uint32_t caps = MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA;
+#endif
+    ILOG_DEBUG("LVGL: allocating 2x%u bytes for double-buffered DMA draw buffers", bufsize);
+#ifdef ARCH_ESP32
+    buf1 = (lv_color_t *)heap_caps_aligned_alloc(32, bufsize, caps);
+    buf2 = (lv_color_t *)heap_caps_aligned_alloc(32, bufsize, caps);
+#else
+    (void)caps;
+    buf1 = (lv_color_t *)new (std::nothrow) uint8_t[bufsize];
+    buf2 = (lv_color_t *)new (std::nothrow) uint8_t[bufsize];
+#endif
+    assert(buf1 != 0);
+    if (!buf2) {
+        ILOG_WARN("LVGL: no memory for second draw buffer, flushing without DMA");
+    }
+    lv_display_set_buffers(this->display, buf1, buf2, bufsize, LV_DISPLAY_RENDER_MODE_PARTIAL);
 #elif defined(BOARD_HAS_PSRAM)
     assert(ESP.getFreePsram());
 #ifdef LGFX_BUFSIZE
@@ -294,7 +285,7 @@ template <class LGFX> void LGFXDriver<LGFX>::init(DeviceGUI *gui)
     lv_display_set_buffers(this->display, buf1, buf2, sizeof(lv_color_t) * bufsize, LV_DISPLAY_RENDER_MODE_PARTIAL);
 #endif
 
-    lv_display_set_flush_cb(this->display, LGFXDriver::display_flush);
+    LGFXFlush<LGFX>::attach(this->display, lgfx);
 #ifdef LGFX_AMOLED_ROUNDER
     lv_display_add_event_cb(this->display, rounder_cb, LV_EVENT_INVALIDATE_AREA, this->display);
 #endif
@@ -392,6 +383,7 @@ template <class LGFX> bool LGFXDriver<LGFX>::calibrate(uint16_t parameters[8])
         lgfx->setTouchCalibrate(parameters);
     } else {
         calibrating = true;
+        LGFXFlush<LGFX>::finish(lgfx);
         std::uint16_t fg = TFT_BLUE;
         std::uint16_t bg = LGFX::color565(0x67, 0xEA, 0x94);
         lgfx->clearDisplay();
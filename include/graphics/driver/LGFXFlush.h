@@ -0,0 +1,135 @@
+#pragma once
+
+#include "lvgl.h"
+#include <stdint.h>
+
+/**
+ * LVGL flush callbacks for an LGFX device. The panel takes RGB565 with the high byte first, so a
+ * display in LV_COLOR_FORMAT_RGB565_SWAPPED is pushed as rendered and only an RGB565 display is
+ * byte-swapped before the push.
+ * With one draw buffer an area is pushed blocking and flushed right away. With two draw buffers
+ * an area is pushed by DMA and LVGL renders the next area into the other buffer meanwhile; before
+ * it flushes again (or reuses the buffer) LVGL calls flush_wait, which waits for the transfer and
+ * signals flush ready.
+ * Bus ownership: the UI thread (LVGL refresh) owns the bus from the start of a DMA transfer until
+ * finish(), the transfer keeps running while the next area is rendered. Other users of a shared
+ * bus take it with acquire() from any thread, e.g. SD card reads of map tiles in the draw threads
+ * (LV_DRAW_SW_DRAW_UNIT_CNT > 1); flushing waits until release(). All bus state changes are
+ * serialized by one mutex, which is a no-op without LV_USE_OS.
+ * The device is a template parameter so that the callbacks can run with a mock device on Linux.
+ */
+template <class LGFX> class LGFXFlush
+{
+  public:
+    // set the flush callbacks of disp, call after lv_display_set_buffers()
+    static void attach(lv_display_t *disp, LGFX *lgfx);
+    // wait for a running DMA transfer and release the bus, e.g. before talking to the panel or a touch controller on the same bus
+    static void finish(LGFX *lgfx);
+    // exclusive use of the bus from any thread: finishes a running transfer, flushing waits until release()
+    static void acquire(LGFX *lgfx);
+    static void release(void);
+
+  private:
+    static lv_mutex_t &busMutex(void);
+    static void end(LGFX *lgfx);
+    static void toPanelOrder(lv_display_t *disp, uint8_t *px_map, uint32_t pixels);
+    static void flush(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map);
+    static void flushDMA(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map);
+    static void flushWait(lv_display_t *disp);
+};
+
+template <class LGFX> void LGFXFlush<LGFX>::attach(lv_display_t *disp, LGFX *lgfx)
+{
+    lv_display_set_driver_data(disp, lgfx);
+    if (lv_display_is_double_buffered(disp)) {
+        lv_display_set_flush_cb(disp, flushDMA);
+        lv_display_set_flush_wait_cb(disp, flushWait);
+    } else {
+        lv_display_set_flush_cb(disp, flush);
+        lv_display_set_flush_wait_cb(disp, nullptr);
+    }
+}
+
+template <class LGFX> void LGFXFlush<LGFX>::finish(LGFX *lgfx)
+{
+    lv_mutex_lock(&busMutex());
+    end(lgfx);
+    lv_mutex_unlock(&busMutex());
+}
+
+template <class LGFX> void LGFXFlush<LGFX>::acquire(LGFX *lgfx)
+{
+    lv_mutex_lock(&busMutex());
+    end(lgfx);
+}
+
+template <class LGFX> void LGFXFlush<LGFX>::release(void)
+{
+    lv_mutex_unlock(&busMutex());
+}
+
+template <class LGFX> lv_mutex_t &LGFXFlush<LGFX>::busMutex(void)
+{
+    static lv_mutex_t m;
+    static bool initialized = lv_mutex_init(&m) == LV_RESULT_OK;
+    (void)initialized;
+    return m;
+}
+
+template <class LGFX> void LGFXFlush<LGFX>::end(LGFX *lgfx)
+{
+    if (lgfx->getStartCount() > 0) {
+        lgfx->waitDMA();
+        lgfx->endWrite();
+    }
+}
+
+template <class LGFX> void LGFXFlush<LGFX>::toPanelOrder(lv_display_t *disp, uint8_t *px_map, uint32_t pixels)
+{
+    if (lv_display_get_color_format(disp) == LV_COLOR_FORMAT_RGB565) {
+        lv_draw_sw_rgb565_swap(px_map, pixels);
+    }
+}
+
+/**
+ * Display flushing not using DMA
+ */
+template <class LGFX> void LGFXFlush<LGFX>::flush(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    LGFX *lgfx = (LGFX *)lv_display_get_driver_data(disp);
+    uint32_t w = lv_area_get_width(area);
+    uint32_t h = lv_area_get_height(area);
+    toPanelOrder(disp, px_map, w * h);
+    lv_mutex_lock(&busMutex());
+    lgfx->pushImage(area->x1, area->y1, w, h, (uint16_t *)px_map);
+    lv_mutex_unlock(&busMutex());
+    lv_display_flush_ready(disp);
+}
+
+/**
+ * Display flushing using DMA: the transfer is started inside a write transaction (the bus stays
+ * selected until it completes) and px_map must not change until flushWait() returned.
+ */
+template <class LGFX> void LGFXFlush<LGFX>::flushDMA(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    LGFX *lgfx = (LGFX *)lv_display_get_driver_data(disp);
+    uint32_t w = lv_area_get_width(area);
+    uint32_t h = lv_area_get_height(area);
+    toPanelOrder(disp, px_map, w * h);
+    lv_mutex_lock(&busMutex());
+    if (lgfx->getStartCount() == 0) {
+        lgfx->startWrite();
+    }
+    lgfx->pushImageDMA(area->x1, area->y1, w, h, (uint16_t *)px_map);
+    lv_mutex_unlock(&busMutex());
+}
+
+/**
+ * Called by LVGL before it flushes the other buffer, so at most one transfer is running and the
+ * buffer being rendered into is never the one being transferred.
+ */
+template <class LGFX> void LGFXFlush<LGFX>::flushWait(lv_display_t *disp)
+{
+    finish((LGFX *)lv_display_get_driver_data(disp));
+    lv_display_flush_ready(disp);
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include "graphics/driver/DisplayDriver.h"
+#include <functional>
+#include <vector>
+
+class InputScript;
+
+/**
+ * @brief Headless display for benchmarks and tests on pc/raspberry
+ * Renders into a framebuffer in RAM (RGB565) that can be saved as PNG snapshot. LVGL runs on a
+ * virtual clock that only advances by advance(), so a run does not depend on the speed of the
+ * machine, and input comes from a script instead of a device. Usage: DisplayDriverConfig with
+ * device_t::MEM, or define USE_MEMDRIVER for the compile-time configured view.
+ */
+class MemDriver : public DisplayDriver
+{
+  public:
+    struct Stats {
+        uint32_t frames;        // refreshes that rendered something
+        uint32_t flushes;       // areas flushed
+        uint64_t flushedPixels;
+        uint64_t renderUs;      // rendering and flushing of all frames
+        uint32_t maxRenderUs;   // slowest frame
+        size_t heapHighWater;   // max. bytes used in the LVGL heap since lv_init()
+    };
+
+    static MemDriver &create(uint16_t width, uint16_t height);
+    void init(DeviceGUI *gui) override;
+    bool hasTouch(void) override { return true; }
+    bool hasVirtualClock(void) override { return true; }
+    virtual ~MemDriver() {}
+
+    // virtual clock in ms
+    void advance(uint32_t ms);
+    uint32_t now(void) const { return tick; }
+
+    // scripted input
+    void press(int32_t x, int32_t y);
+    void release(void);
+    void key(uint32_t key);
+    // run the script: apply each event at its time and call frame() after each advance of frameMs,
+    // snapshots are saved as <snapshotDir>/<name>.png if snapshotDir is set
+    void replay(const InputScript &script, const std::function<void(void)> &frame, uint32_t frameMs = LV_DEF_REFR_PERIOD,
+                const char *snapshotDir = nullptr);
+
+    bool snapshot(const char *path) const;
+    uint16_t pixel(int32_t x, int32_t y) const { return framebuffer[y * screenWidth + x]; }
+
+    const Stats &stats(void) const { return statistics; }
+    void resetStats(void);
+
+  private:
+    MemDriver(uint16_t width, uint16_t height);
+
+    static uint32_t tick_cb(void);
+    static void flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map);
+    static void render_event_cb(lv_event_t *e);
+    static void pointer_read(lv_indev_t *indev, lv_indev_data_t *data);
+    static void keypad_read(lv_indev_t *indev, lv_indev_data_t *data);
+
+    static MemDriver *memDriver;
+
+    std::vector<uint16_t> framebuffer;
+    std::vector<uint8_t> drawBuffer;
+    lv_indev_t *keypad;
+    uint32_t tick;
+    uint64_t renderStart;
+    Stats statistics;
+
+    lv_point_t point;
+    bool pressed;
+    bool clicked; // pressed since the last read
+    std::vector<uint32_t> keys; // pending, each is reported pressed and released
+    bool keyPressed;
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "lvgl.h"
 #include <stddef.h>
 #include <stdint.h>
 
@@ -20,6 +21,41 @@ class ITileService
     const char *idLetter; // LVGL letter for file system drives
 };
 
+/**
+ * Held by the lv_fs callbacks of tile services whose file system is not reentrant (SD, SdFat):
+ * with more than one draw unit (LV_DRAW_SW_DRAW_UNIT_CNT > 1) LVGL decodes tiles in several
+ * draw threads at the same time. A no-op without LV_USE_OS.
+ * If the card shares its bus with the display, the lock also owns the bus (see shareBus()).
+ */
+class TileFsLock
+{
+  public:
+    TileFsLock(void)
+    {
+        lv_mutex_lock(&mutex());
+        if (acquireBus)
+            acquireBus();
+    }
+    ~TileFsLock()
+    {
+        if (releaseBus)
+            releaseBus();
+        lv_mutex_unlock(&mutex());
+    }
+
+    // take the bus from the display while the card is accessed (and give it back), called from any thread
+    static void shareBus(void (*acquire)(void), void (*release)(void))
+    {
+        acquireBus = acquire;
+        releaseBus = release;
+    }
+
+  private:
+    static lv_mutex_t &mutex(void);
+    static void (*acquireBus)(void);
+    static void (*releaseBus)(void);
+};
+
 /**
  * Envelope class to allow runtime configuration of TileService variants
  * Note: This class will delete unused TileService objects.
@@ -2,7 +2,13 @@
 #define _TFTVIEW_COMMON_H_
 
 #include "graphics/common/MeshtasticView.h"
+#include "graphics/common/VirtualChat.h"
+#include "graphics/common/VirtualList.h"
 #include "meshtastic/clientonly.pb.h"
+#include "util/DistanceTracker.h"
+#include "util/LabelRegistry.h"
+#include "util/PacketLog.h"
+#include "util/PacketStats.h"
 #include <set>
 
 class MapPanel;
@@ -110,6 +116,7 @@ class TFTView_Common : public MeshtasticView
     bool isScreenLocked(void) override;
     void newMessage(uint32_t from, uint32_t to, uint8_t ch, const char *msg, uint32_t &msgtime, bool restore = true) override;
     void restoreMessage(const LogMessage &msg) override;
+    void restoreChatSummary(const ChatSummary &summary) override;
 
     // virtual methods for view-specific differences (override in subclasses)
     virtual void configureKeyboardLayouts() = 0;
@@ -172,17 +179,44 @@ class TFTView_Common : public MeshtasticView
     void updateTheme(void);
 
     // node management
-    void purgeNode(uint32_t nodeNum);
-    bool applyNodesFilter(uint32_t nodeNum, bool reset = false);
+    static lv_obj_t *createNodePanel(lv_obj_t *parent);
+    static void bindNodePanel(lv_obj_t *panel, uint32_t index);
+    void bindNode(lv_obj_t *panel, uint32_t nodeNum);
+    void refreshNode(uint32_t nodeNum);
+    void updateNodeList(void);
+    void orderNodeButtons(void);
+    void selectNode(uint32_t nodeNum);
+    void scrollToNode(uint32_t nodeNum);
+    bool purgeNode(uint32_t nodeNum);
+    bool applyNodesFilter(uint32_t nodeNum);
+    void setNodeFilterBits(uint32_t nodeNum, uint32_t slot, int channel, int hops);
+    void syncNodeFilter(void);
+    void highlightNode(uint32_t nodeNum, lv_obj_t *panel);
     void setNodeImage(uint32_t nodeNum, eRole role, bool unmessagable, lv_obj_t *img);
+    void setNodeImage(uint32_t nodeNum, lv_obj_t *img); // role from nodeDB
+    void setShortName(uint32_t nodeNum, const char *userShort, const char *userLong);
     void updateNodesStatus(void);
     void updateNodesFiltered(bool reset);
     void updateLastHeard(uint32_t nodeNum);
     void updateAllLastHeard(void);
 
+    // node widget updates, applied once per frame from nodeUpdates
+    void flushNodeUpdates(void);
+    virtual void showMetrics(uint32_t nodeNum, const NodeUpdates::Metrics &metrics);
+    void showEnvironmentMetrics(uint32_t nodeNum, const NodeUpdates::Environment &metrics);
+    virtual void showSignalStrength(uint32_t nodeNum, int32_t rssi, float snr);
+    virtual void showHopsAway(uint32_t nodeNum, uint8_t hopsAway);
+    void showLastHeard(uint32_t nodeNum, bool cameOnline);
+    static bool setLabelText(lv_obj_t *label, const char *text);
+
     // message/chat functions
     lv_obj_t *newMessageContainer(uint32_t from, uint32_t to, uint8_t ch);
     void newMessage(uint32_t nodeNum, lv_obj_t *container, uint8_t channel, const char *msg);
+    static VirtualChat *chatList(lv_obj_t *container);
+    void invalidateChats(void); // bubble sizes of all chats are measured again
+    static ChatLayout::Size measureMessage(const char *text, bool sent);
+    static lv_obj_t *createMessageBubble(lv_obj_t *parent, bool sent);
+    static void bindMessageBubble(lv_obj_t *bubble, uint32_t index);
     void addChat(uint32_t from, uint32_t to, uint8_t ch);
     void showMessages(uint8_t channel);
     void showMessages(uint32_t nodeNum);
@@ -201,7 +235,7 @@ class TFTView_Common : public MeshtasticView
     void updateFreeMem(void);
     bool updateSDCard(void);
     void formatSDCard(void);
-    void updateDistance(uint32_t nodeNum, int32_t lat, int32_t lon);
+    void updateDistance(uint32_t nodeNum, const char *distance);
     void updateSignalStrength(int32_t rssi, float snr);
     int32_t signalStrength2Percent(int32_t rx_rssi, float rx_snr);
 
@@ -220,6 +254,13 @@ class TFTView_Common : public MeshtasticView
     uint32_t language2val(meshtastic_Language lang);
     meshtastic_Language val2language(uint32_t val);
     void setLocale(meshtastic_Language lang);
+    void loadLanguagePack(const char *name);
+    void registerLabels(void);
+    // text: _("..."), the label is bound to its message ID
+    void bindLabel(lv_obj_t *obj, const char *text, LabelRegistry::Format format = nullptr);
+    void bindLabel(lv_obj_t *obj, const char *text, const char *arg);
+    void bindOptionLabel(lv_obj_t *obj, const char *text, lv_obj_t *dropdown);
+    void setLockLabel(void);
     void setLanguage(meshtastic_Language lang);
     void setTimeout(uint32_t timeout);
     void setBrightness(uint32_t brightness);
@@ -241,7 +282,11 @@ class TFTView_Common : public MeshtasticView
     void removeSpinner(void);
     void packetDetected(const meshtastic_MeshPacket &p);
     void writePacketLog(const meshtastic_MeshPacket &p);
+    static lv_obj_t *createPacketLogRow(lv_obj_t *parent);
+    static void bindPacketLogRow(lv_obj_t *row, uint32_t index);
+    static int32_t packetLogRowHeight(void);
     void updateStatistics(const meshtastic_MeshPacket &p);
+    void updateStatisticsTable(void);
 
     // map functions
     void loadMap(void);
@@ -270,6 +315,7 @@ class TFTView_Common : public MeshtasticView
     static void ui_event_ChannelButton(lv_event_t *e);
     static void ui_event_ChatButton(lv_event_t *e);
     static void ui_event_ChatDelButton(lv_event_t *e);
+    static void ui_event_chatBubble(lv_event_t *e);
     static void ui_event_chatNodeButton(lv_event_t *e);
     static void ui_event_MsgPopupButton(lv_event_t *e);
     static void ui_event_MsgRestoreButton(lv_event_t *e);
@@ -352,6 +398,7 @@ class TFTView_Common : public MeshtasticView
     static void ui_event_mapContrastSlider(lv_event_t *e);
     static void ui_event_mapNodeButton(lv_event_t *e);
     static void ui_event_positionButton(lv_event_t *e);
+    static void ui_event_labelDeleted(lv_event_t *e);
 
     // animations
     static void ui_anim_node_panel_cb(void *var, int32_t v);
@@ -374,25 +421,31 @@ class TFTView_Common : public MeshtasticView
     enum BasicSettings activeSettings = eNone;
 
     bool screensInitialised;
-    uint32_t nodesFiltered;
     bool nodesChanged;
-    bool processingFilter;
+    bool nodeRowsChanged; // order or visibility of the nodes changed, the node list is rebound with the next frame
     bool packetLogEnabled;
     bool detectorRunning;
     bool cardDetected;
     bool formatSD;
+    void *languagePack = nullptr; // tables of the current locale with LV_I18N_EXTERNAL_PACKS
+    LabelRegistry labels;         // translatable widget texts, relabeled after a locale switch
     uint16_t buttonSize;
     uint16_t statisticTableRows;
-    uint16_t packetCounter;
+    VirtualList *nodeList;    // visible rows of nodes
+    PacketLog packetLog;      // received packets while the packet log is enabled
+    VirtualList *packetList;  // visible rows of packetLog
+    PacketStats packetStats;  // packets per node, ranked for the statistics table
+    bool statisticsChanged;   // update the statistics table with the next frame
+    std::vector<PacketStats::Node> statisticsShown; // content of the statistics table rows
     time_t lastrun60, lastrun10, lastrun5, lastrun1;
     time_t actTime, uptime, lastHeard;
     bool hasPosition;
     int32_t myLatitude, myLongitude;
-    void *topNodeLL;
+    DistanceTracker distances; // distance of each node to our position
+    void *topNodeLL; // the node buttons follow this entry of the input group
     uint32_t scans;
     lv_anim_t radar;
     static uint32_t currentNode;
-    static lv_obj_t *currentPanel;
     static lv_obj_t *spinnerButton;
     static time_t startTime;
     static uint32_t pinKeys;
@@ -24,5 +24,11 @@ class LinuxInputDriver : public InputDriver
 
   private:
     std::vector<std::string> globVector(const std::string &pattern);
+    int watchDevice(const std::string &path);
+    void unwatchDevice(int &fd);
+
     lv_obj_t *mouse_cursor = nullptr;
+    // second handle on the devices to wake up the UI thread on input (see Wakeup)
+    int keyboardFd = -1;
+    int pointerFd = -1;
 };
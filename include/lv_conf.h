@@ -101,7 +101,21 @@
  * - LV_OS_WINDOWS
  * - LV_OS_MQX
  * - LV_OS_CUSTOM */
-#define LV_USE_OS   LV_OS_NONE
+/*Number of software draw units, i.e. threads rendering in parallel (e.g. -DLV_DRAW_SW_DRAW_UNIT_CNT=4).
+ *More than one selects pthreads on Linux and FreeRTOS on ESP32.*/
+#ifndef LV_DRAW_SW_DRAW_UNIT_CNT
+    #define LV_DRAW_SW_DRAW_UNIT_CNT    1
+#endif
+
+#ifndef LV_USE_OS
+    #if LV_DRAW_SW_DRAW_UNIT_CNT > 1 && defined(ARCH_PORTDUINO)
+        #define LV_USE_OS   LV_OS_PTHREAD
+    #elif LV_DRAW_SW_DRAW_UNIT_CNT > 1 && defined(ARCH_ESP32)
+        #define LV_USE_OS   LV_OS_FREERTOS
+    #else
+        #define LV_USE_OS   LV_OS_NONE
+    #endif
+#endif
 
 #if LV_USE_OS == LV_OS_CUSTOM
     #define LV_OS_CUSTOM_INCLUDE <stdint.h>
@@ -155,6 +169,7 @@
      */
 
     #define LV_DRAW_SW_SUPPORT_RGB565        1
+    #define LV_DRAW_SW_SUPPORT_RGB565_SWAPPED 1
     #define LV_DRAW_SW_SUPPORT_RGB565A8      1
     #define LV_DRAW_SW_SUPPORT_RGB888        0
     #define LV_DRAW_SW_SUPPORT_XRGB8888      0
@@ -164,10 +179,9 @@
     #define LV_DRAW_SW_SUPPORT_A8            1
     #define LV_DRAW_SW_SUPPORT_I1            1
 
-    /* Set the number of draw unit.
+    /* LV_DRAW_SW_DRAW_UNIT_CNT (the number of draw units) is set next to LV_USE_OS above.
      * > 1 requires an operating system enabled in `LV_USE_OS`
      * > 1 means multiple threads will render the screen in parallel */
-    #define LV_DRAW_SW_DRAW_UNIT_CNT    1
 
     /* Use Arm-2D to accelerate the sw render */
     #define LV_USE_DRAW_ARM2D_SYNC      0
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <functional>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * Messages of one chat with a cache of their bubble sizes, for showing a long chat with a
+ * few recycled bubbles. The texts are kept in one contiguous buffer; sizes are measured on
+ * demand (via the measure callback) and stay cached until the font or the panel width
+ * changes, the vertical positions are prefix sums of the cached heights.
+ */
+class ChatLayout
+{
+  public:
+    static constexpr uint32_t c_none = UINT32_MAX;
+
+    struct Size {
+        uint16_t width;
+        uint16_t height;
+    };
+    // bubble size of a text, sent by us or received
+    using Measure = std::function<Size(const char *text, bool sent)>;
+
+    struct Message {
+        uint32_t nodeNum;
+        uint32_t requestId;
+        uint32_t offset; // into texts
+        Size size;       // height 0 if not measured yet
+        uint8_t status;
+        bool sent;
+    };
+
+    ChatLayout(Measure measure, uint32_t gap);
+
+    // append a message, returns its index
+    uint32_t add(const char *text, bool sent, uint32_t nodeNum, uint32_t requestId, uint8_t status);
+    void setStatus(uint32_t index, uint8_t status) { messages[index].status = status; }
+    // last message with the request id or c_none
+    uint32_t findRequest(uint32_t requestId) const;
+    void clear(void);
+    uint32_t size(void) const { return messages.size(); }
+    const Message &message(uint32_t index) const { return messages[index]; }
+    const char *text(uint32_t index) const { return &texts[messages[index].offset]; }
+
+    // measure all messages again (font or panel width changed)
+    void invalidate(void);
+    Size bubble(uint32_t index);
+    // y position of a message, the bottom of the list for index size()
+    int32_t top(uint32_t index);
+    int32_t contentHeight(void) { return top(messages.size()); }
+    // message shown at y, or c_none
+    uint32_t indexAt(int32_t y);
+    uint32_t measured(void) const { return laidOut; }
+
+  private:
+    void layout(uint32_t upTo);
+
+    Measure measure;
+    const uint32_t gap;
+    std::vector<char> texts;
+    std::vector<Message> messages;
+    std::vector<int32_t> tops; // y of each message, valid up to laidOut
+    uint32_t laidOut = 0;
+};
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "FS.h"
+#include "LogMessage.h"
+#include "mesh-pb-constants.h"
+#include <stdint.h>
+#include <vector>
+
+/**
+ * Fixed-size summary of all chats in the message log (last message, time and unread count)
+ * that is persisted next to the log. It allows to show the chat list at boot without replaying
+ * the log. The table has one slot per channel and c_maxDirect slots for direct messages; if all
+ * of them are in use the least recently active DM chat is dropped.
+ *
+ * The file is replaced atomically (written to a temporary file and renamed) and protected by a
+ * crc, a missing or damaged file results in an empty summary that can be rebuilt from the log.
+ * Modifications are only kept in memory, the owner decides when to save() (see changes()). The
+ * file records the log position it is up to date with, so that the messages logged after the
+ * last save (e.g. before a power loss) can be applied again.
+ */
+class ChatSummary
+{
+  public:
+    enum ChatType : uint8_t { eFree, eChannel, eDirect };
+
+    static constexpr uint32_t c_maxChannels = c_max_channels;
+    static constexpr uint32_t c_maxDirect = 24;
+    static constexpr uint32_t c_maxChats = c_maxChannels + c_maxDirect;
+    static constexpr uint32_t c_previewLen = 40;
+
+    struct Chat {
+        uint32_t id;                // channel index or node number of the peer
+        uint32_t lastTime;          // time of the last message
+        uint32_t lastFrom;          // sender of the last message
+        uint32_t count;             // messages written since the chat was created
+        uint16_t unread;            // received messages not yet read
+        uint8_t ch;                 // channel
+        ChatType type;              // free slot, group or direct chat
+        char preview[c_previewLen]; // beginning of the last message (null terminated)
+    };
+
+    ChatSummary(fs::FS &fs, const char *fileName);
+
+    // load summary from fs, returns false if there is no valid summary
+    bool load(void);
+    // save summary to fs if modified, logPosition is the end of the log it includes
+    bool save(uint64_t logPosition);
+    // log position of the loaded or saved summary
+    uint64_t logPosition(void) const { return position; }
+    // apply a message (or trash record) written to the log
+    void update(const LogMessage &msg, uint32_t ownNode, bool unread = false);
+    // mark all messages as read
+    void markRead(void);
+    // remove all chats
+    void clear(void);
+
+    // find chat by type and id, returns nullptr if not found
+    const Chat *find(ChatType type, uint32_t id) const;
+    // all chats ordered by last activity (oldest first)
+    std::vector<const Chat *> chats(void) const;
+    // number of chats
+    uint32_t count(void) const;
+    // total number of unread messages
+    uint32_t unread(void) const;
+    bool isDirty(void) const { return dirty; }
+    // modifications since the last load or save
+    uint32_t changes(void) const { return numChanges; }
+
+  private:
+    ChatSummary(const ChatSummary &) = delete;
+    ChatSummary &operator=(const ChatSummary &) = delete;
+
+    struct FileHeader {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t chats;       // number of table entries
+        uint32_t crc;         // crc32 over log position and table
+        uint64_t logPosition; // end of the log when the summary was saved
+    };
+    static constexpr uint32_t c_magic = 0x4d555343; // "CSUM"
+    static constexpr uint16_t c_version = 2;
+
+    Chat *slot(ChatType type, uint32_t id, uint8_t ch, bool create);
+
+    fs::FS &_fs;
+    String fileName;
+    Chat table[c_maxChats]; // channels at index ch, DMs behind
+    bool dirty;
+    uint32_t numChanges;
+    uint64_t position;
+};
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * CRC-32 (IEEE 802.3, reflected polynomial 0xEDB88320) as used by zlib/PNG.
+ * Pass the result of a previous call as crc to continue a checksum over several buffers.
+ */
+uint32_t crc32(const void *data, size_t len, uint32_t crc = 0);
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <functional>
+#include <stddef.h>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Distances from our own position to all nodes with a known position, updated incrementally.
+ * Positions are kept in flat arrays of integer microdegrees together with the precomputed
+ * cos(latitude) in Q15, so a distance is a few integer operations (equirectangular projection
+ * with the mean cosine of both latitudes). Moving less than the threshold does not trigger a
+ * recomputation; otherwise all nodes are marked pending and process() works through them in
+ * batches, reporting only those whose displayed (rounded) distance changed.
+ */
+class DistanceTracker
+{
+  public:
+    static constexpr uint32_t c_none = UINT32_MAX;
+    static constexpr size_t c_textLen = 16;
+    // nodeNum and its distance formatted for display
+    using Update = std::function<void(uint32_t nodeNum, const char *text)>;
+
+    explicit DistanceTracker(uint32_t thresholdMeters = 10);
+
+    // set own position (1e-7 degrees), returns true if the distances are recomputed
+    bool setOrigin(int32_t lat, int32_t lon);
+    bool hasOrigin(void) const { return originSet; }
+    // metric or imperial units for the displayed distance
+    void setMetric(bool metric);
+    // add or update a node position (1e-7 degrees)
+    void setPosition(uint32_t nodeNum, int32_t lat, int32_t lon);
+    void remove(uint32_t nodeNum);
+    void clear(void);
+    // report the distance of a node again on the next process() even if unchanged
+    void invalidate(uint32_t nodeNum);
+    uint32_t size(void) const { return num.size(); }
+    uint32_t pending(void) const { return pendingCount; }
+
+    // recompute at most maxNodes pending nodes, returns the number of nodes recomputed
+    uint32_t process(uint32_t maxNodes, const Update &update);
+    // last computed distance in meters or c_none
+    uint32_t distance(uint32_t nodeNum) const;
+
+    // kernel: distance in meters between two positions in microdegrees, cosines of the latitudes in Q15
+    static uint32_t distance(int32_t lat1, int32_t lon1, uint16_t cos1, int32_t lat2, int32_t lon2, uint16_t cos2);
+    static uint16_t cosQ15(int32_t latMicro);
+    // displayed value: meters (or feet) for short distances and 1/10 km (or 1/10 mi) otherwise
+    static uint32_t displayValue(uint32_t meters, bool metric);
+    static void format(char *buf, size_t len, uint32_t value, bool metric);
+
+  private:
+    void markAll(void);
+
+    const uint32_t threshold;
+    bool originSet = false;
+    bool metric = true;
+    int32_t originLat = 0, originLon = 0; // microdegrees of the last recomputation
+    uint16_t originCos = 0;
+
+    // columns
+    std::vector<uint32_t> num;
+    std::vector<int32_t> lat;
+    std::vector<int32_t> lon;
+    std::vector<uint16_t> cos;
+    std::vector<uint32_t> meters;
+    std::vector<uint32_t> shown;  // displayed value, c_none if not shown yet
+    std::vector<uint8_t> dirty;   // needs recomputation
+    std::unordered_map<uint32_t, uint32_t> index; // nodeNum -> column index
+
+    uint32_t pendingCount = 0;
+    uint32_t cursor = 0;
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "FS.h"
+#include "MappedFile.h"
 #include "lvgl.h"
 
 #define FL_DRIVE_LETTER "L:"
@@ -9,7 +10,8 @@ class FileLoader
 {
   public:
     FileLoader(){};
-    static void init(fs::FS *fs);
+    // mountpoint: host directory of fs, enables loading the boot image via mmap (Linux only)
+    static void init(fs::FS *fs, const char *mountpoint = nullptr);
     static bool loadImage(lv_obj_t *img, const char *path);
     static bool loadBootImage(lv_obj_t *img);
 
@@ -27,4 +29,7 @@ class FileLoader
     } FileHandle;
 
     static fs::FS *_fs;
+    static const char *_mountpoint;
+    static MappedFile bootImage;        // boot logo, mapped for the lifetime of the image
+    static lv_image_dsc_t bootImageDsc; // in-memory PNG source for the boot logo
 };
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Fixed-size histogram of 32-bit values (e.g. durations in us) with log-linear buckets: values
+ * below c_subBuckets have a bucket each, above that every power of two is split into c_subBuckets
+ * equal buckets, so a bucket is at most 25% wide relative to its values. Adding a value is O(1)
+ * and never allocates; percentiles are accurate to the width of a bucket.
+ */
+class Histogram
+{
+  public:
+    static constexpr uint32_t c_subBits = 2;
+    static constexpr uint32_t c_subBuckets = 1 << c_subBits;
+    static constexpr uint32_t c_buckets = (32 - c_subBits + 1) * c_subBuckets;
+
+    Histogram(void) { clear(); }
+
+    void add(uint32_t value);
+    void clear(void);
+
+    uint32_t count(void) const { return samples; }
+    uint32_t min(void) const { return samples ? minimum : 0; }
+    uint32_t max(void) const { return maximum; }
+    uint32_t mean(void) const { return samples ? uint32_t(sum / samples) : 0; }
+    // upper bound of the bucket holding the given percentile (0..100), limited to max()
+    uint32_t percentile(uint32_t percent) const;
+
+    static uint32_t bucket(uint32_t value);
+    // smallest value in the bucket
+    static uint32_t lowerBound(uint32_t bucket);
+
+  private:
+    uint32_t counts[c_buckets];
+    uint32_t samples;
+    uint32_t minimum;
+    uint32_t maximum;
+    uint64_t sum;
+};
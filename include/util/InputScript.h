@@ -0,0 +1,54 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+ * Scripted input for headless runs of the UI: a text script is parsed into pointer and key events
+ * with the time (ms from the start of the script) at which they happen. One command per line,
+ * '#' starts a comment:
+ *   wait <ms>                      let time pass
+ *   tap <x> <y>                    press and release after c_tapMs
+ *   press <x> <y> / move <x> <y> / release
+ *   drag <x1> <y1> <x2> <y2> <ms>  press, move in steps of c_moveMs, release
+ *   key <name|char|code>           enter, esc, left, right, up, down, next, prev, backspace, del, home, end
+ *   snapshot <name>                save the screen
+ * Key codes are those of LV_KEY_*, so that the events can be fed to a keypad as they are.
+ */
+class InputScript
+{
+  public:
+    static constexpr uint32_t c_tapMs = 80;
+    static constexpr uint32_t c_moveMs = 20;
+
+    enum Action { ePress, eMove, eRelease, eKey, eSnapshot };
+
+    struct Event {
+        uint32_t at; // ms
+        Action action;
+        int32_t x;
+        int32_t y;
+        uint32_t key;
+        std::string name; // snapshot
+    };
+
+    // returns false and keeps the events parsed so far on the first invalid line
+    bool parse(const std::string &text);
+    bool load(const char *path);
+
+    const std::vector<Event> &events(void) const { return list; }
+    uint32_t duration(void) const { return time; }
+    // line of the parse error, 0 if none
+    uint32_t errorLine(void) const { return error; }
+
+  private:
+    bool parseLine(const std::string &line);
+    void add(Action action, int32_t x = 0, int32_t y = 0, uint32_t key = 0, const std::string &name = std::string());
+    static bool keyCode(const std::string &name, uint32_t &key);
+
+    std::vector<Event> list;
+    uint32_t time = 0;
+    uint32_t error = 0;
+    bool pressed = false;
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <functional>
+#include <stddef.h>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Labels bound to the message ID they show (and a formatter for the arguments of a format
+ * string). After a locale change only the registered labels are relabeled: visible ones on the
+ * next frame, the others a few per frame. A label whose text was changed by someone else since
+ * it was labeled is rebound to the message ID of its new text if there is one, else it is unbound
+ * instead of overwritten and its owner keeps it up to date.
+ */
+class LabelRegistry
+{
+  public:
+    using Label = const void *;
+    // write the text of a label from its translated message ID, e.g. snprintf(buf, size, translated, value)
+    using Format = std::function<void(char *buf, size_t size, const char *translated)>;
+    using Translate = std::function<const char *(const char *msgId)>;
+    using GetText = std::function<const char *(Label label)>;
+    using SetText = std::function<void(Label label, const char *text)>;
+    // message ID of a text in the current locale, nullptr if it is not translatable
+    using Resolve = std::function<const char *(const char *text)>;
+    using Visible = std::function<bool(Label label)>;
+
+    LabelRegistry(Translate translate, GetText getText, SetText setText, Resolve resolve = nullptr);
+
+    // bind a label and set its text, returns false if it was bound already (then the binding is replaced)
+    bool bind(Label label, const char *msgId, Format format = nullptr);
+    // bind a label that shows the translation of msgId already
+    bool adopt(Label label, const char *msgId);
+    // bind a label to the message ID its text resolves to, false if it has none or was bound already
+    bool adopt(Label label);
+    void unbind(Label label);
+    void clear(void);
+    bool bound(Label label) const { return index.count(label) != 0; }
+    const char *msgId(Label label) const;
+    uint32_t size(void) const { return entries.size(); }
+
+    // the locale is about to change (texts still resolve in the old one), all labels become stale
+    void invalidate(void);
+    // relabel all stale visible labels and up to budget others, returns the number of stale labels left
+    uint32_t relabel(const Visible &visible, uint32_t budget);
+    uint32_t stale(void) const { return staleCount; }
+    // number of labels unbound because their text was changed elsewhere to something untranslatable
+    uint32_t released(void) const { return releasedCount; }
+
+  private:
+    struct Entry {
+        Label label;
+        const char *msgId;
+        Format format;
+        uint32_t hash; // of the text set last, to detect changes by others
+        bool stale;
+    };
+
+    static uint32_t hash(const char *text);
+    uint32_t entry(Label label, const char *msgId, Format format);
+    void apply(Entry &e);
+    bool changed(uint32_t i); // true if the label was unbound
+    void remove(uint32_t i);
+
+    Translate translate;
+    GetText getText;
+    SetText setText;
+    Resolve resolve;
+    std::vector<Entry> entries;
+    std::unordered_map<Label, uint32_t> index; // label -> entries
+    uint32_t staleCount = 0;
+    uint32_t releasedCount = 0;
+};
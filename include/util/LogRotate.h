@@ -2,7 +2,11 @@
 
 #include "FS.h"
 #include "ILogEntry.h"
+#include "Lzss.h"
+#include "MappedFile.h"
+#include <memory>
 #include <stdint.h>
+#include <vector>
 
 /**
  * Generic LogRotate class that writes log-rotation like files into (arduino) FS storage file system
@@ -14,19 +18,37 @@
  * @param maxFiles number of log files (default is 50)
  * @param maxFileSize per log file (default size is 4000 bytes to fit into a physical block
  *                    including fs descriptor data)
+ * @param compress compress log files when they are rotated out (see class Lzss)
  *
  * If the maximum storage is exceeded then old files are deleted to fit the new log entry.
  * Note: for performance reasons the logs are not renumbered
+ *
+ * Each entry is stored as a record with a small header (magic, length, crc) so that a torn
+ * write (e.g. power loss) can be detected. init() recovers every log file by locating the
+ * last valid record and truncating the garbage behind it. Log files written before the record
+ * header was introduced are still read but not recovered.
+ *
+ * With compression enabled a log file is replaced by a compressed segment as soon as it is not
+ * the current file anymore, so more entries fit into maxSize. Segments are decompressed on the
+ * fly by readNext(); the current file always stays uncompressed for cheap appends.
+ *
+ * On Linux readNext() can map the log files instead of reading them through fs (see mapFiles()),
+ * records are then validated and deserialized directly from the mapped memory.
  */
 class LogRotate
 {
   public:
+    // position of a record: log number in the upper, offset in the uncompressed log file in the lower 32 bits
+    using Position = uint64_t;
+
     LogRotate(fs::FS &fs, const char *logDir, uint32_t maxLen, uint32_t maxSize = 102400, uint32_t maxFiles = 25,
-              uint32_t maxFileSize = 4000);
+              uint32_t maxFileSize = 4000, bool compress = false);
     // uint32_t maxSize = 4096, uint32_t maxFiles = 10, uint32_t maxFileSize = 400);
 
     // initialize the log directory
     void init(void);
+    // read log files via mmap, mountpoint is the host directory fs is mounted to (Linux only)
+    void mapFiles(const char *mountpoint);
     // write a log entry to fs
     bool write(const ILogEntry &entry);
     // read the next log entry from fs
@@ -40,13 +62,58 @@ class LogRotate
     uint32_t count(void) const;
     // request current log number
     uint32_t current(void) const;
+    // position behind the last written record
+    Position endPosition(void) const;
+    // position of the oldest log file that is left
+    Position startPosition(void) const;
+    // position of the entry returned by the last readNext()
+    Position readPosition(void) const { return lastRead; }
 
   private:
     LogRotate(const LogRotate &) = delete;
     LogRotate &operator=(const LogRotate &) = delete;
 
+    enum LogFormat { eLegacy, eRecords, eSegment };
+
+    struct RecordHeader {
+        uint16_t magic;  // c_recordMagic, distinguishes records from legacy entries
+        uint16_t length; // payload length
+        uint32_t crc;    // crc32 over length and payload
+    };
+    struct SegmentHeader {
+        uint16_t magic;   // c_segmentMagic
+        uint16_t version; // compression format
+        uint32_t rawSize; // size of the uncompressed records
+    };
+    static constexpr uint16_t c_recordMagic = 0x4d4c;  // "LM", larger than any legacy payload size
+    static constexpr uint16_t c_segmentMagic = 0x5a4c; // "LZ", compressed log file
+    static constexpr uint16_t c_segmentVersion = 1;    // Lzss stream
+
     // create filename from number
     String logFileName(uint32_t num);
+    // extract the number from a log filename, returns false for other files
+    static bool parseLogFileName(const char *name, uint32_t &num);
+    // check the format of a file (opened for reading)
+    static LogFormat logFormat(File &file);
+    static LogFormat logFormat(const uint8_t *data, size_t len);
+    // open the next log file with data for reading
+    bool openReadLog(void);
+    // read from the current file (when reading)
+    size_t readBytes(uint8_t *data, size_t size);
+    // validate the next record of the mapped file in place and return its payload (or nullptr)
+    const uint8_t *mappedRecord(int32_t &length);
+    // read and validate the next record (payload is left in buf), returns the payload length or -1
+    int32_t readRecord(const std::function<size_t(uint8_t *, size_t)> &read);
+    // validate the record at offset and return offset of the following record (or 0 if invalid)
+    uint32_t validRecord(File &file, uint32_t offset, uint32_t fileSize);
+    // find the first valid record starting in the block at offset, returns UINT32_MAX if none
+    uint32_t findRecord(File &file, uint32_t offset, uint32_t fileSize);
+    // locate the last valid record and truncate the log file behind it, returns the number of removed bytes
+    uint32_t recoverLog(uint32_t num, LogFormat &format);
+    // shrink log file to size
+    bool truncateLog(const String &name, uint32_t size);
+    // replace log file by a compressed segment, returns the number of saved bytes
+    uint32_t compressLog(uint32_t num);
     // remove oldest log and return freed size
     size_t removeLog(void);
     // scan all files in logdir to get min/max log
@@ -56,6 +123,8 @@ class LogRotate
     const uint32_t c_maxSize;     // max storage size in bytes (default is 100kB)
     const uint32_t c_maxFiles;    // max log files number (default is 50)
     const uint32_t c_maxFileSize; // max file size per log file
+    const uint32_t c_blockSize;   // checkpoint distance for the recovery scan
+    const bool c_compress;        // compress rotated log files
 
     fs::FS &_fs;
     File rootDir;             // directory (for reading logs)
@@ -69,4 +138,12 @@ class LogRotate
     uint32_t currentLogWrite; // current log number (when writing)
     uint32_t currentSize;     // size of current written log file
     uint32_t totalSize;       // size of all logs
+    LogFormat readFormat;     // format of current file (when reading)
+    std::vector<uint8_t> buf; // record buffer (when reading and writing)
+    std::unique_ptr<Lzss::Decoder> decoder; // decompression of current file (when reading)
+    String mapRoot;           // host directory of fs if files are mapped for reading
+    MappedFile mapped;        // current file if mapped (when reading)
+    size_t mapPos;            // read position in mapped file
+    uint32_t readOffset;      // offset of the next record in the current file (uncompressed, when reading)
+    Position lastRead;        // position of the last entry read
 };
\ No newline at end of file
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <functional>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * Small LZSS codec (in the spirit of heatshrink) for compressing log segments on MCUs.
+ * The stream consists of groups of a flag byte followed by 8 tokens; a set flag bit (LSB first)
+ * marks a literal byte, a cleared bit a back reference of two bytes: 11 bits distance-1 and
+ * 5 bits length-3. The decoder only needs the window (2kB) and streams its output.
+ */
+class Lzss
+{
+  public:
+    static constexpr uint32_t c_windowBits = 11;
+    static constexpr uint32_t c_lengthBits = 5;
+    static constexpr uint32_t c_windowSize = 1 << c_windowBits;
+    static constexpr uint32_t c_minMatch = 3;
+    static constexpr uint32_t c_maxMatch = c_minMatch + (1 << c_lengthBits) - 1;
+
+    // compress len bytes of data and append the result to out
+    static void compress(const uint8_t *data, size_t len, std::vector<uint8_t> &out);
+
+    /**
+     * Streaming decoder that pulls the compressed data from source
+     */
+    class Decoder
+    {
+      public:
+        using Source = std::function<size_t(uint8_t *, size_t)>;
+
+        Decoder(Source source, uint32_t rawSize);
+        // decompress up to len bytes into buf, returns less at the end of the stream
+        size_t read(uint8_t *buf, size_t len);
+        // bytes decompressed so far
+        uint32_t position(void) const { return produced; }
+
+      private:
+        Decoder(const Decoder &) = delete;
+        Decoder &operator=(const Decoder &) = delete;
+
+        int nextByte(void);
+
+        Source source;
+        const uint32_t rawSize; // size of the uncompressed data
+        uint32_t produced;      // bytes decompressed so far
+        uint16_t matchDist;     // distance of the current back reference
+        uint16_t matchLen;      // remaining bytes of the current back reference
+        uint8_t flags;          // flag byte of the current token group
+        uint8_t flagBits;       // remaining tokens of the current group
+        uint8_t inPos;          // read position in input buffer
+        uint8_t inLen;          // bytes in input buffer
+        bool corrupted;         // invalid back reference found
+        uint8_t input[64];
+        uint8_t window[c_windowSize];
+    };
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * Read-only view of a host file (Linux only). Files of at least c_minMapSize bytes are mmap'ed,
+ * smaller files (where mmap/munmap cost more than they save) or files that cannot be mapped are
+ * read into memory with a single pread(). On other platforms open() fails and the caller has to
+ * use its regular file access.
+ * The view covers the file size at open time; call refresh() to pick up data appended since then.
+ */
+class MappedFile
+{
+  public:
+    static constexpr size_t c_minMapSize = 65536;
+
+    MappedFile(void);
+    ~MappedFile(void);
+
+    // open the host file at path, returns false if neither mmap nor read() are available
+    bool open(const char *path);
+    // extend the view if the file has grown, returns true if there is new data (data() may change)
+    bool refresh(void);
+    void close(void);
+
+    bool isOpen(void) const { return fd >= 0; }
+    bool isMapped(void) const { return addr != nullptr; }
+    const uint8_t *data(void) const { return addr ? (const uint8_t *)addr : copy.data(); }
+    size_t size(void) const { return length; }
+
+  private:
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    bool load(size_t fileSize);
+
+    int fd;
+    void *addr;                // mapped memory or nullptr if read into copy
+    size_t length;             // size of the view
+    std::vector<uint8_t> copy; // file content when mmap is not available
+};
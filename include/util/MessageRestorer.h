@@ -0,0 +1,86 @@
+#pragma once
+
+#include "LogMessage.h"
+#include <deque>
+#include <functional>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Staging area for restoring the persistent message log at startup.
+ *
+ * The log is read in large blocks (load) into per-chat lists that only keep the newest
+ * maxPerChat messages of each chat; chats that were trashed are dropped while reading.
+ * Afterwards the staged messages are handed out in log order (restore) under a time budget
+ * per call so that the UI stays responsive. Live messages that arrive before the restore is
+ * finished are queued (queueLive) and handed out after the stored ones, in arrival order.
+ * The live queue is not bounded, no received message is dropped. Once the log has been read
+ * the caller may persist live messages right away and queue them for display only (logged).
+ *
+ * A chat is identified like in the view: the channel index for group messages,
+ * otherwise the node number of the peer.
+ */
+class MessageRestorer
+{
+  public:
+    using ReadFunc = std::function<bool(LogMessageEnv &)>;
+    using RestoreFunc = std::function<void(const LogMessage &, bool live, bool logged)>;
+
+    MessageRestorer(uint32_t maxPerChat = 100);
+
+    // start a new restore cycle, ownNode is required to assign DMs to their chat
+    void begin(uint32_t ownNode);
+    // read up to maxRecords log entries, returns true when the log is exhausted
+    bool load(ReadFunc read, uint32_t maxRecords);
+    // queue a message that was received before the restore has finished, logged: already in the log
+    void queueLive(uint32_t from, uint32_t to, uint8_t ch, time_t time, uint32_t len, const uint8_t *bytes, bool logged = false);
+    // hand out staged and live messages until budget is used up, returns true when all are done
+    bool restore(RestoreFunc func, uint32_t budgetMs);
+
+    bool loaded(void) const { return isLoaded; }
+    bool done(void) const { return isLoaded && next >= pending.size() && live.empty(); }
+    uint32_t recordsRead(void) const { return numRead; }
+    uint32_t bytesRead(void) const { return numBytes; }
+    uint32_t staged(void) const { return numStaged; }
+    uint32_t restored(void) const { return next; }
+    uint32_t queued(void) const { return live.size(); }
+    // percentage of staged messages that have been handed out
+    uint32_t progress(void) const;
+
+  private:
+    MessageRestorer(const MessageRestorer &) = delete;
+    MessageRestorer &operator=(const MessageRestorer &) = delete;
+
+    struct Entry {
+        uint32_t seq;
+        uint32_t from;
+        uint32_t to;
+        time_t time;
+        uint8_t ch;
+        LogMessage::MsgStatus status;
+        bool logged;
+        uint16_t len;
+        uint8_t bytes[messagePayloadSize];
+    };
+
+    uint32_t chatKey(uint32_t from, uint32_t to, uint8_t ch) const;
+    void stage(const LogMessageEnv &msg);
+    void finishLoading(void);
+    static void fill(Entry &entry, uint32_t from, uint32_t to, uint8_t ch, time_t time, LogMessage::MsgStatus status,
+                     uint32_t len, const uint8_t *bytes);
+    static void handOut(const Entry &entry, bool live, const RestoreFunc &func);
+
+    const uint32_t c_maxPerChat; // newest messages kept per chat
+
+    std::unordered_map<uint32_t, std::deque<Entry>> chats; // staging per chat while loading
+    std::vector<Entry> pending;                            // staged messages in log order after loading
+    std::deque<Entry> live;                                // live messages in arrival order
+    uint32_t ownNode;
+    uint32_t seq;       // log order of staged messages
+    uint32_t next;      // next pending message to hand out
+    uint32_t numRead;   // log entries read
+    uint32_t numBytes;  // log bytes read
+    uint32_t numStaged; // messages currently staged while loading
+    bool isLoaded;      // log has been read completely
+};
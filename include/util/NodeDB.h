@@ -0,0 +1,108 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+#include <vector>
+
+/**
+ * Data model of all nodes shown by the views, independent of any widgets.
+ * The nodes are kept in a dense struct-of-arrays store: every attribute is a separate column
+ * indexed by slot, so scans over one attribute (sorting by last heard, filtering, counting
+ * online nodes, distance updates) touch only the memory they need. A hash table maps
+ * node numbers to slots. Slots are not stable: removing a node moves the last node into
+ * the freed slot, so keep node numbers and look up the slot with find() when needed.
+ */
+class NodeDB
+{
+  public:
+    static constexpr uint32_t c_noSlot = UINT32_MAX;
+    static constexpr size_t c_shortNameLen = 5; // 4 chars + 0
+    static constexpr size_t c_longNameLen = 40;
+    static constexpr uint8_t c_unknownRole = 0xff;
+
+    enum Flags : uint8_t {
+        eHasKey = 0x01,       // public key known
+        eKeyMismatch = 0x02,  // PKI failed, don't use the key
+        eHasPosition = 0x04,  // latitude/longitude are valid
+        eViaMqtt = 0x08,      // heard via MQTT
+        eUnmessagable = 0x10, // node does not accept messages
+    };
+
+    NodeDB(void);
+
+    // add a node and return its slot (or the slot of the existing node)
+    uint32_t add(uint32_t nodeNum);
+    // remove a node, returns false if unknown
+    bool remove(uint32_t nodeNum);
+    void clear(void);
+    // slot of a node or c_noSlot
+    uint32_t find(uint32_t nodeNum) const;
+    bool contains(uint32_t nodeNum) const { return find(nodeNum) != c_noSlot; }
+    uint32_t size(void) const { return _num.size(); }
+    void reserve(uint32_t nodes);
+
+    // setters by slot
+    void setNames(uint32_t slot, const char *shortName, const char *longName);
+    void setChannel(uint32_t slot, uint8_t ch) { _channel[slot] = ch; }
+    void setRole(uint32_t slot, uint8_t role) { _role[slot] = role; }
+    void setLastHeard(uint32_t slot, uint32_t lastHeard) { _lastHeard[slot] = lastHeard; }
+    void setPosition(uint32_t slot, int32_t lat, int32_t lon);
+    void setSnr(uint32_t slot, float snr) { _snr[slot] = snr; }
+    void setHopsAway(uint32_t slot, int8_t hops) { _hopsAway[slot] = hops; }
+    void setBattery(uint32_t slot, uint8_t level) { _battery[slot] = level; }
+    void setFlag(uint32_t slot, Flags flag, bool set) { _flags[slot] = set ? (_flags[slot] | flag) : (_flags[slot] & ~flag); }
+
+    // getters by slot
+    uint32_t num(uint32_t slot) const { return _num[slot]; }
+    const char *shortName(uint32_t slot) const { return _shortName[slot].name; }
+    const char *longName(uint32_t slot) const { return _longName[slot].name; }
+    uint8_t channel(uint32_t slot) const { return _channel[slot]; }
+    uint8_t role(uint32_t slot) const { return _role[slot]; }
+    uint32_t lastHeard(uint32_t slot) const { return _lastHeard[slot]; }
+    int32_t latitude(uint32_t slot) const { return _lat[slot]; }
+    int32_t longitude(uint32_t slot) const { return _lon[slot]; }
+    float snr(uint32_t slot) const { return _snr[slot]; }
+    int8_t hopsAway(uint32_t slot) const { return _hopsAway[slot]; } // -1: unknown
+    uint8_t battery(uint32_t slot) const { return _battery[slot]; }
+    bool hasFlag(uint32_t slot, Flags flag) const { return _flags[slot] & flag; }
+
+    // columns for linear scans
+    const uint32_t *nums(void) const { return _num.data(); }
+    const uint32_t *lastHeards(void) const { return _lastHeard.data(); }
+
+    // node numbers ordered by last heard, most recent first (ties keep slot order)
+    std::vector<uint32_t> sortedByLastHeard(void) const;
+    // number of nodes heard within the last secs
+    uint32_t countOnline(time_t now, uint32_t secs) const;
+
+  private:
+    struct ShortName {
+        char name[c_shortNameLen];
+    };
+    struct LongName {
+        char name[c_longNameLen];
+    };
+
+    uint32_t hash(uint32_t nodeNum) const;
+    uint32_t lookup(uint32_t nodeNum) const; // index into table
+    void rehash(uint32_t capacity);
+
+    // columns
+    std::vector<uint32_t> _num;
+    std::vector<uint32_t> _lastHeard;
+    std::vector<int32_t> _lat;
+    std::vector<int32_t> _lon;
+    std::vector<float> _snr;
+    std::vector<ShortName> _shortName;
+    std::vector<LongName> _longName;
+    std::vector<uint8_t> _channel;
+    std::vector<uint8_t> _role;
+    std::vector<int8_t> _hopsAway;
+    std::vector<uint8_t> _battery;
+    std::vector<uint8_t> _flags;
+
+    // open addressing (linear probing) nodeNum -> slot + 1, 0 is an empty entry
+    std::vector<uint32_t> table;
+    uint32_t mask;
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <set>
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * Chooses the node to evict when the node list is full, in O(log n).
+ * Nodes are kept in ordered indexes keyed by last heard: unknown-role nodes, named nodes and
+ * chat-pinned nodes (of any role). A second split of all nodes into the newest 20% and the rest
+ * implements the 80/20 rule of the node list:
+ * - evict the oldest unknown node unless it was heard within c_freshSecs or is among the newest 20%,
+ * - otherwise evict the oldest named node, then the oldest unknown and last the oldest chat-pinned node.
+ */
+class NodeEviction
+{
+  public:
+    static constexpr uint32_t c_none = UINT32_MAX;
+    static constexpr time_t c_freshSecs = 120; // don't evict brand new unknown nodes
+
+    // add a node or update all its attributes
+    void add(uint32_t nodeNum, uint32_t lastHeard, bool unknown, bool pinned = false);
+    void remove(uint32_t nodeNum);
+    void clear(void);
+    bool contains(uint32_t nodeNum) const { return entries.find(nodeNum) != entries.end(); }
+    size_t size(void) const { return entries.size(); }
+
+    // update a single attribute, ignored for nodes not added
+    void setLastHeard(uint32_t nodeNum, uint32_t lastHeard);
+    void setUnknown(uint32_t nodeNum, bool unknown);
+    void setPinned(uint32_t nodeNum, bool pinned);
+
+    // node to evict according to the 80/20 rule (never except), or c_none if there is none
+    uint32_t victim(time_t now, uint32_t except = c_none) const;
+    // least recently heard node (never except), or c_none
+    uint32_t oldest(uint32_t except = c_none) const;
+
+  private:
+    struct Entry {
+        uint32_t lastHeard;
+        bool unknown;
+        bool pinned;
+    };
+    using Key = std::pair<uint32_t, uint32_t>; // lastHeard, nodeNum
+    using Index = std::set<Key>;
+
+    Index &indexOf(const Entry &e) { return e.pinned ? pinned : e.unknown ? unknown : named; }
+    void insert(uint32_t nodeNum, const Entry &e);
+    void erase(uint32_t nodeNum, const Entry &e);
+    void update(uint32_t nodeNum, const Entry &e);
+    void balance(void);
+
+    std::unordered_map<uint32_t, Entry> entries;
+    Index unknown;
+    Index named;
+    Index pinned;
+    Index recent; // newest 20% of all nodes
+    Index older;  // all other nodes, each key older than any key in recent
+};
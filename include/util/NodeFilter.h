@@ -0,0 +1,68 @@
+#pragma once
+
+#include <functional>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Node list filter that works without touching any widget.
+ * Each node has a normalized search key (case-folded UTF-8 with accents removed: short name,
+ * long name and hex id) in one contiguous buffer, and one bit per filter criterion that tells
+ * whether the node passes it. Filtering all nodes is then a bitwise AND of the active criteria
+ * plus a substring search over the keys.
+ */
+class NodeFilter
+{
+  public:
+    enum Criterion : uint8_t {
+        eOnline,      // heard recently
+        eKnownRole,   // role is known
+        eHasKey,      // usable public key
+        eHasPosition, // position known
+        eChannel,     // on the selected channel
+        eHops,        // within the selected hops range
+        eChat,        // active chat
+        eNumCriteria
+    };
+    // nodeNum and whether it passes the filter
+    using Visit = std::function<void(uint32_t nodeNum, bool visible)>;
+
+    void setKey(uint32_t nodeNum, const char *shortName, const char *longName);
+    void set(uint32_t nodeNum, Criterion criterion, bool pass);
+    void remove(uint32_t nodeNum);
+    void clear(void);
+    uint32_t size(void) const { return num.size(); }
+
+    // make a criterion part of the filter or not
+    void require(Criterion criterion, bool active);
+    bool required(Criterion criterion) const { return active & (1 << criterion); }
+    // substring to search for; a leading '!' hides the matching nodes instead
+    void setQuery(const char *query);
+
+    // nodes not added are visible
+    bool visible(uint32_t nodeNum) const;
+    // visit all nodes, returns the number of nodes not visible
+    uint32_t apply(const Visit &visit) const;
+
+    // case-fold UTF-8 and strip accents (Latin) for comparison
+    static void normalize(const char *utf8, std::string &out);
+
+  private:
+    uint32_t entry(uint32_t nodeNum);
+    bool passes(uint32_t i) const;
+    bool matches(uint32_t i) const;
+    void storeKey(uint32_t i, const std::string &key);
+    void compact(void);
+
+    std::vector<uint32_t> num;
+    std::vector<uint32_t> keyOffset;          // into keys, each key is 0-terminated
+    std::vector<char> keys;                   // contiguous key storage
+    uint32_t garbage = 0;                     // bytes of replaced keys in keys
+    std::vector<uint32_t> bits[eNumCriteria]; // one bit per node and criterion
+    std::unordered_map<uint32_t, uint32_t> index;
+    uint32_t active = 0; // bitmask of required criteria
+    std::string query;
+    bool negate = false;
+};
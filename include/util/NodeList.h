@@ -0,0 +1,74 @@
+#pragma once
+
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Rows of the node list, independent of any widgets: the order of the nodes (the pinned own
+ * node first, then by last heard, most recent first), which of them pass the node filter and
+ * the formatted texts that are not part of NodeDB (telemetry, position, signal).
+ * The view shows the visible rows with a small pool of recycled row widgets and binds each
+ * row from here and from NodeDB, so no widget exists per node.
+ */
+class NodeList
+{
+  public:
+    static constexpr uint32_t c_none = UINT32_MAX;
+    static constexpr uint32_t c_textLen = 40; // including the terminating 0
+
+    enum Text : uint8_t { eBattery, eSignal, ePosition1, ePosition2, eTelemetry1, eTelemetry2, eDistance, eNumTexts };
+
+    // node always shown in the first row, regardless of last heard and filter
+    void setPinned(uint32_t nodeNum);
+    uint32_t pinned(void) const { return pinnedNode; }
+    // add a node behind all nodes heard more recently, returns false if it is already listed
+    bool add(uint32_t nodeNum, uint32_t lastHeard);
+    bool remove(uint32_t nodeNum);
+    void clear(void);
+    bool contains(uint32_t nodeNum) const { return nodes.find(nodeNum) != nodes.end(); }
+    uint32_t size(void) const { return order.size(); }
+    // node numbers in list order, including the hidden nodes
+    const std::vector<uint32_t> &all(void) const { return order; }
+    // move a node that was just heard to the top (below the pinned node)
+    void moveToTop(uint32_t nodeNum, uint32_t lastHeard);
+
+    // nodes not passing the filter are hidden, returns true if the visibility changed
+    bool setVisible(uint32_t nodeNum, bool visible);
+    bool visible(uint32_t nodeNum) const;
+    // number of listed nodes that are hidden
+    uint32_t hidden(void) const { return numHidden; }
+
+    // the visible rows in list order
+    uint32_t rows(void);
+    uint32_t nodeAt(uint32_t row);
+    // row of a node or c_none if it is hidden or not listed
+    uint32_t rowOf(uint32_t nodeNum);
+
+    // formatted texts, "" if not set; returns true if the text changed (long texts are cut)
+    bool setText(uint32_t nodeNum, Text text, const char *value);
+    const char *text(uint32_t nodeNum, Text text) const;
+    void setIaq(uint32_t nodeNum, uint16_t iaq);
+    uint16_t iaq(uint32_t nodeNum) const;
+
+  private:
+    struct Node {
+        uint32_t lastHeard;
+        bool visible;
+    };
+    // texts are only stored for nodes that have any, most nodes never report telemetry
+    struct Texts {
+        char text[eNumTexts][c_textLen];
+        uint16_t iaq;
+    };
+
+    void updateRows(void);
+
+    uint32_t pinnedNode = c_none;
+    std::vector<uint32_t> order;
+    std::unordered_map<uint32_t, Node> nodes;
+    std::unordered_map<uint32_t, Texts> texts;
+    uint32_t numHidden = 0;
+    std::vector<uint32_t> visibleRows; // rebuilt lazily after the order or the visibility changed
+    bool rowsChanged = false;
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <functional>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Accumulates the latest telemetry, signal and last heard values per node between two frames.
+ * Packet handlers only record values (and mark the fields dirty); flush() hands each changed
+ * node over once per frame, so a burst of packets from the same node results in a single
+ * widget update with the most recent values.
+ */
+class NodeUpdates
+{
+  public:
+    enum Field : uint8_t {
+        eMetrics = 0x01,     // device metrics
+        eEnvironment = 0x02, // environment metrics
+        eSignal = 0x04,      // rssi/snr of a direct neighbor
+        eHopsAway = 0x08,    // hops of a relayed packet, replaces eSignal and vice versa
+        eLastHeard = 0x10
+    };
+
+    struct Metrics {
+        uint32_t batteryLevel;
+        float voltage;
+        float channelUtil;
+        float airUtil;
+    };
+
+    struct Environment {
+        float temperature;
+        float relativeHumidity;
+        float barometricPressure;
+        uint32_t iaq;
+        float voltage;
+        float current;
+    };
+
+    struct Update {
+        uint32_t nodeNum;
+        uint8_t dirty; // Field bits
+        bool cameOnline; // heard again after it was offline
+        uint8_t hopsAway;
+        int32_t rssi;
+        float snr;
+        Metrics metrics;
+        Environment environment;
+    };
+    using Flush = std::function<void(const Update &update)>;
+
+    void setMetrics(uint32_t nodeNum, const Metrics &metrics);
+    void setEnvironment(uint32_t nodeNum, const Environment &environment);
+    void setSignal(uint32_t nodeNum, int32_t rssi, float snr);
+    void setHopsAway(uint32_t nodeNum, uint8_t hopsAway);
+    void setLastHeard(uint32_t nodeNum, bool cameOnline);
+    // drop pending updates, e.g. when the node is removed
+    void remove(uint32_t nodeNum);
+    void clear(void);
+
+    // number of nodes with pending updates
+    uint32_t pending(void) const { return index.size(); }
+    // number of values that replaced a pending one (i.e. saved widget updates)
+    uint32_t coalesced(void) const { return merged; }
+
+    // hand over all changed nodes in the order of their first change, returns their number;
+    // values recorded during the flush are kept for the next one
+    uint32_t flush(const Flush &flush);
+
+  private:
+    Update &entry(uint32_t nodeNum, Field field);
+
+    std::vector<Update> updates;
+    std::vector<Update> flushing;
+    std::unordered_map<uint32_t, uint32_t> index; // nodeNum -> updates
+    uint32_t merged = 0;
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <stdint.h>
 
 /**
  * Polymorphic packets that can be moved into and out of packet queues.
@@ -22,6 +23,9 @@ class Packet
     virtual ~Packet() {}
 
     int getPacketId() const { return id; }
+    // monotonic time in us the packet was queued (see SharedQueue), 0 if unknown
+    uint64_t getEnqueued() const { return enqueued; }
+    void setEnqueued(uint64_t us) { enqueued = us; }
 
   protected:
     // Enable moving
@@ -30,6 +34,7 @@ class Packet
 
   private:
     int id;
+    uint64_t enqueued = 0;
 };
 
 /**
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * Packet log of fixed size binary records in a ring buffer; an entry is only formatted as text
+ * when it gets displayed. Traceroute paths don't fit into a record and are kept in a small ring
+ * of their own that the records refer to, so old entries may lose their path.
+ */
+class PacketLog
+{
+  public:
+    static constexpr uint8_t c_maxHops = 8;
+    static constexpr uint8_t c_noRoute = 0xff;
+    static constexpr uint8_t c_unknownHops = 0xff;
+
+    enum Detail : uint8_t { eNone, eDeviceMetrics, eEnvironmentMetrics, eAirQualityMetrics, ePowerMetrics };
+
+    struct Entry {
+        uint32_t time;
+        uint32_t from;
+        uint32_t to;
+        uint16_t port;
+        uint16_t size; // payload bytes
+        int16_t rssi;  // 0 if not received via LoRa
+        int8_t snr;    // 1/4 dB
+        uint8_t channel;
+        uint8_t hops = c_unknownHops;
+        uint8_t detail = eNone;
+        uint8_t route = c_noRoute; // set by setRoute()
+        uint8_t reserved = 0;
+    };
+
+    explicit PacketLog(uint32_t capacity, uint8_t routes = 16);
+
+    // add an entry, the oldest one is dropped when full
+    void push(const Entry &entry);
+    // attach a traceroute path (node numbers, UINT32_MAX if unknown) to the last entry
+    void setRoute(const uint32_t *hops, uint8_t count);
+    void clear(void);
+
+    // 0 is the oldest entry
+    const Entry &operator[](uint32_t i) const { return ring[(head + i) % ring.size()]; }
+    uint32_t size(void) const { return ring.size(); }
+    uint32_t capacity(void) const { return cap; }
+    // number of entries pushed since clear()
+    uint32_t total(void) const { return pushed; }
+
+    // text of entry i, time and short name of the sender are provided by the caller;
+    // the path and signal, if any, follow on a second line
+    void format(uint32_t i, const char *time, const char *fromName, uint32_t ownNode, char *buf, size_t len) const;
+    static const char *portName(uint16_t port);
+
+  private:
+    struct Route {
+        uint32_t seq;       // total() of the entry owning the path
+        uint8_t count;
+        uint8_t unknown;    // bit set for unknown hops
+        uint16_t hop[c_maxHops];
+    };
+
+    const uint32_t cap;
+    std::vector<Entry> ring; // grows up to cap, then wraps
+    uint32_t head = 0;       // oldest entry once full
+    uint32_t pushed = 0;
+    std::vector<Route> routes;
+    uint8_t nextRoute = 0;
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * Packet counters per node with the top nodes (most packets) kept ranked.
+ * Nodes are found through an open-addressing hash table, the top nodes form an indexed
+ * min-heap so that counting a packet is O(1) for most nodes and O(log top) for the top ones.
+ * Ties are broken by who reached the count first.
+ */
+class PacketStats
+{
+  public:
+    enum Counter : uint8_t { eTelemetry, ePosition, eNodeInfo, eTraceRoute, eText, eNeighborInfo, eOther, eNumCounters };
+
+    struct Node {
+        uint32_t num;
+        uint16_t count[eNumCounters];
+        uint32_t sum;
+        uint32_t seq; // packet number of the last count, for ties
+    };
+
+    explicit PacketStats(uint32_t topSize);
+
+    // number of top nodes to keep ranked
+    void setTopSize(uint32_t topSize);
+    void count(uint32_t nodeNum, Counter counter);
+    void clear(void);
+    uint32_t size(void) const { return nodes.size(); }
+    const Node *find(uint32_t nodeNum) const;
+
+    // the top nodes, best first; returns the number of nodes stored into out
+    uint32_t top(const Node **out, uint32_t max) const;
+    // true if a ranks before b
+    static bool before(const Node &a, const Node &b) { return a.sum > b.sum || (a.sum == b.sum && a.seq < b.seq); }
+
+  private:
+    static constexpr uint32_t c_none = UINT32_MAX;
+
+    uint32_t lookup(uint32_t nodeNum) const; // position in table
+    void grow(void);
+    void rank(uint32_t i);
+    void siftDown(uint32_t pos);
+    void place(uint32_t pos, uint32_t i);
+
+    std::vector<Node> nodes;
+    std::vector<uint32_t> table;   // index into nodes + 1, 0 is empty
+    std::vector<uint32_t> heap;    // min-heap of node indices, worst top node first
+    std::vector<uint32_t> heapPos; // position of each node in heap or c_none
+    uint32_t topSize;
+    uint32_t packets = 0;
+};
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Request (packet) ids from a monotonic counter, scrambled by a bijective 32-bit mix so that
+ * they look random on air. The per-boot salt selects a different sequence after each restart;
+ * within one boot an id repeats only after 2^32 requests. 0 is never returned.
+ */
+class RequestId
+{
+  public:
+    explicit RequestId(uint32_t salt) : salt(salt) {}
+
+    uint32_t next(void);
+    // bijective integer hash
+    static uint32_t mix(uint32_t x);
+
+  private:
+    uint32_t counter = 0;
+    const uint32_t salt;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <functional>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * Geometry and bookkeeping of a virtualized list: a long list of equally high rows is shown
+ * with a small pool of recycled row widgets that are rebound as the list scrolls.
+ * List row i is always shown by pool row i % poolSize(), so scrolling by one row rebinds
+ * exactly one pool row and no widget has to be moved within the pool.
+ */
+class RowWindow
+{
+  public:
+    static constexpr uint32_t c_none = UINT32_MAX;
+    using Bind = std::function<void(uint32_t poolRow, uint32_t index)>; // index c_none: hide the pool row
+
+    RowWindow(uint32_t rowHeight, uint32_t viewHeight, uint32_t overscan = 1);
+
+    void setCount(uint32_t count);
+    uint32_t count(void) const { return rows; }
+    // number of recycled rows needed to cover the view including overscan
+    uint32_t poolSize(void) const { return pool; }
+    uint32_t rowHeight(void) const { return height; }
+    // height of a row including the extra height of the expanded row
+    uint32_t rowHeight(uint32_t index) const { return index == expandedRow ? height + extra : height; }
+    // height of the whole list for the scroll extents
+    int32_t contentHeight(void) const { return (int32_t)rows * height + (expandedRow < rows ? extra : 0); }
+    int32_t rowY(uint32_t index) const { return (int32_t)index * height + (index > expandedRow ? extra : 0); }
+    uint32_t indexAt(int32_t y) const;
+
+    // let one row (e.g. a selected entry showing details) be extra pixels higher, c_none for none
+    void setExpanded(uint32_t index, uint32_t extra);
+    uint32_t expanded(void) const { return expandedRow; }
+
+    // set the scroll position (top of the view within the list)
+    void scrollTo(int32_t scrollY);
+    // range of rows bound to the pool [first, last)
+    uint32_t first(void) const { return begin; }
+    uint32_t last(void) const { return end; }
+    // list row currently bound to a pool row, or c_none
+    uint32_t indexOf(uint32_t poolRow) const { return bound[poolRow] == c_dirty ? c_none : bound[poolRow]; }
+    // pool row showing a list row, or c_none if not within the window
+    uint32_t poolRowOf(uint32_t index) const;
+
+    // force rebinding of all pool rows or of a single list row on the next update
+    void invalidate(void);
+    void invalidate(uint32_t index);
+    // call bind for all pool rows whose list row changed, returns the number of rebinds
+    uint32_t update(const Bind &bind);
+
+  private:
+    static constexpr uint32_t c_dirty = UINT32_MAX - 1; // pool row must be rebound
+
+    void updateRange(void);
+
+    const uint32_t height;
+    const uint32_t viewHeight;
+    const uint32_t overscan;
+    uint32_t pool;
+    uint32_t rows;
+    int32_t scrollY;
+    uint32_t begin;
+    uint32_t end;
+    uint32_t expandedRow;
+    uint32_t extra;
+    std::vector<uint32_t> bound; // list row per pool row
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <functional>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * Hashed timing wheel for timeouts: a timer is hashed into the slot of its deadline tick and
+ * linked into that slot's list, so scheduling and cancelling are O(1) and advancing visits only
+ * the slots of the ticks passed. Delays longer than one revolution stay in their slot until
+ * their deadline comes around. Handles carry a generation, so cancelling a timer that already
+ * expired (or whose entry was reused) does nothing.
+ */
+class TimingWheel
+{
+  public:
+    using Handle = uint64_t; // 0 is never a valid handle
+    using Expire = std::function<void(uint32_t key)>;
+
+    // tickMs: resolution, slots: number of slots (rounded up to a power of 2), now: current time in ms
+    TimingWheel(uint32_t tickMs, uint32_t slots, uint32_t now = 0);
+
+    // call expire(key) after at least delay ms
+    Handle schedule(uint32_t key, uint32_t now, uint32_t delay);
+    // returns false if the timer has expired or was cancelled already
+    bool cancel(Handle handle);
+    bool pending(Handle handle) const;
+    void clear(void);
+    uint32_t size(void) const { return count; }
+
+    // expire all timers due at now in deadline order (in scheduling order for equal deadlines),
+    // returns the number of expired timers; expire() may schedule and cancel timers
+    uint32_t advance(uint32_t now, const Expire &expire);
+
+  private:
+    static constexpr uint32_t c_nil = UINT32_MAX;
+
+    struct Timer {
+        uint32_t key;
+        uint32_t deadline; // tick
+        uint32_t seq;      // scheduling order
+        uint32_t gen;      // incremented on release
+        uint32_t prev, next;
+        bool used;
+    };
+
+    void link(uint32_t i);
+    void unlink(uint32_t i);
+    void release(uint32_t i);
+
+    const uint32_t tickMs;
+    const uint32_t mask;        // slots - 1
+    uint32_t lastMs;            // time of the current tick
+    uint32_t tick = 0;          // ticks since construction
+    uint32_t seq = 0;
+    uint32_t count = 0;
+    uint32_t freeList = c_nil;  // released timers, linked through next
+    std::vector<uint32_t> head; // first and last timer of each slot
+    std::vector<uint32_t> tail;
+    std::vector<Timer> timers;
+};
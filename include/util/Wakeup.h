@@ -0,0 +1,43 @@
+#pragma once
+
+#if defined(ARCH_PORTDUINO)
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @brief Lets a thread sleep until a timeout, an explicit notify() from another thread (e.g. a
+ *        packet was queued) or until one of the watched file descriptors becomes readable (e.g. an
+ *        input device). Based on an eventfd and poll(), so notifications are never lost: a notify()
+ *        before wait() makes the next wait() return immediately.
+ *        Watched descriptors are drained by wait(), they must be opened for this purpose only.
+ *        Except for notify() all methods are called by the waiting thread.
+ */
+class Wakeup
+{
+  public:
+    enum Cause { eTimeout, eNotified, eReadable };
+
+    Wakeup(void);
+    virtual ~Wakeup(void);
+
+    // the instance the UI thread waits on
+    static Wakeup &instance(void);
+
+    // wake up the waiting thread, may be called from any thread
+    void notify(void);
+    // wake up also when fd is readable (non-blocking, owned by the caller)
+    void watch(int fd);
+    void unwatch(int fd);
+    // block at most ms until notify() or a watched fd is readable
+    Cause wait(uint32_t ms);
+
+  private:
+    Wakeup(const Wakeup &) = delete;
+    Wakeup &operator=(const Wakeup &) = delete;
+
+    int eventFd;
+    std::vector<int> watched;
+};
+
+#endif
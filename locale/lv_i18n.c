@@ -1,4 +1,5 @@
 #include "./lv_i18n.h"
+#include <lv_i18n_hash.h> // generated into the CMake build directory, otherwise the one in locale/
 
 ////////////////////////////////////////////////////////////////////////////////
 // Define plural operands
@@ -8,6 +9,15 @@
 
 #define UNUSED(x) (void)(x)
 
+// With LV_I18N_EXTERNAL_PACKS only the English tables are linked, the other languages keep their
+// plural rule and get their tables from a language pack (lv_i18n_set_locale_pack()).
+#ifdef LV_I18N_EXTERNAL_PACKS
+#pragma GCC diagnostic ignored "-Wunused-const-variable"
+#define LV_I18N_PACK_TABLE(table) NULL
+#else
+#define LV_I18N_PACK_TABLE(table) table
+#endif
+
 static inline uint32_t op_n(int32_t val)
 {
     return (uint32_t)(val < 0 ? -val : val);
@@ -207,9 +217,9 @@ static uint8_t bg_plural_fn(int32_t num)
 }
 
 static const lv_i18n_lang_t bg_lang = {.locale_name = "bg",
-                                       .singulars = bg_singulars,
-                                       .plurals[LV_I18N_PLURAL_TYPE_ONE] = bg_plurals_one,
-                                       .plurals[LV_I18N_PLURAL_TYPE_OTHER] = bg_plurals_other,
+                                       .singulars = LV_I18N_PACK_TABLE(bg_singulars),
+                                       .plurals[LV_I18N_PLURAL_TYPE_ONE] = LV_I18N_PACK_TABLE(bg_plurals_one),
+                                       .plurals[LV_I18N_PLURAL_TYPE_OTHER] = LV_I18N_PACK_TABLE(bg_plurals_other),
                                        .locale_plural_fn = bg_plural_fn};
 
 static const lv_i18n_phrase_t cs_singulars[] = {
@@ -369,9 +379,9 @@ static uint8_t cs_plural_fn(int32_t num)
 }
 
 static const lv_i18n_lang_t cs_lang = {.locale_name = "cs",
-                                       .singulars = cs_singulars,
-                                       .plurals[LV_I18N_PLURAL_TYPE_ONE] = cs_plurals_one,
-                                       .plurals[LV_I18N_PLURAL_TYPE_OTHER] = cs_plurals_other,
+                                       .singulars = LV_I18N_PACK_TABLE(cs_singulars),
+                                       .plurals[LV_I18N_PLURAL_TYPE_ONE] = LV_I18N_PACK_TABLE(cs_plurals_one),
+                                       .plurals[LV_I18N_PLURAL_TYPE_OTHER] = LV_I18N_PACK_TABLE(cs_plurals_other),
                                        .locale_plural_fn = cs_plural_fn};
 
 static const lv_i18n_phrase_t da_singulars[] = {
@@ -564,9 +574,9 @@ static uint8_t da_plural_fn(int32_t num)
 }
 
 static const lv_i18n_lang_t da_lang = {.locale_name = "da",
-                                       .singulars = da_singulars,
-                                       .plurals[LV_I18N_PLURAL_TYPE_ONE] = da_plurals_one,
-                                       .plurals[LV_I18N_PLURAL_TYPE_OTHER] = da_plurals_other,
+                                       .singulars = LV_I18N_PACK_TABLE(da_singulars),
+                                       .plurals[LV_I18N_PLURAL_TYPE_ONE] = LV_I18N_PACK_TABLE(da_plurals_one),
+                                       .plurals[LV_I18N_PLURAL_TYPE_OTHER] = LV_I18N_PACK_TABLE(da_plurals_other),
                                        .locale_plural_fn = da_plural_fn};
 
 static const lv_i18n_phrase_t de_singulars[] = {
@@ -715,9 +725,9 @@ static uint8_t de_plural_fn(int32_t num)
 }
 
 static const lv_i18n_lang_t de_lang = {.locale_name = "de",
-                                       .singulars = de_singulars,
-                                       .plurals[LV_I18N_PLURAL_TYPE_ONE] = de_plurals_one,
-                                       .plurals[LV_I18N_PLURAL_TYPE_OTHER] = de_plurals_other,
+                                       .singulars = LV_I18N_PACK_TABLE(de_singulars),
+                                       .plurals[LV_I18N_PLURAL_TYPE_ONE] = LV_I18N_PACK_TABLE(de_plurals_one),
+                                       .plurals[LV_I18N_PLURAL_TYPE_OTHER] = LV_I18N_PACK_TABLE(de_plurals_other),
                                        .locale_plural_fn = de_plural_fn};
 
 static const lv_i18n_phrase_t el_singulars[] = {
@@ -886,9 +896,9 @@ static uint8_t el_plural_fn(int32_t num)
 }
 
 static const lv_i18n_lang_t el_lang = {.locale_name = "el",
-                                       .singulars = el_singulars,
-                                       .plurals[LV_I18N_PLURAL_TYPE_ONE] = el_plurals_one,
-                                       .plurals[LV_I18N_PLURAL_TYPE_OTHER] = el_plurals_other,
+                                       .singulars = LV_I18N_PACK_TABLE(el_singulars),
+                                       .plurals[LV_I18N_PLURAL_TYPE_ONE] = LV_I18N_PACK_TABLE(el_plurals_one),
+                                       .plurals[LV_I18N_PLURAL_TYPE_OTHER] = LV_I18N_PACK_TABLE(el_plurals_other),
                                        .locale_plural_fn = el_plural_fn};
 
 static const lv_i18n_phrase_t es_singulars[] = {
@@ -1058,9 +1068,9 @@ static uint8_t es_plural_fn(int32_t num)
 }
 
 static const lv_i18n_lang_t es_lang = {.locale_name = "es",
-                                       .singulars = es_singulars,
-                                       .plurals[LV_I18N_PLURAL_TYPE_ONE] = es_plurals_one,
-                                       .plurals[LV_I18N_PLURAL_TYPE_OTHER] = es_plurals_other,
+                                       .singulars = LV_I18N_PACK_TABLE(es_singulars),
+                                       .plurals[LV_I18N_PLURAL_TYPE_ONE] = LV_I18N_PACK_TABLE(es_plurals_one),
+                                       .plurals[LV_I18N_PLURAL_TYPE_OTHER] = LV_I18N_PACK_TABLE(es_plurals_other),
                                        .locale_plural_fn = es_plural_fn};
 
 static const lv_i18n_phrase_t fi_singulars[] = {
@@ -1190,7 +1200,7 @@ static uint8_t fi_plural_fn(int32_t num)
 }
 
 static const lv_i18n_lang_t fi_lang = {.locale_name = "fi",
-                                       .singulars = fi_singulars,
+                                       .singulars = LV_I18N_PACK_TABLE(fi_singulars),
 
                                        .locale_plural_fn = fi_plural_fn};
 
@@ -1360,9 +1370,9 @@ static uint8_t fr_plural_fn(int32_t num)
 }
 
 static const lv_i18n_lang_t fr_lang = {.locale_name = "fr",
-                                       .singulars = fr_singulars,
-                                       .plurals[LV_I18N_PLURAL_TYPE_ONE] = fr_plurals_one,
-                                       .plurals[LV_I18N_PLURAL_TYPE_OTHER] = fr_plurals_other,
+                                       .singulars = LV_I18N_PACK_TABLE(fr_singulars),
+                                       .plurals[LV_I18N_PLURAL_TYPE_ONE] = LV_I18N_PACK_TABLE(fr_plurals_one),
+                                       .plurals[LV_I18N_PLURAL_TYPE_OTHER] = LV_I18N_PACK_TABLE(fr_plurals_other),
                                        .locale_plural_fn = fr_plural_fn};
 
 static const lv_i18n_phrase_t it_singulars[] = {
@@ -1527,9 +1537,9 @@ static uint8_t it_plural_fn(int32_t num)
 }
 
 static const lv_i18n_lang_t it_lang = {.locale_name = "it",
-                                       .singulars = it_singulars,
-                                       .plurals[LV_I18N_PLURAL_TYPE_ONE] = it_plurals_one,
-                                       .plurals[LV_I18N_PLURAL_TYPE_OTHER] = it_plurals_other,
+                                       .singulars = LV_I18N_PACK_TABLE(it_singulars),
+                                       .plurals[LV_I18N_PLURAL_TYPE_ONE] = LV_I18N_PACK_TABLE(it_plurals_one),
+                                       .plurals[LV_I18N_PLURAL_TYPE_OTHER] = LV_I18N_PACK_TABLE(it_plurals_other),
                                        .locale_plural_fn = it_plural_fn};
 
 static const lv_i18n_phrase_t nl_singulars[] = {
@@ -1713,9 +1723,9 @@ static uint8_t nl_plural_fn(int32_t num)
 }
 
 static const lv_i18n_lang_t nl_lang = {.locale_name = "nl",
-                                       .singulars = nl_singulars,
-                                       .plurals[LV_I18N_PLURAL_TYPE_ONE] = nl_plurals_one,
-                                       .plurals[LV_I18N_PLURAL_TYPE_OTHER] = nl_plurals_other,
+                                       .singulars = LV_I18N_PACK_TABLE(nl_singulars),
+                                       .plurals[LV_I18N_PLURAL_TYPE_ONE] = LV_I18N_PACK_TABLE(nl_plurals_one),
+                                       .plurals[LV_I18N_PLURAL_TYPE_OTHER] = LV_I18N_PACK_TABLE(nl_plurals_other),
                                        .locale_plural_fn = nl_plural_fn};
 
 static const lv_i18n_phrase_t no_singulars[] = {
@@ -1898,9 +1908,9 @@ static uint8_t no_plural_fn(int32_t num)
 }
 
 static const lv_i18n_lang_t no_lang = {.locale_name = "no",
-                                       .singulars = no_singulars,
-                                       .plurals[LV_I18N_PLURAL_TYPE_ONE] = no_plurals_one,
-                                       .plurals[LV_I18N_PLURAL_TYPE_OTHER] = no_plurals_other,
+                                       .singulars = LV_I18N_PACK_TABLE(no_singulars),
+                                       .plurals[LV_I18N_PLURAL_TYPE_ONE] = LV_I18N_PACK_TABLE(no_plurals_one),
+                                       .plurals[LV_I18N_PLURAL_TYPE_OTHER] = LV_I18N_PACK_TABLE(no_plurals_other),
                                        .locale_plural_fn = no_plural_fn};
 
 static const lv_i18n_phrase_t pl_singulars[] = {
@@ -2029,7 +2039,7 @@ static uint8_t pl_plural_fn(int32_t num)
 }
 
 static const lv_i18n_lang_t pl_lang = {.locale_name = "pl",
-                                       .singulars = pl_singulars,
+                                       .singulars = LV_I18N_PACK_TABLE(pl_singulars),
 
                                        .locale_plural_fn = pl_plural_fn};
 
@@ -2186,9 +2196,9 @@ static uint8_t pt_plural_fn(int32_t num)
 }
 
 static const lv_i18n_lang_t pt_lang = {.locale_name = "pt",
-                                       .singulars = pt_singulars,
-                                       .plurals[LV_I18N_PLURAL_TYPE_ONE] = pt_plurals_one,
-                                       .plurals[LV_I18N_PLURAL_TYPE_OTHER] = pt_plurals_other,
+                                       .singulars = LV_I18N_PACK_TABLE(pt_singulars),
+                                       .plurals[LV_I18N_PLURAL_TYPE_ONE] = LV_I18N_PACK_TABLE(pt_plurals_one),
+                                       .plurals[LV_I18N_PLURAL_TYPE_OTHER] = LV_I18N_PACK_TABLE(pt_plurals_other),
                                        .locale_plural_fn = pt_plural_fn};
 
 static uint8_t ro_plural_fn(int32_t num)
@@ -2354,7 +2364,7 @@ static uint8_t ru_plural_fn(int32_t num)
 }
 
 static const lv_i18n_lang_t ru_lang = {.locale_name = "ru",
-                                       .singulars = ru_singulars,
+                                       .singulars = LV_I18N_PACK_TABLE(ru_singulars),
 
                                        .locale_plural_fn = ru_plural_fn};
 
@@ -2528,9 +2538,9 @@ static uint8_t se_plural_fn(int32_t num)
 }
 
 static const lv_i18n_lang_t se_lang = {.locale_name = "se",
-                                       .singulars = se_singulars,
-                                       .plurals[LV_I18N_PLURAL_TYPE_ONE] = se_plurals_one,
-                                       .plurals[LV_I18N_PLURAL_TYPE_OTHER] = se_plurals_other,
+                                       .singulars = LV_I18N_PACK_TABLE(se_singulars),
+                                       .plurals[LV_I18N_PLURAL_TYPE_ONE] = LV_I18N_PACK_TABLE(se_plurals_one),
+                                       .plurals[LV_I18N_PLURAL_TYPE_OTHER] = LV_I18N_PACK_TABLE(se_plurals_other),
                                        .locale_plural_fn = se_plural_fn};
 
 static const lv_i18n_phrase_t sl_singulars[] = {
@@ -2701,9 +2711,9 @@ static uint8_t sl_plural_fn(int32_t num)
 }
 
 static const lv_i18n_lang_t sl_lang = {.locale_name = "sl",
-                                       .singulars = sl_singulars,
-                                       .plurals[LV_I18N_PLURAL_TYPE_ONE] = sl_plurals_one,
-                                       .plurals[LV_I18N_PLURAL_TYPE_OTHER] = sl_plurals_other,
+                                       .singulars = LV_I18N_PACK_TABLE(sl_singulars),
+                                       .plurals[LV_I18N_PLURAL_TYPE_ONE] = LV_I18N_PACK_TABLE(sl_plurals_one),
+                                       .plurals[LV_I18N_PLURAL_TYPE_OTHER] = LV_I18N_PACK_TABLE(sl_plurals_other),
                                        .locale_plural_fn = sl_plural_fn};
 
 static const lv_i18n_phrase_t sr_singulars[] = {
@@ -2857,7 +2867,7 @@ static uint8_t sr_plural_fn(int32_t num)
 }
 
 static const lv_i18n_lang_t sr_lang = {.locale_name = "sr",
-                                       .singulars = sr_singulars,
+                                       .singulars = LV_I18N_PACK_TABLE(sr_singulars),
 
                                        .locale_plural_fn = sr_plural_fn};
 
@@ -3011,9 +3021,9 @@ static uint8_t tr_plural_fn(int32_t num)
 }
 
 static const lv_i18n_lang_t tr_lang = {.locale_name = "tr",
-                                       .singulars = tr_singulars,
-                                       .plurals[LV_I18N_PLURAL_TYPE_ONE] = tr_plurals_one,
-                                       .plurals[LV_I18N_PLURAL_TYPE_OTHER] = tr_plurals_other,
+                                       .singulars = LV_I18N_PACK_TABLE(tr_singulars),
+                                       .plurals[LV_I18N_PLURAL_TYPE_ONE] = LV_I18N_PACK_TABLE(tr_plurals_one),
+                                       .plurals[LV_I18N_PLURAL_TYPE_OTHER] = LV_I18N_PACK_TABLE(tr_plurals_other),
                                        .locale_plural_fn = tr_plural_fn};
 
 static const lv_i18n_phrase_t uk_singulars[] = {
@@ -3185,9 +3195,9 @@ static uint8_t uk_plural_fn(int32_t num)
 }
 
 static const lv_i18n_lang_t uk_lang = {.locale_name = "uk",
-                                       .singulars = uk_singulars,
-                                       .plurals[LV_I18N_PLURAL_TYPE_ONE] = uk_plurals_one,
-                                       .plurals[LV_I18N_PLURAL_TYPE_OTHER] = uk_plurals_other,
+                                       .singulars = LV_I18N_PACK_TABLE(uk_singulars),
+                                       .plurals[LV_I18N_PLURAL_TYPE_ONE] = LV_I18N_PACK_TABLE(uk_plurals_one),
+                                       .plurals[LV_I18N_PLURAL_TYPE_OTHER] = LV_I18N_PACK_TABLE(uk_plurals_other),
                                        .locale_plural_fn = uk_plural_fn};
 
 static const lv_i18n_phrase_t zh_cn_singulars[] = {
@@ -3334,7 +3344,7 @@ static uint8_t zh_cn_plural_fn(int32_t num)
 }
 
 static const lv_i18n_lang_t zh_cn_lang = {.locale_name = "zh-CN",
-                                          .singulars = zh_cn_singulars,
+                                          .singulars = LV_I18N_PACK_TABLE(zh_cn_singulars),
 
                                           .locale_plural_fn = zh_cn_plural_fn};
 
@@ -3349,6 +3359,42 @@ const lv_i18n_language_pack_t lv_i18n_language_pack[] = {
 // Internal state
 static const lv_i18n_language_pack_t *current_lang_pack;
 static const lv_i18n_lang_t *current_lang;
+static const lv_i18n_hash_index_t *current_index; // NULL: not in lv_i18n_hash.h, search linearly
+static const lv_i18n_hash_index_t *default_index;
+
+// Direct-mapped caches keyed by the msg_id pointer, call sites pass string literals
+#define LV_I18N_CACHE_SIZE 64        // power of 2
+#define LV_I18N_PLURAL_CACHE_SIZE 16 // power of 2
+
+typedef struct {
+    const char *msg_id;
+    const char *translation;
+} lv_i18n_cache_entry_t;
+
+typedef struct {
+    const char *msg_id;
+    const char *translation;
+    uint8_t ptypes; // plural type of current (high nibble) and default (low nibble) locale
+} lv_i18n_plural_cache_entry_t;
+
+static lv_i18n_cache_entry_t text_cache[LV_I18N_CACHE_SIZE];
+static lv_i18n_plural_cache_entry_t plural_cache[LV_I18N_PLURAL_CACHE_SIZE];
+#ifdef LV_I18N_CACHE_STATS
+static uint32_t cache_hits;
+static uint32_t cache_misses;
+#endif
+
+static void __lv_i18n_cache_clear(void)
+{
+    memset(text_cache, 0, sizeof(text_cache));
+    memset(plural_cache, 0, sizeof(plural_cache));
+}
+
+static uint32_t __lv_i18n_cache_slot(const char *msg_id)
+{
+    uintptr_t p = (uintptr_t)msg_id; // literals are packed byte by byte in .rodata
+    return (uint32_t)(p ^ (p >> 6) ^ (p >> 12));
+}
 
 /**
  * Reset internal state. For testing.
@@ -3357,6 +3403,69 @@ void __lv_i18n_reset(void)
 {
     current_lang_pack = NULL;
     current_lang = NULL;
+    current_index = NULL;
+    default_index = NULL;
+    __lv_i18n_cache_clear();
+}
+
+/**
+ * Index of a language of lv_i18n_language_pack, NULL for other packs or if the phrase table
+ * does not have the size lv_i18n_hash.h was generated for.
+ */
+static const lv_i18n_hash_index_t *__lv_i18n_hash_index(const lv_i18n_lang_t *lang)
+{
+    uint16_t i;
+    if (current_lang_pack != lv_i18n_language_pack)
+        return NULL;
+    for (i = 0; lv_i18n_hash_langs[i].locale_name != NULL; i++) {
+        if (strcmp(lv_i18n_hash_langs[i].locale_name, lang->locale_name) == 0) {
+            uint16_t size = 0;
+            while (lang->singulars != NULL && lang->singulars[size].msg_id != NULL)
+                size++;
+            return size == lv_i18n_hash_langs[i].singulars ? lv_i18n_hash_langs[i].index : NULL;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Slot of a message ID in the dense index arrays: FNV-1a over the string, its bucket selects
+ * the displacement that makes the mixed hash collision free (see lv_i18n_hash.py).
+ */
+static uint32_t __lv_i18n_hash_slot(const char *msg_id)
+{
+    uint32_t h = 2166136261u;
+    const unsigned char *s = (const unsigned char *)msg_id;
+    while (*s) {
+        h ^= *s++;
+        h *= 16777619u;
+    }
+    uint32_t x = h ^ lv_i18n_hash_displace[h % LV_I18N_HASH_BUCKETS];
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x % LV_I18N_HASH_KEYS;
+}
+
+/**
+ * Look up a singular via the hash index. Returns 0 if the phrase table does not match the index
+ * (unknown message ID or tables out of sync), then the caller has to search linearly.
+ */
+static int __lv_i18n_hash_get_text(const lv_i18n_lang_t *lang, lv_i18n_hash_index_t idx, const char *msg_id,
+                                   const char **txt)
+{
+    *txt = NULL;
+    if (idx == 0)
+        return 1;
+    if (lang->singulars == NULL)
+        return 0;
+    const lv_i18n_phrase_t *phrase = &lang->singulars[idx - 1];
+    if (strcmp(phrase->msg_id, msg_id) != 0)
+        return 0;
+    *txt = phrase->translation;
+    return 1;
 }
 
 /**
@@ -3372,6 +3481,9 @@ int lv_i18n_init(const lv_i18n_language_pack_t *langs)
 
     current_lang_pack = langs;
     current_lang = langs[0]; /*Automatically select the first language*/
+    default_index = __lv_i18n_hash_index(current_lang);
+    current_index = default_index;
+    __lv_i18n_cache_clear();
     return 0;
 }
 
@@ -3398,6 +3510,8 @@ int lv_i18n_set_locale(const char *l_name)
         // Found -> finish
         if (strcmp(current_lang_pack[i]->locale_name, l_name) == 0) {
             current_lang = current_lang_pack[i];
+            current_index = __lv_i18n_hash_index(current_lang);
+            __lv_i18n_cache_clear();
             return 0;
         }
     }
@@ -3405,6 +3519,130 @@ int lv_i18n_set_locale(const char *l_name)
     return -1;
 }
 
+// Header of a language pack written by lv_i18n_hash.py --packs, little endian
+typedef struct {
+    char magic[4];     // "LVI\x01"
+    uint32_t checksum; // LV_I18N_HASH_CHECKSUM of the message IDs the index was built for
+    uint16_t keys;     // LV_I18N_HASH_KEYS
+    uint8_t index_size;
+    uint8_t reserved;
+    char locale_name[8];
+    uint16_t singulars;
+    uint8_t plurals[_LV_I18N_PLURAL_TYPE_NUM];
+    uint32_t pool_size;
+} lv_i18n_pack_header_t;
+
+#define LV_I18N_PACK_ALIGN(n, a) (((n) + (a)-1) & ~(uint32_t)((a)-1))
+
+static uint32_t __lv_i18n_pack_phrases(const lv_i18n_pack_header_t *header)
+{
+    uint32_t count = header->singulars;
+    uint16_t t;
+    for (t = 0; t < _LV_I18N_PLURAL_TYPE_NUM; t++)
+        count += header->plurals[t];
+    return count;
+}
+
+static uint32_t __lv_i18n_pack_phrases_offset(void)
+{
+    return LV_I18N_PACK_ALIGN(sizeof(lv_i18n_pack_header_t) + LV_I18N_HASH_KEYS * sizeof(lv_i18n_hash_index_t), 4);
+}
+
+/**
+ * Bytes to allocate for a language pack
+ * @param header the first LV_I18N_PACK_HEADER_SIZE bytes of the pack
+ * @param size size of the pack
+ * @return the size of the buffer to pass to `lv_i18n_set_locale_pack`, 0 if the pack does not match this firmware
+ */
+uint32_t lv_i18n_pack_alloc_size(const void *header, uint32_t size)
+{
+    const lv_i18n_pack_header_t *h = (const lv_i18n_pack_header_t *)header;
+    if (size < sizeof(lv_i18n_pack_header_t) || memcmp(h->magic, "LVI\x01", 4) != 0 ||
+        h->checksum != LV_I18N_HASH_CHECKSUM || h->keys != LV_I18N_HASH_KEYS ||
+        h->index_size != sizeof(lv_i18n_hash_index_t) || h->locale_name[sizeof(h->locale_name) - 1] != '\0')
+        return 0;
+    uint32_t phrases = __lv_i18n_pack_phrases(h);
+    if (__lv_i18n_pack_phrases_offset() + phrases * 8 + h->pool_size != size)
+        return 0;
+    // the phrase tables are built behind the pack: one end mark for the singulars and each plural form
+    return LV_I18N_PACK_ALIGN(size, sizeof(void *)) + sizeof(lv_i18n_lang_t) +
+           (phrases + 1 + _LV_I18N_PLURAL_TYPE_NUM) * sizeof(lv_i18n_phrase_t);
+}
+
+static const lv_i18n_phrase_t *__lv_i18n_pack_table(lv_i18n_phrase_t **phrases, const uint32_t **offsets, uint32_t count,
+                                                    const char *pool)
+{
+    if (count == 0)
+        return NULL;
+    lv_i18n_phrase_t *table = *phrases;
+    uint32_t i;
+    for (i = 0; i < count; i++) {
+        table[i].msg_id = pool + (*offsets)[2 * i];
+        table[i].translation = pool + (*offsets)[2 * i + 1];
+    }
+    table[count].msg_id = NULL;
+    table[count].translation = NULL;
+    *phrases += count + 1;
+    *offsets += 2 * count;
+    return table;
+}
+
+/**
+ * Change the localization to a language pack loaded from a file. The language must be part of the
+ * initialized language pack (for its plural rule), English stays the fallback.
+ * @param data buffer of `lv_i18n_pack_alloc_size` bytes that starts with the pack, it must stay
+ *             allocated until the locale is changed again
+ * @param size size of the pack
+ * @return 0 on success, -1 if the pack is invalid or the language unknown
+ */
+int lv_i18n_set_locale_pack(void *data, uint32_t size)
+{
+    if (current_lang_pack == NULL || lv_i18n_pack_alloc_size(data, size) == 0)
+        return -1;
+
+    const lv_i18n_pack_header_t *header = (const lv_i18n_pack_header_t *)data;
+    const lv_i18n_lang_t *compiled = NULL;
+    uint16_t i;
+    for (i = 0; current_lang_pack[i] != NULL && compiled == NULL; i++) {
+        if (strcmp(current_lang_pack[i]->locale_name, header->locale_name) == 0)
+            compiled = current_lang_pack[i];
+    }
+    if (compiled == NULL)
+        return -1;
+
+    // validate everything the lookup relies on, the pack comes from a file
+    uint8_t *base = (uint8_t *)data;
+    const lv_i18n_hash_index_t *index = (const lv_i18n_hash_index_t *)(base + sizeof(lv_i18n_pack_header_t));
+    const uint32_t *offsets = (const uint32_t *)(base + __lv_i18n_pack_phrases_offset());
+    uint32_t phrases = __lv_i18n_pack_phrases(header);
+    const char *pool = (const char *)(offsets + 2 * phrases);
+    uint32_t k;
+    for (k = 0; k < LV_I18N_HASH_KEYS; k++) {
+        if (index[k] > header->singulars)
+            return -1;
+    }
+    if (header->pool_size > 0 && pool[header->pool_size - 1] != '\0')
+        return -1;
+    for (k = 0; k < 2 * phrases; k++) {
+        if (offsets[k] >= header->pool_size)
+            return -1;
+    }
+
+    lv_i18n_lang_t *lang = (lv_i18n_lang_t *)(base + LV_I18N_PACK_ALIGN(size, sizeof(void *)));
+    lv_i18n_phrase_t *tables = (lv_i18n_phrase_t *)(lang + 1);
+    memset(lang, 0, sizeof(lv_i18n_lang_t));
+    lang->locale_name = compiled->locale_name;
+    lang->locale_plural_fn = compiled->locale_plural_fn;
+    lang->singulars = __lv_i18n_pack_table(&tables, &offsets, header->singulars, pool);
+    for (i = 0; i < _LV_I18N_PLURAL_TYPE_NUM; i++)
+        lang->plurals[i] = __lv_i18n_pack_table(&tables, &offsets, header->plurals[i], pool);
+
+    current_lang = lang;
+    current_index = index;
+    __lv_i18n_cache_clear();
+    return 0;
+}
+
 static const char *__lv_i18n_get_text_core(const lv_i18n_phrase_t *trans, const char *msg_id)
 {
     uint16_t i;
@@ -3419,19 +3657,25 @@ static const char *__lv_i18n_get_text_core(const lv_i18n_phrase_t *trans, const
     return NULL;
 }
 
-/**
- * Get the translation from a message ID
- * @param msg_id message ID
- * @return the translation of `msg_id` on the set local
- */
-const char *lv_i18n_get_text(const char *msg_id)
+static const char *__lv_i18n_lookup_text(const char *msg_id)
 {
-    if (current_lang == NULL)
-        return msg_id;
-
     const lv_i18n_lang_t *lang = current_lang;
     const void *txt;
 
+    // Hash lookup in current and default locale
+    if (current_index != NULL && default_index != NULL) {
+        uint32_t slot = __lv_i18n_hash_slot(msg_id);
+        const char *hashed;
+        if (__lv_i18n_hash_get_text(lang, current_index[slot], msg_id, &hashed)) {
+            if (hashed != NULL)
+                return hashed;
+            if (lang == current_lang_pack[0])
+                return msg_id;
+            if (__lv_i18n_hash_get_text(current_lang_pack[0], default_index[slot], msg_id, &hashed))
+                return hashed != NULL ? hashed : msg_id;
+        }
+    }
+
     // Search in current locale
     if (lang->singulars != NULL) {
         txt = __lv_i18n_get_text_core(lang->singulars, msg_id);
@@ -3455,16 +3699,32 @@ const char *lv_i18n_get_text(const char *msg_id)
 }
 
 /**
- * Get the translation from a message ID and apply the language's plural rule to get correct form
+ * Get the translation from a message ID
  * @param msg_id message ID
- * @param num an integer to select the correct plural form
  * @return the translation of `msg_id` on the set local
  */
-const char *lv_i18n_get_text_plural(const char *msg_id, int32_t num)
+const char *lv_i18n_get_text(const char *msg_id)
 {
     if (current_lang == NULL)
         return msg_id;
 
+    lv_i18n_cache_entry_t *entry = &text_cache[__lv_i18n_cache_slot(msg_id) & (LV_I18N_CACHE_SIZE - 1)];
+    if (entry->msg_id == msg_id) {
+#ifdef LV_I18N_CACHE_STATS
+        cache_hits++;
+#endif
+        return entry->translation;
+    }
+#ifdef LV_I18N_CACHE_STATS
+    cache_misses++;
+#endif
+    entry->msg_id = msg_id;
+    entry->translation = __lv_i18n_lookup_text(msg_id);
+    return entry->translation;
+}
+
+static const char *__lv_i18n_lookup_text_plural(const char *msg_id, int32_t num)
+{
     const lv_i18n_lang_t *lang = current_lang;
     const void *txt;
     lv_i18n_plural_type_t ptype;
@@ -3499,6 +3759,91 @@ const char *lv_i18n_get_text_plural(const char *msg_id, int32_t num)
     return msg_id;
 }
 
+/**
+ * Get the translation from a message ID and apply the language's plural rule to get correct form
+ * @param msg_id message ID
+ * @param num an integer to select the correct plural form
+ * @return the translation of `msg_id` on the set local
+ */
+const char *lv_i18n_get_text_plural(const char *msg_id, int32_t num)
+{
+    if (current_lang == NULL)
+        return msg_id;
+
+    // the translation depends on num only through the plural types of the current and default locale
+    const lv_i18n_lang_t *def = current_lang_pack[0];
+    uint8_t ptypes = (current_lang->locale_plural_fn ? current_lang->locale_plural_fn(num) : _LV_I18N_PLURAL_TYPE_NUM) << 4;
+    ptypes |= def->locale_plural_fn ? def->locale_plural_fn(num) : _LV_I18N_PLURAL_TYPE_NUM;
+
+    lv_i18n_plural_cache_entry_t *entry =
+        &plural_cache[__lv_i18n_cache_slot(msg_id) & (LV_I18N_PLURAL_CACHE_SIZE - 1)];
+    if (entry->msg_id == msg_id && entry->ptypes == ptypes) {
+#ifdef LV_I18N_CACHE_STATS
+        cache_hits++;
+#endif
+        return entry->translation;
+    }
+#ifdef LV_I18N_CACHE_STATS
+    cache_misses++;
+#endif
+    entry->msg_id = msg_id;
+    entry->ptypes = ptypes;
+    entry->translation = __lv_i18n_lookup_text_plural(msg_id, num);
+    return entry->translation;
+}
+
+/**
+ * The copy of a message ID in the compiled tables, the IDs of a language pack live in its buffer.
+ * @return NULL if msg_id is unknown
+ */
+static const char *__lv_i18n_compiled_msg_id(const char *msg_id)
+{
+    const char *key = lv_i18n_hash_keys[__lv_i18n_hash_slot(msg_id)];
+    if (strcmp(key, msg_id) == 0)
+        return key;
+
+    // not in lv_i18n_hash.h (out of sync with the tables): the default language
+    const lv_i18n_phrase_t *phrase = current_lang_pack[0]->singulars;
+    for (; phrase != NULL && phrase->msg_id != NULL; phrase++) {
+        if (strcmp(phrase->msg_id, msg_id) == 0)
+            return phrase->msg_id;
+    }
+    return NULL;
+}
+
+/**
+ * Get the message ID a text was translated from on the set locale (reverse of lv_i18n_get_text)
+ * @param text text of a widget
+ * @return the message ID or NULL if `text` is neither a translation of the set locale nor an
+ * untranslated message ID. The ID is one of the compiled tables, it stays valid after the locale
+ * changed, also if the set locale was a language pack that gets freed.
+ */
+const char *lv_i18n_get_msg_id(const char *text)
+{
+    if (current_lang == NULL || text == NULL)
+        return NULL;
+
+    // the translations of the set locale, then those of the default it falls back to
+    const lv_i18n_lang_t *langs[] = {current_lang, current_lang_pack[0]};
+    uint16_t i;
+    for (i = 0; i < 2; i++) {
+        const lv_i18n_phrase_t *phrase = langs[i]->singulars;
+        for (; phrase != NULL && phrase->msg_id != NULL; phrase++) {
+            if (strcmp(phrase->translation, text) == 0)
+                return __lv_i18n_compiled_msg_id(phrase->msg_id);
+        }
+    }
+    return __lv_i18n_compiled_msg_id(text);
+}
+
+#ifdef LV_I18N_CACHE_STATS
+void lv_i18n_get_cache_stats(uint32_t *hits, uint32_t *misses)
+{
+    *hits = cache_hits;
+    *misses = cache_misses;
+}
+#endif
+
 /**
  * Get the name of the currently used locale.
  * @return name of the currently used locale. E.g. "en-GB"
@@ -52,8 +52,29 @@ int lv_i18n_init_default(void);
  */
 int lv_i18n_set_locale(const char *l_name);
 
+#define LV_I18N_PACK_HEADER_SIZE 32
+
+/**
+ * Bytes to allocate for a language pack
+ * @param header the first LV_I18N_PACK_HEADER_SIZE bytes of the pack
+ * @param size size of the pack
+ * @return the size of the buffer to pass to `lv_i18n_set_locale_pack`, 0 if the pack does not match this firmware
+ */
+uint32_t lv_i18n_pack_alloc_size(const void *header, uint32_t size);
+
+/**
+ * Change the localization to a language pack loaded from a file (see locale/README.md)
+ * @param data buffer of `lv_i18n_pack_alloc_size` bytes that starts with the pack, it must stay
+ *             allocated until the locale is changed again
+ * @param size size of the pack
+ * @return 0 on success, -1 if the pack is invalid or the language unknown
+ */
+int lv_i18n_set_locale_pack(void *data, uint32_t size);
+
 /**
  * Get the translation from a message ID
+ * Results are cached by the `msg_id` pointer, so the text it points to must not change
+ * (string literals, as passed by `_()`).
  * @param msg_id message ID
  * @return the translation of `msg_id` on the set local
  */
@@ -67,6 +88,13 @@ const char *lv_i18n_get_text(const char *msg_id);
  */
 const char *lv_i18n_get_text_plural(const char *msg_id, int32_t num);
 
+/**
+ * Get the message ID a text was translated from on the set locale
+ * @param text text of a widget
+ * @return the message ID or NULL if `text` is not a translation of the set locale or a message ID
+ */
+const char *lv_i18n_get_msg_id(const char *text);
+
 /**
  * Get the name of the currently used localization.
  * @return name of the currently used localization. E.g. "en_GB"
@@ -75,6 +103,13 @@ const char *lv_i18n_get_current_locale(void);
 
 void __lv_i18n_reset(void);
 
+#ifdef LV_I18N_CACHE_STATS
+/**
+ * Number of lookups answered from the translation caches and lookups that had to search.
+ */
+void lv_i18n_get_cache_stats(uint32_t *hits, uint32_t *misses);
+#endif
+
 #define _(text) lv_i18n_get_text(text)
 #define _p(text, num) lv_i18n_get_text_plural(text, num)
 
@@ -0,0 +1,502 @@
+// generated by lv_i18n_hash.py from locale/*.yml, do not edit
+// minimal perfect hash over the message IDs (see __lv_i18n_hash_slot() in lv_i18n.c) and per
+// language the 1-based position of each message in <locale>_singulars, 0 if not translated
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define LV_I18N_HASH_KEYS 191
+#define LV_I18N_HASH_BUCKETS 48
+#define LV_I18N_HASH_CHECKSUM 0x375108f9u // of the message IDs, identifies compatible language packs
+
+typedef uint8_t lv_i18n_hash_index_t;
+
+typedef struct {
+    const char *locale_name;
+    uint16_t singulars; // size of <locale>_singulars, to detect tables out of sync
+    const lv_i18n_hash_index_t *index;
+} lv_i18n_hash_lang_t;
+
+static const uint16_t lv_i18n_hash_displace[LV_I18N_HASH_BUCKETS] = {
+    131, 16, 247, 7, 59, 23, 284, 11, 55, 65, 1, 2, 2, 24, 16, 1, 256, 57, 15, 1, 2080, 19, 58, 5, 2, 214, 3, 301, 3, 0,
+    98, 11, 32, 58, 17, 78, 7, 26, 9, 1, 142, 211, 16, 12, 366, 161, 80, 176,
+};
+
+static const char *const lv_i18n_hash_keys[LV_I18N_HASH_KEYS] = {
+    "SD unknown error",
+    "FrequencySlot: 1 (902.0MHz)",
+    "Group Channels",
+    "Screen Calibration: %s",
+    "User name: %s",
+    "Locations Map (%d/%d)",
+    "Screen Brightness: %d%%",
+    "Screen Lock: %s",
+    "Position",
+    "no public key",
+    "Heap: 0\\nLVGL: 0",
+    "Screen Timeout: 60s",
+    "Hops away",
+    "now",
+    "Active Chat",
+    "no new messages",
+    "Screen Lock: off",
+    "Client\nClient Mute\nRouter\nRepeater\nTracker\nSensor\nTAK\nClient Hidden\nLost & Found\nTAK Tracker\nRouter Late",
+    "Settings & Tools",
+    "DEL",
+    "Input Control: %s/%s",
+    "Sound only",
+    "Brightness: %d%%",
+    "Failed to restore keys!",
+    "Please set region and name",
+    "Resynch ...",
+    "Resync ...",
+    "Heap: %d (%d%%)\\nLVGL: %d (%d%%)",
+    "choose target node",
+    "hops: %d",
+    "OK",
+    "silent",
+    "Enter Text ...",
+    "Locations Map",
+    "<not set>",
+    "Timeout: 60s",
+    "Message Alert Buzzer: on",
+    "Device Role: %s",
+    "Modem Preset: %s",
+    "Filter",
+    "Role: Client",
+    "Rebooting ...",
+    "Modem Preset: LONG FAST",
+    "no SD card detected",
+    "Brightness: 60%",
+    "Restore",
+    "Client\nClient Mute\nRouter\n-- deprecated --\nRepeater\nTracker\nSensor\nTAK\nClient Hidden\nLost & Found\nTAK Tracker",
+    "Signal Scanner",
+    "Input Control: none/none",
+    "Configuration Reset",
+    "Util %0.1f%%  Air %0.1f%%",
+    "Long Name",
+    "Channel: LongFast",
+    "%d of %d nodes online",
+    "Mouse",
+    "Channel: %s",
+    "Trace Route",
+    "unknown",
+    "No map tiles found on SDCard!",
+    "%s: %d GB (%s)\nUsed: %0.2f GB (%d%%)",
+    "Start",
+    "Failed to retrieve keys!",
+    "none",
+    "Resync...",
+    "%s (%0.1f GB)\nUsed: %d MB (%d%%)",
+    "No map tiles found",
+    "Settings Lock",
+    "Klijent\nKlijent bez zvuka\nRuter\n-- ne koristi se --\nRipiter\nTreker\nSenzor\nTAK\nSakriven klijent\nIzgubljeno - nađeno\nTAK Treker",
+    "Banner & Sound",
+    "Short Name",
+    "NodeDB Reset\nFactory Reset\nClear Chat History",
+    "Telemetry",
+    "Unknown",
+    "New message from \n%s",
+    "Screen Timeout: off",
+    "SD invalid format",
+    "no signal",
+    "WiFi SSID",
+    "LONG FAST\nLONG SLOW\n-- zastarelo --\nMEDIUM SLOW\nMEDIUM FAST\nSHORT SLOW\nSHORT FAST\nLONG MODERATE\nSHORT TURBO",
+    "New message from \\n%s",
+    "Channel",
+    "Backup",
+    "New Message from\\n",
+    "<no name>",
+    "Stop",
+    "DALEKO BRZO\nDALEKO SPORO\n-- ne koristi se --\nSREDNJE SPORO\nSREDNJE BRZO\nBLIZU SPORO\nBLIZU BRZO\nDALEKO SREDNJE\nBLIZU TURBO",
+    "WiFi pre-shared Key",
+    "LONG FAST\nLONG SLOW\n-- deprecated --\nMEDIUM SLOW\nMEDIUM FAST\nSHORT SLOW\nSHORT FAST\nLONG MODERATE\nSHORT TURBO",
+    "Heap: 0\nLVGL: 0",
+    "Region: %s",
+    "%d active chat(s)",
+    "Client\nClient Mute\n-- deprecated --\nRouter\nRepeater\nTracker\nSensor\nTAK\nClient Hidden\nLost & Found\nTAK Tracker",
+    "LONG FAST\nLONG MODERATE\nLONG TURBO\nMEDIUM FAST\nMEDIUM SLOW\nSHORT FAST\nSHORT TURBO\nSHORT SLOW",
+    "Secondary Channels",
+    "LoRa 0.0 MHz",
+    "Message Alert",
+    "off",
+    "Configuration  Reset",
+    "Heap: %d (%d%%)\nLVGL: %d (%d%%)",
+    "New Message from\n",
+    "Channel Name",
+    "Packet Log",
+    "SD mbr not found",
+    "Lock: %s/%s",
+    "Filter: %d of %d nodes",
+    "Backup & Restore",
+    "no messages",
+    "SD slot empty",
+    "FrequencySlot: %d (%.2f MHz)",
+    "no chats",
+    "Banner only",
+    "Default",
+    "Reboot / Shutdown",
+    "Failed to parse keys!",
+    "WiFi: %s",
+    "Lock PIN",
+    "City",
+    "Timeout: off",
+    "Dark\nLight",
+    "Message Alert: %s",
+    "Disconnected!",
+    "Meshtastic",
+    "Region",
+    "Timeout: %ds",
+    "Node Options",
+    "Pre-shared Key",
+    "MQTT",
+    "Failed to write keys!",
+    "Name",
+    "Light\\nDark",
+    "Enter Filter ...",
+    "Client\nClient Mute\nRouter\nRepeater\nTracker\nSensor\nTAK\nClient Hidden\nLost & Found\nTAK Tracker",
+    ">> Programming mode <<",
+    "done",
+    "Shutting down ...",
+    "uptime: %02d:%02d:%02d",
+    "Connected!",
+    "Filtering ...",
+    "%d new message",
+    "Mesh Detector",
+    "Restoring messages ...",
+    "Tools",
+    "default",
+    "Neighbors",
+    "Offline",
+    "Screen Brightness: 60%",
+    "SD card error",
+    "choose\nnode",
+    "Screen Lock",
+    "Resynch...",
+    "Packet Statistics",
+    "Modem Preset: custom",
+    "1 of 1 nodes online",
+    "FrequencySlot: %d (%g MHz)",
+    "Theme: Dark",
+    "uptime 00:00:00",
+    "Zone",
+    "Public/Private Key",
+    "Node Search",
+    "Client\nClient Mute\nTracker\nSensor\nTAK\nClient Hidden\nLost & Found\nTAK Tracker",
+    "Primary Channel",
+    "Settings (advanced)",
+    "Cancel",
+    "%d new messages",
+    "region unset",
+    "choose node",
+    "Screen Timeout: %ds",
+    "map tiles not found!",
+    "NodeDB Reset\nFactory Reset",
+    "Statistics",
+    "Theme: %s",
+    "!Enter Filter ...",
+    "<unset>",
+    "Language: %s",
+    "New Message from \n%s",
+    "Keyboard",
+    "IAQ",
+    "Highlight",
+    "Ringtone",
+    "Reboot into BaseUI?",
+    "Settings",
+    "Language: English",
+    "User name: ",
+    "Screen Calibration: default",
+    "LoRa TX off!",
+    "Public Key",
+    "WiFi: <not setup>",
+    "on",
+    "Packet Log: %d",
+    "heard: !%08x",
+    "Lock: off/off",
+};
+
+static const lv_i18n_hash_index_t lv_i18n_hash_en[LV_I18N_HASH_KEYS] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+#ifndef LV_I18N_EXTERNAL_PACKS
+static const lv_i18n_hash_index_t lv_i18n_hash_bg[LV_I18N_HASH_KEYS] = {
+    0, 0, 13, 32, 30, 0, 78, 79, 57, 0, 0, 6, 56, 89, 59, 1, 38, 0, 46, 0, 0, 116, 68, 0, 0, 0, 98, 0, 73, 83, 0, 101,
+    108, 17, 112, 0, 9, 31, 0, 94, 5, 99, 0, 0, 23, 0, 65, 41, 0, 11, 0, 21, 4, 0, 24, 36, 42, 84, 0, 0, 61, 0, 0, 0, 0,
+    0, 106, 0, 114, 20, 0, 60, 53, 86, 76, 0, 0, 105, 0, 0, 0, 0, 29, 85, 71, 0, 0, 64, 0, 35, 0, 0, 0, 97, 0, 26, 81,
+    0, 0, 0, 28, 45, 0, 107, 88, 0, 14, 0, 0, 18, 115, 0, 12, 0, 111, 49, 52, 69, 66, 82, 0, 0, 0, 70, 19, 0, 0, 0, 58,
+    0, 110, 0, 0, 33, 100, 92, 0, 87, 90, 40, 0, 93, 34, 43, 54, 7, 0, 72, 48, 0, 63, 0, 2, 0, 39, 0, 51, 0, 47, 0, 96,
+    16, 67, 91, 113, 0, 77, 0, 27, 44, 62, 109, 22, 37, 0, 25, 0, 95, 50, 0, 15, 10, 3, 8, 104, 55, 102, 80, 75, 74,
+    103,
+};
+#endif
+
+#ifndef LV_I18N_EXTERNAL_PACKS
+static const lv_i18n_hash_index_t lv_i18n_hash_cs[LV_I18N_HASH_KEYS] = {
+    0, 29, 18, 40, 1, 23, 85, 86, 65, 0, 0, 10, 64, 97, 67, 3, 0, 0, 54, 5, 94, 117, 75, 0, 0, 0, 107, 0, 80, 90, 0,
+    110, 121, 22, 114, 31, 14, 2, 44, 101, 9, 108, 7, 0, 30, 0, 0, 49, 13, 16, 0, 27, 8, 0, 32, 45, 50, 91, 0, 0, 0, 0,
+    71, 39, 0, 0, 119, 0, 115, 26, 35, 68, 61, 93, 83, 0, 125, 0, 0, 0, 0, 0, 0, 92, 78, 0, 113, 0, 0, 43, 0, 0, 0, 105,
+    0, 34, 88, 0, 0, 38, 36, 53, 0, 120, 96, 0, 19, 0, 0, 24, 116, 72, 17, 0, 0, 57, 60, 76, 106, 89, 0, 0, 0, 77, 25,
+    37, 0, 0, 66, 0, 123, 0, 0, 41, 109, 0, 0, 95, 98, 48, 126, 100, 42, 51, 62, 11, 0, 79, 56, 0, 70, 0, 4, 74, 47, 0,
+    59, 0, 55, 0, 104, 21, 73, 99, 124, 103, 84, 0, 0, 52, 69, 122, 28, 46, 0, 33, 0, 102, 58, 0, 20, 15, 6, 12, 112,
+    63, 111, 87, 82, 81, 118,
+};
+#endif
+
+#ifndef LV_I18N_EXTERNAL_PACKS
+static const lv_i18n_hash_index_t lv_i18n_hash_da[LV_I18N_HASH_KEYS] = {
+    159, 0, 37, 103, 127, 117, 124, 0, 83, 0, 0, 18, 81, 99, 86, 2, 0, 0, 39, 10, 149, 141, 113, 145, 94, 0, 96, 0, 91,
+    133, 97, 7, 109, 41, 131, 58, 24, 128, 129, 76, 16, 107, 14, 8, 56, 71, 0, 31, 23, 26, 132, 48, 15, 0, 62, 143, 32,
+    134, 116, 154, 89, 147, 63, 0, 0, 0, 60, 0, 139, 47, 73, 87, 77, 148, 122, 156, 6, 54, 0, 0, 80, 70, 0, 0, 118, 0,
+    55, 52, 9, 126, 0, 0, 0, 51, 5, 65, 102, 0, 160, 92, 74, 35, 157, 100, 150, 27, 38, 155, 0, 42, 140, 67, 28, 146,
+    130, 61, 69, 114, 57, 142, 136, 36, 95, 115, 45, 75, 82, 144, 84, 0, 111, 53, 108, 104, 137, 153, 135, 0, 151, 30,
+    93, 29, 105, 33, 78, 20, 158, 90, 59, 0, 44, 0, 3, 112, 21, 4, 68, 72, 43, 106, 49, 40, 98, 152, 138, 0, 123, 11, 0,
+    34, 125, 110, 50, 121, 0, 64, 88, 85, 66, 1, 12, 25, 13, 22, 46, 79, 17, 101, 120, 119, 19,
+};
+#endif
+
+#ifndef LV_I18N_EXTERNAL_PACKS
+static const lv_i18n_hash_index_t lv_i18n_hash_de[LV_I18N_HASH_KEYS] = {
+    0, 28, 17, 39, 1, 22, 80, 81, 0, 0, 0, 9, 0, 91, 62, 3, 0, 0, 52, 0, 88, 110, 70, 0, 0, 0, 100, 0, 75, 0, 0, 103,
+    114, 21, 107, 30, 13, 2, 42, 0, 8, 101, 6, 0, 29, 0, 0, 47, 12, 15, 0, 26, 7, 0, 31, 43, 48, 85, 0, 0, 0, 0, 66, 38,
+    0, 0, 112, 0, 108, 25, 0, 63, 59, 87, 78, 0, 118, 0, 0, 0, 0, 0, 0, 86, 73, 0, 106, 0, 0, 0, 0, 0, 0, 98, 0, 33, 83,
+    0, 0, 37, 35, 51, 0, 113, 90, 0, 18, 0, 0, 23, 109, 67, 16, 0, 0, 55, 58, 71, 99, 84, 0, 0, 0, 72, 24, 36, 0, 0, 0,
+    0, 116, 0, 0, 40, 102, 0, 0, 89, 92, 46, 119, 94, 41, 49, 60, 10, 0, 74, 54, 0, 65, 0, 4, 69, 45, 0, 57, 0, 53, 0,
+    97, 20, 68, 93, 117, 96, 79, 0, 34, 50, 64, 115, 27, 44, 0, 32, 0, 95, 56, 0, 19, 14, 5, 11, 105, 61, 104, 82, 77,
+    76, 111,
+};
+#endif
+
+#ifndef LV_I18N_EXTERNAL_PACKS
+static const lv_i18n_hash_index_t lv_i18n_hash_el[LV_I18N_HASH_KEYS] = {
+    143, 0, 34, 89, 112, 102, 109, 0, 72, 8, 0, 16, 71, 87, 75, 2, 0, 0, 36, 0, 133, 125, 98, 129, 83, 0, 85, 0, 80,
+    116, 0, 6, 94, 38, 115, 50, 22, 113, 114, 66, 14, 92, 12, 7, 48, 63, 0, 29, 21, 24, 0, 44, 13, 0, 54, 127, 30, 117,
+    101, 138, 78, 131, 55, 0, 0, 0, 52, 0, 123, 43, 64, 76, 67, 132, 107, 140, 5, 0, 0, 0, 70, 62, 0, 0, 103, 0, 0, 0,
+    0, 111, 0, 0, 0, 47, 0, 57, 0, 0, 0, 81, 65, 33, 141, 88, 134, 25, 35, 139, 0, 39, 124, 59, 26, 130, 0, 53, 61, 99,
+    49, 126, 119, 0, 84, 100, 42, 0, 0, 128, 73, 0, 96, 0, 93, 90, 120, 137, 118, 0, 135, 28, 82, 27, 91, 31, 68, 18,
+    142, 79, 51, 0, 41, 121, 3, 97, 19, 4, 60, 0, 40, 0, 45, 37, 86, 136, 122, 0, 108, 9, 0, 32, 110, 95, 46, 106, 0,
+    56, 77, 74, 58, 1, 10, 23, 11, 20, 0, 69, 15, 0, 105, 104, 17,
+};
+#endif
+
+#ifndef LV_I18N_EXTERNAL_PACKS
+static const lv_i18n_hash_index_t lv_i18n_hash_es[LV_I18N_HASH_KEYS] = {
+    0, 0, 14, 34, 32, 0, 78, 79, 59, 0, 0, 7, 58, 90, 61, 1, 40, 0, 48, 3, 0, 110, 70, 131, 127, 99, 0, 0, 73, 84, 0,
+    102, 114, 18, 107, 0, 10, 33, 0, 95, 6, 100, 0, 120, 24, 123, 67, 43, 0, 12, 83, 22, 5, 0, 25, 38, 44, 85, 0, 0, 63,
+    133, 0, 0, 134, 0, 112, 0, 108, 21, 125, 62, 55, 87, 76, 0, 118, 105, 0, 0, 126, 122, 0, 86, 71, 0, 106, 66, 0, 37,
+    0, 0, 0, 98, 0, 27, 81, 0, 0, 31, 29, 47, 0, 113, 89, 121, 15, 0, 0, 19, 109, 0, 13, 132, 0, 51, 54, 0, 68, 82, 0,
+    0, 128, 0, 20, 30, 0, 130, 60, 0, 116, 0, 129, 35, 101, 93, 0, 88, 91, 42, 119, 94, 36, 45, 56, 8, 0, 72, 50, 0, 65,
+    0, 2, 0, 41, 0, 53, 124, 49, 0, 97, 17, 69, 92, 117, 0, 77, 0, 28, 46, 64, 115, 23, 39, 0, 26, 0, 96, 52, 0, 16, 11,
+    4, 9, 104, 57, 103, 80, 75, 74, 111,
+};
+#endif
+
+#ifndef LV_I18N_EXTERNAL_PACKS
+static const lv_i18n_hash_index_t lv_i18n_hash_fi[LV_I18N_HASH_KEYS] = {
+    0, 0, 24, 67, 79, 29, 77, 83, 56, 0, 0, 8, 55, 96, 58, 1, 9, 0, 26, 0, 92, 0, 64, 0, 0, 0, 106, 0, 72, 87, 0, 0, 0,
+    28, 0, 39, 14, 80, 0, 102, 7, 107, 5, 0, 37, 0, 0, 19, 13, 16, 0, 35, 6, 93, 42, 82, 20, 88, 0, 0, 60, 0, 43, 0, 0,
+    0, 0, 0, 0, 34, 0, 59, 53, 91, 75, 0, 0, 0, 0, 0, 0, 0, 0, 89, 70, 0, 0, 0, 0, 81, 90, 0, 0, 105, 0, 45, 85, 0, 0,
+    61, 51, 23, 0, 0, 95, 0, 25, 0, 0, 30, 0, 47, 17, 0, 0, 41, 49, 65, 38, 86, 0, 0, 0, 66, 33, 52, 0, 0, 57, 0, 0, 0,
+    0, 68, 108, 99, 0, 94, 97, 18, 0, 101, 69, 21, 0, 10, 0, 71, 40, 0, 32, 0, 2, 63, 11, 3, 48, 0, 31, 0, 104, 27, 62,
+    98, 0, 0, 76, 0, 50, 22, 78, 0, 36, 74, 0, 44, 0, 103, 46, 0, 100, 15, 4, 12, 0, 54, 0, 84, 73, 0, 0,
+};
+#endif
+
+#ifndef LV_I18N_EXTERNAL_PACKS
+static const lv_i18n_hash_index_t lv_i18n_hash_fr[LV_I18N_HASH_KEYS] = {
+    0, 0, 23, 65, 78, 28, 76, 83, 55, 0, 0, 9, 53, 93, 57, 1, 10, 0, 25, 4, 0, 120, 63, 132, 129, 0, 0, 0, 70, 87, 0,
+    104, 112, 27, 116, 0, 13, 79, 81, 98, 8, 102, 6, 122, 36, 125, 0, 18, 0, 15, 0, 34, 7, 0, 40, 82, 19, 88, 0, 0, 59,
+    134, 0, 0, 135, 0, 110, 0, 118, 33, 127, 58, 50, 90, 74, 0, 121, 108, 0, 0, 0, 124, 0, 89, 68, 0, 109, 0, 0, 80, 0,
+    0, 0, 101, 0, 42, 85, 0, 0, 60, 48, 22, 0, 111, 92, 123, 24, 0, 0, 29, 119, 44, 16, 133, 115, 39, 46, 64, 37, 86, 0,
+    0, 0, 0, 32, 49, 54, 131, 56, 0, 114, 0, 130, 66, 103, 0, 0, 91, 94, 17, 128, 97, 67, 20, 51, 0, 0, 69, 38, 0, 31,
+    0, 2, 62, 11, 3, 45, 126, 30, 0, 100, 26, 61, 95, 117, 0, 75, 0, 47, 21, 77, 113, 35, 73, 0, 41, 0, 99, 43, 0, 96,
+    14, 5, 12, 107, 52, 105, 84, 72, 71, 106,
+};
+#endif
+
+#ifndef LV_I18N_EXTERNAL_PACKS
+static const lv_i18n_hash_index_t lv_i18n_hash_it[LV_I18N_HASH_KEYS] = {
+    0, 0, 27, 69, 81, 32, 79, 86, 58, 0, 0, 10, 57, 98, 60, 1, 11, 0, 29, 5, 95, 128, 66, 0, 0, 0, 109, 0, 73, 91, 0,
+    112, 120, 31, 124, 0, 16, 82, 84, 105, 9, 110, 7, 0, 41, 0, 40, 21, 15, 18, 90, 38, 8, 0, 0, 85, 22, 92, 0, 0, 0, 0,
+    45, 63, 0, 0, 118, 0, 126, 37, 0, 61, 55, 94, 77, 0, 129, 116, 0, 0, 0, 0, 0, 93, 0, 0, 117, 0, 4, 83, 0, 0, 0, 108,
+    0, 47, 88, 0, 102, 62, 53, 25, 0, 119, 97, 0, 28, 0, 0, 33, 127, 49, 19, 0, 123, 44, 51, 67, 42, 89, 0, 26, 0, 68,
+    36, 54, 0, 0, 59, 0, 122, 0, 0, 70, 111, 101, 0, 96, 99, 20, 0, 104, 71, 23, 0, 12, 0, 72, 43, 0, 35, 0, 2, 65, 13,
+    3, 50, 0, 34, 0, 107, 30, 64, 100, 125, 0, 78, 0, 52, 24, 80, 121, 39, 76, 0, 46, 0, 106, 48, 0, 103, 17, 6, 14,
+    115, 56, 113, 87, 75, 74, 114,
+};
+#endif
+
+#ifndef LV_I18N_EXTERNAL_PACKS
+static const lv_i18n_hash_index_t lv_i18n_hash_nl[LV_I18N_HASH_KEYS] = {
+    0, 0, 27, 76, 89, 32, 87, 94, 62, 0, 4, 10, 60, 106, 64, 1, 11, 0, 29, 5, 103, 133, 73, 148, 143, 117, 145, 110, 81,
+    99, 70, 120, 126, 31, 129, 44, 16, 90, 92, 113, 9, 118, 7, 136, 42, 139, 41, 21, 15, 18, 98, 38, 8, 0, 47, 93, 22,
+    100, 0, 0, 67, 150, 48, 0, 151, 0, 124, 0, 131, 37, 141, 65, 57, 102, 85, 0, 134, 0, 0, 0, 142, 138, 0, 101, 79, 0,
+    0, 40, 0, 91, 0, 0, 0, 116, 0, 50, 96, 0, 0, 68, 55, 25, 0, 125, 105, 137, 28, 0, 0, 33, 132, 52, 19, 149, 0, 46,
+    54, 74, 43, 97, 0, 26, 144, 75, 36, 56, 61, 147, 63, 0, 128, 0, 146, 77, 119, 109, 0, 104, 107, 20, 135, 112, 78,
+    23, 58, 12, 0, 80, 45, 69, 35, 0, 2, 72, 13, 3, 53, 140, 34, 0, 115, 30, 71, 108, 130, 0, 86, 0, 0, 24, 88, 127, 39,
+    84, 0, 49, 66, 114, 51, 0, 111, 17, 6, 14, 123, 59, 121, 95, 83, 82, 122,
+};
+#endif
+
+#ifndef LV_I18N_EXTERNAL_PACKS
+static const lv_i18n_hash_index_t lv_i18n_hash_no[LV_I18N_HASH_KEYS] = {
+    0, 0, 27, 77, 90, 32, 88, 95, 63, 0, 4, 10, 61, 107, 65, 1, 11, 0, 29, 5, 104, 138, 74, 152, 149, 0, 118, 111, 82,
+    100, 71, 122, 130, 31, 134, 44, 16, 91, 93, 113, 9, 119, 7, 141, 42, 146, 41, 21, 15, 18, 99, 38, 8, 0, 47, 94, 22,
+    101, 0, 155, 68, 154, 48, 70, 0, 143, 128, 0, 136, 37, 148, 66, 58, 103, 86, 0, 139, 126, 0, 0, 0, 145, 0, 102, 80,
+    0, 127, 40, 0, 92, 0, 0, 0, 117, 121, 50, 97, 0, 0, 69, 56, 25, 0, 129, 106, 144, 28, 0, 0, 33, 137, 52, 19, 153,
+    133, 46, 54, 75, 43, 98, 0, 26, 0, 76, 36, 57, 62, 151, 64, 0, 132, 0, 150, 78, 120, 110, 0, 105, 108, 20, 140, 112,
+    79, 23, 59, 12, 0, 81, 45, 0, 35, 0, 2, 73, 13, 3, 53, 147, 34, 0, 116, 30, 72, 109, 135, 0, 87, 142, 55, 24, 89,
+    131, 39, 85, 0, 49, 67, 114, 51, 0, 115, 17, 6, 14, 125, 60, 123, 96, 84, 83, 124,
+};
+#endif
+
+#ifndef LV_I18N_EXTERNAL_PACKS
+static const lv_i18n_hash_index_t lv_i18n_hash_pl[LV_I18N_HASH_KEYS] = {
+    0, 25, 14, 36, 34, 19, 76, 77, 59, 0, 0, 7, 0, 90, 61, 1, 41, 0, 49, 0, 86, 0, 71, 0, 0, 0, 33, 0, 73, 81, 0, 0, 0,
+    18, 0, 0, 0, 35, 0, 96, 6, 100, 4, 0, 26, 0, 0, 44, 10, 94, 0, 23, 5, 87, 27, 39, 45, 82, 0, 0, 0, 0, 67, 0, 0, 0,
+    0, 0, 0, 22, 0, 62, 57, 85, 0, 0, 0, 0, 0, 0, 0, 0, 0, 83, 0, 0, 0, 0, 0, 0, 84, 0, 0, 99, 0, 29, 79, 12, 0, 32, 31,
+    48, 0, 0, 89, 0, 15, 0, 0, 20, 0, 68, 13, 0, 0, 53, 56, 0, 66, 80, 0, 0, 0, 0, 21, 0, 0, 0, 60, 51, 0, 0, 0, 37,
+    101, 93, 0, 88, 91, 43, 0, 95, 38, 46, 0, 8, 0, 72, 52, 0, 65, 0, 2, 70, 42, 64, 55, 0, 50, 0, 98, 17, 69, 92, 0, 0,
+    0, 0, 30, 47, 63, 0, 24, 40, 0, 28, 0, 97, 54, 0, 16, 11, 3, 9, 0, 58, 0, 78, 75, 74, 0,
+};
+#endif
+
+#ifndef LV_I18N_EXTERNAL_PACKS
+static const lv_i18n_hash_index_t lv_i18n_hash_pt[LV_I18N_HASH_KEYS] = {
+    0, 0, 26, 76, 89, 31, 87, 94, 62, 0, 0, 9, 60, 107, 64, 1, 10, 0, 28, 4, 104, 0, 73, 0, 0, 0, 117, 0, 81, 99, 70, 0,
+    0, 30, 0, 43, 15, 90, 92, 113, 8, 118, 6, 0, 41, 0, 40, 20, 14, 17, 98, 37, 7, 0, 46, 93, 21, 100, 0, 0, 67, 0, 47,
+    69, 0, 0, 0, 0, 0, 36, 0, 65, 57, 103, 85, 0, 0, 0, 0, 0, 0, 0, 0, 101, 79, 0, 0, 39, 0, 91, 102, 0, 0, 116, 0, 49,
+    96, 0, 0, 68, 55, 24, 0, 0, 106, 0, 27, 0, 0, 32, 0, 51, 18, 0, 0, 45, 53, 74, 42, 97, 0, 25, 0, 75, 35, 56, 61, 0,
+    63, 0, 0, 0, 0, 77, 119, 110, 0, 105, 108, 19, 0, 112, 78, 22, 58, 11, 0, 80, 44, 0, 34, 0, 2, 72, 12, 3, 52, 0, 33,
+    0, 115, 29, 71, 109, 0, 0, 86, 0, 54, 23, 88, 0, 38, 84, 0, 48, 66, 114, 50, 0, 111, 16, 5, 13, 0, 59, 0, 95, 83,
+    82, 0,
+};
+#endif
+
+#ifndef LV_I18N_EXTERNAL_PACKS
+static const lv_i18n_hash_index_t lv_i18n_hash_ro[LV_I18N_HASH_KEYS] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+#endif
+
+#ifndef LV_I18N_EXTERNAL_PACKS
+static const lv_i18n_hash_index_t lv_i18n_hash_ru[LV_I18N_HASH_KEYS] = {
+    0, 0, 14, 33, 31, 0, 77, 78, 58, 0, 0, 7, 57, 90, 60, 1, 39, 0, 47, 3, 0, 117, 69, 0, 0, 0, 99, 0, 72, 82, 0, 102,
+    109, 18, 113, 0, 10, 32, 0, 95, 6, 100, 0, 0, 24, 0, 66, 42, 0, 12, 0, 22, 5, 87, 25, 37, 43, 83, 0, 0, 62, 0, 0, 0,
+    0, 0, 107, 0, 115, 21, 0, 61, 54, 86, 75, 0, 0, 106, 0, 0, 0, 0, 30, 84, 70, 0, 0, 65, 0, 36, 85, 0, 0, 98, 0, 27,
+    80, 0, 0, 0, 29, 46, 0, 108, 89, 0, 15, 0, 0, 19, 116, 0, 13, 0, 112, 50, 53, 0, 67, 81, 0, 0, 0, 0, 20, 0, 0, 0,
+    59, 0, 111, 0, 0, 34, 101, 93, 0, 88, 91, 41, 0, 94, 35, 44, 55, 8, 0, 71, 49, 0, 64, 0, 2, 0, 40, 0, 52, 0, 48, 0,
+    97, 17, 68, 92, 114, 0, 76, 0, 28, 45, 63, 110, 23, 38, 0, 26, 0, 96, 51, 0, 16, 11, 4, 9, 105, 56, 103, 79, 74, 73,
+    104,
+};
+#endif
+
+#ifndef LV_I18N_EXTERNAL_PACKS
+static const lv_i18n_hash_index_t lv_i18n_hash_se[LV_I18N_HASH_KEYS] = {
+    0, 0, 32, 91, 113, 103, 110, 136, 74, 0, 0, 14, 73, 87, 77, 1, 141, 0, 34, 0, 131, 123, 100, 127, 84, 0, 85, 0, 81,
+    117, 0, 5, 96, 36, 116, 0, 20, 114, 115, 68, 12, 94, 10, 6, 49, 63, 142, 27, 19, 22, 0, 43, 11, 0, 54, 125, 28, 118,
+    102, 0, 79, 129, 55, 139, 0, 0, 52, 0, 121, 42, 65, 78, 69, 130, 108, 0, 4, 0, 0, 0, 72, 62, 0, 137, 104, 0, 48, 47,
+    0, 112, 0, 0, 0, 46, 0, 57, 90, 0, 0, 82, 66, 31, 0, 88, 132, 23, 33, 0, 0, 37, 122, 59, 24, 128, 0, 53, 61, 101,
+    50, 124, 0, 0, 0, 0, 40, 67, 0, 126, 75, 0, 98, 0, 95, 92, 119, 135, 0, 138, 133, 26, 83, 25, 93, 29, 70, 16, 0, 80,
+    51, 0, 39, 0, 2, 99, 17, 3, 60, 64, 38, 0, 44, 35, 86, 134, 120, 0, 109, 7, 140, 30, 111, 97, 45, 107, 0, 56, 0, 76,
+    58, 0, 8, 21, 9, 18, 41, 71, 13, 89, 106, 105, 15,
+};
+#endif
+
+#ifndef LV_I18N_EXTERNAL_PACKS
+static const lv_i18n_hash_index_t lv_i18n_hash_sl[LV_I18N_HASH_KEYS] = {
+    0, 0, 26, 77, 1, 31, 88, 93, 62, 0, 0, 10, 60, 105, 64, 3, 11, 0, 28, 5, 102, 126, 74, 0, 0, 0, 116, 0, 82, 97, 71,
+    119, 130, 30, 123, 43, 16, 2, 91, 112, 9, 117, 7, 0, 41, 0, 0, 21, 15, 18, 0, 37, 8, 0, 46, 92, 22, 98, 0, 0, 66, 0,
+    47, 70, 0, 0, 128, 0, 124, 36, 54, 65, 57, 0, 86, 0, 134, 0, 39, 101, 0, 0, 0, 99, 80, 0, 122, 0, 68, 90, 100, 0, 0,
+    115, 0, 49, 95, 0, 109, 0, 55, 25, 0, 129, 104, 0, 27, 0, 0, 32, 125, 51, 19, 0, 0, 45, 53, 75, 42, 96, 0, 0, 0, 76,
+    35, 56, 61, 0, 63, 0, 132, 0, 0, 78, 118, 108, 0, 103, 106, 20, 0, 111, 79, 23, 58, 12, 0, 81, 44, 0, 34, 0, 4, 73,
+    13, 67, 52, 0, 33, 40, 114, 29, 72, 107, 133, 0, 87, 0, 0, 24, 89, 131, 38, 85, 69, 48, 0, 113, 50, 0, 110, 17, 6,
+    14, 121, 59, 120, 94, 84, 83, 127,
+};
+#endif
+
+#ifndef LV_I18N_EXTERNAL_PACKS
+static const lv_i18n_hash_index_t lv_i18n_hash_sr[LV_I18N_HASH_KEYS] = {
+    0, 0, 26, 73, 85, 31, 83, 90, 60, 0, 0, 10, 58, 103, 62, 1, 11, 0, 28, 5, 99, 124, 70, 0, 0, 0, 114, 0, 78, 94, 67,
+    117, 0, 30, 121, 41, 16, 86, 88, 110, 9, 115, 7, 0, 39, 0, 0, 21, 15, 18, 0, 37, 8, 100, 44, 89, 22, 95, 0, 0, 64,
+    0, 45, 66, 0, 0, 0, 0, 122, 36, 0, 63, 55, 0, 81, 0, 0, 0, 0, 98, 0, 0, 65, 96, 76, 0, 120, 0, 4, 87, 97, 0, 0, 113,
+    0, 47, 92, 0, 107, 0, 53, 25, 0, 0, 102, 0, 27, 0, 0, 32, 123, 49, 19, 0, 0, 43, 51, 71, 40, 93, 0, 0, 0, 72, 35,
+    54, 59, 0, 61, 0, 0, 0, 0, 74, 116, 106, 0, 101, 104, 20, 0, 109, 75, 23, 56, 12, 0, 77, 42, 0, 34, 0, 2, 69, 13, 3,
+    50, 0, 33, 0, 112, 29, 68, 105, 0, 0, 82, 0, 52, 24, 84, 0, 38, 80, 0, 46, 0, 111, 48, 0, 108, 17, 6, 14, 119, 57,
+    118, 91, 79, 0, 0,
+};
+#endif
+
+#ifndef LV_I18N_EXTERNAL_PACKS
+static const lv_i18n_hash_index_t lv_i18n_hash_tr[LV_I18N_HASH_KEYS] = {
+    0, 0, 24, 69, 81, 29, 79, 86, 56, 0, 0, 9, 0, 97, 58, 1, 10, 0, 26, 4, 94, 125, 66, 0, 0, 0, 107, 0, 74, 0, 63, 110,
+    118, 28, 121, 39, 15, 82, 84, 103, 8, 108, 6, 0, 37, 0, 0, 20, 14, 17, 0, 35, 7, 0, 42, 85, 0, 90, 0, 0, 60, 0, 43,
+    62, 0, 0, 116, 0, 123, 34, 0, 59, 53, 93, 77, 0, 126, 114, 0, 0, 0, 0, 0, 91, 72, 0, 115, 0, 0, 83, 92, 0, 0, 106,
+    0, 45, 88, 0, 0, 61, 51, 23, 0, 117, 96, 0, 25, 0, 0, 30, 124, 47, 18, 0, 0, 41, 49, 67, 38, 89, 0, 0, 0, 68, 33,
+    52, 0, 0, 57, 0, 120, 0, 0, 70, 109, 100, 0, 95, 98, 19, 127, 102, 71, 21, 54, 11, 0, 73, 40, 0, 32, 0, 2, 65, 12,
+    3, 48, 0, 31, 0, 105, 27, 64, 99, 122, 0, 78, 0, 50, 22, 80, 119, 36, 76, 0, 44, 0, 104, 46, 0, 101, 16, 5, 13, 113,
+    55, 111, 87, 75, 0, 112,
+};
+#endif
+
+#ifndef LV_I18N_EXTERNAL_PACKS
+static const lv_i18n_hash_index_t lv_i18n_hash_uk[LV_I18N_HASH_KEYS] = {
+    0, 0, 32, 91, 114, 104, 111, 0, 73, 0, 0, 14, 72, 87, 76, 1, 0, 0, 34, 0, 132, 124, 100, 128, 83, 0, 85, 0, 80, 118,
+    0, 5, 96, 36, 117, 49, 20, 115, 116, 67, 12, 94, 10, 6, 47, 62, 0, 27, 19, 22, 0, 43, 11, 0, 53, 126, 28, 119, 103,
+    0, 78, 130, 54, 0, 137, 0, 51, 0, 122, 42, 64, 77, 68, 131, 109, 0, 4, 0, 0, 0, 71, 61, 0, 0, 105, 0, 0, 0, 0, 113,
+    0, 0, 0, 46, 0, 56, 90, 0, 0, 81, 65, 31, 0, 88, 133, 23, 33, 0, 0, 37, 123, 58, 24, 129, 0, 52, 60, 101, 48, 125,
+    0, 0, 84, 102, 40, 66, 0, 127, 74, 0, 98, 0, 95, 92, 120, 136, 0, 0, 134, 26, 82, 25, 93, 29, 69, 16, 0, 79, 50, 0,
+    39, 0, 2, 99, 17, 3, 59, 63, 38, 0, 44, 35, 86, 135, 121, 0, 110, 7, 0, 30, 112, 97, 45, 108, 0, 55, 0, 75, 57, 0,
+    8, 21, 9, 18, 41, 70, 13, 89, 107, 106, 15,
+};
+#endif
+
+#ifndef LV_I18N_EXTERNAL_PACKS
+static const lv_i18n_hash_index_t lv_i18n_hash_zh_cn[LV_I18N_HASH_KEYS] = {
+    0, 27, 16, 0, 0, 21, 84, 85, 41, 0, 0, 8, 39, 99, 43, 1, 0, 0, 54, 3, 95, 123, 74, 0, 0, 0, 110, 0, 79, 90, 71, 114,
+    127, 20, 120, 29, 12, 0, 0, 105, 7, 111, 5, 0, 28, 0, 67, 49, 11, 14, 89, 25, 6, 96, 30, 0, 50, 91, 0, 0, 46, 0, 69,
+    0, 0, 0, 125, 0, 121, 24, 0, 44, 36, 94, 82, 0, 131, 117, 0, 0, 0, 0, 0, 92, 77, 0, 118, 66, 63, 0, 93, 0, 0, 109,
+    113, 32, 87, 0, 103, 0, 34, 53, 0, 126, 98, 0, 17, 0, 0, 22, 122, 70, 15, 0, 119, 57, 60, 75, 68, 88, 0, 64, 0, 76,
+    23, 35, 40, 0, 42, 0, 129, 0, 0, 0, 112, 102, 0, 97, 100, 48, 0, 104, 0, 51, 37, 9, 0, 78, 56, 0, 65, 0, 2, 73, 47,
+    62, 59, 0, 55, 0, 108, 19, 72, 101, 130, 107, 83, 0, 33, 52, 61, 128, 26, 0, 0, 31, 45, 106, 58, 0, 18, 13, 4, 10,
+    116, 38, 115, 86, 81, 80, 124,
+};
+#endif
+
+static const lv_i18n_hash_lang_t lv_i18n_hash_langs[] = {
+    {"en", 1, lv_i18n_hash_en},
+#ifndef LV_I18N_EXTERNAL_PACKS
+    {"bg", 116, lv_i18n_hash_bg},
+    {"cs", 126, lv_i18n_hash_cs},
+    {"da", 160, lv_i18n_hash_da},
+    {"de", 119, lv_i18n_hash_de},
+    {"el", 143, lv_i18n_hash_el},
+    {"es", 134, lv_i18n_hash_es},
+    {"fi", 108, lv_i18n_hash_fi},
+    {"fr", 135, lv_i18n_hash_fr},
+    {"it", 129, lv_i18n_hash_it},
+    {"nl", 151, lv_i18n_hash_nl},
+    {"no", 155, lv_i18n_hash_no},
+    {"pl", 101, lv_i18n_hash_pl},
+    {"pt", 119, lv_i18n_hash_pt},
+    {"ro", 0, lv_i18n_hash_ro},
+    {"ru", 117, lv_i18n_hash_ru},
+    {"se", 142, lv_i18n_hash_se},
+    {"sl", 134, lv_i18n_hash_sl},
+    {"sr", 124, lv_i18n_hash_sr},
+    {"tr", 127, lv_i18n_hash_tr},
+    {"uk", 137, lv_i18n_hash_uk},
+    {"zh-CN", 131, lv_i18n_hash_zh_cn},
+#endif
+    {NULL, 0, NULL} // End mark
+};
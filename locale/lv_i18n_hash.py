@@ -0,0 +1,274 @@
+#!/usr/bin/env python3
+"""
+Generates lv_i18n_hash.h: a minimal perfect hash over all message IDs of the locale/*.yml
+files plus one dense index array per language into the phrase tables of lv_i18n.c, which
+`lv_i18n compile` generates from the same files (in the same order).
+
+With --packs it writes one binary language pack <locale>.lvi per language except English,
+loaded at runtime by lv_i18n_set_locale_pack() (see LV_I18N_EXTERNAL_PACKS).
+
+Usage: lv_i18n_hash.py [-o lv_i18n_hash.h] [--packs DIR] locale/*.yml
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+try:
+    import yaml
+except ImportError:
+    print("lv_i18n_hash.py: PyYAML not installed (pip install pyyaml)", file=sys.stderr)
+    sys.exit(1)
+
+MASK = 0xFFFFFFFF
+PACK_MAGIC = b"LVI\x01"
+PLURAL_TYPES = ["zero", "one", "two", "few", "many", "other"]  # lv_i18n_plural_type_t
+
+
+class Loader(yaml.SafeLoader):
+    """YAML 1.2 booleans like lv_i18n: 'no', 'on', 'off' ... are strings (e.g. the 'no' locale)"""
+
+
+Loader.yaml_implicit_resolvers = {
+    k: [(tag, regexp) for tag, regexp in v if tag != "tag:yaml.org,2002:bool"]
+    for k, v in yaml.SafeLoader.yaml_implicit_resolvers.items()
+}
+Loader.add_implicit_resolver(
+    "tag:yaml.org,2002:bool", re.compile(r"^(?:true|True|TRUE|false|False|FALSE)$"), list("tTfF")
+)
+
+
+def fnv1a(data):
+    h = 2166136261
+    for b in data:
+        h = ((h ^ b) * 16777619) & MASK
+    return h
+
+
+def mix(x):
+    # same as RequestId::mix(), a bijective 32-bit hash
+    x ^= x >> 16
+    x = (x * 0x7FEB352D) & MASK
+    x ^= x >> 15
+    x = (x * 0x846CA68B) & MASK
+    x ^= x >> 16
+    return x
+
+
+def perfect_hash(keys):
+    """hash and displace: returns (displacements, slot of each key)"""
+    n = len(keys)
+    hashes = [fnv1a(k.encode("utf-8")) for k in keys]
+    if len(set(hashes)) != n:
+        raise SystemExit("lv_i18n_hash.py: 32-bit hash collision between message IDs")
+    buckets = max(1, (n + 3) // 4)
+    while True:
+        members = [[] for _ in range(buckets)]
+        for i, h in enumerate(hashes):
+            members[h % buckets].append(i)
+        displace = [0] * buckets
+        slot = [None] * n
+        used = [False] * n
+        ok = True
+        for b in sorted(range(buckets), key=lambda b: -len(members[b])):
+            if not members[b]:
+                continue
+            for d in range(1, 0x10000):
+                slots = [mix(hashes[i] ^ d) % n for i in members[b]]
+                if len(set(slots)) == len(slots) and not any(used[s] for s in slots):
+                    break
+            else:
+                ok = False
+                break
+            displace[b] = d
+            for i, s in zip(members[b], slots):
+                slot[i] = s
+                used[s] = True
+        if ok:
+            return displace, slot
+        buckets *= 2
+
+
+def c_name(locale):
+    return locale.lower().replace("-", "_")
+
+
+def c_string(s):
+    escapes = {"\\": "\\\\", '"': '\\"', "\n": "\\n", "\t": "\\t", "\r": "\\r"}
+    return '"' + "".join(escapes.get(c, c) for c in s) + '"'
+
+
+def write_if_changed(path, data):
+    if os.path.exists(path):
+        with open(path, "rb") as f:
+            if f.read() == data:
+                return
+    with open(path, "wb") as f:
+        f.write(data)
+
+
+def pack(locale, phrases, index, checksum, index_size):
+    """
+    Binary language pack, little endian:
+      header (32 bytes): magic "LVI\\x01", uint32 checksum of the message IDs, uint16 number of keys,
+        uint8 index size, uint8 0, char locale[8], uint16 singulars, uint8 plurals[6], uint32 pool size
+      index: the dense hash index of lv_i18n_hash.h for this language, padded to 4 bytes
+      phrases: uint32 msg_id and translation offset into the pool, singulars then plurals by type
+      pool: 0-terminated UTF-8 strings
+    """
+    singulars = []
+    plurals = [[] for _ in PLURAL_TYPES]
+    for msg_id, text in phrases.items():
+        if isinstance(text, dict):
+            for form, translation in text.items():
+                if translation is not None:
+                    plurals[PLURAL_TYPES.index(form)].append((str(msg_id), str(translation)))
+        elif text is not None:
+            singulars.append((str(msg_id), str(text)))
+
+    pool = bytearray()
+    offsets = {}
+
+    def string(s):
+        if s not in offsets:
+            offsets[s] = len(pool)
+            pool.extend(s.encode("utf-8") + b"\0")
+        return offsets[s]
+
+    records = bytearray()
+    for msg_id, translation in singulars + [p for forms in plurals for p in forms]:
+        records += struct.pack("<II", string(msg_id), string(translation))
+
+    name = locale.encode("ascii")
+    if len(name) >= 8:
+        raise SystemExit("lv_i18n_hash.py: locale name %s too long for a language pack" % locale)
+    data = bytearray(PACK_MAGIC)
+    data += struct.pack("<IHBB8sH6BI", checksum, len(index), index_size, 0, name, len(singulars),
+                        *[len(forms) for forms in plurals], len(pool))
+    data += struct.pack("<%d%s" % (len(index), "B" if index_size == 1 else "H"), *index)
+    data += bytes(-len(data) % 4)
+    return bytes(data + records + pool)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("-o", "--output")
+    parser.add_argument("--packs", metavar="DIR", help="write the language packs into DIR")
+    parser.add_argument("files", nargs="+")
+    args = parser.parse_args()
+    if not args.output and not args.packs:
+        parser.error("nothing to generate, use -o and/or --packs")
+
+    # languages in the order of lv_i18n_language_pack: English first, then by file name
+    langs = []
+    for path in sorted(args.files, key=lambda p: (os.path.basename(p) != "en.yml", os.path.basename(p))):
+        with open(path, encoding="utf-8") as f:
+            data = yaml.load(f, Loader=Loader)
+        for locale, phrases in data.items():
+            langs.append((str(locale), phrases or {}))
+
+    # singular message IDs of all languages, in order of first appearance
+    keys = []
+    seen = set()
+    for _, phrases in langs:
+        for msg_id, text in phrases.items():
+            if not isinstance(text, dict) and str(msg_id) not in seen:
+                seen.add(str(msg_id))
+                keys.append(str(msg_id))
+    displace, slot = perfect_hash(keys)
+    checksum = fnv1a("\0".join(keys).encode("utf-8"))
+    key_slot = dict(zip(keys, slot))
+
+    indexes = []
+    longest = 0
+    for locale, phrases in langs:
+        index = [0] * len(keys)
+        pos = 0
+        for msg_id, text in phrases.items():
+            if text is None or isinstance(text, dict):
+                continue
+            pos += 1  # 1-based position in <locale>_singulars, 0 is untranslated
+            index[key_slot[str(msg_id)]] = pos
+        longest = max(longest, pos)
+        indexes.append((locale, pos, index))
+    index_type = "uint8_t" if longest < 0x100 else "uint16_t"
+
+    if args.packs:
+        os.makedirs(args.packs, exist_ok=True)
+        for (locale, phrases), (_, _, index) in zip(langs, indexes):
+            if locale != "en":
+                data = pack(locale, phrases, index, checksum, 1 if longest < 0x100 else 2)
+                write_if_changed(os.path.join(args.packs, locale + ".lvi"), data)
+    if not args.output:
+        return
+
+    out = []
+    out.append("// generated by lv_i18n_hash.py from locale/*.yml, do not edit")
+    out.append("// minimal perfect hash over the message IDs (see __lv_i18n_hash_slot() in lv_i18n.c) and per")
+    out.append("// language the 1-based position of each message in <locale>_singulars, 0 if not translated")
+    out.append("#pragma once")
+    out.append("")
+    out.append("#include <stddef.h>")
+    out.append("#include <stdint.h>")
+    out.append("")
+    out.append("#define LV_I18N_HASH_KEYS %d" % len(keys))
+    out.append("#define LV_I18N_HASH_BUCKETS %d" % len(displace))
+    out.append("#define LV_I18N_HASH_CHECKSUM 0x%08xu // of the message IDs, identifies compatible language packs" % checksum)
+    out.append("")
+    out.append("typedef %s lv_i18n_hash_index_t;" % index_type)
+    out.append("")
+    out.append("typedef struct {")
+    out.append("    const char *locale_name;")
+    out.append("    uint16_t singulars; // size of <locale>_singulars, to detect tables out of sync")
+    out.append("    const lv_i18n_hash_index_t *index;")
+    out.append("} lv_i18n_hash_lang_t;")
+    out.append("")
+
+    def array(decl, values):
+        out.append(decl + " = {")
+        line = "   "
+        for v in values:
+            item = " %d," % v
+            if len(line) + len(item) > 120:
+                out.append(line)
+                line = "   "
+            line += item
+        out.append(line)
+        out.append("};")
+        out.append("")
+
+    array("static const uint16_t lv_i18n_hash_displace[LV_I18N_HASH_BUCKETS]", displace)
+    # the message ID in each slot, for lv_i18n_get_msg_id()
+    out.append("static const char *const lv_i18n_hash_keys[LV_I18N_HASH_KEYS] = {")
+    for msg_id in sorted(keys, key=lambda k: key_slot[k]):
+        out.append("    %s," % c_string(msg_id))
+    out.append("};")
+    out.append("")
+    # with LV_I18N_EXTERNAL_PACKS only English is compiled in, the other indexes are part of the packs
+    for locale, _, index in indexes:
+        if locale != "en":
+            out.append("#ifndef LV_I18N_EXTERNAL_PACKS")
+        array("static const lv_i18n_hash_index_t lv_i18n_hash_%s[LV_I18N_HASH_KEYS]" % c_name(locale), index)
+        if locale != "en":
+            out[-1] = "#endif"
+            out.append("")
+    out.append("static const lv_i18n_hash_lang_t lv_i18n_hash_langs[] = {")
+    for locale, size, _ in indexes:
+        if locale == "en":
+            out.append('    {"%s", %d, lv_i18n_hash_%s},' % (locale, size, c_name(locale)))
+    out.append("#ifndef LV_I18N_EXTERNAL_PACKS")
+    for locale, size, _ in indexes:
+        if locale != "en":
+            out.append('    {"%s", %d, lv_i18n_hash_%s},' % (locale, size, c_name(locale)))
+    out.append("#endif")
+    out.append("    {NULL, 0, NULL} // End mark")
+    out.append("};")
+    out.append("")
+
+    write_if_changed(args.output, "\n".join(out).encode("utf-8"))
+
+
+if __name__ == "__main__":
+    main()
@@ -63,6 +63,7 @@ meshtastic_FromRadio PacketClient::receive(void)
     if (hasData()) {
         auto p = queue->clientReceive();
         if (p) {
+            lastEnqueued = p->getEnqueued();
             return static_cast<DataPacket<meshtastic_FromRadio> *>(p->move().get())->getData();
         }
     }
@@ -168,6 +168,7 @@ meshtastic_FromRadio SerialClient::receive(void)
         ILOG_TRACE("SerialClient::receive() got a packet from queue");
         auto p = queue.clientReceive();
         if (p) {
+            lastEnqueued = p->getEnqueued();
             return static_cast<DataPacket<meshtastic_FromRadio> *>(p->move().get())->getData();
         } else {
             ILOG_ERROR("SerialClient::receive() no packet in queue");
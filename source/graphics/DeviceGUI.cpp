@@ -1,9 +1,9 @@
 #include "graphics/DeviceGUI.h"
+#include "graphics/common/FrameStats.h"
 #include "graphics/driver/DisplayDriver.h"
 #include "graphics/driver/DisplayDriverConfig.h"
 #include "input/I2CKeyboardScanner.h"
 #include "input/InputDriver.h"
-#include <thread>
 
 #include "input/I2CKeyboardInputDriver.h"
 static I2CKeyboardInputDriver *keyboardDriver = nullptr;
@@ -32,6 +32,31 @@ static ButtonInputDriver *buttonDriver = nullptr;
 #include "ui.h"
 #include "util/ILog.h"
 
+#if defined(ARCH_PORTDUINO)
+#include "util/Wakeup.h"
+
+namespace
+{
+constexpr uint32_t c_maxSleep = 100; // ms, the views and the controller are run at least this often
+
+bool inputRead = false; // an input device woke up the last wait
+
+/**
+ * Input devices in event mode (watched by Wakeup) are only read when they became readable. While
+ * one of them is pressed it gets no events for a long press or key repeat, so it is read at the
+ * LVGL read period until it is released.
+ */
+bool inputHeld(void)
+{
+    for (lv_indev_t *indev = lv_indev_get_next(nullptr); indev; indev = lv_indev_get_next(indev)) {
+        if (lv_indev_get_mode(indev) == LV_INDEV_MODE_EVENT && lv_indev_get_state(indev) == LV_INDEV_STATE_PRESSED)
+            return true;
+    }
+    return false;
+}
+} // namespace
+#endif
+
 DeviceGUI::DeviceGUI(const DisplayDriverConfig *cfg, DisplayDriver *driver) : displaydriver(driver), inputdriver(nullptr)
 {
 
@@ -61,6 +86,11 @@ void DeviceGUI::init(IClientBase *client)
 {
     ILOG_DEBUG("Display driver init...");
     displaydriver->init(this);
+    // not getDisplay(): FBDriver keeps its display elsewhere
+    FrameStats::instance().attach(lv_display_get_default());
+#ifdef FRAME_STATS_OVERLAY
+    FrameStats::instance().showOverlay(true);
+#endif
 
     ILOG_DEBUG("Input driver init...");
     I2CKeyboardScanner scanner;
@@ -93,23 +123,25 @@ void DeviceGUI::init(IClientBase *client)
 }
 
 /**
- * Linux: measure how long it takes to call displaydriver->task_handler().
- * Then tell the lvgl library how long it took via lv_tick_inc().
+ * Linux: run the LVGL timers, then sleep until the next timer is due, a packet arrives or an
+ * input device becomes readable (see Wakeup). Watched input devices have no read timer (event
+ * mode), input that woke us is read right away. The ticks come from the monotonic clock.
+ * A driver with a virtual clock advances the ticks itself and is not slowed down.
  */
 void DeviceGUI::task_handler(void)
 {
 #if defined(ARCH_PORTDUINO)
-    int ms = 10;
-    auto start = std::chrono::high_resolution_clock::now();
     displaydriver->task_handler();
-    auto stop = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
-    if (duration.count() < ms) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(ms - duration.count()));
-        lv_tick_inc(ms);
-    } else {
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
-        lv_tick_inc(duration.count() + 1);
+    if (displaydriver->hasVirtualClock())
+        return;
+    uint32_t ms = displaydriver->getTimeUntilNext();
+    // read once more a read period after input, libinput may have queued the events only after we woke up
+    bool readAgain = inputRead || inputHeld();
+    uint32_t maxSleep = readAgain ? LV_DEF_REFR_PERIOD : c_maxSleep;
+    inputRead = Wakeup::instance().wait(ms < maxSleep ? ms : maxSleep) == Wakeup::eReadable;
+    if (inputRead || readAgain) {
+        for (lv_indev_t *indev = lv_indev_get_next(nullptr); indev; indev = lv_indev_get_next(indev))
+            lv_indev_read(indev);
     }
 #else
     displaydriver->task_handler();
@@ -1,4 +1,4 @@
-#if HAS_TFT // VIEW_128x64
+#if HAS_TFT && defined(VIEW_128x64)
 
 #include "graphics/view/OLED/OLEDView_128x64.h"
 #include "graphics/driver/DisplayDriverFactory.h"
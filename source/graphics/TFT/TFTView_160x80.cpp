@@ -1,4 +1,4 @@
-#if HAS_TFT // VIEW_160x80
+#if HAS_TFT && defined(VIEW_160x80)
 
 #include "graphics/view/TFT/TFTView_160x80.h"
 #include "graphics/common/ViewController.h"
@@ -52,12 +52,8 @@ fs::FS &fileSystem = LittleFS;
 #include "graphics/map/URLService.h"
 #include "graphics/common/SdCard.h"
 
-#ifndef MAX_NUM_NODES_VIEW
-#define MAX_NUM_NODES_VIEW 250
-#endif
-
 #ifndef PACKET_LOGS_MAX
-#define PACKET_LOGS_MAX 200
+#define PACKET_LOGS_MAX 1000 // 24 bytes each
 #endif
 
 LV_IMAGE_DECLARE(img_circle_image);
@@ -393,429 +389,6 @@ void TFTView_320x240::updateSignalStrength(int32_t rssi, float snr)
  * @param e
  */
 // end button event handlers
-nimations
-**
- * @brief Dynamically show user widget
- *        First a panel is created where the widget is located in, then the widget is drawn.
- *        "active_widget" contains the surrounding panel which must be destroyed
- *        to remove the widget from the screen (e.g. by pressing OK/Cancel).
- *
- * @param func
- */
-**
- * display message that has just been written and sent out
- */
-void TFTView_320x240::addNode(uint32_t nodeNum, uint8_t ch, const char *userShort, const char *userLong, uint32_t lastHeard,
-                              eRole role, bool hasKey, bool unmessagable)
-{
-    // lv_obj nodesPanel children  |  user data (4 bytes)
-    // ==================================================
-    // [0]: img                    | role
-    // [1]: btn                    | ll group
-    // [2]: lbl user long          | nodeNum
-    // [3]: lbl user short         | userShort (4 chars)
-    // [4]: lbl battery            | hasKey
-    // [5]: lbl lastHeard          | lastHeard / curtime
-    // [6]: lbl signal (or hops)   | hops away
-    // [7]: lbl position 1         | lat
-    // [8]: lbl position 2         | lon
-    // [9]: lbl telemetry 1        |
-    // [10]: lbl telemetry 2       | iaq
-    // panel user_data: ch
-
-    ILOG_DEBUG("addNode(%d): num=0x%08x, lastseen=%d, name=%s(%s), role=%d", nodeCount, nodeNum, lastHeard, userLong, userShort,
-               role);
-    while (nodeCount >= MAX_NUM_NODES_VIEW) {
-        purgeNode(nodeNum);
-    }
-
-    lv_obj_t *p = lv_obj_create(objects.nodes_panel);
-    lv_ll_t *lv_group_ll = &lv_group_get_default()->obj_ll;
-
-    p->user_data = (void *)(uint32_t)ch;
-    nodes[nodeNum] = p;
-    nodeCount++;
-
-    // NodePanel
-    lv_obj_set_pos(p, LV_PCT(0), 0);
-    lv_obj_set_size(p, LV_PCT(100), 53);
-    lv_obj_set_align(p, LV_ALIGN_CENTER);
-    lv_obj_set_style_pad_top(p, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_pad_bottom(p, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_remove_flag(p, lv_obj_flag_t(LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_PRESS_LOCK | LV_OBJ_FLAG_CLICK_FOCUSABLE |
-                                        LV_OBJ_FLAG_GESTURE_BUBBLE | LV_OBJ_FLAG_SNAPPABLE | LV_OBJ_FLAG_SCROLLABLE));
-    add_style_node_panel_style(p);
-
-    // NodeImage
-    lv_obj_t *img = lv_img_create(p);
-    setNodeImage(nodeNum, role, unmessagable, img);
-    lv_obj_set_pos(img, -5, 3);
-    lv_obj_set_size(img, 32, 32);
-    lv_obj_clear_flag(img, LV_OBJ_FLAG_SCROLLABLE);
-    lv_obj_set_style_radius(img, 6, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_opa(img, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_opa(img, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_width(img, 2, LV_PART_MAIN | LV_STATE_DEFAULT);
-    if (!hasKey) {
-        lv_obj_set_style_border_color(img, colorRed, LV_PART_MAIN | LV_STATE_DEFAULT);
-    }
-    if (unmessagable) {
-        // node role icon is not clickable and replaced with a cancelled icon
-        img->user_data = (void *)eRole::unmessagable;
-    } else {
-        img->user_data = (void *)role;
-    }
-
-    // NodeButton
-    lv_obj_t *nodeButton = lv_btn_create(p);
-    lv_obj_set_pos(nodeButton, 0, 0);
-    lv_obj_set_size(nodeButton, LV_PCT(106), LV_PCT(100));
-    add_style_node_button_style(nodeButton);
-    lv_obj_set_align(nodeButton, LV_ALIGN_CENTER);
-    lv_obj_add_flag(nodeButton, LV_OBJ_FLAG_SCROLL_ON_FOCUS);
-    lv_obj_set_style_shadow_width(nodeButton, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_max_height(nodeButton, 132, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_min_height(nodeButton, 50, LV_PART_MAIN | LV_STATE_DEFAULT);
-    nodeButton->user_data = _lv_ll_get_tail(lv_group_ll);
-
-    // UserNameLabel
-    lv_obj_t *ln_lbl = lv_label_create(p);
-    lv_obj_set_pos(ln_lbl, -5, 35);
-    lv_obj_set_size(ln_lbl, LV_PCT(80), LV_SIZE_CONTENT);
-    lv_label_set_long_mode(ln_lbl, LV_LABEL_LONG_SCROLL);
-    lv_label_set_text(ln_lbl, userLong);
-    ln_lbl->user_data = (void *)nodeNum;
-    lv_obj_set_style_align(ln_lbl, LV_ALIGN_TOP_LEFT, LV_PART_MAIN | LV_STATE_DEFAULT);
-
-    // UserNameShortLabel
-    lv_obj_t *sn_lbl = lv_label_create(p);
-    lv_obj_set_pos(sn_lbl, 30, 10);
-    lv_obj_set_size(sn_lbl, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
-    lv_label_set_long_mode(sn_lbl, LV_LABEL_LONG_WRAP);
-    lv_obj_set_style_align(sn_lbl, LV_ALIGN_TOP_LEFT, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_font(sn_lbl, &ui_font_montserrat_14, LV_PART_MAIN | LV_STATE_DEFAULT);
-    // if short name contains only non-printable glyphs replace with short id
-    if (lv_txt_get_width(userShort, strlen(userShort), &ui_font_montserrat_14, 0) <= 4) {
-        lv_label_set_text_fmt(sn_lbl, "%04x", nodeNum & 0xffff);
-    } else {
-        lv_label_set_text(sn_lbl, userShort);
-    }
-    char *modUserShort = lv_label_get_text(sn_lbl);
-
-    // keep a copy of the (4-byte) short name for use in many other widgets
-    char *userData = (char *)&(sn_lbl->user_data);
-    userData[0] = modUserShort[0];
-    if (userData[0] == 0x00)
-        userData[0] = ' ';
-    userData[1] = modUserShort[1];
-    if (userData[1] == 0x00)
-        userData[1] = ' ';
-    userData[2] = modUserShort[2];
-    if (userData[2] == 0x00)
-        userData[2] = ' ';
-    userData[3] = modUserShort[3];
-    if (userData[3] == 0x00)
-        userData[3] = ' ';
-
-    //  BatteryLabel
-    lv_obj_t *ui_BatteryLabel = lv_label_create(p);
-    lv_obj_set_pos(ui_BatteryLabel, 8, 17);
-    lv_obj_set_size(ui_BatteryLabel, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
-    lv_obj_set_align(ui_BatteryLabel, LV_ALIGN_TOP_RIGHT);
-    lv_label_set_text(ui_BatteryLabel, "");
-    lv_obj_set_style_text_align(ui_BatteryLabel, LV_TEXT_ALIGN_RIGHT, LV_PART_MAIN | LV_STATE_DEFAULT);
-    ui_BatteryLabel->user_data = (void *)hasKey;
-    // LastHeardLabel
-    lv_obj_t *ui_lastHeardLabel = lv_label_create(p);
-    lv_obj_set_pos(ui_lastHeardLabel, 8, 33);
-    lv_obj_set_size(ui_lastHeardLabel, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
-    lv_obj_set_style_align(ui_lastHeardLabel, LV_ALIGN_TOP_RIGHT, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_label_set_long_mode(ui_lastHeardLabel, LV_LABEL_LONG_CLIP);
-
-    // TODO: devices without actual time will report all nodes as lastseen = now
-    if (lastHeard) {
-        lastHeard = std::min(curtime, (time_t)lastHeard); // adapt values too large
-
-        char buf[20];
-        bool isOnline = lastHeardToString(lastHeard, buf);
-        lv_label_set_text(ui_lastHeardLabel, buf);
-        if (isOnline) {
-            nodesOnline++;
-        }
-    } else {
-        lv_label_set_text(ui_lastHeardLabel, "");
-    }
-
-    lv_obj_set_style_text_align(ui_lastHeardLabel, LV_TEXT_ALIGN_RIGHT, LV_PART_MAIN | LV_STATE_DEFAULT);
-    ui_lastHeardLabel->user_data = (void *)lastHeard;
-    // SignalLabel / hopsAway
-    lv_obj_t *ui_SignalLabel = lv_label_create(p);
-    lv_obj_set_width(ui_SignalLabel, LV_SIZE_CONTENT);
-    lv_obj_set_height(ui_SignalLabel, LV_SIZE_CONTENT);
-    lv_obj_set_pos(ui_SignalLabel, 8, 1);
-    lv_obj_set_align(ui_SignalLabel, LV_ALIGN_TOP_RIGHT);
-    lv_label_set_text(ui_SignalLabel, "");
-    ui_SignalLabel->user_data = (void *)-1; // TODO viaMqtt; // used for filtering (applyNodesFilter)
-    // PositionLabel
-    lv_obj_t *ui_PositionLabel = lv_label_create(p);
-    lv_obj_set_pos(ui_PositionLabel, -5, 49);
-    lv_obj_set_size(ui_PositionLabel, 120, LV_SIZE_CONTENT);
-    lv_label_set_long_mode(ui_PositionLabel, LV_LABEL_LONG_CLIP);
-    lv_label_set_text(ui_PositionLabel, "");
-    lv_obj_set_style_align(ui_PositionLabel, LV_ALIGN_TOP_LEFT, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_color(ui_PositionLabel, colorBlueGreen, LV_PART_MAIN | LV_STATE_DEFAULT);
-    ui_PositionLabel->user_data = 0; // store latitude
-    // Position2Label
-    lv_obj_t *ui_Position2Label = lv_label_create(p);
-    lv_obj_set_pos(ui_Position2Label, -5, 63);
-    lv_obj_set_size(ui_Position2Label, 108, LV_SIZE_CONTENT);
-    lv_label_set_long_mode(ui_Position2Label, LV_LABEL_LONG_SCROLL);
-    lv_label_set_text(ui_Position2Label, "");
-    lv_obj_set_style_align(ui_Position2Label, LV_ALIGN_TOP_LEFT, LV_PART_MAIN | LV_STATE_DEFAULT);
-    ui_Position2Label->user_data = 0; // store longitude
-    // Telemetry1Label
-    lv_obj_t *ui_Telemetry1Label = lv_label_create(p);
-    lv_obj_set_pos(ui_Telemetry1Label, 8, 49);
-    lv_obj_set_size(ui_Telemetry1Label, 130, LV_SIZE_CONTENT);
-    lv_label_set_long_mode(ui_Telemetry1Label, LV_LABEL_LONG_CLIP);
-    lv_label_set_text(ui_Telemetry1Label, "");
-    lv_obj_set_style_align(ui_Telemetry1Label, LV_ALIGN_TOP_RIGHT, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_align(ui_Telemetry1Label, LV_TEXT_ALIGN_RIGHT, LV_PART_MAIN | LV_STATE_DEFAULT);
-    // Telemetry2Label
-    lv_obj_t *ui_Telemetry2Label = lv_label_create(p);
-    lv_obj_set_pos(ui_Telemetry2Label, 8, 63);
-    lv_obj_set_size(ui_Telemetry2Label, 130, LV_SIZE_CONTENT);
-    lv_label_set_long_mode(ui_Telemetry2Label, LV_LABEL_LONG_CLIP);
-    lv_label_set_text(ui_Telemetry2Label, "");
-    lv_obj_set_style_align(ui_Telemetry2Label, LV_ALIGN_TOP_RIGHT, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_align(ui_Telemetry2Label, LV_TEXT_ALIGN_RIGHT, LV_PART_MAIN | LV_STATE_DEFAULT);
-
-    // optimisation: hide all 6ix extended labels by default; enable only when set
-    // lv_obj_add_flag(ui_lastHeardLabel, LV_OBJ_FLAG_HIDDEN); // lastHeard
-    lv_obj_add_flag(ui_BatteryLabel, LV_OBJ_FLAG_HIDDEN); // Autohide battery
-    lv_obj_add_flag(ui_SignalLabel, LV_OBJ_FLAG_HIDDEN);  // Autohide signal/hops
-    lv_obj_add_flag(ui_PositionLabel, LV_OBJ_FLAG_HIDDEN);
-    lv_obj_add_flag(ui_Position2Label, LV_OBJ_FLAG_HIDDEN);
-    lv_obj_add_flag(ui_Telemetry1Label, LV_OBJ_FLAG_HIDDEN);
-    lv_obj_add_flag(ui_Telemetry2Label, LV_OBJ_FLAG_HIDDEN);
-
-    lv_obj_add_event_cb(nodeButton, ui_event_NodeButton, LV_EVENT_ALL, (void *)nodeNum);
-
-    // move node into new position within nodePanel
-    if (lastHeard) {
-        lv_obj_t **children = objects.nodes_panel->spec_attr->children;
-        int i = objects.nodes_panel->spec_attr->child_cnt - 1;
-        while (i > 1) {
-            if (lastHeard <= (time_t)(children[i - 1]->LV_OBJ_IDX(node_lh_idx)->user_data))
-                break;
-            i--;
-        }
-        if (i >= 1 && i < objects.nodes_panel->spec_attr->child_cnt - 1) {
-            lv_obj_move_to_index(p, i);
-            // re-arrange the group linked list by moving the new button (now at the tail) into the right position
-            void *after = children[i + 1]->LV_OBJ_IDX(node_btn_idx)->user_data;
-            _lv_ll_move_before(lv_group_ll, nodeButton->user_data, after);
-        }
-    }
-
-    if (!nodesChanged) {
-        applyNodesFilter(nodeNum);
-        updateNodesStatus();
-    }
-}
-void TFTView_320x240::addOrUpdateNode(uint32_t nodeNum, uint8_t channel, uint32_t lastHeard, const meshtastic_User &cfg)
-{
-    if (nodes.find(nodeNum) == nodes.end()) {
-        addNode(nodeNum, channel, cfg.short_name, cfg.long_name, lastHeard, (MeshtasticView::eRole)cfg.role,
-                cfg.public_key.size != 0, cfg.has_is_unmessagable && cfg.is_unmessagable);
-    } else {
-        updateNode(nodeNum, channel, cfg);
-    }
-}
-
-/**
- * @brief update node userName and image
- *
- * @param nodeNum
- * @param ch
- * @param userShort
- * @param userLong
- * @param lastHeard
- * @param role
- * @param viaMqtt
- */
-// void TFTView_320x240::updateNode(uint32_t nodeNum, uint8_t ch, const char *userShort, const char *userLong, uint32_t lastHeard,
-//                                  eRole role, bool hasKey, bool viaMqtt)
-void TFTView_320x240::updateNode(uint32_t nodeNum, uint8_t ch, const meshtastic_User &cfg)
-{
-    db.user = cfg;
-    auto it = nodes.find(nodeNum);
-    if (it != nodes.end() && it->second) {
-        if (it->first == ownNode) {
-            // update related settings buttons and store role in image user data
-            char buf[30];
-            lv_snprintf(buf, sizeof(buf), _("User name: %s"), cfg.short_name);
-            lv_label_set_text(objects.basic_settings_user_label, buf);
-
-            char buf1[30], buf2[40];
-            lv_dropdown_set_selected(objects.settings_device_role_dropdown,
-                                     role2val(meshtastic_Config_DeviceConfig_Role(cfg.role)));
-            lv_dropdown_get_selected_str(objects.settings_device_role_dropdown, buf1, sizeof(buf1));
-            lv_snprintf(buf2, sizeof(buf2), _("Device Role: %s"), buf1);
-            lv_label_set_text(objects.basic_settings_role_label, buf2);
-
-            // update DB
-            strcpy(db.short_name, cfg.short_name);
-            strcpy(db.long_name, cfg.long_name);
-            db.config.device.role = cfg.role;
-        }
-        lv_label_set_text(it->second->LV_OBJ_IDX(node_lbl_idx), cfg.long_name);
-        it->second->LV_OBJ_IDX(node_lbl_idx)->user_data = (void *)nodeNum;
-        lv_label_set_text(it->second->LV_OBJ_IDX(node_lbs_idx), cfg.short_name);
-        char *userData = (char *)&(it->second->LV_OBJ_IDX(node_lbs_idx)->user_data);
-        userData[0] = cfg.short_name[0];
-        if (userData[0] == 0x00)
-            userData[0] = ' ';
-        userData[1] = cfg.short_name[1];
-        if (userData[1] == 0x00)
-            userData[1] = ' ';
-        userData[2] = cfg.short_name[2];
-        if (userData[2] == 0x00)
-            userData[2] = ' ';
-        userData[3] = cfg.short_name[3];
-        if (userData[3] == 0x00)
-            userData[3] = ' ';
-
-        setNodeImage(nodeNum, (MeshtasticView::eRole)cfg.role, cfg.has_is_unmessagable && cfg.is_unmessagable,
-                     it->second->LV_OBJ_IDX(node_img_idx));
-
-        if (cfg.public_key.size != 0) {
-            // set border color to bg color
-            lv_color_t color = lv_obj_get_style_bg_color(it->second->LV_OBJ_IDX(node_img_idx), LV_PART_MAIN | LV_STATE_DEFAULT);
-            lv_obj_set_style_border_color(it->second->LV_OBJ_IDX(node_img_idx), color, LV_PART_MAIN | LV_STATE_DEFAULT);
-        } else {
-            lv_obj_set_style_border_color(it->second->LV_OBJ_IDX(node_img_idx), colorRed, LV_PART_MAIN | LV_STATE_DEFAULT);
-        }
-
-        // update chat name
-        auto ct = chats.find(it->first);
-        if (ct != chats.end()) {
-            char buf[64];
-            lv_snprintf(buf, sizeof(buf), "%s: %s", lv_label_get_text(it->second->LV_OBJ_IDX(node_lbs_idx)),
-                        lv_label_get_text(it->second->LV_OBJ_IDX(node_lbl_idx)));
-            lv_label_set_text(ct->second->spec_attr->children[0], buf);
-        }
-    }
-}
-**
- * @brief Update battery level and air utilisation
- *
- * @param nodeNum
- * @param bat_level
- * @param voltage
- * @param chUtil
- * @param airUtil
- */
-void TFTView_320x240::updateMetrics(uint32_t nodeNum, uint32_t bat_level, float voltage, float chUtil, float airUtil)
-{
-    auto it = nodes.find(nodeNum);
-    if (it != nodes.end()) {
-        char buf[48];
-        if (it->first == ownNode) {
-            sprintf(buf, _("Util %0.1f%%  Air %0.1f%%"), chUtil, airUtil);
-            lv_label_set_text(it->second->LV_OBJ_IDX(node_sig_idx), buf);
-
-            // update battery percentage and symbol
-            if (bat_level != 0 || voltage != 0) {
-                uint32_t shown_level = std::min(bat_level, (uint32_t)100);
-                sprintf(buf, "%d%%", shown_level);
-                bool alert = false;
-
-                BatteryLevel level;
-                BatteryLevel::Status status = level.calcStatus(bat_level, voltage);
-                switch (status) {
-                case BatteryLevel::Plugged:
-                    lv_obj_set_style_bg_image_src(objects.battery_image, &img_battery_plug_image,
-                                                  LV_PART_MAIN | LV_STATE_DEFAULT);
-                    if (shown_level == 100)
-                        buf[0] = '\0';
-                    break;
-                case BatteryLevel::Charging:
-                    lv_obj_set_style_bg_image_src(objects.battery_image, &img_battery_bolt_image,
-                                                  LV_PART_MAIN | LV_STATE_DEFAULT);
-                    break;
-                case BatteryLevel::Full:
-                    lv_obj_set_style_bg_image_src(objects.battery_image, &img_battery_full_image,
-                                                  LV_PART_MAIN | LV_STATE_DEFAULT);
-                    break;
-                case BatteryLevel::Mid:
-                    lv_obj_set_style_bg_image_src(objects.battery_image, &img_battery_mid_image, LV_PART_MAIN | LV_STATE_DEFAULT);
-                    break;
-                case BatteryLevel::Low:
-                    lv_obj_set_style_bg_image_src(objects.battery_image, &img_battery_low_image, LV_PART_MAIN | LV_STATE_DEFAULT);
-                    break;
-                case BatteryLevel::Empty:
-                    lv_obj_set_style_bg_image_src(objects.battery_image, &img_battery_empty_image,
-                                                  LV_PART_MAIN | LV_STATE_DEFAULT);
-                    break;
-                case BatteryLevel::Warn:
-                    lv_obj_set_style_bg_image_src(objects.battery_image, &img_battery_empty_warn_image,
-                                                  LV_PART_MAIN | LV_STATE_DEFAULT);
-                    buf[0] = '\0';
-                    alert = true;
-                    break;
-                default:
-                    ILOG_ERROR("unhandled battery level %d", status);
-                    break;
-                }
-                Themes::recolorTopLabel(objects.battery_percentage_label, alert);
-                lv_obj_set_style_bg_image_recolor_opa(objects.battery_image, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
-                lv_label_set_text(objects.battery_percentage_label, buf);
-            }
-        }
-
-        if (bat_level != 0 || voltage != 0) {
-            bat_level = std::min(bat_level, (uint32_t)100);
-            sprintf(buf, "%d%% %0.2fV", bat_level, voltage);
-            lv_label_set_text(it->second->LV_OBJ_IDX(node_bat_idx), buf);
-            lv_obj_remove_flag(it->second->LV_OBJ_IDX(node_bat_idx), LV_OBJ_FLAG_HIDDEN);
-        }
-    }
-}
-*
- * update signal strength for direct neighbors
- */
-void TFTView_320x240::updateSignalStrength(uint32_t nodeNum, int32_t rssi, float snr)
-{
-    if (nodeNum != ownNode) {
-        auto it = nodes.find(nodeNum);
-        if (it != nodes.end()) {
-            char buf[32];
-            if (rssi == 0 && snr == 0.0) {
-                buf[0] = '\0';
-            } else {
-                sprintf(buf, "rssi: %d snr: %.1f", rssi, snr);
-            }
-            lv_label_set_text(it->second->LV_OBJ_IDX(node_sig_idx), buf);
-            it->second->LV_OBJ_IDX(node_sig_idx)->user_data = 0;
-            lv_obj_remove_flag(it->second->LV_OBJ_IDX(node_sig_idx), LV_OBJ_FLAG_HIDDEN);
-        }
-    }
-}
-
-void TFTView_320x240::updateHopsAway(uint32_t nodeNum, uint8_t hopsAway)
-{
-    if (nodeNum != ownNode) {
-        auto it = nodes.find(nodeNum);
-        if (it != nodes.end()) {
-            char buf[32];
-            sprintf(buf, _("hops: %d"), (int)hopsAway);
-            lv_label_set_text(it->second->LV_OBJ_IDX(node_sig_idx), buf);
-            it->second->LV_OBJ_IDX(node_sig_idx)->user_data = (void *)(unsigned long)hopsAway;
-            lv_obj_remove_flag(it->second->LV_OBJ_IDX(node_sig_idx), LV_OBJ_FLAG_HIDDEN);
-        }
-    }
-}
 
 void TFTView_320x240::updateConnectionStatus(const meshtastic_DeviceConnectionStatus &status)
 {
@@ -909,269 +482,6 @@ void TFTView_320x240::updateConnectionStatus(const meshtastic_DeviceConnectionSt
     }
 }
 
-// ResponseHandler callbacks
-*
- * handle response from routing
- */
-/**
- * Signal scanner
- */
-**
- * Trace Route: handle  ack or timeout
- */
-*
- * @brief purge oldest node from node list (and all its memory)
- * @param nodeNum node that is being added and already contained in nodes[], so don't remove it!
- */
-void TFTView_320x240::purgeNode(uint32_t nodeNum)
-{
-    if (nodeCount <= 1)
-        return;
-
-    lv_obj_t **children = objects.nodes_panel->spec_attr->children;
-    int last = objects.nodes_panel->spec_attr->child_cnt - 1;
-    int i = last;
-
-#ifndef ALWAYS_PURGE_OLDEST_NODE
-    time_t curr_time;
-#ifdef ARCH_PORTDUINO
-    time(&curr_time);
-#else
-    curr_time = actTime;
-#endif
-    // prefer purging older unknown nodes first (but not the brand new ones)
-    while ((eRole)(long)(children[i]->LV_OBJ_IDX(node_img_idx)->user_data) != eRole::unknown ||
-           curr_time < (time_t)(children[i]->LV_OBJ_IDX(node_lh_idx)->user_data) + 120 ||
-           (unsigned long)(children[i]->LV_OBJ_IDX(node_lbl_idx)->user_data) == nodeNum ||
-           chats.find((unsigned long)(children[i]->LV_OBJ_IDX(node_lbl_idx)->user_data)) != chats.end()) {
-        if (i < (last + 1) / 5) { // keep 80% named nodes and 20% unknown (not fresh) nodes
-            i = last;
-            break;
-        }
-        i--;
-    }
-#endif
-    lv_obj_t *p = children[i];
-    uint32_t oldest = (unsigned long)(p->LV_OBJ_IDX(node_lbl_idx)->user_data);
-    uint32_t lastHeard = (unsigned long)p->LV_OBJ_IDX(node_lh_idx)->user_data;
-    if (lastHeard > 0 && (curtime - lastHeard <= secs_until_offline))
-        nodesOnline--;
-
-    ILOG_INFO("removing oldest node 0x%08x", oldest);
-    lv_obj_delete(p);
-    {
-        auto it = messages.find(oldest);
-        if (it != messages.end()) {
-            lv_obj_delete(it->second);
-            messages.erase(oldest);
-        }
-    }
-
-    {
-        auto it = chats.find(oldest);
-        if (it != chats.end()) {
-            lv_obj_delete(it->second);
-            chats.erase(oldest);
-            updateActiveChats();
-        }
-    }
-    removeFromMap(oldest);
-    nodes.erase(oldest);
-    nodeCount--;
-    nodesChanged = true; // flag to force re-apply node filter
-}
-
-/**
- * @brief apply enabled filters and highlight node
- *
- * @param nodeNum
- * @param reset : set true when filter has changed (to recalculate number of filtered nodes)
- * @return true
- * @return false
- */
-bool TFTView_320x240::applyNodesFilter(uint32_t nodeNum, bool reset)
-{
-    lv_obj_t *panel = nodes[nodeNum];
-    bool hide = false;
-    if (nodeNum != ownNode /* && filter.active*/) { // TODO
-        if (lv_obj_has_state(objects.nodes_filter_unknown_switch, LV_STATE_CHECKED)) {
-            if (lv_img_get_src(panel->LV_OBJ_IDX(node_img_idx)) == &img_circle_question_image) {
-                hide = true;
-            }
-        }
-        if (lv_obj_has_state(objects.nodes_filter_offline_switch, LV_STATE_CHECKED)) {
-            time_t lastHeard = (time_t)panel->LV_OBJ_IDX(node_lh_idx)->user_data;
-            if (lastHeard == 0 || curtime - lastHeard > secs_until_offline)
-                hide = true;
-        }
-        if (lv_obj_has_state(objects.nodes_filter_public_key_switch, LV_STATE_CHECKED)) {
-            bool hasKey = (unsigned long)panel->LV_OBJ_IDX(node_bat_idx)->user_data == 1;
-            if (!hasKey)
-                hide = true;
-        }
-        if (lv_dropdown_get_selected(objects.nodes_filter_channel_dropdown) != 0) {
-            int selected = lv_dropdown_get_selected(objects.nodes_filter_channel_dropdown);
-            if (selected != 0) {
-                uint8_t ch = (uint8_t)(unsigned long)panel->user_data;
-                if (selected - 1 != ch)
-                    hide = true;
-            }
-        }
-        if (lv_dropdown_get_selected(objects.nodes_filter_hops_dropdown) != 0) {
-            int32_t hopsAway = (signed long)panel->LV_OBJ_IDX(node_sig_idx)->user_data;
-            int selected = lv_dropdown_get_selected(objects.nodes_filter_hops_dropdown) - 7;
-            if (hopsAway < 0)
-                hide = true;
-            else if (selected <= 0) {
-                if (hopsAway > -selected)
-                    hide = true;
-            } else {
-                if (hopsAway < selected)
-                    hide = true;
-            }
-        }
-#if 0
-        if (lv_obj_has_state(objects.nodes_filter_mqtt_switch, LV_STATE_CHECKED)) {
-            bool viaMqtt = false; // TODO (unsigned long)panel->LV_OBJ_IDX(node_sig_idx)->user_data;
-            if (viaMqtt)
-                hide = true;
-        }
-#endif
-        if (lv_obj_has_state(objects.nodes_filter_position_switch, LV_STATE_CHECKED)) {
-            if (lv_label_get_text(panel->LV_OBJ_IDX(node_pos1_idx))[0] == '\0')
-                hide = true;
-        }
-        const char *name = lv_textarea_get_text(objects.nodes_filter_name_area);
-        if (name[0] != '\0') {
-            if (name[0] != '!') { // use '!' char to negate search result
-                if (!strcasestr(lv_label_get_text(panel->LV_OBJ_IDX(node_lbl_idx)), name) &&
-                    !strcasestr(lv_label_get_text(panel->LV_OBJ_IDX(node_lbs_idx)), name)) {
-                    hide = true;
-                }
-            } else {
-                if (strcasestr(lv_label_get_text(panel->LV_OBJ_IDX(node_lbl_idx)), &name[1]) ||
-                    strcasestr(lv_label_get_text(panel->LV_OBJ_IDX(node_lbs_idx)), &name[1])) {
-                    hide = true;
-                }
-            }
-        }
-    }
-    if (hide) {
-        if (reset || !lv_obj_has_flag(panel, LV_OBJ_FLAG_HIDDEN)) {
-            lv_obj_add_flag(panel, LV_OBJ_FLAG_HIDDEN);
-            nodesFiltered++;
-        }
-    } else {
-        lv_obj_clear_flag(panel, LV_OBJ_FLAG_HIDDEN);
-    }
-
-    // hide node location if filtered
-    if (map)
-        map->update(nodeNum, hide);
-
-    bool highlight = false;
-    if (true /*highlight.active*/) { // TODO
-        if (lv_obj_has_state(objects.nodes_hl_active_chat_switch, LV_STATE_CHECKED)) {
-            auto it = chats.find(nodeNum);
-            if (it != nodes.end()) {
-                lv_obj_set_style_border_color(panel, colorOrange, LV_PART_MAIN | LV_STATE_DEFAULT);
-                highlight = true;
-            }
-        }
-        if (lv_obj_has_state(objects.nodes_hl_position_switch, LV_STATE_CHECKED)) {
-            if (lv_label_get_text(panel->LV_OBJ_IDX(node_pos1_idx))[0] != '\0') {
-                lv_obj_set_style_border_color(panel, colorBlueGreen, LV_PART_MAIN | LV_STATE_DEFAULT);
-                highlight = true;
-            }
-        }
-        if (lv_obj_has_state(objects.nodes_hl_telemetry_switch, LV_STATE_CHECKED)) {
-            if (lv_label_get_text(panel->LV_OBJ_IDX(node_tm1_idx))[0] != '\0') {
-                lv_obj_set_style_border_color(panel, colorBlue, LV_PART_MAIN | LV_STATE_DEFAULT);
-                lv_obj_set_style_border_width(panel, 2, LV_PART_MAIN | LV_STATE_DEFAULT);
-                highlight = true;
-            }
-        }
-        if (lv_obj_has_state(objects.nodes_hliaq_switch, LV_STATE_CHECKED)) {
-            if (lv_label_get_text(panel->LV_OBJ_IDX(node_tm2_idx))[0] != '\0') {
-                uint32_t iaq = (unsigned long)panel->LV_OBJ_IDX(node_tm2_idx)->user_data;
-                // IAQ color code
-                lv_color_t fg, bg;
-                if (iaq <= 50) {
-                    fg = lv_color_hex(0x00000000);
-                    bg = lv_color_hex(0x000ce810);
-                } else if (iaq <= 100) {
-                    fg = lv_color_hex(0x00000000);
-                    bg = lv_color_hex(0x00faf646);
-                } else if (iaq <= 150) {
-                    fg = lv_color_hex(0x00000000);
-                    bg = lv_color_hex(0x00f98204);
-                } else if (iaq <= 200) {
-                    fg = lv_color_hex(0x00000000);
-                    bg = lv_color_hex(0x00e42104);
-                } else if (iaq <= 300) {
-                    fg = lv_color_hex(0xffffffff);
-                    bg = lv_color_hex(0x009b2970);
-                } else {
-                    fg = lv_color_hex(0xffffffff);
-                    bg = lv_color_hex(0x001d1414);
-                }
-                lv_obj_set_style_text_color(panel->LV_OBJ_IDX(node_tm2_idx), fg, LV_PART_MAIN | LV_STATE_DEFAULT);
-                lv_obj_set_style_bg_color(panel->LV_OBJ_IDX(node_tm2_idx), bg, LV_PART_MAIN | LV_STATE_DEFAULT);
-                lv_obj_set_style_bg_opa(panel->LV_OBJ_IDX(node_tm2_idx), 255, LV_PART_MAIN | LV_STATE_DEFAULT);
-                lv_obj_set_style_border_color(panel, bg, LV_PART_MAIN | LV_STATE_DEFAULT);
-                lv_obj_set_style_border_width(panel, 2, LV_PART_MAIN | LV_STATE_DEFAULT);
-                highlight = true;
-            }
-        }
-        const char *name = lv_textarea_get_text(objects.nodes_hl_name_area);
-        if (name[0] != '\0') {
-            if (strcasestr(lv_label_get_text(panel->LV_OBJ_IDX(node_lbl_idx)), name) ||
-                strcasestr(lv_label_get_text(panel->LV_OBJ_IDX(node_lbs_idx)), name)) {
-                lv_obj_set_style_border_color(panel, colorMesh, LV_PART_MAIN | LV_STATE_DEFAULT);
-                highlight = true;
-            }
-        }
-    }
-    if (!highlight) {
-        lv_obj_set_style_border_color(panel, colorMidGray, LV_PART_MAIN | LV_STATE_DEFAULT);
-        lv_obj_set_style_border_width(panel, 1, LV_PART_MAIN | LV_STATE_DEFAULT);
-    }
-    return hide; // TODO || filter.active;
-}
-/**
- * @brief mark the sent message as either heard or acknowledged or failed
- *
- * @param channelOrNode
- * @param id
- * @param ack
- */
-TView_320x240::screenSaving(bool enabled)
-{
-    if (enabled) {
-        // overlay main screen with blank screen to prevent accidentally pressing buttons
-        lv_screen_load_anim(objects.blank_screen, LV_SCR_LOAD_ANIM_FADE_OUT, 0, 0, false);
-        lv_group_focus_obj(objects.blank_screen_button);
-        screenLocked = true;
-        screenUnlockRequest = false;
-    } else {
-        if (THIS->db.uiConfig.screen_lock) {
-            ILOG_DEBUG("showing lock screen");
-            lv_screen_load_anim(objects.lock_screen, LV_SCR_LOAD_ANIM_NONE, 0, 0, false);
-        } else if (objects.main_screen) {
-            ILOG_DEBUG("showing main screen");
-            lv_screen_load_anim(objects.main_screen, LV_SCR_LOAD_ANIM_NONE, 0, 0, false);
-            if (THIS->activeSettings != eNone) {
-                lv_event_t e = {.code = LV_EVENT_CLICKED};
-                ui_event_cancel(&e);
-            }
-            screenLocked = false;
-        } else {
-            ILOG_DEBUG("showing boot screen");
-            lv_screen_load_anim(objects.boot_screen, LV_SCR_LOAD_ANIM_NONE, 0, 0, false);
-            screenLocked = false;
-        }
-    }
-}
 void TFTView_320x240::updateChannelConfig(const meshtastic_Channel &ch)
 {
     static lv_obj_t *btn[c_max_channels] = {objects.channel_button0, objects.channel_button1, objects.channel_button2,
@@ -1236,9 +546,6 @@ void TFTView_320x240::updateChannelConfig(const meshtastic_Channel &ch)
     }
 }
 
-// redraw bell icons and color
-uto set primary(secondary) channel name (based on region)
- */
 void TFTView_320x240::backup(uint32_t option)
 {
 #if defined(HAS_SDCARD) || defined(HAS_SD_MMC) || defined(ARCH_PORTDUINO)
@@ -1418,13 +725,13 @@ void TFTView_320x240::newMessage(uint32_t from, uint32_t to, uint8_t ch, const c
     char buf[284]; // 237 + 4 + 40 + 2 + 1
     lv_obj_t *container = nullptr;
     if (to == UINT32_MAX) { // message for group, prepend short name to msg
-        if (nodes.find(from) == nodes.end()) {
+        if (!nodes.contains(from)) {
             pos += sprintf(buf, "%04x ", from & 0xffff);
         } else {
-            // original short name is held in userData, extract it and add msg
-            char *userData = (char *)&(nodes[from]->LV_OBJ_IDX(node_lbs_idx)->user_data);
-            while (pos < 4 && userData[pos] != 0) {
-                buf[pos] = userData[pos];
+            // original short name is held in nodeDB, extract it and add msg
+            const char *userShort = nodeDB.shortName(nodeDB.find(from));
+            while (pos < 4 && userShort[pos] != 0) {
+                buf[pos] = userShort[pos];
                 pos++;
             }
         }
@@ -1452,7 +759,8 @@ void TFTView_320x240::newMessage(uint32_t from, uint32_t to, uint8_t ch, const c
             updateUnreadMessages();
             if (activePanel != objects.messages_panel && db.uiConfig.alert_enabled &&
                 !db.channel[ch].settings.module_settings.is_muted) {
-                showMessagePopup(from, to, ch, lv_label_get_text(nodes[from]->LV_OBJ_IDX(node_lbl_idx)));
+                uint32_t slot = nodeDB.find(from);
+                showMessagePopup(from, to, ch, slot != NodeDB::c_noSlot ? nodeDB.longName(slot) : "");
             }
             lv_obj_add_flag(container, LV_OBJ_FLAG_HIDDEN);
         }
@@ -1474,33 +782,7 @@ void TFTView_320x240::newMessage(uint32_t from, uint32_t to, uint8_t ch, const c
  */
 void TFTView_320x240::newMessage(uint32_t nodeNum, lv_obj_t *container, uint8_t ch, const char *msg)
 {
-    lv_obj_t *hiddenPanel = lv_obj_create(container);
-    lv_obj_set_width(hiddenPanel, lv_pct(100));
-    lv_obj_set_height(hiddenPanel, LV_SIZE_CONTENT); /// 50
-    lv_obj_set_align(hiddenPanel, LV_ALIGN_CENTER);
-    lv_obj_clear_flag(hiddenPanel, LV_OBJ_FLAG_SCROLLABLE); /// Flags
-    lv_obj_set_style_radius(hiddenPanel, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    add_style_panel_style(hiddenPanel);
-    lv_obj_set_style_pad_left(hiddenPanel, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_pad_right(hiddenPanel, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_pad_top(hiddenPanel, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_pad_bottom(hiddenPanel, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-
-    lv_obj_t *msgLabel = lv_label_create(hiddenPanel);
-    // calculate expected size of text bubble, to make it look nicer
-    lv_coord_t width = lv_txt_get_width(msg, strlen(msg), &ui_font_montserrat_14, 0);
-    lv_obj_set_width(msgLabel, std::max<int32_t>(std::min<int32_t>((int32_t)(width), 160) + 10, 40));
-    lv_obj_set_height(msgLabel, LV_SIZE_CONTENT);
-    lv_obj_set_align(msgLabel, LV_ALIGN_LEFT_MID);
-    lv_label_set_text(msgLabel, msg);
-    add_style_new_message_style(msgLabel);
-    lv_obj_add_flag(msgLabel, LV_OBJ_FLAG_CLICK_FOCUSABLE);
-    lv_obj_add_event_cb(msgLabel, ui_event_chatNodeButton, LV_EVENT_CLICKED, (void *)nodeNum);
-
-    if (state == MeshtasticView::eRunning) {
-        lv_obj_scroll_to_view(hiddenPanel, LV_ANIM_ON);
-        lv_obj_move_foreground(objects.message_input_area);
-    }
+    TFTView_Common::newMessage(nodeNum, container, ch, msg);
 }
 
 /**
@@ -1523,7 +805,7 @@ void TFTView_320x240::restoreMessage(const LogMessage &msg)
                 container = newMessageContainer(msg.from, msg.to, msg.ch);
             }
         } else {
-            if (nodes.find(msg.to) != nodes.end()) {
+            if (nodes.contains(msg.to)) {
                 if (msg.trashFlag && chats.find(msg.to) != chats.end()) {
                     ILOG_DEBUG("trashFlag set for node %08x", msg.to);
                     eraseChat(msg.to);
@@ -1541,7 +823,7 @@ void TFTView_320x240::restoreMessage(const LogMessage &msg)
                 lv_obj_add_flag(container, LV_OBJ_FLAG_HIDDEN);
             addMessage(container, msg.time, 0, (char *)msg.bytes, msg.status);
         }
-    } else if (nodes.find(msg.from) != nodes.end()) {
+    } else if (nodes.contains(msg.from)) {
         if (msg.trashFlag && chats.find(msg.from) != chats.end()) {
             ILOG_DEBUG("trashFlag set for node %08x", msg.from);
             eraseChat(msg.from);
@@ -1613,10 +895,9 @@ void TFTView_320x240::addChat(uint32_t from, uint32_t to, uint8_t ch)
     if (to == UINT32_MAX || from == 0) {
         sprintf(buf, "%d: %s", (int)ch, lv_label_get_text(channel[ch]));
     } else {
-        auto it = nodes.find(from);
-        if (it != nodes.end()) {
-            sprintf(buf, "%s: %s", lv_label_get_text(it->second->LV_OBJ_IDX(node_lbs_idx)),
-                    lv_label_get_text(it->second->LV_OBJ_IDX(node_lbl_idx)));
+        uint32_t slot = nodeDB.find(from);
+        if (nodes.contains(from) && slot != NodeDB::c_noSlot) {
+            sprintf(buf, "%s: %s", nodeDB.shortName(slot), nodeDB.longName(slot));
         } else {
             sprintf(buf, "!%08x", from);
         }
@@ -1662,7 +943,7 @@ void TFTView_320x240::addChat(uint32_t from, uint32_t to, uint8_t ch)
     chats[index] = chatBtn;
     updateActiveChats();
     if (index > c_max_channels) {
-        if (nodes.find(index) != nodes.end())
+        if (nodes.contains(index))
             applyNodesFilter(index);
     }
 
@@ -1688,9 +969,6 @@ void TFTView_320x240::updateActiveChats(void)
 }
 
 /**
- * @brief Display banner showing to be patient while restoring messages
- */
-**
  * @brief display new message popup panel
  *
  * @param from sender (NULL for removing popup)
@@ -1756,23 +1034,19 @@ void TFTView_320x240::showMessages(uint32_t nodeNum)
     }
     activeMsgContainer->user_data = (void *)nodeNum;
     lv_obj_clear_flag(activeMsgContainer, LV_OBJ_FLAG_HIDDEN);
-    lv_obj_t *p = nodes[nodeNum];
-    if (p) {
-        lv_label_set_text(objects.top_messages_node_label, lv_label_get_text(p->LV_OBJ_IDX(node_lbl_idx)));
+    uint32_t slot = nodeDB.find(nodeNum);
+    if (nodes.contains(nodeNum)) {
+        lv_label_set_text(objects.top_messages_node_label, slot != NodeDB::c_noSlot ? nodeDB.longName(slot) : "");
         ui_set_active(objects.messages_button, objects.messages_panel, objects.top_messages_panel);
-        switch ((unsigned long)p->LV_OBJ_IDX(node_bat_idx)->user_data) {
-        case 0:
-            lv_obj_set_style_bg_image_src(objects.top_messages_node_image, &img_lock_channel_image,
+        if (slot == NodeDB::c_noSlot || nodeDB.hasFlag(slot, NodeDB::eKeyMismatch)) {
+            lv_obj_set_style_bg_image_src(objects.top_messages_node_image, &img_lock_slash_image,
                                           LV_PART_MAIN | LV_STATE_DEFAULT);
-            break;
-        case 1:
+        } else if (nodeDB.hasFlag(slot, NodeDB::eHasKey)) {
             lv_obj_set_style_bg_image_src(objects.top_messages_node_image, &img_lock_secure_image,
                                           LV_PART_MAIN | LV_STATE_DEFAULT);
-            break;
-        default:
-            lv_obj_set_style_bg_image_src(objects.top_messages_node_image, &img_lock_slash_image,
+        } else {
+            lv_obj_set_style_bg_image_src(objects.top_messages_node_image, &img_lock_channel_image,
                                           LV_PART_MAIN | LV_STATE_DEFAULT);
-            break;
         }
         unreadMessages = 0; // TODO: not all messages may be actually read
         updateUnreadMessages();
@@ -1781,17 +1055,6 @@ void TFTView_320x240::showMessages(uint32_t nodeNum)
     }
 }
 
-/**
- * @brief Place keyboard at a suitable space above or below the text input area
- *
- * @param textArea
- */
-*
- * Enable underlying panel, buttons and scrollbar after it was disabled
- */
-/**
- * Disable underlying panel with it's children buttons and scrollbar
- */
 /**
  * Set focus to first button of a panel
  */
@@ -1800,7 +1063,7 @@ void TFTView_320x240::setGroupFocus(lv_obj_t *panel)
     if (panel == objects.home_panel) {
         lv_group_focus_obj(objects.home_mail_button);
     } else if (panel == objects.nodes_panel) {
-        lv_group_focus_obj(objects.node_button);
+        TFTView_Common::setGroupFocus(panel); // first visible row of the node list
     } else if (panel == objects.groups_panel) {
         lv_group_focus_obj(objects.channel_button0);
     } else if (panel == objects.messages_panel) {
@@ -1828,72 +1091,7 @@ void TFTView_320x240::setGroupFocus(lv_obj_t *panel)
 /**
  * input group used by keyboard and/or pointer for dynamic assignment
  */
-/ -------- helpers --------
-
-void TFTView_320x240::removeNode(uint32_t nodeNum)
-{
-    auto it = nodes.find(nodeNum);
-    if (it != nodes.end()) {
-    }
-}
-
-void TFTView_320x240::setNodeImage(uint32_t nodeNum, eRole role, bool unmessagable, lv_obj_t *img)
-{
-    uint32_t bgColor, fgColor;
-    std::tie(bgColor, fgColor) = nodeColor(nodeNum);
-    if (unmessagable) {
-        lv_image_set_src(img, &img_unmessagable_image);
-        lv_obj_set_style_border_color(img, lv_color_hex(bgColor), LV_PART_MAIN | LV_STATE_DEFAULT);
-        lv_obj_set_style_bg_color(img, lv_color_hex(0x202020), LV_PART_MAIN | LV_STATE_DEFAULT);
-        lv_obj_set_style_img_recolor(img, lv_color_hex(0xFF5555), LV_PART_MAIN | LV_STATE_DEFAULT);
-        lv_obj_set_style_img_recolor_opa(img, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
-        return;
-    } else {
-        switch (role) {
-        case client:
-        case client_mute:
-        case client_hidden:
-        case tak: {
-            lv_image_set_src(img, &img_node_client_image);
-            break;
-        }
-        case router_client: {
-            lv_image_set_src(img, &img_top_nodes_image);
-            break;
-        }
-        case repeater:
-        case router:
-        case router_late: {
-            lv_image_set_src(img, &img_node_router_image);
-            break;
-        }
-        case tracker:
-        case sensor:
-        case lost_and_found:
-        case tak_tracker: {
-            lv_image_set_src(img, &img_node_sensor_image);
-            break;
-        }
-        case unknown: {
-            lv_image_set_src(img, &img_circle_question_image);
-            break;
-        }
-        default:
-            lv_image_set_src(img, &img_node_client_image);
-            break;
-        }
-    }
-    lv_obj_set_style_bg_color(img, lv_color_hex(bgColor), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_color(img, lv_color_hex(bgColor), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_img_recolor_opa(img, fgColor ? 0 : 255, LV_PART_MAIN | LV_STATE_DEFAULT);
-}
-
-void TFTView_320x240::updateNodesStatus(void)
-{
-    char buf[40];
-    lv_snprintf(buf, sizeof(buf), _p("%d of %d nodes online", nodeCount), nodesOnline, nodeCount);
-    lv_label_set_text(objects.home_nodes_label, buf);
-}
+// -------- helpers --------
 
 int TFTView_320x240::getChannelButtonWidth()
 {
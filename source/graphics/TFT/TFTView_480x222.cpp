@@ -52,12 +52,8 @@ fs::FS &fileSystem = LittleFS;
 #include "graphics/map/URLService.h"
 #include "graphics/common/SdCard.h"
 
-#ifndef MAX_NUM_NODES_VIEW
-#define MAX_NUM_NODES_VIEW 250
-#endif
-
 #ifndef PACKET_LOGS_MAX
-#define PACKET_LOGS_MAX 200
+#define PACKET_LOGS_MAX 1000 // 24 bytes each
 #endif
 
 LV_IMAGE_DECLARE(img_circle_image);
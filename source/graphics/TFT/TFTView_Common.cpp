@@ -29,7 +29,6 @@
 #include <cstring>
 #include <functional>
 #include <iomanip>
-#include <list>
 #include <locale>
 #include <random>
 #include <sstream>
@@ -55,14 +54,24 @@ extern fs::FS &fileSystem;
 #include "graphics/map/URLService.h"
 #include "graphics/common/SdCard.h"
 
+#ifndef PACKET_LOGS_MAX
+#define PACKET_LOGS_MAX 1000 // 24 bytes each
+#endif
+
+// no widgets per node, but nodeDB, nodes, nodeFilter and distances keep a few hundred bytes each
 #ifndef MAX_NUM_NODES_VIEW
+#if defined(BOARD_HAS_PSRAM)
+#define MAX_NUM_NODES_VIEW 1000
+#else
 #define MAX_NUM_NODES_VIEW 250
 #endif
-
-#ifndef PACKET_LOGS_MAX
-#define PACKET_LOGS_MAX 200
 #endif
 
+constexpr int32_t c_nodePanelHeight = 53;  // collapsed node panel
+constexpr int32_t c_nodePanelDetails = 30; // added by expanding a node panel: position and telemetry
+constexpr uint32_t c_distanceBatch = 16; // node distances recomputed per task_handler() call
+constexpr uint32_t c_relabelBatch = 16;  // hidden labels relabeled per task_handler() call after a locale switch
+
 #define CR_REPLACEMENT 0x0C // dummy to record several lines in a one line textarea
 #define THIS TFTView_Common::commonInstance
 
@@ -163,7 +172,6 @@ extern const char *firmware_version;
 // static member initialization
 TFTView_Common *TFTView_Common::commonInstance = nullptr;
 uint32_t TFTView_Common::currentNode = 0;
-lv_obj_t *TFTView_Common::currentPanel = nullptr;
 lv_obj_t *TFTView_Common::spinnerButton = nullptr;
 time_t TFTView_Common::startTime = 0;
 uint32_t TFTView_Common::pinKeys = 0;
@@ -172,11 +180,39 @@ bool TFTView_Common::screenUnlockRequest = false;
 
 static lv_obj_t *symIndicator = nullptr;
 
+// text of the widgets the label registry relabels, nullptr for other widgets
+static const char *widgetText(LabelRegistry::Label label)
+{
+    lv_obj_t *obj = (lv_obj_t *)label;
+    if (lv_obj_check_type(obj, &lv_label_class))
+        return lv_label_get_text(obj);
+    if (lv_obj_check_type(obj, &lv_checkbox_class))
+        return lv_checkbox_get_text(obj);
+    if (lv_obj_check_type(obj, &lv_dropdown_class))
+        return lv_dropdown_get_options(obj);
+    return nullptr;
+}
+
+static void setWidgetText(LabelRegistry::Label label, const char *text)
+{
+    lv_obj_t *obj = (lv_obj_t *)label;
+    if (lv_obj_check_type(obj, &lv_label_class)) {
+        lv_label_set_text(obj, text);
+    } else if (lv_obj_check_type(obj, &lv_checkbox_class)) {
+        lv_checkbox_set_text(obj, text);
+    } else if (lv_obj_check_type(obj, &lv_dropdown_class)) {
+        uint32_t selected = lv_dropdown_get_selected(obj);
+        lv_dropdown_set_options(obj, text);
+        lv_dropdown_set_selected(obj, selected);
+    }
+}
+
 TFTView_Common::TFTView_Common(const DisplayDriverConfig *cfg, DisplayDriver *driver)
-    : MeshtasticView(cfg, driver, new ViewController), screensInitialised(false), nodesFiltered(0), nodesChanged(true),
-      processingFilter(false), packetLogEnabled(false), detectorRunning(false), cardDetected(false), formatSD(false),
-      packetCounter(0), actTime(0), uptime(0), lastHeard(0), hasPosition(false), myLatitude(0), myLongitude(0),
-      topNodeLL(nullptr), scans(0), selectedHops(0), chooseNodeSignalScanner(false), chooseNodeTraceRoute(false), qr(nullptr),
+    : MeshtasticView(cfg, driver, new ViewController), screensInitialised(false), nodesChanged(true),
+      nodeRowsChanged(false), packetLogEnabled(false), detectorRunning(false), cardDetected(false), formatSD(false),
+      labels(lv_i18n_get_text, widgetText, setWidgetText, lv_i18n_get_msg_id), nodeList(nullptr), packetLog(PACKET_LOGS_MAX),
+      packetList(nullptr), packetStats(0), statisticsChanged(false), actTime(0), uptime(0),
+      lastHeard(0), hasPosition(false), myLatitude(0), myLongitude(0), topNodeLL(nullptr), scans(0), selectedHops(0), chooseNodeSignalScanner(false), chooseNodeTraceRoute(false), qr(nullptr),
       db{}
 {
     filter.active = false;
@@ -405,52 +441,34 @@ void TFTView_Common::timer_event_shutdown(lv_timer_t *timer)
 
 // ─── Packet handling ─────────────────────────────────────────────────────────
 
+/**
+ * store the packet as binary record, the text is formatted when the row becomes visible
+ */
 void TFTView_Common::writePacketLog(const meshtastic_MeshPacket &p)
 {
-    static std::unordered_map<uint16_t, const char *> name = {
-        {0, "unknown"},        {1, "text message"},    {2, "remote hardware"}, {3, "position"},    {4, "node info"},
-        {5, "routing"},        {6, "admin"},           {7, "text message"},    {8, "waypoint"},    {9, "audio"},
-        {10, "sensor"},        {32, "reply"},          {33, "ip tunnel"},      {34, "paxcounter"}, {64, "serial"},
-        {65, "store forward"}, {66, "range test"},     {67, "telemetry"},      {68, "ZPS"},        {69, "simulator"},
-        {70, "tracert"},       {71, "neighbor info"},  {72, "atax"},           {73, "map report"}, {74, "power stress"},
-        {256, "private"},      {257, "atax forwarder"}};
-
     // ignore admin packages initiated by us
     if (p.from == ownNode && p.decoded.portnum == meshtastic_PortNum_ADMIN_APP)
         return;
 
     // get actual time
-    char timebuf[16];
     time_t curr_time;
 #ifdef ARCH_PORTDUINO
     time(&curr_time);
 #else
     curr_time = actTime;
 #endif
-    tm *curr_tm = localtime(&curr_time);
-    if (VALID_TIME(curr_time)) {
-        strftime(timebuf, 16, "%T", curr_tm);
-    } else {
-        strcpy(timebuf, "??:??:??");
-    }
 
-    // get node name from
-    char from[5];
-    char *userShort = (char *)&(nodes[p.from]->LV_OBJ_IDX(node_lbs_idx)->user_data);
-    int pos = 0;
-    while (pos < 4 && userShort[pos] != 0) {
-        from[pos] = userShort[pos];
-        pos++;
-    }
-    from[pos] = '\0';
-
-    char buf[256];
-    if (p.to == 0xffffffff)
-        sprintf(buf, "%s: ch%d %s:%04x->all: %s", timebuf, p.channel, from, p.from & 0xffff,
-                name[p.decoded.portnum]); // note: this may crash if there's a new portnum not in this map...
-    else
-        sprintf(buf, "%s: ch%d %s:%04x->%s%04x: %s", timebuf, p.channel, from, p.from & 0xffff, p.to == ownNode ? "*" : "",
-                p.to & 0xffff, name[p.decoded.portnum]);
+    PacketLog::Entry entry{};
+    entry.time = VALID_TIME(curr_time) ? uint32_t(curr_time) : 0;
+    entry.from = p.from;
+    entry.to = p.to;
+    entry.port = p.decoded.portnum;
+    entry.size = p.decoded.payload.size;
+    entry.rssi = p.rx_rssi;
+    entry.snr = (int8_t)lroundf(p.rx_snr * 4.0f);
+    entry.channel = p.channel;
+    if (p.hop_start != 0 && p.hop_start >= p.hop_limit)
+        entry.hops = p.hop_start - p.hop_limit;
 
     if (p.decoded.portnum == meshtastic_PortNum_TELEMETRY_APP) {
         meshtastic_Telemetry telemetry;
@@ -459,114 +477,118 @@ void TFTView_Common::writePacketLog(const meshtastic_MeshPacket &p)
             case meshtastic_Telemetry_device_metrics_tag: {
                 if (p.from == ownNode)
                     return; // suppress (internal) battery level packets
-                strcat(buf, " dev");
+                entry.detail = PacketLog::eDeviceMetrics;
                 break;
             }
             case meshtastic_Telemetry_environment_metrics_tag: {
-                strcat(buf, " env");
+                entry.detail = PacketLog::eEnvironmentMetrics;
                 break;
             }
             case meshtastic_Telemetry_air_quality_metrics_tag: {
-                strcat(buf, " air");
+                entry.detail = PacketLog::eAirQualityMetrics;
                 break;
             }
             case meshtastic_Telemetry_power_metrics_tag: {
-                strcat(buf, " pow");
+                entry.detail = PacketLog::ePowerMetrics;
                 break;
             }
             case meshtastic_Telemetry_local_stats_tag: {
-                strcat(buf, " dev"); // bug in firmware that this is local?
+                entry.detail = PacketLog::eDeviceMetrics; // bug in firmware that this is local?
+                break;
             }
             default:
                 break;
             }
         }
-    } else if (p.decoded.portnum == meshtastic_PortNum_TRACEROUTE_APP) {
-        // print the recorded route and add from/to manually
-        strcat(buf, "\n");
-        int pos = strlen(buf);
-        if (p.to == ownNode) {
-            pos += snprintf(&buf[pos], 16, "%04x", ownNode & 0xffff);
-        }
+    }
+    packetLog.push(entry);
 
+    if (p.decoded.portnum == meshtastic_PortNum_TRACEROUTE_APP) {
         meshtastic_RouteDiscovery route;
-        if (pb_decode_from_bytes(p.decoded.payload.bytes, p.decoded.payload.size, &meshtastic_RouteDiscovery_msg, &route)) {
-            for (int i = 0; i < route.route_count; i++) {
-                uint32_t nodeNum = route.route[i];
-                if (nodeNum != UINT32_MAX) {
-                    pos += snprintf(&buf[pos], 16, "->%04x", nodeNum & 0xffff);
-                } else {
-                    strcat(buf, "->unk");
-                    pos += 6;
-                }
-            }
-            if (p.to == ownNode) {
-                pos += snprintf(&buf[pos], 16, "->%04x", p.from & 0xffff);
-            }
-        }
+        if (pb_decode_from_bytes(p.decoded.payload.bytes, p.decoded.payload.size, &meshtastic_RouteDiscovery_msg, &route))
+            packetLog.setRoute(route.route, route.route_count);
     }
 
-    if (packetCounter >= PACKET_LOGS_MAX) {
-        // delete oldest entry
-        lv_obj_del(objects.tools_packet_log_panel->spec_attr->children[0]);
-    } else {
-        packetCounter++;
-        char top[24];
-        sprintf(top, _("Packet Log: %d"), packetCounter);
-        lv_label_set_text(objects.top_packet_log_label, top);
-    }
-    lv_obj_t *pLabel = lv_label_create(objects.tools_packet_log_panel);
-    lv_obj_set_pos(pLabel, 0, 0);
-    lv_obj_set_size(pLabel, LV_PCT(100), LV_SIZE_CONTENT);
-    uint32_t bgColor, fgColor;
-    std::tie(bgColor, fgColor) = nodeColor(p.from);
-    lv_obj_set_style_bg_color(pLabel, lv_color_hex(bgColor), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_color(pLabel, lv_color_hex(fgColor), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_opa(pLabel, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_label_set_text(pLabel, buf);
+    char top[24];
+    lv_snprintf(top, sizeof(top), _("Packet Log: %d"), packetLog.size());
+    lv_label_set_text(objects.top_packet_log_label, top);
 
-    // auto-scroll if last item is visible
-    if (lv_obj_get_scroll_bottom(objects.tools_packet_log_panel) < 20)
-        lv_obj_scroll_to_view(pLabel, LV_ANIM_OFF);
+    if (packetList) {
+        // auto-scroll if last item is visible
+        bool atBottom = lv_obj_get_scroll_bottom(objects.tools_packet_log_panel) < 20;
+        packetList->setCount(packetLog.size());
+        if (atBottom)
+            lv_obj_scroll_by(objects.tools_packet_log_panel, 0, -lv_obj_get_scroll_bottom(objects.tools_packet_log_panel),
+                             LV_ANIM_OFF);
+    }
 }
 
-void TFTView_Common::updateStatistics(const meshtastic_MeshPacket &p)
+/**
+ * row of the packet log list, the pool has only as many rows as fit into the panel;
+ * two single lines: the packet itself and its path and signal, each cut with dots
+ */
+lv_obj_t *TFTView_Common::createPacketLogRow(lv_obj_t *parent)
 {
-    struct Stats {
-        uint32_t id;
-        uint16_t row;
-        uint16_t tel;
-        uint16_t pos;
-        uint16_t inf;
-        uint16_t trc;
-        uint16_t txt;
-        uint16_t nbr;
-        uint32_t sum;
+    lv_obj_t *row = lv_obj_create(parent);
+    lv_obj_remove_style_all(row);
+    lv_obj_set_pos(row, 0, 0);
+    lv_obj_set_size(row, LV_PCT(100), packetLogRowHeight());
+    lv_obj_set_style_bg_opa(row, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_remove_flag(row, LV_OBJ_FLAG_SCROLLABLE);
 
-        bool operator==(const Stats &rhs) const { return id == rhs.id; }
+    int32_t lineHeight = lv_font_get_line_height(lv_obj_get_style_text_font(parent, LV_PART_MAIN));
+    for (int32_t y : {int32_t(1), lineHeight + 1}) {
+        lv_obj_t *line = lv_label_create(row);
+        lv_obj_set_pos(line, 0, y);
+        lv_obj_set_size(line, LV_PCT(100), lineHeight);
+        lv_label_set_long_mode(line, LV_LABEL_LONG_DOT);
+    }
+    return row;
+}
 
-        Stats &operator+=(const Stats &rhs)
-        {
-            this->tel += rhs.tel;
-            this->pos += rhs.pos;
-            this->inf += rhs.inf;
-            this->trc += rhs.trc;
-            this->txt += rhs.txt;
-            this->nbr += rhs.nbr;
-            this->sum += 1;
-            return *this;
-        }
+void TFTView_Common::bindPacketLogRow(lv_obj_t *row, uint32_t index)
+{
+    const PacketLog::Entry &entry = THIS->packetLog[index];
+    char timebuf[16];
+    time_t time = entry.time;
+    if (VALID_TIME(time)) {
+        strftime(timebuf, sizeof(timebuf), "%T", localtime(&time));
+    } else {
+        strcpy(timebuf, "??:??:??");
+    }
 
-        bool operator<(const Stats &rhs) const
-        {
-            return sum > rhs.sum; // sort reverse but skip equal values
-        }
-    };
-    static std::list<Stats> stats;
+    char from[5] = {};
+    uint32_t slot = THIS->nodeDB.find(entry.from);
+    if (slot != NodeDB::c_noSlot)
+        strcpy(from, THIS->nodeDB.shortName(slot));
 
+    char buf[160];
+    THIS->packetLog.format(index, timebuf, from, THIS->ownNode, buf, sizeof(buf));
+    char *details = strchr(buf, '\n');
+    if (details)
+        *details++ = '\0';
+    uint32_t bgColor, fgColor;
+    std::tie(bgColor, fgColor) = THIS->nodeColor(entry.from);
+    lv_obj_set_style_bg_color(row, lv_color_hex(bgColor), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_color(row, lv_color_hex(fgColor), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_label_set_text(row->LV_OBJ_IDX(0), buf);
+    lv_label_set_text(row->LV_OBJ_IDX(1), details ? details : "");
+}
+
+int32_t TFTView_Common::packetLogRowHeight(void)
+{
+    return 2 * lv_font_get_line_height(lv_obj_get_style_text_font(objects.tools_packet_log_panel, LV_PART_MAIN)) + 2;
+}
+
+/**
+ * count the packet for its sender, the table is updated with the next frame
+ */
+void TFTView_Common::updateStatistics(const meshtastic_MeshPacket &p)
+{
     if (p.from == 0) {
         // clear table
-        stats.clear();
+        packetStats.clear();
+        statisticsShown.clear();
         for (int i = 1; i < statisticTableRows; i++) {
             for (int j = 0; j < 7; j++) {
                 lv_table_set_cell_value(objects.statistics_table, i, j, "");
@@ -576,7 +598,7 @@ void TFTView_Common::updateStatistics(const meshtastic_MeshPacket &p)
     }
 
     // update statistic for node
-    Stats stat = {p.from};
+    PacketStats::Counter counter;
     switch (p.decoded.portnum) {
     case meshtastic_PortNum_TELEMETRY_APP: {
         meshtastic_Telemetry telemetry;
@@ -586,97 +608,82 @@ void TFTView_Common::updateStatistics(const meshtastic_MeshPacket &p)
                     return; // suppress (internal) battery level packets
             }
         }
-        stat.tel++;
+        counter = PacketStats::eTelemetry;
         break;
     }
     case meshtastic_PortNum_POSITION_APP: {
-        stat.pos++;
+        counter = PacketStats::ePosition;
         break;
     }
     case meshtastic_PortNum_NODEINFO_APP: {
-        stat.inf++;
+        counter = PacketStats::eNodeInfo;
         break;
     }
     case meshtastic_PortNum_ROUTING_APP:
     case meshtastic_PortNum_TRACEROUTE_APP: {
-        stat.trc++;
+        counter = PacketStats::eTraceRoute;
         break;
     }
     case meshtastic_PortNum_TEXT_MESSAGE_APP:
     case meshtastic_PortNum_RANGE_TEST_APP: {
-        stat.txt++;
+        counter = PacketStats::eText;
         break;
     }
     case meshtastic_PortNum_NEIGHBORINFO_APP: {
-        stat.nbr++;
+        counter = PacketStats::eNeighborInfo;
         break;
     }
     case meshtastic_PortNum_ADMIN_APP: {
-        // ignore
+        // only part of the sum
+        counter = PacketStats::eOther;
         break;
     }
     default:
         ILOG_WARN("packet portnum in stats unhandled: %d", p.decoded.portnum);
-        stat.sum++;
         return;
     }
 
-    std::list<Stats>::iterator it = std::find(stats.begin(), stats.end(), stat);
-    if (it == stats.end()) {
-        stat.row = stats.size();
-        stat.sum = 1;
-        // TODO: stop if memory limit is reached
-        stats.push_back(stat);
-    } else {
-        *it += stat;
-    }
+    packetStats.count(p.from, counter);
+    statisticsChanged = true;
+}
 
-    stats.sort();
+/**
+ * fill the statistics table with the top nodes, only rows whose content changed are written
+ */
+void TFTView_Common::updateStatisticsTable(void)
+{
+    statisticsChanged = false;
+    uint32_t rows = statisticTableRows > 1 ? statisticTableRows - 1 : 0; // row 0 is the heading
+    std::vector<const PacketStats::Node *> top(rows);
+    rows = packetStats.top(top.data(), rows);
+    statisticsShown.resize(std::max<size_t>(statisticsShown.size(), rows), PacketStats::Node{});
 
-    // fill packet statistics table
     char buf[10];
-    int row = 1;
-    bool move = false;
-
-    for (auto it2 : stats) {
-        if (it2.id == p.from || move) {
-            buf[0] = '\0';
-            auto it = nodes.find(it2.id); // node may have been removed from nodes, so check if still there
-            if (it != nodes.end() && it->second) {
-                char *userData = (char *)&(it->second->LV_OBJ_IDX(node_lbs_idx)->user_data);
-                if (userData) {
-                    buf[0] = userData[0];
-                    buf[1] = userData[1];
-                    buf[2] = userData[2];
-                    buf[3] = userData[3];
-                    buf[4] = '\0';
-                }
-            }
-
+    for (uint32_t i = 0; i < rows; i++) {
+        const PacketStats::Node &node = *top[i];
+        PacketStats::Node &shown = statisticsShown[i];
+        uint32_t row = i + 1;
+        // the name may become known later, so compare with the cell
+        buf[0] = '\0';
+        uint32_t slot = nodeDB.find(node.num); // node may have been removed from nodes, so check if still there
+        if (slot != NodeDB::c_noSlot)
+            strcpy(buf, nodeDB.shortName(slot));
+        if (strcmp(lv_table_get_cell_value(objects.statistics_table, row, 0), buf) != 0)
             lv_table_set_cell_value(objects.statistics_table, row, 0, buf);
-            sprintf(buf, "%d", it2.tel);
-            lv_table_set_cell_value(objects.statistics_table, row, 1, buf);
-            sprintf(buf, "%d", it2.pos);
-            lv_table_set_cell_value(objects.statistics_table, row, 2, buf);
-            sprintf(buf, "%d", it2.inf);
-            lv_table_set_cell_value(objects.statistics_table, row, 3, buf);
-            sprintf(buf, "%d", it2.trc);
-            lv_table_set_cell_value(objects.statistics_table, row, 4, buf);
-            sprintf(buf, "%d", it2.nbr);
-            lv_table_set_cell_value(objects.statistics_table, row, 5, buf);
-            sprintf(buf, "%d", it2.sum);
-            lv_table_set_cell_value(objects.statistics_table, row, 6, buf);
-
-            if (row != it2.row) {
-                it2.row = row;
-                move = true;
-            } else {
-                break;
+        static const PacketStats::Counter column[] = {PacketStats::eTelemetry,  PacketStats::ePosition,
+                                                      PacketStats::eNodeInfo,   PacketStats::eTraceRoute,
+                                                      PacketStats::eNeighborInfo};
+        for (int j = 0; j < 5; j++) {
+            if (shown.num != node.num || shown.count[column[j]] != node.count[column[j]]) {
+                lv_snprintf(buf, sizeof(buf), "%d", node.count[column[j]]);
+                lv_table_set_cell_value(objects.statistics_table, row, j + 1, buf);
             }
         }
-        row++;
-        if (row >= statisticTableRows) // fill rows till bottom of display
-            break;
+        if (shown.num != node.num || shown.sum != node.sum) {
+            lv_snprintf(buf, sizeof(buf), "%d", node.sum);
+            lv_table_set_cell_value(objects.statistics_table, row, 6, buf);
+        }
+        shown = node;
     }
 }
 
@@ -954,38 +961,172 @@ bool TFTView_Common::restoreFullConfig(void)
 void TFTView_Common::addNode(uint32_t nodeNum, uint8_t ch, const char *userShort, const char *userLong, uint32_t lastHeard,
                              eRole role, bool hasKey, bool unmessagable)
 {
-    // lv_obj nodesPanel children  |  user data (4 bytes)
-    // ==================================================
-    // [0]: img                    | role
-    // [1]: btn                    | ll group
-    // [2]: lbl user long          | nodeNum
-    // [3]: lbl user short         | userShort (4 chars)
-    // [4]: lbl battery            | hasKey
-    // [5]: lbl lastHeard          | lastHeard / curtime
-    // [6]: lbl signal (or hops)   | hops away
-    // [7]: lbl position 1         | lat
-    // [8]: lbl position 2         | lon
-    // [9]: lbl telemetry 1        |
-    // [10]: lbl telemetry 2       | iaq
-    // panel user_data: ch
-
+    // all node data (names, channel, role, key, last heard, hops, position) is held in nodeDB, the texts
+    // of the node panel in nodes; the panels are only created for the visible rows of nodeList
     ILOG_DEBUG("addNode(%d): num=0x%08x, lastseen=%d, name=%s(%s), role=%d", nodeCount, nodeNum, lastHeard, userLong, userShort,
                role);
-    while (nodeCount >= MAX_NUM_NODES_VIEW) {
-        purgeNode(nodeNum);
+
+    // TODO: devices without actual time will report all nodes as lastseen = now
+    if (lastHeard)
+        lastHeard = std::min(THIS->curtime, (time_t)lastHeard); // adapt values too large
+
+    if (!THIS->nodes.contains(nodeNum)) {
+        while (THIS->nodes.size() >= MAX_NUM_NODES_VIEW) {
+            if (!purgeNode(nodeNum))
+                break;
+        }
     }
 
-    lv_obj_t *p = lv_obj_create(objects.nodes_panel);
-    lv_ll_t *lv_group_ll = &lv_group_get_default()->obj_ll;
+    uint32_t slot = THIS->nodeDB.add(nodeNum);
+    THIS->nodeDB.setChannel(slot, ch);
+    THIS->nodeDB.setRole(slot, role);
+    THIS->nodeDB.setFlag(slot, NodeDB::eHasKey, hasKey);
+    THIS->nodeDB.setFlag(slot, NodeDB::eUnmessagable, unmessagable);
+    THIS->nodeDB.setLastHeard(slot, lastHeard);
+
+    // if short name contains only non-printable glyphs replace with short id
+    char shortId[5];
+    if (lv_txt_get_width(userShort, strlen(userShort), &ui_font_montserrat_14, 0) <= 4) {
+        lv_snprintf(shortId, sizeof(shortId), "%04x", nodeNum & 0xffff);
+        userShort = shortId;
+    }
+    // keep a copy of the (4-byte) short name for use in many other widgets
+    setShortName(nodeNum, userShort, userLong);
+
+    if (THIS->nodes.add(nodeNum, lastHeard)) {
+        THIS->nodeCount++;
+        THIS->nodeRowsChanged = true;
+    }
+    if (nodeNum != THIS->ownNode)
+        THIS->nodeEviction.add(nodeNum, lastHeard, role == eRole::unknown, THIS->chats.find(nodeNum) != THIS->chats.end());
+
+    if (!THIS->nodesChanged) {
+        applyNodesFilter(nodeNum);
+        updateNodesStatus();
+    }
+}
+
+void TFTView_Common::addOrUpdateNode(uint32_t nodeNum, uint8_t channel, uint32_t lastHeard, const meshtastic_User &cfg)
+{
+    if (!THIS->nodes.contains(nodeNum)) {
+        addNode(nodeNum, channel, cfg.short_name, cfg.long_name, lastHeard, (MeshtasticView::eRole)cfg.role,
+                cfg.public_key.size != 0, cfg.has_is_unmessagable && cfg.is_unmessagable);
+    } else {
+        updateNode(nodeNum, channel, cfg);
+    }
+}
+
+void TFTView_Common::updateNode(uint32_t nodeNum, uint8_t ch, const meshtastic_User &cfg)
+{
+    THIS->db.user = cfg;
+    if (THIS->nodes.contains(nodeNum)) {
+        if (nodeNum == THIS->ownNode) {
+            // update related settings buttons and store role in image user data
+            THIS->bindLabel(objects.basic_settings_user_label, _("User name: %s"), cfg.short_name);
+
+            lv_dropdown_set_selected(objects.settings_device_role_dropdown,
+                                     THIS->role2val(meshtastic_Config_DeviceConfig_Role(cfg.role)));
+            THIS->bindOptionLabel(objects.basic_settings_role_label, _("Device Role: %s"), objects.settings_device_role_dropdown);
+
+            // update DB
+            strcpy(THIS->db.short_name, cfg.short_name);
+            strcpy(THIS->db.long_name, cfg.long_name);
+            THIS->db.config.device.role = cfg.role;
+        }
+        THIS->setShortName(nodeNum, cfg.short_name, cfg.long_name);
+
+        uint32_t slot = THIS->nodeDB.add(nodeNum);
+        THIS->nodeDB.setChannel(slot, ch);
+        THIS->nodeDB.setRole(slot, cfg.role);
+        THIS->nodeDB.setFlag(slot, NodeDB::eHasKey, cfg.public_key.size != 0);
+        THIS->nodeDB.setFlag(slot, NodeDB::eUnmessagable, cfg.has_is_unmessagable && cfg.is_unmessagable);
+        THIS->nodeEviction.setUnknown(nodeNum, (MeshtasticView::eRole)cfg.role == eRole::unknown);
+
+        // update chat name
+        auto ct = THIS->chats.find(nodeNum);
+        if (ct != THIS->chats.end()) {
+            char buf[64];
+            lv_snprintf(buf, sizeof(buf), "%s: %s", cfg.short_name, cfg.long_name);
+            lv_label_set_text(ct->second->spec_attr->children[0], buf);
+        }
+        THIS->refreshNode(nodeNum);
+    }
+}
+
+/**
+ * remove a node from the node list together with everything kept for it (the own node stays)
+ */
+void TFTView_Common::removeNode(uint32_t nodeNum)
+{
+    if (nodeNum == THIS->ownNode || !THIS->nodes.contains(nodeNum))
+        return;
+
+    THIS->removeFromMap(nodeNum);
+    THIS->nodes.remove(nodeNum);
+    THIS->nodeDB.remove(nodeNum);
+    THIS->nodeFilter.remove(nodeNum);
+    THIS->distances.remove(nodeNum);
+    THIS->nodeUpdates.remove(nodeNum);
+    THIS->nodeEviction.remove(nodeNum);
+    if (currentNode == nodeNum)
+        currentNode = 0;
+    THIS->nodeCount--;
+    THIS->nodeRowsChanged = true;
+}
 
-    p->user_data = (void *)(uint32_t)ch;
-    THIS->nodes[nodeNum] = p;
-    THIS->nodeCount++;
+/**
+ * make room for nodeNum in the full node list: remove the node nodeEviction selects (the own
+ * node is not part of it), returns false if there is none that can be removed
+ */
+bool TFTView_Common::purgeNode(uint32_t nodeNum)
+{
+#ifndef ALWAYS_PURGE_OLDEST_NODE
+    time_t curr_time;
+#ifdef ARCH_PORTDUINO
+    time(&curr_time);
+#else
+    curr_time = THIS->actTime;
+#endif
+    // prefer purging older unknown nodes first (but not the brand new ones), keep chat partners
+    uint32_t oldest = THIS->nodeEviction.victim(curr_time, nodeNum);
+#else
+    uint32_t oldest = THIS->nodeEviction.oldest(nodeNum);
+#endif
+    if (oldest == NodeEviction::c_none || !THIS->nodes.contains(oldest)) {
+        ILOG_ERROR("purgeNode: no node to remove");
+        return false;
+    }
+    ILOG_INFO("removing oldest node 0x%08x", oldest);
+    removeNode(oldest);
+    return true;
+}
+
+/**
+ * panel of the node list, the pool has only as many panels as fit into the nodes panel
+ */
+lv_obj_t *TFTView_Common::createNodePanel(lv_obj_t *parent)
+{
+    // lv_obj nodesPanel children  |  user data (4 bytes)
+    // ==================================================
+    // panel                       | nodeNum (bound)
+    // [0]: img                    |
+    // [1]: btn                    | ll group
+    // [2]: lbl user long          |
+    // [3]: lbl user short         |
+    // [4]: lbl battery            |
+    // [5]: lbl lastHeard          |
+    // [6]: lbl signal (or hops)   |
+    // [7]: lbl position 1         |
+    // [8]: lbl position 2         |
+    // [9]: lbl telemetry 1        |
+    // [10]: lbl telemetry 2       |
+    lv_obj_t *p = lv_obj_create(parent);
+    lv_ll_t *lv_group_ll = &lv_group_get_default()->obj_ll;
 
     // NodePanel
-    lv_obj_set_pos(p, LV_PCT(0), 0);
-    lv_obj_set_size(p, LV_PCT(100), 53);
-    lv_obj_set_align(p, LV_ALIGN_CENTER);
+    lv_obj_set_pos(p, 0, 0);
+    lv_obj_set_size(p, LV_PCT(100), c_nodePanelHeight);
+    lv_obj_set_align(p, LV_ALIGN_TOP_MID);
     lv_obj_set_style_pad_top(p, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_set_style_pad_bottom(p, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_remove_flag(p, lv_obj_flag_t(LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_PRESS_LOCK | LV_OBJ_FLAG_CLICK_FOCUSABLE |
@@ -994,7 +1135,6 @@ void TFTView_Common::addNode(uint32_t nodeNum, uint8_t ch, const char *userShort
 
     // NodeImage
     lv_obj_t *img = lv_img_create(p);
-    setNodeImage(nodeNum, role, unmessagable, img);
     lv_obj_set_pos(img, -5, 3);
     lv_obj_set_size(img, 32, 32);
     lv_obj_clear_flag(img, LV_OBJ_FLAG_SCROLLABLE);
@@ -1002,15 +1142,6 @@ void TFTView_Common::addNode(uint32_t nodeNum, uint8_t ch, const char *userShort
     lv_obj_set_style_bg_opa(img, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_set_style_border_opa(img, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_set_style_border_width(img, 2, LV_PART_MAIN | LV_STATE_DEFAULT);
-    if (!hasKey) {
-        lv_obj_set_style_border_color(img, colorRed, LV_PART_MAIN | LV_STATE_DEFAULT);
-    }
-    if (unmessagable) {
-        // node role icon is not clickable and replaced with a cancelled icon
-        img->user_data = (void *)eRole::unmessagable;
-    } else {
-        img->user_data = (void *)role;
-    }
 
     // NodeButton
     lv_obj_t *nodeButton = lv_btn_create(p);
@@ -1033,8 +1164,7 @@ void TFTView_Common::addNode(uint32_t nodeNum, uint8_t ch, const char *userShort
     lv_obj_set_pos(ln_lbl, -5, 35);
     lv_obj_set_size(ln_lbl, LV_PCT(80), LV_SIZE_CONTENT);
     lv_label_set_long_mode(ln_lbl, LV_LABEL_LONG_SCROLL);
-    lv_label_set_text(ln_lbl, userLong);
-    ln_lbl->user_data = (void *)nodeNum;
+    lv_label_set_text(ln_lbl, "");
     lv_obj_set_style_align(ln_lbl, LV_ALIGN_TOP_LEFT, LV_PART_MAIN | LV_STATE_DEFAULT);
 
     // UserNameShortLabel
@@ -1042,30 +1172,9 @@ void TFTView_Common::addNode(uint32_t nodeNum, uint8_t ch, const char *userShort
     lv_obj_set_pos(sn_lbl, 30, 10);
     lv_obj_set_size(sn_lbl, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
     lv_label_set_long_mode(sn_lbl, LV_LABEL_LONG_WRAP);
+    lv_label_set_text(sn_lbl, "");
     lv_obj_set_style_align(sn_lbl, LV_ALIGN_TOP_LEFT, LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_set_style_text_font(sn_lbl, &ui_font_montserrat_14, LV_PART_MAIN | LV_STATE_DEFAULT);
-    // if short name contains only non-printable glyphs replace with short id
-    if (lv_txt_get_width(userShort, strlen(userShort), &ui_font_montserrat_14, 0) <= 4) {
-        lv_label_set_text_fmt(sn_lbl, "%04x", nodeNum & 0xffff);
-    } else {
-        lv_label_set_text(sn_lbl, userShort);
-    }
-    char *modUserShort = lv_label_get_text(sn_lbl);
-
-    // keep a copy of the (4-byte) short name for use in many other widgets
-    char *userData = (char *)&(sn_lbl->user_data);
-    userData[0] = modUserShort[0];
-    if (userData[0] == 0x00)
-        userData[0] = ' ';
-    userData[1] = modUserShort[1];
-    if (userData[1] == 0x00)
-        userData[1] = ' ';
-    userData[2] = modUserShort[2];
-    if (userData[2] == 0x00)
-        userData[2] = ' ';
-    userData[3] = modUserShort[3];
-    if (userData[3] == 0x00)
-        userData[3] = ' ';
 
     //  BatteryLabel
     lv_obj_t *ui_BatteryLabel = lv_label_create(p);
@@ -1074,27 +1183,14 @@ void TFTView_Common::addNode(uint32_t nodeNum, uint8_t ch, const char *userShort
     lv_obj_set_align(ui_BatteryLabel, LV_ALIGN_TOP_RIGHT);
     lv_label_set_text(ui_BatteryLabel, "");
     lv_obj_set_style_text_align(ui_BatteryLabel, LV_TEXT_ALIGN_RIGHT, LV_PART_MAIN | LV_STATE_DEFAULT);
-    ui_BatteryLabel->user_data = (void *)hasKey;
     // LastHeardLabel
     lv_obj_t *ui_lastHeardLabel = lv_label_create(p);
     lv_obj_set_pos(ui_lastHeardLabel, 8, 33);
     lv_obj_set_size(ui_lastHeardLabel, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
     lv_obj_set_style_align(ui_lastHeardLabel, LV_ALIGN_TOP_RIGHT, LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_label_set_long_mode(ui_lastHeardLabel, LV_LABEL_LONG_CLIP);
-
-    // TODO: devices without actual time will report all nodes as lastseen = now
-    if (lastHeard) {
-        lastHeard = std::min(THIS->curtime, (time_t)lastHeard); // adapt values too large
-
-        char buf[20];
-        THIS->lastHeardToString(lastHeard, buf);
-        lv_label_set_text(ui_lastHeardLabel, buf);
-    } else {
-        lv_label_set_text(ui_lastHeardLabel, "");
-    }
-
+    lv_label_set_text(ui_lastHeardLabel, "");
     lv_obj_set_style_text_align(ui_lastHeardLabel, LV_TEXT_ALIGN_RIGHT, LV_PART_MAIN | LV_STATE_DEFAULT);
-    ui_lastHeardLabel->user_data = (void *)lastHeard;
     // SignalLabel / hopsAway
     lv_obj_t *ui_SignalLabel = lv_label_create(p);
     lv_obj_set_width(ui_SignalLabel, LV_SIZE_CONTENT);
@@ -1102,8 +1198,7 @@ void TFTView_Common::addNode(uint32_t nodeNum, uint8_t ch, const char *userShort
     lv_obj_set_pos(ui_SignalLabel, 8, 1);
     lv_obj_set_align(ui_SignalLabel, LV_ALIGN_TOP_RIGHT);
     lv_label_set_text(ui_SignalLabel, "");
-    ui_SignalLabel->user_data = (void *)-1; // TODO viaMqtt; // used for filtering (applyNodesFilter)
-    // PositionLabel
+    // PositionLabel, opens the map if the node has a location
     lv_obj_t *ui_PositionLabel = lv_label_create(p);
     lv_obj_set_pos(ui_PositionLabel, -5, 49);
     lv_obj_set_size(ui_PositionLabel, 120, LV_SIZE_CONTENT);
@@ -1111,7 +1206,7 @@ void TFTView_Common::addNode(uint32_t nodeNum, uint8_t ch, const char *userShort
     lv_label_set_text(ui_PositionLabel, "");
     lv_obj_set_style_align(ui_PositionLabel, LV_ALIGN_TOP_LEFT, LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_set_style_text_color(ui_PositionLabel, colorBlueGreen, LV_PART_MAIN | LV_STATE_DEFAULT);
-    ui_PositionLabel->user_data = 0; // store latitude
+    lv_obj_add_event_cb(ui_PositionLabel, ui_event_positionButton, LV_EVENT_CLICKED, NULL);
     // Position2Label
     lv_obj_t *ui_Position2Label = lv_label_create(p);
     lv_obj_set_pos(ui_Position2Label, -5, 63);
@@ -1119,7 +1214,6 @@ void TFTView_Common::addNode(uint32_t nodeNum, uint8_t ch, const char *userShort
     lv_label_set_long_mode(ui_Position2Label, LV_LABEL_LONG_SCROLL);
     lv_label_set_text(ui_Position2Label, "");
     lv_obj_set_style_align(ui_Position2Label, LV_ALIGN_TOP_LEFT, LV_PART_MAIN | LV_STATE_DEFAULT);
-    ui_Position2Label->user_data = 0; // store longitude
     // Telemetry1Label
     lv_obj_t *ui_Telemetry1Label = lv_label_create(p);
     lv_obj_set_pos(ui_Telemetry1Label, 8, 49);
@@ -1137,273 +1231,284 @@ void TFTView_Common::addNode(uint32_t nodeNum, uint8_t ch, const char *userShort
     lv_obj_set_style_align(ui_Telemetry2Label, LV_ALIGN_TOP_RIGHT, LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_set_style_text_align(ui_Telemetry2Label, LV_TEXT_ALIGN_RIGHT, LV_PART_MAIN | LV_STATE_DEFAULT);
 
-    // virtual hook for view-specific customization (e.g. 320x240 hides extended labels)
+    // virtual hook for view-specific customization
     THIS->onAddNodeExtra(p);
 
-    lv_obj_add_event_cb(nodeButton, ui_event_NodeButton, LV_EVENT_ALL, (void *)nodeNum);
-
-    // move node into new position within nodePanel
-    if (lastHeard) {
-        lv_obj_t **children = objects.nodes_panel->spec_attr->children;
-        int i = objects.nodes_panel->spec_attr->child_cnt - 1;
-        while (i > 1) {
-            if (lastHeard <= (time_t)(children[i - 1]->LV_OBJ_IDX(node_lh_idx)->user_data))
-                break;
-            i--;
-        }
-        if (i >= 1 && i < objects.nodes_panel->spec_attr->child_cnt - 1) {
-            lv_obj_move_to_index(p, i);
-            // re-arrange the group linked list by moving the new button (now at the tail) into the right position
-            void *after = children[i + 1]->LV_OBJ_IDX(node_btn_idx)->user_data;
-            _lv_ll_move_before(lv_group_ll, nodeButton->user_data, after);
-        }
-    }
-
-    if (!THIS->nodesChanged) {
-        applyNodesFilter(nodeNum);
-        updateNodesStatus();
-    }
+    lv_obj_add_event_cb(nodeButton, ui_event_NodeButton, LV_EVENT_ALL, NULL);
+    return p;
 }
 
-void TFTView_Common::addOrUpdateNode(uint32_t nodeNum, uint8_t channel, uint32_t lastHeard, const meshtastic_User &cfg)
+void TFTView_Common::bindNodePanel(lv_obj_t *panel, uint32_t index)
 {
-    if (THIS->nodes.find(nodeNum) == THIS->nodes.end()) {
-        addNode(nodeNum, channel, cfg.short_name, cfg.long_name, lastHeard, (MeshtasticView::eRole)cfg.role,
-                cfg.public_key.size != 0, cfg.has_is_unmessagable && cfg.is_unmessagable);
-    } else {
-        updateNode(nodeNum, channel, cfg);
-    }
+    uint32_t nodeNum = THIS->nodes.nodeAt(index);
+    panel->user_data = (void *)(unsigned long)nodeNum;
+    // a recycled panel may still be expanding for the node it showed before
+    lv_anim_delete(panel, ui_anim_node_panel_cb);
+    bool expanded = index == THIS->nodeList->expanded();
+    lv_obj_set_height(panel, expanded ? c_nodePanelHeight + c_nodePanelDetails : c_nodePanelHeight);
+    THIS->bindNode(panel, nodeNum);
+    THIS->orderNodeButtons();
 }
 
-void TFTView_Common::updateNode(uint32_t nodeNum, uint8_t ch, const meshtastic_User &cfg)
+/**
+ * fill a node panel from nodeDB and the texts kept in nodes, empty labels are hidden
+ */
+void TFTView_Common::bindNode(lv_obj_t *panel, uint32_t nodeNum)
 {
-    THIS->db.user = cfg;
-    auto it = THIS->nodes.find(nodeNum);
-    if (it != THIS->nodes.end() && it->second) {
-        if (it->first == THIS->ownNode) {
-            // update related settings buttons and store role in image user data
-            char buf[30];
-            lv_snprintf(buf, sizeof(buf), _("User name: %s"), cfg.short_name);
-            lv_label_set_text(objects.basic_settings_user_label, buf);
+    uint32_t slot = nodeDB.find(nodeNum);
+    if (slot == NodeDB::c_noSlot)
+        return;
 
-            char buf1[30], buf2[40];
-            lv_dropdown_set_selected(objects.settings_device_role_dropdown,
-                                     THIS->role2val(meshtastic_Config_DeviceConfig_Role(cfg.role)));
-            lv_dropdown_get_selected_str(objects.settings_device_role_dropdown, buf1, sizeof(buf1));
-            lv_snprintf(buf2, sizeof(buf2), _("Device Role: %s"), buf1);
-            lv_label_set_text(objects.basic_settings_role_label, buf2);
+    auto setText = [panel](uint32_t idx, const char *text) {
+        lv_obj_t *label = panel->LV_OBJ_IDX(idx);
+        setLabelText(label, text);
+        if (text[0] != '\0')
+            lv_obj_remove_flag(label, LV_OBJ_FLAG_HIDDEN);
+        else
+            lv_obj_add_flag(label, LV_OBJ_FLAG_HIDDEN);
+    };
 
-            // update DB
-            strcpy(THIS->db.short_name, cfg.short_name);
-            strcpy(THIS->db.long_name, cfg.long_name);
-            THIS->db.config.device.role = cfg.role;
-        }
-        lv_label_set_text(it->second->LV_OBJ_IDX(node_lbl_idx), cfg.long_name);
-        it->second->LV_OBJ_IDX(node_lbl_idx)->user_data = (void *)nodeNum;
-        lv_label_set_text(it->second->LV_OBJ_IDX(node_lbs_idx), cfg.short_name);
-        char *userData = (char *)&(it->second->LV_OBJ_IDX(node_lbs_idx)->user_data);
-        userData[0] = cfg.short_name[0];
-        if (userData[0] == 0x00)
-            userData[0] = ' ';
-        userData[1] = cfg.short_name[1];
-        if (userData[1] == 0x00)
-            userData[1] = ' ';
-        userData[2] = cfg.short_name[2];
-        if (userData[2] == 0x00)
-            userData[2] = ' ';
-        userData[3] = cfg.short_name[3];
-        if (userData[3] == 0x00)
-            userData[3] = ' ';
-
-        setNodeImage(nodeNum, (MeshtasticView::eRole)cfg.role, cfg.has_is_unmessagable && cfg.is_unmessagable,
-                     it->second->LV_OBJ_IDX(node_img_idx));
-
-        if (cfg.public_key.size != 0) {
-            // set border color to bg color
-            lv_color_t color = lv_obj_get_style_bg_color(it->second->LV_OBJ_IDX(node_img_idx), LV_PART_MAIN | LV_STATE_DEFAULT);
-            lv_obj_set_style_border_color(it->second->LV_OBJ_IDX(node_img_idx), color, LV_PART_MAIN | LV_STATE_DEFAULT);
-        } else {
-            lv_obj_set_style_border_color(it->second->LV_OBJ_IDX(node_img_idx), colorRed, LV_PART_MAIN | LV_STATE_DEFAULT);
-        }
+    lv_obj_t *img = panel->LV_OBJ_IDX(node_img_idx);
+    setNodeImage(nodeNum, (eRole)nodeDB.role(slot), nodeDB.hasFlag(slot, NodeDB::eUnmessagable), img);
+    if (!nodeDB.hasFlag(slot, NodeDB::eHasKey) || nodeDB.hasFlag(slot, NodeDB::eKeyMismatch))
+        lv_obj_set_style_border_color(img, colorRed, LV_PART_MAIN | LV_STATE_DEFAULT);
 
-        // update chat name
-        auto ct = THIS->chats.find(it->first);
-        if (ct != THIS->chats.end()) {
-            char buf[64];
-            lv_snprintf(buf, sizeof(buf), "%s: %s", lv_label_get_text(it->second->LV_OBJ_IDX(node_lbs_idx)),
-                        lv_label_get_text(it->second->LV_OBJ_IDX(node_lbl_idx)));
-            lv_label_set_text(ct->second->spec_attr->children[0], buf);
-        }
+    setLabelText(panel->LV_OBJ_IDX(node_lbl_idx), nodeDB.longName(slot));
+
+    // the distance is added to the short name label, so re-arrange a bit the position
+    char buf[40];
+    const char *distance = nodes.text(nodeNum, NodeList::eDistance);
+    lv_obj_t *shortLabel = panel->LV_OBJ_IDX(node_lbs_idx);
+    if (distance[0] != '\0') {
+        lv_snprintf(buf, sizeof(buf), "%.4s\n%s ", nodeDB.shortName(slot), distance);
+        setLabelText(shortLabel, buf);
+        lv_obj_set_pos(shortLabel, 30, -1);
+    } else {
+        setLabelText(shortLabel, nodeDB.shortName(slot));
+        lv_obj_set_pos(shortLabel, 30, 10);
     }
+
+    buf[0] = '\0';
+    if (nodeDB.lastHeard(slot))
+        lastHeardToString(nodeDB.lastHeard(slot), buf);
+    setLabelText(panel->LV_OBJ_IDX(node_lh_idx), buf);
+
+    setText(node_bat_idx, nodes.text(nodeNum, NodeList::eBattery));
+    setText(node_sig_idx, nodes.text(nodeNum, NodeList::eSignal));
+    setText(node_pos1_idx, nodes.text(nodeNum, NodeList::ePosition1));
+    setText(node_pos2_idx, nodes.text(nodeNum, NodeList::ePosition2));
+    setText(node_tm1_idx, nodes.text(nodeNum, NodeList::eTelemetry1));
+    setText(node_tm2_idx, nodes.text(nodeNum, NodeList::eTelemetry2));
+
+    if (nodeObjects.find(nodeNum) != nodeObjects.end())
+        lv_obj_add_flag(panel->LV_OBJ_IDX(node_pos1_idx), LV_OBJ_FLAG_CLICKABLE);
+    else
+        lv_obj_remove_flag(panel->LV_OBJ_IDX(node_pos1_idx), LV_OBJ_FLAG_CLICKABLE);
+
+    highlightNode(nodeNum, panel);
 }
 
-void TFTView_Common::removeNode(uint32_t nodeNum)
+/**
+ * rebind the panel showing a node, if the node is within the visible rows
+ */
+void TFTView_Common::refreshNode(uint32_t nodeNum)
 {
-    auto it = THIS->nodes.find(nodeNum);
-    if (it != THIS->nodes.end()) {
+    if (!nodeList)
+        return;
+    for (uint32_t index = nodeList->first(); index < nodeList->last(); index++) {
+        lv_obj_t *panel = nodeList->rowOf(index);
+        if (panel && (unsigned long)panel->user_data == nodeNum) {
+            nodeList->refresh(index);
+            return;
+        }
     }
 }
 
-void TFTView_Common::purgeNode(uint32_t nodeNum)
+/**
+ * rebind the node list after the order or the visibility of the nodes changed, the selected node stays expanded
+ */
+void TFTView_Common::updateNodeList(void)
 {
-    if (THIS->nodeCount <= 1)
+    nodeRowsChanged = false;
+    if (!nodeList)
         return;
+    nodeList->setCount(nodes.rows());
+    uint32_t index = currentNode ? nodes.rowOf(currentNode) : NodeList::c_none;
+    if (index != nodeList->expanded())
+        nodeList->setExpanded(index == NodeList::c_none ? RowWindow::c_none : index, c_nodePanelDetails);
+}
 
-    lv_obj_t **children = objects.nodes_panel->spec_attr->children;
-    int last = objects.nodes_panel->spec_attr->child_cnt - 1;
-    int i = last;
+/**
+ * keep the buttons of the visible rows in list order within the input group, right after topNodeLL
+ */
+void TFTView_Common::orderNodeButtons(void)
+{
+    lv_group_t *group = lv_group_get_default();
+    if (!group || !topNodeLL)
+        return;
+    lv_ll_t *lv_group_ll = &group->obj_ll;
+    void *prev = topNodeLL;
+    for (uint32_t index = nodeList->first(); index < nodeList->last(); index++) {
+        lv_obj_t *panel = nodeList->rowOf(index);
+        if (!panel)
+            continue;
+        void *act = panel->LV_OBJ_IDX(node_btn_idx)->user_data;
+        void *next = _lv_ll_get_next(lv_group_ll, prev);
+        if (act != next)
+            _lv_ll_move_before(lv_group_ll, act, next);
+        prev = act;
+    }
+}
 
-#ifndef ALWAYS_PURGE_OLDEST_NODE
-    time_t curr_time;
-#ifdef ARCH_PORTDUINO
-    time(&curr_time);
-#else
-    curr_time = THIS->actTime;
-#endif
-    // prefer purging older unknown nodes first (but not the brand new ones)
-    while ((eRole)(long)(children[i]->LV_OBJ_IDX(node_img_idx)->user_data) != eRole::unknown ||
-           curr_time < (time_t)(children[i]->LV_OBJ_IDX(node_lh_idx)->user_data) + 120 ||
-           (unsigned long)(children[i]->LV_OBJ_IDX(node_lbl_idx)->user_data) == nodeNum ||
-           THIS->chats.find((unsigned long)(children[i]->LV_OBJ_IDX(node_lbl_idx)->user_data)) != THIS->chats.end()) {
-        if (i < (last + 1) / 5) { // keep 80% named nodes and 20% unknown (not fresh) nodes
-            i = last;
-            break;
+/**
+ * expand the panel of a node to show its position and telemetry, or collapse it if it is already expanded
+ */
+void TFTView_Common::selectNode(uint32_t nodeNum)
+{
+    uint32_t index = nodes.rowOf(nodeNum);
+    if (nodeNum == currentNode || index == NodeList::c_none) {
+        nodeList->setExpanded(RowWindow::c_none, 0);
+        currentNode = 0;
+    } else {
+        // the rows below move down at once, the panel grows into the gap
+        nodeList->setExpanded(index, c_nodePanelDetails);
+        lv_obj_t *panel = nodeList->rowOf(index);
+        if (panel) {
+            static lv_anim_t a;
+            lv_anim_init(&a);
+            lv_anim_set_var(&a, panel);
+            lv_anim_set_values(&a, c_nodePanelHeight, c_nodePanelHeight + c_nodePanelDetails);
+            lv_anim_set_duration(&a, 200);
+            lv_anim_set_exec_cb(&a, ui_anim_node_panel_cb);
+            lv_anim_set_path_cb(&a, lv_anim_path_linear);
+            lv_anim_start(&a);
         }
-        i--;
+        nodeList->scrollToIndex(index, LV_ANIM_ON);
+        currentNode = nodeNum;
     }
-#endif
-    lv_obj_t *p = children[i];
-    uint32_t oldest = (unsigned long)(p->LV_OBJ_IDX(node_lbl_idx)->user_data);
-    uint32_t lastHeard = (unsigned long)p->LV_OBJ_IDX(node_lh_idx)->user_data;
-    ILOG_INFO("removing oldest node 0x%08x", oldest);
-    lv_obj_delete(p);
-    {
-        auto it = THIS->messages.find(oldest);
-        if (it != THIS->messages.end()) {
-            lv_obj_delete(it->second);
-            THIS->messages.erase(oldest);
-        }
+    if (chooseNodeSignalScanner) {
+        chooseNodeSignalScanner = false;
+        ui_event_signal_scanner(NULL);
+        // restore previous filter
+        lv_dropdown_set_selected(objects.nodes_filter_hops_dropdown, selectedHops);
+        updateNodesFiltered(true);
+        updateNodesStatus();
+    } else if (chooseNodeTraceRoute) {
+        chooseNodeTraceRoute = false;
+        ui_event_trace_route(NULL);
     }
+}
 
-    {
-        auto it = THIS->chats.find(oldest);
-        if (it != THIS->chats.end()) {
-            lv_obj_delete(it->second);
-            THIS->chats.erase(oldest);
-            updateActiveChats();
-        }
-    }
-    THIS->removeFromMap(oldest);
-    THIS->nodes.erase(oldest);
-    THIS->nodeCount--;
-    THIS->nodesChanged = true; // flag to force re-apply node filter
+/**
+ * show the node list scrolled to a node
+ */
+void TFTView_Common::scrollToNode(uint32_t nodeNum)
+{
+    ui_set_active(objects.nodes_button, objects.nodes_panel, objects.top_nodes_panel);
+    uint32_t index = nodes.rowOf(nodeNum);
+    if (index != NodeList::c_none)
+        nodeList->scrollToIndex(index, LV_ANIM_ON);
 }
 
-bool TFTView_Common::applyNodesFilter(uint32_t nodeNum, bool reset)
+bool TFTView_Common::applyNodesFilter(uint32_t nodeNum)
 {
-    lv_obj_t *panel = THIS->nodes[nodeNum];
+    uint32_t slot = THIS->nodeDB.find(nodeNum);
     bool hide = false;
-    if (nodeNum != THIS->ownNode /* && filter.active*/) { // TODO
-        if (lv_obj_has_state(objects.nodes_filter_unknown_switch, LV_STATE_CHECKED)) {
-            if (lv_img_get_src(panel->LV_OBJ_IDX(node_img_idx)) == &img_circle_question_image) {
-                hide = true;
-            }
-        }
-        if (lv_obj_has_state(objects.nodes_filter_offline_switch, LV_STATE_CHECKED)) {
-            time_t lastHeard = (time_t)panel->LV_OBJ_IDX(node_lh_idx)->user_data;
-            if (lastHeard == 0 || THIS->curtime - lastHeard > THIS->secs_until_offline)
-                hide = true;
-        }
-        if (lv_obj_has_state(objects.nodes_filter_public_key_switch, LV_STATE_CHECKED)) {
-            bool hasKey = (unsigned long)panel->LV_OBJ_IDX(node_bat_idx)->user_data == 1;
-            if (!hasKey)
-                hide = true;
-        }
-        if (lv_dropdown_get_selected(objects.nodes_filter_channel_dropdown) != 0) {
-            int selected = lv_dropdown_get_selected(objects.nodes_filter_channel_dropdown);
-            if (selected != 0) {
-                uint8_t ch = (uint8_t)(unsigned long)panel->user_data;
-                if (selected - 1 != ch)
-                    hide = true;
-            }
-        }
-        if (lv_dropdown_get_selected(objects.nodes_filter_hops_dropdown) != 0) {
-            int32_t hopsAway = (signed long)panel->LV_OBJ_IDX(node_sig_idx)->user_data;
-            int selected = lv_dropdown_get_selected(objects.nodes_filter_hops_dropdown) - 7;
-            if (hopsAway < 0)
-                hide = true;
-            else if (selected <= 0) {
-                if (hopsAway > -selected)
-                    hide = true;
-            } else {
-                if (hopsAway < selected)
-                    hide = true;
-            }
-        }
-#if 0
-        if (lv_obj_has_state(objects.nodes_filter_mqtt_switch, LV_STATE_CHECKED)) {
-            bool viaMqtt = false; // TODO (unsigned long)panel->LV_OBJ_IDX(node_sig_idx)->user_data;
-            if (viaMqtt)
-                hide = true;
-        }
-#endif
-        if (lv_obj_has_state(objects.nodes_filter_position_switch, LV_STATE_CHECKED)) {
-            if (lv_label_get_text(panel->LV_OBJ_IDX(node_pos1_idx))[0] == '\0')
-                hide = true;
-        }
-        const char *name = lv_textarea_get_text(objects.nodes_filter_name_area);
-        if (name[0] != '\0') {
-            if (name[0] != '!') { // use '!' char to negate search result
-                if (!strcasestr(lv_label_get_text(panel->LV_OBJ_IDX(node_lbl_idx)), name) &&
-                    !strcasestr(lv_label_get_text(panel->LV_OBJ_IDX(node_lbs_idx)), name)) {
-                    hide = true;
-                }
-            } else {
-                if (strcasestr(lv_label_get_text(panel->LV_OBJ_IDX(node_lbl_idx)), &name[1]) ||
-                    strcasestr(lv_label_get_text(panel->LV_OBJ_IDX(node_lbs_idx)), &name[1])) {
-                    hide = true;
-                }
-            }
-        }
-    }
-    if (hide) {
-        if (reset || !lv_obj_has_flag(panel, LV_OBJ_FLAG_HIDDEN)) {
-            lv_obj_add_flag(panel, LV_OBJ_FLAG_HIDDEN);
-            THIS->nodesFiltered++;
-        }
-    } else {
-        lv_obj_clear_flag(panel, LV_OBJ_FLAG_HIDDEN);
+    if (nodeNum != THIS->ownNode && slot != NodeDB::c_noSlot) {
+        setNodeFilterBits(nodeNum, slot, lv_dropdown_get_selected(objects.nodes_filter_channel_dropdown),
+                          lv_dropdown_get_selected(objects.nodes_filter_hops_dropdown));
+        hide = !THIS->nodeFilter.visible(nodeNum);
     }
+    if (THIS->nodes.setVisible(nodeNum, !hide))
+        THIS->nodeRowsChanged = true;
 
     // hide node location if filtered
     if (THIS->map)
         THIS->map->update(nodeNum, hide);
 
+    // highlighting
+    THIS->refreshNode(nodeNum);
+    return hide; // TODO || filter.active;
+}
+
+/**
+ * set the filter criteria bits of a node from nodeDB and the selected channel/hops dropdown entries
+ */
+void TFTView_Common::setNodeFilterBits(uint32_t nodeNum, uint32_t slot, int channel, int hops)
+{
+    NodeFilter &filter = THIS->nodeFilter;
+    time_t lastHeard = THIS->nodeDB.lastHeard(slot);
+    uint8_t role = THIS->nodeDB.role(slot);
+    int32_t hopsAway = THIS->nodeDB.hopsAway(slot);
+    int selected = hops - 7;
+
+    filter.set(nodeNum, NodeFilter::eOnline, lastHeard != 0 && THIS->curtime - lastHeard <= THIS->secs_until_offline);
+    filter.set(nodeNum, NodeFilter::eKnownRole,
+               (role != NodeDB::c_unknownRole && role != eRole::unknown) || THIS->nodeDB.hasFlag(slot, NodeDB::eUnmessagable));
+    filter.set(nodeNum, NodeFilter::eHasKey,
+               THIS->nodeDB.hasFlag(slot, NodeDB::eHasKey) && !THIS->nodeDB.hasFlag(slot, NodeDB::eKeyMismatch));
+    filter.set(nodeNum, NodeFilter::eHasPosition, THIS->nodeDB.hasFlag(slot, NodeDB::eHasPosition));
+    filter.set(nodeNum, NodeFilter::eChannel, channel == 0 || channel - 1 == THIS->nodeDB.channel(slot));
+    filter.set(nodeNum, NodeFilter::eHops,
+               hops == 0 || (hopsAway >= 0 && (selected <= 0 ? hopsAway <= -selected : hopsAway >= selected)));
+    filter.set(nodeNum, NodeFilter::eChat, THIS->chats.find(nodeNum) != THIS->chats.end());
+}
+
+/**
+ * take over the node filter settings from the widgets and refresh the criteria bits of all nodes
+ */
+void TFTView_Common::syncNodeFilter(void)
+{
+    NodeFilter &filter = THIS->nodeFilter;
+    int channel = lv_dropdown_get_selected(objects.nodes_filter_channel_dropdown);
+    int hops = lv_dropdown_get_selected(objects.nodes_filter_hops_dropdown);
+    filter.require(NodeFilter::eKnownRole, lv_obj_has_state(objects.nodes_filter_unknown_switch, LV_STATE_CHECKED));
+    filter.require(NodeFilter::eOnline, lv_obj_has_state(objects.nodes_filter_offline_switch, LV_STATE_CHECKED));
+    filter.require(NodeFilter::eHasKey, lv_obj_has_state(objects.nodes_filter_public_key_switch, LV_STATE_CHECKED));
+    filter.require(NodeFilter::eHasPosition, lv_obj_has_state(objects.nodes_filter_position_switch, LV_STATE_CHECKED));
+    filter.require(NodeFilter::eChannel, channel != 0);
+    filter.require(NodeFilter::eHops, hops != 0);
+    filter.setQuery(lv_textarea_get_text(objects.nodes_filter_name_area));
+
+    for (uint32_t nodeNum : THIS->nodes.all()) {
+        uint32_t slot = THIS->nodeDB.find(nodeNum);
+        if (nodeNum != THIS->ownNode && slot != NodeDB::c_noSlot)
+            setNodeFilterBits(nodeNum, slot, channel, hops);
+    }
+}
+
+void TFTView_Common::highlightNode(uint32_t nodeNum, lv_obj_t *panel)
+{
+    // the panel may have shown another node before
+    lv_obj_t *tm2 = panel->LV_OBJ_IDX(node_tm2_idx);
+    lv_obj_remove_local_style_prop(tm2, LV_STYLE_TEXT_COLOR, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_bg_opa(tm2, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_border_width(panel, 1, LV_PART_MAIN | LV_STATE_DEFAULT);
+
     bool highlight = false;
     if (true /*highlight.active*/) { // TODO
         if (lv_obj_has_state(objects.nodes_hl_active_chat_switch, LV_STATE_CHECKED)) {
-            auto it = THIS->chats.find(nodeNum);
-            if (it != THIS->nodes.end()) {
+            if (THIS->chats.find(nodeNum) != THIS->chats.end()) {
                 lv_obj_set_style_border_color(panel, colorOrange, LV_PART_MAIN | LV_STATE_DEFAULT);
                 highlight = true;
             }
         }
         if (lv_obj_has_state(objects.nodes_hl_position_switch, LV_STATE_CHECKED)) {
-            if (lv_label_get_text(panel->LV_OBJ_IDX(node_pos1_idx))[0] != '\0') {
+            if (THIS->nodes.text(nodeNum, NodeList::ePosition1)[0] != '\0') {
                 lv_obj_set_style_border_color(panel, colorBlueGreen, LV_PART_MAIN | LV_STATE_DEFAULT);
                 highlight = true;
             }
         }
         if (lv_obj_has_state(objects.nodes_hl_telemetry_switch, LV_STATE_CHECKED)) {
-            if (lv_label_get_text(panel->LV_OBJ_IDX(node_tm1_idx))[0] != '\0') {
+            if (THIS->nodes.text(nodeNum, NodeList::eTelemetry1)[0] != '\0') {
                 lv_obj_set_style_border_color(panel, colorBlue, LV_PART_MAIN | LV_STATE_DEFAULT);
                 lv_obj_set_style_border_width(panel, 2, LV_PART_MAIN | LV_STATE_DEFAULT);
                 highlight = true;
             }
         }
         if (lv_obj_has_state(objects.nodes_hliaq_switch, LV_STATE_CHECKED)) {
-            if (lv_label_get_text(panel->LV_OBJ_IDX(node_tm2_idx))[0] != '\0') {
-                uint32_t iaq = (unsigned long)panel->LV_OBJ_IDX(node_tm2_idx)->user_data;
+            if (THIS->nodes.text(nodeNum, NodeList::eTelemetry2)[0] != '\0') {
+                uint32_t iaq = THIS->nodes.iaq(nodeNum);
                 // IAQ color code
                 lv_color_t fg, bg;
                 if (iaq <= 50) {
@@ -1425,18 +1530,18 @@ bool TFTView_Common::applyNodesFilter(uint32_t nodeNum, bool reset)
                     fg = lv_color_hex(0xffffffff);
                     bg = lv_color_hex(0x001d1414);
                 }
-                lv_obj_set_style_text_color(panel->LV_OBJ_IDX(node_tm2_idx), fg, LV_PART_MAIN | LV_STATE_DEFAULT);
-                lv_obj_set_style_bg_color(panel->LV_OBJ_IDX(node_tm2_idx), bg, LV_PART_MAIN | LV_STATE_DEFAULT);
-                lv_obj_set_style_bg_opa(panel->LV_OBJ_IDX(node_tm2_idx), 255, LV_PART_MAIN | LV_STATE_DEFAULT);
+                lv_obj_set_style_text_color(tm2, fg, LV_PART_MAIN | LV_STATE_DEFAULT);
+                lv_obj_set_style_bg_color(tm2, bg, LV_PART_MAIN | LV_STATE_DEFAULT);
+                lv_obj_set_style_bg_opa(tm2, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
                 lv_obj_set_style_border_color(panel, bg, LV_PART_MAIN | LV_STATE_DEFAULT);
                 lv_obj_set_style_border_width(panel, 2, LV_PART_MAIN | LV_STATE_DEFAULT);
                 highlight = true;
             }
         }
         const char *name = lv_textarea_get_text(objects.nodes_hl_name_area);
-        if (name[0] != '\0') {
-            if (strcasestr(lv_label_get_text(panel->LV_OBJ_IDX(node_lbl_idx)), name) ||
-                strcasestr(lv_label_get_text(panel->LV_OBJ_IDX(node_lbs_idx)), name)) {
+        uint32_t slot = THIS->nodeDB.find(nodeNum);
+        if (name[0] != '\0' && slot != NodeDB::c_noSlot) {
+            if (strcasestr(THIS->nodeDB.longName(slot), name) || strcasestr(THIS->nodeDB.shortName(slot), name)) {
                 lv_obj_set_style_border_color(panel, colorMesh, LV_PART_MAIN | LV_STATE_DEFAULT);
                 highlight = true;
             }
@@ -1446,7 +1551,6 @@ bool TFTView_Common::applyNodesFilter(uint32_t nodeNum, bool reset)
         lv_obj_set_style_border_color(panel, colorMidGray, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_border_width(panel, 1, LV_PART_MAIN | LV_STATE_DEFAULT);
     }
-    return hide; // TODO || filter.active;
 }
 
 void TFTView_Common::setNodeImage(uint32_t nodeNum, eRole role, bool unmessagable, lv_obj_t *img)
@@ -1500,86 +1604,90 @@ void TFTView_Common::setNodeImage(uint32_t nodeNum, eRole role, bool unmessagabl
     lv_obj_set_style_img_recolor_opa(img, fgColor ? 0 : 255, LV_PART_MAIN | LV_STATE_DEFAULT);
 }
 
+void TFTView_Common::setNodeImage(uint32_t nodeNum, lv_obj_t *img)
+{
+    uint32_t slot = THIS->nodeDB.find(nodeNum);
+    if (slot != NodeDB::c_noSlot)
+        setNodeImage(nodeNum, (eRole)THIS->nodeDB.role(slot), THIS->nodeDB.hasFlag(slot, NodeDB::eUnmessagable), img);
+    else
+        setNodeImage(nodeNum, eRole::unknown, false, img);
+}
+
+/**
+ * keep the short name (padded to 4 chars) and long name of a node in nodeDB
+ */
+void TFTView_Common::setShortName(uint32_t nodeNum, const char *userShort, const char *userLong)
+{
+    char shortName[NodeDB::c_shortNameLen] = "    ";
+    for (int i = 0; i < 4 && userShort[i] != '\0'; i++)
+        shortName[i] = userShort[i];
+    THIS->nodeDB.setNames(THIS->nodeDB.add(nodeNum), shortName, userLong);
+    THIS->nodeFilter.setKey(nodeNum, shortName, userLong);
+    THIS->distances.invalidate(nodeNum); // the short name label also shows the distance
+}
+
 void TFTView_Common::updateNodesStatus(void)
 {
-    uint16_t online = 0;
-    for (auto &it : THIS->nodes) {
-        time_t lastHeard = (time_t)it.second->LV_OBJ_IDX(node_lh_idx)->user_data;
-        if (lastHeard > 0 && THIS->curtime - lastHeard <= THIS->secs_until_offline)
-            online++;
-    }
-    THIS->nodesOnline = online;
+    THIS->nodesOnline = THIS->nodeDB.countOnline(THIS->curtime, THIS->secs_until_offline);
 
     char buf[40];
     lv_snprintf(buf, sizeof(buf), _p("%d of %d nodes online", THIS->nodeCount), THIS->nodesOnline, THIS->nodeCount);
     lv_label_set_text(objects.home_nodes_label, buf);
 
-    if (THIS->nodesFiltered)
-        lv_snprintf(buf, sizeof(buf), _("Filter: %d of %d nodes"), THIS->nodeCount - THIS->nodesFiltered, THIS->nodeCount);
+    if (THIS->nodes.hidden())
+        lv_snprintf(buf, sizeof(buf), _("Filter: %d of %d nodes"), THIS->nodeCount - THIS->nodes.hidden(), THIS->nodeCount);
     lv_label_set_text(objects.top_nodes_online_label, buf);
 }
 
 void TFTView_Common::updateNodesFiltered(bool reset)
 {
-    static auto it = THIS->nodes.begin();
     if (reset || THIS->nodesChanged) {
-        THIS->nodesFiltered = 0;
-        THIS->nodesChanged = false;
-        THIS->processingFilter = true;
-        it = THIS->nodes.begin();
-    }
-
-    for (int i = 0; i < 10 && it != THIS->nodes.end(); i++) {
-        applyNodesFilter(it->first, true);
-        it++;
-    }
-
-    if (it == THIS->nodes.end()) {
-        THIS->processingFilter = false;
+        // visibility of all nodes in one pass, the highlighting is applied when the visible rows are bound
+        syncNodeFilter();
+        THIS->nodeFilter.apply([](uint32_t nodeNum, bool visible) {
+            if (nodeNum == THIS->ownNode)
+                return;
+            THIS->nodes.setVisible(nodeNum, visible);
+            if (THIS->map)
+                THIS->map->update(nodeNum, !visible);
+        });
+        THIS->nodesChanged = false;
+        THIS->updateNodeList();
     }
     updateNodesStatus();
 }
 
 void TFTView_Common::updateLastHeard(uint32_t nodeNum)
 {
-    auto it = THIS->nodes.find(nodeNum);
-    if (it != THIS->nodes.end() && it->second) {
-        time_t lastHeard = (time_t)it->second->LV_OBJ_IDX(node_lh_idx)->user_data;
-        it->second->LV_OBJ_IDX(node_lh_idx)->user_data = (void *)THIS->curtime;
-        lv_label_set_text(it->second->LV_OBJ_IDX(node_lh_idx), _("now"));
-        if (it->first != THIS->ownNode) {
-            if (lastHeard > 0 && THIS->curtime - lastHeard >= THIS->secs_until_offline) {
-                applyNodesFilter(nodeNum);
-                updateNodesStatus();
-            }
-            // move to top position
-            lv_obj_move_to_index(it->second, 1);
+    uint32_t slot = THIS->nodeDB.find(nodeNum);
+    if (THIS->nodes.contains(nodeNum) && slot != NodeDB::c_noSlot) {
+        time_t lastHeard = THIS->nodeDB.lastHeard(slot);
+        THIS->nodeDB.setLastHeard(slot, THIS->curtime);
+        THIS->nodeEviction.setLastHeard(nodeNum, THIS->curtime);
+        bool cameOnline = lastHeard > 0 && THIS->curtime - lastHeard >= THIS->secs_until_offline;
+        THIS->nodeUpdates.setLastHeard(nodeNum, cameOnline);
+    }
+}
 
-            // re-arrange the group linked list i.e. move the node after the top position
-            lv_ll_t *lv_group_ll = &lv_group_get_default()->obj_ll;
-            void *act = it->second->LV_OBJ_IDX(node_btn_idx)->user_data;
-            if (lv_group_ll && act)
-                _lv_ll_move_before(lv_group_ll, act, _lv_ll_get_next(lv_group_ll, THIS->topNodeLL));
+void TFTView_Common::showLastHeard(uint32_t nodeNum, bool cameOnline)
+{
+    if (THIS->nodes.contains(nodeNum)) {
+        // move to top position, the node list is rebound with the next frame
+        THIS->nodes.moveToTop(nodeNum, THIS->curtime);
+        THIS->nodeRowsChanged = true;
+        if (nodeNum != THIS->ownNode && cameOnline) {
+            applyNodesFilter(nodeNum);
+            updateNodesStatus();
         }
     }
 }
 
 void TFTView_Common::updateAllLastHeard(void)
 {
-    time_t lastHeard;
-    for (auto it : THIS->nodes) {
-        char buf[32];
-        if (it.first == THIS->ownNode) { // own node is always now, so do update
-            lastHeard = THIS->curtime;
-            it.second->LV_OBJ_IDX(node_lh_idx)->user_data = (void *)lastHeard;
-        } else {
-            lastHeard = (time_t)it.second->LV_OBJ_IDX(node_lh_idx)->user_data;
-        }
-        if (lastHeard) {
-            THIS->lastHeardToString(lastHeard, buf);
-            lv_label_set_text(it.second->LV_OBJ_IDX(node_lh_idx), buf);
-        }
-    }
+    // own node is always now, the last heard texts of the visible rows are formatted when they are bound
+    uint32_t slot = THIS->nodeDB.find(THIS->ownNode);
+    if (slot != NodeDB::c_noSlot)
+        THIS->nodeDB.setLastHeard(slot, THIS->curtime);
     updateNodesFiltered(true);
     updateNodesStatus();
 }
@@ -1638,13 +1746,13 @@ void TFTView_Common::newMessage(uint32_t from, uint32_t to, uint8_t ch, const ch
     char buf[284]; // 237 + 4 + 40 + 2 + 1
     lv_obj_t *container = nullptr;
     if (to == UINT32_MAX) { // message for group, prepend short name to msg
-        if (THIS->nodes.find(from) == THIS->nodes.end()) {
+        if (!THIS->nodes.contains(from)) {
             pos += sprintf(buf, "%04x ", from & 0xffff);
         } else {
-            // original short name is held in userData, extract it and add msg
-            char *userData = (char *)&(THIS->nodes[from]->LV_OBJ_IDX(node_lbs_idx)->user_data);
-            while (pos < 4 && userData[pos] != 0) {
-                buf[pos] = userData[pos];
+            // original short name is held in nodeDB, extract it and add msg
+            const char *userShort = THIS->nodeDB.shortName(THIS->nodeDB.find(from));
+            while (pos < 4 && userShort[pos] != 0) {
+                buf[pos] = userShort[pos];
                 pos++;
             }
         }
@@ -1675,7 +1783,8 @@ void TFTView_Common::newMessage(uint32_t from, uint32_t to, uint8_t ch, const ch
                 THIS->unreadMessages++;
                 updateUnreadMessages();
                 if (THIS->activePanel != objects.messages_panel && THIS->db.uiConfig.alert_enabled) {
-                    showMessagePopup(from, to, ch, lv_label_get_text(THIS->nodes[from]->LV_OBJ_IDX(node_lbl_idx)));
+                    uint32_t slot = THIS->nodeDB.find(from);
+                    showMessagePopup(from, to, ch, slot != NodeDB::c_noSlot ? THIS->nodeDB.longName(slot) : "");
                 }
             }
             lv_obj_add_flag(container, LV_OBJ_FLAG_HIDDEN);
@@ -1692,32 +1801,105 @@ void TFTView_Common::newMessage(uint32_t from, uint32_t to, uint8_t ch, const ch
 
 void TFTView_Common::newMessage(uint32_t nodeNum, lv_obj_t *container, uint8_t ch, const char *msg)
 {
-    lv_obj_t *hiddenPanel = lv_obj_create(container);
-    lv_obj_set_width(hiddenPanel, lv_pct(100));
-    lv_obj_set_height(hiddenPanel, LV_SIZE_CONTENT); /// 50
-    lv_obj_set_align(hiddenPanel, LV_ALIGN_CENTER);
-    lv_obj_clear_flag(hiddenPanel, LV_OBJ_FLAG_SCROLLABLE); /// Flags
-    lv_obj_set_style_radius(hiddenPanel, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    add_style_panel_style(hiddenPanel);
-    lv_obj_set_style_pad_left(hiddenPanel, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_pad_right(hiddenPanel, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_pad_top(hiddenPanel, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_pad_bottom(hiddenPanel, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-
-    lv_obj_t *msgLabel = lv_label_create(hiddenPanel);
-    // calculate expected size of text bubble, to make it look nicer
-    lv_coord_t width = lv_txt_get_width(msg, strlen(msg), &ui_font_montserrat_14, 0);
-    lv_obj_set_width(msgLabel, std::max<int32_t>(std::min<int32_t>((int32_t)(width), 160) + 10, 40));
-    lv_obj_set_height(msgLabel, LV_SIZE_CONTENT);
-    lv_obj_set_align(msgLabel, LV_ALIGN_LEFT_MID);
-    lv_label_set_text(msgLabel, msg);
-    add_style_new_message_style(msgLabel);
+    VirtualChat *chat = chatList(container);
+    chat->messages().add(msg, false, nodeNum, 0, LogMessage::eNone);
+    chat->changed();
 
     if (THIS->state == MeshtasticView::eRunning) {
-        lv_obj_scroll_to_view(hiddenPanel, LV_ANIM_ON);
+        chat->scrollToEnd(LV_ANIM_ON);
         lv_obj_move_foreground(objects.message_input_area);
     }
-    lv_obj_add_event_cb(hiddenPanel, ui_event_chatNodeButton, LV_EVENT_CLICKED, (void *)nodeNum);
+}
+
+/**
+ * messages of a chat container, only the visible ones are shown as bubbles
+ */
+VirtualChat *TFTView_Common::chatList(lv_obj_t *container)
+{
+    VirtualChat *chat = VirtualChat::of(container);
+    if (!chat)
+        chat = new VirtualChat(container, measureMessage, createMessageBubble, bindMessageBubble);
+    return chat;
+}
+
+/**
+ * measure the bubbles of all chats again after their font or style changed
+ */
+void TFTView_Common::invalidateChats(void)
+{
+    for (auto &it : messages) {
+        VirtualChat *chat = VirtualChat::of(it.second);
+        if (chat)
+            chat->invalidate();
+    }
+    for (lv_obj_t *container : channelGroup) {
+        VirtualChat *chat = container ? VirtualChat::of(container) : nullptr;
+        if (chat)
+            chat->invalidate();
+    }
+}
+
+/**
+ * size of a text bubble, measured once per message and then cached by the chat list
+ */
+ChatLayout::Size TFTView_Common::measureMessage(const char *text, bool sent)
+{
+    // style (font, padding) of the bubbles is taken from a hidden label of each kind
+    static lv_obj_t *probe[2] = {};
+    lv_obj_t *&label = probe[sent];
+    if (!label) {
+        label = createMessageBubble(objects.messages_panel, sent);
+        lv_obj_add_flag(label, LV_OBJ_FLAG_HIDDEN);
+    }
+    const lv_font_t *font = lv_obj_get_style_text_font(label, LV_PART_MAIN);
+    int32_t letterSpace = lv_obj_get_style_text_letter_space(label, LV_PART_MAIN);
+    int32_t lineSpace = lv_obj_get_style_text_line_space(label, LV_PART_MAIN);
+    int32_t border = lv_obj_get_style_border_width(label, LV_PART_MAIN);
+    int32_t padH = lv_obj_get_style_pad_left(label, LV_PART_MAIN) + lv_obj_get_style_pad_right(label, LV_PART_MAIN) + 2 * border;
+    int32_t padV = lv_obj_get_style_pad_top(label, LV_PART_MAIN) + lv_obj_get_style_pad_bottom(label, LV_PART_MAIN) + 2 * border;
+
+    // calculate expected size of text bubble, to make it look nicer
+    int32_t width = lv_txt_get_width(text, strlen(text), font, letterSpace);
+    width = std::max<int32_t>(std::min<int32_t>(width, sent ? 200 : 160) + 10, 40);
+    lv_point_t size;
+    lv_text_get_size(&size, text, font, letterSpace, lineSpace, width - padH, LV_TEXT_FLAG_NONE);
+    return ChatLayout::Size{uint16_t(width), uint16_t(size.y + padV)};
+}
+
+lv_obj_t *TFTView_Common::createMessageBubble(lv_obj_t *parent, bool sent)
+{
+    lv_obj_t *label = lv_label_create(parent);
+    if (sent) {
+        add_style_chat_message_style(label);
+    } else {
+        add_style_new_message_style(label);
+        lv_obj_add_flag(label, LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_add_event_cb(label, ui_event_chatBubble, LV_EVENT_CLICKED, NULL);
+    }
+    return label;
+}
+
+void TFTView_Common::bindMessageBubble(lv_obj_t *bubble, uint32_t index)
+{
+    ChatLayout &messages = VirtualChat::of(lv_obj_get_parent(bubble))->messages();
+    lv_label_set_text(bubble, messages.text(index));
+    if (!messages.message(index).sent)
+        return;
+
+    switch (messages.message(index).status) {
+    case LogMessage::eHeard:
+        lv_obj_set_style_border_color(bubble, colorYellow, LV_PART_MAIN | LV_STATE_DEFAULT);
+        break;
+    case LogMessage::eAcked:
+        lv_obj_set_style_border_color(bubble, colorBlueGreen, LV_PART_MAIN | LV_STATE_DEFAULT);
+        break;
+    case LogMessage::eFailed:
+        lv_obj_set_style_border_color(bubble, colorRed, LV_PART_MAIN | LV_STATE_DEFAULT);
+        break;
+    default:
+        lv_obj_remove_local_style_prop(bubble, LV_STYLE_BORDER_COLOR, LV_PART_MAIN | LV_STATE_DEFAULT);
+        break;
+    }
 }
 
 void TFTView_Common::restoreMessage(const LogMessage &msg)
@@ -1733,7 +1915,7 @@ void TFTView_Common::restoreMessage(const LogMessage &msg)
                 container = newMessageContainer(msg.from, msg.to, msg.ch);
             }
         } else {
-            if (THIS->nodes.find(msg.to) != THIS->nodes.end()) {
+            if (THIS->nodes.contains(msg.to)) {
                 if (msg.trashFlag && THIS->chats.find(msg.to) != THIS->chats.end()) {
                     ILOG_DEBUG("trashFlag set for node %08x", msg.to);
                     THIS->eraseChat(msg.to);
@@ -1751,7 +1933,7 @@ void TFTView_Common::restoreMessage(const LogMessage &msg)
                 lv_obj_add_flag(container, LV_OBJ_FLAG_HIDDEN);
             THIS->addMessage(container, msg.time, 0, (char *)msg.bytes, msg.status);
         }
-    } else if (THIS->nodes.find(msg.from) != THIS->nodes.end()) {
+    } else if (THIS->nodes.contains(msg.from)) {
         if (msg.trashFlag && THIS->chats.find(msg.from) != THIS->chats.end()) {
             ILOG_DEBUG("trashFlag set for node %08x", msg.from);
             THIS->eraseChat(msg.from);
@@ -1781,6 +1963,30 @@ void TFTView_Common::restoreMessage(const LogMessage &msg)
     }
 }
 
+/**
+ * show the chats and unread messages from the persistent summary already before the messages are restored
+ */
+void TFTView_Common::restoreChatSummary(const ChatSummary &summary)
+{
+    uint32_t unread = 0;
+    for (const ChatSummary::Chat *chat : summary.chats()) {
+        if (chat->type == ChatSummary::eChannel) {
+            if (!THIS->db.channel[chat->ch].settings.module_settings.is_muted)
+                unread += chat->unread;
+            addChat(0, UINT32_MAX, chat->ch);
+        } else {
+            if (!THIS->nodes.contains(chat->id))
+                MeshtasticView::addOrUpdateNode(chat->id, chat->ch, 0, eRole::unknown, false, false);
+            unread += chat->unread;
+            addChat(chat->id, THIS->ownNode, chat->ch);
+        }
+    }
+    if (unread) {
+        THIS->unreadMessages += unread;
+        updateUnreadMessages();
+    }
+}
+
 void TFTView_Common::addChat(uint32_t from, uint32_t to, uint8_t ch)
 {
     uint32_t index = ((to == UINT32_MAX || from == 0) ? ch : from);
@@ -1819,10 +2025,9 @@ void TFTView_Common::addChat(uint32_t from, uint32_t to, uint8_t ch)
     if (to == UINT32_MAX || from == 0) {
         sprintf(buf, "%d: %s", (int)ch, lv_label_get_text(THIS->channel[ch]));
     } else {
-        auto it = THIS->nodes.find(from);
-        if (it != THIS->nodes.end()) {
-            sprintf(buf, "%s: %s", lv_label_get_text(it->second->LV_OBJ_IDX(node_lbs_idx)),
-                    lv_label_get_text(it->second->LV_OBJ_IDX(node_lbl_idx)));
+        uint32_t slot = THIS->nodeDB.find(from);
+        if (THIS->nodes.contains(from) && slot != NodeDB::c_noSlot) {
+            sprintf(buf, "%s: %s", THIS->nodeDB.shortName(slot), THIS->nodeDB.longName(slot));
         } else {
             sprintf(buf, "!%08x", from);
         }
@@ -1868,7 +2073,8 @@ void TFTView_Common::addChat(uint32_t from, uint32_t to, uint8_t ch)
     THIS->chats[index] = chatBtn;
     updateActiveChats();
     if (index > c_max_channels) {
-        if (THIS->nodes.find(index) != THIS->nodes.end())
+        THIS->nodeEviction.setPinned(index, true);
+        if (THIS->nodes.contains(index))
             applyNodesFilter(index);
     }
 
@@ -1906,23 +2112,19 @@ void TFTView_Common::showMessages(uint32_t nodeNum)
     }
     THIS->activeMsgContainer->user_data = (void *)nodeNum;
     lv_obj_clear_flag(THIS->activeMsgContainer, LV_OBJ_FLAG_HIDDEN);
-    lv_obj_t *p = THIS->nodes[nodeNum];
-    if (p) {
-        lv_label_set_text(objects.top_messages_node_label, lv_label_get_text(p->LV_OBJ_IDX(node_lbl_idx)));
+    uint32_t slot = THIS->nodeDB.find(nodeNum);
+    if (THIS->nodes.contains(nodeNum)) {
+        lv_label_set_text(objects.top_messages_node_label, slot != NodeDB::c_noSlot ? THIS->nodeDB.longName(slot) : "");
         THIS->ui_set_active(objects.messages_button, objects.messages_panel, objects.top_messages_panel);
-        switch ((unsigned long)p->LV_OBJ_IDX(node_bat_idx)->user_data) {
-        case 0:
-            lv_obj_set_style_bg_image_src(objects.top_messages_node_image, &img_lock_channel_image,
+        if (slot == NodeDB::c_noSlot || THIS->nodeDB.hasFlag(slot, NodeDB::eKeyMismatch)) {
+            lv_obj_set_style_bg_image_src(objects.top_messages_node_image, &img_lock_slash_image,
                                           LV_PART_MAIN | LV_STATE_DEFAULT);
-            break;
-        case 1:
+        } else if (THIS->nodeDB.hasFlag(slot, NodeDB::eHasKey)) {
             lv_obj_set_style_bg_image_src(objects.top_messages_node_image, &img_lock_secure_image,
                                           LV_PART_MAIN | LV_STATE_DEFAULT);
-            break;
-        default:
-            lv_obj_set_style_bg_image_src(objects.top_messages_node_image, &img_lock_slash_image,
+        } else {
+            lv_obj_set_style_bg_image_src(objects.top_messages_node_image, &img_lock_channel_image,
                                           LV_PART_MAIN | LV_STATE_DEFAULT);
-            break;
         }
         THIS->unreadMessages = 0; // TODO: not all messages may be actually read
         updateUnreadMessages();
@@ -2000,6 +2202,9 @@ void TFTView_Common::updateUnreadMessages(void)
     } else {
         strcpy(buf, _("no new messages"));
         lv_obj_set_style_bg_img_src(objects.home_mail_button, &img_home_mail_button_image, LV_PART_MAIN | LV_STATE_DEFAULT);
+        // messages have been read, keep the persistent chat summary in sync
+        if (THIS->controller)
+            THIS->controller->markMessagesRead();
     }
     lv_label_set_text(objects.home_mail_label, buf);
 
@@ -2508,7 +2713,7 @@ void TFTView_Common::ui_event_NodesButton(lv_event_t *e)
         if (filterNeedsUpdate) {
             THIS->updateNodesFiltered(true);
             THIS->updateNodesStatus();
-            lv_obj_scroll_to_view(objects.node_panel, LV_ANIM_ON);
+            THIS->nodeList->scrollToIndex(0, LV_ANIM_ON);
             if (THIS->map) {
                 THIS->map->forceRedraw(true);
             }
@@ -2794,9 +2999,10 @@ void TFTView_Common::ui_event_calibration_screen_loaded(lv_event_t *e)
     memset(parameters, 0, 16); // clear all calibration data
     bool done = THIS->displaydriver->calibrate(parameters);
     THIS->db.uiConfig.calibration_data.size = 16;
-    char buf[32];
-    lv_snprintf(buf, sizeof(buf), _("Screen Calibration: %s"), done ? _("done") : _("default"));
-    lv_label_set_text(objects.basic_settings_calibration_label, buf);
+    THIS->bindLabel(objects.basic_settings_calibration_label, _("Screen Calibration: %s"),
+                    [done](char *buf, size_t size, const char *fmt) {
+                        lv_snprintf(buf, size, fmt, done ? _("done") : _("default"));
+                    });
     lv_screen_load_anim(objects.main_screen, LV_SCR_LOAD_ANIM_FADE_ON, 200, 0, false);
     THIS->controller->storeUIConfig(THIS->db.uiConfig);
 }
@@ -3155,11 +3361,9 @@ void TFTView_Common::ui_event_mapNodeButton(lv_event_t *e)
     // navigate to node in node list
     uint32_t nodeNum = (unsigned long)e->user_data;
     ILOG_DEBUG("map node %08x", nodeNum);
-    lv_obj_t *panel = THIS->nodes[nodeNum];
-    THIS->ui_set_active(objects.nodes_button, objects.nodes_panel, objects.top_nodes_panel);
-    lv_obj_scroll_to_view(panel, LV_ANIM_ON);
-    if (panel != currentPanel)
-        ui_event_NodeButton(e);
+    THIS->scrollToNode(nodeNum);
+    if (nodeNum != currentNode)
+        THIS->selectNode(nodeNum);
 }
 
 void TFTView_Common::ui_event_map_style_dropdown(lv_event_t *e)
@@ -3387,10 +3591,7 @@ void TFTView_Common::ui_event_ok(lv_event_t *e)
             // }
 
             if (region != THIS->db.config.lora.region) {
-                char buf1[10], buf2[30];
-                lv_dropdown_get_selected_str(objects.setup_region_dropdown, buf1, sizeof(buf1));
-                lv_snprintf(buf2, sizeof(buf2), _("Region: %s"), buf1);
-                lv_label_set_text(objects.basic_settings_region_label, buf2);
+                THIS->bindOptionLabel(objects.basic_settings_region_label, _("Region: %s"), objects.setup_region_dropdown);
 
                 meshtastic_Config_LoRaConfig &lora = THIS->db.config.lora;
                 uint32_t defaultSlot = lora.region == meshtastic_Config_LoRaConfig_RegionCode_UNSET ? lora.channel_num : 0;
@@ -3403,14 +3604,12 @@ void TFTView_Common::ui_event_ok(lv_event_t *e)
                 THIS->controller->sendConfig(meshtastic_Config_LoRaConfig{lora}, THIS->ownNode);
             }
 
-            char buf[30];
             const char *userShort = lv_textarea_get_text(objects.setup_user_short_textarea);
             const char *userLong = lv_textarea_get_text(objects.setup_user_long_textarea);
             if (strcmp(userShort, THIS->db.short_name) || strcmp(userLong, THIS->db.long_name)) {
-                lv_snprintf(buf, sizeof(buf), _("User name: %s"), userShort);
-                lv_label_set_text(objects.basic_settings_user_label, buf);
-                lv_label_set_text(objects.user_name_short_label, userShort);
-                lv_label_set_text(objects.user_name_label, userLong);
+                THIS->bindLabel(objects.basic_settings_user_label, _("User name: %s"), userShort);
+                THIS->setShortName(THIS->ownNode, userShort, userLong);
+                THIS->refreshNode(THIS->ownNode);
                 strcpy(THIS->db.short_name, userShort);
                 strcpy(THIS->db.long_name, userLong);
                 meshtastic_User user{}; // TODO: don't overwrite is_licensed
@@ -3425,14 +3624,12 @@ void TFTView_Common::ui_event_ok(lv_event_t *e)
             break;
         }
         case eUsername: {
-            char buf[30];
             const char *userShort = lv_textarea_get_text(objects.settings_user_short_textarea);
             const char *userLong = lv_textarea_get_text(objects.settings_user_long_textarea);
             if (strcmp(userShort, THIS->db.short_name) || strcmp(userLong, THIS->db.long_name)) {
-                lv_snprintf(buf, sizeof(buf), _("User name: %s"), userShort);
-                lv_label_set_text(objects.basic_settings_user_label, buf);
-                lv_label_set_text(objects.user_name_short_label, userShort);
-                lv_label_set_text(objects.user_name_label, userLong);
+                THIS->bindLabel(objects.basic_settings_user_label, _("User name: %s"), userShort);
+                THIS->setShortName(THIS->ownNode, userShort, userLong);
+                THIS->refreshNode(THIS->ownNode);
                 strcpy(THIS->db.short_name, userShort);
                 strcpy(THIS->db.long_name, userLong);
                 meshtastic_User user{}; // TODO: don't overwrite is_licensed
@@ -3451,10 +3648,8 @@ void TFTView_Common::ui_event_ok(lv_event_t *e)
                 THIS->val2role(lv_dropdown_get_selected(objects.settings_device_role_dropdown));
 
             if (role != device.role) {
-                char buf1[30], buf2[40];
-                lv_dropdown_get_selected_str(objects.settings_device_role_dropdown, buf1, sizeof(buf1));
-                lv_snprintf(buf2, sizeof(buf2), _("Device Role: %s"), buf1);
-                lv_label_set_text(objects.basic_settings_role_label, buf2);
+                THIS->bindOptionLabel(objects.basic_settings_role_label, _("Device Role: %s"),
+                                      objects.settings_device_role_dropdown);
 
                 device.role = role;
                 THIS->controller->sendConfig(meshtastic_Config_DeviceConfig{device}, THIS->ownNode);
@@ -3476,10 +3671,7 @@ void TFTView_Common::ui_event_ok(lv_event_t *e)
             }
 
             if (region != THIS->db.config.lora.region) {
-                char buf1[10], buf2[30];
-                lv_dropdown_get_selected_str(objects.settings_region_dropdown, buf1, sizeof(buf1));
-                lv_snprintf(buf2, sizeof(buf2), _("Region: %s"), buf1);
-                lv_label_set_text(objects.basic_settings_region_label, buf2);
+                THIS->bindOptionLabel(objects.basic_settings_region_label, _("Region: %s"), objects.settings_region_dropdown);
 
                 meshtastic_Config_LoRaConfig &lora = THIS->db.config.lora;
                 uint32_t defaultSlot = lora.region == meshtastic_Config_LoRaConfig_RegionCode_UNSET ? lora.channel_num : 0;
@@ -3502,10 +3694,8 @@ void TFTView_Common::ui_event_ok(lv_event_t *e)
                 THIS->val2preset(lv_dropdown_get_selected(objects.settings_modem_preset_dropdown));
             uint16_t channelNum = lv_slider_get_value(objects.frequency_slot_slider);
             if (preset != lora.modem_preset || lora.channel_num != channelNum) {
-                char buf1[16], buf2[32];
-                lv_dropdown_get_selected_str(objects.settings_modem_preset_dropdown, buf1, sizeof(buf1));
-                lv_snprintf(buf2, sizeof(buf2), _("Modem Preset: %s"), buf1);
-                lv_label_set_text(objects.basic_settings_modem_preset_label, buf2);
+                THIS->bindOptionLabel(objects.basic_settings_modem_preset_label, _("Modem Preset: %s"),
+                                      objects.settings_modem_preset_dropdown);
 
                 lora.use_preset = true;
                 lora.modem_preset = preset;
@@ -3536,13 +3726,11 @@ void TFTView_Common::ui_event_ok(lv_event_t *e)
             break;
         }
         case eWifi: {
-            char buf[30];
             const char *ssid = lv_textarea_get_text(objects.settings_wifi_ssid_textarea);
             const char *psk = lv_textarea_get_text(objects.settings_wifi_password_textarea);
             if (strlen(ssid) == 0 || strlen(psk) == 0)
                 return;
-            lv_snprintf(buf, sizeof(buf), _("WiFi: %s"), ssid[0] ? ssid : _("<not set>"));
-            lv_label_set_text(objects.basic_settings_wifi_label, buf);
+            THIS->bindLabel(objects.basic_settings_wifi_label, _("WiFi: %s"), ssid);
             if (strcmp(THIS->db.config.network.wifi_ssid, ssid) != 0 || strcmp(THIS->db.config.network.wifi_psk, psk) != 0) {
                 strcpy(THIS->db.config.network.wifi_ssid, ssid);
                 strcpy(THIS->db.config.network.wifi_psk, psk);
@@ -3561,6 +3749,13 @@ void TFTView_Common::ui_event_ok(lv_event_t *e)
             if (lang != THIS->db.uiConfig.language) {
                 THIS->db.uiConfig.language = lang;
                 THIS->controller->storeUIConfig(THIS->db.uiConfig);
+                // the registered labels are relabeled, the visible ones with the next frame
+                THIS->labels.invalidate();
+                THIS->setLocale(lang);
+                THIS->setLanguage(lang);
+                THIS->invalidateChats(); // the language may come with another font
+                // texts formatted once with _() (node panels, home and status labels) are only
+                // rebuilt from scratch
                 THIS->controller->requestReboot(3, THIS->ownNode);
                 THIS->notifyReboot(true);
             }
@@ -3596,9 +3791,7 @@ void TFTView_Common::ui_event_ok(lv_event_t *e)
                 THIS->controller->storeUIConfig(THIS->db.uiConfig);
             }
 
-            char buf[40];
-            lv_snprintf(buf, 40, _("Lock: %s/%s"), screenLock ? _("on") : _("off"), settingsLock ? _("on") : _("off"));
-            lv_label_set_text(objects.basic_settings_screen_lock_label, buf);
+            THIS->setLockLabel();
             lv_obj_add_flag(objects.settings_screen_lock_panel, LV_OBJ_FLAG_HIDDEN);
 
             break;
@@ -3799,9 +3992,16 @@ void TFTView_Common::ui_event_packet_log(lv_event_t *e)
     if (event_code == LV_EVENT_CLICKED) {
         THIS->ui_set_active(objects.settings_button, objects.tools_packet_log_panel, objects.top_packet_log_panel);
         THIS->packetLogEnabled = true;
+        if (!THIS->packetList) {
+            lv_obj_clean(objects.tools_packet_log_panel);
+            THIS->packetList = new VirtualList(objects.tools_packet_log_panel, THIS->packetLogRowHeight(), createPacketLogRow,
+                                               bindPacketLogRow);
+            THIS->packetList->setCount(THIS->packetLog.size());
+        }
     } else if (event_code == LV_EVENT_LONG_PRESSED) {
-        THIS->packetCounter = 0;
-        lv_obj_clean(objects.tools_packet_log_panel);
+        THIS->packetLog.clear();
+        if (THIS->packetList)
+            THIS->packetList->setCount(0);
     }
 }
 
@@ -3868,10 +4068,10 @@ void TFTView_Common::ui_event_pin_screen_button(lv_event_t *e)
 
 void TFTView_Common::ui_event_positionButton(lv_event_t *e)
 {
-    // navigate to position in map
-    lv_obj_t *p = (lv_obj_t *)e->user_data;
-    int32_t lat = (long)p->LV_OBJ_IDX(node_pos1_idx)->user_data;
-    int32_t lon = (long)p->LV_OBJ_IDX(node_pos2_idx)->user_data;
+    // navigate to position in map, the label is in the panel bound to the node
+    uint32_t slot = THIS->nodeDB.find((unsigned long)lv_obj_get_parent(lv_event_get_target_obj(e))->user_data);
+    int32_t lat = slot != NodeDB::c_noSlot ? THIS->nodeDB.latitude(slot) : 0;
+    int32_t lon = slot != NodeDB::c_noSlot ? THIS->nodeDB.longitude(slot) : 0;
     if (lat && lon) {
         THIS->ui_set_active(objects.map_button, objects.map_panel, objects.top_map_panel);
         if (!THIS->map) {
@@ -4016,11 +4216,10 @@ void TFTView_Common::ui_event_setup_region_dropdown(lv_event_t *e) {}
 
 void TFTView_Common::ui_event_signal_scanner(lv_event_t *e)
 {
-    if (currentPanel) {
-        THIS->setNodeImage(currentNode, (MeshtasticView::eRole)(unsigned long)currentPanel->LV_OBJ_IDX(node_img_idx)->user_data,
-                           false, objects.signal_scanner_node_image);
-        const char *lbs = lv_label_get_text(currentPanel->LV_OBJ_IDX(node_lbs_idx));
-        lv_label_set_text(objects.signal_scanner_node_button_label, lbs);
+    uint32_t slot = THIS->nodeDB.find(currentNode);
+    if (currentNode && slot != NodeDB::c_noSlot) {
+        THIS->setNodeImage(currentNode, objects.signal_scanner_node_image);
+        lv_label_set_text(objects.signal_scanner_node_button_label, THIS->nodeDB.shortName(slot));
         lv_obj_clear_state(objects.signal_scanner_start_button, LV_STATE_DISABLED);
     } else {
         lv_label_set_text(objects.signal_scanner_node_button_label, _("choose\nnode"));
@@ -4185,12 +4384,10 @@ void TFTView_Common::ui_event_trace_route(lv_event_t *e)
     lv_obj_clear_flag(objects.start_button_panel, LV_OBJ_FLAG_HIDDEN);
     lv_obj_add_flag(objects.hop_routes_panel, LV_OBJ_FLAG_HIDDEN);
 
-    if (currentPanel) {
-        THIS->setNodeImage(THIS->currentNode,
-                           (MeshtasticView::eRole)(unsigned long)currentPanel->LV_OBJ_IDX(node_img_idx)->user_data, false,
-                           objects.trace_route_to_image);
-        const char *lbl = lv_label_get_text(currentPanel->LV_OBJ_IDX(node_lbl_idx));
-        lv_label_set_text(objects.trace_route_to_button_label, lbl);
+    uint32_t slot = THIS->nodeDB.find(currentNode);
+    if (currentNode && slot != NodeDB::c_noSlot) {
+        THIS->setNodeImage(THIS->currentNode, objects.trace_route_to_image);
+        lv_label_set_text(objects.trace_route_to_button_label, THIS->nodeDB.longName(slot));
         lv_obj_clear_state(objects.trace_route_start_button, LV_STATE_DISABLED);
     } else {
         lv_label_set_text(objects.trace_route_to_button_label, _("choose target node"));
@@ -4203,15 +4400,13 @@ void TFTView_Common::ui_event_trace_route(lv_event_t *e)
 void TFTView_Common::ui_event_trace_route_node(lv_event_t *e)
 {
     // navigate to node in node list
-    lv_obj_t *panel = (lv_obj_t *)e->user_data;
-    THIS->ui_set_active(objects.nodes_button, objects.nodes_panel, objects.top_nodes_panel);
-    lv_obj_scroll_to_view(panel, LV_ANIM_ON);
+    THIS->scrollToNode((unsigned long)e->user_data);
 }
 
 void TFTView_Common::ui_event_trace_route_start(lv_event_t *e)
 {
     if (!spinnerButton) {
-        if (currentPanel) {
+        if (currentNode) {
             time(&startTime);
             lv_obj_t *obj = lv_spinner_create(objects.start_button_panel);
             spinnerButton = obj;
@@ -4222,23 +4417,16 @@ void TFTView_Common::ui_event_trace_route_start(lv_event_t *e)
             add_style_spinner_style(obj);
             lv_label_set_text(objects.trace_route_start_label, "30s");
 
-            // retrieve nodeNum from current node
-            // FIXME: remove for loop
-            for (auto &it : THIS->nodes) {
-                if (it.second == currentPanel) {
-                    uint32_t requestId;
-                    uint32_t to = it.first;
-                    uint8_t ch = (uint8_t)(unsigned long)currentPanel->user_data;
-                    // trial: hoplimit optimization for direct messages
-                    int8_t hopsAway = (signed long)THIS->nodes[to]->LV_OBJ_IDX(node_sig_idx)->user_data;
-                    if (hopsAway < 0)
-                        hopsAway = 5;
-                    uint8_t hopLimit = (hopsAway < THIS->db.config.lora.hop_limit ? hopsAway + 1 : hopsAway);
-                    requestId = THIS->requests.addRequest(to, ResponseHandler::TraceRouteRequest);
-                    THIS->controller->traceRoute(to, ch, hopLimit, requestId);
-                    break;
-                }
-            }
+            uint32_t to = currentNode;
+            uint32_t slot = THIS->nodeDB.find(to);
+            uint8_t ch = THIS->nodeDB.channel(slot);
+            // trial: hoplimit optimization for direct messages
+            int8_t hopsAway = THIS->nodeDB.hopsAway(slot);
+            if (hopsAway < 0)
+                hopsAway = 5;
+            uint8_t hopLimit = (hopsAway < THIS->db.config.lora.hop_limit ? hopsAway + 1 : hopsAway);
+            uint32_t requestId = THIS->requests.addRequest(to, ResponseHandler::TraceRouteRequest);
+            THIS->controller->traceRoute(to, ch, hopLimit, requestId);
         }
     } else {
         // restart
@@ -4317,7 +4505,11 @@ void TFTView_Common::init(IClientBase *client)
     MeshtasticView::init(client);
 
     ui_init_boot();
+#if defined(ARCH_PORTDUINO)
+    FileLoader::init(&fileSystem, portduinoVFS->mountpoint());
+#else
     FileLoader::init(&fileSystem);
+#endif
     FileLoader::loadBootImage(objects.boot_logo);
     // if boot logo is too big remove the label and center the image
     lv_obj_update_layout(objects.boot_logo);
@@ -4403,10 +4595,7 @@ bool TFTView_Common::setupUIConfig(const meshtastic_DeviceUIConfig &uiconfig)
     THIS->setTimeout(db.uiConfig.screen_timeout);
 
     // set screen/settings lock
-    char buf[40];
-    lv_snprintf(buf, 40, _("Lock: %s/%s"), db.uiConfig.screen_lock ? _("on") : _("off"),
-                db.uiConfig.settings_lock ? _("on") : _("off"));
-    lv_label_set_text(objects.basic_settings_screen_lock_label, buf);
+    setLockLabel();
 
     // set node filter options
     meshtastic_NodeFilter &filter = db.uiConfig.node_filter;
@@ -4418,6 +4607,7 @@ bool TFTView_Common::setupUIConfig(const meshtastic_DeviceUIConfig &uiconfig)
     // lv_obj_set_state(objects.nodes_filter_mqtt_switch, LV_STATE_CHECKED, filter.mqtt_switch);
     lv_obj_set_state(objects.nodes_filter_position_switch, LV_STATE_CHECKED, filter.position_switch);
     lv_textarea_set_text(objects.nodes_filter_name_area, filter.node_name);
+    THIS->syncNodeFilter();
 
     // set node highlight options
     meshtastic_NodeHighlight &highlight = db.uiConfig.node_highlight;
@@ -4427,18 +4617,23 @@ bool TFTView_Common::setupUIConfig(const meshtastic_DeviceUIConfig &uiconfig)
     lv_obj_set_state(objects.nodes_hliaq_switch, LV_STATE_CHECKED, highlight.iaq_switch);
     lv_textarea_set_text(objects.nodes_hl_name_area, highlight.node_name);
 
-    // initialize own node panel
-    if (ownNode && objects.node_panel)
-        nodes[ownNode] = objects.node_panel;
+    // own node is the first row of the node list
+    if (ownNode) {
+        nodes.setPinned(ownNode);
+        nodes.add(ownNode, 0);
+        nodeDB.add(ownNode);
+        nodeRowsChanged = true;
+    }
 
     // touch screen calibration data
     uint16_t *parameters = (uint16_t *)db.uiConfig.calibration_data.bytes;
     if (db.uiConfig.calibration_data.size == 16 && (parameters[0] || parameters[7])) {
 #ifndef IGNORE_CALIBRATION_DATA
         bool done = displaydriver->calibrate(parameters);
-        char buf[32];
-        lv_snprintf(buf, sizeof(buf), _("Screen Calibration: %s"), done ? _("done") : _("default"));
-        lv_label_set_text(objects.basic_settings_calibration_label, buf);
+        bindLabel(objects.basic_settings_calibration_label, _("Screen Calibration: %s"),
+                  [done](char *buf, size_t size, const char *fmt) {
+                      lv_snprintf(buf, size, fmt, done ? _("done") : _("default"));
+                  });
 #endif
     }
 
@@ -4587,6 +4782,11 @@ void TFTView_Common::init_screens(void)
             break;
         }
     }
+    // the generated node panel only anchors the node buttons in the group, the rows are recycled panels
+    lv_obj_add_flag(objects.node_panel, LV_OBJ_FLAG_HIDDEN);
+    nodeList = new VirtualList(objects.nodes_panel, c_nodePanelHeight + lv_obj_get_style_pad_row(objects.nodes_panel, LV_PART_MAIN),
+                               createNodePanel, bindNodePanel);
+    updateNodeList();
 
     // user data
     objects.home_time_button->user_data = (void *)0;
@@ -4606,6 +4806,9 @@ void TFTView_Common::init_screens(void)
     // view-specific screen initialization (e.g. messagesBadge for 480x222)
     onInitScreensExtra();
 
+    // translatable texts of all screens, relabeled after a locale switch
+    registerLabels();
+
     screensInitialised = true;
     state = MeshtasticView::eInitDone;
     ILOG_DEBUG("TFTView_Common init done.");
@@ -4737,7 +4940,8 @@ void TFTView_Common::apply_hotfix(void)
     if (v > 240) {
         rows = (v - 32) / 18;
     }
-    statisticTableRows = rows;
+    statisticTableRows = std::max(rows, (int32_t)1);
+    packetStats.setTopSize(statisticTableRows - 1); // row 0 is the heading
     lv_table_set_row_count(objects.statistics_table, statisticTableRows);
     lv_table_set_column_count(objects.statistics_table, 7);
     lv_table_set_column_width(objects.statistics_table, 0, 57);
@@ -4937,9 +5141,6 @@ void TFTView_Common::ui_events_init(void)
     lv_obj_add_event_cb(objects.home_qr_button, this->ui_event_QrButton, LV_EVENT_CLICKED, NULL);
     lv_obj_add_event_cb(objects.home_cancel_qr_button, this->ui_event_CancelQrButton, LV_EVENT_CLICKED, NULL);
 
-    // node and channel buttons
-    lv_obj_add_event_cb(objects.node_button, ui_event_NodeButton, LV_EVENT_ALL, (void *)ownNode);
-
     // 8 channel buttons
     lv_obj_add_event_cb(objects.channel_button0, ui_event_ChannelButton, LV_EVENT_ALL, (void *)0);
     lv_obj_add_event_cb(objects.channel_button1, ui_event_ChannelButton, LV_EVENT_ALL, (void *)1);
@@ -5132,59 +5333,10 @@ void TFTView_Common::timer_event_programming_mode(lv_timer_t *timer)
 
 void TFTView_Common::ui_event_NodeButton(lv_event_t *e)
 {
-    static bool animRunning = false;
-    static auto deleted_cb = [](_lv_anim_t *) { animRunning = false; };
     lv_event_code_t event_code = lv_event_get_code(e);
-    if (event_code == LV_EVENT_CLICKED && !animRunning) {
-        uint32_t nodeNum = (unsigned long)e->user_data;
-        if (!nodeNum) // event-handler for own node has value 0 in user_data
-            nodeNum = THIS->ownNode;
-        lv_obj_t *panel = THIS->nodes[nodeNum];
-        if (currentPanel) {
-            // create animation to shrink other panel
-            animRunning = true;
-            static lv_anim_t a;
-            int32_t height = lv_obj_get_height(currentPanel);
-            lv_anim_init(&a);
-            lv_anim_set_var(&a, currentPanel);
-            lv_anim_set_values(&a, height, 136 - height);
-            lv_anim_set_duration(&a, 200);
-            lv_anim_set_exec_cb(&a, ui_anim_node_panel_cb);
-            lv_anim_set_path_cb(&a, lv_anim_path_linear);
-            lv_anim_set_deleted_cb(&a, deleted_cb);
-            lv_anim_start(&a);
-        }
-        if (panel != currentPanel) {
-            // create animation to enlarge node panel
-            animRunning = true;
-            static lv_anim_t a;
-            int32_t height = lv_obj_get_height(panel);
-            lv_anim_init(&a);
-            lv_anim_set_var(&a, panel);
-            lv_anim_set_values(&a, height, 136 - height);
-            lv_anim_set_duration(&a, 200);
-            lv_anim_set_exec_cb(&a, ui_anim_node_panel_cb);
-            lv_anim_set_path_cb(&a, lv_anim_path_linear);
-            lv_anim_set_deleted_cb(&a, deleted_cb);
-            lv_anim_start(&a);
-            lv_obj_scroll_to_view(panel, LV_ANIM_ON);
-            currentPanel = panel;
-            currentNode = nodeNum;
-        } else {
-            currentPanel = nullptr;
-            currentNode = 0;
-        }
-        if (THIS->chooseNodeSignalScanner) {
-            THIS->chooseNodeSignalScanner = false;
-            ui_event_signal_scanner(NULL);
-            // restore previous filter
-            lv_dropdown_set_selected(objects.nodes_filter_hops_dropdown, THIS->selectedHops);
-            THIS->updateNodesFiltered(true);
-            THIS->updateNodesStatus();
-        } else if (THIS->chooseNodeTraceRoute) {
-            THIS->chooseNodeTraceRoute = false;
-            ui_event_trace_route(NULL);
-        }
+    if (event_code == LV_EVENT_CLICKED) {
+        // the panel of the button is bound to the node
+        THIS->selectNode((unsigned long)lv_obj_get_parent(lv_event_get_target_obj(e))->user_data);
     } else if (event_code == LV_EVENT_KEY) {
         uint32_t key = lv_event_get_key(e);
         // Page-jump: skip 5 nodes forward/backward for fast navigation with encoder
@@ -5204,8 +5356,9 @@ void TFTView_Common::ui_event_NodeButton(lv_event_t *e)
         }
     } else if (event_code == LV_EVENT_LONG_PRESSED) {
         //  set color and text of clicked node
-        uint32_t nodeNum = (unsigned long)e->user_data;
-        bool isMessagable = !((unsigned long)(THIS->nodes[nodeNum]->LV_OBJ_IDX(node_img_idx)->user_data) == eRole::unmessagable);
+        uint32_t nodeNum = (unsigned long)lv_obj_get_parent(lv_event_get_target_obj(e))->user_data;
+        uint32_t slot = THIS->nodeDB.find(nodeNum);
+        bool isMessagable = slot != NodeDB::c_noSlot && !THIS->nodeDB.hasFlag(slot, NodeDB::eUnmessagable);
         if (nodeNum != THIS->ownNode && isMessagable)
             THIS->showMessages(nodeNum);
     }
@@ -5310,16 +5463,24 @@ void TFTView_Common::ui_event_message_ready(lv_event_t *e)
 // backup & restore
 // configuration reset
 // reboot / shutdown
+void TFTView_Common::ui_event_chatBubble(lv_event_t *e)
+{
+    lv_obj_t *bubble = lv_event_get_target_obj(e);
+    VirtualChat *chat = VirtualChat::of(lv_obj_get_parent(bubble));
+    uint32_t index = chat ? chat->indexOf(bubble) : ChatLayout::c_none;
+    if (index != ChatLayout::c_none) {
+        e->user_data = (void *)(unsigned long)chat->messages().message(index).nodeNum;
+        ui_event_chatNodeButton(e);
+    }
+}
+
 void TFTView_Common::ui_event_chatNodeButton(lv_event_t *e)
 {
     uint32_t nodeNum = (unsigned long)e->user_data;
-    auto it = THIS->nodes.find(nodeNum);
-    if (it != THIS->nodes.end()) {
-        lv_obj_t *panel = it->second;
-        THIS->ui_set_active(objects.nodes_button, objects.nodes_panel, objects.top_nodes_panel);
-        lv_obj_scroll_to_view(panel, LV_ANIM_ON);
-        if (panel != currentPanel)
-            ui_event_NodeButton(e);
+    if (THIS->nodes.contains(nodeNum)) {
+        THIS->scrollToNode(nodeNum);
+        if (nodeNum != currentNode)
+            THIS->selectNode(nodeNum);
     }
 }
 
@@ -5352,6 +5513,9 @@ void TFTView_Common::loadMap(void)
 {
 
     if (!map) {
+#if defined(HAS_SD_MMC) || defined(HAS_SDCARD)
+        TileFsLock::shareBus([]() { THIS->displaydriver->acquireBus(); }, []() { THIS->displaydriver->releaseBus(); });
+#endif
 #if LV_USE_FS_ARDUINO_SD
         map = new MapPanel(objects.raw_map_panel);
 #elif defined(HAS_SD_MMC)
@@ -5412,9 +5576,9 @@ void TFTView_Common::loadMap(void)
             sortedLat.reserve(nodeObjects.size());
             sortedLon.reserve(nodeObjects.size());
             for (auto it : nodeObjects) {
-                lv_obj_t *p = nodes[it.first];
-                int32_t lat = (long)p->LV_OBJ_IDX(node_pos1_idx)->user_data;
-                int32_t lon = (long)p->LV_OBJ_IDX(node_pos2_idx)->user_data;
+                uint32_t slot = nodeDB.find(it.first);
+                int32_t lat = nodeDB.latitude(slot);
+                int32_t lon = nodeDB.longitude(slot);
                 if (lat && lon) {
                     sortedLat.push_back(lat);
                     sortedLon.push_back(lon);
@@ -5455,9 +5619,9 @@ void TFTView_Common::loadMap(void)
         // finally add all node images to the map
         if (!nodeObjects.empty()) {
             for (auto it : nodeObjects) {
-                lv_obj_t *p = nodes[it.first];
-                float lat = 1e-7 * (long)p->LV_OBJ_IDX(node_pos1_idx)->user_data;
-                float lon = 1e-7 * (long)p->LV_OBJ_IDX(node_pos2_idx)->user_data;
+                uint32_t slot = nodeDB.find(it.first);
+                float lat = 1e-7 * nodeDB.latitude(slot);
+                float lon = 1e-7 * nodeDB.longitude(slot);
                 map->add(it.first, lat, lon, drawObjectCB);
                 lv_obj_add_flag(it.second, LV_OBJ_FLAG_CLICKABLE);
                 lv_obj_add_event_cb(it.second, ui_event_mapNodeButton, LV_EVENT_CLICKED, (void *)it.first);
@@ -5563,14 +5727,11 @@ void TFTView_Common::addOrUpdateMap(uint32_t nodeNum, int32_t lat, int32_t lon)
         lv_obj_set_style_align(lbl, LV_ALIGN_BOTTOM_MID, LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_style_align(lbl, LV_ALIGN_BOTTOM_MID, LV_PART_MAIN | LV_STATE_DEFAULT);
 
-        lv_obj_t *p = nodes[nodeNum];
-        lv_label_set_text_fmt(lbl, "%s", lv_label_get_text(p->LV_OBJ_IDX(node_lbs_idx)));
-
-        // position label callback
-        lv_obj_add_flag(p->LV_OBJ_IDX(node_pos1_idx), LV_OBJ_FLAG_CLICKABLE);
-        lv_obj_add_event_cb(p->LV_OBJ_IDX(node_pos1_idx), ui_event_positionButton, LV_EVENT_CLICKED, (void *)p);
+        uint32_t slot = nodeDB.find(nodeNum);
+        lv_label_set_text(lbl, slot != NodeDB::c_noSlot ? nodeDB.shortName(slot) : "");
 
         nodeObjects[nodeNum] = img;
+        refreshNode(nodeNum); // the position label becomes clickable
         if (map) {
             map->add(nodeNum, lat * 1e-7, lon * 1e-7, drawObjectCB);
             lv_obj_add_flag(img, LV_OBJ_FLAG_CLICKABLE);
@@ -5598,6 +5759,7 @@ void TFTView_Common::removeFromMap(uint32_t nodeNum)
     nodeObjects.erase(nodeNum);
     lv_obj_remove_event_cb(img, ui_event_mapNodeButton);
     lv_obj_delete(img);
+    refreshNode(nodeNum);
 }
 
 void TFTView_Common::removeSpinner(void)
@@ -5626,18 +5788,9 @@ void TFTView_Common::packetDetected(const meshtastic_MeshPacket &p)
             lv_obj_add_flag(objects.detector_radar_panel, LV_OBJ_FLAG_HIDDEN);
             lv_obj_add_flag(objects.detector_heard_label, LV_OBJ_FLAG_HIDDEN);
 
-            setNodeImage(p.from, (MeshtasticView::eRole)(unsigned long)nodes[p.from]->LV_OBJ_IDX(node_img_idx)->user_data, false,
-                         objects.detector_contact_image);
-            const char *lbl = lv_label_get_text(nodes[p.from]->LV_OBJ_IDX(node_lbl_idx));
-
-            char from[5];
-            char *userShort = (char *)&(nodes[p.from]->LV_OBJ_IDX(node_lbs_idx)->user_data);
-            int pos = 0;
-            while (pos < 4 && userShort[pos] != 0) {
-                from[pos] = userShort[pos];
-                pos++;
-            }
-            from[pos] = '\0';
+            setNodeImage(p.from, objects.detector_contact_image);
+            const char *lbl = nodeDB.longName(nodeDB.find(p.from));
+            const char *from = nodeDB.shortName(nodeDB.find(p.from));
 
             char buf[64];
             lv_snprintf(buf, 64, "%s(%04x)\n%s", from, p.from & 0xffff, lbl);
@@ -5700,6 +5853,83 @@ void TFTView_Common::updateSignalStrength(int32_t rssi, float snr)
     }
 }
 
+#ifdef LV_I18N_EXTERNAL_PACKS
+/**
+ * Read a language pack into one allocation that also holds the phrase tables built from it.
+ */
+template <class FileT> static void *readLanguagePack(FileT &file, uint32_t &size)
+{
+    if (!file)
+        return nullptr;
+    uint8_t header[LV_I18N_PACK_HEADER_SIZE];
+    uint32_t alloc = 0;
+    size = file.size();
+    if ((size_t)file.read(header, sizeof(header)) == sizeof(header))
+        alloc = lv_i18n_pack_alloc_size(header, size);
+    uint8_t *pack = alloc ? (uint8_t *)lv_malloc(alloc) : nullptr;
+    if (pack) {
+        memcpy(pack, header, sizeof(header));
+        if ((uint32_t)file.read(pack + sizeof(header), size - sizeof(header)) != size - sizeof(header)) {
+            lv_free(pack);
+            pack = nullptr;
+        }
+    }
+    file.close();
+    return pack;
+}
+#endif
+
+/**
+ * @brief Load the tables of the current locale from /locale/<name>.lvi on the SD card or in
+ * LittleFS. Without LV_I18N_EXTERNAL_PACKS all languages are compiled in and this does nothing;
+ * if no (matching) pack is found, texts stay English.
+ */
+void TFTView_Common::loadLanguagePack(const char *name)
+{
+#ifdef LV_I18N_EXTERNAL_PACKS
+    if (!name)
+        return;
+    // back to the compiled-in language before the old pack is freed
+    lv_i18n_set_locale(name);
+    if (languagePack) {
+        lv_free(languagePack);
+        languagePack = nullptr;
+    }
+    if (strcmp(name, "en") == 0)
+        return;
+
+    char path[32];
+    lv_snprintf(path, sizeof(path), "/locale/%s.lvi", name);
+    uint32_t size = 0;
+    void *pack = nullptr;
+#if defined(HAS_SDCARD) || defined(HAS_SD_MMC) || defined(ARCH_PORTDUINO)
+#if defined(ARCH_PORTDUINO) || defined(HAS_SD_MMC)
+    File sd = SDFs.open(path, FILE_READ);
+#else
+    FsFile sd = SDFs.open(path, O_RDONLY);
+#endif
+    pack = readLanguagePack(sd, size);
+#endif
+    if (!pack) {
+        File fs = fileSystem.open(path, FILE_READ);
+        pack = readLanguagePack(fs, size);
+    }
+    if (!pack) {
+        ILOG_WARN("language pack %s not found or invalid", path);
+        return;
+    }
+    if (lv_i18n_set_locale_pack(pack, size) != 0) {
+        ILOG_WARN("language pack %s does not match", path);
+        lv_free(pack);
+        return;
+    }
+    languagePack = pack;
+    ILOG_INFO("language pack %s loaded (%u bytes)", path, (unsigned int)size);
+#else
+    (void)name;
+#endif
+}
+
 /**
  * @brief Set lv_i18n language
  */
@@ -5798,6 +6028,7 @@ void TFTView_Common::setLocale(meshtastic_Language lang)
         ILOG_WARN("Language %d not implemented", lang);
         break;
     }
+    loadLanguagePack(lv_i18n_get_current_locale());
 
 #if defined(LOCALE_SUPPORT)
     std::locale::global(std::locale(locale));
@@ -5811,11 +6042,8 @@ void TFTView_Common::setLocale(meshtastic_Language lang)
  */
 void TFTView_Common::setLanguage(meshtastic_Language lang)
 {
-    char buf1[20], buf2[40];
     lv_dropdown_set_selected(objects.settings_language_dropdown, language2val(lang));
-    lv_dropdown_get_selected_str(objects.settings_language_dropdown, buf1, sizeof(buf1));
-    lv_snprintf(buf2, sizeof(buf2), _("Language: %s"), buf1);
-    lv_label_set_text(objects.basic_settings_language_label, buf2);
+    bindOptionLabel(objects.basic_settings_language_label, _("Language: %s"), objects.settings_language_dropdown);
 }
 
 /**
@@ -5823,12 +6051,11 @@ void TFTView_Common::setLanguage(meshtastic_Language lang)
  */
 void TFTView_Common::setTimeout(uint32_t timeout)
 {
-    char buf[32];
     if (timeout == 0)
-        lv_snprintf(buf, sizeof(buf), _("Screen Timeout: off"));
+        bindLabel(objects.basic_settings_timeout_label, _("Screen Timeout: off"));
     else
-        lv_snprintf(buf, sizeof(buf), _("Screen Timeout: %ds"), timeout);
-    lv_label_set_text(objects.basic_settings_timeout_label, buf);
+        bindLabel(objects.basic_settings_timeout_label, _("Screen Timeout: %ds"),
+                  [timeout](char *buf, size_t size, const char *fmt) { lv_snprintf(buf, size, fmt, timeout); });
     THIS->displaydriver->setScreenTimeout(timeout);
 }
 
@@ -5837,9 +6064,9 @@ void TFTView_Common::setTimeout(uint32_t timeout)
  */
 void TFTView_Common::setBrightness(uint32_t brightness)
 {
-    char buf[32];
-    lv_snprintf(buf, sizeof(buf), _("Screen Brightness: %d%%"), uint16_t(round((brightness * 100) / 255.0)));
-    lv_label_set_text(objects.basic_settings_brightness_label, buf);
+    uint16_t percent = round((brightness * 100) / 255.0);
+    bindLabel(objects.basic_settings_brightness_label, _("Screen Brightness: %d%%"),
+              [percent](char *buf, size_t size, const char *fmt) { lv_snprintf(buf, size, fmt, percent); });
     THIS->displaydriver->setBrightness((uint8_t)brightness);
 }
 
@@ -5848,15 +6075,100 @@ void TFTView_Common::setBrightness(uint32_t brightness)
  */
 void TFTView_Common::setTheme(uint32_t value)
 {
-    char buf1[30], buf2[30];
     lv_dropdown_set_selected(objects.settings_theme_dropdown, value);
-    lv_dropdown_get_selected_str(objects.settings_theme_dropdown, buf1, sizeof(buf1));
-    lv_snprintf(buf2, sizeof(buf2), _("Theme: %s"), buf1);
-    lv_label_set_text(objects.basic_settings_theme_label, buf2);
+    bindOptionLabel(objects.basic_settings_theme_label, _("Theme: %s"), objects.settings_theme_dropdown);
 
     // change theme and redraw UI
     Themes::set(Themes::Theme(value));
     updateTheme();
+    invalidateChats(); // the bubble styles may have other paddings or borders
+}
+
+/**
+ * @brief Show the screen/settings lock state
+ */
+void TFTView_Common::setLockLabel(void)
+{
+    bool screenLock = db.uiConfig.screen_lock;
+    bool settingsLock = db.uiConfig.settings_lock;
+    bindLabel(objects.basic_settings_screen_lock_label, _("Lock: %s/%s"),
+              [screenLock, settingsLock](char *buf, size_t size, const char *fmt) {
+                  lv_snprintf(buf, size, fmt, screenLock ? _("on") : _("off"), settingsLock ? _("on") : _("off"));
+              });
+}
+
+/**
+ * @brief Bind the texts of all screens that are translations (e.g. set with _() by the generated
+ * UI) to their message IDs, so that a locale switch relabels them without a reboot
+ */
+void TFTView_Common::registerLabels(void)
+{
+    lv_obj_tree_walk(
+        NULL,
+        [](lv_obj_t *obj, void *) -> lv_obj_tree_walk_res_t {
+            if (widgetText(obj) && THIS->labels.adopt(obj))
+                lv_obj_add_event_cb(obj, ui_event_labelDeleted, LV_EVENT_DELETE, NULL);
+            return LV_OBJ_TREE_WALK_NEXT;
+        },
+        NULL);
+    ILOG_DEBUG("%u translatable labels registered", (unsigned int)labels.size());
+}
+
+/**
+ * @brief Set the text of a label (checkbox, dropdown) to a translated text, formatted if a format
+ * is given, and keep it translated when the locale changes. The text is passed as _("...") so that
+ * `lv_i18n extract` finds it, the label is bound to the message ID it was translated from. Texts
+ * without one must be string literals (the registry and the translation cache keep the pointers).
+ */
+void TFTView_Common::bindLabel(lv_obj_t *obj, const char *text, LabelRegistry::Format format)
+{
+    const char *msgId = lv_i18n_get_msg_id(text);
+    if (labels.bind(obj, msgId ? msgId : text, std::move(format)))
+        lv_obj_add_event_cb(obj, ui_event_labelDeleted, LV_EVENT_DELETE, NULL);
+}
+
+/**
+ * @brief Bind a label to a format string with one untranslated argument (e.g. a name)
+ */
+void TFTView_Common::bindLabel(lv_obj_t *obj, const char *text, const char *arg)
+{
+    bindLabel(obj, text, [value = std::string(arg)](char *buf, size_t size, const char *fmt) {
+        lv_snprintf(buf, size, fmt, value.c_str());
+    });
+}
+
+/**
+ * @brief Bind a label to a format string with the selected option of a dropdown as argument.
+ * The option is taken from the translated options, the dropdown itself may not have been
+ * relabeled yet.
+ */
+void TFTView_Common::bindOptionLabel(lv_obj_t *obj, const char *text, lv_obj_t *dropdown)
+{
+    bindLabel(obj, text, [this, dropdown](char *buf, size_t size, const char *fmt) {
+        char option[40];
+        const char *options = labels.msgId(dropdown);
+        if (options) {
+            options = _(options);
+            for (uint32_t i = lv_dropdown_get_selected(dropdown); i > 0 && options; i--) {
+                options = strchr(options, '\n');
+                if (options)
+                    options++;
+            }
+            if (!options)
+                options = "";
+            size_t len = std::min(strcspn(options, "\n"), sizeof(option) - 1);
+            memcpy(option, options, len);
+            option[len] = '\0';
+        } else {
+            lv_dropdown_get_selected_str(dropdown, option, sizeof(option));
+        }
+        lv_snprintf(buf, size, fmt, option);
+    });
+}
+
+void TFTView_Common::ui_event_labelDeleted(lv_event_t *e)
+{
+    THIS->labels.unbind(lv_event_get_target(e));
 }
 
 /**
@@ -5917,6 +6229,7 @@ void TFTView_Common::eraseChat(uint32_t channelOrNode)
         lv_obj_del(messages.at(nodeNum));
         messages.erase(nodeNum);
         chats.erase(nodeNum);
+        nodeEviction.setPinned(nodeNum, false);
     }
 }
 
@@ -5932,6 +6245,7 @@ void TFTView_Common::clearChatHistory(void)
             channelGroup[it.first] = nullptr;
         } else {
             lv_obj_delete(messages[it.first]);
+            nodeEviction.setPinned(it.first, false);
         }
     }
     chats.clear();
@@ -6005,12 +6319,13 @@ void TFTView_Common::handleAddMessage(char *msg)
         ch = (uint8_t)channelOrNode;
         requestId = requests.addRequest(ch, ResponseHandler::TextMessageRequest, (void *)(long)ch, callback);
     } else {
-        ch = (uint8_t)(unsigned long)nodes[channelOrNode]->user_data;
+        uint32_t slot = nodeDB.find(channelOrNode);
+        ch = nodeDB.channel(slot);
         to = channelOrNode;
-        usePkc = (unsigned long)nodes[to]->LV_OBJ_IDX(node_bat_idx)->user_data; // hasKey
+        usePkc = nodeDB.hasFlag(slot, NodeDB::eHasKey) && !nodeDB.hasFlag(slot, NodeDB::eKeyMismatch);
         requestId = requests.addRequest(to, ResponseHandler::TextMessageRequest, (void *)to, callback);
         // trial: hoplimit optimization for direct text messages
-        int8_t hopsAway = (signed long)nodes[to]->LV_OBJ_IDX(node_sig_idx)->user_data;
+        int8_t hopsAway = nodeDB.hopsAway(slot);
         if (hopsAway < 0)
             hopsAway = db.config.lora.hop_limit;
         hopLimit = (hopsAway < db.config.lora.hop_limit ? hopsAway + 1 : hopsAway);
@@ -6031,58 +6346,24 @@ void TFTView_Common::handleAddMessage(char *msg)
 void TFTView_Common::addMessage(lv_obj_t *container, uint32_t msgTime, uint32_t requestId, char *msg,
                                  LogMessage::MsgStatus status)
 {
-    lv_obj_t *hiddenPanel = lv_obj_create(container);
-    lv_obj_set_width(hiddenPanel, lv_pct(100));
-    lv_obj_set_height(hiddenPanel, LV_SIZE_CONTENT);
-    lv_obj_set_align(hiddenPanel, LV_ALIGN_CENTER);
-    lv_obj_clear_flag(hiddenPanel, LV_OBJ_FLAG_SCROLLABLE);
-    lv_obj_set_style_radius(hiddenPanel, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    add_style_panel_style(hiddenPanel);
-
-    lv_obj_set_style_border_width(hiddenPanel, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_pad_left(hiddenPanel, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_pad_right(hiddenPanel, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_pad_top(hiddenPanel, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_pad_bottom(hiddenPanel, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    hiddenPanel->user_data = (void *)requestId;
-
     // add timestamp
     char buf[284]; // 237 + 4 + 40 + 2 + 1
     buf[0] = '\0';
     uint32_t len = timestamp(buf, msgTime, status == LogMessage::eNone);
     strcat(&buf[len], msg);
 
-    lv_obj_t *textLabel = lv_label_create(hiddenPanel);
-    // calculate expected size of text bubble, to make it look nicer
-    lv_coord_t width = lv_txt_get_width(buf, strlen(buf), &ui_font_montserrat_12, 0);
-    lv_obj_set_width(textLabel, std::max<int32_t>(std::min<int32_t>(width, 200) + 10, 40));
-    lv_obj_set_height(textLabel, LV_SIZE_CONTENT);
-    lv_obj_set_y(textLabel, 0);
-    lv_obj_set_align(textLabel, LV_ALIGN_RIGHT_MID);
-    lv_label_set_text(textLabel, buf);
-
-    add_style_chat_message_style(textLabel);
-
-    lv_obj_scroll_to_view(hiddenPanel, LV_ANIM_ON);
+    VirtualChat *chat = chatList(container);
+    chat->messages().add(buf, true, 0, requestId, status);
+    chat->changed();
+    chat->scrollToEnd(LV_ANIM_ON);
     lv_obj_move_foreground(objects.message_input_area);
-
-    switch (status) {
-    case LogMessage::eHeard:
-        lv_obj_set_style_border_color(textLabel, colorYellow, LV_PART_MAIN | LV_STATE_DEFAULT);
-        break;
-    case LogMessage::eAcked:
-        lv_obj_set_style_border_color(textLabel, colorBlueGreen, LV_PART_MAIN | LV_STATE_DEFAULT);
-        break;
-    case LogMessage::eFailed:
-        lv_obj_set_style_border_color(textLabel, colorRed, LV_PART_MAIN | LV_STATE_DEFAULT);
-        break;
-    default:
-        break;
-    }
 }
+
 void TFTView_Common::setMyInfo(uint32_t nodeNum)
 {
     ownNode = nodeNum;
+    nodes.setPinned(nodeNum);
+    nodeEviction.remove(nodeNum); // never evicted
 }
 
 void TFTView_Common::setDeviceMetaData(int hw_model, const char *version, bool has_bluetooth, bool has_wifi, bool has_eth,
@@ -6130,26 +6411,17 @@ void TFTView_Common::updatePosition(uint32_t nodeNum, int32_t lat, int32_t lon,
             myLatitude = lat;
             myLongitude = lon;
 
-            // go through existing node list and update distance
-            // TODO: need incremental update!?
-            for (auto &it : nodes) {
-                if (it.first != ownNode) {
-                    int32_t nlat = (long)it.second->LV_OBJ_IDX(node_pos1_idx)->user_data;
-                    int32_t nlon = (long)it.second->LV_OBJ_IDX(node_pos2_idx)->user_data;
-                    if (nlat != 0 && nlon != 0) {
-                        updateDistance(it.first, nlat, nlon);
-                    }
-                }
-            }
+            // node distances are recomputed in batches by task_handler() once we moved far enough
+            distances.setOrigin(lat, lon);
             // update own location on map
             if (map)
                 map->setGpsPosition(lat * 1e-7, lon * 1e-7);
         }
+    } else if (!nodes.contains(nodeNum)) {
+        return; // nothing is kept for nodes that are not listed, the node list is capped
     } else {
         if (lat != 0 && lon != 0) {
-            if (hasPosition) {
-                updateDistance(nodeNum, lat, lon);
-            }
+            distances.setPosition(nodeNum, lat, lon);
             addOrUpdateMap(nodeNum, lat, lon);
         }
     }
@@ -6157,53 +6429,25 @@ void TFTView_Common::updatePosition(uint32_t nodeNum, int32_t lat, int32_t lon,
     if (lat != 0 && lon != 0) {
         char buf[32];
         sprintf(buf, "%.5f %.5f", lat * 1e-7, lon * 1e-7);
-        lv_obj_t *panel = nodes[nodeNum];
-        lv_label_set_text(panel->LV_OBJ_IDX(node_pos1_idx), buf);
+        bool changed = nodes.setText(nodeNum, NodeList::ePosition1, buf);
         if (sats)
             sprintf(buf, "%d%s MSL  %u sats", altU, units, sats);
         sprintf(buf, "%d%s MSL", altU, units);
-        lv_label_set_text(panel->LV_OBJ_IDX(node_pos2_idx), buf);
-        // store lat/lon in user_data, because we need these values later to calculate the distance to us
-        panel->LV_OBJ_IDX(node_pos1_idx)->user_data = (void *)lat;
-        panel->LV_OBJ_IDX(node_pos2_idx)->user_data = (void *)lon;
-        lv_obj_remove_flag(panel->LV_OBJ_IDX(node_pos1_idx), LV_OBJ_FLAG_HIDDEN);
-        lv_obj_remove_flag(panel->LV_OBJ_IDX(node_pos2_idx), LV_OBJ_FLAG_HIDDEN);
+        changed |= nodes.setText(nodeNum, NodeList::ePosition2, buf);
+        // keep lat/lon, because we need these values later to calculate the distance to us
+        nodeDB.setPosition(nodeDB.add(nodeNum), lat, lon);
+        if (changed)
+            refreshNode(nodeNum);
     }
 
     applyNodesFilter(nodeNum);
 }
 
-void TFTView_Common::updateDistance(uint32_t nodeNum, int32_t lat, int32_t lon)
+void TFTView_Common::updateDistance(uint32_t nodeNum, const char *distance)
 {
-    // if we know our position then calculate (simple) distance to other node in km
-    float dx = 71.5 * 1e-7 * (myLongitude - lon);
-    float dy = 111.3 * 1e-7 * (myLatitude - lat);
-    float dist = sqrt(dx * dx + dy * dy);
-
-    // add distance to user short field
-    char buf[32];
-    char *userData = (char *)&(nodes[nodeNum]->LV_OBJ_IDX(node_lbs_idx)->user_data);
-    buf[0] = userData[0];
-    buf[1] = userData[1];
-    buf[2] = userData[2];
-    buf[3] = userData[3];
-    buf[4] = '\n';
-
-    if (db.config.display.units == meshtastic_Config_DisplayConfig_DisplayUnits_METRIC) {
-        if (dist > 1.0)
-            sprintf(&buf[5], "%.1f km ", dist);
-        else
-            sprintf(&buf[5], "%d m ", (uint32_t)round(dist * 1000));
-    } else {
-        if (dist > 0.1)
-            sprintf(&buf[5], "%.1f mi ", round(dist * 0.621371));
-        else
-            sprintf(&buf[5], "%d ft ", uint32_t(dist * 3280.84));
-    }
-    // we used the userShort label to add the distance, so re-arrange a bit the position
-    lv_obj_t *userShort = nodes[nodeNum]->LV_OBJ_IDX(node_lbs_idx);
-    lv_label_set_text(userShort, buf);
-    lv_obj_set_pos(userShort, 30, -1);
+    // the distance is shown below the short name
+    if (nodes.setText(nodeNum, NodeList::eDistance, distance))
+        refreshNode(nodeNum);
 }
 
 /**
@@ -6217,12 +6461,27 @@ void TFTView_Common::updateDistance(uint32_t nodeNum, int32_t lat, int32_t lon)
  */
 void TFTView_Common::updateMetrics(uint32_t nodeNum, uint32_t bat_level, float voltage, float chUtil, float airUtil)
 {
-    auto it = nodes.find(nodeNum);
-    if (it != nodes.end()) {
+    if (nodes.contains(nodeNum)) {
+        uint32_t slot = nodeDB.find(nodeNum);
+        if (slot != NodeDB::c_noSlot)
+            nodeDB.setBattery(slot, std::min(bat_level, (uint32_t)255));
+        nodeUpdates.setMetrics(nodeNum, NodeUpdates::Metrics{bat_level, voltage, chUtil, airUtil});
+    }
+}
+
+/**
+ * @brief Show the latest device metrics of a node, called once per frame
+ */
+void TFTView_Common::showMetrics(uint32_t nodeNum, const NodeUpdates::Metrics &metrics)
+{
+    if (nodes.contains(nodeNum)) {
+        uint32_t bat_level = metrics.batteryLevel;
+        float voltage = metrics.voltage;
         char buf[48];
-        if (it->first == ownNode) {
-            sprintf(buf, _("Util %0.1f%%  Air %0.1f%%"), chUtil, airUtil);
-            lv_label_set_text(it->second->LV_OBJ_IDX(node_sig_idx), buf);
+        bool changed = false;
+        if (nodeNum == ownNode) {
+            sprintf(buf, _("Util %0.1f%%  Air %0.1f%%"), metrics.channelUtil, metrics.airUtil);
+            changed = nodes.setText(nodeNum, NodeList::eSignal, buf);
 
             // update battery percentage and symbol
             if (bat_level != 0 || voltage != 0) {
@@ -6269,55 +6528,64 @@ void TFTView_Common::updateMetrics(uint32_t nodeNum, uint32_t bat_level, float v
                 }
                 Themes::recolorTopLabel(objects.battery_percentage_label, alert);
                 lv_obj_set_style_bg_image_recolor_opa(objects.battery_image, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
-                lv_label_set_text(objects.battery_percentage_label, buf);
+                setLabelText(objects.battery_percentage_label, buf);
             }
         }
 
         if (bat_level != 0 || voltage != 0) {
             bat_level = std::min(bat_level, (uint32_t)100);
             sprintf(buf, "%d%% %0.2fV", bat_level, voltage);
-            lv_label_set_text(it->second->LV_OBJ_IDX(node_bat_idx), buf);
+            changed |= nodes.setText(nodeNum, NodeList::eBattery, buf);
         }
+        if (changed)
+            refreshNode(nodeNum);
     }
 }
 
 void TFTView_Common::updateEnvironmentMetrics(uint32_t nodeNum, const meshtastic_EnvironmentMetrics &metrics)
 {
-    auto it = nodes.find(nodeNum);
-    if (it != nodes.end()) {
+    if (nodes.contains(nodeNum)) {
+        nodeUpdates.setEnvironment(nodeNum, NodeUpdates::Environment{metrics.temperature, metrics.relative_humidity,
+                                                                     metrics.barometric_pressure, metrics.iaq, metrics.voltage,
+                                                                     metrics.current});
+    }
+}
+
+void TFTView_Common::showEnvironmentMetrics(uint32_t nodeNum, const NodeUpdates::Environment &metrics)
+{
+    if (nodes.contains(nodeNum)) {
         char buf[50];
         if (db.config.display.units == meshtastic_Config_DisplayConfig_DisplayUnits_METRIC) {
-            if ((int)metrics.relative_humidity > 0) {
-                sprintf(buf, "%2.1f°C %d%% %3.1fhPa", metrics.temperature, (int)metrics.relative_humidity,
-                        metrics.barometric_pressure);
+            if ((int)metrics.relativeHumidity > 0) {
+                sprintf(buf, "%2.1f°C %d%% %3.1fhPa", metrics.temperature, (int)metrics.relativeHumidity,
+                        metrics.barometricPressure);
             } else {
-                sprintf(buf, "%2.1f°C %3.1fhPa", metrics.temperature, metrics.barometric_pressure);
+                sprintf(buf, "%2.1f°C %3.1fhPa", metrics.temperature, metrics.barometricPressure);
             }
         } else {
-            if ((int)metrics.relative_humidity > 0) {
-                sprintf(buf, "%2.1f°F %d%% %3.1finHg", metrics.temperature * 9 / 5 + 32, (int)metrics.relative_humidity,
-                        metrics.barometric_pressure / 33.86f);
+            if ((int)metrics.relativeHumidity > 0) {
+                sprintf(buf, "%2.1f°F %d%% %3.1finHg", metrics.temperature * 9 / 5 + 32, (int)metrics.relativeHumidity,
+                        metrics.barometricPressure / 33.86f);
             } else {
-                sprintf(buf, "%2.1f°F %3.1finHg", metrics.temperature * 9 / 5 + 32, metrics.barometric_pressure / 33.86f);
+                sprintf(buf, "%2.1f°F %3.1finHg", metrics.temperature * 9 / 5 + 32, metrics.barometricPressure / 33.86f);
             }
         }
-        lv_label_set_text(it->second->LV_OBJ_IDX(node_tm1_idx), buf);
-        lv_obj_remove_flag(it->second->LV_OBJ_IDX(node_tm1_idx), LV_OBJ_FLAG_HIDDEN);
+        bool changed = nodes.setText(nodeNum, NodeList::eTelemetry1, buf);
 
         if (metrics.iaq > 0 && metrics.iaq < 1000) {
-            sprintf(buf, "IAQ: %d %.1fV %.1fmA", metrics.iaq, metrics.voltage, metrics.current);
-            lv_label_set_text(it->second->LV_OBJ_IDX(node_tm2_idx), buf);
-            it->second->LV_OBJ_IDX(node_tm2_idx)->user_data = (void *)(uint32_t)metrics.iaq;
-            lv_obj_remove_flag(it->second->LV_OBJ_IDX(node_tm2_idx), LV_OBJ_FLAG_HIDDEN);
+            sprintf(buf, "IAQ: %d %.1fV %.1fmA", (int)metrics.iaq, metrics.voltage, metrics.current);
+            changed |= nodes.setText(nodeNum, NodeList::eTelemetry2, buf);
+            nodes.setIaq(nodeNum, (uint16_t)metrics.iaq);
         }
-        applyNodesFilter(nodeNum);
+        // the telemetry filter and highlight depend on these texts
+        if (changed)
+            applyNodesFilter(nodeNum);
     }
 }
 
 void TFTView_Common::updateAirQualityMetrics(uint32_t nodeNum, const meshtastic_AirQualityMetrics &metrics)
 {
-    auto it = nodes.find(nodeNum);
-    if (it != nodes.end() && it->first != ownNode) {
+    if (nodes.contains(nodeNum) && nodeNum != ownNode) {
         // TODO
         // char buf[32];
         // sprintf(buf, "%d %d", metrics.particles_03um, metrics.pm100_environmental);
@@ -6327,8 +6595,7 @@ void TFTView_Common::updateAirQualityMetrics(uint32_t nodeNum, const meshtastic_
 
 void TFTView_Common::updatePowerMetrics(uint32_t nodeNum, const meshtastic_PowerMetrics &metrics)
 {
-    auto it = nodes.find(nodeNum);
-    if (it != nodes.end() && it->first != ownNode) {
+    if (nodes.contains(nodeNum) && nodeNum != ownNode) {
         // TODO
         // char buf[32];
         // sprintf(buf, "%0.1fmA %0.2fV", metrics.ch1_current, metrics.ch1_voltage);
@@ -6341,34 +6608,82 @@ void TFTView_Common::updatePowerMetrics(uint32_t nodeNum, const meshtastic_Power
  */
 void TFTView_Common::updateSignalStrength(uint32_t nodeNum, int32_t rssi, float snr)
 {
-    if (nodeNum != ownNode) {
-        auto it = nodes.find(nodeNum);
-        if (it != nodes.end()) {
-            char buf[32];
-            if (rssi == 0 && snr == 0.0) {
-                buf[0] = '\0';
-            } else {
-                sprintf(buf, "rssi: %d snr: %.1f", rssi, snr);
-            }
-            lv_label_set_text(it->second->LV_OBJ_IDX(node_sig_idx), buf);
-            it->second->LV_OBJ_IDX(node_sig_idx)->user_data = 0;
+    if (nodeNum != ownNode && nodes.contains(nodeNum)) {
+        uint32_t slot = nodeDB.find(nodeNum);
+        if (slot != NodeDB::c_noSlot) {
+            nodeDB.setHopsAway(slot, 0);
+            nodeDB.setSnr(slot, snr);
         }
+        nodeUpdates.setSignal(nodeNum, rssi, snr);
     }
 }
 
-void TFTView_Common::updateHopsAway(uint32_t nodeNum, uint8_t hopsAway)
+void TFTView_Common::showSignalStrength(uint32_t nodeNum, int32_t rssi, float snr)
 {
-    if (nodeNum != ownNode) {
-        auto it = nodes.find(nodeNum);
-        if (it != nodes.end()) {
-            char buf[32];
-            sprintf(buf, _("hops: %d"), (int)hopsAway);
-            lv_label_set_text(it->second->LV_OBJ_IDX(node_sig_idx), buf);
-            it->second->LV_OBJ_IDX(node_sig_idx)->user_data = (void *)(unsigned long)hopsAway;
+    if (nodes.contains(nodeNum)) {
+        char buf[32];
+        if (rssi == 0 && snr == 0.0) {
+            buf[0] = '\0';
+        } else {
+            sprintf(buf, "rssi: %d snr: %.1f", rssi, snr);
         }
+        if (nodes.setText(nodeNum, NodeList::eSignal, buf))
+            refreshNode(nodeNum);
+    }
+}
+
+void TFTView_Common::updateHopsAway(uint32_t nodeNum, uint8_t hopsAway)
+{
+    if (nodeNum != ownNode && nodes.contains(nodeNum)) {
+        uint32_t slot = nodeDB.find(nodeNum);
+        if (slot != NodeDB::c_noSlot)
+            nodeDB.setHopsAway(slot, hopsAway);
+        nodeUpdates.setHopsAway(nodeNum, hopsAway);
+    }
+}
+
+void TFTView_Common::showHopsAway(uint32_t nodeNum, uint8_t hopsAway)
+{
+    if (nodes.contains(nodeNum)) {
+        char buf[32];
+        sprintf(buf, _("hops: %d"), (int)hopsAway);
+        if (nodes.setText(nodeNum, NodeList::eSignal, buf))
+            refreshNode(nodeNum);
     }
 }
 
+/**
+ * @brief Apply all node updates recorded since the last frame, before lvgl renders it
+ */
+void TFTView_Common::flushNodeUpdates(void)
+{
+    nodeUpdates.flush([this](const NodeUpdates::Update &u) {
+        if (u.dirty & NodeUpdates::eMetrics)
+            showMetrics(u.nodeNum, u.metrics);
+        if (u.dirty & NodeUpdates::eEnvironment)
+            showEnvironmentMetrics(u.nodeNum, u.environment);
+        if (u.dirty & NodeUpdates::eSignal)
+            showSignalStrength(u.nodeNum, u.rssi, u.snr);
+        if (u.dirty & NodeUpdates::eHopsAway)
+            showHopsAway(u.nodeNum, u.hopsAway);
+        if (u.dirty & NodeUpdates::eLastHeard)
+            showLastHeard(u.nodeNum, u.cameOnline);
+    });
+}
+
+/**
+ * @brief Set the label text only if it differs, so that an unchanged value does not
+ *        invalidate the label
+ * @return true if the text was changed
+ */
+bool TFTView_Common::setLabelText(lv_obj_t *label, const char *text)
+{
+    if (strcmp(lv_label_get_text(label), text) == 0)
+        return false;
+    lv_label_set_text(label, text);
+    return true;
+}
+
 void TFTView_Common::updateConnectionStatus(const meshtastic_DeviceConnectionStatus &status)
 {
     const bool wasWifiConnected = db.connectionStatus.has_wifi && db.connectionStatus.wifi.has_status &&
@@ -6535,11 +6850,12 @@ void TFTView_Common::handleResponse(uint32_t from, const uint32_t id, const mesh
             if (req.type == ResponseHandler::TextMessageRequest) {
                 handleTextMessageResponse((unsigned long)req.cookie, id, ack, true);
                 // we probably have a wrong key; mark it as bad and don't use in future
-                if ((unsigned long)nodes[from]->LV_OBJ_IDX(node_bat_idx)->user_data == 1) {
+                uint32_t slot = nodeDB.find(from);
+                if (slot != NodeDB::c_noSlot && nodeDB.hasFlag(slot, NodeDB::eHasKey) &&
+                    !nodeDB.hasFlag(slot, NodeDB::eKeyMismatch)) {
                     ILOG_DEBUG("public key mismatch");
-                    nodes[from]->LV_OBJ_IDX(node_bat_idx)->user_data = (void *)2;
-                    lv_obj_set_style_border_color(nodes[from]->LV_OBJ_IDX(node_img_idx), colorRed,
-                                                  LV_PART_MAIN | LV_STATE_DEFAULT);
+                    nodeDB.setFlag(slot, NodeDB::eKeyMismatch, true);
+                    refreshNode(from);
                     lv_obj_set_style_bg_image_src(objects.top_messages_node_image, &img_lock_slash_image,
                                                   LV_PART_MAIN | LV_STATE_DEFAULT);
                 }
@@ -6575,7 +6891,7 @@ void TFTView_Common::scanSignal(uint32_t scanNo)
     } else {
         uint32_t requestId;
         uint32_t to = currentNode;
-        uint8_t ch = (uint8_t)(unsigned long)currentPanel->user_data;
+        uint8_t ch = nodeDB.channel(nodeDB.find(to));
         requestId = requests.addRequest(to, ResponseHandler::PositionRequest, (void *)to);
         controller->requestPosition(to, ch, requestId);
         objects.signal_scanner_panel->user_data = (void *)requestId;
@@ -6645,12 +6961,9 @@ void TFTView_Common::handleResponse(uint32_t from, uint32_t id, const meshtastic
 
 void TFTView_Common::addNodeToTraceRoute(uint32_t nodeNum, lv_obj_t *panel)
 {
-    // check if node exists, and get its panel
-    lv_obj_t *nodePanel = nullptr;
-    auto it = nodes.find(nodeNum);
-    if (it != nodes.end()) {
-        nodePanel = it->second;
-    }
+    // check if node exists
+    bool listed = nodes.contains(nodeNum);
+    uint32_t slot = nodeDB.find(nodeNum);
     lv_obj_t *btn = lv_btn_create(panel);
     lv_obj_set_pos(btn, 0, 0);
     lv_obj_set_size(btn, LV_PCT(100), 38);
@@ -6666,9 +6979,8 @@ void TFTView_Common::addNodeToTraceRoute(uint32_t nodeNum, lv_obj_t *panel)
     {
         {
             lv_obj_t *img = lv_img_create(btn);
-            if (nodePanel) {
-                setNodeImage(nodeNum, (MeshtasticView::eRole)(unsigned long)nodePanel->LV_OBJ_IDX(node_img_idx)->user_data, false,
-                             img);
+            if (listed) {
+                setNodeImage(nodeNum, img);
             } else {
                 setNodeImage(0, eRole::unknown, false, img);
             }
@@ -6687,14 +6999,12 @@ void TFTView_Common::addNodeToTraceRoute(uint32_t nodeNum, lv_obj_t *panel)
             lv_obj_set_pos(label, 35, 10);
             lv_obj_set_size(label, LV_PCT(80), LV_SIZE_CONTENT);
             lv_label_set_long_mode(label, LV_LABEL_LONG_SCROLL);
-            if (nodePanel) {
+            if (listed && slot != NodeDB::c_noSlot) {
                 if (nodeNum != ownNode) {
-                    lv_obj_add_event_cb(btn, ui_event_trace_route_node, LV_EVENT_CLICKED, nodePanel);
-                    lv_label_set_text(label, lv_label_get_text(nodePanel->LV_OBJ_IDX(node_lbs_idx)));
-                    if (strlen(lv_label_get_text(label)) >= 5)
-                        lv_obj_set_pos(label, 35, -1);
+                    lv_obj_add_event_cb(btn, ui_event_trace_route_node, LV_EVENT_CLICKED, (void *)(unsigned long)nodeNum);
+                    lv_label_set_text(label, nodeDB.shortName(slot));
                 } else {
-                    lv_label_set_text(label, lv_label_get_text(nodePanel->LV_OBJ_IDX(node_lbl_idx)));
+                    lv_label_set_text(label, nodeDB.longName(slot));
                 }
             } else {
                 char buf[20];
@@ -6739,23 +7049,12 @@ void TFTView_Common::handleTextMessageResponse(uint32_t channelOrNode, const uin
         ILOG_WARN("received unexpected response nodeNum/channel 0x%08x for request id 0x%08x", channelOrNode, id);
         return;
     }
-    // go through all hiddenPanels and search for requestId
-    uint16_t i = msgContainer->spec_attr->child_cnt;
-    while (i-- > 0) {
-        lv_obj_t *panel = msgContainer->spec_attr->children[i];
-        uint32_t requestId = (unsigned long)panel->user_data;
-        if (requestId == id) {
-            // now give the textlabel border another color
-            lv_obj_t *textLabel = panel->spec_attr->children[0];
-            lv_obj_set_style_border_color(textLabel,
-                                          err   ? colorRed
-                                          : ack ? colorBlueGreen
-                                                : colorYellow,
-                                          LV_PART_MAIN | LV_STATE_DEFAULT);
-
-            // store message
-            break;
-        }
+    // search the sent message with requestId, a bubble only exists if it is visible
+    VirtualChat *chat = VirtualChat::of(msgContainer);
+    uint32_t index = chat ? chat->messages().findRequest(id) : ChatLayout::c_none;
+    if (index != ChatLayout::c_none) {
+        chat->messages().setStatus(index, err ? LogMessage::eFailed : ack ? LogMessage::eAcked : LogMessage::eHeard);
+        chat->refresh(index);
     }
 }
 
@@ -6971,11 +7270,8 @@ void TFTView_Common::updateDeviceConfig(const meshtastic_Config_DeviceConfig &cf
     db.config.device = cfg;
     db.config.has_device = true;
 
-    char buf1[30], buf2[40];
     lv_dropdown_set_selected(objects.settings_device_role_dropdown, role2val(cfg.role));
-    lv_dropdown_get_selected_str(objects.settings_device_role_dropdown, buf1, sizeof(buf1));
-    lv_snprintf(buf2, sizeof(buf2), _("Device Role: %s"), buf1);
-    lv_label_set_text(objects.basic_settings_role_label, buf2);
+    bindOptionLabel(objects.basic_settings_role_label, _("Device Role: %s"), objects.settings_device_role_dropdown);
 }
 
 void TFTView_Common::updatePositionConfig(const meshtastic_Config_PositionConfig &cfg)
@@ -7003,15 +7299,18 @@ void TFTView_Common::updateNetworkConfig(const meshtastic_Config_NetworkConfig &
     db.config.network = cfg;
     db.config.has_network = true;
 
-    char buf[40];
-    lv_snprintf(buf, sizeof(buf), _("WiFi: %s"), cfg.wifi_ssid[0] ? cfg.wifi_ssid : _("<not set>"));
-    lv_label_set_text(objects.basic_settings_wifi_label, buf);
+    if (cfg.wifi_ssid[0])
+        bindLabel(objects.basic_settings_wifi_label, _("WiFi: %s"), cfg.wifi_ssid);
+    else
+        bindLabel(objects.basic_settings_wifi_label, _("WiFi: %s"),
+                  [](char *buf, size_t size, const char *fmt) { lv_snprintf(buf, size, fmt, _("<not set>")); });
 }
 
 void TFTView_Common::updateDisplayConfig(const meshtastic_Config_DisplayConfig &cfg)
 {
     db.config.display = cfg;
     db.config.has_display = true;
+    distances.setMetric(cfg.units == meshtastic_Config_DisplayConfig_DisplayUnits_METRIC);
     if (!controller->isStandalone() && cfg.displaymode != meshtastic_Config_DisplayConfig_DisplayMode_COLOR) {
         meshtastic_Config_DisplayConfig &display = db.config.display;
         display.displaymode = meshtastic_Config_DisplayConfig_DisplayMode_COLOR;
@@ -7030,22 +7329,17 @@ void TFTView_Common::updateLoRaConfig(const meshtastic_Config_LoRaConfig &cfg)
             db.config.lora.channel_num = LoRaPresets::getDefaultSlot(db.config.lora.region, THIS->db.config.lora.modem_preset,
                                                                      THIS->db.channel[0].settings.name);
         }
-        char buf1[20], buf2[32];
         lv_dropdown_set_selected(objects.settings_modem_preset_dropdown, preset2val(cfg.modem_preset));
-        lv_dropdown_get_selected_str(objects.settings_modem_preset_dropdown, buf1, sizeof(buf1));
-        lv_snprintf(buf2, sizeof(buf2), _("Modem Preset: %s"), buf1);
-        lv_label_set_text(objects.basic_settings_modem_preset_label, buf2);
+        bindOptionLabel(objects.basic_settings_modem_preset_label, _("Modem Preset: %s"), objects.settings_modem_preset_dropdown);
 
         uint32_t numChannels = LoRaPresets::getNumChannels(cfg.region, cfg.modem_preset);
         lv_slider_set_range(objects.frequency_slot_slider, 1, numChannels);
         lv_slider_set_value(objects.frequency_slot_slider, db.config.lora.channel_num, LV_ANIM_OFF);
     } else {
-        lv_label_set_text(objects.basic_settings_modem_preset_label, _("Modem Preset: custom"));
+        bindLabel(objects.basic_settings_modem_preset_label, _("Modem Preset: custom"));
     }
 
-    char region[30];
-    lv_snprintf(region, sizeof(region), _("Region: %s"), LoRaPresets::loRaRegionToString(cfg.region));
-    lv_label_set_text(objects.basic_settings_region_label, region);
+    bindLabel(objects.basic_settings_region_label, _("Region: %s"), LoRaPresets::loRaRegionToString(cfg.region));
 
     showLoRaFrequency(db.config.lora);
 
@@ -7089,21 +7383,21 @@ void TFTView_Common::showLoRaFrequency(const meshtastic_Config_LoRaConfig &cfg)
 void TFTView_Common::setBellText(bool banner, bool sound)
 {
     if (banner && sound) {
-        lv_label_set_text(objects.home_bell_label, _("Banner & Sound"));
+        bindLabel(objects.home_bell_label, _("Banner & Sound"));
     } else if (banner) {
-        lv_label_set_text(objects.home_bell_label, _("Banner only"));
+        bindLabel(objects.home_bell_label, _("Banner only"));
     } else if (sound) {
-        lv_label_set_text(objects.home_bell_label, _("Sound only"));
+        bindLabel(objects.home_bell_label, _("Sound only"));
     } else {
-        lv_label_set_text(objects.home_bell_label, _("silent"));
+        bindLabel(objects.home_bell_label, _("silent"));
     }
 
-    char buf[40];
-    lv_snprintf(buf, sizeof(buf), _("Message Alert: %s"),
-                db.module_config.external_notification.alert_message_buzzer
-                    ? (!sound ? _("silent") : ringtone[db.uiConfig.ring_tone_id].name)
-                    : "off");
-    lv_label_set_text(objects.basic_settings_alert_label, buf);
+    bool buzzer = db.module_config.external_notification.alert_message_buzzer;
+    const char *tone = ringtone[db.uiConfig.ring_tone_id].name;
+    bindLabel(objects.basic_settings_alert_label, _("Message Alert: %s"),
+              [buzzer, sound, tone](char *buf, size_t size, const char *fmt) {
+                  lv_snprintf(buf, size, fmt, buzzer ? (!sound ? _("silent") : tone) : "off");
+              });
 
     Themes::recolorButton(objects.home_bell_button, banner || sound);
     Themes::recolorText(objects.home_bell_label, banner || sound);
@@ -7116,18 +7410,12 @@ void TFTView_Common::setChannelName(const meshtastic_Channel &ch)
 {
     char buf[40];
     if (ch.role == meshtastic_Channel_Role_PRIMARY) {
-        sprintf(buf, _("Channel: %s"),
-                strlen(ch.settings.name) ? ch.settings.name
-                : db.config.lora.region == meshtastic_Config_LoRaConfig_RegionCode_UNSET
-                    ? ("<unset>")
-                    : LoRaPresets::modemPresetToString(db.config.lora.modem_preset));
-        lv_label_set_text(objects.basic_settings_channel_label, buf);
-
-        sprintf(buf, "*%s",
-                strlen(ch.settings.name) ? ch.settings.name
-                : db.config.lora.region == meshtastic_Config_LoRaConfig_RegionCode_UNSET
-                    ? ("<unset>")
-                    : LoRaPresets::modemPresetToString(db.config.lora.modem_preset));
+        const char *name = strlen(ch.settings.name) ? ch.settings.name
+                           : db.config.lora.region == meshtastic_Config_LoRaConfig_RegionCode_UNSET
+                               ? ("<unset>")
+                               : LoRaPresets::modemPresetToString(db.config.lora.modem_preset);
+        bindLabel(objects.basic_settings_channel_label, _("Channel: %s"), name);
+        sprintf(buf, "*%s", name);
     } else {
         if (ch.settings.name[0] == '\0' && ch.settings.psk.size == 1 && ch.settings.psk.bytes[0] == 0x01) {
             sprintf(buf, "%s", LoRaPresets::modemPresetToString(db.config.lora.modem_preset));
@@ -7334,12 +7622,9 @@ void TFTView_Common::updateExtNotificationModule(const meshtastic_ModuleConfig_E
     db.module_config.external_notification = cfg;
     db.module_config.has_external_notification = true;
 
-    char buf[32];
-    lv_snprintf(buf, sizeof(buf), _("Message Alert: %s"),
-                db.module_config.external_notification.alert_message_buzzer && db.module_config.external_notification.enabled
-                    ? _("on")
-                    : _("off"));
-    lv_label_set_text(objects.basic_settings_alert_label, buf);
+    bool on = db.module_config.external_notification.alert_message_buzzer && db.module_config.external_notification.enabled;
+    bindLabel(objects.basic_settings_alert_label, _("Message Alert: %s"),
+              [on](char *buf, size_t size, const char *fmt) { lv_snprintf(buf, size, fmt, on ? _("on") : _("off")); });
 }
 
 void TFTView_Common::updateRingtone(const char rtttl[231])
@@ -7533,7 +7818,9 @@ void TFTView_Common::setGroupFocus(lv_obj_t *panel)
     if (panel == objects.home_panel) {
         lv_group_focus_obj(objects.home_mail_button);
     } else if (panel == objects.nodes_panel) {
-        lv_group_focus_obj(objects.node_button);
+        lv_obj_t *row = nodeList->rowOf(nodeList->first());
+        if (row)
+            lv_group_focus_obj(row->LV_OBJ_IDX(node_btn_idx));
     } else if (panel == objects.groups_panel) {
         lv_group_focus_obj(objects.channel_button0);
     } else if (panel == objects.messages_panel) {
@@ -7583,9 +7870,10 @@ void TFTView_Common::setInputButtonLabel(void)
     std::string current_kbd = inputdriver->getCurrentKeyboardDevice();
     std::string current_ptr = inputdriver->getCurrentPointerDevice();
 
-    char label[40];
-    lv_snprintf(label, sizeof(label), _("Input Control: %s/%s"), current_ptr.c_str(), current_kbd.c_str());
-    lv_label_set_text(objects.basic_settings_input_label, label);
+    bindLabel(objects.basic_settings_input_label, _("Input Control: %s/%s"),
+              [current_ptr, current_kbd](char *buf, size_t size, const char *fmt) {
+                  lv_snprintf(buf, size, fmt, current_ptr.c_str(), current_kbd.c_str());
+              });
 }
 /**
  * @brief Called once a second to update time label
@@ -7771,11 +8059,32 @@ void TFTView_Common::task_handler(void)
     MeshtasticView::task_handler();
 
     if (screensInitialised) {
+        // node updates of all packets received since the last frame at once
+        flushNodeUpdates();
+        if (nodeRowsChanged)
+            updateNodeList();
+
         syncVirtualKeyboardLayout(objects.keyboard);
 
         if (map)
             map->task_handler();
 
+        // spread distance updates of many nodes over several frames
+        distances.process(c_distanceBatch, [](uint32_t nodeNum, const char *text) { THIS->updateDistance(nodeNum, text); });
+
+        // after a locale switch the labels of the active screen at once, the others spread over several frames
+        if (labels.stale())
+            labels.relabel(
+                [](LabelRegistry::Label label) {
+                    const lv_obj_t *obj = (const lv_obj_t *)label;
+                    return lv_obj_get_screen(obj) == lv_screen_active() && lv_obj_is_visible(obj);
+                },
+                c_relabelBatch);
+
+        // all packets counted since the last frame in one table update
+        if (statisticsChanged)
+            updateStatisticsTable();
+
         if (curtime - lastrun1 >= 1) { // call every 1s
             if (map) {
                 updateLocationMap(THIS->map->getObjectsOnMap());
@@ -7829,8 +8138,8 @@ void TFTView_Common::task_handler(void)
                 }
             }
         }
-        if (processingFilter || nodesChanged) {
-            updateNodesFiltered(nodesChanged);
+        if (nodesChanged) {
+            updateNodesFiltered(true);
         }
     }
 }
@@ -0,0 +1,182 @@
+#include "graphics/common/FrameStats.h"
+#include "util/ILog.h"
+#include <stdio.h>
+
+#if defined(ARCH_PORTDUINO)
+#include <time.h>
+#elif defined(ARCH_ESP32)
+#include "esp_timer.h"
+#else
+#include "Arduino.h"
+#endif
+
+namespace
+{
+constexpr uint32_t c_overlayPeriod = 1000000; // us
+} // namespace
+
+FrameStats &FrameStats::instance(void)
+{
+    static FrameStats stats;
+    return stats;
+}
+
+FrameStats::FrameStats(void)
+    : renderStart(0), flushStart(0), flushUs(0), area(0), rendering(false), numPendingPackets(0),
+      logInterval(FRAME_STATS_LOG_INTERVAL), lastLog(now()), lastOverlay(0), since(lastLog), overlay(nullptr)
+{
+}
+
+uint64_t FrameStats::now(void)
+{
+#if defined(ARCH_PORTDUINO)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return uint64_t(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+#elif defined(ARCH_ESP32)
+    return esp_timer_get_time();
+#else
+    return micros();
+#endif
+}
+
+/**
+ * Flushing includes waiting for a transfer in flush_wait (DMA), as long as it happens within the
+ * frame.
+ */
+void FrameStats::attach(lv_display_t *disp)
+{
+    if (!disp)
+        return;
+    lv_display_add_event_cb(disp, display_event_cb, LV_EVENT_RENDER_START, this);
+    lv_display_add_event_cb(disp, display_event_cb, LV_EVENT_RENDER_READY, this);
+    lv_display_add_event_cb(disp, display_event_cb, LV_EVENT_FLUSH_START, this);
+    lv_display_add_event_cb(disp, display_event_cb, LV_EVENT_FLUSH_FINISH, this);
+    lv_display_add_event_cb(disp, display_event_cb, LV_EVENT_FLUSH_WAIT_START, this);
+    lv_display_add_event_cb(disp, display_event_cb, LV_EVENT_FLUSH_WAIT_FINISH, this);
+}
+
+void FrameStats::timerHandler(uint32_t us)
+{
+    histograms[eTimerHandler].add(us);
+}
+
+/**
+ * Packets arriving while more than c_maxPendingPackets wait for the next frame are not counted.
+ */
+void FrameStats::packetArrived(uint64_t queued)
+{
+    if (numPendingPackets < c_maxPendingPackets)
+        pendingPackets[numPendingPackets++] = queued ? queued : now();
+}
+
+void FrameStats::task_handler(void)
+{
+    uint64_t time = now();
+    if (overlay && time - lastOverlay >= c_overlayPeriod) {
+        lastOverlay = time;
+        updateOverlay();
+    }
+    if (logInterval && time - lastLog >= uint64_t(logInterval) * 1000000) {
+        lastLog = time;
+        log();
+        clear();
+    }
+}
+
+void FrameStats::showOverlay(bool show)
+{
+    if (show && !overlay) {
+        overlay = lv_label_create(lv_layer_top());
+        lv_obj_set_style_bg_color(overlay, lv_color_black(), 0);
+        lv_obj_set_style_bg_opa(overlay, LV_OPA_70, 0);
+        lv_obj_set_style_text_color(overlay, lv_color_white(), 0);
+        lv_obj_set_style_text_font(overlay, &lv_font_montserrat_10, 0);
+        lv_obj_set_style_pad_all(overlay, 2, 0);
+        lv_obj_align(overlay, LV_ALIGN_BOTTOM_RIGHT, 0, 0);
+        lv_obj_remove_flag(overlay, LV_OBJ_FLAG_CLICKABLE);
+        updateOverlay();
+    } else if (!show && overlay) {
+        lv_obj_delete(overlay);
+        overlay = nullptr;
+    }
+}
+
+/**
+ * One line with count, p50/p90/p99/max of each histogram since the last clear().
+ */
+void FrameStats::log(void)
+{
+    static const char *names[eMetrics] = {"timer", "render", "flush", "area", "pkt2screen"};
+    char line[320];
+    int len = snprintf(line, sizeof(line), "frame stats %us:", uint32_t((now() - since) / 1000000));
+    for (int m = 0; m < eMetrics && len < (int)sizeof(line); m++) {
+        const Histogram &h = histograms[m];
+        len += snprintf(line + len, sizeof(line) - len, " %s %u %u/%u/%u/%u", names[m], h.count(), h.percentile(50),
+                        h.percentile(90), h.percentile(99), h.max());
+    }
+    ILOG_INFO("%s", line);
+}
+
+void FrameStats::clear(void)
+{
+    for (Histogram &h : histograms)
+        h.clear();
+    since = now();
+}
+
+void FrameStats::updateOverlay(void)
+{
+    const Histogram &render = histograms[eRender];
+    const Histogram &flush = histograms[eFlush];
+    const Histogram &pixels = histograms[eArea];
+    uint32_t seconds = uint32_t((now() - since) / 1000000);
+    lv_label_set_text_fmt(overlay, "%u fps  timer p99 %ums\nrender %u/%uus  flush %u/%uus\narea %u/%upx",
+                          seconds ? render.count() / seconds : render.count(), histograms[eTimerHandler].percentile(99) / 1000,
+                          render.percentile(50), render.percentile(99), flush.percentile(50), flush.percentile(99),
+                          pixels.percentile(50), pixels.percentile(99));
+}
+
+void FrameStats::display_event_cb(lv_event_t *e)
+{
+    FrameStats *stats = (FrameStats *)lv_event_get_user_data(e);
+    uint64_t time = now();
+    switch (lv_event_get_code(e)) {
+    case LV_EVENT_RENDER_START:
+        stats->renderStart = time;
+        stats->flushUs = 0;
+        stats->area = 0;
+        stats->rendering = true;
+        break;
+    case LV_EVENT_FLUSH_START: {
+        const lv_area_t *area = (const lv_area_t *)lv_event_get_param(e);
+        if (area)
+            stats->area += lv_area_get_size(area);
+        stats->flushStart = time;
+        break;
+    }
+    case LV_EVENT_FLUSH_WAIT_START:
+        stats->flushStart = time;
+        break;
+    case LV_EVENT_FLUSH_FINISH:
+    case LV_EVENT_FLUSH_WAIT_FINISH:
+        if (stats->rendering)
+            stats->flushUs += uint32_t(time - stats->flushStart);
+        break;
+    case LV_EVENT_RENDER_READY: {
+        if (!stats->rendering)
+            break;
+        stats->rendering = false;
+        uint32_t frameUs = uint32_t(time - stats->renderStart);
+        stats->histograms[eRender].add(frameUs > stats->flushUs ? frameUs - stats->flushUs : 0);
+        stats->histograms[eFlush].add(stats->flushUs);
+        stats->histograms[eArea].add(stats->area);
+        for (uint32_t i = 0; i < stats->numPendingPackets; i++)
+            stats->histograms[ePacketToScreen].add(uint32_t(time - stats->pendingPackets[i]));
+        stats->numPendingPackets = 0;
+        break;
+    }
+    default:
+        break;
+    }
+}
@@ -24,6 +24,9 @@ void MeshtasticView::task_handler(void)
     DeviceGUI::task_handler();
     controller->runOnce();
 
+    // expire timed out requests, cheap unless a timeout tick has passed
+    requests.task_handler();
+
     time(&curtime);
     if (curtime - lastrun20 >= 20) {
         lastrun20 = curtime;
@@ -31,9 +34,6 @@ void MeshtasticView::task_handler(void)
         if (!displaydriver->isPowersaving() || state == eProgrammingMode) {
             controller->sendHeartbeat();
         }
-
-        // cleanup queued requests
-        requests.task_handler();
     }
 };
 
@@ -104,14 +104,12 @@ void MeshtasticView::updateLastHeard(uint32_t nodeNum) {}
 void MeshtasticView::packetReceived(const meshtastic_MeshPacket &p)
 {
     // if there's a message from a node we don't know (yet), create it with defaults
-    auto it = nodes.find(p.from);
-    if (it == nodes.end()) {
+    if (!nodes.contains(p.from)) {
         MeshtasticView::addOrUpdateNode(p.from, p.channel, 0, eRole::unknown, false, false);
         updateLastHeard(p.from);
     }
     if (p.to != ownNode && p.to != 0xffffffff) {
-        auto it = nodes.find(p.to);
-        if (it == nodes.end()) {
+        if (!nodes.contains(p.to)) {
             MeshtasticView::addOrUpdateNode(p.to, p.channel, 0, eRole::unknown, false, false);
             updateLastHeard(p.to);
         }
@@ -2,23 +2,29 @@
 #include "Arduino.h"
 #include "util/ILog.h"
 
-uint32_t ResponseHandler::rollingPacketId = 0;
+namespace
+{
+constexpr uint32_t c_timeoutTickMs = 1000;
+constexpr uint32_t c_timeoutSlots = 64; // one revolution covers the default request timeout
+} // namespace
 
 /**
  * @brief Construct a new Response Handler:: Response Handler object
  *
  * @param timeout
  */
-ResponseHandler::ResponseHandler(uint32_t timeout) : requestIdCounter(0), maxTime(timeout)
+ResponseHandler::ResponseHandler(uint32_t timeout)
+    : ids(random(UINT32_MAX & 0x7fffffff) ^ millis()), maxTime(timeout), timeouts(c_timeoutTickMs, c_timeoutSlots, millis())
 {
-    rollingPacketId = random(UINT32_MAX & 0x7fffffff);
 }
 
 uint32_t ResponseHandler::addRequest(uint32_t id, RequestType type, void *cookie, Callback cb)
 {
-    requestIdCounter++;
     uint32_t requestId = generatePacketId();
-    pendingRequest[requestId] = Request{.id = id, .timestamp = millis(), .type = type, .cookie = cookie, .cb = cb};
+    unsigned long now = millis();
+    Pending &pending = pendingRequest[requestId];
+    pending.request = Request{.id = id, .timestamp = now, .type = type, .cookie = cookie, .cb = cb};
+    pending.timer = timeouts.schedule(requestId, now, maxTime);
     return requestId;
 }
 
@@ -26,7 +32,7 @@ ResponseHandler::Request ResponseHandler::findRequest(uint32_t requestId, Reques
 {
     const auto it = pendingRequest.find(requestId);
     if (it != pendingRequest.end()) {
-        Request &req = it->second;
+        Request &req = it->second.request;
         if (req.cb && pass != -1 && (match == anyRequest || match == req.type))
             req.cb(req, found, pass);
         return req;
@@ -39,45 +45,47 @@ ResponseHandler::Request ResponseHandler::removeRequest(uint32_t requestId, Requ
     Request req{};
     const auto it = pendingRequest.find(requestId);
     if (it != pendingRequest.end()) {
-        req = it->second;
+        req = it->second.request;
         ILOG_DEBUG("removing request %08x", it->first);
+        timeouts.cancel(it->second.timer);
+        pendingRequest.erase(it);
         if (req.cb && pass != -1 && (match == anyRequest || match == req.type))
             req.cb(req, removed, pass);
-        pendingRequest.erase(it);
     }
     return req;
 }
 
 /**
  * @brief: Generate a unique packet id
- *
+ *         The sequence cannot repeat within 2^32 requests, the check against the pending
+ *         requests only guards against a derived class mixing in ids of its own.
  */
 uint32_t ResponseHandler::generatePacketId(void)
 {
-    rollingPacketId++;
-    rollingPacketId &= UINT32_MAX >> 22;
-    return rollingPacketId | random(UINT32_MAX & 0x7fffffff) << 10;
+    uint32_t requestId;
+    do {
+        requestId = ids.next();
+    } while (pendingRequest.count(requestId));
+    return requestId;
 }
 
 /**
  * @brief  Garbage collection that is periodically called.
- *         removes all pending requests that timed out
- *
+ *         removes all pending requests that timed out; only the timeout wheel slots of the
+ *         ticks passed since the last call are visited, so it can be called on every loop
  */
 void ResponseHandler::task_handler(void)
 {
-    if (pendingRequest.size())
+    uint32_t expired = timeouts.advance(millis(), [this](uint32_t requestId) {
+        const auto it = pendingRequest.find(requestId);
+        if (it == pendingRequest.end())
+            return;
+        Request req = it->second.request;
+        pendingRequest.erase(it);
+        ILOG_DEBUG("removing timed out request %08x", requestId);
+        if (req.cb)
+            req.cb(req, timeout, 0);
+    });
+    if (expired)
         ILOG_DEBUG("ResponseHandler has %d pending request(s)", pendingRequest.size());
-    auto it = pendingRequest.begin();
-    while (it != pendingRequest.end()) {
-        Request &req = it->second;
-        if (req.timestamp + maxTime < millis()) {
-            ILOG_DEBUG("removing timed out request %08x", it->first);
-            if (req.cb)
-                req.cb(req, timeout, 0);
-            it = pendingRequest.erase(it);
-        } else {
-            it++;
-        }
-    }
 }
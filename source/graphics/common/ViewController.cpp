@@ -1,5 +1,6 @@
 #include "graphics/common/ViewController.h"
 #include "assert.h"
+#include "graphics/common/FrameStats.h"
 #include "graphics/common/MeshtasticView.h"
 #include "util/ILog.h"
 #include "util/LogMessage.h"
@@ -15,14 +16,35 @@ fs::FS &persistentFS = LittleFS;
 
 const size_t DATA_PAYLOAD_LEN = meshtastic_Constants_DATA_PAYLOAD_LEN;
 constexpr const char *logDir = "/messages";
+constexpr const char *summaryFile = "/messages.sum";
+
+#ifndef MAX_RESTORE_MESSAGES_PER_CHAT
+#define MAX_RESTORE_MESSAGES_PER_CHAT 100
+#endif
+#ifndef MESSAGE_LOG_COMPRESSION
+#define MESSAGE_LOG_COMPRESSION 0 // compress rotated message log files (not yet measured on device)
+#endif
+constexpr uint32_t c_restoreBlockSize = 256; // log entries read per runOnce()
+constexpr uint32_t c_restoreBudget = 8;      // ms per runOnce() to create restored messages in the view
+constexpr uint32_t c_summaryChanges = 16;    // chat summary changes that are saved at once
+constexpr time_t c_summaryInterval = 30;     // s, save interval of a modified chat summary
+#if MESSAGE_LOG_COMPRESSION
+// raw size of a log file: chat text compresses about 2.4x (bench_LogCompression), so a segment
+// of 8000 bytes (~3.3kB) still fits into one 4kB flash block
+constexpr uint32_t c_logFileSize = 8000;
+#else
+constexpr uint32_t c_logFileSize = 4000; // fits into one 4kB flash block including fs descriptor data
+#endif
 
 /**
  * @brief mediate between GUI view and client interface
  *
  */
 ViewController::ViewController()
-    : view(nullptr), log(persistentFS, logDir, sizeof(LogMessage)), client(nullptr), sendId(1), myNodeNum(0), setupDone(false),
-      configCompleted(false), messagesRestored(false), requestConfigRequired(true)
+    : view(nullptr), log(persistentFS, logDir, sizeof(LogMessage), 102400, 25, c_logFileSize, MESSAGE_LOG_COMPRESSION),
+      restorer(MAX_RESTORE_MESSAGES_PER_CHAT), summary(persistentFS, summaryFile), client(nullptr), sendId(1), myNodeNum(0),
+      summaryReplayFrom(0), summaryReplayTo(0), setupDone(false), configCompleted(false), messagesRestored(false),
+      summaryRebuild(false), requestConfigRequired(true)
 {
 }
 
@@ -30,6 +52,7 @@ void ViewController::init(MeshtasticView *gui, IClientBase *_client)
 {
     time(&lastrun1);
     time(&lastrun10);
+    time(&lastSummarySave);
     view = gui;
     client = _client;
     if (client) {
@@ -45,6 +68,19 @@ void ViewController::init(MeshtasticView *gui, IClientBase *_client)
         client->connect();
     }
     log.init();
+#if defined(ARCH_PORTDUINO)
+    log.mapFiles(portduinoVFS->mountpoint());
+#endif
+    if (!summary.load()) {
+        summaryRebuild = log.size() > 0;
+    } else if (summary.logPosition() < log.startPosition() || summary.logPosition() > log.endPosition()) {
+        ILOG_WARN("chat summary does not match the log, rebuilding it");
+        summaryRebuild = true;
+    } else {
+        // the summary is saved behind, replay what was logged since (nothing if it was saved last)
+        summaryReplayFrom = summary.logPosition();
+        summaryReplayTo = log.endPosition();
+    }
 }
 
 /**
@@ -60,10 +96,8 @@ void ViewController::runOnce(void)
 
         if (configCompleted && !messagesRestored)
             restoreTextMessages();
-        else {
-            if (myNodeNum == 0 || view->getState() != MeshtasticView::eProgrammingMode)
-                receive();
-        }
+        if (myNodeNum == 0 || view->getState() != MeshtasticView::eProgrammingMode)
+            receive();
 
         // executed every 10s:
         time_t curtime;
@@ -83,12 +117,15 @@ void ViewController::runOnce(void)
         if (curtime - lastrun1 >= 1) {
             lastrun1 = curtime;
             client->task_handler();
+            if (summary.isDirty() && curtime - lastSummarySave >= c_summaryInterval)
+                saveSummary();
         }
     }
 }
 
 bool ViewController::sleep(int16_t pin)
 {
+    saveSummary();
     if (client)
         return client->sleep(pin);
     else
@@ -173,6 +210,7 @@ uint32_t ViewController::requestConfig(meshtastic_AdminMessage_ConfigType type,
 
 bool ViewController::requestReboot(int32_t seconds, uint32_t nodeId)
 {
+    saveSummary();
     return sendAdminMessage(
         meshtastic_AdminMessage{.which_payload_variant = meshtastic_AdminMessage_reboot_seconds_tag, .reboot_seconds = seconds},
         nodeId ? nodeId : myNodeNum);
@@ -180,6 +218,7 @@ bool ViewController::requestReboot(int32_t seconds, uint32_t nodeId)
 
 bool ViewController::requestRebootOTA(int32_t seconds, uint32_t nodeId)
 {
+    saveSummary();
     return sendAdminMessage(meshtastic_AdminMessage{.which_payload_variant = meshtastic_AdminMessage_reboot_ota_seconds_tag,
                                                     .reboot_ota_seconds = seconds},
                             nodeId ? nodeId : myNodeNum);
@@ -187,6 +226,7 @@ bool ViewController::requestRebootOTA(int32_t seconds, uint32_t nodeId)
 
 bool ViewController::requestShutdown(int32_t seconds, uint32_t nodeId)
 {
+    saveSummary();
     return sendAdminMessage(meshtastic_AdminMessage{.which_payload_variant = meshtastic_AdminMessage_shutdown_seconds_tag,
                                                     .shutdown_seconds = seconds},
                             nodeId ? nodeId : myNodeNum);
@@ -202,6 +242,7 @@ bool ViewController::requestShutdown(int32_t seconds, uint32_t nodeId)
  */
 bool ViewController::requestReset(bool factoryReset, uint32_t nodeId)
 {
+    saveSummary();
     return sendAdminMessage(
         meshtastic_AdminMessage{.which_payload_variant =
                                     (pb_size_t)(factoryReset ? meshtastic_AdminMessage_factory_reset_config_tag
@@ -478,7 +519,7 @@ void ViewController::sendTextMessage(uint32_t to, uint8_t ch, uint8_t hopLimit,
 
     if (send(to, ch, hopLimit, requestId, meshtastic_PortNum_TEXT_MESSAGE_APP, false, usePkc, (const uint8_t *)textmsg, msgLen)) {
         // ILOG_DEBUG("storing msg to:0x%08x, ch:%d, time:%d, size:%d, '%s'", to, ch, msgTime, msgLen, textmsg);
-        log.write(LogMessageEnv(myNodeNum, to, ch, msgTime, LogMessage::eDefault, false, msgLen, (const uint8_t *)textmsg));
+        logMessage(LogMessageEnv(myNodeNum, to, ch, msgTime, LogMessage::eDefault, false, msgLen, (const uint8_t *)textmsg));
     }
 }
 
@@ -629,31 +670,73 @@ void ViewController::beginRestoreTextMessages(void)
 {
     configCompleted = true;
     restoreTimer = millis();
+    restorer.begin(myNodeNum);
+    if (summaryRebuild) {
+        summary.clear();
+    } else if (summaryReplayFrom < summaryReplayTo) {
+        ILOG_INFO("chat summary is behind the log, replaying the log tail");
+    } else {
+        // chats are known from the summary, no need to wait for the restore
+        view->restoreChatSummary(summary);
+    }
     ILOG_INFO("loading persistent messages...");
 }
 
 /**
- * incrementally recover messages from persistent log (could take a while!)
+ * incrementally recover messages from persistent log: first the log is read in blocks into
+ * the staging area (0..50%), then the newest messages per chat are created in the view under
+ * a time budget (50..100%) followed by the live messages received in the meantime
  */
 void ViewController::restoreTextMessages(void)
 {
-    static uint32_t msgCounter = 0;
-    static uint32_t msgTotalSize = 0;
-    LogMessageEnv msg;
-
-    if (log.readNext(msg)) {
-        if (msg.ch >= c_max_channels) {
-            ILOG_WARN("skipping stored message with invalid channel %d", (int)msg.ch);
+    if (!restorer.loaded()) {
+        bool loaded = restorer.load(
+            [this](LogMessageEnv &msg) {
+                while (log.readNext(msg)) {
+                    if (summaryRebuild)
+                        summary.update(msg, myNodeNum);
+                    else if (log.readPosition() >= summaryReplayFrom && log.readPosition() < summaryReplayTo)
+                        summary.update(msg, myNodeNum, msg.from != myNodeNum); // received after the last save: unread
+                    if (msg.ch < c_max_channels)
+                        return true;
+                    ILOG_WARN("skipping stored message with invalid channel %d", (int)msg.ch);
+                }
+                return false;
+            },
+            c_restoreBlockSize);
+        uint32_t total = log.size();
+        view->notifyRestoreMessages(total ? std::min(restorer.bytesRead() * 50 / total, 50U) : 50);
+        if (!loaded)
             return;
+        if (summaryRebuild) {
+            ILOG_INFO("chat summary rebuilt from log");
+            summaryRebuild = false;
+            saveSummary();
+        } else if (summaryReplayFrom < summaryReplayTo) {
+            summaryReplayFrom = summaryReplayTo = 0;
+            saveSummary();
+            view->restoreChatSummary(summary);
         }
-        msgCounter++;
-        msgTotalSize += msg.size();
-        view->restoreMessage(msg);
-        view->notifyRestoreMessages(msgTotalSize * 100 / log.size());
-    } else {
-        ILOG_INFO("restoring %d messages completed in %dms.", msgCounter, millis() - restoreTimer);
-        msgCounter = 0;
-        msgTotalSize = 0;
+    }
+
+    bool done = restorer.restore(
+        [this](const LogMessage &msg, bool live, bool logged) {
+            if (live) {
+                uint32_t time = msg.time;
+                view->newMessage(msg.from, msg.to, msg.ch, (const char *)msg.bytes, time);
+                if (!logged)
+                    logMessage(LogMessageEnv(msg.from, msg.to, msg.ch, time, LogMessage::eDefault, false, msg._size, msg.bytes),
+                               true);
+            } else {
+                view->restoreMessage(msg);
+            }
+        },
+        c_restoreBudget);
+    view->notifyRestoreMessages(50 + restorer.progress() / 2);
+
+    if (done) {
+        ILOG_INFO("restoring %d messages (%d log entries) completed in %dms.", restorer.restored(), restorer.recordsRead(),
+                  millis() - restoreTimer);
         messagesRestored = true;
         view->notifyMessagesRestored();
     }
@@ -667,11 +750,41 @@ void ViewController::removeTextMessages(uint32_t from, uint32_t to, uint8_t ch)
 {
     if (!from && !to && !ch) {
         log.clear();
+        summary.clear();
+        summaryReplayFrom = summaryReplayTo = 0;
+        saveSummary();
     } else {
-        log.write(LogMessageEnv(from, to, ch, 0L, LogMessage::eDefault, true, 0, nullptr));
+        logMessage(LogMessageEnv(from, to, ch, 0L, LogMessage::eDefault, true, 0, nullptr));
     }
 }
 
+void ViewController::markMessagesRead(void)
+{
+    summary.markRead();
+}
+
+/**
+ * every log write updates the chat summary; it is written to flash after c_summaryChanges
+ * changes, every c_summaryInterval seconds and before sleep, reboot or shutdown (saveSummary),
+ * together with the log position it includes. Messages logged after the last save are
+ * replayed from the log at the next start.
+ */
+void ViewController::logMessage(const LogMessageEnv &msg, bool unread)
+{
+    log.write(msg);
+    summary.update(msg, myNodeNum, unread && msg.from != myNodeNum);
+    if (summary.changes() >= c_summaryChanges)
+        saveSummary();
+}
+
+void ViewController::saveSummary(void)
+{
+    // not while it is rebuilt or replayed: it does not include the whole log yet
+    if (!summaryRebuild && summaryReplayFrom == summaryReplayTo)
+        summary.save(log.endPosition());
+    time(&lastSummarySave);
+}
+
 /**
  * request connection status of WLAN/BT/MQTT
  */
@@ -700,6 +813,7 @@ bool ViewController::handleFromRadio(const meshtastic_FromRadio &from)
                           from.config.which_payload_variant == meshtastic_Config_bluetooth_tag)) {
             switch (from.which_payload_variant) {
             case meshtastic_FromRadio_packet_tag: {
+                FrameStats::instance().packetArrived(client->enqueuedAt());
                 const meshtastic_MeshPacket &p = from.packet;
                 if (p.which_payload_variant == meshtastic_MeshPacket_decoded_tag) {
                     packetReceived(p);
@@ -928,24 +1042,27 @@ bool ViewController::packetReceived(const meshtastic_MeshPacket &p)
     case meshtastic_PortNum_TEXT_MESSAGE_APP:
     case meshtastic_PortNum_RANGE_TEST_APP: {
         ILOG_INFO("received text message '%s'", (const char *)p.decoded.payload.bytes);
-        if (!messagesRestored && log.count() > 0) {
-            // houston we have a problem! Haven't finished restoring messages incrementally while new ones come in
-            if (!configCompleted) {
-                ILOG_ERROR("cannot handle received message NOW");
-                return false; // the only way out
-            } else {
-                // let's hope for the best...
-                ILOG_ERROR("WTF!? how did we get here??");
-            }
-        }
         uint32_t time = p.rx_time;
         if (p.channel >= c_max_channels) {
             ILOG_WARN("ignoring message with invalid channel %d", (int)p.channel);
             break;
         }
+        if (!messagesRestored) {
+            // stored messages are not yet restored; queue it so it shows up in order after the restored ones.
+            // Once the log has been read it is persisted right away, before that it would be read back as stored.
+            bool logged = restorer.loaded();
+            if (logged)
+                logMessage(LogMessageEnv(p.from, p.to, p.channel, time, LogMessage::eDefault, false, p.decoded.payload.size,
+                                         (const uint8_t *)p.decoded.payload.bytes),
+                           true);
+            restorer.queueLive(p.from, p.to, p.channel, time, p.decoded.payload.size, (const uint8_t *)p.decoded.payload.bytes,
+                               logged);
+            break;
+        }
         view->newMessage(p.from, p.to, p.channel, (const char *)p.decoded.payload.bytes, time);
-        log.write(LogMessageEnv(p.from, p.to, p.channel, time, LogMessage::eDefault, false, p.decoded.payload.size,
-                                (const uint8_t *)p.decoded.payload.bytes));
+        logMessage(LogMessageEnv(p.from, p.to, p.channel, time, LogMessage::eDefault, false, p.decoded.payload.size,
+                                 (const uint8_t *)p.decoded.payload.bytes),
+                   true);
         break;
     }
     case meshtastic_PortNum_POSITION_APP: {
@@ -1155,4 +1272,7 @@ bool ViewController::packetReceived(const meshtastic_MeshPacket &p)
     return true;
 }
 
-ViewController::~ViewController() {}
+ViewController::~ViewController()
+{
+    saveSummary();
+}
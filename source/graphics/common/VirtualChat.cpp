@@ -0,0 +1,169 @@
+#include "graphics/common/VirtualChat.h"
+#include "util/ILog.h"
+
+VirtualChat::VirtualChat(lv_obj_t *container, ChatLayout::Measure measure, CreateBubble create, BindBubble bind)
+    : container(container), layout(measure, lv_obj_get_style_pad_row(container, LV_PART_MAIN)), createBubble(create),
+      bindBubble(bind)
+{
+    // bubbles are placed by position, not by the flex layout of the container
+    lv_obj_set_layout(container, LV_LAYOUT_NONE);
+    lv_obj_add_event_cb(container, scrollEvent, LV_EVENT_SCROLL, this);
+    lv_obj_add_event_cb(container, selfSizeEvent, LV_EVENT_GET_SELF_SIZE, this);
+    lv_obj_add_event_cb(container, sizeChangedEvent, LV_EVENT_SIZE_CHANGED, this);
+    lv_obj_add_event_cb(container, deleteEvent, LV_EVENT_DELETE, this);
+}
+
+VirtualChat::~VirtualChat()
+{
+    if (container) {
+        lv_obj_remove_event_cb_with_user_data(container, scrollEvent, this);
+        lv_obj_remove_event_cb_with_user_data(container, selfSizeEvent, this);
+        lv_obj_remove_event_cb_with_user_data(container, sizeChangedEvent, this);
+        lv_obj_remove_event_cb_with_user_data(container, deleteEvent, this);
+        for (Bubble &b : pool)
+            lv_obj_delete(b.obj);
+    }
+}
+
+VirtualChat *VirtualChat::of(lv_obj_t *container)
+{
+    uint32_t count = lv_obj_get_event_count(container);
+    for (uint32_t i = 0; i < count; i++) {
+        lv_event_dsc_t *dsc = lv_obj_get_event_dsc(container, i);
+        if (lv_event_dsc_get_cb(dsc) == deleteEvent)
+            return (VirtualChat *)lv_event_dsc_get_user_data(dsc);
+    }
+    return nullptr;
+}
+
+void VirtualChat::changed(void)
+{
+    lv_obj_refresh_self_size(container);
+    update(true);
+}
+
+void VirtualChat::invalidate(void)
+{
+    layout.invalidate();
+    changed();
+}
+
+void VirtualChat::refresh(uint32_t index)
+{
+    for (Bubble &b : pool) {
+        if (b.index == index)
+            bindBubble(b.obj, index);
+    }
+}
+
+void VirtualChat::scrollToEnd(lv_anim_enable_t anim)
+{
+    lv_obj_update_layout(container);
+    lv_obj_scroll_by(container, 0, -lv_obj_get_scroll_bottom(container), anim);
+}
+
+uint32_t VirtualChat::indexOf(lv_obj_t *bubble) const
+{
+    for (const Bubble &b : pool) {
+        if (b.obj == bubble)
+            return b.index;
+    }
+    return ChatLayout::c_none;
+}
+
+/**
+ * Bind the messages within the view (plus one above and below); bubbles showing a message
+ * that is still visible are kept, the others are reused or created.
+ */
+void VirtualChat::update(bool rebind)
+{
+    if (layout.size() == 0) {
+        for (Bubble &b : pool) {
+            b.index = ChatLayout::c_none;
+            lv_obj_add_flag(b.obj, LV_OBJ_FLAG_HIDDEN);
+        }
+        return;
+    }
+
+    int32_t scrollY = lv_obj_get_scroll_y(container);
+    int32_t height = lv_obj_get_content_height(container);
+    uint32_t first = layout.indexAt(std::max<int32_t>(scrollY, 0));
+    if (first == ChatLayout::c_none)
+        first = layout.size() - 1;
+    first = first > 0 ? first - 1 : 0;
+    uint32_t last = first;
+    while (last < layout.size() && layout.top(last) < scrollY + height)
+        last++;
+    last = std::min<uint32_t>(last + 1, layout.size());
+
+    // release bubbles that went out of view
+    for (Bubble &b : pool) {
+        if (b.index != ChatLayout::c_none && (b.index < first || b.index >= last)) {
+            b.index = ChatLayout::c_none;
+            lv_obj_add_flag(b.obj, LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+
+    int32_t width = lv_obj_get_content_width(container);
+    for (uint32_t index = first; index < last; index++) {
+        const ChatLayout::Message &msg = layout.message(index);
+        Bubble *bubble = nullptr;
+        Bubble *free = nullptr;
+        for (Bubble &b : pool) {
+            if (b.index == index)
+                bubble = &b;
+            else if (!free && b.index == ChatLayout::c_none && b.sent == msg.sent)
+                free = &b;
+        }
+        bool bind = rebind || !bubble;
+        if (!bubble) {
+            if (!free) {
+                pool.push_back(Bubble{createBubble(container, msg.sent), ChatLayout::c_none, msg.sent});
+                free = &pool.back();
+            }
+            bubble = free;
+            bubble->index = index;
+        }
+        if (bind) {
+            ChatLayout::Size size = layout.bubble(index);
+            lv_obj_set_pos(bubble->obj, msg.sent ? width - size.width : 0, layout.top(index));
+            lv_obj_set_size(bubble->obj, size.width, size.height);
+            bindBubble(bubble->obj, index);
+            lv_obj_remove_flag(bubble->obj, LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+}
+
+void VirtualChat::scrollEvent(lv_event_t *e)
+{
+    VirtualChat *chat = (VirtualChat *)lv_event_get_user_data(e);
+    chat->update(false);
+}
+
+void VirtualChat::selfSizeEvent(lv_event_t *e)
+{
+    VirtualChat *chat = (VirtualChat *)lv_event_get_user_data(e);
+    lv_point_t *size = (lv_point_t *)lv_event_get_param(e);
+    size->y = LV_MAX(size->y, chat->layout.contentHeight());
+}
+
+/**
+ * A new width (rotation, resized panel) moves the sent bubbles and may wrap the texts differently,
+ * a new height only shows more or fewer messages.
+ */
+void VirtualChat::sizeChangedEvent(lv_event_t *e)
+{
+    VirtualChat *chat = (VirtualChat *)lv_event_get_user_data(e);
+    const lv_area_t *before = (const lv_area_t *)lv_event_get_param(e);
+    if (lv_area_get_width(before) != lv_obj_get_width(chat->container))
+        chat->invalidate();
+    else
+        chat->update(false);
+}
+
+void VirtualChat::deleteEvent(lv_event_t *e)
+{
+    VirtualChat *chat = (VirtualChat *)lv_event_get_user_data(e);
+    chat->container = nullptr; // bubbles are deleted with the container
+    delete chat;
+}
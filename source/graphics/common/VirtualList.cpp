@@ -0,0 +1,116 @@
+#include "graphics/common/VirtualList.h"
+#include "util/ILog.h"
+
+static uint32_t viewHeight(lv_obj_t *container)
+{
+    lv_obj_update_layout(container);
+    return lv_obj_get_content_height(container);
+}
+
+VirtualList::VirtualList(lv_obj_t *container, uint32_t rowHeight, CreateRow create, BindRow bind)
+    : container(container), window(rowHeight, viewHeight(container)), createRow(create), bindRow(bind)
+{
+    // rows are placed by position, not by the flex layout of the container
+    lv_obj_set_layout(container, LV_LAYOUT_NONE);
+    lv_obj_add_event_cb(container, scrollEvent, LV_EVENT_SCROLL, this);
+    lv_obj_add_event_cb(container, selfSizeEvent, LV_EVENT_GET_SELF_SIZE, this);
+}
+
+VirtualList::~VirtualList()
+{
+    lv_obj_remove_event_cb_with_user_data(container, scrollEvent, this);
+    lv_obj_remove_event_cb_with_user_data(container, selfSizeEvent, this);
+    for (lv_obj_t *row : rows)
+        lv_obj_delete(row);
+}
+
+void VirtualList::setCount(uint32_t count)
+{
+    window.setCount(count);
+    window.scrollTo(lv_obj_get_scroll_y(container));
+    window.invalidate();
+    lv_obj_refresh_self_size(container);
+    update();
+}
+
+void VirtualList::refresh(void)
+{
+    window.invalidate();
+    update();
+}
+
+void VirtualList::refresh(uint32_t index)
+{
+    window.invalidate(index);
+    update();
+}
+
+void VirtualList::scrollToIndex(uint32_t index, lv_anim_enable_t anim)
+{
+    lv_obj_scroll_to_y(container, window.rowY(index), anim);
+}
+
+void VirtualList::setExpanded(uint32_t index, uint32_t extra)
+{
+    uint32_t previous = window.expanded();
+    window.setExpanded(index, extra);
+    window.invalidate(previous);
+    window.invalidate(index);
+    lv_obj_refresh_self_size(container);
+    update();
+}
+
+lv_obj_t *VirtualList::rowOf(uint32_t index) const
+{
+    uint32_t poolRow = window.poolRowOf(index);
+    if (poolRow == RowWindow::c_none || poolRow >= rows.size() || window.indexOf(poolRow) != index)
+        return nullptr;
+    return rows[poolRow];
+}
+
+/**
+ * Create the pool lazily (short lists need less rows) and rebind the rows that changed.
+ * Rows below an expanded row move without being rebound.
+ */
+void VirtualList::update(void)
+{
+    uint32_t needed = std::min(window.poolSize(), window.count());
+    while (rows.size() < needed) {
+        lv_obj_t *row = createRow(container);
+        lv_obj_add_flag(row, LV_OBJ_FLAG_HIDDEN);
+        rows.push_back(row);
+    }
+
+    window.update([this](uint32_t poolRow, uint32_t index) {
+        if (poolRow >= rows.size())
+            return;
+        lv_obj_t *row = rows[poolRow];
+        if (index == RowWindow::c_none) {
+            lv_obj_add_flag(row, LV_OBJ_FLAG_HIDDEN);
+        } else {
+            lv_obj_set_y(row, window.rowY(index));
+            bindRow(row, index);
+            lv_obj_remove_flag(row, LV_OBJ_FLAG_HIDDEN);
+        }
+    });
+
+    for (uint32_t poolRow = 0; poolRow < rows.size(); poolRow++) {
+        uint32_t index = window.indexOf(poolRow);
+        if (index != RowWindow::c_none && lv_obj_get_y_aligned(rows[poolRow]) != window.rowY(index))
+            lv_obj_set_y(rows[poolRow], window.rowY(index));
+    }
+}
+
+void VirtualList::scrollEvent(lv_event_t *e)
+{
+    VirtualList *list = (VirtualList *)lv_event_get_user_data(e);
+    list->window.scrollTo(lv_obj_get_scroll_y(list->container));
+    list->update();
+}
+
+void VirtualList::selfSizeEvent(lv_event_t *e)
+{
+    VirtualList *list = (VirtualList *)lv_event_get_user_data(e);
+    lv_point_t *size = (lv_point_t *)lv_event_get_param(e);
+    size->y = LV_MAX(size->y, list->window.contentHeight());
+}
@@ -1,4 +1,5 @@
 #include "graphics/driver/DisplayDriver.h"
+#include "graphics/common/FrameStats.h"
 #include "util/ILog.h"
 
 #if LV_USE_PROFILER
@@ -12,7 +13,8 @@
 #endif
 
 DisplayDriver::DisplayDriver(uint16_t width, uint16_t height)
-    : lvgl(width, height), display(nullptr), touch(nullptr), view(nullptr), screenWidth(width), screenHeight(height)
+    : lvgl(width, height), display(nullptr), touch(nullptr), view(nullptr), screenWidth(width), screenHeight(height),
+      lastTimerRun(0), timeUntilNext(0)
 {
 }
 
@@ -21,6 +23,11 @@ void DisplayDriver::init(DeviceGUI *gui)
     ILOG_DEBUG("DisplayDriver init...");
     view = gui;
     lvgl.init();
+    lv_timer_handler_set_resume_cb(timer_resume_cb, this);
+#ifdef ARCH_PORTDUINO
+    // ticks from the monotonic clock, DeviceGUI::task_handler() sleeps for varying times
+    lv_tick_set_cb([]() -> uint32_t { return uint32_t(FrameStats::now() / 1000); });
+#endif
 
 #if LV_USE_PROFILER
     // initialize lvgl profiler
@@ -48,3 +55,32 @@ void DisplayDriver::init(DeviceGUI *gui)
     lv_profiler_builtin_init(&config);
 #endif
 }
+
+/**
+ * Same as lv_timer_periodic_handler(): run lv_timer_handler() when the next timer is due, but
+ * record how long each run takes.
+ */
+void DisplayDriver::task_handler(void)
+{
+    if (lv_tick_elaps(lastTimerRun) >= timeUntilNext) {
+        uint64_t start = FrameStats::now();
+        timeUntilNext = lv_timer_handler();
+        lastTimerRun = lv_tick_get();
+        FrameStats::instance().timerHandler(uint32_t(FrameStats::now() - start));
+    }
+    FrameStats::instance().task_handler();
+}
+
+uint32_t DisplayDriver::getTimeUntilNext(void) const
+{
+    uint32_t elapsed = lv_tick_elaps(lastTimerRun);
+    return elapsed >= timeUntilNext ? 0 : timeUntilNext - elapsed;
+}
+
+/**
+ * A timer was created or resumed, it may be due before timeUntilNext
+ */
+void DisplayDriver::timer_resume_cb(void *data)
+{
+    ((DisplayDriver *)data)->timeUntilNext = 0;
+}
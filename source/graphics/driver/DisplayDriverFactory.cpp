@@ -16,6 +16,9 @@
 #if defined(USE_X11)
 #include "graphics/driver/X11Driver.h"
 #endif
+#if defined(ARCH_PORTDUINO)
+#include "graphics/driver/MemDriver.h"
+#endif
 
 #ifndef ARCH_PORTDUINO
 #ifdef LGFX_DRIVER_TEMPLATE
@@ -87,6 +90,9 @@ DisplayDriverFactory::DisplayDriverFactory() {}
 
 DisplayDriver *DisplayDriverFactory::create(uint16_t width, uint16_t height)
 {
+#if defined(USE_MEMDRIVER)
+    return &MemDriver::create(width, height);
+#endif
 #if defined(USE_FRAMEBUFFER)
     return &FBDriver::create(width, height);
 #endif
@@ -127,6 +133,11 @@ DisplayDriver *DisplayDriverFactory::create(const DisplayDriverConfig &cfg)
     if (cfg._device == DisplayDriverConfig::device_t::X11) {
         return &X11Driver::create(cfg.width(), cfg.height());
     }
+#endif
+#if defined(ARCH_PORTDUINO)
+    if (cfg._device == DisplayDriverConfig::device_t::MEM) {
+        return &MemDriver::create(cfg.width(), cfg.height());
+    }
 #endif
     switch (cfg._device) {
 #ifndef ARCH_PORTDUINO
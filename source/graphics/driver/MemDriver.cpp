@@ -0,0 +1,281 @@
+#ifdef ARCH_PORTDUINO
+
+#include "graphics/driver/MemDriver.h"
+#include "util/Crc32.h"
+#include "util/ILog.h"
+#include "util/InputScript.h"
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <string>
+
+namespace
+{
+uint64_t micros64(void)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void put32(std::vector<uint8_t> &out, uint32_t v)
+{
+    out.push_back(uint8_t(v >> 24));
+    out.push_back(uint8_t(v >> 16));
+    out.push_back(uint8_t(v >> 8));
+    out.push_back(uint8_t(v));
+}
+
+void chunk(FILE *f, const char *type, const std::vector<uint8_t> &data)
+{
+    std::vector<uint8_t> head;
+    put32(head, data.size());
+    head.insert(head.end(), type, type + 4);
+    uint32_t crc = crc32(type, 4);
+    crc = crc32(data.data(), data.size(), crc);
+    std::vector<uint8_t> tail;
+    put32(tail, crc);
+    fwrite(head.data(), 1, head.size(), f);
+    fwrite(data.data(), 1, data.size(), f);
+    fwrite(tail.data(), 1, tail.size(), f);
+}
+} // namespace
+
+MemDriver *MemDriver::memDriver = nullptr;
+
+MemDriver &MemDriver::create(uint16_t width, uint16_t height)
+{
+    if (!memDriver)
+        memDriver = new MemDriver(width, height);
+    return *memDriver;
+}
+
+MemDriver::MemDriver(uint16_t width, uint16_t height)
+    : DisplayDriver(width, height), framebuffer(width * height), drawBuffer(width * height / 8 * sizeof(uint16_t)),
+      keypad(nullptr), tick(0), renderStart(0), statistics{}, point{0, 0}, pressed(false), clicked(false), keyPressed(false)
+{
+}
+
+void MemDriver::init(DeviceGUI *gui)
+{
+    ILOG_DEBUG("MemDriver::init...");
+    // Initialize LVGL
+    DisplayDriver::init(gui);
+    lv_tick_set_cb(tick_cb);
+
+    display = lv_display_create(screenWidth, screenHeight);
+    lv_display_set_color_format(display, LV_COLOR_FORMAT_RGB565);
+    lv_display_set_buffers(display, drawBuffer.data(), nullptr, drawBuffer.size(), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(display, flush_cb);
+    lv_display_add_event_cb(display, render_event_cb, LV_EVENT_RENDER_START, this);
+    lv_display_add_event_cb(display, render_event_cb, LV_EVENT_RENDER_READY, this);
+
+    touch = lv_indev_create();
+    lv_indev_set_type(touch, LV_INDEV_TYPE_POINTER);
+    lv_indev_set_read_cb(touch, pointer_read);
+    lv_indev_set_display(touch, display);
+
+    keypad = lv_indev_create();
+    lv_indev_set_type(keypad, LV_INDEV_TYPE_KEYPAD);
+    lv_indev_set_read_cb(keypad, keypad_read);
+    lv_indev_set_display(keypad, display);
+}
+
+void MemDriver::advance(uint32_t ms)
+{
+    tick += ms;
+}
+
+void MemDriver::press(int32_t x, int32_t y)
+{
+    point.x = x;
+    point.y = y;
+    pressed = true;
+    clicked = true;
+}
+
+void MemDriver::release(void)
+{
+    pressed = false;
+}
+
+void MemDriver::key(uint32_t key)
+{
+    keys.push_back(key);
+}
+
+/**
+ * The clock advances by frameMs (less up to the next event) and frame() is called, which runs the
+ * view's task_handler. Before a snapshot the pending changes are rendered.
+ */
+void MemDriver::replay(const InputScript &script, const std::function<void(void)> &frame, uint32_t frameMs,
+                       const char *snapshotDir)
+{
+    uint32_t start = tick;
+    for (const InputScript::Event &event : script.events()) {
+        while (tick - start < event.at) {
+            advance(std::min(frameMs, event.at - (tick - start)));
+            frame();
+        }
+        switch (event.action) {
+        case InputScript::ePress:
+        case InputScript::eMove:
+            press(event.x, event.y);
+            break;
+        case InputScript::eRelease:
+            point.x = event.x;
+            point.y = event.y;
+            release();
+            break;
+        case InputScript::eKey:
+            key(event.key);
+            break;
+        case InputScript::eSnapshot:
+            if (snapshotDir) {
+                lv_refr_now(display);
+                std::string path = std::string(snapshotDir) + "/" + event.name + ".png";
+                if (!snapshot(path.c_str()))
+                    ILOG_ERROR("MemDriver: failed to write snapshot %s", path.c_str());
+            }
+            break;
+        }
+    }
+    // let the last event take effect
+    advance(frameMs);
+    frame();
+}
+
+/**
+ * Write the framebuffer as 8-bit RGB PNG with uncompressed deflate blocks, which needs no zlib and
+ * is fast enough for a few snapshots.
+ */
+bool MemDriver::snapshot(const char *path) const
+{
+    FILE *f = fopen(path, "wb");
+    if (!f)
+        return false;
+
+    // filter type 0 and RGB per row
+    std::vector<uint8_t> raw;
+    raw.reserve(screenHeight * (1 + screenWidth * 3));
+    for (uint32_t y = 0; y < screenHeight; y++) {
+        raw.push_back(0);
+        for (uint32_t x = 0; x < screenWidth; x++) {
+            uint16_t px = pixel(x, y);
+            uint8_t r = (px >> 11) & 0x1f, g = (px >> 5) & 0x3f, b = px & 0x1f;
+            raw.push_back(uint8_t(r << 3 | r >> 2));
+            raw.push_back(uint8_t(g << 2 | g >> 4));
+            raw.push_back(uint8_t(b << 3 | b >> 2));
+        }
+    }
+
+    std::vector<uint8_t> zlib = {0x78, 0x01};
+    uint32_t a = 1, b = 0; // adler32
+    size_t pos = 0;
+    do {
+        size_t len = std::min(raw.size() - pos, size_t(65535));
+        bool last = pos + len == raw.size();
+        zlib.push_back(last ? 1 : 0);
+        zlib.push_back(uint8_t(len));
+        zlib.push_back(uint8_t(len >> 8));
+        zlib.push_back(uint8_t(~len));
+        zlib.push_back(uint8_t(~len >> 8));
+        for (size_t i = pos; i < pos + len; i++) {
+            a = (a + raw[i]) % 65521;
+            b = (b + a) % 65521;
+        }
+        zlib.insert(zlib.end(), raw.begin() + pos, raw.begin() + pos + len);
+        pos += len;
+    } while (pos < raw.size());
+    put32(zlib, b << 16 | a);
+
+    std::vector<uint8_t> header;
+    put32(header, screenWidth);
+    put32(header, screenHeight);
+    header.insert(header.end(), {8, 2, 0, 0, 0}); // 8 bit, RGB, deflate, filter 0, no interlace
+
+    static const uint8_t signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+    fwrite(signature, 1, sizeof(signature), f);
+    chunk(f, "IHDR", header);
+    chunk(f, "IDAT", zlib);
+    chunk(f, "IEND", {});
+    return fclose(f) == 0;
+}
+
+void MemDriver::resetStats(void)
+{
+    statistics = Stats{};
+}
+
+uint32_t MemDriver::tick_cb(void)
+{
+    return memDriver->tick;
+}
+
+void MemDriver::flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    int32_t w = lv_area_get_width(area);
+    int32_t h = lv_area_get_height(area);
+    const uint16_t *src = (const uint16_t *)px_map;
+    for (int32_t y = 0; y < h; y++)
+        std::copy(src + y * w, src + (y + 1) * w, &memDriver->framebuffer[(area->y1 + y) * memDriver->screenWidth + area->x1]);
+    memDriver->statistics.flushes++;
+    memDriver->statistics.flushedPixels += w * h;
+    lv_display_flush_ready(disp);
+}
+
+/**
+ * LV_EVENT_RENDER_START/READY enclose rendering and flushing of the invalidated areas; they are
+ * not sent for a refresh with nothing to render.
+ */
+void MemDriver::render_event_cb(lv_event_t *e)
+{
+    MemDriver *driver = (MemDriver *)lv_event_get_user_data(e);
+    if (lv_event_get_code(e) == LV_EVENT_RENDER_START) {
+        driver->renderStart = micros64();
+        return;
+    }
+    uint32_t us = uint32_t(micros64() - driver->renderStart);
+    Stats &stats = driver->statistics;
+    stats.frames++;
+    stats.renderUs += us;
+    stats.maxRenderUs = std::max(stats.maxRenderUs, us);
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    stats.heapHighWater = std::max(stats.heapHighWater, mon.max_used);
+}
+
+/**
+ * A press is reported at least once even if it is released before the next read.
+ */
+void MemDriver::pointer_read(lv_indev_t *indev, lv_indev_data_t *data)
+{
+    data->point = memDriver->point;
+    data->state = memDriver->pressed || memDriver->clicked ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+    memDriver->clicked = false;
+}
+
+/**
+ * Each pending key is reported pressed and then released, all in one read.
+ */
+void MemDriver::keypad_read(lv_indev_t *indev, lv_indev_data_t *data)
+{
+    if (!lv_indev_get_group(indev))
+        lv_indev_set_group(indev, lv_group_get_default());
+    std::vector<uint32_t> &keys = memDriver->keys;
+    if (keys.empty()) {
+        data->state = LV_INDEV_STATE_RELEASED;
+        return;
+    }
+    data->key = keys.front();
+    if (!memDriver->keyPressed) {
+        data->state = LV_INDEV_STATE_PRESSED;
+        memDriver->keyPressed = true;
+    } else {
+        data->state = LV_INDEV_STATE_RELEASED;
+        memDriver->keyPressed = false;
+        keys.erase(keys.begin());
+    }
+    data->continue_reading = !keys.empty();
+}
+
+#endif
@@ -1,5 +1,8 @@
 #include "graphics/map/TileService.h"
 
+void (*TileFsLock::acquireBus)(void) = nullptr;
+void (*TileFsLock::releaseBus)(void) = nullptr;
+
 void TileService::setService(ITileService *s)
 {
     delete service;
@@ -16,4 +19,11 @@ TileService::~TileService()
 {
     delete service;
     delete backup;
-}
\ No newline at end of file
+}
+lv_mutex_t &TileFsLock::mutex(void)
+{
+    static lv_mutex_t m;
+    static bool initialized = lv_mutex_init(&m) == LV_RESULT_OK;
+    (void)initialized;
+    return m;
+}
@@ -3,6 +3,8 @@
 #include "input/LinuxInputDriver.h"
 #include "screens.h"
 #include "util/ILog.h"
+#include "util/Wakeup.h"
+#include <fcntl.h>
 #include <glob.h>
 #include <unistd.h>
 
@@ -119,6 +121,10 @@ bool LinuxInputDriver::useKeyboardDevice(const std::string &name)
     if (keyboard) {
         ILOG_INFO("Using keyboard device %s", kb_path.c_str());
         keyboardDevice = event;
+        unwatchDevice(keyboardFd);
+        keyboardFd = watchDevice(kb_path);
+        if (keyboardFd >= 0)
+            lv_indev_set_mode(keyboard, LV_INDEV_MODE_EVENT); // read by DeviceGUI::task_handler() on input
     } else {
         ILOG_ERROR("Failed to use keyboard device %s", kb_path.c_str());
         keyboardDevice = "none";
@@ -156,6 +162,10 @@ bool LinuxInputDriver::usePointerDevice(const std::string &name)
         lv_image_set_src(mouse_cursor, &mouse_cursor_icon);
         lv_indev_set_cursor(pointer, mouse_cursor);
         pointerDevice = event;
+        unwatchDevice(pointerFd);
+        pointerFd = watchDevice(ptr_path);
+        if (pointerFd >= 0)
+            lv_indev_set_mode(pointer, LV_INDEV_MODE_EVENT);
         return true;
     } else {
         ILOG_ERROR("Failed to use pointer device %s", ptr_path.c_str());
@@ -167,6 +177,7 @@ bool LinuxInputDriver::usePointerDevice(const std::string &name)
 bool LinuxInputDriver::releaseKeyboardDevice(void)
 {
     ILOG_INFO("Releasing keyboard device %s", keyboardDevice.c_str());
+    unwatchDevice(keyboardFd);
     lv_indev_delete(keyboard);
     keyboard = nullptr;
     keyboardDevice = "none";
@@ -181,12 +192,36 @@ bool LinuxInputDriver::releasePointerDevice(void)
         lv_obj_delete(mouse_cursor);
         mouse_cursor = nullptr;
     }
+    unwatchDevice(pointerFd);
     lv_indev_delete(pointer);
     pointer = nullptr;
     pointerDevice = "none";
     return true;
 }
 
+/**
+ * libinput reads the events through its own handle, this one only tells that there are some.
+ * Without it the device stays in timer mode and is polled at the LVGL read period.
+ */
+int LinuxInputDriver::watchDevice(const std::string &path)
+{
+    int fd = open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd >= 0)
+        Wakeup::instance().watch(fd);
+    else
+        ILOG_WARN("Cannot watch input device %s, it is polled only", path.c_str());
+    return fd;
+}
+
+void LinuxInputDriver::unwatchDevice(int &fd)
+{
+    if (fd >= 0) {
+        Wakeup::instance().unwatch(fd);
+        close(fd);
+        fd = -1;
+    }
+}
+
 LinuxInputDriver::~LinuxInputDriver(void)
 {
     if (keyboard)
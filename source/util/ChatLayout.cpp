@@ -0,0 +1,83 @@
+#include "util/ChatLayout.h"
+#include <algorithm>
+#include <string.h>
+
+ChatLayout::ChatLayout(Measure measure, uint32_t gap) : measure(measure), gap(gap) {}
+
+uint32_t ChatLayout::add(const char *text, bool sent, uint32_t nodeNum, uint32_t requestId, uint8_t status)
+{
+    uint32_t offset = texts.size();
+    texts.insert(texts.end(), text, text + strlen(text) + 1);
+    messages.push_back(Message{nodeNum, requestId, offset, {0, 0}, status, sent});
+    return messages.size() - 1;
+}
+
+uint32_t ChatLayout::findRequest(uint32_t requestId) const
+{
+    for (uint32_t i = messages.size(); i-- > 0;) {
+        if (messages[i].sent && messages[i].requestId == requestId)
+            return i;
+    }
+    return c_none;
+}
+
+void ChatLayout::clear(void)
+{
+    texts.clear();
+    messages.clear();
+    tops.clear();
+    laidOut = 0;
+}
+
+void ChatLayout::invalidate(void)
+{
+    for (Message &m : messages)
+        m.size = {0, 0};
+    laidOut = 0;
+}
+
+ChatLayout::Size ChatLayout::bubble(uint32_t index)
+{
+    layout(index + 1);
+    return messages[index].size;
+}
+
+int32_t ChatLayout::top(uint32_t index)
+{
+    layout(index + 1);
+    if (index < messages.size())
+        return tops[index];
+    if (messages.empty())
+        return 0;
+    return tops.back() + messages.back().size.height;
+}
+
+/**
+ * Binary search over the positions; only the messages up to the result need to be measured,
+ * but since a scroll position is usually computed from contentHeight() all are measured anyway.
+ */
+uint32_t ChatLayout::indexAt(int32_t y)
+{
+    if (messages.empty() || y < 0)
+        return c_none;
+    layout(messages.size());
+    auto it = std::upper_bound(tops.begin(), tops.end(), y);
+    uint32_t index = (it - tops.begin()) - 1;
+    return y < tops[index] + messages[index].size.height + (int32_t)gap ? index : c_none;
+}
+
+/**
+ * Measure the messages [laidOut, upTo) and continue the prefix sums of their heights.
+ */
+void ChatLayout::layout(uint32_t upTo)
+{
+    upTo = std::min<uint32_t>(upTo, messages.size());
+    tops.resize(messages.size());
+    for (uint32_t i = laidOut; i < upTo; i++) {
+        Message &m = messages[i];
+        if (m.size.height == 0)
+            m.size = measure(&texts[m.offset], m.sent);
+        tops[i] = i == 0 ? 0 : tops[i - 1] + messages[i - 1].size.height + gap;
+    }
+    laidOut = std::max(laidOut, upTo);
+}
@@ -0,0 +1,195 @@
+#include "util/ChatSummary.h"
+#include "util/Crc32.h"
+#include "util/ILog.h"
+#include <algorithm>
+
+ChatSummary::ChatSummary(fs::FS &fs, const char *fileName) : _fs(fs), fileName(fileName), dirty(false), numChanges(0), position(0)
+{
+    memset(table, 0, sizeof(table));
+}
+
+bool ChatSummary::load(void)
+{
+    memset(table, 0, sizeof(table));
+    dirty = false;
+    numChanges = 0;
+    position = 0;
+
+    File file = _fs.open(fileName, FILE_READ);
+    if (!file) {
+        ILOG_INFO("ChatSummary: no summary found");
+        return false;
+    }
+
+    FileHeader header;
+    bool valid = file.read((uint8_t *)&header, sizeof(header)) == sizeof(header) && header.magic == c_magic &&
+                 header.version == c_version && header.chats == c_maxChats &&
+                 file.read((uint8_t *)table, sizeof(table)) == sizeof(table) &&
+                 crc32(table, sizeof(table), crc32(&header.logPosition, sizeof(header.logPosition))) == header.crc;
+    file.close();
+
+    if (!valid) {
+        ILOG_WARN("ChatSummary: %s invalid, ignored", fileName.c_str());
+        memset(table, 0, sizeof(table));
+        return false;
+    }
+    position = header.logPosition;
+    return true;
+}
+
+/**
+ * write to a temporary file and rename it so that a power loss leaves either the old or the new summary
+ */
+bool ChatSummary::save(uint64_t logPosition)
+{
+    if (!dirty && logPosition == position)
+        return true;
+
+    String tmpName = fileName + ".tmp";
+    File file = _fs.open(tmpName, FILE_WRITE);
+    if (!file) {
+        ILOG_ERROR("ChatSummary: cannot create %s", tmpName.c_str());
+        return false;
+    }
+
+    FileHeader header{c_magic, c_version, c_maxChats, crc32(table, sizeof(table), crc32(&logPosition, sizeof(logPosition))),
+                      logPosition};
+    bool ok = file.write((const uint8_t *)&header, sizeof(header)) == sizeof(header) &&
+              file.write((const uint8_t *)table, sizeof(table)) == sizeof(table);
+    file.close();
+
+    if (!ok || !_fs.rename(tmpName, fileName)) {
+        ILOG_ERROR("ChatSummary: failed to write %s", fileName.c_str());
+        _fs.remove(tmpName);
+        return false;
+    }
+    dirty = false;
+    numChanges = 0;
+    position = logPosition;
+    return true;
+}
+
+/**
+ * Chats are identified the same way as in the view: group messages by channel,
+ * direct messages by the node number of the peer
+ */
+void ChatSummary::update(const LogMessage &msg, uint32_t ownNode, bool unread)
+{
+    if (msg.ch >= c_maxChannels)
+        return;
+
+    ChatType type = (msg.to == UINT32_MAX || msg.from == 0) ? eChannel : eDirect;
+    uint32_t id = type == eChannel ? msg.ch : (msg.from == ownNode ? msg.to : msg.from);
+
+    if (msg.trashFlag) {
+        Chat *chat = slot(type, id, msg.ch, false);
+        if (chat) {
+            memset(chat, 0, sizeof(Chat));
+            dirty = true;
+            numChanges++;
+        }
+        return;
+    }
+
+    Chat *chat = slot(type, id, msg.ch, true);
+    chat->ch = msg.ch;
+    chat->lastTime = (uint32_t)msg.time;
+    chat->lastFrom = msg.from;
+    chat->count++;
+    if (unread && chat->unread < UINT16_MAX)
+        chat->unread++;
+    size_t len = std::min<size_t>(msg.length(), c_previewLen - 1);
+    memcpy(chat->preview, msg.bytes, len);
+    chat->preview[len] = 0;
+    dirty = true;
+    numChanges++;
+}
+
+void ChatSummary::markRead(void)
+{
+    bool read = false;
+    for (auto &chat : table) {
+        if (chat.unread) {
+            chat.unread = 0;
+            read = true;
+        }
+    }
+    if (read) {
+        dirty = true;
+        numChanges++;
+    }
+}
+
+void ChatSummary::clear(void)
+{
+    memset(table, 0, sizeof(table));
+    dirty = true;
+    numChanges++;
+}
+
+const ChatSummary::Chat *ChatSummary::find(ChatType type, uint32_t id) const
+{
+    for (auto &chat : table) {
+        if (chat.type == type && chat.id == id)
+            return &chat;
+    }
+    return nullptr;
+}
+
+std::vector<const ChatSummary::Chat *> ChatSummary::chats(void) const
+{
+    std::vector<const Chat *> result;
+    for (auto &chat : table) {
+        if (chat.type != eFree)
+            result.push_back(&chat);
+    }
+    std::stable_sort(result.begin(), result.end(), [](const Chat *a, const Chat *b) { return a->lastTime < b->lastTime; });
+    return result;
+}
+
+uint32_t ChatSummary::count(void) const
+{
+    return std::count_if(std::begin(table), std::end(table), [](const Chat &chat) { return chat.type != eFree; });
+}
+
+uint32_t ChatSummary::unread(void) const
+{
+    uint32_t total = 0;
+    for (auto &chat : table)
+        total += chat.unread;
+    return total;
+}
+
+/**
+ * Return the slot of a chat; channels have a fixed slot, DMs take a free slot or replace the
+ * least recently active DM chat.
+ */
+ChatSummary::Chat *ChatSummary::slot(ChatType type, uint32_t id, uint8_t ch, bool create)
+{
+    Chat *chat = nullptr;
+    if (type == eChannel) {
+        chat = &table[ch];
+        if (chat->type == eFree && !create)
+            return nullptr;
+    } else {
+        Chat *candidate = nullptr;
+        for (uint32_t i = c_maxChannels; i < c_maxChats; i++) {
+            if (table[i].type == eDirect && table[i].id == id)
+                return &table[i];
+            if (!candidate || (candidate->type != eFree && (table[i].type == eFree || table[i].lastTime < candidate->lastTime)))
+                candidate = &table[i];
+        }
+        if (!create)
+            return nullptr;
+        chat = candidate;
+        if (chat->type != eFree)
+            ILOG_DEBUG("ChatSummary: dropping chat with %08x", chat->id);
+    }
+
+    if (chat->type == eFree || chat->id != id) {
+        memset(chat, 0, sizeof(Chat));
+        chat->type = type;
+        chat->id = id;
+    }
+    return chat;
+}
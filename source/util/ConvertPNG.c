@@ -156,6 +156,7 @@ bool decodeImgColor(const void *data, size_t size, lv_img_dsc_t **img)
     (*img)->header.magic = LV_IMAGE_HEADER_MAGIC;
     (*img)->header.w = width;
     (*img)->header.h = height;
+    /* kept in RGB565 for all displays: blending into RGB565_SWAPPED (LGFXDriver) swaps while copying, see test_LGFXFlush */
     (*img)->header.cf = LV_COLOR_FORMAT_RGB565;
     (*img)->header.flags = LV_IMAGE_FLAGS_MODIFIABLE | LV_IMAGE_FLAGS_USER1;
     (*img)->data = (uint8_t *)rgb565Data;
@@ -0,0 +1,28 @@
+#include "util/Crc32.h"
+
+namespace
+{
+struct Crc32Table {
+    uint32_t entry[256];
+    constexpr Crc32Table() : entry()
+    {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++)
+                c = (c & 1) ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+            entry[i] = c;
+        }
+    }
+};
+
+constexpr Crc32Table table;
+} // namespace
+
+uint32_t crc32(const void *data, size_t len, uint32_t crc)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    crc = ~crc;
+    while (len--)
+        crc = table.entry[(crc ^ *p++) & 0xff] ^ (crc >> 8);
+    return ~crc;
+}
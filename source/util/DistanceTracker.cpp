@@ -0,0 +1,220 @@
+#include "util/DistanceTracker.h"
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+
+namespace
+{
+constexpr uint64_t c_metersPerDegree = 111195; // 6371 km * pi / 180
+constexpr uint32_t c_large = 0x80000000;       // displayValue() flag for 1/10 km or 1/10 mi
+
+inline int32_t toMicro(int32_t e7)
+{
+    return e7 / 10;
+}
+
+uint32_t isqrt(uint64_t v)
+{
+    uint64_t res = 0;
+    uint64_t bit = 1ull << 62;
+    while (bit > v)
+        bit >>= 2;
+    while (bit) {
+        if (v >= res + bit) {
+            v -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)res;
+}
+} // namespace
+
+DistanceTracker::DistanceTracker(uint32_t thresholdMeters) : threshold(thresholdMeters) {}
+
+bool DistanceTracker::setOrigin(int32_t lat, int32_t lon)
+{
+    int32_t latMicro = toMicro(lat), lonMicro = toMicro(lon);
+    uint16_t c = cosQ15(latMicro);
+    if (originSet && distance(originLat, originLon, originCos, latMicro, lonMicro, c) < threshold)
+        return false;
+    originSet = true;
+    originLat = latMicro;
+    originLon = lonMicro;
+    originCos = c;
+    markAll();
+    return true;
+}
+
+void DistanceTracker::setMetric(bool isMetric)
+{
+    if (metric == isMetric)
+        return;
+    metric = isMetric;
+    std::fill(shown.begin(), shown.end(), c_none);
+    markAll();
+}
+
+void DistanceTracker::setPosition(uint32_t nodeNum, int32_t latitude, int32_t longitude)
+{
+    auto it = index.find(nodeNum);
+    uint32_t i;
+    if (it == index.end()) {
+        i = num.size();
+        index[nodeNum] = i;
+        num.push_back(nodeNum);
+        lat.push_back(0);
+        lon.push_back(0);
+        cos.push_back(0);
+        meters.push_back(c_none);
+        shown.push_back(c_none);
+        dirty.push_back(0);
+    } else {
+        i = it->second;
+    }
+    lat[i] = toMicro(latitude);
+    lon[i] = toMicro(longitude);
+    cos[i] = cosQ15(lat[i]);
+    if (!dirty[i]) {
+        dirty[i] = 1;
+        pendingCount++;
+    }
+}
+
+void DistanceTracker::remove(uint32_t nodeNum)
+{
+    auto it = index.find(nodeNum);
+    if (it == index.end())
+        return;
+    uint32_t i = it->second;
+    uint32_t last = num.size() - 1;
+    if (dirty[i])
+        pendingCount--;
+    if (i != last) {
+        num[i] = num[last];
+        lat[i] = lat[last];
+        lon[i] = lon[last];
+        cos[i] = cos[last];
+        meters[i] = meters[last];
+        shown[i] = shown[last];
+        dirty[i] = dirty[last];
+        index[num[i]] = i;
+    }
+    index.erase(it);
+    num.pop_back();
+    lat.pop_back();
+    lon.pop_back();
+    cos.pop_back();
+    meters.pop_back();
+    shown.pop_back();
+    dirty.pop_back();
+}
+
+void DistanceTracker::clear(void)
+{
+    num.clear();
+    lat.clear();
+    lon.clear();
+    cos.clear();
+    meters.clear();
+    shown.clear();
+    dirty.clear();
+    index.clear();
+    pendingCount = 0;
+    cursor = 0;
+}
+
+void DistanceTracker::invalidate(uint32_t nodeNum)
+{
+    auto it = index.find(nodeNum);
+    if (it == index.end())
+        return;
+    uint32_t i = it->second;
+    shown[i] = c_none;
+    if (!dirty[i]) {
+        dirty[i] = 1;
+        pendingCount++;
+    }
+}
+
+/**
+ * Continue where the last call stopped, so that a recomputation of all nodes is spread
+ * evenly over several calls.
+ */
+uint32_t DistanceTracker::process(uint32_t maxNodes, const Update &update)
+{
+    if (!originSet)
+        return 0;
+
+    uint32_t done = 0;
+    char text[c_textLen];
+    while (pendingCount && done < maxNodes) {
+        if (cursor >= num.size())
+            cursor = 0;
+        uint32_t i = cursor++;
+        if (!dirty[i])
+            continue;
+        dirty[i] = 0;
+        pendingCount--;
+        done++;
+
+        meters[i] = distance(originLat, originLon, originCos, lat[i], lon[i], cos[i]);
+        uint32_t value = displayValue(meters[i], metric);
+        if (value != shown[i]) {
+            shown[i] = value;
+            format(text, sizeof(text), value, metric);
+            update(num[i], text);
+        }
+    }
+    return done;
+}
+
+void DistanceTracker::markAll(void)
+{
+    std::fill(dirty.begin(), dirty.end(), 1);
+    pendingCount = dirty.size();
+}
+
+uint32_t DistanceTracker::distance(uint32_t nodeNum) const
+{
+    auto it = index.find(nodeNum);
+    return it != index.end() ? meters[it->second] : c_none;
+}
+
+uint32_t DistanceTracker::distance(int32_t lat1, int32_t lon1, uint16_t cos1, int32_t lat2, int32_t lon2, uint16_t cos2)
+{
+    int64_t dlat = (int64_t)lat2 - lat1;
+    int64_t dlon = (int64_t)lon2 - lon1;
+    if (dlon > 180000000)
+        dlon -= 360000000;
+    else if (dlon < -180000000)
+        dlon += 360000000;
+    int64_t x = (dlon * (cos1 + cos2)) >> 16; // mean of both Q15 cosines
+    uint64_t d = isqrt(uint64_t(x * x + dlat * dlat));
+    return uint32_t((d * c_metersPerDegree + 500000) / 1000000);
+}
+
+uint16_t DistanceTracker::cosQ15(int32_t latMicro)
+{
+    return (uint16_t)lroundf(cosf(latMicro * 1e-6f * float(M_PI) / 180.0f) * 32768.0f);
+}
+
+uint32_t DistanceTracker::displayValue(uint32_t meters, bool metric)
+{
+    if (metric)
+        return meters > 1000 ? c_large | ((meters + 50) / 100) : meters;
+    else
+        return meters > 100 ? c_large | uint32_t(meters / 160.9344f + 0.5f) : uint32_t(meters * 3.28084f);
+}
+
+void DistanceTracker::format(char *buf, size_t len, uint32_t value, bool metric)
+{
+    if (value & c_large) {
+        value &= ~c_large;
+        snprintf(buf, len, "%u.%u %s", value / 10, value % 10, metric ? "km" : "mi");
+    } else {
+        snprintf(buf, len, "%u %s", value, metric ? "m" : "ft");
+    }
+}
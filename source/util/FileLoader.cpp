@@ -1,12 +1,19 @@
 #include "util/FileLoader.h"
 #include "lvgl_private.h"
 #include "util/ILog.h"
+#include <string>
+
+#define BOOT_IMAGE "/boot/logo.png"
 
 fs::FS *FileLoader::_fs = nullptr;
+const char *FileLoader::_mountpoint = nullptr;
+MappedFile FileLoader::bootImage;
+lv_image_dsc_t FileLoader::bootImageDsc;
 
-void FileLoader::init(fs::FS *fs)
+void FileLoader::init(fs::FS *fs, const char *mountpoint)
 {
     _fs = fs;
+    _mountpoint = mountpoint;
     static lv_fs_drv_t drv;
     lv_fs_drv_init(&drv);
 
@@ -99,8 +106,25 @@ bool FileLoader::loadImage(lv_obj_t *img, const char *path)
     return lv_image_get_src((lv_obj_t *)img) != nullptr;
 }
 
+/**
+ * If the boot image can be mapped the PNG decoder gets it as in-memory image, which saves
+ * the open/read/seek round trips through the lv_fs driver. Otherwise it is loaded via the driver.
+ */
 bool FileLoader::loadBootImage(lv_obj_t *img)
 {
-    lv_image_set_src(img, FL_DRIVE_LETTER "/boot/logo.png");
+    if (_mountpoint && bootImage.open((std::string(_mountpoint) + BOOT_IMAGE).c_str()) && bootImage.size() > 0) {
+        memset(&bootImageDsc, 0, sizeof(bootImageDsc));
+        bootImageDsc.header.magic = LV_IMAGE_HEADER_MAGIC;
+        bootImageDsc.header.cf = LV_COLOR_FORMAT_RAW_ALPHA;
+        bootImageDsc.data = bootImage.data();
+        bootImageDsc.data_size = bootImage.size();
+        lv_image_set_src(img, &bootImageDsc);
+        if (lv_image_get_src((lv_obj_t *)img) != nullptr) {
+            ILOG_DEBUG("FileLoader: boot image %s (%d bytes)", bootImage.isMapped() ? "mapped" : "read", bootImage.size());
+            return true;
+        }
+    }
+    bootImage.close();
+    lv_image_set_src(img, FL_DRIVE_LETTER BOOT_IMAGE);
     return lv_image_get_src((lv_obj_t *)img) != nullptr;
 }
@@ -0,0 +1,58 @@
+#include "util/Histogram.h"
+#include <string.h>
+
+uint32_t Histogram::bucket(uint32_t value)
+{
+    if (value < c_subBuckets)
+        return value;
+    uint32_t msb = 31 - __builtin_clz(value);
+    uint32_t shift = msb - c_subBits;
+    return (shift + 1) * c_subBuckets + (value >> shift) - c_subBuckets;
+}
+
+uint32_t Histogram::lowerBound(uint32_t bucket)
+{
+    if (bucket < c_subBuckets)
+        return bucket;
+    uint32_t shift = bucket / c_subBuckets - 1;
+    return (c_subBuckets + bucket % c_subBuckets) << shift;
+}
+
+void Histogram::add(uint32_t value)
+{
+    counts[bucket(value)]++;
+    if (value < minimum)
+        minimum = value;
+    if (value > maximum)
+        maximum = value;
+    sum += value;
+    samples++;
+}
+
+void Histogram::clear(void)
+{
+    memset(counts, 0, sizeof(counts));
+    samples = 0;
+    minimum = UINT32_MAX;
+    maximum = 0;
+    sum = 0;
+}
+
+uint32_t Histogram::percentile(uint32_t percent) const
+{
+    if (!samples)
+        return 0;
+    // rank of the sample, rounded up so that percentile(100) is the last one
+    uint64_t rank = (uint64_t(samples) * (percent < 100 ? percent : 100) + 99) / 100;
+    if (rank == 0)
+        rank = 1;
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < c_buckets; i++) {
+        seen += counts[i];
+        if (seen >= rank) {
+            uint32_t upper = i + 1 < c_buckets ? lowerBound(i + 1) - 1 : UINT32_MAX;
+            return upper < maximum ? upper : maximum;
+        }
+    }
+    return maximum;
+}
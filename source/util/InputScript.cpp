@@ -0,0 +1,142 @@
+#include "util/InputScript.h"
+#include <fstream>
+#include <sstream>
+#include <stdlib.h>
+
+namespace
+{
+struct KeyName {
+    const char *name;
+    uint32_t key;
+};
+
+// LV_KEY_*
+const KeyName c_keys[] = {{"up", 17},   {"down", 18},      {"right", 19}, {"left", 20}, {"esc", 27},
+                          {"del", 127}, {"enter", 10},     {"next", 9},   {"prev", 11}, {"home", 2},
+                          {"end", 3},   {"backspace", 8},  {"space", ' '}};
+} // namespace
+
+bool InputScript::parse(const std::string &text)
+{
+    std::istringstream in(text);
+    std::string line;
+    uint32_t lineNo = 0;
+    while (std::getline(in, line)) {
+        lineNo++;
+        if (!parseLine(line)) {
+            error = lineNo;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool InputScript::load(const char *path)
+{
+    std::ifstream file(path);
+    if (!file)
+        return false;
+    std::stringstream text;
+    text << file.rdbuf();
+    return parse(text.str());
+}
+
+bool InputScript::parseLine(const std::string &line)
+{
+    std::istringstream in(line.substr(0, line.find('#')));
+    std::string cmd;
+    if (!(in >> cmd))
+        return true;
+
+    // a line with trailing arguments is invalid as a whole
+    uint32_t start = time;
+    size_t size = list.size();
+    bool wasPressed = pressed;
+
+    int32_t x, y;
+    if (cmd == "wait") {
+        uint32_t ms;
+        if (!(in >> ms))
+            return false;
+        time += ms;
+    } else if (cmd == "tap") {
+        if (!(in >> x >> y))
+            return false;
+        add(ePress, x, y);
+        time += c_tapMs;
+        add(eRelease, x, y);
+    } else if (cmd == "press" || cmd == "move") {
+        if (!(in >> x >> y) || (cmd == "move" && !pressed))
+            return false;
+        add(cmd == "press" ? ePress : eMove, x, y);
+    } else if (cmd == "release") {
+        if (!pressed)
+            return false;
+        add(eRelease, list.back().x, list.back().y);
+    } else if (cmd == "drag") {
+        int32_t x2, y2;
+        uint32_t ms;
+        if (!(in >> x >> y >> x2 >> y2 >> ms))
+            return false;
+        add(ePress, x, y);
+        uint32_t steps = ms / c_moveMs ? ms / c_moveMs : 1;
+        for (uint32_t i = 1; i <= steps; i++) {
+            time += ms / steps;
+            add(eMove, x + (x2 - x) * int32_t(i) / int32_t(steps), y + (y2 - y) * int32_t(i) / int32_t(steps));
+        }
+        add(eRelease, x2, y2);
+    } else if (cmd == "key") {
+        std::string name;
+        uint32_t key;
+        if (!(in >> name) || !keyCode(name, key))
+            return false;
+        add(eKey, 0, 0, key);
+    } else if (cmd == "snapshot") {
+        std::string name;
+        if (!(in >> name))
+            return false;
+        add(eSnapshot, 0, 0, 0, name);
+    } else {
+        return false;
+    }
+    std::string rest;
+    if (in >> rest) {
+        time = start;
+        list.resize(size);
+        pressed = wasPressed;
+        return false;
+    }
+    return true;
+}
+
+void InputScript::add(Action action, int32_t x, int32_t y, uint32_t key, const std::string &name)
+{
+    if (action == ePress)
+        pressed = true;
+    else if (action == eRelease)
+        pressed = false;
+    list.push_back(Event{time, action, x, y, key, name});
+}
+
+/**
+ * A key is given by name, as a single character or as a decimal code.
+ */
+bool InputScript::keyCode(const std::string &name, uint32_t &key)
+{
+    for (const KeyName &k : c_keys) {
+        if (name == k.name) {
+            key = k.key;
+            return true;
+        }
+    }
+    if (name.size() == 1) {
+        key = (uint8_t)name[0];
+        return true;
+    }
+    char *end;
+    unsigned long code = strtoul(name.c_str(), &end, 10);
+    if (*end != '\0')
+        return false;
+    key = (uint32_t)code;
+    return true;
+}
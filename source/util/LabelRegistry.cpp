@@ -0,0 +1,157 @@
+#include "util/LabelRegistry.h"
+#include <utility>
+
+LabelRegistry::LabelRegistry(Translate translate, GetText getText, SetText setText, Resolve resolve)
+    : translate(std::move(translate)), getText(std::move(getText)), setText(std::move(setText)), resolve(std::move(resolve))
+{
+}
+
+bool LabelRegistry::bind(Label label, const char *msgId, Format format)
+{
+    bool added = !bound(label);
+    apply(entries[entry(label, msgId, std::move(format))]);
+    return added;
+}
+
+bool LabelRegistry::adopt(Label label, const char *msgId)
+{
+    bool added = !bound(label);
+    Entry &e = entries[entry(label, msgId, nullptr)];
+    e.hash = hash(getText(label));
+    return added;
+}
+
+bool LabelRegistry::adopt(Label label)
+{
+    const char *msgId = resolve && !bound(label) ? resolve(getText(label)) : nullptr;
+    return msgId && adopt(label, msgId);
+}
+
+void LabelRegistry::unbind(Label label)
+{
+    auto it = index.find(label);
+    if (it != index.end())
+        remove(it->second);
+}
+
+const char *LabelRegistry::msgId(Label label) const
+{
+    auto it = index.find(label);
+    return it != index.end() ? entries[it->second].msgId : nullptr;
+}
+
+void LabelRegistry::clear(void)
+{
+    entries.clear();
+    index.clear();
+    staleCount = 0;
+}
+
+/**
+ * Labels changed by their owners are resolved now, while their texts are still in the old locale.
+ */
+void LabelRegistry::invalidate(void)
+{
+    for (uint32_t i = entries.size(); i-- > 0;) {
+        if (!changed(i))
+            entries[i].stale = true;
+    }
+    staleCount = entries.size();
+}
+
+/**
+ * Walks backwards so that removing a released label (moving the last entry into its place)
+ * does not skip an entry.
+ */
+uint32_t LabelRegistry::relabel(const Visible &visible, uint32_t budget)
+{
+    for (uint32_t i = entries.size(); i-- > 0 && staleCount > 0;) {
+        Entry &e = entries[i];
+        if (!e.stale)
+            continue;
+        bool show = visible(e.label);
+        if (!show && budget == 0)
+            continue;
+        if (changed(i))
+            continue;
+        apply(e);
+        if (!show)
+            budget--;
+    }
+    return staleCount;
+}
+
+uint32_t LabelRegistry::hash(const char *text)
+{
+    uint32_t h = 2166136261u;
+    for (const unsigned char *s = (const unsigned char *)text; s && *s; s++)
+        h = (h ^ *s) * 16777619u;
+    return h;
+}
+
+uint32_t LabelRegistry::entry(Label label, const char *msgId, Format format)
+{
+    auto it = index.find(label);
+    if (it == index.end()) {
+        it = index.emplace(label, entries.size()).first;
+        entries.push_back(Entry{label, msgId, nullptr, 0, false});
+    }
+    Entry &e = entries[it->second];
+    e.msgId = msgId;
+    e.format = std::move(format);
+    if (e.stale) {
+        e.stale = false;
+        staleCount--;
+    }
+    return it->second;
+}
+
+void LabelRegistry::apply(Entry &e)
+{
+    const char *translated = translate(e.msgId);
+    if (e.format) {
+        char buf[256];
+        buf[0] = '\0';
+        e.format(buf, sizeof(buf), translated);
+        setText(e.label, buf);
+        e.hash = hash(buf);
+    } else {
+        setText(e.label, translated);
+        e.hash = hash(translated);
+    }
+    if (e.stale) {
+        e.stale = false;
+        staleCount--;
+    }
+}
+
+bool LabelRegistry::changed(uint32_t i)
+{
+    Entry &e = entries[i];
+    const char *text = getText(e.label);
+    if (hash(text) == e.hash)
+        return false;
+    const char *msgId = resolve ? resolve(text) : nullptr;
+    if (msgId) {
+        e.msgId = msgId;
+        e.format = nullptr;
+        e.hash = hash(text);
+        return false;
+    }
+    releasedCount++;
+    remove(i);
+    return true;
+}
+
+void LabelRegistry::remove(uint32_t i)
+{
+    if (entries[i].stale)
+        staleCount--;
+    index.erase(entries[i].label);
+    uint32_t last = entries.size() - 1;
+    if (i != last) {
+        entries[i] = std::move(entries[last]);
+        index[entries[i].label] = i;
+    }
+    entries.pop_back();
+}
@@ -1,12 +1,19 @@
 #include "util/LogRotate.h"
+#include "util/Crc32.h"
 #include "util/ILog.h"
+#include <algorithm>
 #include <ctime>
 
 #define FILE_PREFIX "log_"
+#define RECOVER_FILE "recover.tmp"
 
-LogRotate::LogRotate(fs::FS &fs, const char *logDir, uint32_t maxLen, uint32_t maxSize, uint32_t maxFiles, uint32_t maxFileSize)
-    : c_maxLen(maxLen), c_maxSize(maxSize), c_maxFiles(maxFiles), c_maxFileSize(maxFileSize), _fs(fs), rootDirName(logDir),
-      numFiles(0), minLogNum(0), maxLogNum(0), currentLogRead(0), currentLogWrite(0), currentSize(0), totalSize(0)
+LogRotate::LogRotate(fs::FS &fs, const char *logDir, uint32_t maxLen, uint32_t maxSize, uint32_t maxFiles, uint32_t maxFileSize,
+                     bool compress)
+    : c_maxLen(maxLen), c_maxSize(maxSize), c_maxFiles(maxFiles), c_maxFileSize(maxFileSize),
+      c_blockSize(std::max<uint32_t>(512, 2 * (sizeof(RecordHeader) + maxLen))), c_compress(compress), _fs(fs),
+      rootDirName(logDir), numFiles(0), minLogNum(0), maxLogNum(0), currentLogRead(0), currentLogWrite(0), currentSize(0),
+      totalSize(0), readFormat(eRecords), buf(sizeof(RecordHeader) + maxLen), mapPos(0),
+      readOffset(0), lastRead(0)
 
 {
 }
@@ -17,11 +24,28 @@ void LogRotate::init(void)
         _fs.mkdir(rootDirName);
         ILOG_INFO("LogRotate: no log files found.");
     } else {
+        // remove leftover of an interrupted recovery or compression
+        String recoverName = rootDirName + "/" RECOVER_FILE;
+        if (_fs.exists(recoverName))
+            _fs.remove(recoverName);
+
         scanLogDir(numFiles, minLogNum, maxLogNum, currentSize, totalSize);
         currentLogRead = minLogNum;
         currentLogWrite = maxLogNum;
         ILOG_INFO("LogRotate: found %d log files using %d bytes (%d%%).", numFiles, totalSize, (totalSize * 100) / c_maxSize);
-        if (currentSize > c_maxFileSize - c_maxLen) {
+
+        time_t start = millis();
+        LogFormat format = eRecords;
+        for (uint32_t num = minLogNum; num > 0 && num <= maxLogNum; num++) {
+            uint32_t removed = recoverLog(num, format);
+            totalSize -= removed;
+            if (num == maxLogNum)
+                currentSize -= removed;
+        }
+        ILOG_DEBUG("LogRotate: recovery scan took %d ms", millis() - start);
+
+        // never append records to a legacy log or compressed segment
+        if (currentSize > c_maxFileSize - c_maxLen || (format != eRecords && currentSize > 0)) {
             ILOG_DEBUG("currentSize(%d) > c_maxFileSize(%d) - c_maxLen(%d)", currentSize, c_maxFileSize, c_maxLen);
             ILOG_DEBUG("numFiles(%d) > c_maxFiles(%d) || totalSize(%d) >= c_maxSize(%d)", numFiles, c_maxFiles, totalSize,
                        c_maxSize);
@@ -54,55 +78,91 @@ bool LogRotate::readNext(ILogEntry &entry)
         if (!rootDir)
             return false;
     }
-    if (!currentFile) {
-        if (currentLogRead == 0 || currentLogRead > maxLogNum)
-            return false;
-        do {
-            currentFile = _fs.open(logFileName(currentLogRead), FILE_READ);
-            if (currentFile && currentFile.available()) {
-                break;
-            }
-            currentFile.close();
-            currentLogRead++;
-        } while (currentLogRead <= maxLogNum);
-        if (!currentFile || !currentFile.available() || currentLogRead > maxLogNum) {
-            rootDir.close();
-            return false;
+    if (!currentFile && !mapped.isOpen() && !openReadLog()) {
+        rootDir.close();
+        return false;
+    }
+
+    size_t len = 0;
+    Position position = (Position(currentLogRead) << 32) | readOffset;
+    if (readFormat == eLegacy) {
+        // elegant way to let the logentry do its work it knows best and pass just a temporary function for reading
+        len = entry.deserialize([this](uint8_t *buf, size_t size) { return this->readBytes(buf, size); });
+        readOffset += len;
+    } else {
+        int32_t length = -1;
+        const uint8_t *payload = buf.data() + sizeof(RecordHeader);
+        if (readFormat == eSegment)
+            length = readRecord([this](uint8_t *data, size_t size) { return decoder->read(data, size); });
+        else if (mapped.isOpen())
+            payload = mappedRecord(length);
+        else
+            length = readRecord([this](uint8_t *data, size_t size) { return currentFile.read(data, size); });
+        if (length >= 0) {
+            // let the logentry deserialize from the record payload
+            size_t remaining = length;
+            len = entry.deserialize([&payload, &remaining](uint8_t *data, size_t size) {
+                size = std::min(size, remaining);
+                memcpy(data, payload, size);
+                payload += size;
+                remaining -= size;
+                return size;
+            });
+            readOffset += sizeof(RecordHeader) + length;
         }
-        ILOG_DEBUG("-> reading %s (%d bytes)", currentFile.name(), currentFile.size());
     }
 
-    // elegant way to let the logentry do its work it knows best and pass just a temporary function for reading
-    if (!entry.deserialize([this](uint8_t *buf, size_t size) { return this->currentFile.read(buf, size); })) {
+    if (!len) {
+        decoder.reset();
         currentFile.close();
+        mapped.close();
         currentLogRead++;
         return readNext(entry);
-    } else
+    } else {
+        lastRead = position;
         return true;
+    }
 }
 
 bool LogRotate::write(const ILogEntry &entry)
 {
     time_t start = millis();
-    if (currentSize + entry.size() >= c_maxFileSize || totalSize + entry.size() >= c_maxSize) {
+    size_t recordSize = sizeof(RecordHeader) + entry.size();
+    if (currentSize + recordSize >= c_maxFileSize || totalSize + recordSize >= c_maxSize) {
         // log rotation
-        ILOG_DEBUG("LogRotation: %d >= %d || %d >= %d", currentSize + entry.size(), c_maxFileSize, totalSize + entry.size(),
+        ILOG_DEBUG("LogRotation: %d >= %d || %d >= %d", currentSize + recordSize, c_maxFileSize, totalSize + recordSize,
                    c_maxSize);
+        if (c_compress)
+            totalSize -= compressLog(currentLogWrite);
         numFiles++;
         currentSize = 0;
         currentLogWrite++;
         currentLogName = logFileName(currentLogWrite);
-        while ((numFiles >= c_maxFiles || totalSize + entry.size() > c_maxSize) && removeLog())
+        while ((numFiles >= c_maxFiles || totalSize + recordSize > c_maxSize) && removeLog())
             ;
     }
 
     // elegant way to let the logentry do its work it knows best and pass just a temporary function for writing
+    RecordHeader header;
+    header.length = 0;
+    entry.serialize([this, &header](const uint8_t *data, size_t size) {
+        size = std::min(size, buf.size() - sizeof(RecordHeader) - header.length);
+        memcpy(buf.data() + sizeof(RecordHeader) + header.length, data, size);
+        header.length += size;
+        return size;
+    });
+    header.magic = c_recordMagic;
+    header.crc = crc32(buf.data() + sizeof(RecordHeader), header.length, crc32(&header.length, sizeof(header.length)));
+    memcpy(buf.data(), &header, sizeof(RecordHeader));
+    recordSize = sizeof(RecordHeader) + header.length;
+
+    // write the record at once to keep the window for a torn write small
     File file = _fs.open(currentLogName, FILE_APPEND);
-    entry.serialize([&file](const uint8_t *buf, size_t size) { return file.write(buf, size); });
+    file.write(buf.data(), recordSize);
     file.close();
 
-    currentSize += entry.size();
-    totalSize += entry.size();
+    currentSize += recordSize;
+    totalSize += recordSize;
 
     // ILOG_DEBUG("LogRotate: %d bytes written in %d ms to %s (%d/%d bytes, total: %d)", entry.size(), millis() - start,
     //            currentLogName.c_str(), currentSize, c_maxFileSize, totalSize);
@@ -151,6 +211,15 @@ bool LogRotate::clear(void)
     return error;
 }
 
+/**
+ * Map log files for reading instead of going through fs; mountpoint is the host directory
+ * fs is mounted to (e.g. portduino's VFS root)
+ */
+void LogRotate::mapFiles(const char *mountpoint)
+{
+    mapRoot = mountpoint ? mountpoint : "";
+}
+
 /**
  * Return number of log files
  */
@@ -175,6 +244,21 @@ uint32_t LogRotate::current(void) const
     return currentLogRead;
 }
 
+/**
+ * Position behind the last record written; the next record is written there or at the start of the
+ * next log file. It only grows until the log is cleared. Records compressed later keep their position,
+ * it refers to the uncompressed log file.
+ */
+LogRotate::Position LogRotate::endPosition(void) const
+{
+    return (Position(currentLogWrite) << 32) | currentSize;
+}
+
+LogRotate::Position LogRotate::startPosition(void) const
+{
+    return Position(minLogNum) << 32;
+}
+
 /**
  * Generate a log file name based on num
  */
@@ -185,6 +269,298 @@ String LogRotate::logFileName(uint32_t num)
     return filename;
 }
 
+/**
+ * Extract the log number from a file name (with or without path) of the form log_<num>.log
+ */
+bool LogRotate::parseLogFileName(const char *name, uint32_t &num)
+{
+    const char *base = strrchr(name, '/');
+    base = base ? base + 1 : name;
+    if (strncmp(base, FILE_PREFIX, sizeof(FILE_PREFIX) - 1) != 0)
+        return false;
+
+    const char *digits = base + sizeof(FILE_PREFIX) - 1;
+    const char *p = digits;
+    uint32_t n = 0;
+    while (*p >= '0' && *p <= '9' && p - digits < 9)
+        n = n * 10 + (*p++ - '0');
+    if (p == digits || n == 0 || strcmp(p, ".log") != 0)
+        return false;
+    num = n;
+    return true;
+}
+
+LogRotate::LogFormat LogRotate::logFormat(File &file)
+{
+    uint8_t magic[2];
+    LogFormat format = logFormat(magic, file.read(magic, sizeof(magic)));
+    file.seek(0);
+    return format;
+}
+
+/**
+ * Log files written before the record header was introduced start directly with the entry.
+ */
+LogRotate::LogFormat LogRotate::logFormat(const uint8_t *data, size_t len)
+{
+    uint16_t magic = c_recordMagic;
+    if (len >= sizeof(magic))
+        memcpy(&magic, data, sizeof(magic));
+    if (magic == c_recordMagic)
+        return eRecords;
+    return magic == c_segmentMagic ? eSegment : eLegacy;
+}
+
+/**
+ * Open the next log file that contains data. If enabled the file is mapped, otherwise
+ * (or if mapping fails) it is opened via fs.
+ */
+bool LogRotate::openReadLog(void)
+{
+    if (currentLogRead == 0)
+        return false;
+    for (; currentLogRead <= maxLogNum; currentLogRead++) {
+        String name = logFileName(currentLogRead);
+        if (mapRoot.length() > 0 && mapped.open((mapRoot + name).c_str())) {
+            if (mapped.size() > 0)
+                break;
+            mapped.close();
+            continue;
+        }
+        currentFile = _fs.open(name, FILE_READ);
+        if (currentFile && currentFile.available())
+            break;
+        currentFile.close();
+    }
+    if (currentLogRead > maxLogNum)
+        return false;
+
+    mapPos = 0;
+    readOffset = 0;
+    readFormat = mapped.isOpen() ? logFormat(mapped.data(), mapped.size()) : logFormat(currentFile);
+    if (readFormat == eSegment) {
+        SegmentHeader header;
+        if (readBytes((uint8_t *)&header, sizeof(header)) != sizeof(header) || header.version != c_segmentVersion)
+            header.rawSize = 0; // unknown segment, skip it
+        decoder.reset(new Lzss::Decoder([this](uint8_t *data, size_t size) { return readBytes(data, size); }, header.rawSize));
+    }
+    ILOG_DEBUG("-> reading log %d (%d bytes, format %d%s)", currentLogRead,
+               mapped.isOpen() ? mapped.size() : currentFile.size(), readFormat, mapped.isMapped() ? ", mapped" : "");
+    return true;
+}
+
+size_t LogRotate::readBytes(uint8_t *data, size_t size)
+{
+    if (!mapped.isOpen())
+        return currentFile.read(data, size);
+    size = std::min(size, mapped.size() - mapPos);
+    memcpy(data, mapped.data() + mapPos, size);
+    mapPos += size;
+    return size;
+}
+
+/**
+ * Same checks as readRecord() but without copying the record. If the record of the current
+ * log file is incomplete the view is extended in case the file has grown since it was mapped.
+ */
+const uint8_t *LogRotate::mappedRecord(int32_t &length)
+{
+    length = -1;
+    RecordHeader header;
+    do {
+        size_t available = mapped.size() - mapPos;
+        if (available < sizeof(RecordHeader))
+            continue;
+        const uint8_t *record = mapped.data() + mapPos;
+        memcpy(&header, record, sizeof(RecordHeader));
+        if (header.magic != c_recordMagic || header.length > c_maxLen)
+            return nullptr;
+        if (available < sizeof(RecordHeader) + header.length)
+            continue;
+
+        const uint8_t *payload = record + sizeof(RecordHeader);
+        if (crc32(payload, header.length, crc32(&header.length, sizeof(header.length))) != header.crc)
+            return nullptr;
+        mapPos += sizeof(RecordHeader) + header.length;
+        length = header.length;
+        return payload;
+    } while (currentLogRead == currentLogWrite && mapped.refresh());
+    return nullptr;
+}
+
+int32_t LogRotate::readRecord(const std::function<size_t(uint8_t *, size_t)> &read)
+{
+    RecordHeader header;
+    if (read(buf.data(), sizeof(RecordHeader)) != sizeof(RecordHeader))
+        return -1;
+    memcpy(&header, buf.data(), sizeof(RecordHeader));
+    if (header.magic != c_recordMagic || header.length > c_maxLen)
+        return -1;
+
+    uint8_t *payload = buf.data() + sizeof(RecordHeader);
+    if (read(payload, header.length) != header.length ||
+        crc32(payload, header.length, crc32(&header.length, sizeof(header.length))) != header.crc)
+        return -1;
+    return header.length;
+}
+
+/**
+ * Check header, length and crc of the record at offset; the payload is left in buf.
+ * Returns the offset of the following record or 0 if the record is not valid.
+ */
+uint32_t LogRotate::validRecord(File &file, uint32_t offset, uint32_t fileSize)
+{
+    if (offset + sizeof(RecordHeader) > fileSize || !file.seek(offset))
+        return 0;
+    int32_t length = readRecord([&file](uint8_t *data, size_t size) { return file.read(data, size); });
+    if (length < 0)
+        return 0;
+    return offset + sizeof(RecordHeader) + length;
+}
+
+/**
+ * Search the block starting at offset for the first valid record. As a record is always smaller than
+ * a block, every block within the valid part of a file contains the start of a record.
+ */
+uint32_t LogRotate::findRecord(File &file, uint32_t offset, uint32_t fileSize)
+{
+    uint32_t windowSize = std::min(fileSize - offset, c_blockSize + (uint32_t)sizeof(RecordHeader) + c_maxLen);
+    std::vector<uint8_t> window(windowSize);
+    if (!file.seek(offset) || file.read(window.data(), windowSize) != windowSize)
+        return UINT32_MAX;
+
+    for (uint32_t pos = 0; pos < c_blockSize && pos + sizeof(RecordHeader) <= windowSize; pos++) {
+        RecordHeader header;
+        memcpy(&header, &window[pos], sizeof(RecordHeader));
+        if (header.magic != c_recordMagic || header.length > c_maxLen || pos + sizeof(RecordHeader) + header.length > windowSize)
+            continue;
+        const uint8_t *payload = &window[pos + sizeof(RecordHeader)];
+        if (crc32(payload, header.length, crc32(&header.length, sizeof(header.length))) == header.crc)
+            return offset + pos;
+    }
+    return UINT32_MAX;
+}
+
+/**
+ * Records are only appended, so the valid records form a prefix of the file. A binary search over
+ * the block checkpoints finds the last block containing a valid record, then only the remaining
+ * records from there on are checked. Everything behind the last valid record is truncated.
+ */
+uint32_t LogRotate::recoverLog(uint32_t num, LogFormat &format)
+{
+    format = eRecords;
+    String name = logFileName(num);
+    File file = _fs.open(name, FILE_READ);
+    if (!file)
+        return 0;
+    uint32_t fileSize = file.size();
+    if (fileSize > 0)
+        format = logFormat(file);
+    if (fileSize == 0 || format != eRecords) {
+        // segments are replaced atomically, legacy logs have no means to check them
+        file.close();
+        return 0;
+    }
+
+    uint32_t validSize = 0;
+    if (validRecord(file, 0, fileSize)) {
+        uint32_t lo = 0;
+        uint32_t hi = (fileSize - 1) / c_blockSize;
+        while (lo < hi) {
+            uint32_t mid = (lo + hi + 1) / 2;
+            if (findRecord(file, mid * c_blockSize, fileSize) != UINT32_MAX)
+                lo = mid;
+            else
+                hi = mid - 1;
+        }
+
+        uint32_t offset = lo ? findRecord(file, lo * c_blockSize, fileSize) : 0;
+        uint32_t next;
+        while (offset < fileSize && (next = validRecord(file, offset, fileSize)) != 0)
+            offset = next;
+        validSize = offset;
+    }
+    file.close();
+
+    if (validSize == fileSize)
+        return 0;
+    ILOG_WARN("LogRotate: %s corrupted at offset %d, truncating %d bytes", name.c_str(), validSize, fileSize - validSize);
+    truncateLog(name, validSize);
+    return fileSize - validSize;
+}
+
+/**
+ * Compress the records of a log file into a segment (written to a temporary file and renamed).
+ * The segment replaces the log only if it is smaller.
+ */
+uint32_t LogRotate::compressLog(uint32_t num)
+{
+    String name = logFileName(num);
+    File file = _fs.open(name, FILE_READ);
+    if (!file)
+        return 0;
+    uint32_t fileSize = file.size();
+    if (fileSize == 0 || logFormat(file) != eRecords) {
+        file.close();
+        return 0;
+    }
+
+    time_t start = millis();
+    std::vector<uint8_t> raw(fileSize);
+    size_t len = file.read(raw.data(), fileSize);
+    file.close();
+    if (len != fileSize)
+        return 0;
+
+    SegmentHeader header{c_segmentMagic, c_segmentVersion, fileSize};
+    std::vector<uint8_t> segment((const uint8_t *)&header, (const uint8_t *)&header + sizeof(header));
+    Lzss::compress(raw.data(), raw.size(), segment);
+    if (segment.size() >= fileSize)
+        return 0;
+
+    String tmpName = rootDirName + "/" RECOVER_FILE;
+    File tmp = _fs.open(tmpName, FILE_WRITE);
+    bool ok = tmp && tmp.write(segment.data(), segment.size()) == segment.size();
+    tmp.close();
+    if (!ok || !_fs.rename(tmpName, name)) {
+        ILOG_ERROR("LogRotate: failed to compress %s", name.c_str());
+        _fs.remove(tmpName);
+        return 0;
+    }
+    ILOG_DEBUG("LogRotate: compressed %s %d -> %d bytes in %d ms", name.c_str(), fileSize, segment.size(), millis() - start);
+    return fileSize - segment.size();
+}
+
+/**
+ * Fs has no truncate, so copy the valid part into a temporary file and replace the log with it
+ */
+bool LogRotate::truncateLog(const String &name, uint32_t size)
+{
+    String recoverName = rootDirName + "/" RECOVER_FILE;
+    File src = _fs.open(name, FILE_READ);
+    File dst = _fs.open(recoverName, FILE_WRITE);
+    if (!src || !dst) {
+        ILOG_ERROR("LogRotate: failed to truncate %s", name.c_str());
+        return false;
+    }
+
+    uint32_t copied = 0;
+    while (copied < size) {
+        size_t len = src.read(buf.data(), std::min<size_t>(buf.size(), size - copied));
+        if (len == 0 || dst.write(buf.data(), len) != len)
+            break;
+        copied += len;
+    }
+    src.close();
+    dst.close();
+    if (copied != size) {
+        ILOG_ERROR("LogRotate: failed to truncate %s", name.c_str());
+        _fs.remove(recoverName);
+        return false;
+    }
+    return _fs.rename(recoverName, name);
+}
+
 /**
  * remove the oldest log
  */
@@ -220,7 +596,7 @@ size_t LogRotate::removeLog(void)
  */
 void LogRotate::scanLogDir(uint32_t &num, uint32_t &minLog, uint32_t &maxLog, uint32_t &logSize, uint32_t &total)
 {
-    num = maxLog = logSize = 0;
+    num = maxLog = logSize = total = 0;
     minLog = UINT32_MAX;
 
     ILOG_DEBUG("scanning log folder %s", rootDirName.c_str());
@@ -228,31 +604,22 @@ void LogRotate::scanLogDir(uint32_t &num, uint32_t &minLog, uint32_t &maxLog, ui
         rootDir = _fs.open(rootDirName);
     File file = rootDir.openNextFile();
     while (file) {
-        if (!file.isDirectory()) {
+        uint32_t logNum = 0;
+        if (!file.isDirectory() && parseLogFileName(file.name(), logNum)) {
             num++;
             size_t size = file.size();
             total += size;
             ILOG_DEBUG(" %s(%d bytes)", file.name(), size);
 
-            String format;
-            if (file.name()[0] == '/') {
-                format = rootDirName + '/' + String(FILE_PREFIX) + String("%u.log");
-            } else {
-                format = String(FILE_PREFIX) + String("%u.log");
+            if (logNum < minLog) {
+                minLog = logNum;
             }
-
-            uint32_t logNum = 0;
-            if (sscanf(file.name(), format.c_str(), &logNum) > 0 && logNum > 0) {
-                if (logNum < minLog) {
-                    minLog = logNum;
-                }
-                if (logNum > maxLog) {
-                    maxLog = logNum;
-                    logSize = size;
-                }
-            } else {
-                ILOG_ERROR("sscanf() failed for %s", file.name());
+            if (logNum > maxLog) {
+                maxLog = logNum;
+                logSize = size;
             }
+        } else if (!file.isDirectory()) {
+            ILOG_WARN("ignoring %s in log folder", file.name());
         }
         file.close();
         file = rootDir.openNextFile();
@@ -0,0 +1,152 @@
+#include "util/Lzss.h"
+#include <algorithm>
+#include <string.h>
+
+namespace
+{
+constexpr uint32_t c_hashBits = 10;
+constexpr uint32_t c_maxChain = 32;
+
+inline uint32_t hash3(const uint8_t *p)
+{
+    return ((p[0] << 8) ^ (p[1] << 4) ^ p[2]) & ((1 << c_hashBits) - 1);
+}
+} // namespace
+
+/**
+ * Greedy parse with hash chains over 3-byte prefixes (chain depth limited to keep the
+ * worst case bounded on the MCU).
+ */
+void Lzss::compress(const uint8_t *data, size_t len, std::vector<uint8_t> &out)
+{
+    // prev holds the distance to the previous position with the same hash (0: none within the window)
+    std::vector<int32_t> head(1 << c_hashBits, -1);
+    std::vector<uint16_t> prev(len, 0);
+
+    size_t flagPos = 0;
+    uint32_t tokens = 8;
+    auto beginToken = [&](bool literal) {
+        if (tokens == 8) {
+            flagPos = out.size();
+            out.push_back(0);
+            tokens = 0;
+        }
+        if (literal)
+            out[flagPos] |= 1 << tokens;
+        tokens++;
+    };
+    auto insert = [&](size_t pos) {
+        if (pos + c_minMatch <= len) {
+            uint32_t h = hash3(&data[pos]);
+            if (head[h] >= 0 && pos - head[h] <= c_windowSize)
+                prev[pos] = pos - head[h];
+            head[h] = pos;
+        }
+    };
+
+    size_t pos = 0;
+    while (pos < len) {
+        uint32_t bestLen = 0;
+        uint32_t bestDist = 0;
+        if (pos + c_minMatch <= len) {
+            uint32_t maxLen = std::min<size_t>(c_maxMatch, len - pos);
+            int32_t candidate = head[hash3(&data[pos])];
+            for (uint32_t chain = 0; candidate >= 0 && chain < c_maxChain; chain++) {
+                uint32_t dist = pos - candidate;
+                if (dist > c_windowSize)
+                    break;
+                uint32_t l = 0;
+                while (l < maxLen && data[candidate + l] == data[pos + l])
+                    l++;
+                if (l > bestLen) {
+                    bestLen = l;
+                    bestDist = dist;
+                    if (l == maxLen)
+                        break;
+                }
+                candidate = prev[candidate] ? candidate - prev[candidate] : -1;
+            }
+        }
+
+        if (bestLen >= c_minMatch) {
+            beginToken(false);
+            uint16_t token = ((bestDist - 1) << c_lengthBits) | (bestLen - c_minMatch);
+            out.push_back(token >> 8);
+            out.push_back(token & 0xff);
+            for (uint32_t i = 0; i < bestLen; i++)
+                insert(pos + i);
+            pos += bestLen;
+        } else {
+            beginToken(true);
+            out.push_back(data[pos]);
+            insert(pos);
+            pos++;
+        }
+    }
+}
+
+Lzss::Decoder::Decoder(Source source, uint32_t rawSize)
+    : source(source), rawSize(rawSize), produced(0), matchDist(0), matchLen(0), flags(0), flagBits(0), inPos(0), inLen(0),
+      corrupted(false)
+{
+    memset(window, 0, sizeof(window));
+}
+
+int Lzss::Decoder::nextByte(void)
+{
+    if (inPos == inLen) {
+        inLen = source(input, sizeof(input));
+        inPos = 0;
+        if (inLen == 0)
+            return -1;
+    }
+    return input[inPos++];
+}
+
+size_t Lzss::Decoder::read(uint8_t *buf, size_t len)
+{
+    size_t count = 0;
+    while (count < len && produced < rawSize && !corrupted) {
+        if (matchLen == 0) {
+            if (flagBits == 0) {
+                int f = nextByte();
+                if (f < 0)
+                    break;
+                flags = f;
+                flagBits = 8;
+            }
+            bool literal = flags & 1;
+            flags >>= 1;
+            flagBits--;
+            if (literal) {
+                int c = nextByte();
+                if (c < 0)
+                    break;
+                window[produced & (c_windowSize - 1)] = c;
+                buf[count++] = c;
+                produced++;
+                continue;
+            }
+            int hi = nextByte();
+            int lo = nextByte();
+            if (hi < 0 || lo < 0)
+                break;
+            uint16_t token = (hi << 8) | lo;
+            matchDist = (token >> c_lengthBits) + 1;
+            matchLen = (token & ((1 << c_lengthBits) - 1)) + c_minMatch;
+            if (matchDist > produced) {
+                // references data before the start
+                matchLen = 0;
+                corrupted = true;
+                break;
+            }
+        }
+
+        uint8_t c = window[(produced - matchDist) & (c_windowSize - 1)];
+        window[produced & (c_windowSize - 1)] = c;
+        buf[count++] = c;
+        produced++;
+        matchLen--;
+    }
+    return count;
+}
@@ -0,0 +1,103 @@
+#include "util/MappedFile.h"
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(void) : fd(-1), addr(nullptr), length(0) {}
+
+MappedFile::~MappedFile(void)
+{
+    close();
+}
+
+bool MappedFile::open(const char *path)
+{
+    close();
+#if defined(__linux__)
+    fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+    struct stat sb;
+    if (fstat(fd, &sb) != 0 || !load(sb.st_size)) {
+        close();
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool MappedFile::refresh(void)
+{
+#if defined(__linux__)
+    struct stat sb;
+    if (fd < 0 || fstat(fd, &sb) != 0 || (size_t)sb.st_size <= length)
+        return false;
+    return load(sb.st_size);
+#else
+    return false;
+#endif
+}
+
+void MappedFile::close(void)
+{
+#if defined(__linux__)
+    if (addr)
+        munmap(addr, length);
+    if (fd >= 0)
+        ::close(fd);
+#endif
+    fd = -1;
+    addr = nullptr;
+    length = 0;
+    copy.clear();
+}
+
+/**
+ * (Re-)create the view for fileSize bytes. A file that was truncated while mapped
+ * would raise SIGBUS on access, so the view never shrinks; log files are only appended
+ * to or replaced by rename which keeps the mapped inode alive.
+ */
+bool MappedFile::load(size_t fileSize)
+{
+#if defined(__linux__)
+    if (addr) {
+        munmap(addr, length);
+        addr = nullptr;
+    }
+    length = 0;
+    if (fileSize == 0) {
+        copy.clear();
+        return true;
+    }
+
+    // the files are read completely, so prefault all pages at once
+    void *p = fileSize >= c_minMapSize ? mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0) : MAP_FAILED;
+    if (p != MAP_FAILED) {
+        copy.clear();
+        addr = p;
+        length = fileSize;
+        return true;
+    }
+
+    // small files or file systems without mmap support: read the file
+    size_t pos = copy.size();
+    copy.resize(fileSize);
+    while (pos < fileSize) {
+        ssize_t n = pread(fd, copy.data() + pos, fileSize - pos, pos);
+        if (n <= 0)
+            break;
+        pos += n;
+    }
+    copy.resize(pos);
+    length = pos;
+    return pos > 0;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,165 @@
+#include "util/MessageRestorer.h"
+#include "util/ILog.h"
+#include <algorithm>
+#include <chrono>
+
+MessageRestorer::MessageRestorer(uint32_t maxPerChat)
+    : c_maxPerChat(maxPerChat), ownNode(0), seq(0), next(0), numRead(0), numBytes(0), numStaged(0),
+      isLoaded(false)
+{
+}
+
+void MessageRestorer::begin(uint32_t node)
+{
+    ownNode = node;
+    chats.clear();
+    pending.clear();
+    seq = next = numRead = numBytes = numStaged = 0;
+    isLoaded = false;
+}
+
+/**
+ * Read a block of log entries into the per-chat staging lists.
+ * Only the newest c_maxPerChat messages of each chat are kept, the older ones would be
+ * created and deleted again by the view anyway.
+ */
+bool MessageRestorer::load(ReadFunc read, uint32_t maxRecords)
+{
+    if (isLoaded)
+        return true;
+
+    LogMessageEnv msg;
+    for (uint32_t i = 0; i < maxRecords; i++) {
+        if (!read(msg)) {
+            finishLoading();
+            return true;
+        }
+        numRead++;
+        numBytes += msg.size();
+        stage(msg);
+    }
+    return false;
+}
+
+/**
+ * The queue only grows while the log is read, reading is much faster than messages arrive.
+ */
+void MessageRestorer::queueLive(uint32_t from, uint32_t to, uint8_t ch, time_t time, uint32_t len, const uint8_t *bytes,
+                                bool logged)
+{
+    live.emplace_back();
+    fill(live.back(), from, to, ch, time, LogMessage::eDefault, len, bytes);
+    live.back().logged = logged;
+}
+
+/**
+ * Hand out the staged messages in log order followed by the queued live messages.
+ * At least one message is handed out per call, then until the budget is used up.
+ */
+bool MessageRestorer::restore(RestoreFunc func, uint32_t budgetMs)
+{
+    if (!isLoaded)
+        return false;
+
+    auto start = std::chrono::steady_clock::now();
+    auto budget = std::chrono::milliseconds(budgetMs);
+    do {
+        if (next < pending.size()) {
+            handOut(pending[next++], false, func);
+        } else if (!live.empty()) {
+            Entry entry = live.front();
+            live.pop_front();
+            handOut(entry, true, func);
+        } else {
+            break;
+        }
+    } while (std::chrono::steady_clock::now() - start < budget);
+
+    if (next >= pending.size() && live.empty()) {
+        // release the staging memory but keep the counters for reporting
+        std::vector<Entry>().swap(pending);
+        return true;
+    }
+    return false;
+}
+
+uint32_t MessageRestorer::progress(void) const
+{
+    if (!isLoaded)
+        return 0;
+    if (next >= pending.size())
+        return 100;
+    return next * 100 / pending.size();
+}
+
+uint32_t MessageRestorer::chatKey(uint32_t from, uint32_t to, uint8_t ch) const
+{
+    if (to == UINT32_MAX || from == 0)
+        return ch;
+    return from == ownNode ? to : from;
+}
+
+void MessageRestorer::stage(const LogMessageEnv &msg)
+{
+    uint32_t key = chatKey(msg.from, msg.to, msg.ch);
+    if (msg.trashFlag) {
+        // chat was cleared, drop everything logged before
+        auto it = chats.find(key);
+        if (it != chats.end()) {
+            numStaged -= it->second.size();
+            chats.erase(it);
+        }
+        return;
+    }
+
+    std::deque<Entry> &chat = chats[key];
+    if (chat.size() >= c_maxPerChat) {
+        chat.pop_front();
+        numStaged--;
+    }
+    chat.emplace_back();
+    fill(chat.back(), msg.from, msg.to, msg.ch, msg.time, msg.status, msg._size, msg.bytes);
+    chat.back().seq = seq++;
+    numStaged++;
+}
+
+/**
+ * merge the per-chat lists into one list in log order
+ */
+void MessageRestorer::finishLoading(void)
+{
+    pending.clear();
+    pending.reserve(numStaged);
+    for (auto &it : chats) {
+        for (auto &entry : it.second)
+            pending.push_back(entry);
+    }
+    chats.clear();
+    std::sort(pending.begin(), pending.end(), [](const Entry &a, const Entry &b) { return a.seq < b.seq; });
+    next = 0;
+    isLoaded = true;
+    ILOG_DEBUG("MessageRestorer: %d log entries read, %d messages staged", numRead, (uint32_t)pending.size());
+}
+
+void MessageRestorer::fill(Entry &entry, uint32_t from, uint32_t to, uint8_t ch, time_t time, LogMessage::MsgStatus status,
+                           uint32_t len, const uint8_t *bytes)
+{
+    len = std::min<uint32_t>(len, messagePayloadSize - 1);
+    entry.seq = 0;
+    entry.from = from;
+    entry.to = to;
+    entry.time = time;
+    entry.ch = ch;
+    entry.status = status;
+    entry.logged = false;
+    entry.len = len;
+    memcpy(entry.bytes, bytes, len);
+    entry.bytes[len] = 0;
+}
+
+void MessageRestorer::handOut(const Entry &entry, bool live, const RestoreFunc &func)
+{
+    LogMessageEnv msg(entry.from, entry.to, entry.ch, entry.time, entry.status, false, entry.len, entry.bytes);
+    msg.bytes[entry.len] = 0;
+    func(msg, live, entry.logged);
+}
@@ -0,0 +1,200 @@
+#include "util/NodeDB.h"
+#include <algorithm>
+#include <string.h>
+
+NodeDB::NodeDB(void) : mask(0)
+{
+    rehash(64);
+}
+
+void NodeDB::reserve(uint32_t nodes)
+{
+    _num.reserve(nodes);
+    _lastHeard.reserve(nodes);
+    _lat.reserve(nodes);
+    _lon.reserve(nodes);
+    _snr.reserve(nodes);
+    _shortName.reserve(nodes);
+    _longName.reserve(nodes);
+    _channel.reserve(nodes);
+    _role.reserve(nodes);
+    _hopsAway.reserve(nodes);
+    _battery.reserve(nodes);
+    _flags.reserve(nodes);
+    uint32_t capacity = table.size();
+    while (nodes * 4 > capacity * 3)
+        capacity *= 2;
+    if (capacity != table.size())
+        rehash(capacity);
+}
+
+uint32_t NodeDB::add(uint32_t nodeNum)
+{
+    uint32_t i = lookup(nodeNum);
+    if (table[i])
+        return table[i] - 1;
+
+    if ((size() + 1) * 4 > table.size() * 3) {
+        rehash(table.size() * 2);
+        i = lookup(nodeNum);
+    }
+
+    uint32_t slot = size();
+    table[i] = slot + 1;
+    _num.push_back(nodeNum);
+    _lastHeard.push_back(0);
+    _lat.push_back(0);
+    _lon.push_back(0);
+    _snr.push_back(0.0f);
+    _shortName.push_back(ShortName{});
+    _longName.push_back(LongName{});
+    _channel.push_back(0);
+    _role.push_back(c_unknownRole);
+    _hopsAway.push_back(-1);
+    _battery.push_back(0);
+    _flags.push_back(0);
+    return slot;
+}
+
+/**
+ * Remove the hash entry with backward shift deletion (no tombstones) and fill the
+ * gap in the columns with the last node.
+ */
+bool NodeDB::remove(uint32_t nodeNum)
+{
+    uint32_t i = lookup(nodeNum);
+    if (!table[i])
+        return false;
+    uint32_t slot = table[i] - 1;
+
+    for (uint32_t j = (i + 1) & mask; table[j]; j = (j + 1) & mask) {
+        uint32_t home = hash(_num[table[j] - 1]);
+        // entry j may move into the gap at i unless its home lies cyclically in (i, j]
+        bool stays = i < j ? (home > i && home <= j) : (home > i || home <= j);
+        if (!stays) {
+            table[i] = table[j];
+            i = j;
+        }
+    }
+    table[i] = 0;
+
+    uint32_t last = size() - 1;
+    if (slot != last) {
+        table[lookup(_num[last])] = slot + 1;
+        _num[slot] = _num[last];
+        _lastHeard[slot] = _lastHeard[last];
+        _lat[slot] = _lat[last];
+        _lon[slot] = _lon[last];
+        _snr[slot] = _snr[last];
+        _shortName[slot] = _shortName[last];
+        _longName[slot] = _longName[last];
+        _channel[slot] = _channel[last];
+        _role[slot] = _role[last];
+        _hopsAway[slot] = _hopsAway[last];
+        _battery[slot] = _battery[last];
+        _flags[slot] = _flags[last];
+    }
+    _num.pop_back();
+    _lastHeard.pop_back();
+    _lat.pop_back();
+    _lon.pop_back();
+    _snr.pop_back();
+    _shortName.pop_back();
+    _longName.pop_back();
+    _channel.pop_back();
+    _role.pop_back();
+    _hopsAway.pop_back();
+    _battery.pop_back();
+    _flags.pop_back();
+    return true;
+}
+
+void NodeDB::clear(void)
+{
+    _num.clear();
+    _lastHeard.clear();
+    _lat.clear();
+    _lon.clear();
+    _snr.clear();
+    _shortName.clear();
+    _longName.clear();
+    _channel.clear();
+    _role.clear();
+    _hopsAway.clear();
+    _battery.clear();
+    _flags.clear();
+    std::fill(table.begin(), table.end(), 0);
+}
+
+uint32_t NodeDB::find(uint32_t nodeNum) const
+{
+    uint32_t i = lookup(nodeNum);
+    return table[i] ? table[i] - 1 : c_noSlot;
+}
+
+/**
+ * Names are cut to fit; an empty short name is shown as short node id by the views,
+ * so it is kept empty here.
+ */
+void NodeDB::setNames(uint32_t slot, const char *shortName, const char *longName)
+{
+    if (shortName) {
+        strncpy(_shortName[slot].name, shortName, c_shortNameLen - 1);
+        _shortName[slot].name[c_shortNameLen - 1] = '\0';
+    }
+    if (longName) {
+        strncpy(_longName[slot].name, longName, c_longNameLen - 1);
+        _longName[slot].name[c_longNameLen - 1] = '\0';
+    }
+}
+
+void NodeDB::setPosition(uint32_t slot, int32_t lat, int32_t lon)
+{
+    _lat[slot] = lat;
+    _lon[slot] = lon;
+    _flags[slot] |= eHasPosition;
+}
+
+std::vector<uint32_t> NodeDB::sortedByLastHeard(void) const
+{
+    std::vector<uint32_t> slots(size());
+    for (uint32_t i = 0; i < slots.size(); i++)
+        slots[i] = i;
+    std::stable_sort(slots.begin(), slots.end(), [this](uint32_t a, uint32_t b) { return _lastHeard[a] > _lastHeard[b]; });
+    for (auto &slot : slots)
+        slot = _num[slot];
+    return slots;
+}
+
+uint32_t NodeDB::countOnline(time_t now, uint32_t secs) const
+{
+    uint32_t online = 0;
+    for (uint32_t lastHeard : _lastHeard) {
+        if (lastHeard > 0 && now - (time_t)lastHeard <= (time_t)secs)
+            online++;
+    }
+    return online;
+}
+
+uint32_t NodeDB::hash(uint32_t nodeNum) const
+{
+    // node numbers are often derived from MAC addresses, so mix all bits into the low ones
+    uint32_t h = nodeNum * 2654435769u;
+    return (h ^ (h >> 16)) & mask;
+}
+
+uint32_t NodeDB::lookup(uint32_t nodeNum) const
+{
+    uint32_t i = hash(nodeNum);
+    while (table[i] && _num[table[i] - 1] != nodeNum)
+        i = (i + 1) & mask;
+    return i;
+}
+
+void NodeDB::rehash(uint32_t capacity)
+{
+    table.assign(capacity, 0);
+    mask = capacity - 1;
+    for (uint32_t slot = 0; slot < _num.size(); slot++)
+        table[lookup(_num[slot])] = slot + 1;
+}
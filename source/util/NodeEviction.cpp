@@ -0,0 +1,131 @@
+#include "util/NodeEviction.h"
+#include <initializer_list>
+#include <iterator>
+
+void NodeEviction::add(uint32_t nodeNum, uint32_t lastHeard, bool unknown, bool pinned)
+{
+    auto it = entries.find(nodeNum);
+    if (it != entries.end()) {
+        update(nodeNum, Entry{lastHeard, unknown, pinned});
+    } else {
+        Entry e{lastHeard, unknown, pinned};
+        entries[nodeNum] = e;
+        insert(nodeNum, e);
+        balance();
+    }
+}
+
+void NodeEviction::remove(uint32_t nodeNum)
+{
+    auto it = entries.find(nodeNum);
+    if (it == entries.end())
+        return;
+    erase(nodeNum, it->second);
+    entries.erase(it);
+    balance();
+}
+
+void NodeEviction::clear(void)
+{
+    entries.clear();
+    unknown.clear();
+    named.clear();
+    pinned.clear();
+    recent.clear();
+    older.clear();
+}
+
+void NodeEviction::setLastHeard(uint32_t nodeNum, uint32_t lastHeard)
+{
+    auto it = entries.find(nodeNum);
+    if (it != entries.end() && it->second.lastHeard != lastHeard)
+        update(nodeNum, Entry{lastHeard, it->second.unknown, it->second.pinned});
+}
+
+void NodeEviction::setUnknown(uint32_t nodeNum, bool unknown)
+{
+    auto it = entries.find(nodeNum);
+    if (it != entries.end() && it->second.unknown != unknown)
+        update(nodeNum, Entry{it->second.lastHeard, unknown, it->second.pinned});
+}
+
+void NodeEviction::setPinned(uint32_t nodeNum, bool pinned)
+{
+    auto it = entries.find(nodeNum);
+    if (it != entries.end() && it->second.pinned != pinned)
+        update(nodeNum, Entry{it->second.lastHeard, it->second.unknown, pinned});
+}
+
+uint32_t NodeEviction::victim(time_t now, uint32_t except) const
+{
+    // all other unknown nodes are newer than the oldest one, so only the oldest needs to be checked
+    for (const Key &key : unknown) {
+        if (key.second == except)
+            continue;
+        if (now >= (time_t)key.first + c_freshSecs && recent.find(key) == recent.end())
+            return key.second;
+        break;
+    }
+    for (const Index *index : {&named, &unknown, &pinned}) {
+        for (const Key &key : *index) {
+            if (key.second != except)
+                return key.second;
+        }
+    }
+    return c_none;
+}
+
+uint32_t NodeEviction::oldest(uint32_t except) const
+{
+    for (const Index *index : {&older, &recent}) {
+        for (const Key &key : *index) {
+            if (key.second != except)
+                return key.second;
+        }
+    }
+    return c_none;
+}
+
+void NodeEviction::insert(uint32_t nodeNum, const Entry &e)
+{
+    Key key(e.lastHeard, nodeNum);
+    indexOf(e).insert(key);
+    if (!recent.empty() && *recent.begin() < key)
+        recent.insert(key);
+    else
+        older.insert(key);
+}
+
+void NodeEviction::erase(uint32_t nodeNum, const Entry &e)
+{
+    Key key(e.lastHeard, nodeNum);
+    indexOf(e).erase(key);
+    if (recent.erase(key) == 0)
+        older.erase(key);
+}
+
+void NodeEviction::update(uint32_t nodeNum, const Entry &e)
+{
+    Entry &entry = entries[nodeNum];
+    erase(nodeNum, entry);
+    entry = e;
+    insert(nodeNum, entry);
+    balance();
+}
+
+/**
+ * Move keys across the border so that recent holds exactly the newest size()/5 keys.
+ */
+void NodeEviction::balance(void)
+{
+    size_t target = entries.size() / 5;
+    while (recent.size() > target) {
+        older.insert(*recent.begin());
+        recent.erase(recent.begin());
+    }
+    while (recent.size() < target && !older.empty()) {
+        auto newest = std::prev(older.end());
+        recent.insert(*newest);
+        older.erase(newest);
+    }
+}
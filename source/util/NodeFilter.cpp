@@ -0,0 +1,267 @@
+#include "util/NodeFilter.h"
+#include <stdio.h>
+#include <string.h>
+
+namespace
+{
+// base letters of U+00C0..U+00FF and U+0100..U+017F, '.' if there is none (or a special case)
+const char c_latin1[] = "aaaaaa.ceeeeiiiidnooooo.ouuuuy.."
+                        "aaaaaa.ceeeeiiiidnooooo.ouuuuy.y";
+const char c_latinExtA[] = "aaaaaaccccccccddddeeeeeeeeeegggggggghhhhiiiiiiiiii..jjkkklllllllllln"
+                           "nnnnnnnnoooooo..rrrrrrssssssssttttttuuuuuuuuuuuuwwyyyzzzzzzs";
+
+constexpr uint32_t c_invalid = 0x80000000; // not valid UTF-8, the byte is passed as is
+
+// decode one UTF-8 sequence, returns the number of bytes consumed
+int decode(const unsigned char *s, uint32_t &cp)
+{
+    if (s[0] < 0x80) {
+        cp = s[0];
+        return 1;
+    }
+    if ((s[0] & 0xe0) == 0xc0 && (s[1] & 0xc0) == 0x80) {
+        cp = ((s[0] & 0x1f) << 6) | (s[1] & 0x3f);
+        return 2;
+    }
+    if ((s[0] & 0xf0) == 0xe0 && (s[1] & 0xc0) == 0x80 && (s[2] & 0xc0) == 0x80) {
+        cp = ((s[0] & 0x0f) << 12) | ((s[1] & 0x3f) << 6) | (s[2] & 0x3f);
+        return 3;
+    }
+    if ((s[0] & 0xf8) == 0xf0 && (s[1] & 0xc0) == 0x80 && (s[2] & 0xc0) == 0x80 && (s[3] & 0xc0) == 0x80) {
+        cp = ((s[0] & 0x07) << 18) | ((s[1] & 0x3f) << 12) | ((s[2] & 0x3f) << 6) | (s[3] & 0x3f);
+        return 4;
+    }
+    cp = c_invalid | s[0];
+    return 1;
+}
+
+void encode(uint32_t cp, std::string &out)
+{
+    if (cp < 0x80) {
+        out += char(cp);
+    } else if (cp < 0x800) {
+        out += char(0xc0 | (cp >> 6));
+        out += char(0x80 | (cp & 0x3f));
+    } else if (cp < 0x10000) {
+        out += char(0xe0 | (cp >> 12));
+        out += char(0x80 | ((cp >> 6) & 0x3f));
+        out += char(0x80 | (cp & 0x3f));
+    } else {
+        out += char(0xf0 | (cp >> 18));
+        out += char(0x80 | ((cp >> 12) & 0x3f));
+        out += char(0x80 | ((cp >> 6) & 0x3f));
+        out += char(0x80 | (cp & 0x3f));
+    }
+}
+} // namespace
+
+void NodeFilter::normalize(const char *utf8, std::string &out)
+{
+    out.clear();
+    const unsigned char *s = (const unsigned char *)utf8;
+    while (*s) {
+        uint32_t cp;
+        s += decode(s, cp);
+        if (cp & c_invalid) {
+            out += char(cp & 0xff);
+        } else if (cp >= 'A' && cp <= 'Z') {
+            out += char(cp + 0x20);
+        } else if (cp < 0x80) {
+            out += char(cp);
+        } else if (cp >= 0xc0 && cp <= 0x17f) {
+            char base = cp < 0x100 ? c_latin1[cp - 0xc0] : c_latinExtA[cp - 0x100];
+            if (base != '.')
+                out += base;
+            else if (cp == 0xc6 || cp == 0xe6)
+                out += "ae";
+            else if (cp == 0xdf)
+                out += "ss";
+            else if (cp == 0x132 || cp == 0x133)
+                out += "ij";
+            else if (cp == 0x152 || cp == 0x153)
+                out += "oe";
+            else
+                encode(cp, out); // × ÷ Þ þ
+        } else if (cp >= 0x391 && cp <= 0x3a9 && cp != 0x3a2) { // Greek capitals
+            encode(cp + 0x20, out);
+        } else if (cp >= 0x410 && cp <= 0x42f) { // Cyrillic А..Я
+            encode(cp + 0x20, out);
+        } else if (cp >= 0x400 && cp <= 0x40f) { // Cyrillic Ѐ..Џ, Ё is searched as Е
+            encode(cp == 0x401 ? 0x435 : cp + 0x50, out);
+        } else if (cp == 0x451) { // ё
+            encode(0x435, out);
+        } else if (cp >= 0x4c1 && cp <= 0x4ce) { // Cyrillic pairs with odd capitals
+            encode(cp & 1 ? cp + 1 : cp, out);
+        } else if (cp >= 0x460 && cp <= 0x4ff && (cp & 1) == 0 && (cp < 0x482 || cp > 0x489) && cp != 0x4c0) {
+            encode(cp + 1, out); // Cyrillic pairs with even capitals
+        } else {
+            encode(cp, out);
+        }
+    }
+}
+
+void NodeFilter::setKey(uint32_t nodeNum, const char *shortName, const char *longName)
+{
+    char id[12];
+    snprintf(id, sizeof(id), "!%08x", nodeNum);
+    // fields are separated by \x01 so that a query cannot match across them
+    std::string raw = std::string(shortName ? shortName : "") + '\x01' + (longName ? longName : "") + '\x01' + id;
+    std::string key;
+    normalize(raw.c_str(), key);
+    storeKey(entry(nodeNum), key);
+}
+
+void NodeFilter::set(uint32_t nodeNum, Criterion criterion, bool pass)
+{
+    uint32_t i = entry(nodeNum);
+    if (pass)
+        bits[criterion][i / 32] |= 1u << (i % 32);
+    else
+        bits[criterion][i / 32] &= ~(1u << (i % 32));
+}
+
+void NodeFilter::remove(uint32_t nodeNum)
+{
+    auto it = index.find(nodeNum);
+    if (it == index.end())
+        return;
+    uint32_t i = it->second;
+    uint32_t last = num.size() - 1;
+    garbage += strlen(&keys[keyOffset[i]]) + 1;
+    if (i != last) {
+        num[i] = num[last];
+        keyOffset[i] = keyOffset[last];
+        for (auto &b : bits) {
+            bool pass = b[last / 32] & (1u << (last % 32));
+            b[i / 32] = pass ? (b[i / 32] | (1u << (i % 32))) : (b[i / 32] & ~(1u << (i % 32)));
+        }
+        index[num[i]] = i;
+    }
+    for (auto &b : bits) {
+        b[last / 32] &= ~(1u << (last % 32));
+        b.resize(last / 32 + (last % 32 ? 1 : 0));
+    }
+    index.erase(it);
+    num.pop_back();
+    keyOffset.pop_back();
+    if (garbage > keys.size() / 2)
+        compact();
+}
+
+void NodeFilter::clear(void)
+{
+    num.clear();
+    keyOffset.clear();
+    keys.clear();
+    garbage = 0;
+    for (auto &b : bits)
+        b.clear();
+    index.clear();
+}
+
+void NodeFilter::require(Criterion criterion, bool required)
+{
+    if (required)
+        active |= 1 << criterion;
+    else
+        active &= ~(1 << criterion);
+}
+
+void NodeFilter::setQuery(const char *q)
+{
+    negate = q[0] == '!';
+    normalize(negate ? q + 1 : q, query);
+}
+
+bool NodeFilter::visible(uint32_t nodeNum) const
+{
+    auto it = index.find(nodeNum);
+    return it == index.end() || (passes(it->second) && matches(it->second));
+}
+
+/**
+ * The criteria are evaluated 32 nodes at a time, the substring search only for nodes that
+ * pass all of them.
+ */
+uint32_t NodeFilter::apply(const Visit &visit) const
+{
+    uint32_t hidden = 0;
+    uint32_t count = num.size();
+    for (uint32_t w = 0; w * 32 < count; w++) {
+        uint32_t mask = UINT32_MAX;
+        for (int c = 0; c < eNumCriteria; c++) {
+            if (active & (1 << c))
+                mask &= bits[c][w];
+        }
+        for (uint32_t i = w * 32; i < count && i < w * 32 + 32; i++) {
+            bool vis = (mask & (1u << (i % 32))) && matches(i);
+            hidden += !vis;
+            visit(num[i], vis);
+        }
+    }
+    return hidden;
+}
+
+uint32_t NodeFilter::entry(uint32_t nodeNum)
+{
+    auto it = index.find(nodeNum);
+    if (it != index.end())
+        return it->second;
+    uint32_t i = num.size();
+    index[nodeNum] = i;
+    num.push_back(nodeNum);
+    keyOffset.push_back(keys.size());
+    keys.push_back('\0');
+    if (i % 32 == 0) {
+        for (auto &b : bits)
+            b.push_back(0);
+    }
+    return i;
+}
+
+bool NodeFilter::passes(uint32_t i) const
+{
+    for (int c = 0; c < eNumCriteria; c++) {
+        if ((active & (1 << c)) && !(bits[c][i / 32] & (1u << (i % 32))))
+            return false;
+    }
+    return true;
+}
+
+bool NodeFilter::matches(uint32_t i) const
+{
+    if (query.empty())
+        return true;
+    bool found = strstr(&keys[keyOffset[i]], query.c_str()) != nullptr;
+    return found != negate;
+}
+
+void NodeFilter::storeKey(uint32_t i, const std::string &key)
+{
+    char *old = &keys[keyOffset[i]];
+    size_t oldLen = strlen(old);
+    if (key.size() <= oldLen) {
+        // fits into the old place
+        memcpy(old, key.c_str(), key.size() + 1);
+        garbage += oldLen - key.size();
+        return;
+    }
+    garbage += oldLen + 1;
+    keyOffset[i] = keys.size();
+    keys.insert(keys.end(), key.c_str(), key.c_str() + key.size() + 1);
+    if (garbage > keys.size() / 2)
+        compact();
+}
+
+void NodeFilter::compact(void)
+{
+    std::vector<char> packed;
+    packed.reserve(keys.size() - garbage);
+    for (uint32_t i = 0; i < num.size(); i++) {
+        const char *key = &keys[keyOffset[i]];
+        keyOffset[i] = packed.size();
+        packed.insert(packed.end(), key, key + strlen(key) + 1);
+    }
+    keys.swap(packed);
+    garbage = 0;
+}
@@ -0,0 +1,173 @@
+#include "util/NodeList.h"
+#include <algorithm>
+#include <string.h>
+
+/**
+ * The pinned node becomes the first row as soon as it is listed.
+ */
+void NodeList::setPinned(uint32_t nodeNum)
+{
+    pinnedNode = nodeNum;
+    auto it = std::find(order.begin(), order.end(), nodeNum);
+    if (it != order.end() && it != order.begin()) {
+        std::rotate(order.begin(), it, it + 1);
+        rowsChanged = true;
+    }
+}
+
+bool NodeList::add(uint32_t nodeNum, uint32_t lastHeard)
+{
+    if (contains(nodeNum))
+        return false;
+    nodes[nodeNum] = Node{lastHeard, true};
+
+    uint32_t top = (!order.empty() && order[0] == pinnedNode) ? 1 : 0;
+    uint32_t i = order.size();
+    if (nodeNum == pinnedNode) {
+        i = 0;
+    } else {
+        // nodes are mostly added in the order they were heard, so search from the end
+        while (i > top && lastHeard > nodes[order[i - 1]].lastHeard)
+            i--;
+    }
+    order.insert(order.begin() + i, nodeNum);
+    rowsChanged = true;
+    return true;
+}
+
+bool NodeList::remove(uint32_t nodeNum)
+{
+    auto node = nodes.find(nodeNum);
+    if (node == nodes.end())
+        return false;
+    if (!node->second.visible)
+        numHidden--;
+    nodes.erase(node);
+    texts.erase(nodeNum);
+    order.erase(std::find(order.begin(), order.end(), nodeNum));
+    rowsChanged = true;
+    return true;
+}
+
+void NodeList::clear(void)
+{
+    order.clear();
+    nodes.clear();
+    texts.clear();
+    visibleRows.clear();
+    numHidden = 0;
+    rowsChanged = false;
+}
+
+void NodeList::moveToTop(uint32_t nodeNum, uint32_t lastHeard)
+{
+    auto node = nodes.find(nodeNum);
+    if (node == nodes.end())
+        return;
+    node->second.lastHeard = lastHeard;
+    if (nodeNum == pinnedNode)
+        return;
+
+    auto top = order.begin() + ((order[0] == pinnedNode) ? 1 : 0);
+    auto it = std::find(top, order.end(), nodeNum);
+    if (it != top) {
+        std::rotate(top, it, it + 1);
+        if (node->second.visible)
+            rowsChanged = true;
+    }
+}
+
+bool NodeList::setVisible(uint32_t nodeNum, bool visible)
+{
+    auto node = nodes.find(nodeNum);
+    if (node == nodes.end() || node->second.visible == visible)
+        return false;
+    node->second.visible = visible;
+    numHidden += visible ? -1 : 1;
+    rowsChanged = true;
+    return true;
+}
+
+bool NodeList::visible(uint32_t nodeNum) const
+{
+    auto node = nodes.find(nodeNum);
+    return node != nodes.end() && node->second.visible;
+}
+
+uint32_t NodeList::rows(void)
+{
+    updateRows();
+    return visibleRows.size();
+}
+
+uint32_t NodeList::nodeAt(uint32_t row)
+{
+    updateRows();
+    return row < visibleRows.size() ? visibleRows[row] : c_none;
+}
+
+uint32_t NodeList::rowOf(uint32_t nodeNum)
+{
+    updateRows();
+    auto it = std::find(visibleRows.begin(), visibleRows.end(), nodeNum);
+    return it != visibleRows.end() ? it - visibleRows.begin() : c_none;
+}
+
+void NodeList::updateRows(void)
+{
+    if (!rowsChanged)
+        return;
+    visibleRows.clear();
+    visibleRows.reserve(order.size() - numHidden);
+    for (uint32_t nodeNum : order) {
+        if (nodes[nodeNum].visible || nodeNum == pinnedNode)
+            visibleRows.push_back(nodeNum);
+    }
+    rowsChanged = false;
+}
+
+/**
+ * Texts longer than c_textLen - 1 bytes are cut at a UTF-8 character boundary.
+ */
+bool NodeList::setText(uint32_t nodeNum, Text text, const char *value)
+{
+    if (!contains(nodeNum))
+        return false;
+    auto it = texts.find(nodeNum);
+    if (it == texts.end()) {
+        if (value[0] == '\0')
+            return false;
+        it = texts.emplace(nodeNum, Texts{}).first;
+    }
+
+    char *dest = it->second.text[text];
+    size_t len = strlen(value);
+    if (len >= c_textLen) {
+        len = c_textLen - 1;
+        while (len > 0 && (value[len] & 0xc0) == 0x80)
+            len--;
+    }
+    if (strncmp(dest, value, len) == 0 && dest[len] == '\0')
+        return false;
+    memcpy(dest, value, len);
+    dest[len] = '\0';
+    return true;
+}
+
+const char *NodeList::text(uint32_t nodeNum, Text text) const
+{
+    auto it = texts.find(nodeNum);
+    return it != texts.end() ? it->second.text[text] : "";
+}
+
+void NodeList::setIaq(uint32_t nodeNum, uint16_t iaq)
+{
+    if (contains(nodeNum))
+        texts[nodeNum].iaq = iaq;
+}
+
+uint16_t NodeList::iaq(uint32_t nodeNum) const
+{
+    auto it = texts.find(nodeNum);
+    return it != texts.end() ? it->second.iaq : 0;
+}
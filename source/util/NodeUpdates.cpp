@@ -0,0 +1,89 @@
+#include "util/NodeUpdates.h"
+
+void NodeUpdates::setMetrics(uint32_t nodeNum, const Metrics &metrics)
+{
+    entry(nodeNum, eMetrics).metrics = metrics;
+}
+
+void NodeUpdates::setEnvironment(uint32_t nodeNum, const Environment &environment)
+{
+    entry(nodeNum, eEnvironment).environment = environment;
+}
+
+void NodeUpdates::setSignal(uint32_t nodeNum, int32_t rssi, float snr)
+{
+    Update &u = entry(nodeNum, eSignal);
+    u.dirty &= ~eHopsAway;
+    u.rssi = rssi;
+    u.snr = snr;
+}
+
+void NodeUpdates::setHopsAway(uint32_t nodeNum, uint8_t hopsAway)
+{
+    Update &u = entry(nodeNum, eHopsAway);
+    u.dirty &= ~eSignal;
+    u.hopsAway = hopsAway;
+}
+
+void NodeUpdates::setLastHeard(uint32_t nodeNum, bool cameOnline)
+{
+    Update &u = entry(nodeNum, eLastHeard);
+    u.cameOnline |= cameOnline;
+}
+
+/**
+ * The entry stays in place with no dirty fields so that the order of the others is kept.
+ */
+void NodeUpdates::remove(uint32_t nodeNum)
+{
+    auto it = index.find(nodeNum);
+    if (it == index.end())
+        return;
+    updates[it->second].dirty = 0;
+    index.erase(it);
+}
+
+void NodeUpdates::clear(void)
+{
+    updates.clear();
+    index.clear();
+}
+
+uint32_t NodeUpdates::flush(const Flush &flush)
+{
+    if (index.empty()) {
+        updates.clear();
+        return 0;
+    }
+    // callbacks may record new values, these go into the emptied (but allocated) vector
+    flushing.swap(updates);
+    updates.clear();
+    index.clear();
+    uint32_t count = 0;
+    for (const Update &u : flushing) {
+        if (u.dirty) {
+            flush(u);
+            count++;
+        }
+    }
+    flushing.clear();
+    return count;
+}
+
+NodeUpdates::Update &NodeUpdates::entry(uint32_t nodeNum, Field field)
+{
+    auto it = index.find(nodeNum);
+    if (it != index.end()) {
+        Update &u = updates[it->second];
+        if (u.dirty & (field == eSignal || field == eHopsAway ? eSignal | eHopsAway : field))
+            merged++;
+        u.dirty |= field;
+        return u;
+    }
+    index[nodeNum] = updates.size();
+    updates.push_back(Update{});
+    Update &u = updates.back();
+    u.nodeNum = nodeNum;
+    u.dirty = field;
+    return u;
+}
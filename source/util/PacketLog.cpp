@@ -0,0 +1,167 @@
+#include "util/PacketLog.h"
+#include <stdarg.h>
+#include <stdio.h>
+
+namespace
+{
+// printf to buf at pos, pos stops at the end of the buffer
+void append(char *buf, size_t len, size_t &pos, const char *fmt, ...)
+{
+    if (pos + 1 >= len)
+        return;
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(&buf[pos], len - pos, fmt, args);
+    va_end(args);
+    if (n > 0)
+        pos = pos + n < len ? pos + n : len - 1;
+}
+} // namespace
+
+PacketLog::PacketLog(uint32_t capacity, uint8_t routes) : cap(capacity), routes(routes) {}
+
+void PacketLog::push(const Entry &entry)
+{
+    if (ring.size() < cap) {
+        ring.push_back(entry);
+    } else {
+        ring[head] = entry;
+        head = (head + 1) % cap;
+    }
+    pushed++;
+}
+
+void PacketLog::setRoute(const uint32_t *hops, uint8_t count)
+{
+    if (ring.empty() || routes.empty())
+        return;
+    Route &r = routes[nextRoute];
+    r.seq = pushed - 1;
+    r.count = count < c_maxHops ? count : c_maxHops;
+    r.unknown = 0;
+    for (int i = 0; i < r.count; i++) {
+        r.hop[i] = hops[i] & 0xffff;
+        if (hops[i] == UINT32_MAX)
+            r.unknown |= 1 << i;
+    }
+    Entry &last = ring[(head + ring.size() - 1) % ring.size()];
+    last.route = nextRoute;
+    nextRoute = (nextRoute + 1) % routes.size();
+}
+
+void PacketLog::clear(void)
+{
+    ring.clear();
+    head = 0;
+    pushed = 0;
+    nextRoute = 0;
+}
+
+/**
+ * Same layout as the former label text, the route is appended to the line.
+ */
+void PacketLog::format(uint32_t i, const char *time, const char *fromName, uint32_t ownNode, char *buf, size_t len) const
+{
+    static const char *const detail[] = {"", " dev", " env", " air", " pow"};
+    if (len == 0)
+        return;
+    const Entry &e = (*this)[i];
+    size_t pos = 0;
+    buf[0] = '\0';
+    if (e.to == UINT32_MAX)
+        append(buf, len, pos, "%s: ch%d %s:%04x->all: %s", time, e.channel, fromName, e.from & 0xffff, portName(e.port));
+    else
+        append(buf, len, pos, "%s: ch%d %s:%04x->%s%04x: %s", time, e.channel, fromName, e.from & 0xffff,
+               e.to == ownNode ? "*" : "", e.to & 0xffff, portName(e.port));
+    if (e.detail < sizeof(detail) / sizeof(detail[0]))
+        append(buf, len, pos, "%s", detail[e.detail]);
+
+    // the variable part (path and signal) goes to a second line
+    const char *sep = "\n";
+    // the path is only valid if it has not been reused by a later traceroute
+    uint32_t seq = pushed - ring.size() + i;
+    if (e.route < routes.size() && routes[e.route].seq == seq) {
+        const Route &r = routes[e.route];
+        append(buf, len, pos, "%s", sep);
+        sep = " ";
+        if (e.to == ownNode)
+            append(buf, len, pos, "%04x", ownNode & 0xffff);
+        for (int h = 0; h < r.count; h++) {
+            if (r.unknown & (1 << h))
+                append(buf, len, pos, "->unk");
+            else
+                append(buf, len, pos, "->%04x", r.hop[h]);
+        }
+        if (e.to == ownNode)
+            append(buf, len, pos, "->%04x", e.from & 0xffff);
+    }
+
+    if (e.rssi != 0) {
+        append(buf, len, pos, "%s(%ddBm %.1fdB", sep, e.rssi, e.snr / 4.0f);
+        if (e.hops != c_unknownHops)
+            append(buf, len, pos, " %dh", e.hops);
+        append(buf, len, pos, ")");
+    }
+}
+
+const char *PacketLog::portName(uint16_t port)
+{
+    switch (port) {
+    case 0:
+        return "unknown";
+    case 1:
+        return "text message";
+    case 2:
+        return "remote hardware";
+    case 3:
+        return "position";
+    case 4:
+        return "node info";
+    case 5:
+        return "routing";
+    case 6:
+        return "admin";
+    case 7:
+        return "text message";
+    case 8:
+        return "waypoint";
+    case 9:
+        return "audio";
+    case 10:
+        return "sensor";
+    case 32:
+        return "reply";
+    case 33:
+        return "ip tunnel";
+    case 34:
+        return "paxcounter";
+    case 64:
+        return "serial";
+    case 65:
+        return "store forward";
+    case 66:
+        return "range test";
+    case 67:
+        return "telemetry";
+    case 68:
+        return "ZPS";
+    case 69:
+        return "simulator";
+    case 70:
+        return "tracert";
+    case 71:
+        return "neighbor info";
+    case 72:
+        return "atax";
+    case 73:
+        return "map report";
+    case 74:
+        return "power stress";
+    case 256:
+        return "private";
+    case 257:
+        return "atax forwarder";
+    default:
+        return "port?";
+    }
+}
@@ -0,0 +1,142 @@
+#include "util/PacketStats.h"
+#include <algorithm>
+
+PacketStats::PacketStats(uint32_t topSize) : topSize(topSize) {}
+
+/**
+ * The heap is rebuilt from all nodes.
+ */
+void PacketStats::setTopSize(uint32_t size)
+{
+    topSize = size;
+    heap.clear();
+    std::fill(heapPos.begin(), heapPos.end(), c_none);
+    for (uint32_t i = 0; i < nodes.size(); i++)
+        rank(i);
+}
+
+void PacketStats::count(uint32_t nodeNum, Counter counter)
+{
+    uint32_t pos = lookup(nodeNum);
+    uint32_t i;
+    if (table.empty() || table[pos] == 0) {
+        if ((nodes.size() + 1) * 4 > table.size() * 3) {
+            grow();
+            pos = lookup(nodeNum);
+        }
+        i = nodes.size();
+        nodes.push_back(Node{nodeNum, {}, 0, 0});
+        heapPos.push_back(c_none);
+        table[pos] = i + 1;
+    } else {
+        i = table[pos] - 1;
+    }
+
+    Node &node = nodes[i];
+    if (node.count[counter] < UINT16_MAX)
+        node.count[counter]++;
+    node.sum++;
+    node.seq = ++packets;
+    rank(i);
+}
+
+void PacketStats::clear(void)
+{
+    nodes.clear();
+    table.clear();
+    heap.clear();
+    heapPos.clear();
+    packets = 0;
+}
+
+const PacketStats::Node *PacketStats::find(uint32_t nodeNum) const
+{
+    if (table.empty())
+        return nullptr;
+    uint32_t i = table[lookup(nodeNum)];
+    return i ? &nodes[i - 1] : nullptr;
+}
+
+uint32_t PacketStats::top(const Node **out, uint32_t max) const
+{
+    std::vector<const Node *> all;
+    all.reserve(heap.size());
+    for (uint32_t i : heap)
+        all.push_back(&nodes[i]);
+    uint32_t n = std::min<uint32_t>(all.size(), max);
+    std::partial_sort(all.begin(), all.begin() + n, all.end(), [](const Node *a, const Node *b) { return before(*a, *b); });
+    std::copy(all.begin(), all.begin() + n, out);
+    return n;
+}
+
+uint32_t PacketStats::lookup(uint32_t nodeNum) const
+{
+    if (table.empty())
+        return 0;
+    uint32_t mask = table.size() - 1;
+    uint32_t pos = (nodeNum * 2654435761u) & mask;
+    while (table[pos] != 0 && nodes[table[pos] - 1].num != nodeNum)
+        pos = (pos + 1) & mask;
+    return pos;
+}
+
+void PacketStats::grow(void)
+{
+    table.assign(table.empty() ? 64 : table.size() * 2, 0);
+    for (uint32_t i = 0; i < nodes.size(); i++)
+        table[lookup(nodes[i].num)] = i + 1;
+}
+
+/**
+ * A node's rank only ever improves: a top node moves down the min-heap, any other node
+ * replaces the worst top node if it is better now.
+ */
+void PacketStats::rank(uint32_t i)
+{
+    if (topSize == 0)
+        return;
+    if (heapPos[i] != c_none) {
+        siftDown(heapPos[i]);
+    } else if (heap.size() < topSize) {
+        // append and sift up
+        uint32_t pos = heap.size();
+        heap.push_back(i);
+        while (pos > 0) {
+            uint32_t parent = (pos - 1) / 2;
+            if (!before(nodes[heap[parent]], nodes[i]))
+                break;
+            place(pos, heap[parent]);
+            pos = parent;
+        }
+        place(pos, i);
+    } else if (before(nodes[i], nodes[heap[0]])) {
+        heapPos[heap[0]] = c_none;
+        place(0, i);
+        siftDown(0);
+    }
+}
+
+void PacketStats::siftDown(uint32_t pos)
+{
+    uint32_t i = heap[pos];
+    uint32_t count = heap.size();
+    while (true) {
+        uint32_t child = 2 * pos + 1;
+        if (child >= count)
+            break;
+        // the worse of both children
+        if (child + 1 < count && before(nodes[heap[child]], nodes[heap[child + 1]]))
+            child++;
+        if (!before(nodes[i], nodes[heap[child]]))
+            break;
+        place(pos, heap[child]);
+        pos = child;
+    }
+    place(pos, i);
+}
+
+void PacketStats::place(uint32_t pos, uint32_t i)
+{
+    heap[pos] = i;
+    heapPos[i] = pos;
+}
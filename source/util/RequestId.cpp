@@ -0,0 +1,24 @@
+#include "util/RequestId.h"
+
+uint32_t RequestId::next(void)
+{
+    uint32_t id;
+    do {
+        id = mix(salt + counter++);
+    } while (id == 0);
+    return id;
+}
+
+/**
+ * Each step (xor-shift, multiplication by an odd constant) is invertible, hence the whole
+ * function is a permutation of the 32-bit integers.
+ */
+uint32_t RequestId::mix(uint32_t x)
+{
+    x ^= x >> 16;
+    x *= 0x7feb352d;
+    x ^= x >> 15;
+    x *= 0x846ca68b;
+    x ^= x >> 16;
+    return x;
+}
@@ -0,0 +1,94 @@
+#include "util/RowWindow.h"
+#include <algorithm>
+
+RowWindow::RowWindow(uint32_t rowHeight, uint32_t viewHeight, uint32_t overscan)
+    : height(std::max<uint32_t>(rowHeight, 1)), viewHeight(viewHeight), overscan(overscan), rows(0), scrollY(0), begin(0), end(0),
+      expandedRow(c_none), extra(0)
+{
+    // a partially visible row at the top and bottom, plus overscan on both sides
+    pool = (viewHeight + height - 1) / height + 1 + 2 * overscan;
+    bound.assign(pool, c_dirty);
+}
+
+void RowWindow::setCount(uint32_t count)
+{
+    rows = count;
+    scrollTo(scrollY);
+}
+
+uint32_t RowWindow::indexAt(int32_t y) const
+{
+    if (y <= 0 || rows == 0)
+        return 0;
+    if (expandedRow < rows && y >= rowY(expandedRow)) {
+        if (y < rowY(expandedRow) + (int32_t)(height + extra))
+            return expandedRow;
+        y -= extra;
+    }
+    return std::min<uint32_t>(y / height, rows - 1);
+}
+
+/**
+ * An expanded row only covers more of the view, so the pool size still suffices.
+ */
+void RowWindow::setExpanded(uint32_t index, uint32_t extraHeight)
+{
+    expandedRow = index;
+    extra = index == c_none ? 0 : extraHeight;
+    scrollTo(scrollY);
+}
+
+void RowWindow::scrollTo(int32_t y)
+{
+    int32_t maxScroll = std::max<int32_t>(contentHeight() - (int32_t)viewHeight, 0);
+    scrollY = std::min(std::max<int32_t>(y, 0), maxScroll);
+    updateRange();
+}
+
+/**
+ * The window starts overscan rows above the first visible row and is shifted down at the
+ * end of the list so that the pool is fully used.
+ */
+void RowWindow::updateRange(void)
+{
+    uint32_t top = indexAt(scrollY);
+    begin = top > overscan ? top - overscan : 0;
+    end = std::min(begin + pool, rows);
+    begin = end > pool ? end - pool : 0;
+}
+
+uint32_t RowWindow::poolRowOf(uint32_t index) const
+{
+    if (index < begin || index >= end)
+        return c_none;
+    return index % pool;
+}
+
+void RowWindow::invalidate(void)
+{
+    std::fill(bound.begin(), bound.end(), c_dirty);
+}
+
+void RowWindow::invalidate(uint32_t index)
+{
+    uint32_t poolRow = poolRowOf(index);
+    if (poolRow != c_none)
+        bound[poolRow] = c_dirty;
+}
+
+uint32_t RowWindow::update(const Bind &bind)
+{
+    uint32_t rebinds = 0;
+    for (uint32_t poolRow = 0; poolRow < pool; poolRow++) {
+        // the list row of this pool row within [begin, end)
+        uint32_t index = begin + (poolRow + pool - begin % pool) % pool;
+        if (index >= end)
+            index = c_none;
+        if (bound[poolRow] != index) {
+            bound[poolRow] = index;
+            bind(poolRow, index);
+            rebinds++;
+        }
+    }
+    return rebinds;
+}
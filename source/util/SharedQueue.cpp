@@ -1,12 +1,25 @@
 #include "util/SharedQueue.h"
+#include "graphics/common/FrameStats.h"
+#if defined(ARCH_PORTDUINO)
+#include "util/Wakeup.h"
+#endif
 
 SharedQueue::SharedQueue() {}
 
 SharedQueue::~SharedQueue() {}
 
+/**
+ * The packet is stamped with the time it was queued so that the UI can measure the latency
+ * from here to the screen (FrameStats), including the time it waited in the queue.
+ * Linux: the UI thread sleeps between frames, wake it up to process the packet
+ */
 bool SharedQueue::serverSend(Packet &&p)
 {
+    p.setEnqueued(FrameStats::now());
     serverQueue.push(std::move(p));
+#if defined(ARCH_PORTDUINO)
+    Wakeup::instance().notify();
+#endif
     return true;
 }
 
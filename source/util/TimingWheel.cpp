@@ -0,0 +1,157 @@
+#include "util/TimingWheel.h"
+#include <algorithm>
+
+namespace
+{
+uint32_t roundUpPow2(uint32_t v)
+{
+    uint32_t p = 1;
+    while (p < v)
+        p <<= 1;
+    return p;
+}
+} // namespace
+
+TimingWheel::TimingWheel(uint32_t tickMs, uint32_t slots, uint32_t now)
+    : tickMs(tickMs ? tickMs : 1), mask(roundUpPow2(slots ? slots : 1) - 1), lastMs(now), head(mask + 1, c_nil),
+      tail(mask + 1, c_nil)
+{
+}
+
+/**
+ * The deadline is rounded up to the next tick so that a timer never fires early; a delay of 0
+ * fires on the next tick.
+ */
+TimingWheel::Handle TimingWheel::schedule(uint32_t key, uint32_t now, uint32_t delay)
+{
+    int32_t sinceTick = int32_t(now - lastMs);
+    uint64_t ms = uint64_t(sinceTick > 0 ? sinceTick : 0) + delay;
+    uint32_t ticks = uint32_t((ms + tickMs - 1) / tickMs);
+
+    uint32_t i;
+    if (freeList != c_nil) {
+        i = freeList;
+        freeList = timers[i].next;
+    } else {
+        i = timers.size();
+        timers.push_back(Timer{});
+    }
+    Timer &t = timers[i];
+    t.key = key;
+    t.deadline = tick + std::max(ticks, 1u);
+    t.seq = seq++;
+    t.used = true;
+    link(i);
+    count++;
+    return (Handle(t.gen) << 32) | (i + 1);
+}
+
+bool TimingWheel::cancel(Handle handle)
+{
+    if (!pending(handle))
+        return false;
+    uint32_t i = uint32_t(handle) - 1;
+    unlink(i);
+    release(i);
+    return true;
+}
+
+bool TimingWheel::pending(Handle handle) const
+{
+    uint32_t i = uint32_t(handle) - 1;
+    return handle && i < timers.size() && timers[i].used && timers[i].gen == uint32_t(handle >> 32);
+}
+
+void TimingWheel::clear(void)
+{
+    for (uint32_t i = 0; i < timers.size(); i++) {
+        if (timers[i].used)
+            release(i);
+    }
+    std::fill(head.begin(), head.end(), c_nil);
+    std::fill(tail.begin(), tail.end(), c_nil);
+}
+
+/**
+ * Visits the slots of all ticks passed (at most one revolution) and collects the due timers
+ * first; they are released before any expire() call so that the callback can safely schedule
+ * new timers or cancel (stale) handles.
+ * Slot lists are in scheduling order, so as long as less than one revolution passed, the due
+ * timers are collected in order already; only longer gaps need sorting.
+ */
+uint32_t TimingWheel::advance(uint32_t now, const Expire &expire)
+{
+    uint32_t ticks = (now - lastMs) / tickMs;
+    if (int32_t(now - lastMs) < 0 || ticks == 0)
+        return 0;
+    lastMs += ticks * tickMs;
+    uint32_t from = tick;
+    tick += ticks;
+    if (count == 0)
+        return 0;
+
+    struct Due {
+        uint32_t deadline; // ticks after from
+        uint32_t seq;
+        uint32_t key;
+    };
+    std::vector<Due> due;
+    uint32_t visit = std::min(ticks, mask + 1);
+    for (uint32_t k = 1; k <= visit; k++) {
+        uint32_t i = head[(from + k) & mask];
+        while (i != c_nil) {
+            uint32_t next = timers[i].next;
+            if (int32_t(timers[i].deadline - tick) <= 0) {
+                due.push_back(Due{timers[i].deadline - from, timers[i].seq, timers[i].key});
+                unlink(i);
+                release(i);
+            }
+            i = next;
+        }
+    }
+
+    if (ticks > mask + 1) {
+        std::sort(due.begin(), due.end(), [](const Due &a, const Due &b) {
+            return a.deadline != b.deadline ? a.deadline < b.deadline : int32_t(a.seq - b.seq) < 0;
+        });
+    }
+    for (const Due &d : due)
+        expire(d.key);
+    return due.size();
+}
+
+void TimingWheel::link(uint32_t i)
+{
+    uint32_t s = timers[i].deadline & mask;
+    timers[i].prev = tail[s];
+    timers[i].next = c_nil;
+    if (tail[s] != c_nil)
+        timers[tail[s]].next = i;
+    else
+        head[s] = i;
+    tail[s] = i;
+}
+
+void TimingWheel::unlink(uint32_t i)
+{
+    Timer &t = timers[i];
+    uint32_t s = t.deadline & mask;
+    if (t.prev != c_nil)
+        timers[t.prev].next = t.next;
+    else
+        head[s] = t.next;
+    if (t.next != c_nil)
+        timers[t.next].prev = t.prev;
+    else
+        tail[s] = t.prev;
+}
+
+void TimingWheel::release(uint32_t i)
+{
+    Timer &t = timers[i];
+    t.used = false;
+    t.gen++;
+    t.next = freeList;
+    freeList = i;
+    count--;
+}
@@ -0,0 +1,87 @@
+#if defined(ARCH_PORTDUINO)
+
+#include "util/Wakeup.h"
+#include "util/ILog.h"
+#include <algorithm>
+#include <errno.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+Wakeup::Wakeup(void) : eventFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+{
+    if (eventFd < 0)
+        ILOG_ERROR("Wakeup: eventfd failed (%d)", errno);
+}
+
+Wakeup::~Wakeup(void)
+{
+    if (eventFd >= 0)
+        close(eventFd);
+}
+
+Wakeup &Wakeup::instance(void)
+{
+    static Wakeup wakeup;
+    return wakeup;
+}
+
+void Wakeup::notify(void)
+{
+    uint64_t one = 1;
+    if (write(eventFd, &one, sizeof(one)) < 0 && errno != EAGAIN)
+        ILOG_ERROR("Wakeup: notify failed (%d)", errno);
+}
+
+void Wakeup::watch(int fd)
+{
+    if (fd >= 0 && std::find(watched.begin(), watched.end(), fd) == watched.end())
+        watched.push_back(fd);
+}
+
+void Wakeup::unwatch(int fd)
+{
+    watched.erase(std::remove(watched.begin(), watched.end(), fd), watched.end());
+}
+
+/**
+ * A timeout of 0 only collects pending notifications. Without an eventfd this is a plain sleep.
+ * Only the first c_maxFds - 1 watched descriptors are polled.
+ */
+Wakeup::Cause Wakeup::wait(uint32_t ms)
+{
+    constexpr size_t c_maxFds = 8;
+    struct pollfd fds[c_maxFds];
+    nfds_t count = 0;
+    fds[count++] = {eventFd, POLLIN, 0};
+    for (size_t i = 0; i < watched.size() && count < c_maxFds; i++)
+        fds[count++] = {watched[i], POLLIN, 0};
+
+    int timeout = ms > INT32_MAX ? -1 : int(ms);
+    int ready = poll(fds, count, timeout);
+    if (ready <= 0)
+        return eTimeout;
+
+    Cause cause = eTimeout;
+    if (fds[0].revents & POLLIN) {
+        uint64_t value;
+        (void)read(eventFd, &value, sizeof(value));
+        cause = eNotified;
+    }
+    for (nfds_t i = 1; i < count; i++) {
+        if (fds[i].revents & POLLIN) {
+            char buf[256];
+            while (read(fds[i].fd, buf, sizeof(buf)) > 0)
+                ;
+            cause = eReadable;
+        }
+        if (fds[i].revents & (POLLERR | POLLHUP | POLLNVAL)) {
+            // e.g. the input device was unplugged, stop polling it
+            ILOG_WARN("Wakeup: fd %d closed", fds[i].fd);
+            unwatch(fds[i].fd);
+        }
+    }
+    return cause;
+}
+
+#endif
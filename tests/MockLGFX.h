@@ -0,0 +1,77 @@
+#pragma once
+
+#include <chrono>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+/**
+ * Stand-in for an LGFX device on Linux with the methods LGFXFlush uses. A push takes as long as
+ * the transfer over a bus with the given pixel rate (40MHz SPI at 16 bit per pixel by default):
+ * pushImage() returns when it is done, pushImageDMA() returns right away and the transfer runs
+ * until waitDMA() or the next push waits for it.
+ */
+class MockLGFX
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    MockLGFX(uint16_t width, uint16_t height, double pixelsPerUs = 2.5)
+        : width(width), height(height), pixelsPerUs(pixelsPerUs), framebuffer(width * height)
+    {
+    }
+
+    void startWrite(void) { transactions++; }
+    void endWrite(void)
+    {
+        waitDMA();
+        if (transactions > 0)
+            transactions--;
+    }
+    uint32_t getStartCount(void) const { return transactions; }
+
+    void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t *data)
+    {
+        transfer(x, y, w, h, data);
+        waitDMA();
+    }
+    void pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t *data)
+    {
+        if (transactions == 0)
+            unselected++;
+        transfer(x, y, w, h, data);
+        dmaTransfers++;
+    }
+    bool dmaBusy(void) const { return Clock::now() < done; }
+    void waitDMA(void)
+    {
+        while (dmaBusy())
+            ;
+    }
+
+    uint16_t pixel(int32_t x, int32_t y) const { return framebuffer[y * width + x]; }
+
+    const uint16_t width;
+    const uint16_t height;
+    const double pixelsPerUs;
+    uint32_t transfers = 0;
+    uint32_t dmaTransfers = 0;
+    uint32_t unselected = 0; // DMA transfers started outside a write transaction
+    uint64_t pixels = 0;
+
+  private:
+    void transfer(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t *data)
+    {
+        waitDMA();
+        for (int32_t row = 0; row < h; row++)
+            memcpy(&framebuffer[(y + row) * width + x], &data[row * w], w * sizeof(uint16_t));
+        std::chrono::duration<double, std::micro> duration(w * h / pixelsPerUs);
+        done = Clock::now() + std::chrono::duration_cast<Clock::duration>(duration);
+        pixels += w * h;
+        transfers++;
+    }
+
+    std::vector<uint16_t> framebuffer;
+    Clock::time_point done;
+    uint32_t transactions = 0;
+};
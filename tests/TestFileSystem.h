@@ -0,0 +1,62 @@
+#pragma once
+
+#include "PortduinoFS.h"
+#include <stdlib.h>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+/**
+ * Portduino file system mounted into a scratch directory (normally done by portduino's main)
+ */
+inline fs::FS &testFileSystem(void)
+{
+    static bool mounted = false;
+    if (!mounted) {
+        const char *tmp = getenv("TMPDIR");
+        static std::string root = std::string(tmp ? tmp : "/tmp") + "/device-ui-tests";
+        mkdir(root.c_str(), 0755);
+        portduinoVFS->mountpoint(root.c_str());
+        mounted = true;
+    }
+    return PortduinoFS;
+}
+
+inline std::vector<uint8_t> readFile(fs::FS &fs, const char *name)
+{
+    std::vector<uint8_t> data;
+    File file = fs.open(name, FILE_READ);
+    if (file) {
+        data.resize(file.size());
+        data.resize(file.read(data.data(), data.size()));
+        file.close();
+    }
+    return data;
+}
+
+inline void writeFile(fs::FS &fs, const char *name, const uint8_t *data, size_t len)
+{
+    File file = fs.open(name, FILE_WRITE);
+    file.write(data, len);
+    file.close();
+}
+
+// remove all files of a directory (non-recursive) and the directory itself
+inline void removeDir(fs::FS &fs, const char *dir)
+{
+    std::vector<std::string> names;
+    File root = fs.open(dir);
+    if (root) {
+        File file = root.openNextFile();
+        while (file) {
+            std::string name = file.name();
+            names.push_back(name[0] == '/' ? name : std::string(dir) + "/" + name);
+            file.close();
+            file = root.openNextFile();
+        }
+        root.close();
+    }
+    for (auto &name : names)
+        fs.remove(name.c_str());
+    fs.rmdir(dir);
+}
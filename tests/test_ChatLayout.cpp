@@ -0,0 +1,82 @@
+#include "util/ChatLayout.h"
+#include <doctest/doctest.h>
+#include <string.h>
+
+namespace
+{
+// 8 px per character, wrapped at 10 characters per line of 16 px, 4 px padding
+ChatLayout::Size measureText(const char *text, bool sent)
+{
+    uint32_t len = strlen(text);
+    uint32_t lines = len / 10 + 1;
+    uint32_t chars = len < 10 ? len : 10;
+    return ChatLayout::Size{uint16_t(chars * 8 + (sent ? 8 : 4)), uint16_t(lines * 16 + 4)};
+}
+} // namespace
+
+TEST_CASE("ChatLayout: positions")
+{
+    uint32_t measured = 0;
+    ChatLayout chat(
+        [&measured](const char *text, bool sent) {
+            measured++;
+            return measureText(text, sent);
+        },
+        6);
+    CHECK(chat.contentHeight() == 0);
+    CHECK(chat.indexAt(0) == ChatLayout::c_none);
+
+    chat.add("hello", false, 0x100, 0, 0);                 // 20 high
+    chat.add("a message of 25 characters", true, 0, 7, 0); // 3 lines: 52 high
+    chat.add("ok", false, 0x100, 0, 0);                    // 20 high
+    CHECK(measured == 0);
+
+    CHECK(chat.top(0) == 0);
+    CHECK(chat.top(1) == 26);
+    CHECK(chat.top(2) == 84);
+    CHECK(chat.contentHeight() == 104);
+    CHECK(measured == 3);
+    CHECK(chat.bubble(1).width == 88);
+    CHECK(chat.bubble(1).height == 52);
+
+    CHECK(chat.indexAt(0) == 0);
+    CHECK(chat.indexAt(25) == 0); // gap belongs to the message above
+    CHECK(chat.indexAt(26) == 1);
+    CHECK(chat.indexAt(83) == 1);
+    CHECK(chat.indexAt(103) == 2);
+    CHECK(chat.indexAt(110) == ChatLayout::c_none);
+
+    // cached: appending only measures the new message
+    chat.add("new", false, 0x200, 0, 0);
+    CHECK(chat.contentHeight() == 130);
+    CHECK(measured == 4);
+
+    chat.invalidate();
+    CHECK(chat.measured() == 0);
+    CHECK(chat.contentHeight() == 130);
+    CHECK(measured == 8);
+}
+
+TEST_CASE("ChatLayout: texts and requests")
+{
+    ChatLayout chat(measureText, 6);
+    chat.add("first", true, 0, 11, 0);
+    chat.add("reply", false, 0x300, 11, 0);
+    chat.add("second", true, 0, 12, 0);
+
+    CHECK(strcmp(chat.text(0), "first") == 0);
+    CHECK(strcmp(chat.text(2), "second") == 0);
+    CHECK(chat.message(1).nodeNum == 0x300);
+
+    CHECK(chat.findRequest(11) == 0); // received messages have no request
+    CHECK(chat.findRequest(12) == 2);
+    CHECK(chat.findRequest(13) == ChatLayout::c_none);
+    chat.setStatus(2, 3);
+    CHECK(chat.message(2).status == 3);
+
+    chat.clear();
+    CHECK(chat.size() == 0);
+    CHECK(chat.contentHeight() == 0);
+    chat.add("again", false, 0x100, 0, 0);
+    CHECK(chat.contentHeight() == 20);
+}
@@ -0,0 +1,251 @@
+#include "TestFileSystem.h"
+#include "util/ChatSummary.h"
+#include "util/LogRotate.h"
+#include <doctest/doctest.h>
+#include <random>
+#include <string>
+
+namespace
+{
+constexpr const char *logDir = "/test_chatsummary";
+constexpr const char *summaryFile = "/test_chatsummary.sum";
+constexpr uint32_t ownNode = 0x1000;
+
+// same as ViewController::logMessage()
+void logMessage(LogRotate &log, ChatSummary &summary, const LogMessageEnv &msg, bool unread)
+{
+    log.write(msg);
+    summary.update(msg, ownNode, unread && msg.from != ownNode);
+    if (summary.changes() >= 16)
+        summary.save(log.endPosition());
+}
+
+void checkEqual(const ChatSummary &a, const ChatSummary &b, bool withUnread)
+{
+    auto chatsA = a.chats();
+    auto chatsB = b.chats();
+    REQUIRE(chatsA.size() == chatsB.size());
+    for (size_t i = 0; i < chatsA.size(); i++) {
+        CAPTURE(i);
+        CHECK(chatsA[i]->type == chatsB[i]->type);
+        CHECK(chatsA[i]->id == chatsB[i]->id);
+        CHECK(chatsA[i]->ch == chatsB[i]->ch);
+        CHECK(chatsA[i]->lastTime == chatsB[i]->lastTime);
+        CHECK(chatsA[i]->lastFrom == chatsB[i]->lastFrom);
+        CHECK(chatsA[i]->count == chatsB[i]->count);
+        CHECK(std::string(chatsA[i]->preview) == chatsB[i]->preview);
+        if (withUnread)
+            CHECK(chatsA[i]->unread == chatsB[i]->unread);
+    }
+}
+
+void cleanup(fs::FS &fs)
+{
+    removeDir(fs, logDir);
+    fs.remove(summaryFile);
+}
+} // namespace
+
+TEST_CASE("ChatSummary::consistency")
+{
+    fs::FS &fs = testFileSystem();
+    cleanup(fs);
+
+    std::mt19937 rnd(42);
+    {
+        // large enough to keep all records
+        LogRotate log(fs, logDir, sizeof(LogMessage), 400000, 100);
+        log.init();
+        ChatSummary summary(fs, summaryFile);
+        CHECK_FALSE(summary.load());
+
+        for (uint32_t i = 0; i < 1500; i++) {
+            uint32_t op = rnd() % 100;
+            uint32_t peer = 0x2000 + rnd() % 40; // more peers than DM slots
+            uint8_t ch = rnd() % 8;
+            std::string text = "msg " + std::to_string(i) + std::string(rnd() % 80, '-');
+            if (op < 2) {
+                logMessage(log, summary, LogMessageEnv(ownNode, UINT32_MAX, ch, 0, LogMessage::eDefault, true, 0, nullptr), false);
+            } else if (op < 4) {
+                logMessage(log, summary, LogMessageEnv(ownNode, peer, 0, 0, LogMessage::eDefault, true, 0, nullptr), false);
+            } else if (op < 5) {
+                summary.markRead();
+            } else {
+                uint32_t from = op < 30 ? ownNode : peer;
+                uint32_t to = op < 60 ? UINT32_MAX : (from == ownNode ? peer : ownNode);
+                logMessage(log, summary,
+                           LogMessageEnv(from, to, ch, 1000 + i, LogMessage::eDefault, false, text.size(),
+                                         (const uint8_t *)text.c_str()),
+                           true);
+            }
+        }
+        CHECK(summary.count() > ChatSummary::c_maxChannels);
+        // pending changes are saved on shutdown
+        REQUIRE(summary.save(log.endPosition()));
+
+        // persisted summary equals the one in memory
+        ChatSummary loaded(fs, summaryFile);
+        REQUIRE(loaded.load());
+        checkEqual(summary, loaded, true);
+        CHECK(loaded.unread() == summary.unread());
+    }
+
+    // summary rebuilt from the log equals the persisted summary (the log does not know about unread messages)
+    LogRotate log(fs, logDir, sizeof(LogMessage), 400000, 100);
+    log.init();
+    ChatSummary rebuilt(fs, "/test_chatsummary_rebuilt.sum");
+    LogMessageEnv msg;
+    while (log.readNext(msg))
+        rebuilt.update(msg, ownNode);
+
+    ChatSummary loaded(fs, summaryFile);
+    REQUIRE(loaded.load());
+    checkEqual(rebuilt, loaded, false);
+
+    cleanup(fs);
+}
+
+TEST_CASE("ChatSummary::replay")
+{
+    fs::FS &fs = testFileSystem();
+    cleanup(fs);
+
+    ChatSummary live(fs, "/test_chatsummary_live.sum");
+    {
+        // small logs so that the unsaved tail spans a rotation
+        LogRotate log(fs, logDir, sizeof(LogMessage), 4000, 100);
+        log.init();
+        ChatSummary summary(fs, summaryFile);
+        for (uint32_t i = 0; i < 200; i++) {
+            std::string text = "msg " + std::to_string(i);
+            LogMessageEnv msg(0x2000 + i % 30, i % 3 ? ownNode : UINT32_MAX, i % 4, 1000 + i, LogMessage::eDefault, false,
+                              text.size(), (const uint8_t *)text.c_str());
+            logMessage(log, summary, msg, true);
+            live.update(msg, ownNode, true);
+        }
+        // crash: the changes since the last save are lost
+        CHECK(summary.changes() > 0);
+        CHECK(summary.logPosition() < log.endPosition());
+    }
+
+    // same as ViewController::init() and the restore loader
+    LogRotate log(fs, logDir, sizeof(LogMessage), 4000, 100);
+    log.init();
+    ChatSummary summary(fs, summaryFile);
+    REQUIRE(summary.load());
+    REQUIRE(summary.logPosition() >= log.startPosition());
+    REQUIRE(summary.logPosition() <= log.endPosition());
+    LogRotate::Position replayTo = log.endPosition();
+    LogMessageEnv msg;
+    uint32_t replayed = 0;
+    while (log.readNext(msg)) {
+        if (log.readPosition() >= summary.logPosition() && log.readPosition() < replayTo) {
+            summary.update(msg, ownNode, msg.from != ownNode);
+            replayed++;
+        }
+    }
+    CHECK(replayed > 0);
+    checkEqual(live, summary, true);
+    CHECK(summary.unread() == live.unread());
+
+    REQUIRE(summary.save(log.endPosition()));
+    ChatSummary loaded(fs, summaryFile);
+    REQUIRE(loaded.load());
+    CHECK(loaded.logPosition() == replayTo);
+
+    cleanup(fs);
+    fs.remove("/test_chatsummary_live.sum");
+}
+
+TEST_CASE("ChatSummary::update")
+{
+    fs::FS &fs = testFileSystem();
+    cleanup(fs);
+    ChatSummary summary(fs, summaryFile);
+
+    auto message = [&](uint32_t from, uint32_t to, uint8_t ch, uint32_t time, const char *text, bool unread = false) {
+        summary.update(LogMessageEnv(from, to, ch, time, LogMessage::eDefault, false, strlen(text), (const uint8_t *)text),
+                       ownNode, unread);
+    };
+
+    SUBCASE("group and direct chats")
+    {
+        message(0x2000, UINT32_MAX, 3, 10, "hello channel", true);
+        message(ownNode, 0x2000, 0, 20, "hello peer");
+        message(0x2000, ownNode, 0, 30, "hello back", true);
+        REQUIRE(summary.count() == 2);
+        const ChatSummary::Chat *group = summary.find(ChatSummary::eChannel, 3);
+        const ChatSummary::Chat *direct = summary.find(ChatSummary::eDirect, 0x2000);
+        REQUIRE(group);
+        REQUIRE(direct);
+        CHECK(group->count == 1);
+        CHECK(direct->count == 2);
+        CHECK(direct->lastFrom == 0x2000);
+        CHECK(std::string(direct->preview) == "hello back");
+        CHECK(summary.unread() == 2);
+        CHECK(summary.chats().back() == direct);
+
+        summary.markRead();
+        CHECK(summary.unread() == 0);
+    }
+
+    SUBCASE("changes are counted until saved")
+    {
+        CHECK(summary.changes() == 0);
+        message(0x2000, UINT32_MAX, 3, 10, "one", true);
+        message(0x2000, UINT32_MAX, 3, 20, "two", true);
+        summary.markRead();
+        summary.markRead(); // nothing left to mark
+        CHECK(summary.changes() == 3);
+        CHECK(summary.isDirty());
+        REQUIRE(summary.save(0));
+        CHECK(summary.changes() == 0);
+        CHECK_FALSE(summary.isDirty());
+    }
+
+    SUBCASE("long messages are cut")
+    {
+        std::string text(200, 'x');
+        message(0x2000, UINT32_MAX, 0, 10, text.c_str());
+        CHECK(strlen(summary.find(ChatSummary::eChannel, 0)->preview) == ChatSummary::c_previewLen - 1);
+    }
+
+    SUBCASE("invalid channels are ignored")
+    {
+        message(0x2000, UINT32_MAX, 8, 10, "invalid");
+        CHECK(summary.count() == 0);
+    }
+
+    SUBCASE("least recently active DM chat is replaced")
+    {
+        for (uint32_t i = 0; i < ChatSummary::c_maxDirect; i++)
+            message(0x3000 + i, ownNode, 0, 100 + (i * 7) % ChatSummary::c_maxDirect, "dm");
+        uint32_t oldest = 0x3000; // (i * 7) % 24 == 0 only for i == 0
+        REQUIRE(summary.find(ChatSummary::eDirect, oldest));
+        message(0x4000, ownNode, 0, 500, "new");
+        CHECK(summary.count() == ChatSummary::c_maxDirect);
+        CHECK_FALSE(summary.find(ChatSummary::eDirect, oldest));
+        CHECK(summary.find(ChatSummary::eDirect, 0x4000));
+    }
+
+    SUBCASE("damaged or incomplete files are rejected")
+    {
+        message(0x2000, UINT32_MAX, 1, 10, "persisted");
+        REQUIRE(summary.save(0x100000020));
+        std::vector<uint8_t> image = readFile(fs, summaryFile);
+
+        ChatSummary loaded(fs, summaryFile);
+        CHECK(loaded.load());
+        CHECK(loaded.logPosition() == 0x100000020);
+
+        image[image.size() / 2] ^= 0xff;
+        writeFile(fs, summaryFile, image.data(), image.size());
+        CHECK_FALSE(loaded.load());
+        CHECK(loaded.count() == 0);
+
+        writeFile(fs, summaryFile, image.data(), image.size() / 2);
+        CHECK_FALSE(loaded.load());
+    }
+
+    cleanup(fs);
+}
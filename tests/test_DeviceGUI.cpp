@@ -0,0 +1,167 @@
+#if defined(ARCH_PORTDUINO)
+
+#include "graphics/DeviceGUI.h"
+#include "graphics/driver/DisplayDriver.h"
+#include "lvgl.h"
+#include "util/Wakeup.h"
+#include <chrono>
+#include <doctest/doctest.h>
+#include <fcntl.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+/**
+ * Drives the Linux main loop of DeviceGUI::task_handler() on a headless display whose next LVGL
+ * timer is due when the test says so, and checks how long each call sleeps and what wakes it up.
+ */
+
+namespace
+{
+constexpr int32_t c_width = 64;
+constexpr int32_t c_height = 32;
+constexpr uint32_t c_maxSleep = 100; // ms, as in DeviceGUI
+constexpr uint32_t c_wakeAfter = 20; // ms until the other thread notifies or writes the input device
+
+class HeadlessDriver : public DisplayDriver
+{
+  public:
+    HeadlessDriver(void) : DisplayDriver(c_width, c_height), drawBuf(c_width * c_height / 4 * 2) {}
+
+    void init(DeviceGUI *gui) override
+    {
+        DisplayDriver::init(gui);
+        display = lv_display_create(c_width, c_height);
+        lv_display_set_color_format(display, LV_COLOR_FORMAT_RGB565);
+        lv_display_set_buffers(display, drawBuf.data(), nullptr, drawBuf.size(), LV_DISPLAY_RENDER_MODE_PARTIAL);
+        lv_display_set_flush_cb(display, [](lv_display_t *disp, const lv_area_t *, uint8_t *) { lv_display_flush_ready(disp); });
+        lv_display_set_default(display);
+    }
+
+    // run the LVGL timers, then pretend the next one is due in nextTimer ms
+    void task_handler(void) override
+    {
+        DisplayDriver::task_handler();
+        lastTimerRun = lv_tick_get();
+        timeUntilNext = nextTimer;
+    }
+
+    uint32_t nextTimer = LV_NO_TIMER_READY;
+
+  private:
+    std::vector<uint8_t> drawBuf;
+};
+
+uint32_t reads = 0; // of the keypad
+
+void keypad_read_cb(lv_indev_t *, lv_indev_data_t *data)
+{
+    reads++;
+    data->state = LV_INDEV_STATE_RELEASED;
+}
+
+// the loop with its display for all test cases, never deleted: ~DeviceGUI() deletes the shared InputDriver
+struct Loop {
+    Loop(void) : gui(nullptr, &driver)
+    {
+        // not DeviceGUI::init(), it would also scan for I2C keyboards
+        driver.init(&gui);
+        for (int i = 0; i < 5; i++) {
+            driver.nextTimer = 0;
+            gui.task_handler();
+        }
+    }
+
+    // ms the next task_handler() call blocks
+    uint32_t run(uint32_t nextTimer)
+    {
+        driver.nextTimer = nextTimer;
+        auto start = std::chrono::steady_clock::now();
+        gui.task_handler();
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    HeadlessDriver driver;
+    DeviceGUI gui;
+};
+
+Loop &loop(void)
+{
+    static Loop *instance = new Loop;
+    Wakeup::instance().wait(0); // drop notifications of earlier tests, e.g. from SharedQueue
+    return *instance;
+}
+} // namespace
+
+TEST_CASE("DeviceGUI: task_handler sleeps until the next timer is due")
+{
+    Loop &l = loop();
+    // idle: at most c_maxSleep
+    uint32_t ms = l.run(LV_NO_TIMER_READY);
+    CHECK(ms >= c_maxSleep - 1);
+    CHECK(ms < 5 * c_maxSleep);
+
+    ms = l.run(30);
+    CHECK(ms >= 29);
+    CHECK(ms < c_maxSleep - 10);
+
+    CHECK(l.run(0) < 10);
+}
+
+TEST_CASE("DeviceGUI: task_handler wakes up for a queued packet")
+{
+    Loop &l = loop();
+    std::thread server([] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(c_wakeAfter));
+        Wakeup::instance().notify(); // as SharedQueue::serverSend()
+    });
+    uint32_t ms = l.run(LV_NO_TIMER_READY);
+    server.join();
+    CHECK(ms >= c_wakeAfter - 5);
+    CHECK(ms < c_maxSleep - 10);
+}
+
+TEST_CASE("DeviceGUI: task_handler reads an input device in event mode on input only")
+{
+    Loop &l = loop();
+    int fds[2];
+    REQUIRE(pipe2(fds, O_NONBLOCK | O_CLOEXEC) == 0);
+    Wakeup::instance().watch(fds[0]); // as LinuxInputDriver does for its evdev devices
+
+    lv_indev_t *keypad = lv_indev_create();
+    lv_indev_set_type(keypad, LV_INDEV_TYPE_KEYPAD);
+    lv_indev_set_read_cb(keypad, keypad_read_cb);
+    lv_indev_set_display(keypad, l.driver.getDisplay());
+    lv_indev_set_mode(keypad, LV_INDEV_MODE_EVENT);
+    reads = 0;
+
+    // no input: the device is not read
+    CHECK(l.run(LV_NO_TIMER_READY) >= c_maxSleep - 1);
+    CHECK(reads == 0);
+
+    // input wakes the loop and is read right away
+    std::thread device([&fds] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(c_wakeAfter));
+        (void)write(fds[1], "", 1);
+    });
+    uint32_t ms = l.run(LV_NO_TIMER_READY);
+    device.join();
+    CHECK(ms >= c_wakeAfter - 5);
+    CHECK(ms < c_maxSleep - 10);
+    CHECK(reads == 1);
+
+    // read once more after a read period, then sleep again
+    ms = l.run(LV_NO_TIMER_READY);
+    CHECK(ms >= LV_DEF_REFR_PERIOD - 1);
+    CHECK(ms < c_maxSleep - 10);
+    CHECK(reads == 2);
+    CHECK(l.run(LV_NO_TIMER_READY) >= c_maxSleep - 1);
+    CHECK(reads == 2);
+
+    lv_indev_delete(keypad);
+    Wakeup::instance().unwatch(fds[0]);
+    close(fds[0]);
+    close(fds[1]);
+}
+
+#endif
@@ -0,0 +1,130 @@
+#include "util/DistanceTracker.h"
+#include <doctest/doctest.h>
+#include <map>
+#include <math.h>
+#include <string>
+
+namespace
+{
+double haversine(double lat1, double lon1, double lat2, double lon2)
+{
+    const double r = 6371000.0, rad = M_PI / 180.0;
+    double dlat = (lat2 - lat1) * rad, dlon = (lon2 - lon1) * rad;
+    double a = sin(dlat / 2) * sin(dlat / 2) + cos(lat1 * rad) * cos(lat2 * rad) * sin(dlon / 2) * sin(dlon / 2);
+    return 2 * r * asin(sqrt(a));
+}
+
+uint32_t kernel(double lat1, double lon1, double lat2, double lon2)
+{
+    int32_t a = lround(lat1 * 1e6), b = lround(lon1 * 1e6), c = lround(lat2 * 1e6), d = lround(lon2 * 1e6);
+    return DistanceTracker::distance(a, b, DistanceTracker::cosQ15(a), c, d, DistanceTracker::cosQ15(c));
+}
+} // namespace
+
+TEST_CASE("DistanceTracker::accuracy")
+{
+    // relative error against haversine by range, in all directions and at several latitudes
+    struct Range {
+        double meters;
+        double maxError; // relative
+    } ranges[] = {{100, 0.01}, {1000, 0.002}, {10000, 0.002}, {100000, 0.003}, {500000, 0.01}};
+    const double latitudes[] = {0.0, 30.0, 47.5, -60.0, 70.0};
+
+    for (const Range &range : ranges) {
+        for (double lat : latitudes) {
+            for (int bearing = 0; bearing < 360; bearing += 30) {
+                double b = bearing * M_PI / 180.0;
+                double dlat = range.meters * cos(b) / 111195.0;
+                double dlon = range.meters * sin(b) / (111195.0 * cos(lat * M_PI / 180.0));
+                double lon = 8.5;
+                double expected = haversine(lat, lon, lat + dlat, lon + dlon);
+                double actual = kernel(lat, lon, lat + dlat, lon + dlon);
+                CAPTURE(range.meters);
+                CAPTURE(lat);
+                CAPTURE(bearing);
+                CHECK(fabs(actual - expected) <= range.maxError * expected + 1.0);
+            }
+        }
+    }
+
+    // across the antimeridian
+    CHECK(fabs(kernel(10.0, 179.99, 10.0, -179.99) - haversine(10.0, 179.99, 10.0, -179.99)) < 5.0);
+    CHECK(kernel(47.0, 8.0, 47.0, 8.0) == 0);
+}
+
+TEST_CASE("DistanceTracker::tracking")
+{
+    DistanceTracker tracker(10);
+    std::map<uint32_t, std::string> labels;
+    auto update = [&](uint32_t nodeNum, const char *text) { labels[nodeNum] = text; };
+
+    // 1e-7 degrees as in the position packets
+    tracker.setPosition(1, 473000000, 85000000);
+    tracker.setPosition(2, 473100000, 85000000); // ~1.1 km north
+    tracker.setPosition(3, 483000000, 85000000); // ~111 km north
+    CHECK(tracker.pending() == 3);
+    CHECK(tracker.process(10, update) == 0); // no own position yet
+    CHECK(labels.empty());
+
+    SUBCASE("batches and displayed values")
+    {
+        CHECK(tracker.setOrigin(473000000, 85000000));
+        CHECK(tracker.process(2, update) == 2);
+        CHECK(tracker.pending() == 1);
+        CHECK(tracker.process(2, update) == 1);
+        CHECK(tracker.pending() == 0);
+        CHECK(labels[1] == "0 m");
+        CHECK(labels[2] == "1.1 km");
+        CHECK(labels[3] == "111.2 km");
+        CHECK(tracker.distance(3) == 111195);
+        CHECK(tracker.distance(4) == DistanceTracker::c_none);
+    }
+
+    SUBCASE("movement threshold and unchanged labels")
+    {
+        tracker.setOrigin(473000000, 85000000);
+        tracker.process(10, update);
+        labels.clear();
+
+        CHECK_FALSE(tracker.setOrigin(473000500, 85000000)); // ~5 m
+        CHECK(tracker.pending() == 0);
+
+        CHECK(tracker.setOrigin(473003000, 85000000)); // ~33 m
+        CHECK(tracker.pending() == 3);
+        CHECK(tracker.process(10, update) == 3);
+        // only node 1 shows a different rounded distance
+        CHECK(labels.size() == 1);
+        CHECK(labels[1] == "33 m");
+
+        labels.clear();
+        tracker.invalidate(3);
+        tracker.process(10, update);
+        CHECK(labels.size() == 1);
+        CHECK(labels[3] == "111.2 km");
+    }
+
+    SUBCASE("units, node updates and removal")
+    {
+        tracker.setOrigin(473000000, 85000000);
+        tracker.process(10, update);
+        tracker.setMetric(false);
+        CHECK(tracker.pending() == 3);
+        tracker.process(10, update);
+        CHECK(labels[1] == "0 ft");
+        CHECK(labels[2] == "0.7 mi");
+        CHECK(labels[3] == "69.1 mi");
+
+        tracker.setPosition(1, 473000000, 85010000); // ~75 m east
+        tracker.remove(2);
+        CHECK(tracker.size() == 2);
+        CHECK(tracker.pending() == 1);
+        tracker.process(10, update);
+        CHECK(labels[1] == "246 ft");
+        CHECK(tracker.distance(2) == DistanceTracker::c_none);
+        CHECK(tracker.distance(3) == 111195);
+
+        tracker.clear();
+        CHECK(tracker.size() == 0);
+        CHECK(tracker.pending() == 0);
+    }
+}
@@ -0,0 +1,81 @@
+#include "util/Histogram.h"
+#include <doctest/doctest.h>
+#include <random>
+
+TEST_CASE("Histogram: buckets")
+{
+    // small values are exact
+    for (uint32_t v = 0; v < Histogram::c_subBuckets; v++)
+        CHECK(Histogram::bucket(v) == v);
+
+    // buckets are contiguous and each value lies within its bucket
+    uint32_t previous = 0;
+    for (uint64_t v = 1; v <= UINT32_MAX; v += v / 7 + 1) {
+        uint32_t b = Histogram::bucket(uint32_t(v));
+        CHECK(b >= previous);
+        CHECK(b <= previous + 1);
+        CHECK(Histogram::lowerBound(b) <= v);
+        if (b + 1 < Histogram::c_buckets)
+            CHECK(v < Histogram::lowerBound(b + 1));
+        previous = b;
+    }
+    CHECK(Histogram::bucket(UINT32_MAX) == Histogram::c_buckets - 1);
+
+    // a bucket is at most 25% wide relative to its lower bound
+    for (uint32_t b = Histogram::c_subBuckets; b + 1 < Histogram::c_buckets; b++) {
+        uint32_t width = Histogram::lowerBound(b + 1) - Histogram::lowerBound(b);
+        CHECK(width * 4 <= Histogram::lowerBound(b));
+    }
+}
+
+TEST_CASE("Histogram: statistics")
+{
+    Histogram h;
+    CHECK(h.count() == 0);
+    CHECK(h.min() == 0);
+    CHECK(h.max() == 0);
+    CHECK(h.mean() == 0);
+    CHECK(h.percentile(50) == 0);
+
+    for (uint32_t v : {3, 1, 2, 2})
+        h.add(v);
+    CHECK(h.count() == 4);
+    CHECK(h.min() == 1);
+    CHECK(h.max() == 3);
+    CHECK(h.mean() == 2);
+    CHECK(h.percentile(0) == 1);
+    CHECK(h.percentile(25) == 1);
+    CHECK(h.percentile(50) == 2);
+    CHECK(h.percentile(75) == 2);
+    CHECK(h.percentile(100) == 3);
+
+    h.clear();
+    CHECK(h.count() == 0);
+    CHECK(h.max() == 0);
+    h.add(1000000);
+    CHECK(h.min() == 1000000);
+    CHECK(h.percentile(99) == 1000000); // limited to max
+}
+
+TEST_CASE("Histogram: percentiles of a distribution")
+{
+    Histogram h;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<uint32_t> frame(5000, 15000);
+    for (int i = 0; i < 100000; i++)
+        h.add(frame(rng));
+    // a few slow frames
+    for (int i = 0; i < 200; i++)
+        h.add(80000);
+
+    CHECK(h.count() == 100200);
+    CHECK(h.mean() == doctest::Approx(10150).epsilon(0.01));
+    for (uint32_t p : {10, 50, 90}) {
+        CAPTURE(p);
+        uint32_t exact = 5000 + 10000 * p / 100;
+        CHECK(h.percentile(p) >= exact);
+        CHECK(h.percentile(p) <= exact * 5 / 4);
+    }
+    CHECK(h.percentile(99) <= 15000 * 5 / 4); // not the slow frames
+    CHECK(h.percentile(100) == 80000);
+}
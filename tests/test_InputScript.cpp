@@ -0,0 +1,78 @@
+#include "util/InputScript.h"
+#include <doctest/doctest.h>
+
+TEST_CASE("InputScript: commands and timing")
+{
+    InputScript script;
+    CHECK(script.parse("# open the nodes panel\n"
+                       "wait 3000\n"
+                       "tap 20 60   # nodes button\n"
+                       "\n"
+                       "wait 500\n"
+                       "key enter\n"
+                       "key a\n"
+                       "key 13\n"
+                       "press 100 100\n"
+                       "wait 40\n"
+                       "move 100 80\n"
+                       "release\n"
+                       "snapshot nodes\n"));
+    CHECK(script.errorLine() == 0);
+
+    const auto &events = script.events();
+    REQUIRE(events.size() == 9);
+    CHECK(events[0].action == InputScript::ePress);
+    CHECK(events[0].at == 3000);
+    CHECK(events[0].x == 20);
+    CHECK(events[0].y == 60);
+    CHECK(events[1].action == InputScript::eRelease);
+    CHECK(events[1].at == 3000 + InputScript::c_tapMs);
+    CHECK(events[2].action == InputScript::eKey);
+    CHECK(events[2].key == 10);
+    CHECK(events[2].at == 3580);
+    CHECK(events[3].key == 'a');
+    CHECK(events[4].key == 13);
+    CHECK(events[5].action == InputScript::ePress);
+    CHECK(events[6].action == InputScript::eMove);
+    CHECK(events[6].at == 3620);
+    CHECK(events[6].y == 80);
+    // release where the pointer was last
+    CHECK(events[7].action == InputScript::eRelease);
+    CHECK(events[7].y == 80);
+    CHECK(events[8].action == InputScript::eSnapshot);
+    CHECK(events[8].name == "nodes");
+    CHECK(script.duration() == 3620);
+}
+
+TEST_CASE("InputScript: drag is split into moves")
+{
+    InputScript script;
+    CHECK(script.parse("drag 10 200 10 100 100"));
+    const auto &events = script.events();
+    REQUIRE(events.size() == 1 + 100 / InputScript::c_moveMs + 1);
+    CHECK(events.front().action == InputScript::ePress);
+    CHECK(events.front().y == 200);
+    for (size_t i = 1; i + 1 < events.size(); i++) {
+        CHECK(events[i].action == InputScript::eMove);
+        CHECK(events[i].y < events[i - 1].y);
+        CHECK(events[i].at > events[i - 1].at);
+    }
+    CHECK(events.back().action == InputScript::eRelease);
+    CHECK(events.back().y == 100);
+    CHECK(events.back().at == 100);
+}
+
+TEST_CASE("InputScript: invalid lines")
+{
+    const char *invalid[] = {"jump 1 2", "tap 10", "wait", "key", "key nokey", "release", "move 1 2", "wait 10 20"};
+    for (const char *line : invalid) {
+        CAPTURE(line);
+        InputScript script;
+        CHECK_FALSE(script.parse(std::string("wait 10\n") + line + "\nwait 10\n"));
+        CHECK(script.errorLine() == 2);
+        CHECK(script.duration() == 10);
+    }
+
+    InputScript script;
+    CHECK_FALSE(script.load("/nonexistent/script.txt"));
+}
@@ -0,0 +1,210 @@
+#include "MockLGFX.h"
+#include "graphics/driver/LGFXFlush.h"
+#include <doctest/doctest.h>
+
+// from ConvertPNG.c
+extern "C" bool decodeImgColor(const void *data, size_t size, lv_img_dsc_t **img);
+
+namespace
+{
+constexpr uint32_t c_width = 320;
+constexpr uint32_t c_height = 240;
+constexpr uint32_t c_rows = 30; // per draw buffer
+
+uint8_t drawBuf1[c_width * c_rows * 2];
+uint8_t drawBuf2[c_width * c_rows * 2];
+
+lv_display_t *display(MockLGFX &lgfx, bool doubleBuffered, lv_color_format_t cf = LV_COLOR_FORMAT_RGB565)
+{
+    if (!lv_is_initialized())
+        lv_init();
+    lv_display_t *disp = lv_display_create(c_width, c_height);
+    lv_display_set_color_format(disp, cf);
+    lv_display_set_buffers(disp, drawBuf1, doubleBuffered ? drawBuf2 : nullptr, sizeof(drawBuf1),
+                           LV_DISPLAY_RENDER_MODE_PARTIAL);
+    LGFXFlush<MockLGFX>::attach(disp, &lgfx);
+
+    lv_obj_t *screen = lv_display_get_screen_active(disp);
+    lv_obj_set_style_bg_color(screen, lv_color_hex(0xff0000), 0);
+    lv_obj_set_style_bg_opa(screen, LV_OPA_COVER, 0);
+    return disp;
+}
+
+// red as the panel expects it: RGB565 with the bytes swapped
+constexpr uint16_t c_red = 0x00f8;
+
+uint16_t tilePixels[64 * 64];
+
+// gradients, text and an RGB565 image like a map tile from decodeImgColor()
+void createScene(lv_display_t *disp)
+{
+    lv_obj_t *screen = lv_display_get_screen_active(disp);
+    lv_obj_set_style_bg_color(screen, lv_color_hex(0x2040c0), 0);
+    lv_obj_set_style_bg_grad_color(screen, lv_color_hex(0xf0e010), 0);
+    lv_obj_set_style_bg_grad_dir(screen, LV_GRAD_DIR_VER, 0);
+
+    lv_obj_t *panel = lv_obj_create(screen);
+    lv_obj_set_size(panel, 200, 100);
+    lv_obj_set_pos(panel, 10, 10);
+    lv_obj_set_style_bg_opa(panel, LV_OPA_50, 0);
+    lv_obj_set_style_radius(panel, 12, 0);
+    lv_obj_t *label = lv_label_create(panel);
+    lv_label_set_text(label, "Meshtastic 0123456789");
+
+    static lv_image_dsc_t tile;
+    for (uint32_t i = 0; i < 64 * 64; i++)
+        tilePixels[i] = (uint16_t)(i * 2654435761u >> 16);
+    tile.header.magic = LV_IMAGE_HEADER_MAGIC;
+    tile.header.cf = LV_COLOR_FORMAT_RGB565;
+    tile.header.w = 64;
+    tile.header.h = 64;
+    tile.header.stride = 64 * 2;
+    tile.data = (const uint8_t *)tilePixels;
+    tile.data_size = sizeof(tilePixels);
+    lv_obj_t *image = lv_image_create(screen);
+    lv_image_set_src(image, &tile);
+    lv_obj_set_pos(image, 230, 150);
+}
+} // namespace
+
+TEST_CASE("LGFXFlush: two draw buffers are transferred by DMA")
+{
+    MockLGFX lgfx(c_width, c_height);
+    lv_display_t *disp = display(lgfx, true);
+
+    lv_refr_now(disp);
+    CHECK(lgfx.transfers == c_height / c_rows);
+    CHECK(lgfx.dmaTransfers == lgfx.transfers);
+    CHECK(lgfx.unselected == 0);
+    CHECK(lgfx.pixels == c_width * c_height);
+    // the last area is still being transferred with the bus selected
+    CHECK(lgfx.getStartCount() == 1);
+
+    LGFXFlush<MockLGFX>::finish(&lgfx);
+    CHECK(lgfx.getStartCount() == 0);
+    CHECK_FALSE(lgfx.dmaBusy());
+    CHECK(lgfx.pixel(0, 0) == c_red);
+    CHECK(lgfx.pixel(c_width - 1, c_height - 1) == c_red);
+
+    // a frame after the transfer was finished elsewhere (e.g. by touchpad_read) starts a new transaction
+    lv_obj_invalidate(lv_display_get_screen_active(disp));
+    lv_refr_now(disp);
+    CHECK(lgfx.transfers == 2 * c_height / c_rows);
+    CHECK(lgfx.unselected == 0);
+    LGFXFlush<MockLGFX>::finish(&lgfx);
+    CHECK(lgfx.getStartCount() == 0);
+    lv_display_delete(disp);
+}
+
+TEST_CASE("LGFXFlush: the bus is released while rendering, e.g. for a tile read from SD")
+{
+    MockLGFX lgfx(c_width, c_height);
+    lv_display_t *disp = display(lgfx, true);
+
+    // drawn in the lower half, when the areas above were handed to DMA already
+    static uint32_t released;
+    released = 0;
+    lv_obj_t *tile = lv_obj_create(lv_display_get_screen_active(disp));
+    lv_obj_set_size(tile, 64, 64);
+    lv_obj_set_pos(tile, 10, c_height - 80);
+    lv_obj_add_event_cb(
+        tile,
+        [](lv_event_t *e) {
+            // like TileFsLock in the lv_fs callbacks of the SD card
+            MockLGFX *lgfx = (MockLGFX *)lv_event_get_user_data(e);
+            if (lgfx->getStartCount() > 0)
+                released++;
+            LGFXFlush<MockLGFX>::acquire(lgfx);
+            CHECK_FALSE(lgfx->dmaBusy());
+            CHECK(lgfx->getStartCount() == 0);
+            LGFXFlush<MockLGFX>::release();
+        },
+        LV_EVENT_DRAW_MAIN, &lgfx);
+
+    lv_refr_now(disp);
+    CHECK(released > 0);
+    CHECK(lgfx.transfers == c_height / c_rows);
+    CHECK(lgfx.unselected == 0);
+    LGFXFlush<MockLGFX>::finish(&lgfx);
+    CHECK(lgfx.pixels == c_width * c_height);
+    CHECK(lgfx.pixel(0, 0) == c_red);
+    lv_display_delete(disp);
+}
+
+TEST_CASE("LGFXFlush: one draw buffer is pushed blocking")
+{
+    MockLGFX lgfx(c_width, c_height);
+    lv_display_t *disp = display(lgfx, false);
+
+    lv_refr_now(disp);
+    CHECK(lgfx.transfers == c_height / c_rows);
+    CHECK(lgfx.dmaTransfers == 0);
+    CHECK(lgfx.getStartCount() == 0);
+    CHECK_FALSE(lgfx.dmaBusy());
+    CHECK(lgfx.pixel(c_width / 2, c_height / 2) == c_red);
+    lv_display_delete(disp);
+}
+
+TEST_CASE("LGFXFlush: RGB565_SWAPPED is pushed pixel-exact without swapping")
+{
+    MockLGFX swapped(c_width, c_height), rgb565(c_width, c_height);
+    lv_display_t *disp = display(rgb565, false);
+    createScene(disp);
+    lv_refr_now(disp);
+    lv_display_delete(disp);
+    CHECK(rgb565.pixel(0, 0) != rgb565.pixel(c_width - 1, c_height - 1)); // the gradient is rendered
+
+    for (bool doubleBuffered : {false, true}) {
+        CAPTURE(doubleBuffered);
+        disp = display(swapped, doubleBuffered, LV_COLOR_FORMAT_RGB565_SWAPPED);
+        createScene(disp);
+        lv_refr_now(disp);
+        LGFXFlush<MockLGFX>::finish(&swapped);
+        lv_display_delete(disp);
+
+        uint32_t differ = 0;
+        for (uint32_t y = 0; y < c_height; y++) {
+            for (uint32_t x = 0; x < c_width; x++) {
+                if (swapped.pixel(x, y) != rgb565.pixel(x, y))
+                    differ++;
+            }
+        }
+        CHECK(differ == 0);
+    }
+}
+
+TEST_CASE("LGFXFlush: a decoded map tile reaches the panel in its byte order")
+{
+    // 2x1 RGB PNG: pure red and #123456
+    static const uint8_t png[] = {
+        0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52, 0x00, 0x00,
+        0x00, 0x02, 0x00, 0x00, 0x00, 0x01, 0x08, 0x02, 0x00, 0x00, 0x00, 0x7b, 0x40, 0xe8, 0xdd, 0x00, 0x00, 0x00,
+        0x0f, 0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0x63, 0xf8, 0xcf, 0xc0, 0x20, 0x64, 0x12, 0x06, 0x00, 0x06, 0xf5,
+        0x01, 0x9c, 0xbc, 0xac, 0x67, 0xdb, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82};
+    lv_img_dsc_t *tile = nullptr;
+    if (!lv_is_initialized())
+        lv_init();
+    REQUIRE(decodeImgColor(png, sizeof(png), &tile));
+    REQUIRE(tile->header.cf == LV_COLOR_FORMAT_RGB565);
+    CHECK(((const uint16_t *)tile->data)[1] == 0x11aa); // RGB565 of #123456
+
+    // decoded in RGB565, blended into the RGB565_SWAPPED draw buffer, pushed as rendered
+    MockLGFX lgfx(c_width, c_height);
+    lv_display_t *disp = display(lgfx, true, LV_COLOR_FORMAT_RGB565_SWAPPED);
+    lv_obj_t *image = lv_image_create(lv_display_get_screen_active(disp));
+    lv_image_set_src(image, tile);
+    lv_obj_set_pos(image, 100, 100);
+    lv_obj_set_style_bg_color(lv_display_get_screen_active(disp), lv_color_hex(0x000000), 0);
+    lv_refr_now(disp);
+    LGFXFlush<MockLGFX>::finish(&lgfx);
+
+    CHECK(lgfx.pixel(100, 100) == c_red);
+    CHECK(lgfx.pixel(101, 100) == 0xaa11);
+    CHECK(lgfx.pixel(102, 100) == 0x0000);
+
+    lv_obj_delete(image);
+    lv_display_delete(disp);
+    lv_image_cache_drop(tile);
+    lv_free((void *)tile->data);
+    lv_free(tile);
+}
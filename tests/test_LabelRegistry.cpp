@@ -0,0 +1,195 @@
+#include "lv_i18n.h"
+#include "util/LabelRegistry.h"
+#include <doctest/doctest.h>
+#include <map>
+#include <set>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+// label texts as the widgets would show them
+struct Widgets {
+    std::map<LabelRegistry::Label, std::string> text;
+    std::set<LabelRegistry::Label> visible;
+    uint32_t writes = 0;
+
+    LabelRegistry registry(LabelRegistry::Resolve resolve = nullptr)
+    {
+        return LabelRegistry(
+            lv_i18n_get_text, [this](LabelRegistry::Label l) { return text[l].c_str(); },
+            [this](LabelRegistry::Label l, const char *t) {
+                text[l] = t;
+                writes++;
+            },
+            resolve);
+    }
+    LabelRegistry::Visible isVisible(void)
+    {
+        return [this](LabelRegistry::Label l) { return visible.count(l) != 0; };
+    }
+};
+
+std::string formatted(const char *fmt, int value)
+{
+    char buf[256];
+    snprintf(buf, sizeof(buf), fmt, value);
+    return buf;
+}
+
+std::vector<std::string> singularIds(void)
+{
+    std::set<std::string> seen;
+    std::vector<std::string> ids;
+    for (const lv_i18n_language_pack_t *lang = lv_i18n_language_pack; *lang; lang++) {
+        for (const lv_i18n_phrase_t *p = (*lang)->singulars; p && p->msg_id; p++) {
+            if (!strchr(p->msg_id, '%') && seen.insert(p->msg_id).second)
+                ids.push_back(p->msg_id);
+        }
+    }
+    return ids;
+}
+} // namespace
+
+TEST_CASE("LabelRegistry: no stale translation in any language")
+{
+    REQUIRE(lv_i18n_init_default() == 0);
+    Widgets w;
+    LabelRegistry labels = w.registry();
+
+    // one label per message ID plus formatted ones, every third one visible
+    std::vector<std::string> ids = singularIds();
+    std::vector<int> slots(ids.size() + 2);
+    for (size_t i = 0; i < ids.size(); i++) {
+        labels.bind(&slots[i], ids[i].c_str());
+        if (i % 3 == 0)
+            w.visible.insert(&slots[i]);
+    }
+    int timeout = 30;
+    const char *timeoutId = "Screen Timeout: %ds";
+    labels.bind(&slots[ids.size()], timeoutId,
+                [&](char *buf, size_t size, const char *fmt) { snprintf(buf, size, fmt, timeout); });
+    const char *lockId = "Lock: %s/%s";
+    labels.bind(&slots[ids.size() + 1], lockId,
+                [](char *buf, size_t size, const char *fmt) { snprintf(buf, size, fmt, _("on"), _("off")); });
+    REQUIRE(labels.size() == slots.size());
+
+    for (const lv_i18n_language_pack_t *lang = lv_i18n_language_pack; *lang; lang++) {
+        CAPTURE((*lang)->locale_name);
+        labels.invalidate();
+        REQUIRE(lv_i18n_set_locale((*lang)->locale_name) == 0);
+        timeout++;
+
+        // the first frame relabels all visible labels
+        labels.relabel(w.isVisible(), 4);
+        for (size_t i = 0; i < ids.size(); i += 3)
+            CHECK(w.text[&slots[i]] == _(ids[i].c_str()));
+
+        uint32_t frames = 1;
+        while (labels.relabel(w.isVisible(), 4) > 0)
+            frames++;
+        CHECK(frames <= slots.size() / 4 + 1);
+        for (size_t i = 0; i < ids.size(); i++) {
+            CAPTURE(ids[i]);
+            CHECK(w.text[&slots[i]] == _(ids[i].c_str()));
+        }
+        CHECK(w.text[&slots[ids.size()]] == formatted(_(timeoutId), timeout));
+        char lock[64];
+        snprintf(lock, sizeof(lock), _(lockId), _("on"), _("off"));
+        CHECK(w.text[&slots[ids.size() + 1]] == lock);
+    }
+    CHECK(labels.released() == 0);
+    lv_i18n_set_locale("en");
+}
+
+TEST_CASE("LabelRegistry: visible labels first, the others within the budget")
+{
+    REQUIRE(lv_i18n_init_default() == 0);
+    Widgets w;
+    LabelRegistry labels = w.registry();
+    int slots[10];
+    for (int &s : slots)
+        labels.bind(&s, "Settings");
+    w.visible = {&slots[2], &slots[7]};
+
+    labels.invalidate();
+    REQUIRE(lv_i18n_set_locale("de") == 0);
+    CHECK(labels.stale() == 10);
+    uint32_t writes = w.writes;
+    CHECK(labels.relabel(w.isVisible(), 3) == 5);
+    CHECK(w.writes - writes == 5);
+    CHECK(w.text[&slots[2]] == _("Settings"));
+    CHECK(w.text[&slots[7]] == _("Settings"));
+    CHECK(labels.relabel(w.isVisible(), 3) == 2);
+    // a label becoming visible is relabeled regardless of the budget
+    w.visible.insert(&slots[0]);
+    w.visible.insert(&slots[1]);
+    CHECK(labels.relabel(w.isVisible(), 0) == 0);
+    for (int &s : slots)
+        CHECK(w.text[&s] == _("Settings"));
+    lv_i18n_set_locale("en");
+}
+
+TEST_CASE("LabelRegistry: labels changed by their owner are released")
+{
+    REQUIRE(lv_i18n_init_default() == 0);
+    Widgets w;
+    LabelRegistry labels = w.registry();
+    int a, b, c;
+    w.text[&a] = "Settings"; // created with _("Settings") in English
+    CHECK(labels.adopt(&a, "Settings"));
+    CHECK(w.writes == 0);
+    labels.bind(&b, "Settings");
+    labels.bind(&c, "no signal");
+    CHECK_FALSE(labels.bind(&c, "no signal"));
+    CHECK(labels.size() == 3);
+
+    w.text[&b] = "12:34"; // now shows a value
+    labels.invalidate();
+    REQUIRE(lv_i18n_set_locale("de") == 0);
+    CHECK(labels.relabel(w.isVisible(), 10) == 0);
+    CHECK(w.text[&a] == _("Settings"));
+    CHECK(w.text[&b] == "12:34");
+    CHECK(w.text[&c] == _("no signal"));
+    CHECK(labels.released() == 1);
+    CHECK_FALSE(labels.bound(&b));
+
+    labels.unbind(&c);
+    CHECK(labels.size() == 1);
+    labels.invalidate();
+    labels.unbind(&a);
+    CHECK(labels.stale() == 0);
+    lv_i18n_set_locale("en");
+}
+
+TEST_CASE("LabelRegistry: labels changed to another message are rebound")
+{
+    REQUIRE(lv_i18n_init_default() == 0);
+    Widgets w;
+    LabelRegistry labels = w.registry(lv_i18n_get_msg_id);
+    int start, status, value;
+    w.text[&start] = "Start";
+    w.text[&status] = "no signal";
+    w.text[&value] = "12:34";
+    CHECK(labels.adopt(&start));
+    CHECK(labels.adopt(&status));
+    CHECK_FALSE(labels.adopt(&value));
+    CHECK_FALSE(labels.adopt(&start));
+    CHECK(labels.msgId(&start) != nullptr);
+    CHECK(labels.msgId(&value) == nullptr);
+
+    REQUIRE(lv_i18n_set_locale("de") == 0);
+    w.text[&start] = _("Stop"); // like lv_label_set_text(label, _("Stop"))
+    w.text[&status] = "-80 dBm";
+    labels.invalidate();
+    REQUIRE(lv_i18n_set_locale("fr") == 0);
+    CHECK(labels.relabel(w.isVisible(), 10) == 0);
+    CHECK(w.text[&start] == _("Stop"));
+    CHECK(std::string(labels.msgId(&start)) == "Stop");
+    CHECK(w.text[&status] == "-80 dBm");
+    CHECK(labels.released() == 1);
+    CHECK(labels.size() == 1);
+    lv_i18n_set_locale("en");
+}
@@ -0,0 +1,352 @@
+#include "TestFileSystem.h"
+#include "util/LogMessage.h"
+#include "util/LogRotate.h"
+#include <doctest/doctest.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr const char *logDir = "/test_logrotate";
+constexpr const char *firstLog = "/test_logrotate/log_000001.log";
+constexpr const char *secondLog = "/test_logrotate/log_000002.log";
+
+std::string messageText(int i)
+{
+    return "message #" + std::to_string(i) + " " + std::string((i * 37) % 150, 'x');
+}
+
+void writeMessage(LogRotate &log, int i)
+{
+    std::string text = messageText(i);
+    log.write(LogMessageEnv(0x1000 + i, UINT32_MAX, i % 8, 1000 + i, LogMessage::eDefault, false, text.size(),
+                            (const uint8_t *)text.c_str()));
+}
+
+std::vector<std::string> readMessages(LogRotate &log)
+{
+    std::vector<std::string> result;
+    LogMessageEnv msg;
+    while (log.readNext(msg))
+        result.push_back((const char *)msg.bytes);
+    return result;
+}
+} // namespace
+
+TEST_CASE("LogRotate::recovery")
+{
+    fs::FS &fs = testFileSystem();
+    removeDir(fs, logDir);
+
+    // write messages and remember where each record ends
+    constexpr int numMessages = 12;
+    std::vector<size_t> recordEnd;
+    {
+        LogRotate log(fs, logDir, sizeof(LogMessage));
+        log.init();
+        for (int i = 0; i < numMessages; i++) {
+            writeMessage(log, i);
+            recordEnd.push_back(readFile(fs, firstLog).size());
+        }
+    }
+    const std::vector<uint8_t> image = readFile(fs, firstLog);
+    REQUIRE(image.size() == recordEnd.back());
+
+    SUBCASE("all records are read back")
+    {
+        LogRotate log(fs, logDir, sizeof(LogMessage));
+        log.init();
+        auto messages = readMessages(log);
+        REQUIRE(messages.size() == numMessages);
+        for (int i = 0; i < numMessages; i++)
+            CHECK(messages[i] == messageText(i));
+    }
+
+    SUBCASE("torn write at every byte offset")
+    {
+        for (size_t offset = 0; offset <= image.size(); offset++) {
+            CAPTURE(offset);
+            writeFile(fs, firstLog, image.data(), offset);
+
+            size_t complete = 0;
+            while (complete < recordEnd.size() && recordEnd[complete] <= offset)
+                complete++;
+
+            {
+                LogRotate log(fs, logDir, sizeof(LogMessage));
+                log.init();
+                CHECK(readFile(fs, firstLog).size() == (complete ? recordEnd[complete - 1] : 0));
+                auto messages = readMessages(log);
+                REQUIRE(messages.size() == complete);
+                for (size_t i = 0; i < complete; i++)
+                    CHECK(messages[i] == messageText(i));
+
+                // the recovered log must accept new records
+                writeMessage(log, 100);
+            }
+            {
+                LogRotate log(fs, logDir, sizeof(LogMessage));
+                log.init();
+                auto messages = readMessages(log);
+                REQUIRE(messages.size() == complete + 1);
+                CHECK(messages.back() == messageText(100));
+            }
+        }
+    }
+
+    SUBCASE("corrupted last record is dropped")
+    {
+        std::vector<uint8_t> corrupted = image;
+        corrupted[image.size() - 5] ^= 0x55;
+        writeFile(fs, firstLog, corrupted.data(), corrupted.size());
+
+        LogRotate log(fs, logDir, sizeof(LogMessage));
+        log.init();
+        CHECK(readFile(fs, firstLog).size() == recordEnd[numMessages - 2]);
+        CHECK(readMessages(log).size() == numMessages - 1);
+    }
+
+    SUBCASE("foreign files in the log folder are ignored")
+    {
+        const uint8_t garbage[] = "garbage";
+        writeFile(fs, "/test_logrotate/log_000003.log.bak", garbage, sizeof(garbage));
+        writeFile(fs, "/test_logrotate/recover.tmp", garbage, sizeof(garbage));
+
+        LogRotate log(fs, logDir, sizeof(LogMessage));
+        log.init();
+        CHECK(log.count() == 1);
+        CHECK(log.size() == image.size());
+        CHECK_FALSE(fs.exists("/test_logrotate/recover.tmp"));
+        CHECK(readMessages(log).size() == numMessages);
+    }
+
+    removeDir(fs, logDir);
+}
+
+TEST_CASE("LogRotate::legacy")
+{
+    fs::FS &fs = testFileSystem();
+    removeDir(fs, logDir);
+    fs.mkdir(logDir);
+
+    // log file written without record headers
+    {
+        File file = fs.open(firstLog, FILE_WRITE);
+        for (int i = 0; i < 3; i++) {
+            std::string text = messageText(i);
+            LogMessageEnv msg(0x1000, UINT32_MAX, 0, 1000 + i, LogMessage::eDefault, false, text.size(),
+                              (const uint8_t *)text.c_str());
+            msg.serialize([&file](const uint8_t *buf, size_t size) { return file.write(buf, size); });
+        }
+        file.close();
+    }
+    size_t legacySize = readFile(fs, firstLog).size();
+
+    {
+        LogRotate log(fs, logDir, sizeof(LogMessage));
+        log.init();
+        CHECK(readFile(fs, firstLog).size() == legacySize);
+        writeMessage(log, 3);
+    }
+
+    // new records are never appended to a legacy log
+    CHECK(readFile(fs, firstLog).size() == legacySize);
+    CHECK(fs.exists(secondLog));
+
+    LogRotate log(fs, logDir, sizeof(LogMessage));
+    log.init();
+    auto messages = readMessages(log);
+    REQUIRE(messages.size() == 4);
+    for (int i = 0; i < 4; i++)
+        CHECK(messages[i] == messageText(i));
+
+    removeDir(fs, logDir);
+}
+
+TEST_CASE("LogRotate::compression")
+{
+    fs::FS &fs = testFileSystem();
+    removeDir(fs, logDir);
+
+    constexpr int numMessages = 300;
+    uint32_t compressedSize = 0;
+    {
+        LogRotate log(fs, logDir, sizeof(LogMessage), 400000, 100, 4000, true);
+        log.init();
+        for (int i = 0; i < numMessages; i++)
+            writeMessage(log, i);
+        compressedSize = log.size();
+    }
+
+    // all but the current file are compressed segments
+    std::vector<std::string> names;
+    for (int num = 1;; num++) {
+        char name[40];
+        sprintf(name, "%s/log_%06d.log", logDir, num);
+        if (!fs.exists(name))
+            break;
+        names.push_back(name);
+    }
+    REQUIRE(names.size() > 2);
+    for (size_t i = 0; i < names.size(); i++) {
+        std::vector<uint8_t> data = readFile(fs, names[i].c_str());
+        REQUIRE(data.size() > 2);
+        CHECK((data[0] == 'L' && data[1] == 'Z') == (i + 1 < names.size()));
+    }
+
+    SUBCASE("round trip")
+    {
+        LogRotate log(fs, logDir, sizeof(LogMessage), 400000, 100, 4000, true);
+        log.init();
+        CHECK(log.size() == compressedSize);
+        auto messages = readMessages(log);
+        REQUIRE(messages.size() == numMessages);
+        for (int i = 0; i < numMessages; i++)
+            CHECK(messages[i] == messageText(i));
+
+        // appending after restart continues in the uncompressed current file
+        writeMessage(log, 1000);
+        CHECK(readFile(fs, names.back().c_str())[0] == 'L');
+        CHECK(readFile(fs, names.back().c_str())[1] == 'M');
+    }
+
+    SUBCASE("partial segment")
+    {
+        std::vector<uint8_t> segment = readFile(fs, names[1].c_str());
+        for (size_t cut : {segment.size() - 1, segment.size() / 2, (size_t)9, (size_t)3}) {
+            CAPTURE(cut);
+            writeFile(fs, names[1].c_str(), segment.data(), cut);
+
+            LogRotate log(fs, logDir, sizeof(LogMessage), 400000, 100, 4000, true);
+            log.init();
+            auto messages = readMessages(log);
+            CHECK(messages.size() < numMessages);
+
+            // the readable records of the damaged segment are followed by all records of the next files
+            size_t i = 0, expected = 0;
+            while (i < messages.size() && messages[i] == messageText(expected))
+                i++, expected++;
+            while (expected < numMessages && messageText(expected) != messages[i])
+                expected++;
+            while (i < messages.size() && expected < numMessages && messages[i] == messageText(expected))
+                i++, expected++;
+            CHECK(i == messages.size());
+            CHECK(expected == numMessages);
+        }
+    }
+
+    removeDir(fs, logDir);
+}
+
+TEST_CASE("LogRotate::positions")
+{
+    fs::FS &fs = testFileSystem();
+    removeDir(fs, logDir);
+
+    // each record is read back between the positions the log ended at before and after it was written
+    // (at the start of the next file if writing it rotated the log)
+    constexpr int numMessages = 300;
+    std::vector<LogRotate::Position> positions;
+    LogRotate::Position end = 0;
+    {
+        LogRotate log(fs, logDir, sizeof(LogMessage), 400000, 100, 4000, true);
+        log.init();
+        for (int i = 0; i < numMessages; i++) {
+            positions.push_back(log.endPosition());
+            writeMessage(log, i);
+            CHECK(log.endPosition() > positions.back());
+        }
+        end = log.endPosition();
+    }
+
+    LogRotate log(fs, logDir, sizeof(LogMessage), 400000, 100, 4000, true);
+    log.init();
+    CHECK(log.endPosition() == end);
+    CHECK(log.startPosition() <= positions.front());
+    LogMessageEnv msg;
+    for (int i = 0; i < numMessages; i++) {
+        CAPTURE(i);
+        REQUIRE(log.readNext(msg));
+        CHECK(log.readPosition() >= positions[i]);
+        CHECK(log.readPosition() < (i + 1 < numMessages ? positions[i + 1] : end));
+        if (log.readPosition() != positions[i])
+            CHECK(log.readPosition() == ((positions[i] >> 32) + 1) << 32);
+    }
+    CHECK_FALSE(log.readNext(msg));
+
+    // clearing starts over
+    log.clear();
+    CHECK(log.endPosition() < end);
+    CHECK(log.endPosition() == log.startPosition());
+
+    removeDir(fs, logDir);
+}
+
+#if defined(__linux__)
+TEST_CASE("LogRotate::mapped")
+{
+    fs::FS &fs = testFileSystem();
+    removeDir(fs, logDir);
+    const char *mountpoint = portduinoVFS->mountpoint();
+
+    // uncompressed log with a current file
+    {
+        LogRotate log(fs, logDir, sizeof(LogMessage));
+        log.init();
+        for (int i = 0; i < 5; i++)
+            writeMessage(log, i);
+    }
+
+    SUBCASE("all formats are read from mapped files")
+    {
+        removeDir(fs, logDir);
+        {
+            LogRotate log(fs, logDir, sizeof(LogMessage), 400000, 100, 4000, true);
+            log.init();
+            for (int i = 0; i < 100; i++)
+                writeMessage(log, i);
+        }
+        for (bool map : {false, true}) {
+            CAPTURE(map);
+            LogRotate log(fs, logDir, sizeof(LogMessage), 400000, 100, 4000, true);
+            log.init();
+            if (map)
+                log.mapFiles(mountpoint);
+            auto messages = readMessages(log);
+            REQUIRE(messages.size() == 100);
+            for (int i = 0; i < 100; i++)
+                CHECK(messages[i] == messageText(i));
+        }
+    }
+
+    SUBCASE("current file grows while mapped")
+    {
+        LogRotate log(fs, logDir, sizeof(LogMessage));
+        log.init();
+        log.mapFiles(mountpoint);
+
+        std::vector<std::string> messages;
+        LogMessageEnv msg;
+        for (int i = 0; i < 2 && log.readNext(msg); i++)
+            messages.push_back((const char *)msg.bytes);
+        for (int i = 5; i < 8; i++)
+            writeMessage(log, i);
+        while (log.readNext(msg))
+            messages.push_back((const char *)msg.bytes);
+
+        REQUIRE(messages.size() == 8);
+        for (int i = 0; i < 8; i++)
+            CHECK(messages[i] == messageText(i));
+    }
+
+    SUBCASE("fallback to fs if the files cannot be mapped")
+    {
+        LogRotate log(fs, logDir, sizeof(LogMessage));
+        log.init();
+        log.mapFiles("/nonexistent");
+        CHECK(readMessages(log).size() == 5);
+    }
+
+    removeDir(fs, logDir);
+}
+#endif
@@ -0,0 +1,108 @@
+#include "util/Lzss.h"
+#include <doctest/doctest.h>
+#include <algorithm>
+#include <random>
+#include <string.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+// decompress with reads of chunk bytes and a source that delivers at most feed bytes per call
+std::vector<uint8_t> decompress(const std::vector<uint8_t> &compressed, uint32_t rawSize, size_t chunk, size_t feed)
+{
+    size_t pos = 0;
+    Lzss::Decoder decoder(
+        [&](uint8_t *buf, size_t len) {
+            len = std::min({len, feed, compressed.size() - pos});
+            memcpy(buf, &compressed[pos], len);
+            pos += len;
+            return len;
+        },
+        rawSize);
+
+    std::vector<uint8_t> result;
+    std::vector<uint8_t> buf(chunk);
+    size_t len;
+    while ((len = decoder.read(buf.data(), chunk)) > 0)
+        result.insert(result.end(), buf.begin(), buf.begin() + len);
+    CHECK(decoder.position() == result.size());
+    return result;
+}
+
+void roundTrip(const std::vector<uint8_t> &data)
+{
+    std::vector<uint8_t> compressed;
+    Lzss::compress(data.data(), data.size(), compressed);
+    for (size_t chunk : {1, 7, 64, 4096}) {
+        for (size_t feed : {1, 5, 64}) {
+            CAPTURE(chunk);
+            CAPTURE(feed);
+            CHECK(decompress(compressed, data.size(), chunk, feed) == data);
+        }
+    }
+}
+} // namespace
+
+TEST_CASE("Lzss::roundtrip")
+{
+    SUBCASE("empty") { roundTrip({}); }
+
+    SUBCASE("single byte") { roundTrip({42}); }
+
+    SUBCASE("text")
+    {
+        std::string text;
+        for (int i = 0; i < 100; i++)
+            text += "Hello from node " + std::to_string(i % 7) + ", is anybody out there? ";
+        std::vector<uint8_t> data(text.begin(), text.end());
+        roundTrip(data);
+
+        std::vector<uint8_t> compressed;
+        Lzss::compress(data.data(), data.size(), compressed);
+        CHECK(compressed.size() < data.size() / 3);
+    }
+
+    SUBCASE("runs and window distances")
+    {
+        std::vector<uint8_t> data(10000, 'a');
+        for (size_t i = 0; i < data.size(); i += Lzss::c_windowSize - 1)
+            data[i] = 'b';
+        for (size_t i = 0; i < 300; i++)
+            data[Lzss::c_windowSize + i] = data[i + 1]; // back reference at the window limit
+        roundTrip(data);
+    }
+
+    SUBCASE("random data")
+    {
+        std::mt19937 rnd(1);
+        std::vector<uint8_t> data(5000);
+        for (auto &b : data)
+            b = rnd();
+        roundTrip(data);
+
+        // incompressible data grows by one flag byte per 8 literals at most
+        std::vector<uint8_t> compressed;
+        Lzss::compress(data.data(), data.size(), compressed);
+        CHECK(compressed.size() <= data.size() + (data.size() + 7) / 8);
+    }
+}
+
+TEST_CASE("Lzss::partial stream")
+{
+    std::string text;
+    for (int i = 0; i < 50; i++)
+        text += "message " + std::to_string(i) + " with some repeated content; ";
+    std::vector<uint8_t> data(text.begin(), text.end());
+    std::vector<uint8_t> compressed;
+    Lzss::compress(data.data(), data.size(), compressed);
+
+    // every truncated stream decodes to a prefix of the original data
+    for (size_t cut = 0; cut < compressed.size(); cut++) {
+        CAPTURE(cut);
+        std::vector<uint8_t> partial(compressed.begin(), compressed.begin() + cut);
+        std::vector<uint8_t> result = decompress(partial, data.size(), 33, 64);
+        REQUIRE(result.size() < data.size());
+        CHECK(std::equal(result.begin(), result.end(), data.begin()));
+    }
+}
@@ -0,0 +1,96 @@
+#include "util/MappedFile.h"
+#include <doctest/doctest.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+#if defined(__linux__)
+namespace
+{
+std::string tempName(void)
+{
+    const char *tmp = getenv("TMPDIR");
+    return std::string(tmp ? tmp : "/tmp") + "/device-ui-mappedfile.bin";
+}
+
+void append(const std::string &name, const std::string &data)
+{
+    FILE *f = fopen(name.c_str(), "ab");
+    fwrite(data.data(), 1, data.size(), f);
+    fclose(f);
+}
+} // namespace
+
+TEST_CASE("MappedFile")
+{
+    std::string name = tempName();
+    remove(name.c_str());
+
+    SUBCASE("missing file")
+    {
+        MappedFile file;
+        CHECK_FALSE(file.open(name.c_str()));
+        CHECK_FALSE(file.isOpen());
+    }
+
+    SUBCASE("small file is read")
+    {
+        std::string content = "0123456789";
+        append(name, content);
+        MappedFile file;
+        REQUIRE(file.open(name.c_str()));
+        CHECK_FALSE(file.isMapped());
+        CHECK(std::string((const char *)file.data(), file.size()) == content);
+        append(name, "abc");
+        REQUIRE(file.refresh());
+        CHECK(std::string((const char *)file.data(), file.size()) == content + "abc");
+    }
+
+    SUBCASE("empty file")
+    {
+        append(name, "");
+        MappedFile file;
+        REQUIRE(file.open(name.c_str()));
+        CHECK(file.size() == 0);
+        CHECK_FALSE(file.refresh());
+    }
+
+    SUBCASE("file grows while mapped")
+    {
+        std::string content(MappedFile::c_minMapSize + 100, 'a');
+        append(name, content);
+        MappedFile file;
+        REQUIRE(file.open(name.c_str()));
+        CHECK(file.isMapped());
+        REQUIRE(file.size() == content.size());
+        CHECK(std::string((const char *)file.data(), file.size()) == content);
+        CHECK_FALSE(file.refresh());
+
+        // crosses a page boundary
+        for (int i = 0; i < 3; i++) {
+            std::string more = std::string(3000, 'b' + i);
+            append(name, more);
+            content += more;
+            CHECK(file.size() == content.size() - more.size());
+            REQUIRE(file.refresh());
+            REQUIRE(file.size() == content.size());
+            CHECK(std::string((const char *)file.data(), file.size()) == content);
+        }
+
+        // the view stays valid when the file is replaced
+        std::string replacement = name + ".new";
+        FILE *f = fopen(replacement.c_str(), "wb");
+        fputs("other", f);
+        fclose(f);
+        REQUIRE(rename(replacement.c_str(), name.c_str()) == 0);
+        CHECK(std::string((const char *)file.data(), file.size()) == content);
+        CHECK_FALSE(file.refresh());
+
+        file.close();
+        CHECK_FALSE(file.isOpen());
+        CHECK(file.size() == 0);
+    }
+
+    remove(name.c_str());
+}
+#endif
@@ -0,0 +1,183 @@
+#include "util/MessageRestorer.h"
+#include <doctest/doctest.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr uint32_t ownNode = 0x1000;
+
+struct Record {
+    uint32_t from;
+    uint32_t to;
+    uint8_t ch;
+    bool trash;
+    std::string text;
+};
+
+// in-memory replacement for LogRotate::readNext()
+class RecordReader
+{
+  public:
+    explicit RecordReader(const std::vector<Record> &records) : records(records) {}
+    bool operator()(LogMessageEnv &msg)
+    {
+        if (pos >= records.size())
+            return false;
+        const Record &r = records[pos++];
+        msg._size = r.text.size();
+        msg.time = pos;
+        msg.from = r.from;
+        msg.to = r.to;
+        msg.ch = r.ch;
+        msg.status = LogMessage::eDefault;
+        msg.trashFlag = r.trash;
+        memcpy(msg.bytes, r.text.c_str(), r.text.size() + 1);
+        return true;
+    }
+
+  private:
+    const std::vector<Record> &records;
+    size_t pos = 0;
+};
+
+struct Restored {
+    std::string text;
+    bool live;
+    bool logged;
+};
+
+std::vector<Restored> restoreAll(MessageRestorer &restorer)
+{
+    std::vector<Restored> result;
+    while (!restorer.restore(
+        [&](const LogMessage &msg, bool live, bool logged) { result.push_back({(const char *)msg.bytes, live, logged}); }, 0))
+        ;
+    return result;
+}
+
+void queueLive(MessageRestorer &restorer, uint32_t from, uint32_t to, uint8_t ch, const char *text, bool logged = false)
+{
+    restorer.queueLive(from, to, ch, 0, strlen(text), (const uint8_t *)text, logged);
+}
+} // namespace
+
+TEST_CASE("MessageRestorer::restore")
+{
+    MessageRestorer restorer(3);
+    restorer.begin(ownNode);
+
+    SUBCASE("empty log")
+    {
+        std::vector<Record> records;
+        CHECK(restorer.load(RecordReader(records), 16));
+        CHECK(restorer.loaded());
+        CHECK(restoreAll(restorer).empty());
+        CHECK(restorer.done());
+    }
+
+    SUBCASE("messages are restored in log order across chats")
+    {
+        std::vector<Record> records = {{0x2000, UINT32_MAX, 0, false, "c0-1"},
+                                       {0x2000, ownNode, 0, false, "dm-1"},
+                                       {ownNode, UINT32_MAX, 1, false, "c1-1"},
+                                       {ownNode, 0x2000, 0, false, "dm-2"},
+                                       {0x3000, UINT32_MAX, 0, false, "c0-2"}};
+        RecordReader reader(records);
+        CHECK_FALSE(restorer.load(std::ref(reader), 2));
+        CHECK_FALSE(restorer.load(std::ref(reader), 2));
+        CHECK(restorer.load(std::ref(reader), 2));
+        CHECK(restorer.recordsRead() == 5);
+
+        auto result = restoreAll(restorer);
+        REQUIRE(result.size() == 5);
+        for (size_t i = 0; i < records.size(); i++) {
+            CHECK(result[i].text == records[i].text);
+            CHECK_FALSE(result[i].live);
+        }
+        CHECK(restorer.progress() == 100);
+    }
+
+    SUBCASE("only the newest messages per chat are restored")
+    {
+        std::vector<Record> records;
+        for (int i = 0; i < 10; i++) {
+            records.push_back({0x2000, UINT32_MAX, 0, false, "c0-" + std::to_string(i)});
+            if (i < 2)
+                records.push_back({0x2000, ownNode, 0, false, "dm-" + std::to_string(i)});
+        }
+        restorer.load(RecordReader(records), 100);
+        CHECK(restorer.staged() == 5);
+
+        auto result = restoreAll(restorer);
+        REQUIRE(result.size() == 5);
+        CHECK(result[0].text == "dm-0");
+        CHECK(result[1].text == "dm-1");
+        CHECK(result[2].text == "c0-7");
+        CHECK(result[3].text == "c0-8");
+        CHECK(result[4].text == "c0-9");
+    }
+
+    SUBCASE("trashed chats are dropped")
+    {
+        std::vector<Record> records = {{0x2000, UINT32_MAX, 2, false, "c2-1"},
+                                       {0x2000, ownNode, 0, false, "dm-1"},
+                                       {ownNode, UINT32_MAX, 2, true, ""},
+                                       {ownNode, 0x2000, 0, true, ""},
+                                       {0x2000, UINT32_MAX, 2, false, "c2-2"}};
+        restorer.load(RecordReader(records), 100);
+        auto result = restoreAll(restorer);
+        REQUIRE(result.size() == 1);
+        CHECK(result[0].text == "c2-2");
+    }
+
+    SUBCASE("live messages are merged in order after the stored ones")
+    {
+        std::vector<Record> records = {{0x2000, UINT32_MAX, 0, false, "stored-1"},
+                                       {0x2000, UINT32_MAX, 0, false, "stored-2"},
+                                       {0x2000, UINT32_MAX, 0, false, "stored-3"}};
+        RecordReader reader(records);
+        queueLive(restorer, 0x2000, UINT32_MAX, 0, "live-1");
+        restorer.load(std::ref(reader), 1);
+        queueLive(restorer, 0x3000, ownNode, 0, "live-2");
+        restorer.load(std::ref(reader), 100);
+
+        std::vector<Restored> result;
+        auto collect = [&](const LogMessage &msg, bool live, bool logged) {
+            result.push_back({(const char *)msg.bytes, live, logged});
+        };
+        // budget 0 hands out one message per call
+        CHECK_FALSE(restorer.restore(collect, 0));
+        queueLive(restorer, 0x2000, UINT32_MAX, 0, "live-3");
+        while (!restorer.restore(collect, 0))
+            ;
+        queueLive(restorer, 0x2000, UINT32_MAX, 0, "live-4");
+        CHECK(restorer.restore(collect, 0));
+
+        const char *expected[] = {"stored-1", "stored-2", "stored-3", "live-1", "live-2", "live-3", "live-4"};
+        REQUIRE(result.size() == 7);
+        for (size_t i = 0; i < result.size(); i++) {
+            CHECK(result[i].text == expected[i]);
+            CHECK(result[i].live == (i >= 3));
+        }
+        CHECK(restorer.done());
+    }
+
+    SUBCASE("live messages are never dropped")
+    {
+        std::vector<Record> records;
+        for (int i = 0; i < 500; i++)
+            queueLive(restorer, 0x2000, UINT32_MAX, 0, std::to_string(i).c_str());
+        CHECK(restorer.queued() == 500);
+        restorer.load(RecordReader(records), 100);
+        // logged right away after the log has been read
+        queueLive(restorer, 0x2000, UINT32_MAX, 0, "500", true);
+        auto result = restoreAll(restorer);
+        REQUIRE(result.size() == 501);
+        for (int i = 0; i <= 500; i++) {
+            CHECK(result[i].text == std::to_string(i));
+            CHECK(result[i].logged == (i == 500));
+        }
+    }
+}
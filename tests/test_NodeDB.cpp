@@ -0,0 +1,107 @@
+#include "util/NodeDB.h"
+#include <doctest/doctest.h>
+#include <map>
+#include <random>
+#include <string.h>
+
+TEST_CASE("NodeDB::model")
+{
+    NodeDB db;
+
+    SUBCASE("add, update and find")
+    {
+        uint32_t slot = db.add(0x1234);
+        CHECK(db.size() == 1);
+        CHECK(db.add(0x1234) == slot);
+        CHECK(db.find(0x1234) == slot);
+        CHECK(db.find(0x4321) == NodeDB::c_noSlot);
+
+        // defaults
+        CHECK(db.role(slot) == NodeDB::c_unknownRole);
+        CHECK(db.hopsAway(slot) == -1);
+        CHECK(db.lastHeard(slot) == 0);
+        CHECK_FALSE(db.hasFlag(slot, NodeDB::eHasPosition));
+
+        db.setNames(slot, "ABCDEFG", "a very long name that does not fit into the long name column at all");
+        CHECK(strcmp(db.shortName(slot), "ABCD") == 0);
+        CHECK(strlen(db.longName(slot)) == NodeDB::c_longNameLen - 1);
+        db.setNames(slot, nullptr, "long");
+        CHECK(strcmp(db.shortName(slot), "ABCD") == 0);
+        CHECK(strcmp(db.longName(slot), "long") == 0);
+
+        db.setPosition(slot, 473000000, 85000000);
+        CHECK(db.hasFlag(slot, NodeDB::eHasPosition));
+        CHECK(db.latitude(slot) == 473000000);
+        CHECK(db.longitude(slot) == 85000000);
+
+        db.setFlag(slot, NodeDB::eHasKey, true);
+        db.setFlag(slot, NodeDB::eKeyMismatch, true);
+        db.setFlag(slot, NodeDB::eKeyMismatch, false);
+        CHECK(db.hasFlag(slot, NodeDB::eHasKey));
+        CHECK_FALSE(db.hasFlag(slot, NodeDB::eKeyMismatch));
+    }
+
+    SUBCASE("removal keeps the store dense")
+    {
+        for (uint32_t i = 1; i <= 5; i++) {
+            uint32_t slot = db.add(i * 0x100);
+            db.setLastHeard(slot, i);
+        }
+        CHECK(db.remove(0x200));
+        CHECK_FALSE(db.remove(0x200));
+        CHECK(db.size() == 4);
+        // last node moved into the gap
+        uint32_t slot = db.find(0x500);
+        CHECK(slot == 1);
+        CHECK(db.lastHeard(slot) == 5);
+        CHECK(db.num(slot) == 0x500);
+    }
+
+    SUBCASE("sorted by last heard and online count")
+    {
+        uint32_t lastHeard[] = {100, 300, 0, 200, 300};
+        for (uint32_t i = 0; i < 5; i++)
+            db.setLastHeard(db.add(i + 1), lastHeard[i]);
+        std::vector<uint32_t> expected = {2, 5, 4, 1, 3};
+        CHECK(db.sortedByLastHeard() == expected);
+        CHECK(db.countOnline(350, 150) == 3);
+        CHECK(db.countOnline(350, 1000) == 4); // never heard nodes are offline
+    }
+}
+
+TEST_CASE("NodeDB::consistency")
+{
+    // random add/remove/update against a reference model, with clustered node numbers
+    std::mt19937 rnd(1);
+    NodeDB db;
+    std::map<uint32_t, uint32_t> model; // nodeNum -> lastHeard
+    for (int i = 0; i < 20000; i++) {
+        uint32_t nodeNum = rnd() % 2 ? rnd() % 3000 : 0xdead0000 + (rnd() % 64) * 1024;
+        uint32_t op = rnd() % 10;
+        if (op < 5) {
+            uint32_t slot = db.add(nodeNum);
+            db.setLastHeard(slot, i);
+            model[nodeNum] = i;
+        } else if (op < 8) {
+            CHECK(db.remove(nodeNum) == (model.erase(nodeNum) == 1));
+        } else {
+            uint32_t slot = db.find(nodeNum);
+            REQUIRE((slot != NodeDB::c_noSlot) == (model.count(nodeNum) == 1));
+            if (slot != NodeDB::c_noSlot)
+                CHECK(db.lastHeard(slot) == model[nodeNum]);
+        }
+        if (i % 5000 == 4999) {
+            REQUIRE(db.size() == model.size());
+            for (auto &it : model) {
+                uint32_t slot = db.find(it.first);
+                REQUIRE(slot != NodeDB::c_noSlot);
+                CHECK(db.num(slot) == it.first);
+                CHECK(db.lastHeard(slot) == it.second);
+            }
+        }
+    }
+
+    db.clear();
+    CHECK(db.size() == 0);
+    CHECK(db.find(model.begin()->first) == NodeDB::c_noSlot);
+}
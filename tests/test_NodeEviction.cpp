@@ -0,0 +1,217 @@
+#include "util/NodeEviction.h"
+#include "util/NodeList.h"
+#include <algorithm>
+#include <doctest/doctest.h>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace
+{
+struct Node {
+    uint32_t lastHeard;
+    bool unknown;
+    bool pinned;
+};
+
+// the eviction policy as a linear scan over the nodes ordered newest first (like the node panel)
+uint32_t referenceVictim(const std::map<uint32_t, Node> &nodes, time_t now, uint32_t except)
+{
+    std::vector<std::pair<uint32_t, uint32_t>> order;
+    for (auto &it : nodes)
+        order.push_back({it.second.lastHeard, it.first});
+    std::sort(order.rbegin(), order.rend());
+
+    size_t newest = order.size() / 5;
+    for (size_t i = order.size(); i-- > newest;) {
+        const Node &n = nodes.at(order[i].second);
+        if (order[i].second == except || !n.unknown || n.pinned)
+            continue;
+        if (now >= (time_t)n.lastHeard + NodeEviction::c_freshSecs)
+            return order[i].second;
+        break;
+    }
+    for (int pass = 0; pass < 3; pass++) {
+        for (size_t i = order.size(); i-- > 0;) {
+            const Node &n = nodes.at(order[i].second);
+            bool match = pass == 0 ? !n.pinned && !n.unknown : pass == 1 ? !n.pinned && n.unknown : n.pinned;
+            if (match && order[i].second != except)
+                return order[i].second;
+        }
+    }
+    return NodeEviction::c_none;
+}
+} // namespace
+
+TEST_CASE("NodeEviction::policy")
+{
+    NodeEviction ev;
+    const time_t now = 10000;
+
+    SUBCASE("empty")
+    {
+        CHECK(ev.victim(now) == NodeEviction::c_none);
+        CHECK(ev.oldest() == NodeEviction::c_none);
+    }
+
+    SUBCASE("old unknown nodes go first")
+    {
+        for (uint32_t i = 1; i <= 10; i++)
+            ev.add(i, 1000 + i * 100, false);
+        ev.add(100, 1500, true);
+        ev.add(101, 1200, true);
+        CHECK(ev.victim(now) == 101);
+        CHECK(ev.oldest() == 1);
+        ev.remove(101);
+        CHECK(ev.victim(now) == 100);
+        CHECK(ev.victim(now, 100) == 1); // the node being added is never evicted
+    }
+
+    SUBCASE("fresh unknown nodes are kept")
+    {
+        for (uint32_t i = 1; i <= 10; i++)
+            ev.add(i, now - 50 + i, false);
+        ev.add(100, now - 60, true);
+        CHECK(ev.victim(now) == 1);
+        CHECK(ev.victim(now + 60) == 100);
+    }
+
+    SUBCASE("unknown nodes among the newest 20% are kept")
+    {
+        for (uint32_t i = 1; i <= 9; i++)
+            ev.add(i, 1000 + i, false);
+        ev.add(100, 5000, true); // newest of 10 nodes
+        CHECK(ev.victim(now) == 1);
+        ev.add(101, 6000, false); // 11 nodes: 100 is second newest, still within 20%
+        CHECK(ev.victim(now) == 1);
+        ev.add(102, 7000, false); // 12 nodes: 100 is third newest
+        CHECK(ev.victim(now) == 100);
+        ev.setLastHeard(102, 1);
+        CHECK(ev.victim(now) == 102); // 100 is second newest again, 102 is the oldest named node
+    }
+
+    SUBCASE("chat-pinned nodes are evicted last")
+    {
+        ev.add(1, 100, true, true);
+        ev.add(2, 200, false, true);
+        ev.add(3, 300, true);
+        ev.add(4, now - 10, true);
+        ev.add(5, 400, false);
+        CHECK(ev.victim(now) == 3);
+        ev.remove(3);
+        CHECK(ev.victim(now) == 5);
+        ev.remove(5);
+        CHECK(ev.victim(now) == 4); // fresh, but only pinned nodes are left otherwise
+        ev.remove(4);
+        CHECK(ev.victim(now) == 1);
+        ev.setPinned(1, false);
+        ev.setUnknown(2, true);
+        ev.setPinned(2, false);
+        CHECK(ev.victim(now) == 1);
+        CHECK(ev.oldest(1) == 2);
+    }
+
+    SUBCASE("role change moves the node between indexes")
+    {
+        for (uint32_t i = 1; i <= 10; i++)
+            ev.add(i, 1000 + i, false);
+        ev.add(100, 500, true);
+        CHECK(ev.victim(now) == 100);
+        ev.setUnknown(100, false);
+        CHECK(ev.victim(now) == 100); // still the oldest
+        ev.add(100, 2000, false);
+        CHECK(ev.victim(now) == 1);
+        CHECK(ev.size() == 11);
+        ev.clear();
+        CHECK(ev.size() == 0);
+        CHECK_FALSE(ev.contains(1));
+    }
+}
+
+TEST_CASE("NodeEviction::consistency")
+{
+    // random add/remove/update against the linear reference scan
+    std::mt19937 rnd(3);
+    NodeEviction ev;
+    std::map<uint32_t, Node> nodes;
+    time_t now = 1000;
+    for (int i = 0; i < 20000; i++) {
+        now += rnd() % 20;
+        uint32_t nodeNum = rnd() % 300;
+        uint32_t op = rnd() % 10;
+        if (op < 4) {
+            Node n{uint32_t(rnd() % 4 ? now - rnd() % 2000 : 0), rnd() % 3 == 0, rnd() % 10 == 0};
+            ev.add(nodeNum, n.lastHeard, n.unknown, n.pinned);
+            nodes[nodeNum] = n;
+        } else if (op < 6) {
+            ev.remove(nodeNum);
+            nodes.erase(nodeNum);
+        } else if (op < 8) {
+            ev.setLastHeard(nodeNum, now);
+            if (nodes.count(nodeNum))
+                nodes[nodeNum].lastHeard = now;
+        } else if (op < 9) {
+            bool pinned = rnd() % 2;
+            ev.setPinned(nodeNum, pinned);
+            if (nodes.count(nodeNum))
+                nodes[nodeNum].pinned = pinned;
+        } else {
+            bool unknown = rnd() % 2;
+            ev.setUnknown(nodeNum, unknown);
+            if (nodes.count(nodeNum))
+                nodes[nodeNum].unknown = unknown;
+        }
+
+        REQUIRE(ev.size() == nodes.size());
+        uint32_t except = rnd() % 300;
+        CHECK(ev.victim(now, except) == referenceVictim(nodes, now, except));
+    }
+}
+
+TEST_CASE("NodeEviction::capped node list")
+{
+    // nodes streamed in like TFTView_Common::addNode() / purgeNode() do with MAX_NUM_NODES_VIEW
+    constexpr uint32_t cap = 250;
+    constexpr uint32_t ownNode = 1;
+    std::mt19937 rnd(7);
+    NodeList list;
+    NodeEviction ev;
+    list.setPinned(ownNode);
+    list.add(ownNode, 0);
+    std::vector<uint32_t> chatPartners = {0x100, 0x101, 0x102};
+    for (uint32_t nodeNum : chatPartners) {
+        list.add(nodeNum, 500);
+        ev.add(nodeNum, 500, true, true);
+    }
+
+    time_t now = 1000;
+    for (uint32_t nodeNum = 0x1000; nodeNum < 0x1000 + 5000; nodeNum++) {
+        now += rnd() % 3;
+        uint32_t lastHeard = now - rnd() % 600;
+        while (list.size() >= cap) {
+            uint32_t victim = ev.victim(now, nodeNum);
+            REQUIRE(victim != NodeEviction::c_none);
+            REQUIRE(list.remove(victim));
+            ev.remove(victim);
+        }
+        list.add(nodeNum, lastHeard);
+        ev.add(nodeNum, lastHeard, rnd() % 3 == 0);
+        if (rnd() % 4 == 0) {
+            uint32_t heard = list.all()[rnd() % list.size()];
+            list.moveToTop(heard, now);
+            ev.setLastHeard(heard, now);
+        }
+
+        REQUIRE(list.size() <= cap);
+        REQUIRE(ev.size() == list.size() - 1); // all but the own node
+    }
+
+    CHECK(list.size() == cap);
+    CHECK(list.contains(ownNode));
+    CHECK_FALSE(ev.contains(ownNode));
+    for (uint32_t nodeNum : chatPartners)
+        CHECK(list.contains(nodeNum));
+    for (uint32_t nodeNum : list.all())
+        CHECK((nodeNum == ownNode || ev.contains(nodeNum)));
+    CHECK(list.contains(0x1000 + 4999));
+}
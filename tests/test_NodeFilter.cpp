@@ -0,0 +1,150 @@
+#include "util/NodeFilter.h"
+#include <doctest/doctest.h>
+#include <map>
+#include <random>
+#include <string>
+
+namespace
+{
+std::string norm(const char *s)
+{
+    std::string out;
+    NodeFilter::normalize(s, out);
+    return out;
+}
+
+std::map<uint32_t, bool> visibility(const NodeFilter &filter)
+{
+    std::map<uint32_t, bool> result;
+    filter.apply([&](uint32_t nodeNum, bool visible) { result[nodeNum] = visible; });
+    return result;
+}
+} // namespace
+
+TEST_CASE("NodeFilter::normalize")
+{
+    CHECK(norm("Meshtastic 1A2B") == "meshtastic 1a2b");
+    // accents
+    CHECK(norm("José Müller") == "jose muller");
+    CHECK(norm("ÀÉÎÕÜ àéîõü Ññ Çç") == "aeiou aeiou nn cc");
+    CHECK(norm("Łódź Škoda Őrség") == "lodz skoda orseg");
+    CHECK(norm("Straße Æble Œuvre") == "strasse aeble oeuvre");
+    // Cyrillic
+    CHECK(norm("Привет МИР") == "привет мир");
+    CHECK(norm("ЁЛКА ёлка") == "елка елка");
+    CHECK(norm("Україна ЇЖАК Ґанок") == "україна їжак ґанок");
+    // Greek
+    CHECK(norm("ΑΘΗΝΑ") == "αθηνα");
+    // other scripts and symbols pass unchanged
+    CHECK(norm("東京 📡 ×") == "東京 📡 ×");
+    // invalid UTF-8 does not break the rest
+    CHECK(norm("a\xff" "B") == "a\xff" "b");
+}
+
+TEST_CASE("NodeFilter::search")
+{
+    NodeFilter filter;
+    filter.setKey(0x11111111, "ЁЖИК", "Ёжик в тумане");
+    filter.setKey(0x22222222, "José", "José's Base Station");
+    filter.setKey(0x33333333, "ab12", "Meshtastic ab12");
+    filter.setKey(0xdeadbeef, "Zürı", "Zürich Router");
+
+    auto visibleFor = [&](const char *query) {
+        filter.setQuery(query);
+        std::string result;
+        for (auto &it : visibility(filter))
+            result += it.second ? '1' : '0';
+        return result;
+    };
+    CHECK(visibleFor("") == "1111");
+    CHECK(visibleFor("ежик") == "1000");
+    CHECK(visibleFor("ЕЖИК В") == "1000");
+    CHECK(visibleFor("jose") == "0100");
+    CHECK(visibleFor("JOSÉ") == "0100");
+    CHECK(visibleFor("zurich") == "0001");
+    CHECK(visibleFor("!zurich") == "1110");
+    CHECK(visibleFor("AB12") == "0010");
+    CHECK(visibleFor("beef") == "0001"); // hex id
+    CHECK(visibleFor("!dead") == "1110");
+    CHECK(visibleFor("12mesh") == "0000"); // no match across fields
+
+    // renaming replaces the key
+    filter.setKey(0x33333333, "Oleg", "Олег");
+    CHECK(visibleFor("ab12") == "0000");
+    CHECK(visibleFor("олег") == "0010");
+    CHECK(filter.visible(0x33333333));
+    CHECK(filter.visible(0x44444444)); // unknown nodes are not filtered
+}
+
+TEST_CASE("NodeFilter::criteria")
+{
+    NodeFilter filter;
+    for (uint32_t n = 1; n <= 70; n++) {
+        filter.setKey(n, "node", "");
+        filter.set(n, NodeFilter::eOnline, n % 2 == 0);
+        filter.set(n, NodeFilter::eHasPosition, n % 3 == 0);
+    }
+    CHECK(filter.apply([](uint32_t, bool) {}) == 0);
+
+    filter.require(NodeFilter::eOnline, true);
+    CHECK(filter.required(NodeFilter::eOnline));
+    CHECK(filter.apply([](uint32_t, bool) {}) == 35);
+    filter.require(NodeFilter::eHasPosition, true);
+    auto vis = visibility(filter);
+    for (auto &it : vis)
+        CHECK(it.second == (it.first % 6 == 0));
+    CHECK(filter.visible(66));
+    CHECK_FALSE(filter.visible(64));
+
+    filter.setQuery("!node");
+    CHECK(filter.apply([](uint32_t, bool) {}) == 70);
+    filter.setQuery("");
+    filter.require(NodeFilter::eHasPosition, false);
+    filter.set(3, NodeFilter::eOnline, true);
+    CHECK(filter.visible(3));
+}
+
+TEST_CASE("NodeFilter::consistency")
+{
+    // random updates and removals against a reference model
+    struct Node {
+        std::string key;
+        bool online;
+        bool chat;
+    };
+    std::mt19937 rnd(35);
+    NodeFilter filter;
+    std::map<uint32_t, Node> model;
+    filter.require(NodeFilter::eOnline, true);
+    filter.setQuery("x");
+    for (int i = 0; i < 20000; i++) {
+        uint32_t nodeNum = 0x1000 + rnd() % 200;
+        uint32_t op = rnd() % 10;
+        if (op < 5) {
+            std::string name(1 + rnd() % 12, 'a');
+            for (char &c : name)
+                c = "abcxyz"[rnd() % 6];
+            bool online = rnd() % 2;
+            filter.setKey(nodeNum, "", name.c_str());
+            filter.set(nodeNum, NodeFilter::eOnline, online);
+            filter.set(nodeNum, NodeFilter::eChat, true);
+            model[nodeNum] = Node{name, online, true};
+        } else if (op < 8) {
+            filter.remove(nodeNum);
+            model.erase(nodeNum);
+        } else {
+            bool visible = !model.count(nodeNum) ||
+                           (model[nodeNum].online && model[nodeNum].key.find('x') != std::string::npos);
+            CHECK(filter.visible(nodeNum) == visible);
+        }
+        if (i % 1000 == 999) {
+            REQUIRE(filter.size() == model.size());
+            auto vis = visibility(filter);
+            REQUIRE(vis.size() == model.size());
+            for (auto &it : model)
+                CHECK(vis[it.first] == (it.second.online && it.second.key.find('x') != std::string::npos));
+        }
+    }
+    filter.clear();
+    CHECK(filter.size() == 0);
+}
@@ -0,0 +1,106 @@
+#include "util/NodeList.h"
+#include <doctest/doctest.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+std::vector<uint32_t> visibleRows(NodeList &list)
+{
+    std::vector<uint32_t> rows;
+    for (uint32_t row = 0; row < list.rows(); row++)
+        rows.push_back(list.nodeAt(row));
+    return rows;
+}
+} // namespace
+
+TEST_CASE("NodeList::order")
+{
+    NodeList list;
+    list.setPinned(1);
+    CHECK(list.add(10, 100));
+    CHECK(list.add(11, 300));
+    CHECK(list.add(12, 200));
+    CHECK(list.add(13, 0)); // never heard: at the end
+    CHECK_FALSE(list.add(12, 500));
+    CHECK(visibleRows(list) == std::vector<uint32_t>{11, 12, 10, 13});
+
+    // the pinned node is always first
+    CHECK(list.add(1, 0));
+    CHECK(visibleRows(list) == std::vector<uint32_t>{1, 11, 12, 10, 13});
+    CHECK(list.add(14, 1000));
+    CHECK(list.nodeAt(1) == 14);
+
+    list.moveToTop(13, 2000);
+    CHECK(visibleRows(list) == std::vector<uint32_t>{1, 13, 14, 11, 12, 10});
+    list.moveToTop(1, 3000);
+    CHECK(list.nodeAt(0) == 1);
+
+    CHECK(list.remove(11));
+    CHECK_FALSE(list.remove(11));
+    CHECK(visibleRows(list) == std::vector<uint32_t>{1, 13, 14, 12, 10});
+    CHECK(list.size() == 5);
+    CHECK(list.nodeAt(5) == NodeList::c_none);
+
+    // pinning a listed node moves it to the top
+    list.setPinned(12);
+    CHECK(list.nodeAt(0) == 12);
+}
+
+TEST_CASE("NodeList::filter")
+{
+    NodeList list;
+    list.setPinned(1);
+    list.add(1, 0);
+    for (uint32_t n = 2; n <= 10; n++)
+        list.add(n, 100 - n);
+
+    for (uint32_t n = 2; n <= 10; n += 2)
+        CHECK(list.setVisible(n, false));
+    CHECK_FALSE(list.setVisible(2, false));
+    CHECK(list.setVisible(1, false)); // the pinned node stays visible
+    CHECK(list.hidden() == 6);
+    CHECK(visibleRows(list) == std::vector<uint32_t>{1, 3, 5, 7, 9});
+    CHECK(list.rowOf(5) == 2);
+    CHECK(list.rowOf(4) == NodeList::c_none);
+    CHECK(list.rowOf(42) == NodeList::c_none);
+
+    // hidden nodes keep their place in the order
+    list.moveToTop(8, 1000);
+    CHECK(list.setVisible(8, true));
+    CHECK(visibleRows(list) == std::vector<uint32_t>{1, 8, 3, 5, 7, 9});
+
+    list.remove(10);
+    CHECK(list.hidden() == 4);
+    list.clear();
+    CHECK(list.rows() == 0);
+    CHECK(list.hidden() == 0);
+}
+
+TEST_CASE("NodeList::texts")
+{
+    NodeList list;
+    list.add(7, 0);
+    CHECK(strcmp(list.text(7, NodeList::eBattery), "") == 0);
+    CHECK_FALSE(list.setText(7, NodeList::eBattery, ""));
+    CHECK_FALSE(list.setText(8, NodeList::eBattery, "100%")); // not listed
+
+    CHECK(list.setText(7, NodeList::eBattery, "90% 4.01V"));
+    CHECK_FALSE(list.setText(7, NodeList::eBattery, "90% 4.01V"));
+    CHECK(strcmp(list.text(7, NodeList::eBattery), "90% 4.01V") == 0);
+    CHECK(strcmp(list.text(7, NodeList::eSignal), "") == 0);
+
+    // long texts are cut at a character boundary
+    std::string text(NodeList::c_textLen - 2, 'x');
+    text += "°C";
+    CHECK(list.setText(7, NodeList::eTelemetry1, text.c_str()));
+    CHECK(strlen(list.text(7, NodeList::eTelemetry1)) == NodeList::c_textLen - 2);
+    CHECK_FALSE(list.setText(7, NodeList::eTelemetry1, text.c_str()));
+
+    list.setIaq(7, 120);
+    CHECK(list.iaq(7) == 120);
+    list.remove(7);
+    CHECK(list.iaq(7) == 0);
+    CHECK(strcmp(list.text(7, NodeList::eBattery), "") == 0);
+}
@@ -0,0 +1,90 @@
+#include "util/NodeUpdates.h"
+#include <doctest/doctest.h>
+#include <vector>
+
+namespace
+{
+std::vector<NodeUpdates::Update> flushAll(NodeUpdates &updates)
+{
+    std::vector<NodeUpdates::Update> flushed;
+    updates.flush([&](const NodeUpdates::Update &u) { flushed.push_back(u); });
+    return flushed;
+}
+} // namespace
+
+TEST_CASE("NodeUpdates: latest values per node")
+{
+    NodeUpdates updates;
+    updates.setMetrics(0x100, NodeUpdates::Metrics{50, 3.7f, 10.0f, 1.0f});
+    updates.setLastHeard(0x200, false);
+    updates.setMetrics(0x100, NodeUpdates::Metrics{49, 3.6f, 12.0f, 2.0f});
+    updates.setSignal(0x100, -90, 5.25f);
+    updates.setLastHeard(0x100, true);
+    updates.setLastHeard(0x100, false);
+    CHECK(updates.pending() == 2);
+    CHECK(updates.coalesced() == 2);
+
+    std::vector<NodeUpdates::Update> flushed = flushAll(updates);
+    REQUIRE(flushed.size() == 2);
+    // order of the first change
+    CHECK(flushed[0].nodeNum == 0x100);
+    CHECK(flushed[0].dirty == (NodeUpdates::eMetrics | NodeUpdates::eSignal | NodeUpdates::eLastHeard));
+    CHECK(flushed[0].metrics.batteryLevel == 49);
+    CHECK(flushed[0].metrics.channelUtil == 12.0f);
+    CHECK(flushed[0].rssi == -90);
+    CHECK(flushed[0].cameOnline);
+    CHECK(flushed[1].nodeNum == 0x200);
+    CHECK(flushed[1].dirty == NodeUpdates::eLastHeard);
+    CHECK_FALSE(flushed[1].cameOnline);
+
+    CHECK(updates.pending() == 0);
+    CHECK(flushAll(updates).empty());
+}
+
+TEST_CASE("NodeUpdates: signal and hops replace each other")
+{
+    NodeUpdates updates;
+    updates.setSignal(0x100, -80, 2.0f);
+    updates.setHopsAway(0x100, 3);
+    updates.setHopsAway(0x200, 1);
+    updates.setSignal(0x200, -100, -4.0f);
+
+    std::vector<NodeUpdates::Update> flushed = flushAll(updates);
+    REQUIRE(flushed.size() == 2);
+    CHECK(flushed[0].dirty == NodeUpdates::eHopsAway);
+    CHECK(flushed[0].hopsAway == 3);
+    CHECK(flushed[1].dirty == NodeUpdates::eSignal);
+    CHECK(flushed[1].snr == -4.0f);
+    CHECK(updates.coalesced() == 2);
+}
+
+TEST_CASE("NodeUpdates: remove and record during flush")
+{
+    NodeUpdates updates;
+    updates.setLastHeard(0x100, false);
+    updates.setLastHeard(0x200, false);
+    updates.setLastHeard(0x300, false);
+    updates.remove(0x200);
+    updates.remove(0x400);
+    CHECK(updates.pending() == 2);
+
+    // removed and added again goes to the end
+    updates.setHopsAway(0x200, 2);
+    std::vector<uint32_t> nums;
+    updates.flush([&](const NodeUpdates::Update &u) {
+        nums.push_back(u.nodeNum);
+        updates.setLastHeard(u.nodeNum + 1, false);
+    });
+    CHECK(nums == std::vector<uint32_t>{0x100, 0x300, 0x200});
+
+    // recorded during the flush, handed over with the next one
+    CHECK(updates.pending() == 3);
+    nums.clear();
+    updates.flush([&](const NodeUpdates::Update &u) { nums.push_back(u.nodeNum); });
+    CHECK(nums == std::vector<uint32_t>{0x101, 0x301, 0x201});
+
+    updates.setLastHeard(0x100, false);
+    updates.clear();
+    CHECK(updates.pending() == 0);
+    CHECK(flushAll(updates).empty());
+}
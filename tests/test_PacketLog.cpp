@@ -0,0 +1,113 @@
+#include "util/PacketLog.h"
+#include <doctest/doctest.h>
+#include <string.h>
+
+namespace
+{
+PacketLog::Entry entry(uint32_t from, uint32_t to, uint16_t port)
+{
+    PacketLog::Entry e{};
+    e.time = 1000 + from;
+    e.from = from;
+    e.to = to;
+    e.port = port;
+    e.hops = PacketLog::c_unknownHops;
+    e.route = PacketLog::c_noRoute;
+    return e;
+}
+} // namespace
+
+TEST_CASE("PacketLog: ring")
+{
+    PacketLog log(4);
+    CHECK(log.size() == 0);
+    for (uint32_t i = 1; i <= 3; i++)
+        log.push(entry(i, UINT32_MAX, 1));
+    CHECK(log.size() == 3);
+    CHECK(log[0].from == 1);
+    CHECK(log[2].from == 3);
+
+    for (uint32_t i = 4; i <= 10; i++)
+        log.push(entry(i, UINT32_MAX, 1));
+    CHECK(log.size() == 4);
+    CHECK(log.total() == 10);
+    for (uint32_t i = 0; i < 4; i++)
+        CHECK(log[i].from == 7 + i);
+
+    log.clear();
+    CHECK(log.size() == 0);
+    CHECK(log.total() == 0);
+    log.push(entry(42, UINT32_MAX, 1));
+    CHECK(log[0].from == 42);
+}
+
+TEST_CASE("PacketLog: format")
+{
+    PacketLog log(8, 2);
+    char buf[128];
+    const uint32_t own = 0x1234abcd;
+
+    log.push(entry(0x55550001, UINT32_MAX, 3));
+    log.format(0, "12:00:00", "ABCD", own, buf, sizeof(buf));
+    CHECK(strcmp(buf, "12:00:00: ch0 ABCD:0001->all: position") == 0);
+
+    PacketLog::Entry e = entry(0x55550002, own, 67);
+    e.channel = 2;
+    e.detail = PacketLog::eEnvironmentMetrics;
+    e.rssi = -95;
+    e.snr = -26; // -6.5 dB
+    e.hops = 2;
+    log.push(e);
+    log.format(1, "t", "", own, buf, sizeof(buf));
+    CHECK(strcmp(buf, "t: ch2 :0002->*abcd: telemetry env\n(-95dBm -6.5dB 2h)") == 0);
+
+    log.push(entry(0x55550003, 0x77770000, 500));
+    log.format(2, "t", "x", own, buf, sizeof(buf));
+    CHECK(strcmp(buf, "t: ch0 x:0003->0000: port?") == 0);
+
+    SUBCASE("truncated")
+    {
+        char small[12];
+        log.format(0, "12:00:00", "ABCD", own, small, sizeof(small));
+        CHECK(strcmp(small, "12:00:00: c") == 0);
+    }
+}
+
+TEST_CASE("PacketLog: traceroute paths")
+{
+    PacketLog log(8, 2);
+    char buf[128];
+    const uint32_t own = 0x1234abcd;
+    const uint32_t hops[] = {0x11110001, UINT32_MAX, 0x11110003};
+
+    log.push(entry(0x55550001, own, 70));
+    log.setRoute(hops, 3);
+    log.format(0, "t", "", own, buf, sizeof(buf));
+    CHECK(strcmp(buf, "t: ch0 :0001->*abcd: tracert\nabcd->0001->unk->0003->0001") == 0);
+
+    PacketLog::Entry e = entry(0x55550002, 0x66660000, 70);
+    e.rssi = -80;
+    log.push(e);
+    log.setRoute(hops, 1);
+    log.format(1, "t", "", own, buf, sizeof(buf));
+    CHECK(strcmp(buf, "t: ch0 :0002->0000: tracert\n->0001 (-80dBm 0.0dB)") == 0);
+
+    // the third path reuses the slot of the first one
+    log.push(entry(0x55550003, own, 70));
+    log.setRoute(hops, 1);
+    log.format(0, "t", "", own, buf, sizeof(buf));
+    CHECK(strcmp(buf, "t: ch0 :0001->*abcd: tracert") == 0);
+    log.format(2, "t", "", own, buf, sizeof(buf));
+    CHECK(strcmp(buf, "t: ch0 :0003->*abcd: tracert\nabcd->0001->0003") == 0);
+
+    SUBCASE("path dropped with its entry")
+    {
+        PacketLog small(2, 4);
+        small.push(entry(1, own, 70));
+        small.setRoute(hops, 1);
+        small.push(entry(2, own, 70));
+        small.push(entry(3, own, 70));
+        small.format(1, "t", "", own, buf, sizeof(buf));
+        CHECK(strcmp(buf, "t: ch0 :0003->*abcd: tracert") == 0);
+    }
+}
@@ -0,0 +1,121 @@
+#include "util/PacketStats.h"
+#include <algorithm>
+#include <doctest/doctest.h>
+#include <random>
+#include <vector>
+
+namespace
+{
+std::vector<uint32_t> topNums(const PacketStats &stats, uint32_t max)
+{
+    std::vector<const PacketStats::Node *> top(max);
+    uint32_t n = stats.top(top.data(), max);
+    std::vector<uint32_t> nums;
+    for (uint32_t i = 0; i < n; i++)
+        nums.push_back(top[i]->num);
+    return nums;
+}
+} // namespace
+
+TEST_CASE("PacketStats: counters")
+{
+    PacketStats stats(4);
+    stats.count(0x100, PacketStats::eTelemetry);
+    stats.count(0x100, PacketStats::ePosition);
+    stats.count(0x100, PacketStats::ePosition);
+    stats.count(0x200, PacketStats::eOther);
+
+    const PacketStats::Node *node = stats.find(0x100);
+    REQUIRE(node != nullptr);
+    CHECK(node->count[PacketStats::eTelemetry] == 1);
+    CHECK(node->count[PacketStats::ePosition] == 2);
+    CHECK(node->count[PacketStats::eText] == 0);
+    CHECK(node->sum == 3);
+    CHECK(stats.find(0x200)->sum == 1);
+    CHECK(stats.find(0x300) == nullptr);
+    CHECK(stats.size() == 2);
+
+    stats.clear();
+    CHECK(stats.size() == 0);
+    CHECK(stats.find(0x100) == nullptr);
+    CHECK(topNums(stats, 4).empty());
+}
+
+TEST_CASE("PacketStats: ranking with ties")
+{
+    PacketStats stats(3);
+
+    SUBCASE("first to reach a count ranks first")
+    {
+        stats.count(1, PacketStats::eText);
+        stats.count(2, PacketStats::eText);
+        stats.count(3, PacketStats::eText);
+        CHECK(topNums(stats, 3) == std::vector<uint32_t>{1, 2, 3});
+
+        stats.count(3, PacketStats::eText);
+        stats.count(1, PacketStats::eText);
+        CHECK(topNums(stats, 3) == std::vector<uint32_t>{3, 1, 2});
+    }
+
+    SUBCASE("a node outside the top replaces the last one only when better")
+    {
+        stats.count(1, PacketStats::eText);
+        stats.count(2, PacketStats::eText);
+        stats.count(3, PacketStats::eText);
+        stats.count(4, PacketStats::eText); // tie with 3, but later
+        CHECK(topNums(stats, 3) == std::vector<uint32_t>{1, 2, 3});
+
+        stats.count(4, PacketStats::eText);
+        CHECK(topNums(stats, 3) == std::vector<uint32_t>{4, 1, 2});
+
+        stats.count(3, PacketStats::eText); // 3 reaches 2 after 4 did
+        CHECK(topNums(stats, 3) == std::vector<uint32_t>{4, 3, 1});
+    }
+
+    SUBCASE("fewer rows than top nodes")
+    {
+        for (uint32_t n = 1; n <= 5; n++)
+            stats.count(n, PacketStats::eText);
+        CHECK(topNums(stats, 2) == std::vector<uint32_t>{1, 2});
+    }
+
+    SUBCASE("resize")
+    {
+        for (uint32_t n = 1; n <= 6; n++) {
+            for (uint32_t k = 0; k < n; k++)
+                stats.count(n, PacketStats::eText);
+        }
+        CHECK(topNums(stats, 5) == std::vector<uint32_t>{6, 5, 4});
+        stats.setTopSize(5);
+        CHECK(topNums(stats, 5) == std::vector<uint32_t>{6, 5, 4, 3, 2});
+        stats.setTopSize(2);
+        CHECK(topNums(stats, 5) == std::vector<uint32_t>{6, 5});
+    }
+}
+
+TEST_CASE("PacketStats: top matches a full sort")
+{
+    constexpr uint32_t c_top = 12;
+    PacketStats stats(c_top);
+    std::mt19937 rnd(37);
+    std::geometric_distribution<uint32_t> pick(0.01);
+
+    for (int packet = 0; packet < 20000; packet++) {
+        stats.count(0x1000 + pick(rnd) % 1000, PacketStats::Counter(rnd() % PacketStats::eNumCounters));
+
+        if (packet % 500 == 0) {
+            std::vector<const PacketStats::Node *> all;
+            for (uint32_t n = 0x1000; n < 0x1000 + 1000; n++) {
+                if (const PacketStats::Node *node = stats.find(n))
+                    all.push_back(node);
+            }
+            std::sort(all.begin(), all.end(),
+                      [](const PacketStats::Node *a, const PacketStats::Node *b) { return PacketStats::before(*a, *b); });
+            std::vector<uint32_t> expected;
+            for (uint32_t i = 0; i < c_top && i < all.size(); i++)
+                expected.push_back(all[i]->num);
+            CHECK(topNums(stats, c_top) == expected);
+        }
+    }
+    CHECK(stats.size() > 500);
+}
@@ -0,0 +1,34 @@
+#include "util/RequestId.h"
+#include <doctest/doctest.h>
+#include <unordered_set>
+
+TEST_CASE("RequestId: unique ids")
+{
+    RequestId ids(0);
+    std::unordered_set<uint32_t> seen;
+    for (int i = 0; i < 200000; i++) {
+        uint32_t id = ids.next();
+        CHECK(id != 0);
+        CHECK(seen.insert(id).second);
+    }
+}
+
+TEST_CASE("RequestId: salt")
+{
+    RequestId a(0x1234), b(0x1235);
+    uint32_t same = 0;
+    for (int i = 0; i < 1000; i++)
+        same += a.next() == b.next();
+    CHECK(same == 0);
+
+    // consecutive ids differ in about half of their bits
+    RequestId c(0xdeadbeef);
+    uint32_t prev = c.next(), bits = 0;
+    for (int i = 0; i < 1000; i++) {
+        uint32_t id = c.next();
+        bits += __builtin_popcount(id ^ prev);
+        prev = id;
+    }
+    CHECK(bits / 1000 >= 12);
+    CHECK(bits / 1000 <= 20);
+}
@@ -0,0 +1,156 @@
+#include "util/RowWindow.h"
+#include <doctest/doctest.h>
+#include <set>
+#include <vector>
+
+namespace
+{
+// pool rows as seen by the view: list row shown per pool row
+struct Pool {
+    std::vector<uint32_t> shown;
+    uint32_t rebinds = 0;
+
+    explicit Pool(const RowWindow &window) : shown(window.poolSize(), RowWindow::c_none) {}
+    RowWindow::Bind bind(void)
+    {
+        return [this](uint32_t poolRow, uint32_t index) {
+            shown[poolRow] = index;
+            rebinds++;
+        };
+    }
+};
+
+void checkConsistent(const RowWindow &window, const Pool &pool)
+{
+    std::set<uint32_t> visible;
+    for (uint32_t poolRow = 0; poolRow < window.poolSize(); poolRow++) {
+        uint32_t index = pool.shown[poolRow];
+        CHECK(index == window.indexOf(poolRow));
+        if (index != RowWindow::c_none) {
+            CHECK(index >= window.first());
+            CHECK(index < window.last());
+            CHECK(window.poolRowOf(index) == poolRow);
+            visible.insert(index);
+        }
+    }
+    CHECK(visible.size() == window.last() - window.first());
+}
+} // namespace
+
+TEST_CASE("RowWindow::geometry")
+{
+    RowWindow window(53, 200, 1);
+    CHECK(window.poolSize() == 4 + 1 + 2);
+    window.setCount(10000);
+    CHECK(window.contentHeight() == 530000);
+    CHECK(window.rowY(3) == 159);
+    CHECK(window.indexAt(-10) == 0);
+    CHECK(window.indexAt(159) == 3);
+    CHECK(window.indexAt(1000000) == 9999);
+
+    // scroll position is clamped to the content
+    window.scrollTo(-100);
+    CHECK(window.first() == 0);
+    window.scrollTo(10000000);
+    CHECK(window.last() == 10000);
+    CHECK(window.first() == 10000 - window.poolSize());
+}
+
+TEST_CASE("RowWindow::recycling")
+{
+    RowWindow window(50, 200, 1);
+    Pool pool(window);
+    window.setCount(1000);
+    CHECK(window.update(pool.bind()) == window.poolSize());
+    checkConsistent(window, pool);
+    CHECK(window.update(pool.bind()) == 0);
+
+    SUBCASE("scrolling by one row rebinds one pool row")
+    {
+        for (int32_t y = 50; y < 50 * 100; y += 50) {
+            CAPTURE(y);
+            window.scrollTo(y);
+            CHECK(window.update(pool.bind()) <= 1);
+            checkConsistent(window, pool);
+        }
+    }
+
+    SUBCASE("small scroll steps within a row don't rebind")
+    {
+        window.scrollTo(500);
+        window.update(pool.bind());
+        for (int32_t y = 501; y < 550; y++) {
+            window.scrollTo(y);
+            CHECK(window.update(pool.bind()) == 0);
+        }
+    }
+
+    SUBCASE("jump rebinds the whole pool")
+    {
+        window.scrollTo(30000);
+        CHECK(window.update(pool.bind()) == window.poolSize());
+        checkConsistent(window, pool);
+        CHECK(window.poolRowOf(0) == RowWindow::c_none);
+    }
+
+    SUBCASE("invalidate")
+    {
+        window.invalidate(2);
+        CHECK(window.update(pool.bind()) == 1);
+        window.invalidate(500); // not within the window
+        CHECK(window.update(pool.bind()) == 0);
+        window.invalidate();
+        CHECK(window.update(pool.bind()) == window.poolSize());
+        checkConsistent(window, pool);
+    }
+
+    SUBCASE("shrinking hides unused pool rows")
+    {
+        window.scrollTo(40000);
+        window.update(pool.bind());
+        window.setCount(3);
+        window.update(pool.bind());
+        checkConsistent(window, pool);
+        CHECK(window.first() == 0);
+        CHECK(window.last() == 3);
+
+        window.invalidate();
+        window.setCount(0);
+        window.update(pool.bind());
+        for (uint32_t index : pool.shown)
+            CHECK(index == RowWindow::c_none);
+    }
+}
+
+TEST_CASE("RowWindow::expanded row")
+{
+    RowWindow window(50, 200, 1);
+    Pool pool(window);
+    window.setCount(100);
+    window.setExpanded(3, 30);
+    CHECK(window.expanded() == 3);
+    CHECK(window.contentHeight() == 100 * 50 + 30);
+    CHECK(window.rowHeight(3) == 80);
+    CHECK(window.rowHeight(4) == 50);
+    CHECK(window.rowY(3) == 150);
+    CHECK(window.rowY(4) == 230);
+    CHECK(window.indexAt(229) == 3);
+    CHECK(window.indexAt(230) == 4);
+    CHECK(window.indexAt(100 * 50 + 29) == 99);
+
+    // the pool still covers the view when scrolling across the expanded row
+    for (int32_t y = 0; y < 1000; y += 10) {
+        CAPTURE(y);
+        window.scrollTo(y);
+        window.update(pool.bind());
+        checkConsistent(window, pool);
+        uint32_t top = window.indexAt(y);
+        uint32_t bottom = window.indexAt(y + 199);
+        CHECK(window.first() <= top);
+        CHECK(window.last() > bottom);
+    }
+
+    window.setExpanded(RowWindow::c_none, 30);
+    CHECK(window.contentHeight() == 100 * 50);
+    CHECK(window.rowY(4) == 200);
+}
@@ -0,0 +1,25 @@
+#include "graphics/common/FrameStats.h"
+#include "util/SharedQueue.h"
+#include <doctest/doctest.h>
+
+TEST_CASE("SharedQueue: packets carry their queuing time")
+{
+    SharedQueue queue;
+    uint64_t before = FrameStats::now();
+    queue.serverSend(Packet(1));
+    uint64_t after = FrameStats::now();
+
+    // the client sees when the packet was queued, not when it was dequeued
+    Packet::PacketPtr p = queue.clientReceive();
+    REQUIRE(p);
+    CHECK(p->getPacketId() == 1);
+    CHECK(p->getEnqueued() >= before);
+    CHECK(p->getEnqueued() <= after);
+    CHECK(p->move()->getEnqueued() == p->getEnqueued());
+
+    // packets the client queues for the server are not stamped
+    queue.clientSend(Packet(2));
+    p = queue.serverReceive();
+    REQUIRE(p);
+    CHECK(p->getEnqueued() == 0);
+}
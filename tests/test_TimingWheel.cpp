@@ -0,0 +1,156 @@
+#include "util/TimingWheel.h"
+#include <algorithm>
+#include <doctest/doctest.h>
+#include <random>
+#include <vector>
+
+TEST_CASE("TimingWheel: expiry ordering")
+{
+    TimingWheel wheel(100, 8);
+    std::vector<uint32_t> expired;
+    auto collect = [&](uint32_t key) { expired.push_back(key); };
+
+    wheel.schedule(1, 0, 500);
+    wheel.schedule(2, 0, 200);
+    wheel.schedule(3, 0, 250); // rounded up to 300
+    wheel.schedule(4, 0, 200); // same deadline as 2, scheduled later
+    wheel.schedule(5, 0, 2000); // more than one revolution
+    CHECK(wheel.size() == 5);
+
+    CHECK(wheel.advance(199, collect) == 0);
+    CHECK(wheel.advance(200, collect) == 2);
+    CHECK(expired == std::vector<uint32_t>{2, 4});
+
+    // jump over several ticks at once
+    CHECK(wheel.advance(1000, collect) == 2);
+    CHECK(expired == std::vector<uint32_t>{2, 4, 3, 1});
+
+    // slot of 5 has been visited already without expiring it
+    CHECK(wheel.advance(1999, collect) == 0);
+    CHECK(wheel.advance(2000, collect) == 1);
+    CHECK(expired.back() == 5);
+    CHECK(wheel.size() == 0);
+
+    SUBCASE("delay 0 expires on the next tick")
+    {
+        wheel.schedule(6, 2050, 0);
+        CHECK(wheel.advance(2099, collect) == 0);
+        CHECK(wheel.advance(2100, collect) == 1);
+    }
+    SUBCASE("scheduled within a tick")
+    {
+        // 50 ms into the current tick plus 100 ms
+        wheel.schedule(7, 2050, 100);
+        CHECK(wheel.advance(2100, collect) == 0);
+        CHECK(wheel.advance(2200, collect) == 1);
+    }
+}
+
+TEST_CASE("TimingWheel: cancel")
+{
+    TimingWheel wheel(10, 4);
+    std::vector<uint32_t> expired;
+    auto collect = [&](uint32_t key) { expired.push_back(key); };
+
+    TimingWheel::Handle a = wheel.schedule(1, 0, 10);
+    TimingWheel::Handle b = wheel.schedule(2, 0, 10);
+    CHECK(wheel.pending(a));
+    CHECK(wheel.cancel(a));
+    CHECK_FALSE(wheel.cancel(a));
+    CHECK_FALSE(wheel.cancel(0));
+
+    // cancel after expire
+    CHECK(wheel.advance(10, collect) == 1);
+    CHECK(expired == std::vector<uint32_t>{2});
+    CHECK_FALSE(wheel.pending(b));
+    CHECK_FALSE(wheel.cancel(b));
+
+    // a stale handle does not cancel the timer that reuses its entry
+    TimingWheel::Handle c = wheel.schedule(3, 10, 10);
+    CHECK_FALSE(wheel.cancel(b));
+    CHECK(wheel.pending(c));
+
+    SUBCASE("expire callback cancels a timer that expires in the same advance")
+    {
+        TimingWheel::Handle d = wheel.schedule(4, 10, 10);
+        bool cancelled = true;
+        wheel.advance(20, [&](uint32_t key) {
+            expired.push_back(key);
+            if (key == 3)
+                cancelled = wheel.cancel(d);
+        });
+        CHECK_FALSE(cancelled);
+        CHECK(expired == std::vector<uint32_t>{2, 3, 4});
+    }
+    SUBCASE("expire callback schedules a new timer")
+    {
+        wheel.advance(20, [&](uint32_t key) { wheel.schedule(key + 10, 20, 10); });
+        CHECK(wheel.size() == 1);
+        CHECK(wheel.advance(30, collect) == 1);
+        CHECK(expired.back() == 13);
+    }
+    SUBCASE("clear")
+    {
+        wheel.clear();
+        CHECK(wheel.size() == 0);
+        CHECK_FALSE(wheel.pending(c));
+        CHECK(wheel.advance(100, collect) == 0);
+    }
+}
+
+TEST_CASE("TimingWheel: clock wrap")
+{
+    uint32_t start = UINT32_MAX - 150;
+    TimingWheel wheel(100, 4, start);
+    uint32_t count = 0;
+    auto counter = [&](uint32_t) { count++; };
+    wheel.schedule(1, start, 300);
+    CHECK(wheel.advance(start + 299, counter) == 0);
+    CHECK(wheel.advance(start + 300, counter) == 1);
+}
+
+TEST_CASE("TimingWheel: random against reference")
+{
+    // random schedule/cancel/advance against a list of deadlines in ms
+    struct Ref {
+        uint32_t key;
+        uint32_t due; // ms, rounded up to a tick
+        TimingWheel::Handle handle;
+    };
+    std::mt19937 rnd(39);
+    TimingWheel wheel(16, 32);
+    std::vector<Ref> ref;
+    uint32_t now = 0, key = 0;
+
+    for (int step = 0; step < 20000; step++) {
+        uint32_t op = rnd() % 10;
+        if (op < 5) {
+            uint32_t delay = rnd() % 2000;
+            uint32_t due = (now + delay + 15) / 16 * 16;
+            if (due <= now / 16 * 16)
+                due = now / 16 * 16 + 16;
+            ref.push_back(Ref{key, due, wheel.schedule(key, now, delay)});
+            key++;
+        } else if (op < 7 && !ref.empty()) {
+            uint32_t i = rnd() % ref.size();
+            CHECK(wheel.cancel(ref[i].handle));
+            ref.erase(ref.begin() + i);
+        } else {
+            now += rnd() % 100;
+            std::vector<uint32_t> expired;
+            wheel.advance(now, [&](uint32_t k) { expired.push_back(k); });
+            std::vector<uint32_t> expected;
+            std::vector<Ref> kept;
+            std::stable_sort(ref.begin(), ref.end(), [](const Ref &a, const Ref &b) { return a.due < b.due; });
+            for (const Ref &r : ref) {
+                if (r.due <= now)
+                    expected.push_back(r.key);
+                else
+                    kept.push_back(r);
+            }
+            ref.swap(kept);
+            REQUIRE(expired == expected);
+        }
+        REQUIRE(wheel.size() == ref.size());
+    }
+}
@@ -0,0 +1,67 @@
+#if defined(ARCH_PORTDUINO)
+
+#include "util/Wakeup.h"
+#include <chrono>
+#include <doctest/doctest.h>
+#include <fcntl.h>
+#include <thread>
+#include <unistd.h>
+
+namespace
+{
+uint32_t elapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+} // namespace
+
+TEST_CASE("Wakeup: timeout and notify")
+{
+    Wakeup wakeup;
+    auto start = std::chrono::steady_clock::now();
+    CHECK(wakeup.wait(30) == Wakeup::eTimeout);
+    CHECK(elapsedMs(start) >= 30);
+    CHECK(wakeup.wait(0) == Wakeup::eTimeout);
+
+    // a notification before waiting is not lost, several are collected at once
+    wakeup.notify();
+    wakeup.notify();
+    CHECK(wakeup.wait(1000) == Wakeup::eNotified);
+    CHECK(wakeup.wait(0) == Wakeup::eTimeout);
+
+    start = std::chrono::steady_clock::now();
+    std::thread sender([&wakeup] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        wakeup.notify();
+    });
+    CHECK(wakeup.wait(5000) == Wakeup::eNotified);
+    CHECK(elapsedMs(start) < 2000);
+    sender.join();
+}
+
+TEST_CASE("Wakeup: watched file descriptors")
+{
+    Wakeup wakeup;
+    int fds[2];
+    REQUIRE(pipe2(fds, O_NONBLOCK) == 0);
+    wakeup.watch(fds[0]);
+    wakeup.watch(fds[0]);
+
+    CHECK(write(fds[1], "input", 5) == 5);
+    CHECK(wakeup.wait(1000) == Wakeup::eReadable);
+    // drained
+    CHECK(wakeup.wait(0) == Wakeup::eTimeout);
+
+    wakeup.unwatch(fds[0]);
+    CHECK(write(fds[1], "input", 5) == 5);
+    CHECK(wakeup.wait(10) == Wakeup::eTimeout);
+
+    // a closed device is no longer watched
+    wakeup.watch(fds[0]);
+    close(fds[1]);
+    wakeup.wait(0);
+    CHECK(wakeup.wait(10) == Wakeup::eTimeout);
+    close(fds[0]);
+}
+
+#endif
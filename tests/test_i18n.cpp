@@ -0,0 +1,365 @@
+#include "lv_i18n.h"
+#include "util/LabelRegistry.h"
+#include <doctest/doctest.h>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <set>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+const char *linearFind(const lv_i18n_phrase_t *phrases, const char *msgId)
+{
+    for (; phrases && phrases->msg_id; phrases++) {
+        if (strcmp(phrases->msg_id, msgId) == 0)
+            return phrases->translation;
+    }
+    return nullptr;
+}
+
+// lv_i18n_get_text() as generated by lv_i18n compile
+const char *reference(const lv_i18n_language_pack_t *pack, const lv_i18n_lang_t *lang, const char *msgId)
+{
+    const char *txt = linearFind(lang->singulars, msgId);
+    if (!txt && lang != pack[0])
+        txt = linearFind(pack[0]->singulars, msgId);
+    return txt ? txt : msgId;
+}
+
+std::vector<std::string> allMessageIds(void)
+{
+    std::vector<std::string> ids;
+    std::set<std::string> seen;
+    for (const lv_i18n_language_pack_t *lang = lv_i18n_language_pack; *lang; lang++) {
+        for (const lv_i18n_phrase_t *p = (*lang)->singulars; p && p->msg_id; p++) {
+            if (seen.insert(p->msg_id).second)
+                ids.push_back(p->msg_id);
+        }
+    }
+    return ids;
+}
+} // namespace
+
+TEST_CASE("i18n: hash lookup equals linear search in all languages")
+{
+    REQUIRE(lv_i18n_init_default() == 0);
+    std::vector<std::string> ids = allMessageIds();
+    ids.push_back("no such message");
+    ids.push_back("");
+
+    for (const lv_i18n_language_pack_t *lang = lv_i18n_language_pack; *lang; lang++) {
+        CAPTURE((*lang)->locale_name);
+        REQUIRE(lv_i18n_set_locale((*lang)->locale_name) == 0);
+        for (const std::string &id : ids) {
+            CAPTURE(id);
+            const char *expected = reference(lv_i18n_language_pack, *lang, id.c_str());
+            // same pointer: the table entry or the message ID itself
+            CHECK(lv_i18n_get_text(id.c_str()) == expected);
+        }
+    }
+    lv_i18n_set_locale("en");
+}
+
+TEST_CASE("i18n: unknown message ID is returned as is")
+{
+    REQUIRE(lv_i18n_init_default() == 0);
+    const char *id = "certainly not translated";
+    CHECK(lv_i18n_get_text(id) == id);
+    REQUIRE(lv_i18n_set_locale("de") == 0);
+    CHECK(lv_i18n_get_text(id) == id);
+    lv_i18n_set_locale("en");
+}
+
+TEST_CASE("i18n: texts map back to a message ID with the same translation")
+{
+    REQUIRE(lv_i18n_init_default() == 0);
+    std::vector<std::string> ids = allMessageIds();
+
+    for (const lv_i18n_language_pack_t *lang = lv_i18n_language_pack; *lang; lang++) {
+        CAPTURE((*lang)->locale_name);
+        REQUIRE(lv_i18n_set_locale((*lang)->locale_name) == 0);
+        for (const std::string &id : ids) {
+            CAPTURE(id);
+            std::string text = lv_i18n_get_text(id.c_str());
+            const char *msgId = lv_i18n_get_msg_id(text.c_str());
+            REQUIRE(msgId != nullptr);
+            // translations shared by several message IDs map to one of them
+            CHECK(text == lv_i18n_get_text(msgId));
+        }
+        CHECK(lv_i18n_get_msg_id("12:34") == nullptr);
+    }
+    lv_i18n_set_locale("en");
+}
+
+TEST_CASE("i18n: language packs without hash index are searched linearly")
+{
+    // same locale name as a generated language but different tables, e.g. a stale lv_i18n_hash.h
+    static const lv_i18n_phrase_t enSingulars[] = {{"Yes", "Yes!"}, {"Only english", "english"}, {nullptr, nullptr}};
+    static const lv_i18n_phrase_t deSingulars[] = {{"Yes", "Ja!"}, {nullptr, nullptr}};
+    static const lv_i18n_lang_t en = {"en", enSingulars, {}, nullptr};
+    static const lv_i18n_lang_t de = {"de", deSingulars, {}, nullptr};
+    static const lv_i18n_lang_t xx = {"xx", nullptr, {}, nullptr};
+    static const lv_i18n_language_pack_t pack[] = {&en, &de, &xx, nullptr};
+
+    REQUIRE(lv_i18n_init(pack) == 0);
+    CHECK(strcmp(lv_i18n_get_text("Yes"), "Yes!") == 0);
+    REQUIRE(lv_i18n_set_locale("de") == 0);
+    CHECK(strcmp(lv_i18n_get_text("Yes"), "Ja!") == 0);
+    CHECK(strcmp(lv_i18n_get_text("Only english"), "english") == 0);
+    CHECK(strcmp(lv_i18n_get_text("Settings"), "Settings") == 0);
+    REQUIRE(lv_i18n_set_locale("xx") == 0);
+    CHECK(strcmp(lv_i18n_get_text("Yes"), "Yes!") == 0);
+
+    REQUIRE(lv_i18n_init_default() == 0);
+}
+
+TEST_CASE("i18n: plurals are unchanged")
+{
+    REQUIRE(lv_i18n_init_default() == 0);
+    const lv_i18n_lang_t *en = lv_i18n_language_pack[0];
+    for (const lv_i18n_language_pack_t *lang = lv_i18n_language_pack; *lang; lang++) {
+        CAPTURE((*lang)->locale_name);
+        REQUIRE(lv_i18n_set_locale((*lang)->locale_name) == 0);
+        for (int32_t n : {0, 1, 2, 5, 21}) {
+            const char *id = "%d active chat(s)";
+            const char *expected = nullptr;
+            if ((*lang)->locale_plural_fn)
+                expected = linearFind((*lang)->plurals[(*lang)->locale_plural_fn(n)], id);
+            if (!expected && *lang != en)
+                expected = linearFind(en->plurals[en->locale_plural_fn(n)], id);
+            CHECK(lv_i18n_get_text_plural(id, n) == (expected ? expected : id));
+        }
+    }
+    lv_i18n_set_locale("en");
+}
+
+TEST_CASE("i18n: cached translations follow locale switches")
+{
+    REQUIRE(lv_i18n_init_default() == 0);
+    const char *id = "no new messages";
+    for (const char *locale : {"de", "de", "fr", "en", "ro", "de"}) {
+        CAPTURE(locale);
+        REQUIRE(lv_i18n_set_locale(locale) == 0);
+        const lv_i18n_language_pack_t *lang = lv_i18n_language_pack;
+        while (strcmp((*lang)->locale_name, locale) != 0)
+            lang++;
+        const char *expected = reference(lv_i18n_language_pack, *lang, id);
+        CHECK(lv_i18n_get_text(id) == expected);
+        CHECK(lv_i18n_get_text(id) == expected);
+    }
+
+    // a different pack with the same locale names
+    static const lv_i18n_phrase_t deSingulars[] = {{"no new messages", "nichts"}, {nullptr, nullptr}};
+    static const lv_i18n_lang_t en = {"en", nullptr, {}, nullptr};
+    static const lv_i18n_lang_t de = {"de", deSingulars, {}, nullptr};
+    static const lv_i18n_language_pack_t pack[] = {&en, &de, nullptr};
+    REQUIRE(lv_i18n_init(pack) == 0);
+    REQUIRE(lv_i18n_set_locale("de") == 0);
+    CHECK(strcmp(lv_i18n_get_text(id), "nichts") == 0);
+    REQUIRE(lv_i18n_init_default() == 0);
+    CHECK(lv_i18n_get_text(id) == id);
+}
+
+TEST_CASE("i18n: cached plural forms")
+{
+    REQUIRE(lv_i18n_init_default() == 0);
+    const char *id = "%d of %d nodes online";
+    const lv_i18n_lang_t *en = lv_i18n_language_pack[0];
+    for (const char *locale : {"uk", "de", "en", "ru", "uk"}) {
+        CAPTURE(locale);
+        REQUIRE(lv_i18n_set_locale(locale) == 0);
+        const lv_i18n_language_pack_t *lang = lv_i18n_language_pack;
+        while (strcmp((*lang)->locale_name, locale) != 0)
+            lang++;
+        // repeated and alternating counts select different forms from the same cache entry
+        for (int32_t n : {1, 1, 2, 5, 1, 21, 22, 25, 0, 2}) {
+            CAPTURE(n);
+            const char *expected = nullptr;
+            if ((*lang)->locale_plural_fn)
+                expected = linearFind((*lang)->plurals[(*lang)->locale_plural_fn(n)], id);
+            if (!expected && *lang != en)
+                expected = linearFind(en->plurals[en->locale_plural_fn(n)], id);
+            CHECK(lv_i18n_get_text_plural(id, n) == (expected ? expected : id));
+        }
+    }
+    lv_i18n_set_locale("en");
+}
+
+#ifdef LV_I18N_CACHE_STATS
+TEST_CASE("i18n: cache hits and misses")
+{
+    REQUIRE(lv_i18n_init_default() == 0);
+    REQUIRE(lv_i18n_set_locale("de") == 0);
+    uint32_t hits, misses, hits2, misses2;
+    lv_i18n_get_cache_stats(&hits, &misses);
+    const char *id = "Settings";
+    lv_i18n_get_text(id);
+    lv_i18n_get_text(id);
+    lv_i18n_get_text(id);
+    lv_i18n_get_cache_stats(&hits2, &misses2);
+    CHECK(misses2 - misses == 1);
+    CHECK(hits2 - hits == 2);
+
+    REQUIRE(lv_i18n_set_locale("fr") == 0);
+    lv_i18n_get_text(id);
+    lv_i18n_get_cache_stats(&hits, &misses);
+    CHECK(misses - misses2 == 1);
+    CHECK(hits == hits2);
+    lv_i18n_set_locale("en");
+}
+#endif
+
+#if defined(LV_I18N_PACK_DIR) && !defined(LV_I18N_EXTERNAL_PACKS)
+namespace
+{
+std::vector<uint8_t> readPack(const char *locale)
+{
+    std::string path = std::string(LV_I18N_PACK_DIR) + "/" + locale + ".lvi";
+    std::vector<uint8_t> pack;
+    if (FILE *f = fopen(path.c_str(), "rb")) {
+        uint8_t buf[4096];
+        size_t n;
+        while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+            pack.insert(pack.end(), buf, buf + n);
+        fclose(f);
+    }
+    return pack;
+}
+
+// pack bytes plus the space lv_i18n_set_locale_pack() builds the tables in
+std::vector<uint8_t> packBuffer(const std::vector<uint8_t> &pack)
+{
+    uint32_t alloc = lv_i18n_pack_alloc_size(pack.data(), pack.size());
+    std::vector<uint8_t> buf(alloc ? alloc : pack.size());
+    std::copy(pack.begin(), pack.end(), buf.begin());
+    return buf;
+}
+} // namespace
+
+TEST_CASE("i18n: language packs equal the compiled tables")
+{
+    REQUIRE(lv_i18n_init_default() == 0);
+    std::vector<std::string> ids = allMessageIds();
+    ids.push_back("no such message");
+    const lv_i18n_lang_t *en = lv_i18n_language_pack[0];
+
+    uint32_t packs = 0;
+    for (const lv_i18n_language_pack_t *lang = lv_i18n_language_pack + 1; *lang; lang++) {
+        CAPTURE((*lang)->locale_name);
+        std::vector<uint8_t> pack = readPack((*lang)->locale_name);
+        if (pack.empty())
+            continue;
+        packs++;
+        std::vector<uint8_t> buf = packBuffer(pack);
+        REQUIRE(lv_i18n_set_locale_pack(buf.data(), pack.size()) == 0);
+        CHECK(strcmp(lv_i18n_get_current_locale(), (*lang)->locale_name) == 0);
+        for (const std::string &id : ids) {
+            CAPTURE(id);
+            CHECK(strcmp(lv_i18n_get_text(id.c_str()), reference(lv_i18n_language_pack, *lang, id.c_str())) == 0);
+        }
+        for (const char *id : {"%d active chat(s)", "%d of %d nodes online"}) {
+            for (int32_t n : {0, 1, 2, 5, 21}) {
+                const char *expected = linearFind((*lang)->plurals[(*lang)->locale_plural_fn(n)], id);
+                if (!expected)
+                    expected = linearFind(en->plurals[en->locale_plural_fn(n)], id);
+                CHECK(strcmp(lv_i18n_get_text_plural(id, n), expected ? expected : id) == 0);
+            }
+        }
+        // back to the compiled tables before the pack is freed
+        REQUIRE(lv_i18n_set_locale("en") == 0);
+    }
+    if (packs == 0)
+        MESSAGE("no language packs in " LV_I18N_PACK_DIR ", is PyYAML installed?");
+}
+
+TEST_CASE("i18n: invalid language packs are rejected")
+{
+    std::vector<uint8_t> pack = readPack("de");
+    if (pack.empty())
+        return;
+    REQUIRE(lv_i18n_init_default() == 0);
+    REQUIRE(lv_i18n_set_locale("fr") == 0);
+    const char *fr = lv_i18n_get_text("Settings");
+
+    auto rejected = [&](std::vector<uint8_t> bad, uint32_t size) {
+        std::vector<uint8_t> buf = packBuffer(bad);
+        bool ok = lv_i18n_set_locale_pack(buf.data(), size) != 0;
+        // the locale is unchanged
+        return ok && strcmp(lv_i18n_get_current_locale(), "fr") == 0 && lv_i18n_get_text("Settings") == fr;
+    };
+    CHECK(rejected(pack, pack.size() - 1));
+    CHECK(rejected(std::vector<uint8_t>(pack.begin(), pack.begin() + LV_I18N_PACK_HEADER_SIZE), LV_I18N_PACK_HEADER_SIZE));
+    std::vector<uint8_t> bad = pack;
+    bad[0] = 'X'; // magic
+    CHECK(rejected(bad, bad.size()));
+    bad = pack;
+    bad[4] ^= 1; // message IDs of another firmware
+    CHECK(rejected(bad, bad.size()));
+    bad = pack;
+    memcpy(&bad[12], "xx\0", 3); // unknown language
+    CHECK(rejected(bad, bad.size()));
+    bad = pack;
+    bad[LV_I18N_PACK_HEADER_SIZE] = 0xff; // index beyond the singulars
+    CHECK(rejected(bad, bad.size()));
+    bad = pack;
+    bad.back() = 'x'; // string pool not terminated
+    CHECK(rejected(bad, bad.size()));
+
+    std::vector<uint8_t> buf = packBuffer(pack);
+    CHECK(lv_i18n_set_locale_pack(buf.data(), pack.size()) == 0);
+    CHECK(strcmp(lv_i18n_get_current_locale(), "de") == 0);
+    lv_i18n_set_locale("en");
+}
+
+TEST_CASE("i18n: labels keep their message IDs when a language pack is freed")
+{
+    std::vector<uint8_t> de = readPack("de");
+    std::vector<uint8_t> fr = readPack("fr");
+    if (de.empty() || fr.empty())
+        return;
+    REQUIRE(lv_i18n_init_default() == 0);
+    const lv_i18n_lang_t *deCompiled = nullptr, *frCompiled = nullptr;
+    for (const lv_i18n_language_pack_t *lang = lv_i18n_language_pack; *lang; lang++) {
+        if (strcmp((*lang)->locale_name, "de") == 0)
+            deCompiled = *lang;
+        if (strcmp((*lang)->locale_name, "fr") == 0)
+            frCompiled = *lang;
+    }
+    REQUIRE(deCompiled);
+    REQUIRE(frCompiled);
+
+    std::map<LabelRegistry::Label, std::string> text;
+    LabelRegistry labels(
+        lv_i18n_get_text, [&text](LabelRegistry::Label l) { return text[l].c_str(); },
+        [&text](LabelRegistry::Label l, const char *t) { text[l] = t; }, lv_i18n_get_msg_id);
+    int bound, adopted; // two labels: one bound by message ID, one resolved from its text
+    auto all = [](LabelRegistry::Label) { return true; };
+
+    auto buf = std::make_unique<std::vector<uint8_t>>(packBuffer(de));
+    REQUIRE(lv_i18n_set_locale_pack(buf->data(), de.size()) == 0);
+    labels.bind(&bound, "Settings");
+    text[&adopted] = lv_i18n_get_text("Cancel");
+    REQUIRE(labels.adopt(&adopted));
+    // the message ID is not a pointer into the pack
+    const char *msgId = labels.msgId(&adopted);
+    CHECK((msgId < (const char *)buf->data() || msgId >= (const char *)buf->data() + buf->size()));
+
+    // switch twice, each time freeing the previous pack after the switch
+    for (auto next : {std::make_pair(&fr, frCompiled), std::make_pair(&de, deCompiled)}) {
+        labels.invalidate();
+        auto nextBuf = std::make_unique<std::vector<uint8_t>>(packBuffer(*next.first));
+        REQUIRE(lv_i18n_set_locale_pack(nextBuf->data(), next.first->size()) == 0);
+        std::fill(buf->begin(), buf->end(), 0xa5);
+        buf = std::move(nextBuf);
+
+        CHECK(labels.relabel(all, 10) == 0);
+        CHECK(text[&bound] == reference(lv_i18n_language_pack, next.second, "Settings"));
+        CHECK(text[&adopted] == reference(lv_i18n_language_pack, next.second, "Cancel"));
+    }
+    lv_i18n_set_locale("en");
+}
+#endif